@@ -720,6 +720,12 @@ extern "C" {
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef portFASTCODE_FUNCTION
+	/* Placement attribute for the scheduler hot path (context switch and tick
+	handling), e.g. a section that is executed from zero wait state RAM. */
+	#define portFASTCODE_FUNCTION
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
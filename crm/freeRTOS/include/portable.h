@@ -174,6 +174,20 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Walk the free block list (heap_4 and heap_5 only).  pxVisit is called once
+ * per free block, in address order, with the scheduler suspended - it must
+ * not call any heap or blocking API.
+ */
+typedef void ( *HeapWalkCallback_t )( void *pvContext, size_t xBlockSize );
+void vPortHeapWalk( HeapWalkCallback_t pxVisit, void *pvContext ) PRIVILEGED_FUNCTION;
+
+/*
+ * Usable size of a block returned by pvPortMalloc() (heap_4 and heap_5 only).
+ * May be larger than the size requested.  Used to implement realloc().
+ */
+size_t xPortGetAllocatedSize( void *pv ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -170,8 +170,8 @@ void vPortSetupTimerInterrupt(void);
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler(void) __attribute__((naked));
-void xPortSysTickHandler(void);
+void xPortPendSVHandler(void) __attribute__((naked)) portFASTCODE_FUNCTION;
+void xPortSysTickHandler(void) portFASTCODE_FUNCTION;
 void vPortSVCHandler(void) __attribute__((naked));
 
 /*
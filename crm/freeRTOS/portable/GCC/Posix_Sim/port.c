@@ -0,0 +1,522 @@
+/**
+ * @file port.c
+ * @brief FreeRTOS 主机确定性仿真移植层实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 线程模型:
+ *       - 每个任务一个pthread，pxPortInitialiseStack创建线程并把线程描述符地址
+ *         存放在FreeRTOS任务栈顶(TCB的第一个成员pxTopOfStack指向它)；
+ *         任务代码实际运行在主机线程栈上，FreeRTOS任务栈只保留这两个字
+ *       - 同一时刻只有s_pxRunning指向的线程在运行，其余线程在各自的条件变量上等待，
+ *         交接顺序完全由调度器决定
+ *       - 调用vTaskStartScheduler的主线程此后充当中断上下文: 任务忙等或空闲跨过
+ *         节拍边界时把控制交给主线程，由它执行外设中断(vApplicationSimTickHook)与
+ *         xTaskIncrementTick，再切换到pxCurrentTCB对应的线程
+ *       - 无节拍空闲(ulPortSimSuppressTicks)期间节拍边界照常到来，但只执行外设中断，
+ *         不执行内核节拍，相当于目标板延长SysTick重装值后WFI被外设中断唤醒
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* 每个任务线程的主机栈大小(字节)，printf等C库调用需要远大于目标板的栈 */
+#ifndef portSIM_THREAD_STACK_SIZE
+#define portSIM_THREAD_STACK_SIZE (256U * 1024U)
+#endif
+
+/* 默认挂死检测时间(主机秒) */
+#ifndef portSIM_STALL_SECONDS
+#define portSIM_STALL_SECONDS 10U
+#endif
+
+/* SysTick的异常号 */
+#define portSIM_SYSTICK_IPSR 15U
+
+/* FreeRTOS任务栈中存放线程描述符所需的字数 */
+#define portSIM_SLOT_WORDS ((sizeof(void *) + sizeof(StackType_t) - 1U) / sizeof(StackType_t))
+
+/**
+ * ============================================================================
+ * 私有类型与变量
+ * ============================================================================
+ */
+
+typedef struct SimThread
+{
+    pthread_t xThread;
+    pthread_cond_t xCond;
+    TaskFunction_t pxCode;
+    void *pvParameters;
+    int iExit; /* 任务已删除，线程下次被唤醒时退出 */
+} SimThread_t;
+
+/* tasks.c中的当前任务(第一个成员为pxTopOfStack) */
+extern void *volatile pxCurrentTCB;
+
+static pthread_mutex_t xSimMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* 当前允许运行的线程 */
+static SimThread_t *volatile s_pxRunning = NULL;
+
+/* 本线程的描述符(主线程为s_xIsrThread) */
+static __thread SimThread_t *s_pxSelf = NULL;
+
+/* 主线程(调度器启动后的中断上下文) */
+static SimThread_t s_xIsrThread;
+
+static BaseType_t s_xStarted = pdFALSE;
+
+/* 模拟时间与节拍 */
+static uint64_t s_ullCycles = 0;
+static uint64_t s_ullNextTick = 0;
+static uint32_t s_ulCyclesPerTick = 1;
+static uint64_t s_ullTicks = 0;
+static uint64_t s_ullSwitches = 0;
+static uint64_t s_ullIrqs = 0;
+
+/* 无节拍空闲: 期间的节拍边界只执行外设中断 */
+static BaseType_t s_xSuppress = pdFALSE;
+static uint64_t s_ullSuppressed = 0;
+
+/* 中断屏蔽与挂起状态 */
+static UBaseType_t s_uxCriticalNesting = 0;
+static uint32_t s_ulBasePri = 0;
+static uint32_t s_ulPriMask = 0;
+static uint32_t s_ulIpsr = 0;
+static BaseType_t s_xTickPending = pdFALSE;
+static BaseType_t s_xSwitchPending = pdFALSE;
+
+static uint32_t s_ulStallSeconds = portSIM_STALL_SECONDS;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static SimThread_t *prvThreadOf(void *pxTCB)
+{
+    StackType_t *pxTop = *(StackType_t *volatile *)pxTCB;
+    SimThread_t *pxThread;
+
+    memcpy(&pxThread, pxTop, sizeof(pxThread));
+    return pxThread;
+}
+
+static BaseType_t prvMasked(void)
+{
+    return (s_ulBasePri != 0 || s_ulPriMask != 0) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief 把运行权交给pxNext，等待再次轮到本线程
+ */
+static void prvSwitchTo(SimThread_t *pxNext)
+{
+    SimThread_t *pxSelf = s_pxSelf;
+    int iExit;
+
+    if (pxNext == pxSelf)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&xSimMutex);
+    s_ullSwitches++;
+    s_pxRunning = pxNext;
+    pthread_cond_signal(&pxNext->xCond);
+    while (s_pxRunning != pxSelf && pxSelf->iExit == 0)
+    {
+        pthread_cond_wait(&pxSelf->xCond, &xSimMutex);
+    }
+    iExit = pxSelf->iExit;
+    pthread_mutex_unlock(&xSimMutex);
+
+    if (iExit != 0)
+    {
+        /* 任务已被删除，描述符不再被任何TCB引用 */
+        pthread_cond_destroy(&pxSelf->xCond);
+        free(pxSelf);
+        pthread_exit(NULL);
+    }
+}
+
+/**
+ * @brief 任务上下文: 执行挂起的切换请求
+ */
+static void prvSwitchContext(void)
+{
+    s_xSwitchPending = pdFALSE;
+    vTaskSwitchContext();
+    prvSwitchTo(prvThreadOf(pxCurrentTCB));
+}
+
+/**
+ * @brief 任务上下文解除屏蔽后: 先交出挂起的节拍，再执行挂起的切换
+ */
+static void prvServicePending(void)
+{
+    if (s_xStarted == pdFALSE || s_pxSelf == &s_xIsrThread || prvMasked() != pdFALSE)
+    {
+        return;
+    }
+    if (s_xTickPending != pdFALSE)
+    {
+        prvSwitchTo(&s_xIsrThread);
+    }
+    else if (s_xSwitchPending != pdFALSE)
+    {
+        prvSwitchContext();
+    }
+}
+
+/**
+ * @brief 中断上下文: 执行一个节拍
+ */
+static void prvTick(void)
+{
+    s_xTickPending = pdFALSE;
+    if (s_xSuppress != pdFALSE)
+    {
+        s_ullSuppressed++;
+    }
+    else
+    {
+        s_ullTicks++;
+    }
+    s_ulIpsr = portSIM_SYSTICK_IPSR;
+    vApplicationSimTickHook();
+    if (s_xSuppress == pdFALSE && xTaskIncrementTick() != pdFALSE)
+    {
+        s_xSwitchPending = pdTRUE;
+    }
+    s_ulIpsr = 0;
+}
+
+static void *prvTaskThread(void *pvArg)
+{
+    SimThread_t *pxSelf = (SimThread_t *)pvArg;
+
+    s_pxSelf = pxSelf;
+
+    pthread_mutex_lock(&xSimMutex);
+    while (s_pxRunning != pxSelf && pxSelf->iExit == 0)
+    {
+        pthread_cond_wait(&pxSelf->xCond, &xSimMutex);
+    }
+    pthread_mutex_unlock(&xSimMutex);
+
+    if (pxSelf->iExit == 0)
+    {
+        pxSelf->pxCode(pxSelf->pvParameters);
+
+        /* 任务函数不允许返回 */
+        configASSERT(0);
+        vTaskDelete(NULL);
+    }
+
+    pthread_cond_destroy(&pxSelf->xCond);
+    free(pxSelf);
+    return NULL;
+}
+
+/**
+ * @brief 挂死检测: 任务不调用任何阻塞/忙等接口的死循环会让模拟时间停止
+ */
+static void *prvStallThread(void *pvArg)
+{
+    uint64_t ullLast = (uint64_t)-1;
+    uint32_t ulIdle = 0;
+
+    (void)pvArg;
+
+    for (;;)
+    {
+        /* 无节拍空闲期间节拍数不变，以模拟时间判断 */
+        uint64_t ullNow = __atomic_load_n(&s_ullCycles, __ATOMIC_RELAXED);
+
+        sleep(1);
+        if (s_ulStallSeconds == 0 || ullNow != ullLast)
+        {
+            ullLast = ullNow;
+            ulIdle = 0;
+            continue;
+        }
+        if (++ulIdle >= s_ulStallSeconds)
+        {
+            fprintf(stderr, "[sim] stalled at tick %llu in task %s (interrupts %s)\n",
+                    (unsigned long long)__atomic_load_n(&s_ullTicks, __ATOMIC_RELAXED),
+                    (pxCurrentTCB != NULL) ? pcTaskGetName(NULL) : "-",
+                    prvMasked() ? "masked" : "enabled");
+            exit(3);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * ============================================================================
+ * 移植层接口
+ * ============================================================================
+ */
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    SimThread_t *pxThread = calloc(1, sizeof(SimThread_t));
+    pthread_attr_t xAttr;
+
+    configASSERT(pxThread != NULL);
+    pxThread->pxCode = pxCode;
+    pxThread->pvParameters = pvParameters;
+    pthread_cond_init(&pxThread->xCond, NULL);
+
+    pthread_attr_init(&xAttr);
+    pthread_attr_setstacksize(&xAttr, portSIM_THREAD_STACK_SIZE);
+    pthread_attr_setdetachstate(&xAttr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&pxThread->xThread, &xAttr, prvTaskThread, pxThread) != 0)
+    {
+        fprintf(stderr, "[sim] pthread_create failed\n");
+        exit(1);
+    }
+    pthread_attr_destroy(&xAttr);
+
+    pxTopOfStack -= portSIM_SLOT_WORDS - 1U;
+    memcpy(pxTopOfStack, &pxThread, sizeof(pxThread));
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    pthread_t xStall;
+
+    s_pxSelf = &s_xIsrThread;
+    pthread_cond_init(&s_xIsrThread.xCond, NULL);
+
+    s_ulCyclesPerTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    s_ullNextTick = s_ullCycles + s_ulCyclesPerTick;
+    s_uxCriticalNesting = 0;
+    s_ulBasePri = 0;
+    s_xStarted = pdTRUE;
+
+    if (pthread_create(&xStall, NULL, prvStallThread, NULL) == 0)
+    {
+        pthread_detach(xStall);
+    }
+
+    /* 主线程从此只在节拍到期时运行 */
+    for (;;)
+    {
+        prvSwitchTo(prvThreadOf(pxCurrentTCB));
+
+        while (s_xTickPending != pdFALSE)
+        {
+            prvTick();
+        }
+        if (s_xSwitchPending != pdFALSE)
+        {
+            s_xSwitchPending = pdFALSE;
+            vTaskSwitchContext();
+        }
+    }
+
+    return 0;
+}
+
+void vPortEndScheduler(void)
+{
+    /* 仿真结束由仿真层直接退出进程 */
+    exit(0);
+}
+
+void vPortYield(void)
+{
+    s_xSwitchPending = pdTRUE;
+    prvServicePending();
+}
+
+void vPortEnterCritical(void)
+{
+    s_ulBasePri = 1;
+    s_uxCriticalNesting++;
+
+    /* 同ARM_CM4F: 非中断安全版本，在中断中调用即断言(中断中须用taskENTER_CRITICAL_FROM_ISR) */
+    if (s_uxCriticalNesting == 1)
+    {
+        configASSERT(s_ulIpsr == 0);
+    }
+}
+
+void vPortExitCritical(void)
+{
+    configASSERT(s_uxCriticalNesting != 0);
+    s_uxCriticalNesting--;
+    if (s_uxCriticalNesting == 0)
+    {
+        vPortSimSetBASEPRI(0);
+    }
+}
+
+uint32_t ulPortSimRaiseBASEPRI(void)
+{
+    uint32_t ulOld = s_ulBasePri;
+
+    s_ulBasePri = 1;
+    return ulOld;
+}
+
+void vPortSimSetBASEPRI(uint32_t ulNewMaskValue)
+{
+    s_ulBasePri = ulNewMaskValue;
+    prvServicePending();
+}
+
+uint32_t ulPortSimGetPRIMASK(void)
+{
+    return s_ulPriMask;
+}
+
+void vPortSimSetPRIMASK(uint32_t ulPriMask)
+{
+    s_ulPriMask = ulPriMask;
+    prvServicePending();
+}
+
+uint32_t ulPortSimGetIPSR(void)
+{
+    return s_ulIpsr;
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+    return (s_ulIpsr != 0) ? pdTRUE : pdFALSE;
+}
+
+void vPortSimCleanUpTCB(void *pxTCB)
+{
+    SimThread_t *pxThread = prvThreadOf(pxTCB);
+
+    pthread_mutex_lock(&xSimMutex);
+    pxThread->iExit = 1;
+    pthread_cond_signal(&pxThread->xCond);
+    pthread_mutex_unlock(&xSimMutex);
+}
+
+uint64_t ullPortSimCycles(void)
+{
+    return s_ullCycles;
+}
+
+void vPortSimConsume(uint32_t ulCycles)
+{
+    uint64_t ullTarget = s_ullCycles + ulCycles;
+
+    if (s_xStarted == pdFALSE)
+    {
+        s_ullCycles = ullTarget;
+        return;
+    }
+
+    /* 目标时刻为绝对时间: 被抢占期间其他任务消耗的时间同样计入本次等待 */
+    while (s_ullNextTick <= ullTarget)
+    {
+        s_ullCycles = s_ullNextTick;
+        s_ullNextTick += s_ulCyclesPerTick;
+        s_xTickPending = pdTRUE;
+
+        /* 中断上下文或屏蔽期间: 节拍只挂起一次，解除屏蔽/中断返回后执行 */
+        if (s_pxSelf != &s_xIsrThread && prvMasked() == pdFALSE)
+        {
+            prvSwitchTo(&s_xIsrThread);
+        }
+    }
+    if (s_ullCycles < ullTarget)
+    {
+        s_ullCycles = ullTarget;
+    }
+}
+
+void vPortSimClockUpdate(void)
+{
+    uint32_t ulNew = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    uint64_t ullRemain;
+
+    if (s_xStarted != pdFALSE)
+    {
+        /* 同目标板AppPower_ClockUpdate: 当前节拍的剩余部分按新频率换算 */
+        ullRemain = (s_ullNextTick - s_ullCycles) * ulNew / s_ulCyclesPerTick;
+        s_ullNextTick = s_ullCycles + ((ullRemain != 0) ? ullRemain : 1U);
+    }
+    s_ulCyclesPerTick = ulNew;
+}
+
+uint32_t ulPortSimIdle(void)
+{
+    uint32_t ulCycles = (uint32_t)(s_ullNextTick - s_ullCycles);
+
+    vPortSimConsume(ulCycles);
+    return ulCycles;
+}
+
+uint32_t ulPortSimSuppressTicks(uint32_t ulTicks, BaseType_t (*pxAbort)(void))
+{
+    uint32_t ulSkipped = 0;
+
+    configASSERT(s_pxSelf != &s_xIsrThread);
+
+    /* 最后一个节拍边界恢复为内核节拍，由它唤醒到期的任务 */
+    s_xSuppress = pdTRUE;
+    while (ulSkipped + 1U < ulTicks)
+    {
+        vPortSimConsume((uint32_t)(s_ullNextTick - s_ullCycles));
+        ulSkipped++;
+        if (pxAbort != NULL && pxAbort() != pdFALSE)
+        {
+            break;
+        }
+    }
+    s_xSuppress = pdFALSE;
+    return ulSkipped;
+}
+
+void vPortSimRunISR(int32_t lIRQn, void (*pvHandler)(void))
+{
+    uint32_t ulSaved = s_ulIpsr;
+
+    configASSERT(s_pxSelf == &s_xIsrThread);
+    s_ulIpsr = (uint32_t)(16 + lIRQn);
+    s_ullIrqs++;
+    pvHandler();
+    s_ulIpsr = ulSaved;
+}
+
+uint64_t ullPortSimTicks(void)
+{
+    return s_ullTicks;
+}
+
+uint64_t ullPortSimSuppressedTicks(void)
+{
+    return s_ullSuppressed;
+}
+
+uint64_t ullPortSimSwitches(void)
+{
+    return s_ullSwitches;
+}
+
+uint64_t ullPortSimIrqs(void)
+{
+    return s_ullIrqs;
+}
+
+void vPortSimSetStallTimeout(uint32_t ulSeconds)
+{
+    s_ulStallSeconds = ulSeconds;
+}
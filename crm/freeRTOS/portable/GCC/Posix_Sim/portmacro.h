@@ -0,0 +1,158 @@
+/**
+ * @file portmacro.h
+ * @brief FreeRTOS 主机确定性仿真移植层(POSIX线程)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个任务对应一个pthread，任意时刻只有一个线程在运行，切换由本移植层显式交接；
+ *       主线程在调度器启动后充当"中断上下文"，执行节拍与外设中断
+ *       时间为模拟时间(内核时钟周期)，只在任务调用vPortSimConsume(忙等、空闲)时推进，
+ *       任务代码本身视为不耗时；因此同样的输入得到逐字节相同的输出，与主机负载无关
+ *       BASEPRI/PRIMASK屏蔽期间到期的节拍只挂起一次(与SysTick的挂起位相同)
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* 类型定义(栈仍按32位字计，与目标板的栈预算一致) */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+
+/* 主机指针为64位，heap_4/tasks.c中的地址对齐运算需要完整宽度 */
+#define portPOINTER_SIZE_TYPE	uintptr_t
+
+/* 架构相关 */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+
+/* 调度: 任务上下文中立即切换(屏蔽期间挂起)，中断上下文中挂起到中断返回 */
+extern void vPortYield( void );
+#define portYIELD()					vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )		portEND_SWITCHING_ISR( x )
+
+/* 临界区: 模拟BASEPRI，没有异步中断，屏蔽只决定节拍与切换何时生效 */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern uint32_t ulPortSimRaiseBASEPRI( void );
+extern void vPortSimSetBASEPRI( uint32_t ulNewMaskValue );
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSimRaiseBASEPRI()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortSimSetBASEPRI(x)
+#define portDISABLE_INTERRUPTS()				( ( void ) ulPortSimRaiseBASEPRI() )
+#define portENABLE_INTERRUPTS()					vPortSimSetBASEPRI(0)
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+/* 任务删除后结束对应线程 */
+extern void vPortSimCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortSimCleanUpTCB( pxTCB )
+
+/* 优先级位图(与ARM_CM4F相同，CLZ由编译器内建函数完成) */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.
+	#endif
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+#define portNOP()
+
+#define portINLINE	__inline
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+
+/* 是否处于中断上下文(主线程执行节拍/外设中断期间) */
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+/**
+ * ============================================================================
+ * 仿真接口(供mcu/sim使用)
+ * ============================================================================
+ */
+
+/* 当前模拟时间(内核时钟周期，调度器启动前同样累计) */
+extern uint64_t ullPortSimCycles( void );
+
+/* 当前任务忙等ulCycles个周期: 期间到期的节拍照常执行，更高优先级任务可以抢占 */
+extern void vPortSimConsume( uint32_t ulCycles );
+
+/* 内核频率改变后按configCPU_CLOCK_HZ重新计算节拍周期(由AppPower_ClockUpdate调用) */
+extern void vPortSimClockUpdate( void );
+
+/* 空闲: 推进到下一个节拍，返回空闲的周期数(由空闲钩子调用) */
+extern uint32_t ulPortSimIdle( void );
+
+/* 无节拍空闲(由portSUPPRESS_TICKS_AND_SLEEP的实现在调度器挂起时调用):
+ * 模拟时间推进最多ulTicks - 1个节拍周期，期间的节拍边界只执行外设中断(节拍钩子)；
+ * 每个边界后pxAbort返回pdTRUE(有任务就绪)则提前结束；返回跳过的节拍数，
+ * 由调用者vTaskStepTick补齐，下一个节拍边界恢复为内核节拍 */
+extern uint32_t ulPortSimSuppressTicks( uint32_t ulTicks, BaseType_t ( *pxAbort )( void ) );
+
+/* 在中断上下文中执行一个外设中断(IPSR = 16 + lIRQn)，只能从节拍钩子中调用 */
+extern void vPortSimRunISR( int32_t lIRQn, void ( *pvHandler )( void ) );
+
+/* 当前IPSR(0 = 线程模式) */
+extern uint32_t ulPortSimGetIPSR( void );
+
+/* PRIMASK(__disable_irq/__enable_irq) */
+extern uint32_t ulPortSimGetPRIMASK( void );
+extern void vPortSimSetPRIMASK( uint32_t ulPriMask );
+
+/* 已执行的内核节拍数、无节拍空闲跳过的节拍数与任务切换次数 */
+extern uint64_t ullPortSimTicks( void );
+extern uint64_t ullPortSimSuppressedTicks( void );
+extern uint64_t ullPortSimSwitches( void );
+
+/* 已执行的外设中断数(vPortSimRunISR) */
+extern uint64_t ullPortSimIrqs( void );
+
+/* 挂死检测: 连续ulSeconds秒(主机时间)没有节拍则报告当前任务并退出，0=关闭 */
+extern void vPortSimSetStallTimeout( uint32_t ulSeconds );
+
+/* 每个节拍在内核节拍处理前调用(中断上下文)，由仿真层实现 */
+extern void vApplicationSimTickHook( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -362,6 +362,42 @@ size_t xPortGetMinimumEverFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetAllocatedSize( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+
+	configASSERT( pv );
+
+	/* The memory being queried will have a BlockLink_t structure immediately
+	before it. */
+	puc -= xHeapStructSize;
+	pxLink = ( void * ) puc;
+	configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+	return ( pxLink->xBlockSize & ~xBlockAllocatedBit ) - xHeapStructSize;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapWalk( HeapWalkCallback_t pxVisit, void *pvContext )
+{
+BlockLink_t *pxBlock;
+
+	vTaskSuspendAll();
+	{
+		/* The list is empty until the first allocation initialises the heap. */
+		if( pxEnd != NULL )
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				pxVisit( pvContext, pxBlock->xBlockSize );
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -55,6 +55,20 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* start address for the initialization values of the .ccmram section.
+defined in linker script */
+.word  _siccmram
+/* start/end address for the .ccmram section. defined in linker script */
+.word  _sccmram
+.word  _eccmram
+/* start/end address for the .ccmbss section. defined in linker script */
+.word  _sccmbss
+.word  _eccmbss
+/* start address for the load image of the .fastcode section and its
+start/end address in SRAM. defined in linker script */
+.word  _sifastcode
+.word  _sfastcode
+.word  _efastcode
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -99,6 +113,51 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+/* Copy the .ccmram initializers from flash to CCMRAM
+   (CCMDATARAMEN is set after reset, no clock enable needed) */
+  ldr  r0, =_sccmram
+  ldr  r1, =_eccmram
+  ldr  r2, =_siccmram
+  b  LoopCopyCcmInit
+
+CopyCcmInit:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyCcmInit:
+  cmp  r0, r1
+  bcc  CopyCcmInit
+
+/* Zero fill the .ccmbss segment. .noinit is left untouched. */
+  ldr  r2, =_sccmbss
+  ldr  r1, =_eccmbss
+  movs  r3, #0
+  b  LoopFillZeroCcmbss
+
+FillZeroCcmbss:
+  str  r3, [r2], #4
+
+LoopFillZeroCcmbss:
+  cmp  r2, r1
+  bcc  FillZeroCcmbss
+
+/* Copy the .fastcode functions from flash to SRAM (empty unless the
+   performance profile places hot code there, see mem_section.h) */
+  ldr  r0, =_sfastcode
+  ldr  r1, =_efastcode
+  ldr  r2, =_sifastcode
+  b  LoopCopyFastcode
+
+CopyFastcode:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyFastcode:
+  cmp  r0, r1
+  bcc  CopyFastcode
+  dsb
+  isb
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
 /* Call the application's entry point.*/
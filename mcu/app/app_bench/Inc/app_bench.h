@@ -0,0 +1,55 @@
+/**
+ * @file app_bench.h
+ * @brief 内核函数基准用例表头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 用例表(app_bench.c)登记滤波器、格式化、环形缓冲、CRC与总线扇出(0/1/4/8个回调订阅者)等热点内核，
+ *       以及共享数据读取的顺序锁与互斥锁对比(data_seqlock/data_mutex)，
+ *       app_pool定长块与heap_4的分配+释放延迟对比(pool_alloc<大小>/heap4_alloc<大小>，
+ *       heap4_alloc64_frag为空闲链表中有16个放不下请求的空洞时)，
+ *       内存/字符串函数的port与C库对比(<函数>_<port|libc>_<长度>_<目的偏移><源偏移>，
+ *       长度16/64/256/1024，对齐{0,0},{0,1},{3,1})，
+ *       中值与IIR另有复位后第一个样本的用例(filter_median5_reset/filter_iir_reset)，
+ *       由libx/bench测量并输出K行(格式见bench.h)；APP_BENCH=1时main在调度器启动前运行一次
+ *       (早于AppData_Init，总线用例登记的订阅者随后被AppBus_Init清除)
+ *       计时后端(AppBench_Backend)按构建选择:
+ *       - 目标板(app_bench_port.c): DWT周期计数器，单位cyc，频率为SystemCoreClock，
+ *         BENCH_F_IRQ_OFF用例在PRIMASK关中断窗口中测量
+ *       - 主机仿真(mcu/sim/Src/sim_bench.c): clock_gettime(CLOCK_MONOTONIC)，单位ns；
+ *         仿真时间不随任务代码推进，不能用DWT计时，也没有需要屏蔽的异步中断
+ *       两端编译同一份用例表，相同名称的K行可直接对比(目标cyc/主机ns)
+ *       测量前先用固定参考向量核对各滤波器输出的CRC(与mcu/sim/Test/test_filter.c相同)，
+ *       输出"bench: filter vectors ok"或不一致的滤波器；目标板上即验证DSP指令与纯C实现逐位一致
+ */
+
+#ifndef __APP_BENCH_H
+#define __APP_BENCH_H
+
+#include "bench.h"
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 填充计时与输出后端
+ * @author Yukikaze
+ *
+ * @param cfg 后端(warmup/repeat保持0，使用bench.h的默认值)
+ *
+ * @note 目标板实现见app_bench_port.c，仿真构建由sim_bench.c替换
+ */
+void AppBench_Backend(Bench_Config_TypeDef *cfg);
+
+/**
+ * @brief 运行全部用例并输出K行
+ * @author Yukikaze
+ *
+ * @note 调度器启动前调用(main中BSP_Init之后)，样本不会被任务切换打断
+ */
+void AppBench_Run(void);
+
+#endif /* __APP_BENCH_H */
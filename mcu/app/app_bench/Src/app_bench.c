@@ -0,0 +1,574 @@
+/**
+ * @file app_bench.c
+ * @brief 内核函数基准用例表实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 输入为固定种子生成的样本，目标板与主机每次运行的输入相同
+ */
+
+#include "app_bench.h"
+#include "app_bus.h"
+#include "app_data.h"
+#include "app_pool.h"
+#include "semphr.h"
+#include "filter.h"
+#include "ringbuffer.h"
+#include "crc.h"
+#include "__port_config__.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_BENCH_INPUT_LEN 64U  /**< 输入样本数(2的幂) */
+#define APP_BENCH_CRC_LEN 256U   /**< CRC数据长度 */
+#define APP_BENCH_RB_SIZE 256U   /**< 环形缓冲容量 */
+#define APP_BENCH_RB_BLOCK 48U   /**< 块读写长度(不整除容量，覆盖回绕路径) */
+#define APP_BENCH_LINE_LEN 48U   /**< 格式化输出缓冲 */
+#define APP_BENCH_STR_MAX_LEN 1024U /**< 内存/字符串函数的最大长度 */
+#define APP_BENCH_FRAG_BLOCKS 32U  /**< heap_4碎片化用例持有的块数(一半释放为空洞) */
+#define APP_BENCH_FRAG_SIZE 24U    /**< 空洞大小(字节，小于被测请求) */
+
+/* 滤波器参考向量(与mcu/sim/Test/test_filter.c的Test_Golden相同):
+ * LCG高16位的满量程输入，每256个样本复位一次中值与IIR，各滤波器输出的CRC-32 */
+#define APP_BENCH_VEC_LEN 1024U
+#define APP_BENCH_VEC_RESET 256U
+#define APP_BENCH_VEC_MA8 0x60B198F1UL
+#define APP_BENCH_VEC_MA2X8 0x4911B030UL
+#define APP_BENCH_VEC_IIR 0x875B97C2UL
+#define APP_BENCH_VEC_MEDIAN5 0x73E4BE81UL
+#define APP_BENCH_VEC_CIC3R8 0x2088A8D4UL
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 输入: 2000附近带噪声的ADC样本 */
+static int16_t s_sInput[APP_BENCH_INPUT_LEN];
+static uint32_t s_ulInputIdx = 0;
+
+static uint8_t s_ucData[APP_BENCH_CRC_LEN];
+
+static Filter_Median_TypeDef s_xMedian;
+static Filter_MA_TypeDef s_xMa;
+static Filter_MA2_TypeDef s_xMa2;
+static Filter_IIR_TypeDef s_xIir;
+static Filter_CIC_TypeDef s_xCic;
+
+static rb_t s_xRb;
+static uint8_t s_ucRbBuf[APP_BENCH_RB_SIZE];
+static uint8_t s_ucBlock[APP_BENCH_RB_BLOCK];
+
+static char s_cLine[APP_BENCH_LINE_LEN];
+
+/* 总线扇出的订阅者数 */
+static const uint8_t s_ucFanout[] = {0U, 1U, 4U, APP_BUS_SUB_NUM};
+static AppTime_Stamp_TypeDef s_xStamp;
+
+/* 顺序锁之前的读法: 互斥锁保护拷贝(只用于对比) */
+static SemaphoreHandle_t s_xDataMutex;
+static StaticSemaphore_t s_xDataMutexBuf;
+static SensorData_TypeDef s_xSnapshot;
+
+/* 内存/字符串函数的两个工作缓冲，留出偏移与memmove重叠的余量 */
+static uint8_t s_ucStrA[APP_BENCH_STR_MAX_LEN + 32U] __attribute__((aligned(8)));
+static uint8_t s_ucStrB[APP_BENCH_STR_MAX_LEN + 32U] __attribute__((aligned(8)));
+
+/* 定长块分配的请求大小(各对应app_pool的一个等级) */
+static const uint16_t s_usAllocSize[] = {APP_POOL_SMALL_SIZE, APP_POOL_MEDIUM_SIZE, APP_POOL_LARGE_SIZE};
+
+/* heap_4碎片化用例持有的块(奇数下标) */
+static void *s_pvFrag[APP_BENCH_FRAG_BLOCKS];
+static uint8_t s_ucFragged = 0;
+
+/* 防止结果被优化掉 */
+static volatile int32_t s_lSink;
+
+/**
+ * ============================================================================
+ * 被测内核
+ * ============================================================================
+ */
+
+static int16_t AppBench_Next(void)
+{
+    return s_sInput[(s_ulInputIdx++) & (APP_BENCH_INPUT_LEN - 1U)];
+}
+
+static void AppBench_Median(void *arg)
+{
+    s_lSink = Filter_Median_Update((Filter_Median_TypeDef *)arg, AppBench_Next());
+}
+
+static void AppBench_Ma(void *arg)
+{
+    s_lSink = Filter_MA_Update((Filter_MA_TypeDef *)arg, AppBench_Next());
+}
+
+static void AppBench_Ma2(void *arg)
+{
+    int16_t x = AppBench_Next();
+
+    s_lSink = (int32_t)Filter_MA2_Update((Filter_MA2_TypeDef *)arg, FILTER_PACK16(x, 4095 - x));
+}
+
+static void AppBench_Iir(void *arg)
+{
+    s_lSink = Filter_IIR_Update((Filter_IIR_TypeDef *)arg, AppBench_Next());
+}
+
+/**
+ * @brief 复位后的第一个样本(填满窗口/直接输出)，task_light在电平阶跃时走这条路径
+ */
+static void AppBench_MedianReset(void *arg)
+{
+    Filter_Median_Reset((Filter_Median_TypeDef *)arg);
+    s_lSink = Filter_Median_Update((Filter_Median_TypeDef *)arg, AppBench_Next());
+}
+
+static void AppBench_IirReset(void *arg)
+{
+    Filter_IIR_Reset((Filter_IIR_TypeDef *)arg);
+    s_lSink = Filter_IIR_Update((Filter_IIR_TypeDef *)arg, AppBench_Next());
+}
+
+static void AppBench_Cic(void *arg)
+{
+    int32_t out = 0;
+
+    s_lSink = Filter_CIC_Update((Filter_CIC_TypeDef *)arg, AppBench_Next(), &out) + out;
+}
+
+/**
+ * @brief 每个样本从空缓冲开始，读写指针的回绕位置固定
+ */
+static void AppBench_RbReset(void *arg)
+{
+    (void)rbclear((rbptr_t)arg, APP_BENCH_RB_SIZE);
+}
+
+static void AppBench_RbByte(void *arg)
+{
+    rbptr_t rb = (rbptr_t)arg;
+
+    (void)rbput(rb, (unsigned char)s_ulInputIdx++);
+    s_lSink = rbget(rb);
+}
+
+static void AppBench_RbBlock(void *arg)
+{
+    rbptr_t rb = (rbptr_t)arg;
+
+    (void)rbwrite(rb, s_ucBlock, APP_BENCH_RB_BLOCK);
+    s_lSink = rbread(rb, s_ucBlock, APP_BENCH_RB_BLOCK);
+}
+
+static void AppBench_Crc(void *arg)
+{
+    (void)arg;
+    s_lSink = (int32_t)CRC32_Update(0U, s_ucData, APP_BENCH_CRC_LEN);
+}
+
+/**
+ * @brief 总线重新初始化并登记N个回调订阅者(阈值0，每次发布都投递)
+ *
+ * @note 在AppData_Init(其中的AppBus_Init)之前运行，登记的订阅者随后被清除
+ */
+static void AppBench_BusCallback(void *ctx, const AppBus_Sample_TypeDef *sample)
+{
+    (void)ctx;
+    s_lSink = sample->value;
+}
+
+static void AppBench_BusSetup(void *arg)
+{
+    uint8_t n = *(const uint8_t *)arg;
+
+    AppBus_Init();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        (void)AppBus_SubscribeCallback(APP_BUS_MASK_ALL, 0U, AppBench_BusCallback, NULL);
+    }
+}
+
+/**
+ * @brief 发布一次(槽分配 + 阈值判断 + N次回调)
+ */
+static void AppBench_BusPublish(void *arg)
+{
+    (void)arg;
+    (void)AppBus_Publish(APP_BUS_TOPIC_LIGHT_ADC, (int32_t)(s_ulInputIdx++ & 0xFFFU), 1U, &s_xStamp);
+}
+
+/**
+ * @brief 共享数据读取: 顺序锁(AppData_GetSensorData)与互斥锁(加锁 -> 拷贝 -> 解锁)
+ */
+static void AppBench_DataSeqLock(void *arg)
+{
+    (void)arg;
+    AppData_GetSensorData(&s_xSnapshot);
+}
+
+static void AppBench_DataMutex(void *arg)
+{
+    (void)arg;
+    if (xSemaphoreTake(s_xDataMutex, 0) == pdTRUE)
+    {
+        memcpy(&s_xSnapshot, &g_SensorData, sizeof(s_xSnapshot));
+        (void)xSemaphoreGive(s_xDataMutex);
+    }
+}
+
+/**
+ * @brief 分配并立即释放: app_pool定长块(O(1))与heap_4首次适配(遍历空闲链表，挂起调度器)
+ */
+static void AppBench_PoolAlloc(void *arg)
+{
+    void *p = AppPool_Alloc(*(const uint16_t *)arg);
+
+    s_lSink = (int32_t)(uintptr_t)p;
+    (void)AppPool_Free(p);
+}
+
+static void AppBench_HeapAlloc(void *arg)
+{
+    void *p = pvPortMalloc(*(const uint16_t *)arg);
+
+    s_lSink = (int32_t)(uintptr_t)p;
+    vPortFree(p);
+}
+
+/**
+ * @brief 在heap_4中留下APP_BENCH_FRAG_BLOCKS/2个放不下请求的空洞(只做一次，AppBench_Run结束时归还)
+ */
+static void AppBench_HeapFragment(void *arg)
+{
+    (void)arg;
+    if (s_ucFragged)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < APP_BENCH_FRAG_BLOCKS; i++)
+    {
+        s_pvFrag[i] = pvPortMalloc(APP_BENCH_FRAG_SIZE);
+    }
+    for (uint32_t i = 0; i < APP_BENCH_FRAG_BLOCKS; i += 2U)
+    {
+        vPortFree(s_pvFrag[i]);
+        s_pvFrag[i] = NULL;
+    }
+    s_ucFragged = 1;
+}
+
+/**
+ * @brief 内存/字符串函数: __port_config__的字对齐实现(port)与C库(libc)
+ *
+ * @note 参数为函数、长度与目的/源相对字边界的偏移；经函数指针调用，
+ *       避免编译器把C库调用按常量长度展开
+ */
+typedef enum
+{
+    APP_BENCH_OP_memcpy = 0,
+    APP_BENCH_OP_memmove,
+    APP_BENCH_OP_memset,
+    APP_BENCH_OP_memcmp,
+    APP_BENCH_OP_memchr,
+    APP_BENCH_OP_strlen,
+} AppBench_StrOp_t;
+
+typedef struct
+{
+    uint8_t op;   /**< AppBench_StrOp_t */
+    uint8_t da;   /**< 目的偏移 */
+    uint8_t sa;   /**< 源偏移 */
+    uint16_t len; /**< 长度(字节) */
+} AppBench_Str_TypeDef;
+
+typedef struct
+{
+    void *(*cpy)(void *, const void *, unsigned long int);
+    void *(*move)(void *, const void *, unsigned long int);
+    void *(*set)(void *, int, unsigned long int);
+    int (*cmp)(const void *, const void *, unsigned long int);
+    void *(*chr)(const void *, int, unsigned long int);
+    unsigned long int (*len)(const char *);
+} AppBench_StrImpl_TypeDef;
+
+static void *AppBench_LibcMemcpy(void *d, const void *s, unsigned long int n) { return memcpy(d, s, n); }
+static void *AppBench_LibcMemmove(void *d, const void *s, unsigned long int n) { return memmove(d, s, n); }
+static void *AppBench_LibcMemset(void *d, int c, unsigned long int n) { return memset(d, c, n); }
+static int AppBench_LibcMemcmp(const void *a, const void *b, unsigned long int n) { return memcmp(a, b, n); }
+static void *AppBench_LibcMemchr(const void *s, int c, unsigned long int n) { return memchr(s, c, n); }
+static unsigned long int AppBench_LibcStrlen(const char *s) { return strlen(s); }
+
+static volatile const AppBench_StrImpl_TypeDef s_xStrImpl[2] = {
+    {_port_memcpy_, _port_memmove_, _port_memset_, _port_memcmp_, _port_memchr_, _port_strlen_},
+    {AppBench_LibcMemcpy, AppBench_LibcMemmove, AppBench_LibcMemset,
+     AppBench_LibcMemcmp, AppBench_LibcMemchr, AppBench_LibcStrlen},
+};
+
+/**
+ * @brief 每个样本前重置缓冲: 内容相同且不含0与0xA5，strlen/memchr的目标字节放在末尾
+ *
+ * @note memmove会改写源区域，必须每个样本重置
+ */
+static void AppBench_StrSetup(void *arg)
+{
+    const AppBench_Str_TypeDef *p = (const AppBench_Str_TypeDef *)arg;
+
+    for (uint32_t i = 0; i < sizeof(s_ucStrA); i++)
+    {
+        s_ucStrA[i] = (uint8_t)(0x10U + (i % 0x70U));
+        s_ucStrB[i] = s_ucStrA[i];
+    }
+    if (p->op == APP_BENCH_OP_strlen)
+    {
+        s_ucStrA[p->da + p->len] = 0U;
+    }
+    else if (p->op == APP_BENCH_OP_memchr)
+    {
+        s_ucStrA[p->da + p->len - 1U] = 0xA5U;
+    }
+}
+
+static void AppBench_StrCall(const volatile AppBench_StrImpl_TypeDef *impl, const AppBench_Str_TypeDef *p)
+{
+    uint8_t *d = s_ucStrA + p->da;
+
+    switch (p->op)
+    {
+    case APP_BENCH_OP_memcpy:
+        s_lSink = (int32_t)(uintptr_t)impl->cpy(d, s_ucStrB + p->sa, p->len);
+        break;
+    case APP_BENCH_OP_memmove:
+        /* 同一缓冲内向后重叠移动，走反向复制路径 */
+        s_lSink = (int32_t)(uintptr_t)impl->move(d + 16U, s_ucStrA + p->sa, p->len);
+        break;
+    case APP_BENCH_OP_memset:
+        s_lSink = (int32_t)(uintptr_t)impl->set(d, 0x5A, p->len);
+        break;
+    case APP_BENCH_OP_memcmp:
+        s_lSink = impl->cmp(d, s_ucStrB + p->sa, p->len);
+        break;
+    case APP_BENCH_OP_memchr:
+        s_lSink = (int32_t)(uintptr_t)impl->chr(d, 0xA5, p->len);
+        break;
+    default:
+        s_lSink = (int32_t)impl->len((const char *)d);
+        break;
+    }
+}
+
+static void AppBench_StrPort(void *arg)
+{
+    AppBench_StrCall(&s_xStrImpl[0], (const AppBench_Str_TypeDef *)arg);
+}
+
+static void AppBench_StrLibc(void *arg)
+{
+    AppBench_StrCall(&s_xStrImpl[1], (const AppBench_Str_TypeDef *)arg);
+}
+
+/**
+ * @brief 内存/字符串用例组合: 16/64/256/1024字节 x 对齐{0,0},{0,1},{3,1}
+ *
+ * @note 单指针函数(memset/memchr/strlen)没有源对齐，只测目的偏移0与3
+ */
+#define APP_BENCH_STR_LENS(X, op, da, sa) \
+    X(op, 16, da, sa) X(op, 64, da, sa) X(op, 256, da, sa) X(op, 1024, da, sa)
+#define APP_BENCH_STR_PAIR(X, op) \
+    APP_BENCH_STR_LENS(X, op, 0, 0) APP_BENCH_STR_LENS(X, op, 0, 1) APP_BENCH_STR_LENS(X, op, 3, 1)
+#define APP_BENCH_STR_SINGLE(X, op) \
+    APP_BENCH_STR_LENS(X, op, 0, 0) APP_BENCH_STR_LENS(X, op, 3, 0)
+#define APP_BENCH_STR_ALL(X)                                                             \
+    APP_BENCH_STR_PAIR(X, memcpy) APP_BENCH_STR_PAIR(X, memmove) APP_BENCH_STR_SINGLE(X, memset) \
+    APP_BENCH_STR_PAIR(X, memcmp) APP_BENCH_STR_SINGLE(X, memchr) APP_BENCH_STR_SINGLE(X, strlen)
+
+#define APP_BENCH_STR_PARAM(op, len, da, sa) \
+    static const AppBench_Str_TypeDef s_xStr_##op##_##len##_##da##sa = {APP_BENCH_OP_##op, da, sa, len};
+
+APP_BENCH_STR_ALL(APP_BENCH_STR_PARAM)
+
+/* 名称: <函数>_<port|libc>_<长度>_<目的偏移><源偏移> */
+#define APP_BENCH_STR_CASE(op, len, da, sa)                                                    \
+    BENCH_CASE_IRQ_OFF(#op "_port_" #len "_" #da #sa, AppBench_StrSetup, AppBench_StrPort,     \
+                       (void *)&s_xStr_##op##_##len##_##da##sa, 1U),                           \
+    BENCH_CASE_IRQ_OFF(#op "_libc_" #len "_" #da #sa, AppBench_StrSetup, AppBench_StrLibc,     \
+                       (void *)&s_xStr_##op##_##len##_##da##sa, 1U),
+
+/**
+ * @brief OLED光照行(同task_display)
+ */
+static void AppBench_FmtDisplay(void *arg)
+{
+    (void)arg;
+    s_lSink = snprintf(s_cLine, sizeof(s_cLine), "Lux: %lu %d%%",
+                       (unsigned long)(1200U + (s_ulInputIdx++ & 0xFFU)), 42);
+}
+
+/**
+ * @brief 串口CSV行(同Task_Prof的P行)
+ */
+static void AppBench_FmtCsv(void *arg)
+{
+    (void)arg;
+    s_lSink = snprintf(s_cLine, sizeof(s_cLine), "P,%lu,%lu,%lu,%u\r\n",
+                       (unsigned long)s_ulInputIdx++, 60000UL, 927UL, 3U);
+}
+
+/**
+ * ============================================================================
+ * 用例注册表
+ * ============================================================================
+ *
+ * 短内核在关中断窗口中测量(一次中断就会淹没结果)；snprintf耗时较长，保持中断开启
+ */
+static const Bench_Case_TypeDef s_xBenchCases[] = {
+    /*               名称              准备              内核                 参数        次数 */
+    BENCH_CASE_IRQ_OFF("filter_median5", NULL,             AppBench_Median,     &s_xMedian, 16U),
+    BENCH_CASE_IRQ_OFF("filter_ma8",     NULL,             AppBench_Ma,         &s_xMa,     16U),
+    BENCH_CASE_IRQ_OFF("filter_ma2x8",   NULL,             AppBench_Ma2,        &s_xMa2,    16U),
+    BENCH_CASE_IRQ_OFF("filter_iir",     NULL,             AppBench_Iir,        &s_xIir,    16U),
+    BENCH_CASE_IRQ_OFF("filter_median5_reset", NULL,       AppBench_MedianReset, &s_xMedian, 16U),
+    BENCH_CASE_IRQ_OFF("filter_iir_reset", NULL,           AppBench_IirReset,   &s_xIir,    16U),
+    BENCH_CASE_IRQ_OFF("filter_cic3r8",  NULL,             AppBench_Cic,        &s_xCic,    16U),
+    BENCH_CASE_IRQ_OFF("rb_byte",        AppBench_RbReset, AppBench_RbByte,     &s_xRb,     32U),
+    BENCH_CASE_IRQ_OFF("rb_block48",     AppBench_RbReset, AppBench_RbBlock,    &s_xRb,     8U),
+    BENCH_CASE_IRQ_OFF("crc32_256",      NULL,             AppBench_Crc,        NULL,       1U),
+    BENCH_CASE_IRQ_OFF("bus_fanout0",    AppBench_BusSetup, AppBench_BusPublish, (void *)&s_ucFanout[0], 8U),
+    BENCH_CASE_IRQ_OFF("bus_fanout1",    AppBench_BusSetup, AppBench_BusPublish, (void *)&s_ucFanout[1], 8U),
+    BENCH_CASE_IRQ_OFF("bus_fanout4",    AppBench_BusSetup, AppBench_BusPublish, (void *)&s_ucFanout[2], 8U),
+    BENCH_CASE_IRQ_OFF("bus_fanout8",    AppBench_BusSetup, AppBench_BusPublish, (void *)&s_ucFanout[3], 8U),
+    BENCH_CASE_IRQ_OFF("data_seqlock",   NULL,             AppBench_DataSeqLock, NULL,      8U),
+    BENCH_CASE_IRQ_OFF("data_mutex",     NULL,             AppBench_DataMutex,  NULL,       8U),
+    BENCH_CASE_IRQ_OFF("pool_alloc16",   NULL,             AppBench_PoolAlloc,  (void *)&s_usAllocSize[0], 8U),
+    BENCH_CASE_IRQ_OFF("pool_alloc64",   NULL,             AppBench_PoolAlloc,  (void *)&s_usAllocSize[1], 8U),
+    BENCH_CASE_IRQ_OFF("pool_alloc256",  NULL,             AppBench_PoolAlloc,  (void *)&s_usAllocSize[2], 8U),
+    BENCH_CASE_IRQ_OFF("heap4_alloc16",  NULL,             AppBench_HeapAlloc,  (void *)&s_usAllocSize[0], 8U),
+    BENCH_CASE_IRQ_OFF("heap4_alloc64",  NULL,             AppBench_HeapAlloc,  (void *)&s_usAllocSize[1], 8U),
+    BENCH_CASE_IRQ_OFF("heap4_alloc256", NULL,             AppBench_HeapAlloc,  (void *)&s_usAllocSize[2], 8U),
+    BENCH_CASE_IRQ_OFF("heap4_alloc64_frag", AppBench_HeapFragment, AppBench_HeapAlloc, (void *)&s_usAllocSize[1], 8U),
+    BENCH_CASE(        "fmt_display",    NULL,             AppBench_FmtDisplay, NULL,       4U),
+    BENCH_CASE(        "fmt_csv",        NULL,             AppBench_FmtCsv,     NULL,       4U),
+    APP_BENCH_STR_ALL(APP_BENCH_STR_CASE)
+};
+
+/**
+ * @brief 滤波器参考向量自检，输出一行结果
+ *
+ * @note 目标板上滤波器走__SMLAD/__QADD16/__QSUB16，主机上走纯C实现；
+ *       两端CRC都等于表中的值即逐位一致
+ */
+static void AppBench_FilterVectors(void)
+{
+    static const char *const name[5] = {"ma8", "ma2x8", "iir", "median5", "cic3r8"};
+    static const uint32_t expect[5] = {APP_BENCH_VEC_MA8, APP_BENCH_VEC_MA2X8, APP_BENCH_VEC_IIR,
+                                       APP_BENCH_VEC_MEDIAN5, APP_BENCH_VEC_CIC3R8};
+    uint32_t crc[5] = {0};
+    uint32_t seed = 0x26UL;
+    uint32_t bad = 0;
+
+    (void)Filter_MA_Init(&s_xMa, 8U);
+    (void)Filter_MA2_Init(&s_xMa2, 8U);
+    (void)Filter_IIR_Init(&s_xIir, 8192U);
+    (void)Filter_Median_Init(&s_xMedian, 5U);
+    (void)Filter_CIC_Init(&s_xCic, 3U, 8U);
+
+    for (uint32_t n = 0; n < APP_BENCH_VEC_LEN; n++)
+    {
+        int16_t x;
+        int16_t y;
+        uint32_t y2;
+        int32_t out;
+
+        seed = seed * 1664525UL + 1013904223UL;
+        x = (int16_t)(seed >> 16);
+        if (n % APP_BENCH_VEC_RESET == APP_BENCH_VEC_RESET - 1U)
+        {
+            Filter_IIR_Reset(&s_xIir);
+            Filter_Median_Reset(&s_xMedian);
+        }
+        y = Filter_MA_Update(&s_xMa, x);
+        crc[0] = CRC32_Update(crc[0], &y, sizeof(y));
+        y2 = Filter_MA2_Update(&s_xMa2, FILTER_PACK16(x >> 4, (int16_t)~x >> 4));
+        crc[1] = CRC32_Update(crc[1], &y2, sizeof(y2));
+        y = Filter_IIR_Update(&s_xIir, x);
+        crc[2] = CRC32_Update(crc[2], &y, sizeof(y));
+        y = Filter_Median_Update(&s_xMedian, x);
+        crc[3] = CRC32_Update(crc[3], &y, sizeof(y));
+        if (Filter_CIC_Update(&s_xCic, x, &out))
+        {
+            crc[4] = CRC32_Update(crc[4], &out, sizeof(out));
+        }
+    }
+
+    for (uint32_t i = 0; i < 5U; i++)
+    {
+        if (crc[i] != expect[i])
+        {
+            printf("bench: filter vector %s crc %08lx, expected %08lx\r\n", name[i],
+                   (unsigned long)crc[i], (unsigned long)expect[i]);
+            bad++;
+        }
+    }
+    if (bad == 0)
+    {
+        printf("bench: filter vectors ok\r\n");
+    }
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppBench_Run(void)
+{
+    Bench_Config_TypeDef cfg = {0};
+    uint32_t seed = 0x12345678UL;
+
+    for (uint32_t i = 0; i < APP_BENCH_INPUT_LEN; i++)
+    {
+        seed = seed * 1664525UL + 1013904223UL;
+        s_sInput[i] = (int16_t)(2000 + (int32_t)((seed >> 24) & 0x3FU) - 32);
+    }
+    for (uint32_t i = 0; i < APP_BENCH_CRC_LEN; i++)
+    {
+        s_ucData[i] = (uint8_t)(i * 7U + 3U);
+    }
+    s_ulInputIdx = 0;
+
+    AppBench_FilterVectors();
+
+    (void)Filter_Median_Init(&s_xMedian, 5U);
+    (void)Filter_MA_Init(&s_xMa, 8U);
+    (void)Filter_MA2_Init(&s_xMa2, 8U);
+    (void)Filter_IIR_Init(&s_xIir, 8192U);
+    (void)Filter_CIC_Init(&s_xCic, 3U, 8U);
+
+    s_xDataMutex = xSemaphoreCreateMutexStatic(&s_xDataMutexBuf);
+
+    /* App_Init稍后会再次初始化，用例的分配统计不会留在M行中 */
+    AppPool_Init();
+
+    s_xRb.bf = s_ucRbBuf;
+    (void)rbclear(&s_xRb, APP_BENCH_RB_SIZE);
+
+    AppBench_Backend(&cfg);
+    Bench_Run(&cfg, s_xBenchCases, sizeof(s_xBenchCases) / sizeof(s_xBenchCases[0]));
+
+    for (uint32_t i = 0; i < APP_BENCH_FRAG_BLOCKS; i++)
+    {
+        vPortFree(s_pvFrag[i]);
+        s_pvFrag[i] = NULL;
+    }
+    s_ucFragged = 0;
+}
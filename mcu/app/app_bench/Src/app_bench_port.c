@@ -0,0 +1,41 @@
+/**
+ * @file app_bench_port.c
+ * @brief 内核函数基准的目标板后端(DWT周期计数器)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 仿真构建由mcu/sim/Src/sim_bench.c替换
+ */
+
+#include "app_bench.h"
+#include "stm32f4xx.h"
+#include "core_delay.h"
+
+#include <stdio.h>
+
+/**
+ * @brief 关中断(PRIMASK)，返回之前的状态
+ */
+static uint32_t AppBench_IrqOff(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+}
+
+static void AppBench_IrqRestore(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+void AppBench_Backend(Bench_Config_TypeDef *cfg)
+{
+    /* CYCCNT已由BSP_Init中的CPU_TS_TmrInit使能 */
+    cfg->clock = CPU_TS_TmrRd;
+    cfg->print = printf;
+    cfg->mask = AppBench_IrqOff;
+    cfg->unmask = AppBench_IrqRestore;
+    cfg->unit = "cyc";
+    cfg->hz = SystemCoreClock;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file app_boot.h
+ * @brief 分阶段启动框架头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 板级与应用初始化由阶段注册表描述(见main.c)，每个阶段记录DWT起止时间与返回值:
+ *       - 同步阶段(APP_BOOT_SYNC): 调度器启动前按表顺序执行，只放任务/中断立即依赖、
+ *         且不需要等待的初始化(GPIO、串口、ADC、标定表等)
+ *       - 异步阶段(APP_BOOT_LANE_x): 调度器启动后在低优先级工作任务中执行，
+ *         同一工作任务内按表顺序，不同工作任务之间相互重叠；慢速设备(OLED刷屏、
+ *         LSE起振、Flash日志挂载)放在这里，应用任务启动后立即开始采集
+ *       - 每个阶段完成后置位provides(就绪位)，依赖它的阶段或任务用AppBoot_Wait等待；
+ *         失败同样置位(避免等待方永久阻塞)，由AppBoot_Failed查询
+ *       全部异步阶段完成后工作任务自行删除；时间线由Task_Prof输出(AppBoot_Report):
+ *         B,<idx>,<name>,<lane>,<start_us>,<end_us>,<rc>
+ *         B,-,<mark>,-,<us>,<us>,0
+ *       时间原点为CPU_TS_TmrInit(系统时钟配置完成后)，之前的复位与时钟切换约2ms未计入
+ */
+
+#ifndef __APP_BOOT_H
+#define __APP_BOOT_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_BOOT_MAX_STAGES 16         /**< 注册表最大阶段数 */
+#define APP_BOOT_MAX_MARKS 8           /**< 里程碑数上限 */
+#define APP_BOOT_LANES 2               /**< 异步工作任务数 */
+#define APP_BOOT_LANE_STACK_SIZE 256   /**< 工作任务栈大小(字) */
+#define APP_BOOT_LANE_PRIORITY 1       /**< 工作任务优先级(与Task_Prof相同，只使用空闲时间) */
+
+/* 阶段执行位置 */
+#define APP_BOOT_SYNC 0   /**< 调度器启动前同步执行 */
+#define APP_BOOT_LANE_A 1 /**< 异步工作任务A */
+#define APP_BOOT_LANE_B 2 /**< 异步工作任务B */
+
+/* 就绪位(阶段的provides/needs，任务用AppBoot_Wait等待；事件组最多24位) */
+#define APP_BOOT_RES_DISPLAY (1UL << 0) /**< OLED初始化完成，可以绘制 */
+#define APP_BOOT_RES_STOP (1UL << 1)    /**< RTC唤醒就绪，空闲时可进入STOP */
+#define APP_BOOT_RES_LOG (1UL << 2)     /**< Flash日志已挂载 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 阶段初始化函数
+ *
+ * @return int 0=成功，其余值记入时间线(负值视为失败)
+ */
+typedef int (*AppBoot_Func_t)(void);
+
+/**
+ * @brief 阶段注册表项
+ */
+typedef struct
+{
+    const char *name;     /**< 阶段名称(时间线输出) */
+    AppBoot_Func_t init;  /**< 初始化函数 */
+    uint8_t lane;         /**< 执行位置(APP_BOOT_SYNC / APP_BOOT_LANE_x) */
+    uint32_t needs;       /**< 开始前等待的就绪位(仅异步阶段) */
+    uint32_t provides;    /**< 完成后置位的就绪位 */
+} AppBoot_Stage_TypeDef;
+
+/**
+ * @brief 生成注册表项
+ */
+#define APP_BOOT_STAGE(name, init, lane, needs, provides) \
+    {(name), (init), (lane), (needs), (provides)}
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 执行全部同步阶段，并创建异步工作任务
+ * @author Yukikaze
+ *
+ * @param stages 阶段注册表(须为静态存储，异步阶段在调度器启动后读取)
+ * @param count 表项数
+ * @return BaseType_t pdPASS=成功, pdFAIL=表项过多或工作任务创建失败
+ *
+ * @note 在CPU_TS_TmrInit之后、vTaskStartScheduler之前调用；
+ *       同步阶段失败不会中止启动，结果记入时间线
+ */
+BaseType_t AppBoot_Run(const AppBoot_Stage_TypeDef *stages, uint32_t count);
+
+/**
+ * @brief 等待就绪位
+ * @author Yukikaze
+ *
+ * @param res 就绪位(APP_BOOT_RES_x，可组合)
+ * @param timeout 最长等待节拍数
+ * @return BaseType_t pdTRUE=全部就绪, pdFALSE=超时
+ */
+BaseType_t AppBoot_Wait(uint32_t res, TickType_t timeout);
+
+/**
+ * @brief 查询提供就绪位的阶段是否失败
+ * @author Yukikaze
+ *
+ * @param res 就绪位
+ * @return uint8_t 1=提供其中任一位的阶段返回了负值
+ */
+uint8_t AppBoot_Failed(uint32_t res);
+
+/**
+ * @brief 记录一个里程碑(同名只记录第一次，任务或中断中调用)
+ * @author Yukikaze
+ *
+ * @param name 名称(须为静态字符串)
+ */
+void AppBoot_Mark(const char *name);
+
+/**
+ * @brief 全部阶段是否已完成
+ * @author Yukikaze
+ */
+uint8_t AppBoot_Done(void);
+
+/**
+ * @brief 串口输出启动时间线(B行)
+ * @author Yukikaze
+ *
+ * @note 使用printf，只能在任务中调用(Task_Prof在启动完成后输出一次)
+ */
+void AppBoot_Report(void);
+
+#endif /* __APP_BOOT_H */
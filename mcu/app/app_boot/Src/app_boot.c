@@ -0,0 +1,289 @@
+/**
+ * @file app_boot.c
+ * @brief 分阶段启动框架实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 就绪位使用一个静态事件组；工作任务的栈与TCB为静态存储，
+ *       任务完成后删除自身，存储不再使用(启动只发生一次)
+ */
+
+#include "app_boot.h"
+#include "core_delay.h"
+#include "event_groups.h"
+#include "app_task.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有类型
+ * ============================================================================
+ */
+
+/**
+ * @brief 阶段执行记录
+ */
+typedef struct
+{
+    uint64_t start; /**< 开始时间戳(DWT周期) */
+    uint64_t end;   /**< 结束时间戳(DWT周期) */
+    int rc;         /**< 返回值 */
+    uint8_t done;   /**< 是否已执行 */
+} AppBoot_Record_TypeDef;
+
+/**
+ * @brief 里程碑
+ */
+typedef struct
+{
+    const char *name; /**< 名称 */
+    uint64_t ts;      /**< 时间戳(DWT周期) */
+} AppBoot_Mark_TypeDef;
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+static const AppBoot_Stage_TypeDef *s_pxStages = NULL;
+static uint32_t s_ulCount = 0;
+static AppBoot_Record_TypeDef s_xRecords[APP_BOOT_MAX_STAGES];
+
+static AppBoot_Mark_TypeDef s_xMarks[APP_BOOT_MAX_MARKS];
+static uint32_t s_ulMarkCount = 0;
+
+/* 就绪位与失败位 */
+static EventGroupHandle_t s_xReady = NULL;
+static uint32_t s_ulFailed = 0;
+
+/* 尚未完成的工作任务数 */
+static volatile uint32_t s_ulLanesLeft = 0;
+static uint8_t s_ucStarted = 0;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticEventGroup_t s_xReadyBuf;
+static APP_TASK_STACK_SECTION StackType_t s_xLaneStack[APP_BOOT_LANES][APP_BOOT_LANE_STACK_SIZE];
+static APP_TASK_TCB_SECTION StaticTask_t s_xLaneTcb[APP_BOOT_LANES];
+#endif
+
+static const char *const s_pcLaneName[APP_BOOT_LANES] = {"Boot_A", "Boot_B"};
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static uint32_t AppBoot_CyclesToUs(uint64_t cycles)
+{
+    return (uint32_t)CPU_TS_ToUs(cycles);
+}
+
+/**
+ * @brief 执行一个阶段并记录时间
+ */
+static void AppBoot_Exec(uint32_t idx)
+{
+    const AppBoot_Stage_TypeDef *stage = &s_pxStages[idx];
+    AppBoot_Record_TypeDef *rec = &s_xRecords[idx];
+    int rc;
+
+    rec->start = CPU_TS_Read64();
+    rc = stage->init();
+    rec->end = CPU_TS_Read64();
+    rec->rc = rc;
+    rec->done = 1;
+
+    if (rc < 0)
+    {
+        taskENTER_CRITICAL();
+        s_ulFailed |= stage->provides;
+        taskEXIT_CRITICAL();
+    }
+    if (stage->provides != 0)
+    {
+        xEventGroupSetBits(s_xReady, stage->provides);
+    }
+}
+
+/**
+ * @brief 异步工作任务: 按表顺序执行本任务的阶段，完成后删除自身
+ */
+static void AppBoot_Lane(void *pvParameters)
+{
+    uint8_t lane = (uint8_t)(uintptr_t)pvParameters;
+
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        if (s_pxStages[i].lane != lane)
+        {
+            continue;
+        }
+        if (s_pxStages[i].needs != 0)
+        {
+            xEventGroupWaitBits(s_xReady, s_pxStages[i].needs, pdFALSE, pdTRUE, portMAX_DELAY);
+        }
+        AppBoot_Exec(i);
+    }
+
+    taskENTER_CRITICAL();
+    s_ulLanesLeft--;
+    taskEXIT_CRITICAL();
+    if (s_ulLanesLeft == 0)
+    {
+        AppBoot_Mark("ready");
+    }
+
+    vTaskDelete(NULL);
+}
+
+static BaseType_t AppBoot_CreateLane(uint8_t lane)
+{
+    TaskHandle_t handle;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    handle = xTaskCreateStatic(AppBoot_Lane, s_pcLaneName[lane - 1U], APP_BOOT_LANE_STACK_SIZE,
+                               (void *)(uintptr_t)lane, APP_BOOT_LANE_PRIORITY,
+                               s_xLaneStack[lane - 1U], &s_xLaneTcb[lane - 1U]);
+#else
+    if (xTaskCreate(AppBoot_Lane, s_pcLaneName[lane - 1U], APP_BOOT_LANE_STACK_SIZE,
+                    (void *)(uintptr_t)lane, APP_BOOT_LANE_PRIORITY, &handle) != pdPASS)
+    {
+        handle = NULL;
+    }
+#endif
+    return (handle != NULL) ? pdPASS : pdFAIL;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+BaseType_t AppBoot_Run(const AppBoot_Stage_TypeDef *stages, uint32_t count)
+{
+    uint8_t used[APP_BOOT_LANES] = {0};
+
+    if (count > APP_BOOT_MAX_STAGES)
+    {
+        return pdFAIL;
+    }
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    s_xReady = xEventGroupCreateStatic(&s_xReadyBuf);
+#else
+    s_xReady = xEventGroupCreate();
+#endif
+    if (s_xReady == NULL)
+    {
+        return pdFAIL;
+    }
+
+    s_pxStages = stages;
+    s_ulCount = count;
+    s_ucStarted = 1;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (stages[i].lane == APP_BOOT_SYNC)
+        {
+            AppBoot_Exec(i);
+        }
+        else if (stages[i].lane <= APP_BOOT_LANES)
+        {
+            used[stages[i].lane - 1U] = 1;
+        }
+    }
+
+    for (uint8_t lane = 1; lane <= APP_BOOT_LANES; lane++)
+    {
+        if (!used[lane - 1U])
+        {
+            continue;
+        }
+        if (AppBoot_CreateLane(lane) != pdPASS)
+        {
+            return pdFAIL;
+        }
+        s_ulLanesLeft++;
+    }
+    if (s_ulLanesLeft == 0)
+    {
+        AppBoot_Mark("ready");
+    }
+
+    return pdPASS;
+}
+
+BaseType_t AppBoot_Wait(uint32_t res, TickType_t timeout)
+{
+    EventBits_t bits;
+
+    if (s_xReady == NULL)
+    {
+        return pdFALSE;
+    }
+    bits = xEventGroupWaitBits(s_xReady, (EventBits_t)res, pdFALSE, pdTRUE, timeout);
+    return ((bits & res) == res) ? pdTRUE : pdFALSE;
+}
+
+uint8_t AppBoot_Failed(uint32_t res)
+{
+    return (s_ulFailed & res) != 0;
+}
+
+void AppBoot_Mark(const char *name)
+{
+    uint64_t ts = CPU_TS_Read64();
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+
+    for (uint32_t i = 0; i < s_ulMarkCount; i++)
+    {
+        if (strcmp(s_xMarks[i].name, name) == 0)
+        {
+            taskEXIT_CRITICAL_FROM_ISR(saved);
+            return;
+        }
+    }
+    if (s_ulMarkCount < APP_BOOT_MAX_MARKS)
+    {
+        s_xMarks[s_ulMarkCount].name = name;
+        s_xMarks[s_ulMarkCount].ts = ts;
+        s_ulMarkCount++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+uint8_t AppBoot_Done(void)
+{
+    return s_ucStarted && s_ulLanesLeft == 0;
+}
+
+void AppBoot_Report(void)
+{
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        const AppBoot_Record_TypeDef *rec = &s_xRecords[i];
+
+        if (!rec->done)
+        {
+            continue;
+        }
+        printf("B,%lu,%s,%u,%lu,%lu,%d\r\n",
+               (unsigned long)i,
+               s_pxStages[i].name,
+               (unsigned)s_pxStages[i].lane,
+               (unsigned long)AppBoot_CyclesToUs(rec->start),
+               (unsigned long)AppBoot_CyclesToUs(rec->end),
+               rec->rc);
+    }
+    for (uint32_t i = 0; i < s_ulMarkCount; i++)
+    {
+        uint32_t us = AppBoot_CyclesToUs(s_xMarks[i].ts);
+
+        printf("B,-,%s,-,%lu,%lu,0\r\n", s_xMarks[i].name, (unsigned long)us, (unsigned long)us);
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file app_calib.h
+ * @brief 传感器标定模块头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 光照: ADC计数 -> lux 的分段线性标定表
+ *       - 标定表保存在Flash扇区11，带魔数与CRC校验；无效时使用内置的GL5528典型曲线
+ *       - VREFINT补偿: 将ADC计数换算为VDDA=3.3V时的等效值，消除电源漂移
+ *       - 所有逐样本换算均为乘法+移位，除法只在建表/更新VREFINT时执行一次
+ *       - 现场标定: AppCalib_CaptureLight逐点采集(照度计读数 + 当前滤波值)，
+ *         AppCalib_CommitLight排序后写入Flash；由串口控制台驱动(见task_prof.h)
+ */
+
+#ifndef __APP_CALIB_H
+#define __APP_CALIB_H
+
+#include <stdint.h>
+#include "lut.h"
+#include "bsp_flash.h"
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_CALIB_FLASH_ADDR BSP_FLASH_CALIB_ADDR /**< 标定表存放地址 */
+#define APP_CALIB_MAGIC 0x4C55584CUL              /**< 魔数 "LXUL" */
+#define APP_CALIB_VERSION 1                       /**< 表格式版本 */
+
+/* VREFINT补偿: 1=启用, 0=关闭
+ * 光敏分压电路若由VDDA本身供电(比例测量)，电源漂移已自然抵消，应关闭 */
+#define APP_CALIB_USE_VREFINT 1
+
+/* 出厂VREFINT标定值地址(VDDA=3.3V, 30℃下采得，12位) */
+#define APP_CALIB_VREFINT_CAL_ADDR 0x1FFF7A2AUL
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief Flash中的光照标定表
+ *
+ * @note 大小为4字节整数倍，按字写入
+ *       crc 覆盖 crc 之前的全部字段
+ */
+typedef struct
+{
+    uint32_t magic;               /**< APP_CALIB_MAGIC */
+    uint16_t version;             /**< APP_CALIB_VERSION */
+    uint16_t count;               /**< 标定点数 */
+    uint16_t adc[LUT_MAX_POINTS]; /**< ADC计数(严格递增，VDDA=3.3V等效值) */
+    int32_t lux[LUT_MAX_POINTS];  /**< 对应照度(lux) */
+    uint32_t crc;                 /**< CRC-32 */
+} AppCalib_Light_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化标定模块
+ * @author Yukikaze
+ *
+ * @return int 0=使用Flash中的标定表, 1=Flash无有效表，使用内置默认表
+ *
+ * @note 不依赖RTOS，可在BSP初始化阶段调用
+ */
+int AppCalib_Init(void);
+
+/**
+ * @brief 将新的光照标定表写入Flash并立即生效
+ * @author Yukikaze
+ *
+ * @param adc ADC计数数组(严格递增)
+ * @param lux 照度数组
+ * @param count 点数(2~LUT_MAX_POINTS)
+ * @return int 0=成功, -1=参数错误或Flash擦写失败
+ *
+ * @note 需擦除128KB扇区，期间CPU停顿1~2秒，只能在低优先级任务中调用
+ */
+int AppCalib_SaveLightTable(const uint16_t *adc, const int32_t *lux, uint8_t count);
+
+/**
+ * @brief 采集一个光照标定点(暂存，不写Flash)
+ * @author Yukikaze
+ *
+ * @param adc 当前滤波后的ADC计数(按当前VREFINT系数换算为VDDA=3.3V等效值后保存)
+ * @param lux 照度计读数
+ * @return int 暂存的点数, -1=已满(LUT_MAX_POINTS)
+ *
+ * @note 暂存点按ADC计数排序，同一计数再次采集时覆盖照度；
+ *       与AppCalib_CommitLight/AppCalib_DiscardLight只能在同一任务中调用
+ */
+int AppCalib_CaptureLight(uint16_t adc, int32_t lux);
+
+/**
+ * @brief 将暂存的标定点写入Flash并立即生效
+ * @author Yukikaze
+ *
+ * @return int 写入的点数, -1=点数不足2、斜率越界或Flash擦写失败(暂存点保留)
+ *
+ * @note 内部调用AppCalib_SaveLightTable，调用约束相同；成功后清空暂存
+ */
+int AppCalib_CommitLight(void);
+
+/**
+ * @brief 丢弃暂存的标定点
+ * @author Yukikaze
+ */
+void AppCalib_DiscardLight(void);
+
+/**
+ * @brief 用新的VREFINT读数更新电源补偿系数
+ * @author Yukikaze
+ *
+ * @param raw VREFINT转换值(PhotoResistor_ReadVrefint)
+ *
+ * @note 读数偏离出厂值超过25%视为无效，保持原系数
+ */
+void AppCalib_UpdateVrefint(uint16_t raw);
+
+/**
+ * @brief 光照ADC计数 -> 照度
+ * @author Yukikaze
+ *
+ * @param adc 滤波后的ADC计数
+ * @return uint32_t 照度(lux)
+ */
+uint32_t AppCalib_LightToLux(uint16_t adc);
+
+/**
+ * @brief 光照ADC计数 -> 亮度百分比
+ * @author Yukikaze
+ *
+ * @param adc 滤波后的ADC计数
+ * @return uint8_t 0~100，值越大越亮(非线性，仅用于直观显示)
+ */
+uint8_t AppCalib_LightToPercent(uint16_t adc);
+
+#endif /* __APP_CALIB_H */
@@ -0,0 +1,230 @@
+/**
+ * @file app_calib.c
+ * @brief 传感器标定模块实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_calib.h"
+#include "crc.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有定义
+ * ============================================================================
+ */
+
+#define APP_CALIB_ADC_MAX 4095U
+
+/* x*100/4095 ≈ (x*1601 + 32768) >> 16，0~4095内与四舍五入结果最多差1 */
+#define APP_CALIB_PERCENT_SCALE 1601U
+
+/* 内置默认表: GL5528 + 10k分压的典型曲线(ADC越大越暗) */
+static const uint16_t s_usDefaultAdc[] = {
+    42, 64, 96, 164, 243, 357, 582, 822,
+    1129, 1628, 2048, 2467, 2966, 3273, 4095,
+};
+static const int32_t s_lDefaultLux[] = {
+    20000, 10000, 5000, 2000, 1000, 500, 200, 100,
+    50, 20, 10, 5, 2, 1, 0,
+};
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 查找表双缓冲: 新表在未生效的一份中建好后切换指针(对齐的32位写，读者看到的总是完整的表)，
+ * 建表失败时生效的表保持不变 */
+static LUT_TypeDef s_xLightLUT[2];
+static const LUT_TypeDef *volatile s_pxLightLUT = &s_xLightLUT[0];
+
+/* VREFINT补偿系数(Q16)，65536 = 不补偿 */
+static uint32_t s_ulVddaScaleQ16 = 1UL << 16;
+
+/* 现场标定的暂存点(按ADC计数升序) */
+static uint16_t s_usCapAdc[LUT_MAX_POINTS];
+static int32_t s_lCapLux[LUT_MAX_POINTS];
+static uint8_t s_ucCapCount = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 在未生效的一份中建表，成功后切换为当前表
+ *
+ * @note 建表在标定命令(Task_Prof，优先级1)中执行，读者Task_Light(优先级3)可随时抢占；
+ *       读者只在切换前后各看到一张完整的表。两次切换之间读者必须已用完旧表，
+ *       读者优先级高于写者即满足
+ */
+static int AppCalib_Publish(const uint16_t *adc, const int32_t *lux, uint8_t count)
+{
+    LUT_TypeDef *next = (s_pxLightLUT == &s_xLightLUT[0]) ? &s_xLightLUT[1] : &s_xLightLUT[0];
+
+    if (LUT_Build(next, adc, lux, count) != 0)
+    {
+        return -1;
+    }
+    s_pxLightLUT = next;
+    return 0;
+}
+
+/**
+ * @brief 校验Flash中的标定表并建表
+ */
+static int AppCalib_LoadLight(const AppCalib_Light_TypeDef *t)
+{
+    if (t->magic != APP_CALIB_MAGIC || t->version != APP_CALIB_VERSION ||
+        t->count < 2 || t->count > LUT_MAX_POINTS)
+    {
+        return -1;
+    }
+    if (CRC32_Update(0, t, offsetof(AppCalib_Light_TypeDef, crc)) != t->crc)
+    {
+        return -1;
+    }
+    return AppCalib_Publish(t->adc, t->lux, (uint8_t)t->count);
+}
+
+/**
+ * @brief 将ADC计数换算为VDDA=3.3V时的等效值
+ */
+static inline uint16_t AppCalib_Compensate(uint16_t adc)
+{
+#if APP_CALIB_USE_VREFINT
+    uint32_t v = ((uint32_t)adc * s_ulVddaScaleQ16 + 0x8000UL) >> 16;
+
+    return (uint16_t)((v > APP_CALIB_ADC_MAX) ? APP_CALIB_ADC_MAX : v);
+#else
+    return adc;
+#endif
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int AppCalib_Init(void)
+{
+    s_ulVddaScaleQ16 = 1UL << 16;
+
+    if (AppCalib_LoadLight((const AppCalib_Light_TypeDef *)APP_CALIB_FLASH_ADDR) == 0)
+    {
+        return 0;
+    }
+
+    (void)AppCalib_Publish(s_usDefaultAdc, s_lDefaultLux,
+                           (uint8_t)(sizeof(s_usDefaultAdc) / sizeof(s_usDefaultAdc[0])));
+    return 1;
+}
+
+int AppCalib_SaveLightTable(const uint16_t *adc, const int32_t *lux, uint8_t count)
+{
+    AppCalib_Light_TypeDef t;
+    LUT_TypeDef check;
+
+    /* 先建表校验，避免把非法数据写进Flash */
+    if (adc == NULL || lux == NULL || LUT_Build(&check, adc, lux, count) != 0)
+    {
+        return -1;
+    }
+
+    memset(&t, 0xFF, sizeof(t));
+    t.magic = APP_CALIB_MAGIC;
+    t.version = APP_CALIB_VERSION;
+    t.count = count;
+    memcpy(t.adc, adc, count * sizeof(adc[0]));
+    memcpy(t.lux, lux, count * sizeof(lux[0]));
+    t.crc = CRC32_Update(0, &t, offsetof(AppCalib_Light_TypeDef, crc));
+
+    if (BSP_Flash_EraseSector(APP_CALIB_FLASH_ADDR) != 0 ||
+        BSP_Flash_Program(APP_CALIB_FLASH_ADDR, (const uint32_t *)&t,
+                          sizeof(t) / sizeof(uint32_t)) != 0)
+    {
+        return -1;
+    }
+
+    /* 回读校验并切换到新表 */
+    return AppCalib_LoadLight((const AppCalib_Light_TypeDef *)APP_CALIB_FLASH_ADDR);
+}
+
+int AppCalib_CaptureLight(uint16_t adc, int32_t lux)
+{
+    uint16_t v = AppCalib_Compensate(adc);
+    uint8_t i = 0;
+
+    while (i < s_ucCapCount && s_usCapAdc[i] < v)
+    {
+        i++;
+    }
+    if (i < s_ucCapCount && s_usCapAdc[i] == v)
+    {
+        s_lCapLux[i] = lux;
+        return s_ucCapCount;
+    }
+    if (s_ucCapCount >= LUT_MAX_POINTS)
+    {
+        return -1;
+    }
+
+    /* 插入到第i个位置 */
+    memmove(&s_usCapAdc[i + 1], &s_usCapAdc[i], (s_ucCapCount - i) * sizeof(s_usCapAdc[0]));
+    memmove(&s_lCapLux[i + 1], &s_lCapLux[i], (s_ucCapCount - i) * sizeof(s_lCapLux[0]));
+    s_usCapAdc[i] = v;
+    s_lCapLux[i] = lux;
+    return ++s_ucCapCount;
+}
+
+int AppCalib_CommitLight(void)
+{
+    uint8_t count = s_ucCapCount;
+
+    if (AppCalib_SaveLightTable(s_usCapAdc, s_lCapLux, count) != 0)
+    {
+        return -1;
+    }
+    s_ucCapCount = 0;
+    return count;
+}
+
+void AppCalib_DiscardLight(void)
+{
+    s_ucCapCount = 0;
+}
+
+void AppCalib_UpdateVrefint(uint16_t raw)
+{
+    uint32_t cal = *(const volatile uint16_t *)APP_CALIB_VREFINT_CAL_ADDR;
+
+    /* 未烧录出厂值或读数超出±25%(VDDA约2.6~4.4V)，视为无效 */
+    if (cal == 0 || cal > APP_CALIB_ADC_MAX ||
+        (uint32_t)raw * 4U < cal * 3U || (uint32_t)raw * 4U > cal * 5U)
+    {
+        return;
+    }
+
+    /* VDDA/3.3V = cal/raw，每次更新只做一次除法 */
+    s_ulVddaScaleQ16 = ((cal << 16) + raw / 2U) / raw;
+}
+
+uint32_t AppCalib_LightToLux(uint16_t adc)
+{
+    int32_t lux = LUT_Interp(s_pxLightLUT, AppCalib_Compensate(adc));
+
+    return (lux > 0) ? (uint32_t)lux : 0;
+}
+
+uint8_t AppCalib_LightToPercent(uint16_t adc)
+{
+    uint32_t v = AppCalib_Compensate(adc);
+
+    return (uint8_t)(100U - ((v * APP_CALIB_PERCENT_SCALE + 0x8000UL) >> 16));
+}
@@ -0,0 +1,107 @@
+/**
+ * @file app_clock.h
+ * @brief 系统时钟档位与运行时调频头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 系统时钟由一张档位表描述(APP_CLOCK_PROFILE_HZ，从高到低)，启动时按实际的PLL输入
+ *       (HSE 25MHz，起振失败时HSI 16MHz)用Pll_Solve求出每档的PLL/Flash/调压器/分频参数，
+ *       因此HSE失效的板子同样能运行在最高档，只是精度降为HSI的约1%
+ *       运行时切换(AppClock_Set)在关中断下完成(PLL重新锁定约0.2ms)，随后重新计算:
+ *       - SysTick重装值与无节拍空闲参数(AppPower_ClockUpdate)
+ *       - DWT时间戳的频率段(CPU_TS_ClockChanged，微秒换算保持连续)
+ *       - 串口波特率与硬件I2C时序
+ *       DHT11/OLED等忙等延时每次调用时按SystemCoreClock计算，不需要处理；
+ *       ADC时钟随APB2变化，采样率按比例降低
+ *
+ *       调频策略(APP_CLOCK_GOVERNOR=1): Task_Prof每个窗口末给出IDLE任务占用率，
+ *       连续APP_CLOCK_DOWN_WINDOWS个窗口不低于APP_CLOCK_DOWN_IDLE时降一档，
+ *       低于APP_CLOCK_UP_IDLE时直接回到最高档；启动阶段全部完成之前保持最高档
+ *       切换只在最低优先级任务中进行，此时更高优先级任务都不在I2C/串口传输中间
+ */
+
+#ifndef __APP_CLOCK_H
+#define __APP_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_CLOCK_PROFILE_HZ {180000000UL, 168000000UL, 84000000UL, 48000000UL}
+#define APP_CLOCK_MAX_PROFILES 8      /**< 档位数上限 */
+#define APP_CLOCK_GOVERNOR 1          /**< 是否按空闲占比自动调频 */
+#define APP_CLOCK_MIN_PROFILE 3       /**< 自动调频允许的最低档(档位表下标) */
+#define APP_CLOCK_DOWN_IDLE 900       /**< 空闲不低于此千分比时考虑降档 */
+#define APP_CLOCK_DOWN_WINDOWS 2      /**< 连续满足降档条件的窗口数 */
+#define APP_CLOCK_UP_IDLE 750         /**< 空闲低于此千分比时回到最高档 */
+
+#define APP_CLOCK_NONE 0xFFU          /**< 未运行在任何档位(PLL失败，系统时钟为HSI) */
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 选择PLL输入、求解档位表并切到最高档
+ * @author Yukikaze
+ *
+ * @return int 0=HSE, 1=HSE失败使用HSI, -1=PLL不可用(运行在HSI 16MHz)
+ *
+ * @note main最先调用(代替固定的180MHz配置)，串口尚未初始化，不输出；
+ *       结果由AppClock_Report在启动阶段中输出
+ */
+int AppClock_Init(void);
+
+/**
+ * @brief 输出时钟源与当前频率
+ * @author Yukikaze
+ *
+ * @return int 同AppClock_Init的返回值(作为启动阶段的返回值记入时间线)
+ */
+int AppClock_Report(void);
+
+/**
+ * @brief 切换到指定档位
+ * @author Yukikaze
+ *
+ * @param idx 档位表下标(0=最高档)
+ * @return int 0=成功, -1=档位无效或PLL失败(运行在HSI)
+ *
+ * @note 只能在任务中调用，调用期间关中断约0.2ms；等待串口发送完成后再切换
+ */
+int AppClock_Set(uint32_t idx);
+
+/**
+ * @brief 当前档位(APP_CLOCK_NONE=运行在HSI)
+ * @author Yukikaze
+ */
+uint32_t AppClock_Current(void);
+
+/**
+ * @brief 按本窗口的空闲占比调整档位
+ * @author Yukikaze
+ *
+ * @param idle_permille IDLE任务的CPU千分比
+ * @return int 1=已切换档位, 0=未切换
+ *
+ * @note 由Task_Prof每个窗口末调用；APP_CLOCK_GOVERNOR=0时只返回0
+ */
+int AppClock_Govern(uint32_t idle_permille);
+
+/**
+ * @brief 把当前频率下的CPU千分比折算到最高档
+ * @author Yukikaze
+ *
+ * @param permille 当前频率下的CPU千分比
+ * @return uint32_t 最高档频率下的等效千分比
+ *
+ * @note 任务注册表的CPU预算按最高档给出，降档后占用率按频率比例升高
+ */
+uint32_t AppClock_ScaleLoad(uint32_t permille);
+
+#endif /* __APP_CLOCK_H */
@@ -0,0 +1,206 @@
+/**
+ * @file app_clock.c
+ * @brief 系统时钟档位与运行时调频实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_clock.h"
+#include "stm32f4xx.h"
+#include "app_power.h"
+#include "bsp_clock.h"
+#include "bsp_iic.h"
+#include "bsp_usart.h"
+#include "core_delay.h"
+#include "pll.h"
+#include <stdio.h>
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+static const uint32_t s_ulProfileHz[] = APP_CLOCK_PROFILE_HZ;
+#define APP_CLOCK_PROFILES (sizeof(s_ulProfileHz) / sizeof(s_ulProfileHz[0]))
+
+/* 按实际PLL输入求出的各档配置(求解失败的档位不可用) */
+static Pll_Config_TypeDef s_xProfile[APP_CLOCK_MAX_PROFILES];
+static uint8_t s_ucValid[APP_CLOCK_MAX_PROFILES];
+
+/* 最高可用档与当前档 */
+static uint32_t s_ulTop = APP_CLOCK_NONE;
+static uint32_t s_ulActive = APP_CLOCK_NONE;
+
+static int s_iInitStatus = -1;
+
+/* 连续满足降档条件的窗口数 */
+static uint32_t s_ulQuietWindows = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 下一个更低的可用档(不低于APP_CLOCK_MIN_PROFILE)，没有时返回当前档
+ */
+static uint32_t AppClock_Lower(uint32_t idx)
+{
+    for (uint32_t i = idx + 1U; i < APP_CLOCK_PROFILES && i <= APP_CLOCK_MIN_PROFILE; i++)
+    {
+        if (s_ucValid[i])
+        {
+            return i;
+        }
+    }
+    return idx;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int AppClock_Init(void)
+{
+    int src = BSP_Clock_Init();
+
+    s_ulTop = APP_CLOCK_NONE;
+    s_ulActive = APP_CLOCK_NONE;
+    for (uint32_t i = 0; i < APP_CLOCK_PROFILES && i < APP_CLOCK_MAX_PROFILES; i++)
+    {
+        s_ucValid[i] = (Pll_Solve(BSP_Clock_SrcHz(), s_ulProfileHz[i], &s_xProfile[i]) >= 0);
+        if (s_ucValid[i] && s_ulTop == APP_CLOCK_NONE)
+        {
+            s_ulTop = i;
+        }
+    }
+
+    /* 调度器未启动、中断未使能，直接切换 */
+    if (s_ulTop != APP_CLOCK_NONE && BSP_Clock_Apply(&s_xProfile[s_ulTop]) == 0)
+    {
+        s_ulActive = s_ulTop;
+    }
+
+    s_iInitStatus = (s_ulActive == APP_CLOCK_NONE) ? -1 : src;
+    return s_iInitStatus;
+}
+
+int AppClock_Report(void)
+{
+    printf("Clock: %lu Hz, %s %lu Hz%s, profiles",
+           (unsigned long)SystemCoreClock,
+           (BSP_Clock_Src() == BSP_CLOCK_SRC_HSE) ? "HSE" : "HSI",
+           (unsigned long)BSP_Clock_SrcHz(),
+           (s_ulActive == APP_CLOCK_NONE) ? " (PLL failed)" : "");
+    for (uint32_t i = 0; i < APP_CLOCK_PROFILES; i++)
+    {
+        if (s_ucValid[i])
+        {
+            printf(" %lu", (unsigned long)s_xProfile[i].sysclk_hz);
+        }
+    }
+    printf("\r\n");
+    return s_iInitStatus;
+}
+
+int AppClock_Set(uint32_t idx)
+{
+    uint32_t primask;
+    int rc;
+
+    if (idx >= APP_CLOCK_PROFILES || !s_ucValid[idx])
+    {
+        return -1;
+    }
+    if (idx == s_ulActive && SystemCoreClock == s_xProfile[idx].sysclk_hz)
+    {
+        return 0;
+    }
+
+    /* 查询发送的printf可能还有字节在移位寄存器中 */
+    USARTx_WaitIdle();
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    rc = BSP_Clock_Apply(&s_xProfile[idx]);
+    s_ulActive = (rc == 0) ? idx : APP_CLOCK_NONE;
+
+    /* 失败时同样已回到HSI，依赖频率的部分一律重新计算 */
+    AppPower_ClockUpdate();
+    CPU_TS_ClockChanged(SystemCoreClock);
+    USARTx_ClockUpdate();
+    IIC_ClockUpdate();
+    __set_PRIMASK(primask);
+
+    return rc;
+}
+
+uint32_t AppClock_Current(void)
+{
+    return s_ulActive;
+}
+
+int AppClock_Govern(uint32_t idle_permille)
+{
+#if (APP_CLOCK_GOVERNOR == 1)
+    uint32_t from = SystemCoreClock;
+    uint32_t next;
+
+    if (s_ulTop == APP_CLOCK_NONE)
+    {
+        return 0;
+    }
+
+    /* STOP唤醒后PLL未能恢复时系统时钟为HSI，按未运行在任何档位处理 */
+    if (s_ulActive != APP_CLOCK_NONE && SystemCoreClock != s_xProfile[s_ulActive].sysclk_hz)
+    {
+        s_ulActive = APP_CLOCK_NONE;
+    }
+
+    if (s_ulActive == APP_CLOCK_NONE || idle_permille < APP_CLOCK_UP_IDLE)
+    {
+        /* 负载上升时一步回到最高档，不逐级试探 */
+        next = s_ulTop;
+        s_ulQuietWindows = 0;
+    }
+    else if (idle_permille >= APP_CLOCK_DOWN_IDLE)
+    {
+        next = s_ulActive;
+        if (++s_ulQuietWindows >= APP_CLOCK_DOWN_WINDOWS)
+        {
+            next = AppClock_Lower(s_ulActive);
+            s_ulQuietWindows = 0;
+        }
+    }
+    else
+    {
+        next = s_ulActive;
+        s_ulQuietWindows = 0;
+    }
+
+    if (next != s_ulActive)
+    {
+        (void)AppClock_Set(next);
+    }
+    return (SystemCoreClock != from) ? 1 : 0;
+#else
+    (void)idle_permille;
+    return 0;
+#endif
+}
+
+uint32_t AppClock_ScaleLoad(uint32_t permille)
+{
+    uint32_t top_hz;
+
+    if (s_ulTop == APP_CLOCK_NONE)
+    {
+        return permille;
+    }
+    top_hz = s_xProfile[s_ulTop].sysclk_hz;
+    return (uint32_t)(((uint64_t)permille * SystemCoreClock + top_hz / 2U) / top_hz);
+}
@@ -0,0 +1,187 @@
+/**
+ * @file app_bus.h
+ * @brief 传感器数据发布/订阅总线头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 生产者按主题发布带时间戳的样本，订阅者按主题掩码和变化阈值过滤后接收:
+ *       - 回调: 在发布者上下文中同步调用，样本只在回调期间有效
+ *       - 任务通知: 以 eSetBits 方式置位 (1 << 主题)，订阅者再用 AppBus_Acquire 取最新样本
+ *       - 队列: 投递样本指针(零拷贝)，订阅者用完后必须调用 AppBus_Release
+ *       样本存放在带引用计数的静态槽中，最后一个引用释放后槽自动回收
+ *       发布只能在任务中进行；订阅应在初始化阶段完成，订阅不可撤销
+ */
+
+#ifndef __APP_BUS_H
+#define __APP_BUS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "app_time.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_BUS_SLOT_NUM 16 /**< 样本槽数量 */
+#define APP_BUS_SUB_NUM 8   /**< 最大订阅者数量 */
+
+/**
+ * @brief 主题
+ */
+typedef enum
+{
+    APP_BUS_TOPIC_TEMPERATURE = 0, /**< 温度(℃) */
+    APP_BUS_TOPIC_HUMIDITY,        /**< 湿度(%RH) */
+    APP_BUS_TOPIC_LIGHT_ADC,       /**< 光照ADC计数 */
+    APP_BUS_TOPIC_LIGHT_LUX,       /**< 照度(lux) */
+    APP_BUS_TOPIC_NUM,
+} AppBus_Topic_t;
+
+/* 主题掩码 */
+#define APP_BUS_MASK(topic) (1UL << (topic))
+#define APP_BUS_MASK_ALL ((1UL << APP_BUS_TOPIC_NUM) - 1UL)
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 样本(由总线持有，订阅者只读)
+ */
+typedef struct
+{
+    int32_t value;               /**< 样本值 */
+    AppTime_Stamp_TypeDef stamp; /**< 采样时间戳 */
+    uint32_t seq;                /**< 本主题内的序号(从1开始) */
+    uint8_t topic;       /**< AppBus_Topic_t */
+    uint8_t valid;       /**< 数据有效标志 */
+    volatile uint8_t ref;/**< 引用计数(总线内部使用) */
+} AppBus_Sample_TypeDef;
+
+/**
+ * @brief 回调订阅者
+ *
+ * @note 在发布者任务中调用，应尽快返回，耗时计入发布者
+ */
+typedef void (*AppBus_Callback_t)(void *ctx, const AppBus_Sample_TypeDef *sample);
+
+/**
+ * @brief 总线统计
+ */
+typedef struct
+{
+    uint32_t published;   /**< 发布次数 */
+    uint32_t delivered;   /**< 投递次数(三类订阅者合计) */
+    uint32_t filtered;    /**< 因变化量小于阈值而跳过的次数 */
+    uint32_t slot_miss;   /**< 无空闲槽导致的发布失败次数 */
+    uint32_t queue_full;  /**< 队列满导致的投递失败次数 */
+} AppBus_Stats_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化总线
+ * @author Yukikaze
+ *
+ * @note 需要在任何订阅/发布之前调用
+ */
+void AppBus_Init(void);
+
+/**
+ * @brief 发布样本
+ * @author Yukikaze
+ *
+ * @param topic 主题
+ * @param value 样本值
+ * @param valid 数据有效标志
+ * @param stamp 采样时间戳(NULL=使用发布时刻)
+ * @return int 0=成功, -1=无空闲槽
+ *
+ * @note 有效标志变化时无视阈值总是投递
+ *       发布失败时序号照常递增，订阅者可由序号跳变发现丢失
+ */
+int AppBus_Publish(AppBus_Topic_t topic, int32_t value, uint8_t valid,
+                   const AppTime_Stamp_TypeDef *stamp);
+
+/**
+ * @brief 订阅: 回调
+ * @author Yukikaze
+ *
+ * @param mask 主题掩码(APP_BUS_MASK)
+ * @param threshold 变化阈值(0=每次发布都投递)
+ * @param cb 回调函数
+ * @param ctx 回调参数
+ * @return int 订阅者编号，-1=订阅者已满
+ */
+int AppBus_SubscribeCallback(uint32_t mask, uint32_t threshold, AppBus_Callback_t cb, void *ctx);
+
+/**
+ * @brief 订阅: 任务通知
+ * @author Yukikaze
+ *
+ * @param mask 主题掩码
+ * @param threshold 变化阈值
+ * @param task 被通知的任务
+ * @return int 订阅者编号，-1=订阅者已满
+ */
+int AppBus_SubscribeNotify(uint32_t mask, uint32_t threshold, TaskHandle_t task);
+
+/**
+ * @brief 订阅: 队列
+ * @author Yukikaze
+ *
+ * @param mask 主题掩码
+ * @param threshold 变化阈值
+ * @param queue 元素类型为 const AppBus_Sample_TypeDef * 的队列
+ * @return int 订阅者编号，-1=订阅者已满
+ *
+ * @note 队列深度之和应小于 APP_BUS_SLOT_NUM，否则慢速订阅者会占满样本槽
+ */
+int AppBus_SubscribeQueue(uint32_t mask, uint32_t threshold, QueueHandle_t queue);
+
+/**
+ * @brief 修改订阅者的主题掩码
+ * @author Yukikaze
+ *
+ * @param id 订阅者编号(订阅函数的返回值)
+ * @param mask 新的主题掩码
+ * @return int 0=成功, -1=编号无效
+ *
+ * @note 只关注一部分主题的订阅者(如显示任务只关注当前页面)借此避免无用的唤醒；
+ *       已在投递途中的通知不受影响，订阅者仍需按通知值过滤
+ */
+int AppBus_SetMask(int id, uint32_t mask);
+
+/**
+ * @brief 获取某主题最新样本的引用
+ * @author Yukikaze
+ *
+ * @return const AppBus_Sample_TypeDef* 样本，尚未发布过返回NULL
+ *
+ * @note 用完后必须调用 AppBus_Release
+ */
+const AppBus_Sample_TypeDef *AppBus_Acquire(AppBus_Topic_t topic);
+
+/**
+ * @brief 释放样本引用
+ * @author Yukikaze
+ */
+void AppBus_Release(const AppBus_Sample_TypeDef *sample);
+
+/**
+ * @brief 获取总线统计
+ * @author Yukikaze
+ */
+void AppBus_GetStats(AppBus_Stats_TypeDef *stats);
+
+#endif /* __APP_BUS_H */
@@ -5,22 +5,65 @@
  * @date 2025-12-2
  *
  * @note 本模块提供各任务间共享的传感器数据结构和访问接口
- *       使用互斥量保护共享数据，确保多任务访问安全
+ *       使用顺序锁(seqlock)发布数据:
+ *       - 写者在极短的临界区内更新数据，从不阻塞，也可在中断中写入
+ *       - 读者无锁拷贝，读取期间数据被修改时自动重读
  */
 
 #ifndef __APP_DATA_H
 #define __APP_DATA_H
 
 #include "FreeRTOS.h"
-#include "semphr.h"
+#include "seqlock.h"
+#include "app_time.h"
 #include <stdint.h>
 
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_DATA_TEMPHUM_STALE_MS 6000 /**< 温湿度超过此时长未更新视为过期(3个采集周期) */
+#define APP_DATA_LIGHT_STALE_MS 25000  /**< 光照超过此时长未更新视为过期(事件模式刷新10秒) */
+
 /**
  * ============================================================================
  * 共享数据结构定义
  * ============================================================================
  */
 
+/**
+ * @brief 数据通道
+ */
+typedef enum
+{
+    APP_DATA_CH_TEMPHUM = 0, /**< 温湿度 */
+    APP_DATA_CH_LIGHT,       /**< 光照 */
+    APP_DATA_CH_NUM,
+} AppData_Channel_t;
+
+/**
+ * @brief 样本元数据
+ */
+typedef struct
+{
+    AppTime_Stamp_TypeDef stamp; /**< 采样时间戳 */
+    uint32_t seq;                /**< 序号(每次更新加1，0=从未更新) */
+} AppData_Meta_TypeDef;
+
+/**
+ * @brief 端到端延迟统计(采样 -> 消费者)
+ */
+typedef struct
+{
+    uint32_t count;  /**< 统计样本数 */
+    uint32_t min_us; /**< 最小延迟 */
+    uint32_t max_us; /**< 最大延迟 */
+    uint32_t avg_us; /**< 平均延迟 */
+    uint32_t last_us;/**< 最近一次延迟 */
+    uint32_t missed; /**< 消费者未看到就被覆盖的样本数(由序号跳变推算) */
+} AppData_Latency_TypeDef;
+
 /**
  * @brief 传感器数据结构体
  *
@@ -36,8 +79,14 @@ typedef struct
     uint8_t dht11_valid; /**< DHT11数据有效标志(1=有效, 0=无效) */
 
     /* 光照数据 (由Task_Light更新) */
-    uint32_t light_adc;  /**< 光敏电阻ADC原始值(0-4095) */
-    uint8_t light_valid; /**< 光照数据有效标志(1=有效, 0=无效) */
+    uint32_t light_adc;    /**< 光敏电阻ADC滤波值(CIC+中值+IIR，0-4095，未做VREFINT补偿) */
+    uint32_t light_lux;    /**< 标定后的照度(单位: lux) */
+    uint8_t light_percent; /**< 亮度百分比(0-100，越大越亮) */
+    uint8_t light_valid;   /**< 光照数据有效标志(1=有效, 0=无效) */
+
+    /* 元数据 */
+    AppData_Meta_TypeDef temphum_meta; /**< 温湿度时间戳与序号 */
+    AppData_Meta_TypeDef light_meta;   /**< 光照时间戳与序号 */
 
 } SensorData_TypeDef;
 
@@ -47,11 +96,11 @@ typedef struct
  * ============================================================================
  */
 
-/* 全局传感器数据实例 */
+/* 全局传感器数据实例(只能通过AppData接口访问) */
 extern SensorData_TypeDef g_SensorData;
 
-/* 数据访问互斥量 */
-extern SemaphoreHandle_t g_xDataMutex;
+/* 传感器数据顺序锁 */
+extern SeqLock_TypeDef g_xDataSeqLock;
 
 /**
  * ============================================================================
@@ -65,7 +114,7 @@ extern SemaphoreHandle_t g_xDataMutex;
  *
  * @return BaseType_t 初始化结果(pdPASS=成功, pdFAIL=失败)
  *
- * @note 创建互斥量，初始化传感器数据结构
+ * @note 初始化传感器数据结构
  *       需要在创建任务前调用
  */
 BaseType_t AppData_Init(void);
@@ -84,17 +133,73 @@ void AppData_UpdateTempHum(uint8_t temp, uint8_t humi, uint8_t valid);
  * @brief 更新光照数据(线程安全)
  * @author Yukikaze
  *
+ * @param adc_value ADC滤波值
+ * @param lux 照度(lux)
+ * @param percent 亮度百分比
+ * @param valid 数据有效标志
+ */
+void AppData_UpdateLight(uint32_t adc_value, uint32_t lux, uint8_t percent, uint8_t valid);
+
+/**
+ * @brief 更新光照数据(中断中调用)
+ * @author Yukikaze
+ *
  * @param adc_value ADC原始值
+ * @param lux 照度(lux)
+ * @param percent 亮度百分比
  * @param valid 数据有效标志
+ *
+ * @note 只更新共享数据，不发布到数据总线(总线只能在任务中发布)
  */
-void AppData_UpdateLight(uint32_t adc_value, uint8_t valid);
+void AppData_UpdateLightFromISR(uint32_t adc_value, uint32_t lux, uint8_t percent, uint8_t valid);
 
 /**
  * @brief 获取传感器数据副本(线程安全)
  * @author Yukikaze
  *
  * @param pData 指向数据结构的指针，用于存储读取的数据副本
+ *
+ * @note 不阻塞，返回时pData总是一份完整一致的副本
  */
 void AppData_GetSensorData(SensorData_TypeDef *pData);
 
+/**
+ * @brief 获取样本距今的时长
+ * @author Yukikaze
+ *
+ * @param meta 样本元数据
+ * @return uint32_t 时长(毫秒)，从未更新返回UINT32_MAX
+ */
+uint32_t AppData_AgeMs(const AppData_Meta_TypeDef *meta);
+
+/**
+ * @brief 判断样本是否过期
+ * @author Yukikaze
+ *
+ * @param meta 样本元数据
+ * @param max_age_ms 允许的最大时长(毫秒)
+ * @return int 1=过期或从未更新, 0=新鲜
+ */
+int AppData_IsStale(const AppData_Meta_TypeDef *meta, uint32_t max_age_ms);
+
+/**
+ * @brief 消费者记录一次端到端延迟
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param meta 被消费样本的元数据
+ *
+ * @note 同一序号只统计一次，消费者可以每个周期都调用
+ */
+void AppData_RecordLatency(AppData_Channel_t ch, const AppData_Meta_TypeDef *meta);
+
+/**
+ * @brief 获取端到端延迟统计
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param pStats 输出统计
+ */
+void AppData_GetLatency(AppData_Channel_t ch, AppData_Latency_TypeDef *pStats);
+
 #endif /* __APP_DATA_H */
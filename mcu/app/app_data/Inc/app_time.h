@@ -0,0 +1,55 @@
+/**
+ * @file app_time.h
+ * @brief 应用层时间戳头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 时间戳由两部分组成:
+ *       - cycles: 64位DWT周期计数(高分辨率，用于计算年龄与延迟)
+ *       - tick:   FreeRTOS系统节拍(便于与RTOS超时/日志对照)
+ */
+
+#ifndef __APP_TIME_H
+#define __APP_TIME_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/**
+ * @brief 时间戳
+ */
+typedef struct
+{
+    uint64_t cycles; /**< 64位DWT周期计数 */
+    TickType_t tick; /**< 系统节拍 */
+} AppTime_Stamp_TypeDef;
+
+/**
+ * @brief 获取当前时间戳
+ * @author Yukikaze
+ *
+ * @param stamp 输出时间戳
+ *
+ * @note 任务与中断中均可调用
+ */
+void AppTime_Now(AppTime_Stamp_TypeDef *stamp);
+
+/**
+ * @brief 计算两个时间戳之间的间隔
+ * @author Yukikaze
+ *
+ * @param from 起始时间戳
+ * @param to 结束时间戳
+ * @return uint32_t 间隔(微秒)，to早于from时返回0，超过uint32范围时饱和
+ */
+uint32_t AppTime_ElapsedUs(const AppTime_Stamp_TypeDef *from, const AppTime_Stamp_TypeDef *to);
+
+/**
+ * @brief 计算时间戳距今的时长
+ * @author Yukikaze
+ *
+ * @return uint32_t 时长(微秒)
+ */
+uint32_t AppTime_AgeUs(const AppTime_Stamp_TypeDef *stamp);
+
+#endif /* __APP_TIME_H */
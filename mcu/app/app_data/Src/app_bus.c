@@ -0,0 +1,369 @@
+/**
+ * @file app_bus.c
+ * @brief 传感器数据发布/订阅总线实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 槽分配、引用计数与各订阅者的阈值判断(seen/last/last_valid)在同一个临界区内完成，
+ *       多个发布者任务并发发布时订阅者状态不会被交错改写；
+ *       回调、通知、入队都在临界区外执行
+ */
+
+#include "app_bus.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有定义
+ * ============================================================================
+ */
+
+/**
+ * @brief 订阅者类型
+ */
+typedef enum
+{
+    APP_BUS_SUB_NONE = 0,
+    APP_BUS_SUB_CALLBACK,
+    APP_BUS_SUB_NOTIFY,
+    APP_BUS_SUB_QUEUE,
+} AppBus_SubType_t;
+
+/**
+ * @brief 订阅者
+ */
+typedef struct
+{
+    uint8_t type;                       /**< AppBus_SubType_t */
+    uint32_t mask;                      /**< 主题掩码 */
+    uint32_t threshold;                 /**< 变化阈值 */
+    AppBus_Callback_t cb;               /**< 回调 */
+    void *ctx;                          /**< 回调参数 */
+    TaskHandle_t task;                  /**< 通知任务 */
+    QueueHandle_t queue;                /**< 投递队列 */
+    int32_t last[APP_BUS_TOPIC_NUM];    /**< 各主题上次投递的值 */
+    uint8_t last_valid[APP_BUS_TOPIC_NUM]; /**< 各主题上次投递的有效标志 */
+    uint8_t seen;                       /**< 已投递过的主题位图 */
+} AppBus_Sub_TypeDef;
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 样本槽 */
+static AppBus_Sample_TypeDef s_xSlots[APP_BUS_SLOT_NUM];
+
+/* 各主题最新样本(总线持有一个引用) */
+static AppBus_Sample_TypeDef *s_pxLatest[APP_BUS_TOPIC_NUM];
+
+/* 订阅者表(只增不减，s_ucSubCount之前的表项除主题掩码外不再修改，掩码在临界区内读写) */
+static AppBus_Sub_TypeDef s_xSubs[APP_BUS_SUB_NUM];
+static volatile uint8_t s_ucSubCount;
+
+/* 各主题序号 */
+static uint32_t s_ulSeq[APP_BUS_TOPIC_NUM];
+
+/* 统计 */
+static AppBus_Stats_TypeDef s_xStats;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 引用计数减1，调用者已进入临界区
+ */
+static void AppBus_Unref(AppBus_Sample_TypeDef *s)
+{
+    if (s != NULL && s->ref != 0)
+    {
+        s->ref--;
+    }
+}
+
+/**
+ * @brief 添加订阅者
+ */
+static int AppBus_AddSub(const AppBus_Sub_TypeDef *sub)
+{
+    int id = -1;
+
+    taskENTER_CRITICAL();
+    if (s_ucSubCount < APP_BUS_SUB_NUM)
+    {
+        id = s_ucSubCount;
+        s_xSubs[id] = *sub;
+        s_ucSubCount++;
+    }
+    taskEXIT_CRITICAL();
+
+    return id;
+}
+
+/**
+ * @brief 按阈值判断是否需要投递，需要时记录本次值，调用者已进入临界区
+ */
+static int AppBus_Accept(AppBus_Sub_TypeDef *sub, const AppBus_Sample_TypeDef *s)
+{
+    uint32_t bit = 1UL << s->topic;
+    uint32_t delta;
+
+    if ((sub->seen & bit) && sub->last_valid[s->topic] == s->valid)
+    {
+        delta = (s->value >= sub->last[s->topic])
+                    ? (uint32_t)s->value - (uint32_t)sub->last[s->topic]
+                    : (uint32_t)sub->last[s->topic] - (uint32_t)s->value;
+        if (delta < sub->threshold)
+        {
+            return 0;
+        }
+    }
+
+    sub->seen |= (uint8_t)bit;
+    sub->last[s->topic] = s->value;
+    sub->last_valid[s->topic] = s->valid;
+    return 1;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppBus_Init(void)
+{
+    taskENTER_CRITICAL();
+    memset(s_xSlots, 0, sizeof(s_xSlots));
+    memset(s_pxLatest, 0, sizeof(s_pxLatest));
+    memset(s_xSubs, 0, sizeof(s_xSubs));
+    memset(s_ulSeq, 0, sizeof(s_ulSeq));
+    memset(&s_xStats, 0, sizeof(s_xStats));
+    s_ucSubCount = 0;
+    taskEXIT_CRITICAL();
+}
+
+int AppBus_Publish(AppBus_Topic_t topic, int32_t value, uint8_t valid,
+                   const AppTime_Stamp_TypeDef *stamp)
+{
+    AppTime_Stamp_TypeDef now;
+    AppBus_Sample_TypeDef *s = NULL;
+    uint32_t delivered = 0;
+    uint32_t queue_full = 0;
+    uint32_t accepted = 0;
+    uint8_t count;
+
+    if (topic >= APP_BUS_TOPIC_NUM)
+    {
+        return -1;
+    }
+
+    if (stamp == NULL)
+    {
+        AppTime_Now(&now);
+        stamp = &now;
+    }
+
+    /* 分配槽: 发布者一个引用 + 作为最新样本一个引用 */
+    taskENTER_CRITICAL();
+    s_ulSeq[topic]++;
+    for (uint8_t i = 0; i < APP_BUS_SLOT_NUM; i++)
+    {
+        if (s_xSlots[i].ref == 0)
+        {
+            s = &s_xSlots[i];
+            break;
+        }
+    }
+    if (s == NULL)
+    {
+        s_xStats.slot_miss++;
+        taskEXIT_CRITICAL();
+        return -1;
+    }
+    s->value = value;
+    s->stamp = *stamp;
+    s->seq = s_ulSeq[topic];
+    s->topic = (uint8_t)topic;
+    s->valid = valid;
+    s->ref = 2;
+    AppBus_Unref(s_pxLatest[topic]);
+    s_pxLatest[topic] = s;
+    s_xStats.published++;
+
+    /* 阈值判断与记录: 同一订阅者的状态由多个发布者共享，必须与快照在同一临界区内 */
+    count = s_ucSubCount;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        AppBus_Sub_TypeDef *sub = &s_xSubs[i];
+
+        if ((sub->mask & (1UL << topic)) == 0)
+        {
+            continue;
+        }
+        if (!AppBus_Accept(sub, s))
+        {
+            s_xStats.filtered++;
+            continue;
+        }
+        accepted |= 1UL << i;
+        if (sub->type == APP_BUS_SUB_QUEUE)
+        {
+            /* 队列订阅者的引用先加上，入队失败时再释放 */
+            s->ref++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        AppBus_Sub_TypeDef *sub = &s_xSubs[i];
+
+        if ((accepted & (1UL << i)) == 0)
+        {
+            continue;
+        }
+
+        switch (sub->type)
+        {
+        case APP_BUS_SUB_CALLBACK:
+            sub->cb(sub->ctx, s);
+            break;
+
+        case APP_BUS_SUB_NOTIFY:
+            xTaskNotify(sub->task, 1UL << topic, eSetBits);
+            break;
+
+        case APP_BUS_SUB_QUEUE:
+            if (xQueueSend(sub->queue, &s, 0) != pdTRUE)
+            {
+                AppBus_Release(s);
+                queue_full++;
+                continue;
+            }
+            break;
+
+        default:
+            continue;
+        }
+        delivered++;
+    }
+
+    /* 释放发布者引用并累加统计 */
+    taskENTER_CRITICAL();
+    AppBus_Unref(s);
+    s_xStats.delivered += delivered;
+    s_xStats.queue_full += queue_full;
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+int AppBus_SubscribeCallback(uint32_t mask, uint32_t threshold, AppBus_Callback_t cb, void *ctx)
+{
+    AppBus_Sub_TypeDef sub;
+
+    if (cb == NULL)
+    {
+        return -1;
+    }
+
+    memset(&sub, 0, sizeof(sub));
+    sub.type = APP_BUS_SUB_CALLBACK;
+    sub.mask = mask & APP_BUS_MASK_ALL;
+    sub.threshold = threshold;
+    sub.cb = cb;
+    sub.ctx = ctx;
+    return AppBus_AddSub(&sub);
+}
+
+int AppBus_SubscribeNotify(uint32_t mask, uint32_t threshold, TaskHandle_t task)
+{
+    AppBus_Sub_TypeDef sub;
+
+    if (task == NULL)
+    {
+        return -1;
+    }
+
+    memset(&sub, 0, sizeof(sub));
+    sub.type = APP_BUS_SUB_NOTIFY;
+    sub.mask = mask & APP_BUS_MASK_ALL;
+    sub.threshold = threshold;
+    sub.task = task;
+    return AppBus_AddSub(&sub);
+}
+
+int AppBus_SubscribeQueue(uint32_t mask, uint32_t threshold, QueueHandle_t queue)
+{
+    AppBus_Sub_TypeDef sub;
+
+    if (queue == NULL)
+    {
+        return -1;
+    }
+
+    memset(&sub, 0, sizeof(sub));
+    sub.type = APP_BUS_SUB_QUEUE;
+    sub.mask = mask & APP_BUS_MASK_ALL;
+    sub.threshold = threshold;
+    sub.queue = queue;
+    return AppBus_AddSub(&sub);
+}
+
+int AppBus_SetMask(int id, uint32_t mask)
+{
+    int ret = -1;
+
+    taskENTER_CRITICAL();
+    if (id >= 0 && id < (int)s_ucSubCount)
+    {
+        s_xSubs[id].mask = mask & APP_BUS_MASK_ALL;
+        ret = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+const AppBus_Sample_TypeDef *AppBus_Acquire(AppBus_Topic_t topic)
+{
+    AppBus_Sample_TypeDef *s = NULL;
+
+    if (topic >= APP_BUS_TOPIC_NUM)
+    {
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    s = s_pxLatest[topic];
+    if (s != NULL)
+    {
+        s->ref++;
+    }
+    taskEXIT_CRITICAL();
+
+    return s;
+}
+
+void AppBus_Release(const AppBus_Sample_TypeDef *sample)
+{
+    taskENTER_CRITICAL();
+    AppBus_Unref((AppBus_Sample_TypeDef *)sample);
+    taskEXIT_CRITICAL();
+}
+
+void AppBus_GetStats(AppBus_Stats_TypeDef *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = s_xStats;
+    taskEXIT_CRITICAL();
+}
@@ -5,10 +5,15 @@
  * @date 2025-12-2
  *
  * @note 本模块管理各任务间共享的传感器数据
- *       使用互斥量保护数据访问，确保线程安全
+ *       写者在临界区内完成顺序锁的写入(多个写者之间互斥)，中断中的写者使用FROM_ISR版本的临界区，
+ *       读者无锁读取，读到被打断的数据时重读
+ *       任务中的更新同时发布到数据总线(app_bus)，由订阅者按需处理
  */
 
 #include "app_data.h"
+#include "app_bus.h"
+#include "task.h"
+#include "__port_config__.h"
 #include <string.h>
 
 /**
@@ -20,8 +25,52 @@
 /* 传感器数据实例 */
 SensorData_TypeDef g_SensorData = {0};
 
-/* 数据访问互斥量句柄 */
-SemaphoreHandle_t g_xDataMutex = NULL;
+/* 传感器数据顺序锁 */
+SeqLock_TypeDef g_xDataSeqLock = SEQLOCK_INIT;
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/**
+ * @brief 延迟统计累加器
+ */
+typedef struct
+{
+    uint32_t last_seq; /**< 最近一次统计的序号 */
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t last_us;
+    uint32_t missed;
+    uint64_t sum_us;
+} AppData_LatencyAcc_TypeDef;
+
+static AppData_LatencyAcc_TypeDef s_xLatency[APP_DATA_CH_NUM];
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 写入光照数据(调用者已进入临界区)
+ */
+static void AppData_WriteLight(uint32_t adc_value, uint32_t lux, uint8_t percent, uint8_t valid,
+                               const AppTime_Stamp_TypeDef *stamp)
+{
+    SeqLock_WriteBegin(&g_xDataSeqLock);
+    g_SensorData.light_adc = adc_value;
+    g_SensorData.light_lux = lux;
+    g_SensorData.light_percent = percent;
+    g_SensorData.light_valid = valid;
+    g_SensorData.light_meta.stamp = *stamp;
+    g_SensorData.light_meta.seq++;
+    SeqLock_WriteEnd(&g_xDataSeqLock);
+}
 
 /**
  * ============================================================================
@@ -35,20 +84,19 @@ SemaphoreHandle_t g_xDataMutex = NULL;
  *
  * @return BaseType_t 初始化结果(pdPASS=成功, pdFAIL=失败)
  *
- * @note 创建互斥量用于保护共享数据
- *       初始化传感器数据结构为默认值
+ * @note 初始化传感器数据结构为默认值，并初始化数据总线
  */
 BaseType_t AppData_Init(void)
 {
-    /* 创建互斥量 */
-    g_xDataMutex = xSemaphoreCreateMutex();
-    if (g_xDataMutex == NULL)
-    {
-        return pdFAIL;
-    }
+    AppBus_Init();
 
     /* 初始化传感器数据 */
-    memset(&g_SensorData, 0, sizeof(SensorData_TypeDef));
+    taskENTER_CRITICAL();
+    SeqLock_WriteBegin(&g_xDataSeqLock);
+    PORT_MEMSET(&g_SensorData, 0, sizeof(SensorData_TypeDef));
+    SeqLock_WriteEnd(&g_xDataSeqLock);
+    PORT_MEMSET(s_xLatency, 0, sizeof(s_xLatency));
+    taskEXIT_CRITICAL();
 
     return pdPASS;
 }
@@ -61,38 +109,78 @@ BaseType_t AppData_Init(void)
  * @param humi 湿度值
  * @param valid 数据有效标志
  *
- * @note 使用互斥量保护数据写入
- *       等待时间设置为100ms，超时则放弃更新
+ * @note 临界区内只做几次存储，不会阻塞
+ *       之后发布到数据总线
  */
 void AppData_UpdateTempHum(uint8_t temp, uint8_t humi, uint8_t valid)
 {
-    if (xSemaphoreTake(g_xDataMutex, pdMS_TO_TICKS(100)) == pdTRUE)
-    {
-        g_SensorData.temperature = temp;
-        g_SensorData.humidity = humi;
-        g_SensorData.dht11_valid = valid;
-        xSemaphoreGive(g_xDataMutex);
-    }
+    AppTime_Stamp_TypeDef stamp;
+
+    AppTime_Now(&stamp);
+
+    taskENTER_CRITICAL();
+    SeqLock_WriteBegin(&g_xDataSeqLock);
+    g_SensorData.temperature = temp;
+    g_SensorData.humidity = humi;
+    g_SensorData.dht11_valid = valid;
+    g_SensorData.temphum_meta.stamp = stamp;
+    g_SensorData.temphum_meta.seq++;
+    SeqLock_WriteEnd(&g_xDataSeqLock);
+    taskEXIT_CRITICAL();
+
+    AppBus_Publish(APP_BUS_TOPIC_TEMPERATURE, temp, valid, &stamp);
+    AppBus_Publish(APP_BUS_TOPIC_HUMIDITY, humi, valid, &stamp);
 }
 
 /**
  * @brief 更新光照数据(线程安全)
  * @author Yukikaze
  *
+ * @param adc_value ADC滤波值
+ * @param lux 照度(lux)
+ * @param percent 亮度百分比
+ * @param valid 数据有效标志
+ *
+ * @note 临界区内只做几次存储，不会阻塞
+ *       之后发布到数据总线
+ */
+void AppData_UpdateLight(uint32_t adc_value, uint32_t lux, uint8_t percent, uint8_t valid)
+{
+    AppTime_Stamp_TypeDef stamp;
+
+    AppTime_Now(&stamp);
+
+    taskENTER_CRITICAL();
+    AppData_WriteLight(adc_value, lux, percent, valid, &stamp);
+    taskEXIT_CRITICAL();
+
+    AppBus_Publish(APP_BUS_TOPIC_LIGHT_ADC, (int32_t)adc_value, valid, &stamp);
+    AppBus_Publish(APP_BUS_TOPIC_LIGHT_LUX, (int32_t)lux, valid, &stamp);
+}
+
+/**
+ * @brief 更新光照数据(中断中调用)
+ * @author Yukikaze
+ *
  * @param adc_value ADC原始值
+ * @param lux 照度(lux)
+ * @param percent 亮度百分比
  * @param valid 数据有效标志
  *
- * @note 使用互斥量保护数据写入
- *       等待时间设置为100ms，超时则放弃更新
+ * @note 中断优先级不得高于configMAX_SYSCALL_INTERRUPT_PRIORITY
+ *       taskENTER_CRITICAL不能在中断中使用，这里屏蔽到同一优先级，与任务中的写者互斥；
+ *       只更新共享数据，不发布到数据总线
  */
-void AppData_UpdateLight(uint32_t adc_value, uint8_t valid)
+void AppData_UpdateLightFromISR(uint32_t adc_value, uint32_t lux, uint8_t percent, uint8_t valid)
 {
-    if (xSemaphoreTake(g_xDataMutex, pdMS_TO_TICKS(100)) == pdTRUE)
-    {
-        g_SensorData.light_adc = adc_value;
-        g_SensorData.light_valid = valid;
-        xSemaphoreGive(g_xDataMutex);
-    }
+    UBaseType_t uxSavedInterruptStatus;
+    AppTime_Stamp_TypeDef stamp;
+
+    AppTime_Now(&stamp);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    AppData_WriteLight(adc_value, lux, percent, valid, &stamp);
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
 }
 
 /**
@@ -101,19 +189,123 @@ void AppData_UpdateLight(uint32_t adc_value, uint8_t valid)
  *
  * @param pData 指向数据结构的指针，用于存储读取的数据副本
  *
- * @note 使用互斥量保护数据读取
- *       返回数据的完整副本，避免读取时数据被修改
+ * @note 无锁读取: 拷贝前后序号不一致说明期间发生了写入，重读即可
+ *       写者只在临界区内写且很短，重读极少发生
  */
 void AppData_GetSensorData(SensorData_TypeDef *pData)
 {
+    uint32_t seq;
+
     if (pData == NULL)
     {
         return;
     }
 
-    if (xSemaphoreTake(g_xDataMutex, pdMS_TO_TICKS(100)) == pdTRUE)
+    do
     {
-        memcpy(pData, &g_SensorData, sizeof(SensorData_TypeDef));
-        xSemaphoreGive(g_xDataMutex);
+        seq = SeqLock_ReadBegin(&g_xDataSeqLock);
+        PORT_MEMCPY(pData, &g_SensorData, sizeof(SensorData_TypeDef));
+    } while (SeqLock_ReadRetry(&g_xDataSeqLock, seq));
+}
+
+/**
+ * @brief 获取样本距今的时长
+ * @author Yukikaze
+ *
+ * @param meta 样本元数据
+ * @return uint32_t 时长(毫秒)，从未更新返回UINT32_MAX
+ */
+uint32_t AppData_AgeMs(const AppData_Meta_TypeDef *meta)
+{
+    if (meta == NULL || meta->seq == 0)
+    {
+        return UINT32_MAX;
+    }
+    return AppTime_AgeUs(&meta->stamp) / 1000U;
+}
+
+/**
+ * @brief 判断样本是否过期
+ * @author Yukikaze
+ *
+ * @param meta 样本元数据
+ * @param max_age_ms 允许的最大时长(毫秒)
+ * @return int 1=过期或从未更新, 0=新鲜
+ */
+int AppData_IsStale(const AppData_Meta_TypeDef *meta, uint32_t max_age_ms)
+{
+    return AppData_AgeMs(meta) > max_age_ms;
+}
+
+/**
+ * @brief 消费者记录一次端到端延迟
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param meta 被消费样本的元数据
+ *
+ * @note 同一序号只统计一次；序号跳变说明中间有样本未被消费
+ */
+void AppData_RecordLatency(AppData_Channel_t ch, const AppData_Meta_TypeDef *meta)
+{
+    AppData_LatencyAcc_TypeDef *acc;
+    uint32_t us;
+
+    if (ch >= APP_DATA_CH_NUM || meta == NULL || meta->seq == 0)
+    {
+        return;
+    }
+
+    us = AppTime_AgeUs(&meta->stamp);
+    acc = &s_xLatency[ch];
+
+    taskENTER_CRITICAL();
+    if (meta->seq != acc->last_seq)
+    {
+        if (acc->last_seq != 0 && meta->seq > acc->last_seq + 1U)
+        {
+            acc->missed += meta->seq - acc->last_seq - 1U;
+        }
+        acc->last_seq = meta->seq;
+        acc->last_us = us;
+        acc->sum_us += us;
+        if (acc->count == 0 || us < acc->min_us)
+        {
+            acc->min_us = us;
+        }
+        if (us > acc->max_us)
+        {
+            acc->max_us = us;
+        }
+        acc->count++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 获取端到端延迟统计
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param pStats 输出统计
+ */
+void AppData_GetLatency(AppData_Channel_t ch, AppData_Latency_TypeDef *pStats)
+{
+    AppData_LatencyAcc_TypeDef acc;
+
+    if (ch >= APP_DATA_CH_NUM || pStats == NULL)
+    {
+        return;
     }
+
+    taskENTER_CRITICAL();
+    acc = s_xLatency[ch];
+    taskEXIT_CRITICAL();
+
+    pStats->count = acc.count;
+    pStats->min_us = acc.min_us;
+    pStats->max_us = acc.max_us;
+    pStats->avg_us = (acc.count != 0) ? (uint32_t)(acc.sum_us / acc.count) : 0;
+    pStats->last_us = acc.last_us;
+    pStats->missed = acc.missed;
 }
@@ -0,0 +1,38 @@
+/**
+ * @file app_time.c
+ * @brief 应用层时间戳实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_time.h"
+#include "core_delay.h"
+#include "task.h"
+
+void AppTime_Now(AppTime_Stamp_TypeDef *stamp)
+{
+    stamp->cycles = CPU_TS_Read64();
+    stamp->tick = (xPortIsInsideInterrupt() ? xTaskGetTickCountFromISR() : xTaskGetTickCount());
+}
+
+uint32_t AppTime_ElapsedUs(const AppTime_Stamp_TypeDef *from, const AppTime_Stamp_TypeDef *to)
+{
+    uint64_t us;
+
+    if (to->cycles <= from->cycles)
+    {
+        return 0;
+    }
+
+    /* 两端各自按所在频率段换算(运行时可能调频，见app_clock.h) */
+    us = CPU_TS_ToUs(to->cycles) - CPU_TS_ToUs(from->cycles);
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+uint32_t AppTime_AgeUs(const AppTime_Stamp_TypeDef *stamp)
+{
+    AppTime_Stamp_TypeDef now;
+
+    AppTime_Now(&now);
+    return AppTime_ElapsedUs(stamp, &now);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file app_heap.h
+ * @brief RTOS堆监视模块头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 通过heap_4/heap_5的traceMALLOC/traceFREE钩子(FreeRTOSConfig.h)驱动统计引擎(libx/heapstat):
+ *       - 调用者以pvPortMalloc的返回地址标识，可用 arm-none-eabi-addr2line -f -e template.elf <addr> 还原函数名；
+ *         malloc族包装(newlib_heap.c)经AppHeap_MallocFrom传入malloc自己的返回地址，
+ *         调用者显示为调用malloc的函数而不是包装函数
+ *       - Task_Prof每个窗口遍历一次空闲链表，输出H行(格式见task_prof.h)并记录最大空闲块趋势
+ *       - 串口收到'h'时输出完整报告(调用者表、空闲块直方图、趋势、最老的活动分配)
+ *       - 分配失败钩子在停机前输出完整报告
+ *       钩子在heap的挂起调度器区间内执行，每次调用的周期数累计在报告末尾(钩子开销)
+ *       configUSE_APP_HEAP_MONITOR 置0即可去掉全部钩子
+ */
+
+#ifndef __APP_HEAP_H
+#define __APP_HEAP_H
+
+#include "heapstat.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_HEAP_DUMP_LIVE 16  /**< 报告中最多列出的活动分配数 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 堆概要(H行)
+ */
+typedef struct
+{
+    uint32_t free;         /**< 空闲总量(字节) */
+    uint32_t min_free;     /**< 历史最小空闲量(字节) */
+    uint32_t largest;      /**< 最大空闲块(字节) */
+    uint32_t free_blocks;  /**< 空闲块数 */
+    uint32_t frag;         /**< 碎片率(千分比) */
+    uint32_t allocs;       /**< 累计分配次数 */
+    uint32_t fails;        /**< 累计失败次数 */
+} AppHeap_Summary_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化堆监视
+ * @author Yukikaze
+ *
+ * @note 在AppTask_HeapInit之后、任何pvPortMalloc之前调用
+ */
+void AppHeap_Init(void);
+
+/**
+ * @brief 分配钩子(traceMALLOC，调度器已挂起)
+ * @author Yukikaze
+ *
+ * @param pv 返回的地址(NULL=失败)
+ * @param size 块大小(含块头)
+ * @param caller 调用者地址
+ */
+void AppHeap_OnMalloc(void *pv, size_t size, void *caller);
+
+/**
+ * @brief 以指定的调用者分配(分配包装函数使用)
+ * @author Yukikaze
+ *
+ * @param size 请求大小(字节)
+ * @param caller 记入调用者表的地址(包装函数自己的返回地址)
+ * @return void* 同pvPortMalloc
+ *
+ * @note 挂起调度器后登记调用者再调用pvPortMalloc，其间不会有其他任务分配；不能在中断中调用
+ */
+void *AppHeap_MallocFrom(size_t size, void *caller);
+
+/**
+ * @brief 读取某个调用者的统计
+ * @author Yukikaze
+ *
+ * @param caller 调用者地址
+ * @param out 输出
+ * @return int 0=找到, -1=调用者表中没有
+ */
+int AppHeap_GetCaller(const void *caller, HeapStat_Caller_TypeDef *out);
+
+/**
+ * @brief 释放钩子(traceFREE，调度器已挂起)
+ * @author Yukikaze
+ */
+void AppHeap_OnFree(void *pv, size_t size);
+
+/**
+ * @brief 遍历空闲链表，更新直方图与趋势并返回概要
+ * @author Yukikaze
+ *
+ * @param t 趋势样本时间戳(秒)
+ * @param sum 输出概要
+ */
+void AppHeap_Sample(uint32_t t, AppHeap_Summary_TypeDef *sum);
+
+/**
+ * @brief 输出完整报告到串口
+ * @author Yukikaze
+ *
+ * @note 先在挂起调度器下复制一份统计快照，再慢速打印，不长时间阻塞调度
+ */
+void AppHeap_Dump(void);
+
+#endif /* __APP_HEAP_H */
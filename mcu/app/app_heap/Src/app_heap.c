@@ -0,0 +1,162 @@
+/**
+ * @file app_heap.c
+ * @brief RTOS堆监视模块实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_heap.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_task.h"
+#include "core_delay.h"
+#include "mem_section.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 统计状态与打印快照(各约2KB，CPU独占，放在CCMRAM) */
+static MEM_CCMBSS HeapStat_TypeDef s_xStat;
+static MEM_CCMBSS HeapStat_TypeDef s_xSnapshot;
+
+/* AppHeap_MallocFrom登记的调用者(调度器挂起期间有效，NULL=使用钩子传入的返回地址) */
+static void *s_pvCaller = NULL;
+
+/* 钩子开销(DWT周期) */
+static uint32_t s_ulHookCalls;
+static uint32_t s_ulHookCycles;
+static uint32_t s_ulHookMax;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 累计一次钩子耗时
+ */
+static inline void AppHeap_Account(uint32_t start)
+{
+    uint32_t cycles = CPU_TS_TmrRd() - start;
+
+    s_ulHookCalls++;
+    s_ulHookCycles += cycles;
+    if (cycles > s_ulHookMax)
+    {
+        s_ulHookMax = cycles;
+    }
+}
+
+/**
+ * @brief 空闲块遍历回调(调度器已挂起)
+ */
+static void AppHeap_Visit(void *ctx, size_t size)
+{
+    HeapStat_WalkBlock((HeapStat_TypeDef *)ctx, (uint32_t)size);
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppHeap_Init(void)
+{
+    HeapStat_Init(&s_xStat, (uint32_t)AppTask_HeapTotal());
+}
+
+void AppHeap_OnMalloc(void *pv, size_t size, void *caller)
+{
+    uint32_t start = CPU_TS_TmrRd();
+
+    if (s_pvCaller != NULL)
+    {
+        caller = s_pvCaller;
+    }
+    HeapStat_Alloc(&s_xStat, pv, (uint32_t)size, (uintptr_t)caller);
+    AppHeap_Account(start);
+}
+
+void *AppHeap_MallocFrom(size_t size, void *caller)
+{
+    void *pv;
+
+    vTaskSuspendAll();
+    s_pvCaller = caller;
+    pv = pvPortMalloc(size);
+    s_pvCaller = NULL;
+    (void)xTaskResumeAll();
+
+    return pv;
+}
+
+int AppHeap_GetCaller(const void *caller, HeapStat_Caller_TypeDef *out)
+{
+    int rc = -1;
+
+    vTaskSuspendAll();
+    for (uint32_t i = 0; i < s_xStat.caller_count; i++)
+    {
+        if (s_xStat.caller[i].caller == (uintptr_t)caller)
+        {
+            *out = s_xStat.caller[i];
+            rc = 0;
+            break;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return rc;
+}
+
+void AppHeap_OnFree(void *pv, size_t size)
+{
+    uint32_t start = CPU_TS_TmrRd();
+
+    HeapStat_Free(&s_xStat, pv, (uint32_t)size);
+    AppHeap_Account(start);
+}
+
+void AppHeap_Sample(uint32_t t, AppHeap_Summary_TypeDef *sum)
+{
+    vTaskSuspendAll();
+    HeapStat_WalkBegin(&s_xStat);
+    vPortHeapWalk(AppHeap_Visit, &s_xStat);
+    HeapStat_WalkEnd(&s_xStat, t);
+
+    sum->free = s_xStat.free_bytes;
+    sum->min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+    sum->largest = s_xStat.largest;
+    sum->free_blocks = s_xStat.free_blocks;
+    sum->frag = HeapStat_FragPermille(&s_xStat);
+    sum->allocs = s_xStat.allocs;
+    sum->fails = s_xStat.fails;
+    (void)xTaskResumeAll();
+}
+
+MEM_COLD void AppHeap_Dump(void)
+{
+    uint32_t calls;
+    uint32_t cycles;
+    uint32_t max;
+
+    vTaskSuspendAll();
+    memcpy(&s_xSnapshot, &s_xStat, sizeof(s_xSnapshot));
+    calls = s_ulHookCalls;
+    cycles = s_ulHookCycles;
+    max = s_ulHookMax;
+    (void)xTaskResumeAll();
+
+    HeapStat_Dump(&s_xSnapshot, printf, APP_HEAP_DUMP_LIVE);
+    printf("-- hook overhead: %lu calls, avg %lu cycles, max %lu cycles\r\n",
+           (unsigned long)calls,
+           (unsigned long)((calls != 0) ? cycles / calls : 0U),
+           (unsigned long)max);
+}
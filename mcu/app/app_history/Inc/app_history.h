@@ -0,0 +1,104 @@
+/**
+ * @file app_history.h
+ * @brief 传感器历史数据模块头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 为每个传感器通道维护一条分级时间序列(原始/分钟/小时)，
+ *       供趋势显示与导出使用。缓冲区放在CCMRAM，容量固定
+ *       每个关闭的分钟桶同时写入Flash日志(app_log)
+ *       时间戳为系统启动后的秒数(64位DWT时间戳换算，单调递增，约136年内不回绕)
+ */
+
+#ifndef __APP_HISTORY_H
+#define __APP_HISTORY_H
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "tseries.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_HISTORY_RAW_LEN 128    /**< 原始样本容量 */
+#define APP_HISTORY_MINUTE_LEN 120 /**< 分钟桶容量(2小时) */
+#define APP_HISTORY_HOUR_LEN 168   /**< 小时桶容量(7天) */
+#define APP_HISTORY_LOCK_MS 100    /**< 等待访问互斥量的最长时间(毫秒) */
+
+/**
+ * @brief 历史数据通道
+ */
+typedef enum
+{
+    APP_HISTORY_TEMPERATURE = 0, /**< 温度(℃) */
+    APP_HISTORY_HUMIDITY,        /**< 湿度(%RH) */
+    APP_HISTORY_LIGHT_LUX,       /**< 照度(lux) */
+    APP_HISTORY_CHANNEL_NUM,
+} AppHistory_Channel_t;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化历史数据模块
+ * @author Yukikaze
+ *
+ * @return BaseType_t 初始化结果(pdPASS=成功, pdFAIL=失败)
+ *
+ * @note 需要在AppData_Init之后、创建采集任务前调用
+ *       通过数据总线订阅温度/湿度/照度，有效样本自动记录
+ */
+BaseType_t AppHistory_Init(void);
+
+/**
+ * @brief 记录一个样本(线程安全)
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param value 样本值
+ * @return int 0=已记录, -1=通道无效/未初始化/等待互斥量超时(样本丢弃并计数)
+ */
+int AppHistory_Record(AppHistory_Channel_t ch, int32_t value);
+
+/**
+ * @brief 按时间范围查询(线程安全)
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param tier 存储级别
+ * @param t_from 起始时间(秒，含)
+ * @param t_to 结束时间(秒，含)
+ * @param out 输出缓冲
+ * @param max 输出缓冲容量
+ * @return uint16_t 实际输出个数，按时间从旧到新排列
+ */
+uint16_t AppHistory_Query(AppHistory_Channel_t ch, TSeries_Tier_t tier,
+                          uint32_t t_from, uint32_t t_to,
+                          TSeries_Agg_TypeDef *out, uint16_t max);
+
+/**
+ * @brief 获取通道因等待互斥量超时而丢弃的样本数
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @return uint32_t 启动以来的累计丢弃数
+ */
+uint32_t AppHistory_GetDropped(AppHistory_Channel_t ch);
+
+/**
+ * @brief 获取当前时间戳
+ * @author Yukikaze
+ *
+ * @return uint32_t 系统启动后的秒数
+ *
+ * @note 由CPU_TS_Read64换算，不随节拍计数回绕；时间原点为CPU_TS_TmrInit
+ */
+uint32_t AppHistory_Now(void);
+
+#endif /* __APP_HISTORY_H */
@@ -0,0 +1,163 @@
+/**
+ * @file app_history.c
+ * @brief 传感器历史数据模块实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每通道占用 TSERIES_FOOTPRINT(128, 120, 168) 约6.8KB，三通道约20KB CCMRAM
+ */
+
+#include "app_history.h"
+#include "app_log.h"
+#include "app_bus.h"
+#include "app_task.h"
+#include "core_delay.h"
+#include "mem_section.h"
+#include "task.h"
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 各通道时间序列及其存储(CCMRAM，由TSeries_Init初始化控制块) */
+static MEM_CCMBSS TSeries_TypeDef s_xSeries[APP_HISTORY_CHANNEL_NUM];
+static MEM_CCMBSS TSeries_Sample_TypeDef s_xRaw[APP_HISTORY_CHANNEL_NUM][APP_HISTORY_RAW_LEN];
+static MEM_CCMBSS TSeries_Agg_TypeDef s_xMinute[APP_HISTORY_CHANNEL_NUM][APP_HISTORY_MINUTE_LEN];
+static MEM_CCMBSS TSeries_Agg_TypeDef s_xHour[APP_HISTORY_CHANNEL_NUM][APP_HISTORY_HOUR_LEN];
+
+/* 历史数据访问互斥量 */
+static SemaphoreHandle_t s_xHistoryMutex = NULL;
+static StaticSemaphore_t s_xHistoryMutexBuf;
+
+/* 等待互斥量超时丢弃的样本数(每个通道只有一个发布任务，无需原子操作) */
+static volatile uint32_t s_ulDropped[APP_HISTORY_CHANNEL_NUM];
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 数据总线回调: 有效样本写入对应通道
+ */
+static void AppHistory_OnSample(void *ctx, const AppBus_Sample_TypeDef *sample)
+{
+    (void)ctx;
+
+    if (!sample->valid)
+    {
+        return;
+    }
+
+    switch (sample->topic)
+    {
+    case APP_BUS_TOPIC_TEMPERATURE:
+        AppHistory_Record(APP_HISTORY_TEMPERATURE, sample->value);
+        break;
+    case APP_BUS_TOPIC_HUMIDITY:
+        AppHistory_Record(APP_HISTORY_HUMIDITY, sample->value);
+        break;
+    case APP_BUS_TOPIC_LIGHT_LUX:
+        AppHistory_Record(APP_HISTORY_LIGHT_LUX, sample->value);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+BaseType_t AppHistory_Init(void)
+{
+    s_xHistoryMutex = AppTask_CreateMutex(&s_xHistoryMutexBuf);
+    if (s_xHistoryMutex == NULL)
+    {
+        return pdFAIL;
+    }
+
+    for (uint8_t ch = 0; ch < APP_HISTORY_CHANNEL_NUM; ch++)
+    {
+        TSeries_Init(&s_xSeries[ch],
+                     s_xRaw[ch], APP_HISTORY_RAW_LEN,
+                     s_xMinute[ch], APP_HISTORY_MINUTE_LEN,
+                     s_xHour[ch], APP_HISTORY_HOUR_LEN);
+    }
+
+    /* 订阅数据总线(需在AppData_Init之后) */
+    if (AppBus_SubscribeCallback(APP_BUS_MASK(APP_BUS_TOPIC_TEMPERATURE) |
+                                     APP_BUS_MASK(APP_BUS_TOPIC_HUMIDITY) |
+                                     APP_BUS_MASK(APP_BUS_TOPIC_LIGHT_LUX),
+                                 0, AppHistory_OnSample, NULL) < 0)
+    {
+        return pdFAIL;
+    }
+
+    return pdPASS;
+}
+
+int AppHistory_Record(AppHistory_Channel_t ch, int32_t value)
+{
+    TSeries_Agg_TypeDef minute;
+    int closed = 0;
+
+    if (ch >= APP_HISTORY_CHANNEL_NUM || s_xHistoryMutex == NULL)
+    {
+        return -1;
+    }
+
+    /* 在发布任务的上下文中执行，不能无限等待；超时丢弃样本并计数 */
+    if (xSemaphoreTake(s_xHistoryMutex, pdMS_TO_TICKS(APP_HISTORY_LOCK_MS)) != pdTRUE)
+    {
+        s_ulDropped[ch]++;
+        return -1;
+    }
+    if (TSeries_Append(&s_xSeries[ch], AppHistory_Now(), value) == 1)
+    {
+        closed = (TSeries_Latest(&s_xSeries[ch], TSERIES_TIER_MINUTE, &minute) == 0);
+    }
+    xSemaphoreGive(s_xHistoryMutex);
+
+    /* 关闭的分钟桶交给持久化日志(只入队，Flash由Task_Log写入) */
+    if (closed)
+    {
+        AppLog_Write((uint8_t)ch, &minute);
+    }
+    return 0;
+}
+
+uint16_t AppHistory_Query(AppHistory_Channel_t ch, TSeries_Tier_t tier,
+                          uint32_t t_from, uint32_t t_to,
+                          TSeries_Agg_TypeDef *out, uint16_t max)
+{
+    uint16_t n = 0;
+
+    if (ch >= APP_HISTORY_CHANNEL_NUM || s_xHistoryMutex == NULL)
+    {
+        return 0;
+    }
+
+    if (xSemaphoreTake(s_xHistoryMutex, pdMS_TO_TICKS(APP_HISTORY_LOCK_MS)) == pdTRUE)
+    {
+        n = TSeries_Query(&s_xSeries[ch], tier, t_from, t_to, out, max);
+        xSemaphoreGive(s_xHistoryMutex);
+    }
+    return n;
+}
+
+uint32_t AppHistory_GetDropped(AppHistory_Channel_t ch)
+{
+    return (ch < APP_HISTORY_CHANNEL_NUM) ? s_ulDropped[ch] : 0;
+}
+
+uint32_t AppHistory_Now(void)
+{
+    /* 节拍计数约49.7天回绕，64位时间戳不回绕(STOP期间由低功耗模块补齐) */
+    return (uint32_t)(CPU_TS_ToUs(CPU_TS_Read64()) / 1000000U);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file app_log.h
+ * @brief 传感器持久化日志模块头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 将每个通道的分钟聚合写入片内Flash扇区8~10(共384KB)，复位后不丢失
+ *       每条记录20字节，3个通道约可保存4天
+ *       写入与Flash操作分离:
+ *       - AppLog_Write从app_pool分配记录并把指针放入队列(不阻塞)，池用尽或队列满时丢弃并计数
+ *       - Task_Log(最低优先级)取出记录追加到RAM缓冲，第一条未写出的记录到达
+ *         APP_LOG_FLUSH_MS后写入Flash；同一分钟关闭的各通道记录合并为一块
+ *       - 复位时最多丢失APP_LOG_FLUSH_MS内的记录(及队列中尚未取出的记录)
+ *       扇区轮换时擦除128KB扇区，CPU取指停顿1~2秒(扇区8~10与代码同在Bank1)，
+ *       只发生在Task_Log中，约30小时一次
+ *       每次上电写入一条启动标记并立即写出，用于区分不同上电周期(时间戳从0重新开始)
+ */
+
+#ifndef __APP_LOG_H
+#define __APP_LOG_H
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "tseries.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_LOG_CH_BOOT 0xFF /**< 启动标记通道号 */
+
+#define APP_LOG_TASK_NAME "Task_Log"  /**< 任务名称 */
+#define APP_LOG_TASK_STACK_SIZE 256   /**< 任务栈大小(字) */
+#define APP_LOG_TASK_PRIORITY 1       /**< 任务优先级(最低，Flash操作不影响采集与显示) */
+#define APP_LOG_QUEUE_LEN 8           /**< 待写记录队列长度 */
+#define APP_LOG_FLUSH_MS 1000         /**< 第一条未写出记录到写入Flash的最长时间(毫秒) */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 日志记录(Flash中的存储格式)
+ */
+typedef struct
+{
+    uint32_t t;     /**< 分钟桶起始时间(上电后秒数) */
+    int32_t min;    /**< 最小值 */
+    int32_t max;    /**< 最大值 */
+    int32_t avg;    /**< 平均值 */
+    uint16_t count; /**< 样本数 */
+    uint8_t ch;     /**< 通道(AppHistory_Channel_t 或 APP_LOG_CH_BOOT) */
+    uint8_t reserved;
+} AppLog_Record_TypeDef;
+
+/**
+ * @brief 日志遍历回调
+ *
+ * @return int 0=继续, 非0=停止
+ */
+typedef int (*AppLog_Visit_t)(void *ctx, const AppLog_Record_TypeDef *rec);
+
+/**
+ * ============================================================================
+ * 全局变量
+ * ============================================================================
+ */
+extern TaskHandle_t AppLog_Task_Handle;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化日志模块(挂载Flash日志并写入启动标记)
+ * @author Yukikaze
+ *
+ * @return BaseType_t 初始化结果(pdPASS=成功, pdFAIL=失败)
+ *
+ * @note 在启动工作任务中执行(见app_boot.h): 扇区内有旧数据而无有效日志时需要擦除，耗时1~2秒；
+ *       挂载成功后才开放访问，之前(或挂载失败时)的写入直接丢弃，遍历返回0
+ */
+BaseType_t AppLog_Init(void);
+
+/**
+ * @brief 记录一个分钟聚合(线程安全，不阻塞)
+ * @author Yukikaze
+ *
+ * @param ch 通道
+ * @param agg 分钟聚合
+ *
+ * @note 只入队，由Task_Log写Flash并释放记录；池用尽或队列满时丢弃(AppLog_Dropped计数)
+ */
+void AppLog_Write(uint8_t ch, const TSeries_Agg_TypeDef *agg);
+
+/**
+ * @brief 因队列满或未挂载而丢弃的记录数
+ * @author Yukikaze
+ */
+uint32_t AppLog_Dropped(void);
+
+/**
+ * @brief 立即将缓冲写入Flash(线程安全)
+ * @author Yukikaze
+ */
+void AppLog_Flush(void);
+
+/**
+ * @brief 从旧到新遍历日志(线程安全)
+ * @author Yukikaze
+ *
+ * @param visit 回调
+ * @param ctx 回调参数
+ * @return uint32_t 遍历的记录数
+ */
+uint32_t AppLog_Iterate(AppLog_Visit_t visit, void *ctx);
+
+/**
+ * @brief 日志写入任务
+ * @author Yukikaze
+ *
+ * @param pvParameters 任务参数(未使用)
+ *
+ * @note 等待日志挂载(APP_BOOT_RES_LOG)，挂载失败时删除自身；
+ *       之后取出队列中的记录追加到缓冲，按APP_LOG_FLUSH_MS写入Flash
+ */
+void AppLog_Task(void *pvParameters);
+
+#endif /* __APP_LOG_H */
@@ -0,0 +1,258 @@
+/**
+ * @file app_log.c
+ * @brief 传感器持久化日志模块实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_log.h"
+#include "app_boot.h"
+#include "app_pool.h"
+#include "app_task.h"
+#include "bsp_flash.h"
+#include "flog.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有函数声明
+ * ============================================================================
+ */
+
+static int AppLog_FlashRead(uint32_t addr, void *buf, uint32_t len);
+static int AppLog_Visit(void *ctx, uint32_t seq, const uint8_t *data, uint8_t len);
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 片内Flash访问接口 */
+static const FLog_Ops_TypeDef s_xFlashOps = {
+    BSP_Flash_EraseSector,
+    BSP_Flash_Program,
+    AppLog_FlashRead,
+};
+
+/* 日志实例 */
+static FLog_TypeDef s_xLog;
+
+/* 日志访问互斥量 */
+static SemaphoreHandle_t s_xLogMutex = NULL;
+static StaticSemaphore_t s_xLogMutexBuf;
+
+/* 待写记录队列(AppLog_Write -> Task_Log)，传递内存池中记录的指针 */
+static QueueHandle_t s_xLogQueue = NULL;
+static StaticQueue_t s_xLogQueueBuf;
+static uint8_t s_ucLogQueueStorage[APP_LOG_QUEUE_LEN * sizeof(AppLog_Record_TypeDef *)];
+
+/* 丢弃的记录数 */
+static volatile uint32_t s_ulDropped = 0;
+
+/* 任务句柄 */
+TaskHandle_t AppLog_Task_Handle = NULL;
+
+/* 遍历回调转换参数 */
+typedef struct
+{
+    AppLog_Visit_t visit;
+    void *ctx;
+} AppLog_IterCtx_TypeDef;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 读取Flash(片内Flash直接映射在地址空间中)
+ */
+static int AppLog_FlashRead(uint32_t addr, void *buf, uint32_t len)
+{
+    memcpy(buf, (const void *)(uintptr_t)addr, len);
+    return 0;
+}
+
+/**
+ * @brief FLog记录 -> AppLog记录
+ */
+static int AppLog_Visit(void *ctx, uint32_t seq, const uint8_t *data, uint8_t len)
+{
+    AppLog_IterCtx_TypeDef *it = (AppLog_IterCtx_TypeDef *)ctx;
+    AppLog_Record_TypeDef rec;
+
+    (void)seq;
+
+    if (len != sizeof(rec))
+    {
+        return 0;
+    }
+    memcpy(&rec, data, sizeof(rec));
+    return it->visit(it->ctx, &rec);
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+BaseType_t AppLog_Init(void)
+{
+    AppLog_Record_TypeDef boot;
+    SemaphoreHandle_t mutex;
+
+    mutex = AppTask_CreateMutex(&s_xLogMutexBuf);
+    s_xLogQueue = AppTask_CreateQueue(APP_LOG_QUEUE_LEN, sizeof(AppLog_Record_TypeDef *),
+                                      s_ucLogQueueStorage, &s_xLogQueueBuf);
+    if (mutex == NULL || s_xLogQueue == NULL)
+    {
+        return pdFAIL;
+    }
+
+    if (FLog_Mount(&s_xLog, &s_xFlashOps, BSP_FLASH_LOG_ADDR,
+                   BSP_FLASH_LOG_SECTOR_SIZE, BSP_FLASH_LOG_SECTORS) < 0)
+    {
+        return pdFAIL;
+    }
+
+    memset(&boot, 0, sizeof(boot));
+    boot.ch = APP_LOG_CH_BOOT;
+    FLog_Append(&s_xLog, &boot, sizeof(boot));
+    FLog_Flush(&s_xLog);
+
+    /* 最后发布互斥量: 任务已在运行，挂载完成前的访问看到NULL直接返回 */
+    s_xLogMutex = mutex;
+
+    return pdPASS;
+}
+
+void AppLog_Write(uint8_t ch, const TSeries_Agg_TypeDef *agg)
+{
+    AppLog_Record_TypeDef *rec;
+
+    if (agg == NULL)
+    {
+        return;
+    }
+    if (s_xLogMutex == NULL)
+    {
+        s_ulDropped++;
+        return;
+    }
+
+    /* 池用尽时的失败次数同时计入内存池统计(M行) */
+    rec = (AppLog_Record_TypeDef *)AppPool_Alloc(sizeof(*rec));
+    if (rec == NULL)
+    {
+        s_ulDropped++;
+        return;
+    }
+
+    rec->t = agg->t;
+    rec->min = agg->min;
+    rec->max = agg->max;
+    rec->avg = agg->avg;
+    rec->count = (agg->count > 0xFFFFU) ? 0xFFFFU : (uint16_t)agg->count;
+    rec->ch = ch;
+    rec->reserved = 0xFF;
+
+    if (xQueueSend(s_xLogQueue, &rec, 0) != pdTRUE)
+    {
+        (void)AppPool_Free(rec);
+        s_ulDropped++;
+    }
+}
+
+uint32_t AppLog_Dropped(void)
+{
+    return s_ulDropped;
+}
+
+void AppLog_Flush(void)
+{
+    if (s_xLogMutex == NULL)
+    {
+        return;
+    }
+
+    if (xSemaphoreTake(s_xLogMutex, portMAX_DELAY) == pdTRUE)
+    {
+        FLog_Flush(&s_xLog);
+        xSemaphoreGive(s_xLogMutex);
+    }
+}
+
+uint32_t AppLog_Iterate(AppLog_Visit_t visit, void *ctx)
+{
+    AppLog_IterCtx_TypeDef it;
+    uint32_t n = 0;
+
+    if (visit == NULL || s_xLogMutex == NULL)
+    {
+        return 0;
+    }
+
+    it.visit = visit;
+    it.ctx = ctx;
+
+    if (xSemaphoreTake(s_xLogMutex, portMAX_DELAY) == pdTRUE)
+    {
+        n = FLog_Iterate(&s_xLog, AppLog_Visit, &it);
+        xSemaphoreGive(s_xLogMutex);
+    }
+    return n;
+}
+
+void AppLog_Task(void *pvParameters)
+{
+    const TickType_t period = pdMS_TO_TICKS(APP_LOG_FLUSH_MS);
+    AppLog_Record_TypeDef *rec;
+    TickType_t first = 0;
+    TickType_t elapsed;
+    TickType_t wait;
+    uint8_t pending = 0;
+
+    (void)pvParameters;
+
+    AppBoot_Wait(APP_BOOT_RES_LOG, portMAX_DELAY);
+    if (s_xLogMutex == NULL)
+    {
+        /* 挂载失败，写入一律丢弃 */
+        vTaskDelete(NULL);
+    }
+
+    for (;;)
+    {
+        wait = portMAX_DELAY;
+        if (pending)
+        {
+            elapsed = xTaskGetTickCount() - first;
+            wait = (elapsed < period) ? (period - elapsed) : 0;
+        }
+
+        if (xQueueReceive(s_xLogQueue, &rec, wait) == pdTRUE)
+        {
+            if (xSemaphoreTake(s_xLogMutex, portMAX_DELAY) == pdTRUE)
+            {
+                FLog_Append(&s_xLog, rec, sizeof(*rec));
+                xSemaphoreGive(s_xLogMutex);
+            }
+            (void)AppPool_Free(rec);
+            if (!pending)
+            {
+                pending = 1;
+                first = xTaskGetTickCount();
+            }
+        }
+
+        /* 第一条未写出的记录已等待APP_LOG_FLUSH_MS */
+        if (pending && (TickType_t)(xTaskGetTickCount() - first) >= period)
+        {
+            AppLog_Flush();
+            pending = 0;
+        }
+    }
+}
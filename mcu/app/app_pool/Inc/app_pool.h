@@ -0,0 +1,94 @@
+/**
+ * @file app_pool.h
+ * @brief 应用消息内存池头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 为传感器消息、日志记录、显示命令等短生命周期对象提供定长块分配(libx/mempool):
+ *       - 三个块大小等级，按请求大小自动选择最小可用等级，满时退到更大的等级
+ *       - 分配/释放为O(1)无锁操作，任务与中断中均可调用，耗时与碎片无关
+ *       - 各等级的占用峰值、失败与错误次数由Task_Prof以M行输出(格式见task_prof.h)
+ *       - 使用者: app_log的待写记录(AppLog_Write分配，Task_Log写入Flash后释放，中块)
+ *       与heap_4的分配延迟对比见app_bench的pool_alloc/heap4_alloc用例
+ *       块存储放在CCMRAM，不能作为DMA缓冲
+ *       调试时以 -DMEMPOOL_GUARD=1 编译可启用守护字与毒化检查
+ */
+
+#ifndef __APP_POOL_H
+#define __APP_POOL_H
+
+#include "mempool.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_POOL_SMALL_SIZE 16    /**< 小块大小(字节): 传感器消息 */
+#define APP_POOL_SMALL_COUNT 32   /**< 小块数量 */
+#define APP_POOL_MEDIUM_SIZE 64   /**< 中块大小(字节): 日志记录(AppLog_Record_TypeDef)、显示命令 */
+#define APP_POOL_MEDIUM_COUNT 16  /**< 中块数量 */
+#define APP_POOL_LARGE_SIZE 256   /**< 大块大小(字节): 文本行、批量数据 */
+#define APP_POOL_LARGE_COUNT 4    /**< 大块数量 */
+
+/**
+ * ============================================================================
+ * 类型定义
+ * ============================================================================
+ */
+
+/**
+ * @brief 块大小等级
+ */
+typedef enum
+{
+    APP_POOL_SMALL = 0,
+    APP_POOL_MEDIUM,
+    APP_POOL_LARGE,
+    APP_POOL_NUM
+} AppPool_Class_t;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化全部内存池
+ * @author Yukikaze
+ *
+ * @note 须在任何任务或中断使用内存池之前调用(App_Init中)
+ */
+void AppPool_Init(void);
+
+/**
+ * @brief 分配一块至少size字节的内存(任务/中断均可调用)
+ * @author Yukikaze
+ *
+ * @param size 请求大小(字节)
+ * @return void* 块地址(8字节对齐)，超过最大块或全部用尽时返回NULL
+ */
+void *AppPool_Alloc(size_t size);
+
+/**
+ * @brief 释放由AppPool_Alloc分配的块(任务/中断均可调用)
+ * @author Yukikaze
+ *
+ * @param ptr 块地址(NULL时直接返回)
+ * @return int MemPool_Result_t
+ */
+int AppPool_Free(void *ptr);
+
+/**
+ * @brief 读取某一等级的统计快照
+ * @author Yukikaze
+ *
+ * @param cls 块大小等级
+ * @param stats 输出
+ */
+void AppPool_GetStats(AppPool_Class_t cls, MemPool_Stats_TypeDef *stats);
+
+#endif /* __APP_POOL_H */
@@ -0,0 +1,60 @@
+/**
+ * @file app_pool.c
+ * @brief 应用消息内存池实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_pool.h"
+#include "mem_section.h"
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 块存储与链接数组(约2.5KB，CPU独占，放在CCMRAM) */
+MEMPOOL_STORAGE(static MEM_CCMBSS, Small, APP_POOL_SMALL_SIZE, APP_POOL_SMALL_COUNT);
+MEMPOOL_STORAGE(static MEM_CCMBSS, Medium, APP_POOL_MEDIUM_SIZE, APP_POOL_MEDIUM_COUNT);
+MEMPOOL_STORAGE(static MEM_CCMBSS, Large, APP_POOL_LARGE_SIZE, APP_POOL_LARGE_COUNT);
+
+static MemPool_TypeDef s_xPool[APP_POOL_NUM];
+
+/* 按块大小升序排列，供MemPool_SetAlloc选择 */
+static MemPool_TypeDef *const s_pxPools[APP_POOL_NUM] = {
+    &s_xPool[APP_POOL_SMALL],
+    &s_xPool[APP_POOL_MEDIUM],
+    &s_xPool[APP_POOL_LARGE],
+};
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppPool_Init(void)
+{
+    MEMPOOL_INIT(&s_xPool[APP_POOL_SMALL], Small, APP_POOL_SMALL_SIZE, APP_POOL_SMALL_COUNT);
+    MEMPOOL_INIT(&s_xPool[APP_POOL_MEDIUM], Medium, APP_POOL_MEDIUM_SIZE, APP_POOL_MEDIUM_COUNT);
+    MEMPOOL_INIT(&s_xPool[APP_POOL_LARGE], Large, APP_POOL_LARGE_SIZE, APP_POOL_LARGE_COUNT);
+}
+
+void *AppPool_Alloc(size_t size)
+{
+    return MemPool_SetAlloc(s_pxPools, APP_POOL_NUM, size);
+}
+
+int AppPool_Free(void *ptr)
+{
+    return MemPool_SetFree(s_pxPools, APP_POOL_NUM, ptr);
+}
+
+void AppPool_GetStats(AppPool_Class_t cls, MemPool_Stats_TypeDef *stats)
+{
+    if (cls < APP_POOL_NUM)
+    {
+        MemPool_GetStats(&s_xPool[cls], stats);
+    }
+}
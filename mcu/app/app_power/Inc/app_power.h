@@ -0,0 +1,125 @@
+/**
+ * @file app_power.h
+ * @brief 无节拍空闲低功耗管理头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 作为 portSUPPRESS_TICKS_AND_SLEEP 的实现(见FreeRTOSConfig.h)，空闲任务在
+ *       所有任务阻塞时调用，按预计空闲时长选择:
+ *       - SLEEP: 延长SysTick重装值后WFI，最长 0xFFFFFF/(SystemCoreClock/节拍频率) 个节拍
+ *                (180MHz下93毫秒，48MHz下349毫秒)；未唤醒任务的中断处理完后继续睡眠
+ *       - STOP:  停止SysTick，由RTC唤醒定时器唤醒，按RTC前后快照补齐节拍数，
+ *                不足一个节拍的部分通过缩短第一个节拍补偿
+ *       预计空闲时长同时受软件定时器(app_timer)下一次到期的限制，
+ *       休眠结束时由vTaskStepTick -> traceINCREASE_TICK_COUNT补齐时间轮
+ *
+ *       STOP期间所有外设时钟停止(ADC不转换、串口不收发)，需要外设持续工作的
+ *       模块用AppPower_StopLock禁止STOP；唤醒后补齐DWT CYCCNT，
+ *       运行时间统计中的休眠时间计入IDLE任务
+ */
+
+#ifndef __APP_POWER_H
+#define __APP_POWER_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_POWER_STOP_ENABLE 1         /**< 是否允许STOP(0=只使用SLEEP) */
+#define APP_POWER_STOP_MIN_TICKS 20     /**< 进入STOP的最小空闲节拍数 */
+#define APP_POWER_STOP_WAKE_TICKS 3     /**< 提前唤醒余量(HSE起振+PLL锁定约1~2ms) */
+#define APP_POWER_STOP_MAX_TICKS 16000  /**< 单次STOP上限(补齐的CYCCNT不超过32位) */
+#define APP_POWER_SYSTICK_COMP 45       /**< 停止SysTick期间丢失的计数补偿(同port.c) */
+#define APP_POWER_TS_SLACK 256          /**< CYCCNT误差小于此值时不补齐 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 休眠驻留统计(累计值，读取方按窗口做差)
+ */
+typedef struct
+{
+    uint64_t sleep_cycles; /**< SLEEP累计时长(内核时钟周期) */
+    uint64_t stop_cycles;  /**< STOP累计时长(内核时钟周期) */
+    uint32_t sleeps;       /**< 进入SLEEP次数 */
+    uint32_t stops;        /**< 进入STOP次数 */
+    uint32_t aborts;       /**< 进入前放弃的次数(有任务就绪或节拍已到) */
+    uint32_t wakes;        /**< SLEEP中处理的非节拍中断次数 */
+    uint32_t early;        /**< STOP被其他中断提前唤醒的次数 */
+    uint32_t late;         /**< STOP唤醒晚于预期、节拍被截断的次数 */
+} AppPower_Stats_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化低功耗管理(SLEEP路径)
+ * @author Yukikaze
+ *
+ * @note 在系统时钟配置与CPU_TS_TmrInit之后、启动调度器之前调用；
+ *       此后空闲时只使用SLEEP，直到AppPower_InitStop完成
+ */
+void AppPower_Init(void);
+
+/**
+ * @brief 初始化RTC与唤醒定时器，成功后允许STOP
+ * @author Yukikaze
+ *
+ * @return int 0=STOP可用, 1=STOP可用但RTC使用LSI(计时误差大), -1=只使用SLEEP
+ *
+ * @note 在AppPower_Init之后调用；LSE起振最长约1秒，调度器运行时等待期间
+ *       每个节拍让出一次CPU，因此放在启动工作任务中执行(见app_boot.h)
+ */
+int AppPower_InitStop(void);
+
+/**
+ * @brief 系统时钟切换后重新计算节拍参数
+ * @author Yukikaze
+ *
+ * @note 由AppClock_Set在关中断下、BSP_Clock_Apply之后调用:
+ *       SysTick当前节拍的剩余部分按新频率换算，此后每个节拍为SystemCoreClock/节拍频率
+ */
+void AppPower_ClockUpdate(void);
+
+/**
+ * @brief 无节拍空闲入口(portSUPPRESS_TICKS_AND_SLEEP)
+ * @author Yukikaze
+ *
+ * @param xExpectedIdleTime 内核给出的预计空闲节拍数
+ *
+ * @note 由空闲任务在调度器挂起时调用
+ */
+void AppPower_SuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+
+/**
+ * @brief 禁止STOP(可嵌套，任务或中断中调用)
+ * @author Yukikaze
+ */
+void AppPower_StopLock(void);
+
+/**
+ * @brief 解除AppPower_StopLock
+ * @author Yukikaze
+ */
+void AppPower_StopUnlock(void);
+
+/**
+ * @brief 读取休眠驻留统计
+ * @author Yukikaze
+ *
+ * @param out 输出统计
+ */
+void AppPower_GetStats(AppPower_Stats_TypeDef *out);
+
+#endif /* __APP_POWER_H */
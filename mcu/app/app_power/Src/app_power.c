@@ -0,0 +1,369 @@
+/**
+ * @file app_power.c
+ * @brief 无节拍空闲低功耗管理实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note SysTick路径沿用port.c中vPortSuppressTicksAndSleep的重装值计算，
+ *       区别在于被非节拍中断唤醒时，只要没有任务就绪就继续睡眠
+ *       (ADC EOC中断频率很高，退出后重新进入的开销不可忽略)
+ *       整个过程在PRIMASK关中断下进行，WFI仍可被挂起的中断唤醒
+ */
+
+#include "app_power.h"
+#include "task.h"
+#include "app_timer.h"
+#include "bsp_power.h"
+#include "core_delay.h"
+#include "tickless.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 一个节拍的SysTick计数(SysTick时钟=内核时钟) */
+static uint32_t s_ulCountsPerTick;
+
+/* SLEEP路径的最大节拍数(24位重装值限制) */
+static uint32_t s_ulMaxSleepTicks;
+
+/* 节拍/RTC时钟参数(RTC不可用时min_stop为0且不允许STOP) */
+static Tickless_Config_TypeDef s_xCfg;
+static uint8_t s_ucStopReady = 0;
+
+/* STOP禁止计数 */
+static volatile uint32_t s_ulStopLock = 0;
+
+static AppPower_Stats_TypeDef s_xStats;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 休眠期间CYCCNT少计的部分补到时间戳上
+ *
+ * @param elapsed 休眠实际经过的内核时钟周期
+ * @param counted 同一期间CYCCNT的增量
+ */
+static void AppPower_FixTimestamp(uint32_t elapsed, uint32_t counted)
+{
+    if (elapsed > counted + APP_POWER_TS_SLACK)
+    {
+        CPU_TS_Advance(elapsed - counted);
+    }
+}
+
+/**
+ * @brief 放弃休眠: 节拍中断已挂起时恢复SysTick，由中断正常计数
+ * @return int 1=已放弃
+ */
+static int AppPower_TickPending(void)
+{
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        s_xStats.aborts++;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 等待LSE起振时的让出函数: 调度器运行时睡眠一个节拍，否则忙等
+ */
+static void AppPower_WaitYield(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+    {
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief SLEEP: 延长SysTick周期后WFI
+ */
+static void AppPower_Sleep(TickType_t xIdle)
+{
+    uint32_t reload;
+    uint32_t ctrl = 0;
+    uint32_t elapsed;
+    uint32_t cyc0;
+    uint32_t ticks;
+
+    if (xIdle > s_ulMaxSleepTicks)
+    {
+        xIdle = s_ulMaxSleepTicks;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    if (AppPower_TickPending())
+    {
+        return;
+    }
+
+    reload = Tickless_SleepReload(s_ulCountsPerTick, SysTick->VAL, xIdle, APP_POWER_SYSTICK_COMP);
+
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    cyc0 = CPU_TS_TmrRd();
+
+    for (;;)
+    {
+        __DSB();
+        __WFI();
+        __ISB();
+
+        /* 读CTRL会清除COUNTFLAG，结果累积保存 */
+        ctrl |= SysTick->CTRL;
+        if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0)
+        {
+            break;
+        }
+
+        /* 其他中断: 短暂开中断让其执行，没有任务就绪则继续睡眠 */
+        __enable_irq();
+        __ISB();
+        __disable_irq();
+        s_xStats.wakes++;
+
+        ctrl |= SysTick->CTRL;
+        if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0 ||
+            eTaskConfirmSleepModeStatus() == eAbortSleep)
+        {
+            break;
+        }
+    }
+
+    ctrl |= SysTick->CTRL;
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+    if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0)
+    {
+        /* 计满一次: 节拍中断已执行或挂起(计1个节拍)，SysTick已从reload重新计数 */
+        uint32_t current = SysTick->VAL;
+
+        elapsed = reload + 1U + (reload - current);
+        SysTick->LOAD = Tickless_SleepExpired(s_ulCountsPerTick, reload, current, APP_POWER_SYSTICK_COMP);
+        ticks = xIdle - 1U;
+    }
+    else
+    {
+        /* 被中断提前唤醒: 按已计数的完整节拍步进，剩余部分作为下一个节拍 */
+        uint32_t current = SysTick->VAL;
+        uint32_t load;
+
+        elapsed = reload - current;
+        ticks = Tickless_SleepEarly(s_ulCountsPerTick, xIdle, current, &load);
+        SysTick->LOAD = load;
+    }
+
+    AppPower_FixTimestamp(elapsed, CPU_TS_TmrRd() - cyc0);
+    s_xStats.sleep_cycles += elapsed;
+    s_xStats.sleeps++;
+
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    vTaskStepTick(ticks);
+    SysTick->LOAD = s_ulCountsPerTick - 1U;
+}
+
+/**
+ * @brief STOP: 停止SysTick，RTC唤醒定时器唤醒
+ */
+static void AppPower_Stop(TickType_t xExpectedIdleTime, TickType_t xIdle)
+{
+    BSP_Power_Time_TypeDef t0;
+    BSP_Power_Time_TypeDef t1;
+    uint32_t remain;
+    uint32_t slept;
+    uint32_t reload;
+    uint32_t ticks;
+    uint32_t cyc0;
+    uint8_t timeout;
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    if (AppPower_TickPending())
+    {
+        return;
+    }
+    remain = SysTick->VAL;
+
+    BSP_Power_ReadTime(&t0);
+    BSP_Power_WakeupStart(Tickless_WakeupCounts(&s_xCfg, xIdle - APP_POWER_STOP_WAKE_TICKS));
+    cyc0 = CPU_TS_TmrRd();
+
+    BSP_Power_EnterStop();
+
+    if (BSP_Power_RestoreClocks() != 0)
+    {
+        /* PLL未能恢复，此后运行在HSI: 节拍与时间戳按新频率重新计算 */
+        remain = (uint32_t)((uint64_t)remain * (SystemCoreClock / configTICK_RATE_HZ) / s_ulCountsPerTick);
+        AppPower_ClockUpdate();
+        CPU_TS_ClockChanged(SystemCoreClock);
+    }
+    BSP_Power_ReadTime(&t1);
+    timeout = (RTC_GetFlagStatus(RTC_FLAG_WUTF) != RESET);
+    BSP_Power_WakeupStop();
+
+    /* 经过时间以RTC为准(含HSE/PLL恢复)，亚秒量化误差前后抵消，不累积偏差 */
+    slept = Tickless_SubToCycles(s_xCfg.sub_hz,
+                                 Tickless_SubElapsed(s_xCfg.sub_hz, t0.sec, t0.ss, t1.sec, t1.ss),
+                                 SystemCoreClock);
+    ticks = Tickless_Compensate(s_ulCountsPerTick, remain, slept, &reload);
+
+    /* 步进不能越过最早的任务唤醒时刻，截断时让下一个节拍尽快到来 */
+    if (ticks > xExpectedIdleTime - 1U)
+    {
+        ticks = xExpectedIdleTime - 1U;
+        reload = s_ulCountsPerTick / 16U;
+        s_xStats.late++;
+    }
+
+    AppPower_FixTimestamp(slept, CPU_TS_TmrRd() - cyc0);
+    s_xStats.stop_cycles += slept;
+    s_xStats.stops++;
+    if (!timeout)
+    {
+        s_xStats.early++;
+    }
+
+    SysTick->LOAD = reload - 1U;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = s_ulCountsPerTick - 1U;
+    vTaskStepTick(ticks);
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppPower_Init(void)
+{
+    memset(&s_xStats, 0, sizeof(s_xStats));
+    memset(&s_xCfg, 0, sizeof(s_xCfg));
+
+    s_ulCountsPerTick = SystemCoreClock / configTICK_RATE_HZ;
+    s_ulMaxSleepTicks = 0xFFFFFFUL / s_ulCountsPerTick;
+    s_xCfg.tick_hz = configTICK_RATE_HZ;
+}
+
+void AppPower_ClockUpdate(void)
+{
+    uint32_t counts = SystemCoreClock / configTICK_RATE_HZ;
+    uint32_t ctrl = SysTick->CTRL;
+    uint32_t remain;
+
+    /* 当前节拍的剩余部分按新频率换算，下一个节拍起使用新重装值(同AppPower_Stop) */
+    remain = (uint32_t)((uint64_t)SysTick->VAL * counts / s_ulCountsPerTick);
+    if (remain < APP_POWER_SYSTICK_COMP)
+    {
+        remain = APP_POWER_SYSTICK_COMP;
+    }
+
+    s_ulCountsPerTick = counts;
+    s_ulMaxSleepTicks = 0xFFFFFFUL / counts;
+
+    if ((ctrl & SysTick_CTRL_ENABLE_Msk) != 0)
+    {
+        SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = remain - 1U;
+        SysTick->VAL = 0;
+        SysTick->CTRL = ctrl;
+    }
+    SysTick->LOAD = counts - 1U;
+}
+
+int AppPower_InitStop(void)
+{
+    int ret = -1;
+
+#if APP_POWER_STOP_ENABLE
+    ret = BSP_Power_Init(AppPower_WaitYield);
+    if (ret >= 0)
+    {
+        /* 空闲任务在关中断下读取配置，与其一次性交接 */
+        __disable_irq();
+        s_xCfg.wut_hz = BSP_Power_RtcHz() / BSP_POWER_WUT_DIV;
+        s_xCfg.sub_hz = BSP_Power_RtcHz() / (BSP_POWER_RTC_PREDIV_A + 1U);
+        s_xCfg.min_stop = APP_POWER_STOP_MIN_TICKS;
+        s_xCfg.max_stop = APP_POWER_STOP_MAX_TICKS;
+        s_ucStopReady = 1;
+        __enable_irq();
+    }
+#endif
+
+    return ret;
+}
+
+void AppPower_SuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    TickType_t xIdle;
+    Tickless_Mode_t mode;
+
+    /* 不使用taskENTER_CRITICAL: BASEPRI会屏蔽唤醒所需的中断 */
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        s_xStats.aborts++;
+        __enable_irq();
+        return;
+    }
+
+    /* 软件定时器到期同样需要节拍按时到来 */
+    xIdle = AppTimer_NextDelay(xExpectedIdleTime);
+    mode = Tickless_Select(&s_xCfg, xIdle, s_ucStopReady && s_ulStopLock == 0);
+
+    if (mode == TICKLESS_STOP)
+    {
+        AppPower_Stop(xExpectedIdleTime, xIdle);
+    }
+    else if (mode == TICKLESS_SLEEP)
+    {
+        AppPower_Sleep(xIdle);
+    }
+
+    __enable_irq();
+}
+
+void AppPower_StopLock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    s_ulStopLock++;
+    __set_PRIMASK(primask);
+}
+
+void AppPower_StopUnlock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (s_ulStopLock != 0)
+    {
+        s_ulStopLock--;
+    }
+    __set_PRIMASK(primask);
+}
+
+void AppPower_GetStats(AppPower_Stats_TypeDef *out)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *out = s_xStats;
+    __set_PRIMASK(primask);
+}
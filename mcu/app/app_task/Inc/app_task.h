@@ -0,0 +1,235 @@
+/**
+ * @file app_task.h
+ * @brief 任务注册表与内核对象分配头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 所有应用任务由一张注册表描述(名称、入口、优先级、栈预算、周期、CPU预算、句柄)，
+ *       在启动调度器之前一次性创建:
+ *       - configSUPPORT_STATIC_ALLOCATION == 1: 栈与TCB为静态数组(默认放在CCMRAM，见mem_section.h)，
+ *         用xTaskCreateStatic创建，RAM不足在链接时报错，运行期不使用堆
+ *       - 否则退回xTaskCreate(heap_4)
+ *       互斥量/队列同样通过本模块创建，调用方提供静态存储，两种模式下代码相同
+ *
+ *       RTOS堆(CMake: -DFREERTOS_HEAP_5=ON 时 APP_HEAP_SCHEME == 5):
+ *       - 4: heap_4，单块ucHeap(configTOTAL_HEAP_SIZE，主SRAM)
+ *       - 5: heap_5，链接后剩余的CCMRAM(_sccmheap.._eccmheap) + 主SRAM中的APP_HEAP_SRAM_SIZE，
+ *         CCMRAM地址较低排在前面，分配优先落在CCMRAM；堆上的内存因此不能用于DMA
+ *       newlib的malloc也使用同一个堆(见newlib_heap.c)，printf第一次输出即会分配流缓冲，
+ *       因此AppTask_HeapInit是main的第一步，早于任何printf与内核对象
+ *
+ *       预算核对(需要Task_Prof): Task_Prof每个窗口把各任务的CPU千分比与栈余量
+ *       交给AppTask_Sample，再调用AppTask_Audit:
+ *       - 普通构建: 栈使用超过预算的APP_TASK_WARN_PCT或CPU超过预算时输出一次W行
+ *       - 测量构建(APP_TASK_MEASURE=1): 栈按预算的APP_TASK_MEASURE_SCALE倍分配，
+ *         避免预算偏小时溢出；运行APP_TASK_MEASURE_MS后输出实测高水位与
+ *         加上余量的建议栈大小(可直接粘贴的#define)，之后高水位再增长时重新输出
+ *       串口行格式:
+ *         W,<name>,<stack|cpu>,<used>,<budget>
+ *         S,<name>,<prio>,<period_ms>,<budget_words>,<used_words>,<suggest_words>,<cpu_peak>,<cpu_budget>
+ */
+
+#ifndef __APP_TASK_H
+#define __APP_TASK_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "mem_section.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+
+/* 静态任务栈/TCB放置的段(CCMRAM，栈上的局部变量不能交给DMA) */
+#ifndef APP_TASK_STACK_SECTION
+#define APP_TASK_STACK_SECTION MEM_PLACE_STACK
+#endif
+#ifndef APP_TASK_TCB_SECTION
+#define APP_TASK_TCB_SECTION MEM_PLACE_TCB
+#endif
+
+/* RTOS堆方案: 4=heap_4, 5=heap_5(SRAM + CCMRAM) */
+#ifndef APP_HEAP_SCHEME
+#define APP_HEAP_SCHEME 4
+#endif
+
+/* heap_5的主SRAM区域大小(字节) */
+#ifndef APP_HEAP_SRAM_SIZE
+#define APP_HEAP_SRAM_SIZE configTOTAL_HEAP_SIZE
+#endif
+
+/* 栈测量构建(CMake: -DAPP_TASK_MEASURE=ON) */
+#ifndef APP_TASK_MEASURE
+#define APP_TASK_MEASURE 0
+#endif
+
+/* 轮询基准构建(CMake: -DAPP_POLLING_BASELINE=ON): 显示/温湿度/光照任务恢复数据总线驱动之前的
+ * 固定周期循环(显示每秒重绘、LED指示用vTaskDelay保持)，只用于对比唤醒次数与延迟 */
+#ifndef APP_POLLING_BASELINE
+#define APP_POLLING_BASELINE 0
+#endif
+
+#define APP_TASK_MAX 8                /**< 注册表最大任务数 */
+#define APP_TASK_MEASURE_SCALE 2      /**< 测量构建的栈分配倍数 */
+#define APP_TASK_MEASURE_MS 60000     /**< 测量构建输出建议表前的运行时间(毫秒) */
+#define APP_TASK_MARGIN_PCT 25        /**< 建议栈大小: 实测高水位之上的比例余量 */
+#define APP_TASK_MARGIN_WORDS 32      /**< 建议栈大小: 固定余量(字) */
+#define APP_TASK_ALIGN_WORDS 8        /**< 建议栈大小按此对齐(字) */
+#define APP_TASK_WARN_PCT 90          /**< 普通构建: 栈使用超过预算的该比例时告警 */
+
+#if (APP_TASK_MEASURE == 1) && (configGENERATE_RUN_TIME_STATS != 1)
+#error "APP_TASK_MEASURE requires Task_Prof (configGENERATE_RUN_TIME_STATS == 1)"
+#endif
+
+/* 实际分配的栈大小(字) */
+#if (APP_TASK_MEASURE == 1)
+#define APP_TASK_ALLOC_WORDS(words) ((words) * APP_TASK_MEASURE_SCALE)
+#else
+#define APP_TASK_ALLOC_WORDS(words) (words)
+#endif
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 任务注册表项
+ */
+typedef struct
+{
+    const char *name;      /**< 任务名称 */
+    const char *tag;       /**< 表项标识(建议表中生成TASK_<TAG>_STACK_SIZE) */
+    TaskFunction_t entry;  /**< 任务入口 */
+    UBaseType_t priority;  /**< 优先级 */
+    uint16_t stack_words;  /**< 栈预算(字) */
+    uint16_t period_ms;    /**< 运行周期(毫秒，0=事件驱动) */
+    uint16_t cpu_budget;   /**< CPU预算(千分比) */
+    TaskHandle_t *handle;  /**< 输出句柄(可为NULL) */
+    StackType_t *stack;    /**< 静态栈(动态分配时为NULL) */
+    StaticTask_t *tcb;     /**< 静态TCB(动态分配时为NULL) */
+} AppTask_Def_TypeDef;
+
+/**
+ * ============================================================================
+ * 注册表宏
+ * ============================================================================
+ */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/**
+ * @brief 定义任务的静态栈与TCB(文件作用域使用)
+ */
+#define APP_TASK_STORAGE(tag, words)                                                          \
+    static APP_TASK_STACK_SECTION StackType_t s_x##tag##Stack[APP_TASK_ALLOC_WORDS(words)]; \
+    static APP_TASK_TCB_SECTION StaticTask_t s_x##tag##Tcb
+
+/**
+ * @brief 生成注册表项(与APP_TASK_STORAGE使用相同的tag)
+ *
+ * @param period 运行周期(毫秒，0=事件驱动)
+ * @param cpu CPU预算(千分比)
+ */
+#define APP_TASK_DEF(tag, name, entry, prio, words, period, cpu, handle)           \
+    {(name), #tag, (entry), (prio), (words), (period), (cpu), (handle), s_x##tag##Stack, \
+     &s_x##tag##Tcb}
+#else
+#define APP_TASK_STORAGE(tag, words) \
+    extern const uint8_t s_uc##tag##NoStorage
+#define APP_TASK_DEF(tag, name, entry, prio, words, period, cpu, handle) \
+    {(name), #tag, (entry), (prio), (words), (period), (cpu), (handle), NULL, NULL}
+#endif
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化RTOS堆
+ * @author Yukikaze
+ *
+ * @note heap_5时定义堆区域(CCMRAM剩余部分 + 主SRAM)，heap_4时为空操作
+ *       必须在任何pvPortMalloc(内核对象、malloc、printf的流缓冲)之前调用，且不能输出(串口尚未初始化)
+ */
+void AppTask_HeapInit(void);
+
+/**
+ * @brief RTOS堆总量(字节)
+ * @author Yukikaze
+ *
+ * @return size_t heap_4为configTOTAL_HEAP_SIZE，heap_5为各区域初始化后的可用总量
+ */
+size_t AppTask_HeapTotal(void);
+
+/**
+ * @brief 按注册表创建任务
+ * @author Yukikaze
+ *
+ * @param defs 注册表
+ * @param count 表项数
+ * @return BaseType_t pdPASS=全部成功, pdFAIL=有任务创建失败(已创建的保留)
+ *
+ * @note 在启动调度器之前调用；创建结束后打印任务数、静态栈总量与堆使用量
+ *       注册表须为静态存储，预算核对时仍会访问
+ */
+BaseType_t AppTask_CreateAll(const AppTask_Def_TypeDef *defs, uint32_t count);
+
+/**
+ * @brief 由实测栈使用量计算建议栈大小
+ * @author Yukikaze
+ *
+ * @param used_words 实测使用量(字)
+ * @return uint32_t used + APP_TASK_MARGIN_PCT% + APP_TASK_MARGIN_WORDS，
+ *         按APP_TASK_ALIGN_WORDS向上对齐，不小于configMINIMAL_STACK_SIZE
+ */
+uint32_t AppTask_SuggestWords(uint32_t used_words);
+
+/**
+ * @brief 记录一个任务本窗口的CPU占用与栈余量
+ * @author Yukikaze
+ *
+ * @param task 任务句柄(不在注册表中的任务忽略)
+ * @param cpu_permille 本窗口CPU占用(千分比)
+ * @param stack_free_words 栈高水位余量(字)
+ */
+void AppTask_Sample(TaskHandle_t task, uint32_t cpu_permille, uint32_t stack_free_words);
+
+/**
+ * @brief 核对预算并按需输出W行/建议表
+ * @author Yukikaze
+ *
+ * @note 在Task_Prof中每个窗口采样完成后调用
+ */
+void AppTask_Audit(void);
+
+/**
+ * @brief 创建互斥量
+ * @author Yukikaze
+ *
+ * @param buf 静态存储(动态分配模式下不使用)
+ * @return SemaphoreHandle_t 句柄，失败返回NULL
+ */
+SemaphoreHandle_t AppTask_CreateMutex(StaticSemaphore_t *buf);
+
+/**
+ * @brief 创建队列
+ * @author Yukikaze
+ *
+ * @param length 队列长度
+ * @param item_size 元素大小(字节)
+ * @param storage 元素存储区(length * item_size字节，动态分配模式下不使用)
+ * @param buf 静态队列控制块(动态分配模式下不使用)
+ * @return QueueHandle_t 句柄，失败返回NULL
+ */
+QueueHandle_t AppTask_CreateQueue(UBaseType_t length, UBaseType_t item_size,
+                                  uint8_t *storage, StaticQueue_t *buf);
+
+#endif /* __APP_TASK_H */
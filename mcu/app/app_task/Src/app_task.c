@@ -0,0 +1,326 @@
+/**
+ * @file app_task.c
+ * @brief 任务注册表与内核对象分配实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "app_task.h"
+#include <ctype.h>
+#include <stdio.h>
+
+/**
+ * ============================================================================
+ * 私有类型与变量
+ * ============================================================================
+ */
+
+#define APP_TASK_WARN_STACK 0x01U /**< 已输出栈告警 */
+#define APP_TASK_WARN_CPU 0x02U   /**< 已输出CPU告警 */
+
+/**
+ * @brief 单个任务的实测值
+ */
+typedef struct
+{
+    uint16_t used;     /**< 栈使用峰值(字) */
+    uint16_t cpu_peak; /**< 窗口CPU占用峰值(千分比) */
+    uint8_t warned;    /**< 已输出的告警(APP_TASK_WARN_x) */
+} AppTask_Stat_TypeDef;
+
+/* 注册表(CreateAll时记录) */
+static const AppTask_Def_TypeDef *s_pxDefs = NULL;
+static uint32_t s_ulCount = 0;
+static TaskHandle_t s_xHandles[APP_TASK_MAX];
+static AppTask_Stat_TypeDef s_xStats[APP_TASK_MAX];
+
+#if (APP_TASK_MEASURE == 1)
+/* 高水位有增长、需要重新输出建议表 */
+static uint8_t s_ucTableDirty = 1;
+#endif
+
+/* RTOS堆总容量(字节) */
+static size_t s_xHeapTotal = configTOTAL_HEAP_SIZE;
+
+#if (APP_HEAP_SCHEME == 5)
+/* 链接脚本给出的CCMRAM剩余区间 */
+extern uint8_t _sccmheap[];
+extern uint8_t _eccmheap[];
+
+/* heap_5的主SRAM区域 */
+static uint8_t s_ucHeapSram[APP_HEAP_SRAM_SIZE];
+
+/* 实际登记的CCMRAM区域大小(0=未使用) */
+static size_t s_xHeapCcm;
+#endif
+
+/**
+ * ============================================================================
+ * 空闲任务内存
+ * ============================================================================
+ */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static APP_TASK_STACK_SECTION StackType_t s_xIdleStack[configMINIMAL_STACK_SIZE];
+static APP_TASK_TCB_SECTION StaticTask_t s_xIdleTcb;
+
+/**
+ * @brief 提供空闲任务的栈与TCB(静态分配时内核要求实现)
+ * @author Yukikaze
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &s_xIdleTcb;
+    *ppxIdleTaskStackBuffer = s_xIdleStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppTask_HeapInit(void)
+{
+#if (APP_HEAP_SCHEME == 5)
+    /* 按地址升序: CCMRAM(0x10000000)在主SRAM(0x20000000)之前 */
+    HeapRegion_t regions[3];
+    uint32_t n = 0;
+    size_t ccm = (size_t)(_eccmheap - _sccmheap);
+
+    /* CCMRAM剩余太少时不值得作为一个区域(每个区域有块头与尾标记开销) */
+    if (ccm >= 256U)
+    {
+        regions[n].pucStartAddress = _sccmheap;
+        regions[n].xSizeInBytes = ccm;
+        s_xHeapCcm = ccm;
+        n++;
+    }
+    regions[n].pucStartAddress = s_ucHeapSram;
+    regions[n].xSizeInBytes = sizeof(s_ucHeapSram);
+    n++;
+    regions[n].pucStartAddress = NULL;
+    regions[n].xSizeInBytes = 0;
+
+    vPortDefineHeapRegions(regions);
+    s_xHeapTotal = xPortGetFreeHeapSize();
+#endif
+}
+
+size_t AppTask_HeapTotal(void)
+{
+    return s_xHeapTotal;
+}
+
+MEM_COLD BaseType_t AppTask_CreateAll(const AppTask_Def_TypeDef *defs, uint32_t count)
+{
+    BaseType_t xReturn = pdPASS;
+    uint32_t stack_bytes = 0;
+    size_t heap_free;
+
+    configASSERT(count <= APP_TASK_MAX);
+    s_pxDefs = defs;
+    s_ulCount = (count <= APP_TASK_MAX) ? count : APP_TASK_MAX;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const AppTask_Def_TypeDef *d = &defs[i];
+        uint16_t words = (uint16_t)APP_TASK_ALLOC_WORDS(d->stack_words);
+        TaskHandle_t handle = NULL;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+        if (d->stack != NULL && d->tcb != NULL)
+        {
+            handle = xTaskCreateStatic(d->entry, d->name, words, NULL,
+                                       d->priority, d->stack, d->tcb);
+        }
+#else
+        if (xTaskCreate(d->entry, d->name, words, NULL,
+                        d->priority, &handle) != pdPASS)
+        {
+            handle = NULL;
+        }
+#endif
+
+        if (i < APP_TASK_MAX)
+        {
+            s_xHandles[i] = handle;
+        }
+        if (d->handle != NULL)
+        {
+            *d->handle = handle;
+        }
+        if (handle == NULL)
+        {
+            printf("Task %s create failed\r\n", d->name);
+            xReturn = pdFAIL;
+            continue;
+        }
+        stack_bytes += (uint32_t)words * sizeof(StackType_t);
+    }
+
+#if (APP_HEAP_SCHEME == 5)
+    printf("Heap: heap_5, CCM %lu B + SRAM %lu B\r\n",
+           (unsigned long)s_xHeapCcm, (unsigned long)sizeof(s_ucHeapSram));
+#endif
+
+    /* heap_4在第一次分配前尚未初始化，剩余量读作0，此时视为未使用 */
+    heap_free = xPortGetFreeHeapSize();
+    printf("Tasks: %lu, stack %lu B (%s%s), heap used %lu/%lu B\r\n",
+           (unsigned long)count,
+           (unsigned long)stack_bytes,
+           (configSUPPORT_STATIC_ALLOCATION == 1) ? "static" : "heap",
+           (APP_TASK_MEASURE == 1) ? ", measure" : "",
+           (unsigned long)((heap_free != 0) ? s_xHeapTotal - heap_free : 0),
+           (unsigned long)s_xHeapTotal);
+
+    return xReturn;
+}
+
+uint32_t AppTask_SuggestWords(uint32_t used_words)
+{
+    uint32_t words;
+
+    words = used_words + (used_words * APP_TASK_MARGIN_PCT + 99U) / 100U + APP_TASK_MARGIN_WORDS;
+    words = (words + APP_TASK_ALIGN_WORDS - 1U) / APP_TASK_ALIGN_WORDS * APP_TASK_ALIGN_WORDS;
+    if (words < configMINIMAL_STACK_SIZE)
+    {
+        words = configMINIMAL_STACK_SIZE;
+    }
+    return words;
+}
+
+void AppTask_Sample(TaskHandle_t task, uint32_t cpu_permille, uint32_t stack_free_words)
+{
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        AppTask_Stat_TypeDef *st = &s_xStats[i];
+        uint32_t alloc;
+        uint32_t used;
+
+        if (s_xHandles[i] != task || task == NULL)
+        {
+            continue;
+        }
+
+        alloc = APP_TASK_ALLOC_WORDS(s_pxDefs[i].stack_words);
+        used = (stack_free_words < alloc) ? alloc - stack_free_words : 0;
+        if (used > st->used)
+        {
+            st->used = (uint16_t)used;
+#if (APP_TASK_MEASURE == 1)
+            s_ucTableDirty = 1;
+#endif
+        }
+        if (cpu_permille > st->cpu_peak)
+        {
+            st->cpu_peak = (uint16_t)cpu_permille;
+        }
+        return;
+    }
+}
+
+#if (APP_TASK_MEASURE == 1)
+/**
+ * @brief 输出实测值与建议栈大小表
+ */
+static void AppTask_PrintTable(void)
+{
+    char macro[16];
+
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        const AppTask_Def_TypeDef *d = &s_pxDefs[i];
+
+        printf("S,%s,%u,%u,%u,%u,%lu,%u,%u\r\n",
+               d->name,
+               (unsigned int)d->priority,
+               (unsigned int)d->period_ms,
+               (unsigned int)d->stack_words,
+               (unsigned int)s_xStats[i].used,
+               (unsigned long)AppTask_SuggestWords(s_xStats[i].used),
+               (unsigned int)s_xStats[i].cpu_peak,
+               (unsigned int)d->cpu_budget);
+    }
+
+    printf("/* suggested stack sizes: high-water + %u%% + %u words */\r\n",
+           (unsigned int)APP_TASK_MARGIN_PCT, (unsigned int)APP_TASK_MARGIN_WORDS);
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        const AppTask_Def_TypeDef *d = &s_pxDefs[i];
+        uint32_t n = 0;
+
+        while (d->tag[n] != '\0' && n < sizeof(macro) - 1U)
+        {
+            macro[n] = (char)toupper((unsigned char)d->tag[n]);
+            n++;
+        }
+        macro[n] = '\0';
+
+        printf("#define TASK_%s_STACK_SIZE %lu /* used %u, was %u */\r\n",
+               macro,
+               (unsigned long)AppTask_SuggestWords(s_xStats[i].used),
+               (unsigned int)s_xStats[i].used,
+               (unsigned int)d->stack_words);
+    }
+}
+#endif
+
+void AppTask_Audit(void)
+{
+    for (uint32_t i = 0; i < s_ulCount; i++)
+    {
+        const AppTask_Def_TypeDef *d = &s_pxDefs[i];
+        AppTask_Stat_TypeDef *st = &s_xStats[i];
+
+        /* 告警只输出一次，避免每个窗口刷屏 */
+        if ((st->warned & APP_TASK_WARN_STACK) == 0U &&
+            (uint32_t)st->used * 100U > (uint32_t)d->stack_words * APP_TASK_WARN_PCT)
+        {
+            st->warned |= APP_TASK_WARN_STACK;
+            printf("W,%s,stack,%u,%u\r\n", d->name,
+                   (unsigned int)st->used, (unsigned int)d->stack_words);
+        }
+        if ((st->warned & APP_TASK_WARN_CPU) == 0U &&
+            d->cpu_budget != 0U && st->cpu_peak > d->cpu_budget)
+        {
+            st->warned |= APP_TASK_WARN_CPU;
+            printf("W,%s,cpu,%u,%u\r\n", d->name,
+                   (unsigned int)st->cpu_peak, (unsigned int)d->cpu_budget);
+        }
+    }
+
+#if (APP_TASK_MEASURE == 1)
+    if (s_ucTableDirty && xTaskGetTickCount() >= pdMS_TO_TICKS(APP_TASK_MEASURE_MS))
+    {
+        s_ucTableDirty = 0;
+        AppTask_PrintTable();
+    }
+#endif
+}
+
+SemaphoreHandle_t AppTask_CreateMutex(StaticSemaphore_t *buf)
+{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    return xSemaphoreCreateMutexStatic(buf);
+#else
+    (void)buf;
+    return xSemaphoreCreateMutex();
+#endif
+}
+
+QueueHandle_t AppTask_CreateQueue(UBaseType_t length, UBaseType_t item_size,
+                                  uint8_t *storage, StaticQueue_t *buf)
+{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    return xQueueCreateStatic(length, item_size, storage, buf);
+#else
+    (void)storage;
+    (void)buf;
+    return xQueueCreate(length, item_size);
+#endif
+}
@@ -0,0 +1,157 @@
+/**
+ * @file app_timer.h
+ * @brief 软件定时器服务头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 基于分层时间轮(twheel)的轻量定时器，由节拍钩子驱动，不占用额外任务栈:
+ *       - LED脉冲/闪烁: 任务点亮后立即继续工作，由定时器负责熄灭
+ *       - 周期触发: 到期时向任务发送通知，替代任务内的阻塞延时
+ *       - 单次超时: 通用定时器 period=0
+ *
+ *       到期回调在SysTick中断中执行(BASEPRI已屏蔽可管理中断)，
+ *       回调必须短小，只能调用 FromISR 结尾的API
+ */
+
+#ifndef __APP_TIMER_H
+#define __APP_TIMER_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "twheel.h"
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 类型定义
+ * ============================================================================
+ */
+
+/**
+ * @brief 定时器(存储由调用者提供)
+ */
+typedef TWheel_Timer_TypeDef AppTimer_TypeDef;
+
+/**
+ * @brief 到期回调(中断上下文)
+ */
+typedef TWheel_Callback_t AppTimer_Callback_t;
+
+/**
+ * @brief 板载LED编号
+ */
+typedef enum
+{
+    APP_TIMER_LED1 = 0, /**< LED1(红色) */
+    APP_TIMER_LED2,     /**< LED2(绿色) */
+    APP_TIMER_LED3,     /**< LED3(蓝色) */
+    APP_TIMER_LED_NUM,
+} AppTimer_Led_t;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化定时器服务
+ * @author Yukikaze
+ *
+ * @note 需要在启动调度器或创建使用定时器的任务之前调用
+ */
+void AppTimer_Init(void);
+
+/**
+ * @brief 推进一个节拍(由vApplicationTickHook调用)
+ * @author Yukikaze
+ */
+void AppTimer_TickFromISR(void);
+
+/**
+ * @brief 无节拍空闲后补齐时间轮(由traceINCREASE_TICK_COUNT调用)
+ * @author Yukikaze
+ *
+ * @param ticks vTaskStepTick跳过的节拍数
+ *
+ * @note 在关中断或临界区中执行，休眠期间到期的回调在此集中执行
+ */
+void AppTimer_Advance(TickType_t ticks);
+
+/**
+ * @brief 距离下一个定时器到期的节拍数
+ * @author Yukikaze
+ *
+ * @param limit 上限(通常为内核给出的预计空闲节拍数)
+ * @return TickType_t 1~limit
+ *
+ * @note 供无节拍空闲使用，调用者需已关中断
+ */
+TickType_t AppTimer_NextDelay(TickType_t limit);
+
+/**
+ * @brief 初始化定时器
+ * @author Yukikaze
+ *
+ * @param t 定时器
+ * @param cb 到期回调(中断上下文)
+ * @param ctx 回调参数
+ */
+void AppTimer_Create(AppTimer_TypeDef *t, AppTimer_Callback_t cb, void *ctx);
+
+/**
+ * @brief 启动定时器(任务或中断中均可调用，已启动时重新计时)
+ * @author Yukikaze
+ *
+ * @param t 定时器
+ * @param delay_ms 首次到期延时(毫秒)
+ * @param period_ms 周期(毫秒，0=单次)
+ */
+void AppTimer_Start(AppTimer_TypeDef *t, uint32_t delay_ms, uint32_t period_ms);
+
+/**
+ * @brief 停止定时器(任务或中断中均可调用)
+ * @author Yukikaze
+ */
+void AppTimer_Stop(AppTimer_TypeDef *t);
+
+/**
+ * @brief 启动周期通知定时器
+ * @author Yukikaze
+ *
+ * @param t 定时器
+ * @param task 被通知的任务
+ * @param period_ms 周期(毫秒)，首次在一个周期后到期
+ *
+ * @note 每次到期调用 vTaskNotifyGiveFromISR，任务用 ulTaskNotifyTake 等待，
+ *       周期与任务本身的执行时间无关(等效于vTaskDelayUntil)
+ */
+void AppTimer_StartNotify(AppTimer_TypeDef *t, TaskHandle_t task, uint32_t period_ms);
+
+/**
+ * @brief 点亮LED并在指定时间后自动熄灭
+ * @author Yukikaze
+ *
+ * @param led LED编号
+ * @param on_ms 点亮时长(毫秒)
+ */
+void AppTimer_LedPulse(AppTimer_Led_t led, uint32_t on_ms);
+
+/**
+ * @brief 按亮/灭时长闪烁LED
+ * @author Yukikaze
+ *
+ * @param led LED编号
+ * @param on_ms 点亮时长(毫秒)
+ * @param off_ms 熄灭时长(毫秒)
+ * @param count 闪烁次数(0=一直闪烁，直到AppTimer_LedStop)
+ */
+void AppTimer_LedBlink(AppTimer_Led_t led, uint32_t on_ms, uint32_t off_ms, uint16_t count);
+
+/**
+ * @brief 停止LED闪烁并熄灭
+ * @author Yukikaze
+ */
+void AppTimer_LedStop(AppTimer_Led_t led);
+
+#endif /* __APP_TIMER_H */
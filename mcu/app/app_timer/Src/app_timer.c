@@ -0,0 +1,280 @@
+/**
+ * @file app_timer.c
+ * @brief 软件定时器服务实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 时间轮在SysTick中断中推进，xPortSysTickHandler调用节拍钩子时已抬高BASEPRI，
+ *       因此任务侧用taskENTER_CRITICAL、中断侧用taskENTER_CRITICAL_FROM_ISR即可互斥
+ */
+
+#include "app_timer.h"
+#include "bsp_led.h"
+#include "mem_section.h"
+
+/**
+ * ============================================================================
+ * 私有类型
+ * ============================================================================
+ */
+
+/**
+ * @brief LED闪烁状态
+ */
+typedef struct
+{
+    AppTimer_TypeDef timer; /**< 亮/灭切换定时器 */
+    uint32_t on_ticks;      /**< 点亮节拍数 */
+    uint32_t off_ticks;     /**< 熄灭节拍数 */
+    uint16_t remain;        /**< 剩余闪烁次数(0=无限) */
+    uint8_t lit;            /**< 当前是否点亮 */
+} AppTimer_LedState_TypeDef;
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 时间轮(4层×64槽链表头约2KB，放在CCMRAM，由AppTimer_Init初始化) */
+static MEM_CCMBSS TWheel_TypeDef s_xWheel;
+
+static AppTimer_LedState_TypeDef s_xLed[APP_TIMER_LED_NUM];
+
+/* 本节拍内回调是否唤醒了更高优先级任务 */
+static BaseType_t s_xWoken = pdFALSE;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static inline uint32_t AppTimer_MsToTicks(uint32_t ms)
+{
+    uint32_t ticks = (uint32_t)pdMS_TO_TICKS(ms);
+
+    return (ticks != 0) ? ticks : 1U;
+}
+
+/**
+ * @brief 驱动LED引脚(低电平点亮)
+ */
+static void AppTimer_LedWrite(AppTimer_Led_t led, uint8_t on)
+{
+    switch (led)
+    {
+    case APP_TIMER_LED1:
+        if (on)
+        {
+            LED1_ON;
+        }
+        else
+        {
+            LED1_OFF;
+        }
+        break;
+    case APP_TIMER_LED2:
+        if (on)
+        {
+            LED2_ON;
+        }
+        else
+        {
+            LED2_OFF;
+        }
+        break;
+    case APP_TIMER_LED3:
+        if (on)
+        {
+            LED3_ON;
+        }
+        else
+        {
+            LED3_OFF;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 进入临界区(自动区分任务/中断上下文)
+ */
+static inline UBaseType_t AppTimer_Lock(void)
+{
+    if (xPortIsInsideInterrupt())
+    {
+        return taskENTER_CRITICAL_FROM_ISR();
+    }
+    taskENTER_CRITICAL();
+    return 0;
+}
+
+static inline void AppTimer_Unlock(UBaseType_t state)
+{
+    if (xPortIsInsideInterrupt())
+    {
+        taskEXIT_CRITICAL_FROM_ISR(state);
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+
+/**
+ * @brief 周期通知回调
+ */
+static void AppTimer_OnNotify(TWheel_Timer_TypeDef *timer, void *ctx)
+{
+    (void)timer;
+
+    vTaskNotifyGiveFromISR((TaskHandle_t)ctx, &s_xWoken);
+}
+
+/**
+ * @brief LED亮/灭切换回调
+ */
+static void AppTimer_OnLed(TWheel_Timer_TypeDef *timer, void *ctx)
+{
+    AppTimer_Led_t led = (AppTimer_Led_t)(uintptr_t)ctx;
+    AppTimer_LedState_TypeDef *s;
+
+    if (led >= APP_TIMER_LED_NUM)
+    {
+        return;
+    }
+    s = &s_xLed[led];
+
+    if (s->lit)
+    {
+        AppTimer_LedWrite(led, 0);
+        s->lit = 0;
+
+        /* 最后一次闪烁结束 */
+        if (s->remain != 0 && --s->remain == 0)
+        {
+            return;
+        }
+        if (s->off_ticks != 0)
+        {
+            TWheel_Start(&s_xWheel, timer, s->off_ticks, 0);
+            return;
+        }
+    }
+
+    AppTimer_LedWrite(led, 1);
+    s->lit = 1;
+    TWheel_Start(&s_xWheel, timer, s->on_ticks, 0);
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppTimer_Init(void)
+{
+    TWheel_Init(&s_xWheel, (uint32_t)xTaskGetTickCount());
+
+    for (uint8_t i = 0; i < APP_TIMER_LED_NUM; i++)
+    {
+        TWheel_TimerInit(&s_xLed[i].timer, AppTimer_OnLed, (void *)(uintptr_t)i);
+        s_xLed[i].lit = 0;
+    }
+}
+
+void AppTimer_TickFromISR(void)
+{
+    s_xWoken = pdFALSE;
+    TWheel_Tick(&s_xWheel);
+    portYIELD_FROM_ISR(s_xWoken);
+}
+
+void AppTimer_Advance(TickType_t ticks)
+{
+    s_xWoken = pdFALSE;
+    while (ticks-- != 0)
+    {
+        TWheel_Tick(&s_xWheel);
+    }
+    portYIELD_FROM_ISR(s_xWoken);
+}
+
+TickType_t AppTimer_NextDelay(TickType_t limit)
+{
+    return (TickType_t)TWheel_NextDelay(&s_xWheel, (uint32_t)limit);
+}
+
+void AppTimer_Create(AppTimer_TypeDef *t, AppTimer_Callback_t cb, void *ctx)
+{
+    TWheel_TimerInit(t, cb, ctx);
+}
+
+void AppTimer_Start(AppTimer_TypeDef *t, uint32_t delay_ms, uint32_t period_ms)
+{
+    uint32_t period = (period_ms != 0) ? AppTimer_MsToTicks(period_ms) : 0;
+    UBaseType_t state = AppTimer_Lock();
+
+    TWheel_Start(&s_xWheel, t, AppTimer_MsToTicks(delay_ms), period);
+    AppTimer_Unlock(state);
+}
+
+void AppTimer_Stop(AppTimer_TypeDef *t)
+{
+    UBaseType_t state = AppTimer_Lock();
+
+    TWheel_Stop(&s_xWheel, t);
+    AppTimer_Unlock(state);
+}
+
+void AppTimer_StartNotify(AppTimer_TypeDef *t, TaskHandle_t task, uint32_t period_ms)
+{
+    TWheel_TimerInit(t, AppTimer_OnNotify, (void *)task);
+    AppTimer_Start(t, period_ms, period_ms);
+}
+
+void AppTimer_LedPulse(AppTimer_Led_t led, uint32_t on_ms)
+{
+    AppTimer_LedBlink(led, on_ms, 0, 1);
+}
+
+void AppTimer_LedBlink(AppTimer_Led_t led, uint32_t on_ms, uint32_t off_ms, uint16_t count)
+{
+    AppTimer_LedState_TypeDef *s;
+    UBaseType_t state;
+
+    if (led >= APP_TIMER_LED_NUM)
+    {
+        return;
+    }
+    s = &s_xLed[led];
+
+    state = AppTimer_Lock();
+    s->on_ticks = AppTimer_MsToTicks(on_ms);
+    s->off_ticks = (off_ms != 0) ? AppTimer_MsToTicks(off_ms) : 0;
+    s->remain = count;
+    s->lit = 1;
+    AppTimer_LedWrite(led, 1);
+    TWheel_Start(&s_xWheel, &s->timer, s->on_ticks, 0);
+    AppTimer_Unlock(state);
+}
+
+void AppTimer_LedStop(AppTimer_Led_t led)
+{
+    UBaseType_t state;
+
+    if (led >= APP_TIMER_LED_NUM)
+    {
+        return;
+    }
+
+    state = AppTimer_Lock();
+    TWheel_Stop(&s_xWheel, &s_xLed[led].timer);
+    s_xLed[led].lit = 0;
+    AppTimer_LedWrite(led, 0);
+    AppTimer_Unlock(state);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file app_trace.h
+ * @brief 调度跟踪记录器头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 通过FreeRTOS跟踪宏(见FreeRTOSConfig.h)记录任务切换、队列/信号量收发、
+ *       任务通知以及中断进出，每个事件8字节，带DWT时间戳，写入CCMRAM的.noinit环形缓冲:
+ *       - 默认覆盖模式，始终保留最近 APP_TRACE_EVENTS 个事件
+ *       - 断言、栈溢出、内存不足和各类Fault时冻结缓冲，热复位后AppTrace_Init
+ *         发现冻结的缓冲会先经串口输出，再重新开始记录
+ *       - 运行中也可调用AppTrace_Dump输出当前缓冲
+ *       串口输出格式(均以"TRACE,"开头):
+ *         TRACE,BEGIN,<events>,<lost>,<dropped>,<cpu_hz>,<reason>
+ *         TRACE,N,<task_num>,<name>
+ *         TRACE,E,<16位十六进制，事件的8个字节(小端)>
+ *         TRACE,END
+ *       主机端转换为Chrome tracing / Perfetto 时间线: tools/trace2json.py
+ */
+
+#ifndef __APP_TRACE_H
+#define __APP_TRACE_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define APP_TRACE_EVENTS 1024   /**< 事件容量(2的幂，每个8字节) */
+#define APP_TRACE_MAX_TASKS 16  /**< 记录名称的最大任务编号 */
+#define APP_TRACE_NAME_LEN 16   /**< 任务名长度(与configMAX_TASK_NAME_LEN一致) */
+#define APP_TRACE_SYSTICK 0     /**< 是否记录SysTick中断进出(每毫秒2个事件，默认关闭) */
+
+/**
+ * ============================================================================
+ * 事件类型(与tools/trace2json.py保持一致)
+ * ============================================================================
+ */
+typedef enum
+{
+    APP_TRACE_SYNC = 0,         /**< 时间戳高32位变化，ts字段为新的高32位 */
+    APP_TRACE_TASK_CREATE,      /**< id=任务编号, arg=优先级 */
+    APP_TRACE_TASK_IN,          /**< id=切入的任务编号 */
+    APP_TRACE_ISR_ENTER,        /**< id=异常号(IPSR) */
+    APP_TRACE_ISR_EXIT,         /**< id=异常号(IPSR) */
+    APP_TRACE_QUEUE_SEND,       /**< id=队列编号, arg=发送前的消息数 */
+    APP_TRACE_QUEUE_SEND_ISR,   /**< 同上(中断中) */
+    APP_TRACE_QUEUE_RECV,       /**< id=队列编号, arg=接收前的消息数 */
+    APP_TRACE_QUEUE_RECV_ISR,   /**< 同上(中断中) */
+    APP_TRACE_QUEUE_BLOCK_SEND, /**< 队列满，当前任务阻塞 */
+    APP_TRACE_QUEUE_BLOCK_RECV, /**< 队列空，当前任务阻塞 */
+    APP_TRACE_NOTIFY,           /**< id=被通知的任务编号 */
+    APP_TRACE_NOTIFY_ISR,       /**< id=被通知的任务编号(中断中) */
+    APP_TRACE_NOTIFY_TAKE,      /**< id=当前任务编号，取得通知 */
+    APP_TRACE_MARK,             /**< 用户标记: id/arg由调用者定义 */
+    APP_TRACE_FREEZE,           /**< 冻结，arg=原因 */
+} AppTrace_Type_t;
+
+/**
+ * @brief 冻结原因
+ */
+typedef enum
+{
+    APP_TRACE_REASON_NONE = 0,
+    APP_TRACE_REASON_ASSERT,
+    APP_TRACE_REASON_STACK,
+    APP_TRACE_REASON_MALLOC,
+    APP_TRACE_REASON_FAULT,
+    APP_TRACE_REASON_USER,
+} AppTrace_Reason_t;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化跟踪记录器
+ * @author Yukikaze
+ *
+ * @note 在串口初始化之后、创建任务之前调用
+ *       若上次运行冻结了缓冲(崩溃)，先输出该缓冲再重新初始化
+ */
+void AppTrace_Init(void);
+
+/**
+ * @brief 记录一个事件(任务、中断、临界区中均可调用)
+ * @author Yukikaze
+ */
+void AppTrace_Record(AppTrace_Type_t type, uint8_t id, uint16_t arg);
+
+/**
+ * @brief 记录任务创建并保存任务名(traceTASK_CREATE调用)
+ * @author Yukikaze
+ */
+void AppTrace_TaskCreate(unsigned long number, const char *name, unsigned long priority);
+
+/**
+ * @brief 记录中断进入/退出(在中断服务函数首尾调用，异常号自动读取)
+ * @author Yukikaze
+ */
+void AppTrace_IsrEnter(void);
+void AppTrace_IsrExit(void);
+
+/**
+ * @brief 分配队列编号(traceQUEUE_CREATE调用)
+ * @author Yukikaze
+ */
+unsigned long AppTrace_NextQueueNumber(void);
+
+/**
+ * @brief 冻结缓冲，保留到下次复位后输出
+ * @author Yukikaze
+ *
+ * @param reason 冻结原因(AppTrace_Reason_t)
+ */
+void AppTrace_Freeze(uint16_t reason);
+
+/**
+ * @brief 经串口输出当前缓冲(查询发送，耗时较长)
+ * @author Yukikaze
+ *
+ * @note 输出期间暂停记录，结束后恢复
+ */
+void AppTrace_Dump(void);
+
+#endif /* __APP_TRACE_H */
@@ -0,0 +1,248 @@
+/**
+ * @file app_trace.c
+ * @brief 调度跟踪记录器实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 记录路径用PRIMASK关中断保护(可能在任意优先级的中断中调用)，
+ *       单个事件约几十个时钟周期
+ *       时间戳取64位DWT计数的低32位，高32位变化时先插入一个SYNC事件；
+ *       SYNC被覆盖时记下它的高32位，即最旧的保留事件所在的时间段，输出时作为开头的SYNC
+ */
+
+#include "app_trace.h"
+#include "trace_ring.h"
+#include "mem_section.h"
+#include "core_delay.h"
+#include "stm32f4xx.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有类型
+ * ============================================================================
+ */
+
+/**
+ * @brief 跨复位保留的记录器状态
+ */
+typedef struct
+{
+    TraceRing_TypeDef ring;                                /**< 环形缓冲控制块 */
+    uint32_t ts_high;                                      /**< 最近记录的时间戳高32位 */
+    uint32_t tail_high;                                    /**< 最旧的保留事件的时间戳高32位 */
+    uint32_t queue_num;                                    /**< 已分配的队列编号 */
+    uint16_t reason;                                       /**< 冻结原因 */
+    char names[APP_TRACE_MAX_TASKS][APP_TRACE_NAME_LEN];   /**< 任务名表(按编号) */
+} AppTrace_State_TypeDef;
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+/* 放在.noinit，复位后由AppTrace_Init判断是否为有效的冻结缓冲 */
+static MEM_NOINIT AppTrace_State_TypeDef s_xTrace;
+static MEM_NOINIT TraceRing_Event_TypeDef s_xEvents[APP_TRACE_EVENTS];
+
+/* 记录器是否可用(.bss，每次启动清零，Init之前的钩子调用直接忽略) */
+static volatile uint8_t s_ucReady = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 写入环形缓冲，覆盖SYNC时更新最旧事件的时间段
+ */
+static void AppTrace_Put(uint32_t ts, uint8_t type, uint8_t id, uint16_t arg)
+{
+    TraceRing_Event_TypeDef old;
+
+    /* 被覆盖的SYNC之后的事件成为最旧事件，它们的高32位就是这个SYNC的值 */
+    if (TraceRing_Evicts(&s_xTrace.ring, &old) && old.type == APP_TRACE_SYNC)
+    {
+        s_xTrace.tail_high = old.ts;
+    }
+    (void)TraceRing_Put(&s_xTrace.ring, ts, type, id, arg);
+}
+
+/**
+ * @brief 写入一个事件(调用者已关中断)
+ */
+static void AppTrace_PutLocked(AppTrace_Type_t type, uint8_t id, uint16_t arg)
+{
+    uint64_t ts = CPU_TS_Read64();
+    uint32_t high = (uint32_t)(ts >> 32);
+
+    if (high != s_xTrace.ts_high)
+    {
+        s_xTrace.ts_high = high;
+        AppTrace_Put(high, APP_TRACE_SYNC, 0, 0);
+    }
+    AppTrace_Put((uint32_t)ts, (uint8_t)type, id, arg);
+}
+
+/**
+ * @brief 输出一个事件行
+ */
+static void AppTrace_PrintEvent(const TraceRing_Event_TypeDef *e)
+{
+    char hex[TRACE_RING_HEX_LEN + 1U];
+
+    TraceRing_Encode(e, hex);
+    printf("TRACE,E,%s\r\n", hex);
+}
+
+/**
+ * @brief 输出整个缓冲
+ */
+static void AppTrace_Print(void)
+{
+    TraceRing_Event_TypeDef e;
+    uint32_t cursor = TraceRing_Tail(&s_xTrace.ring);
+    uint32_t lost;
+
+    printf("TRACE,BEGIN,%lu,%lu,%lu,%lu,%u\r\n",
+           (unsigned long)(s_xTrace.ring.head - cursor),
+           (unsigned long)cursor,
+           (unsigned long)s_xTrace.ring.dropped,
+           (unsigned long)SystemCoreClock,
+           (unsigned int)s_xTrace.reason);
+
+    for (uint8_t i = 0; i < APP_TRACE_MAX_TASKS; i++)
+    {
+        if (s_xTrace.names[i][0] != '\0')
+        {
+            printf("TRACE,N,%u,%.*s\r\n", (unsigned int)i, APP_TRACE_NAME_LEN, s_xTrace.names[i]);
+        }
+    }
+
+    /* 最旧的保留事件之前的SYNC可能已被覆盖，先补一个SYNC给出它所在的时间段 */
+    e.ts = s_xTrace.tail_high;
+    e.type = APP_TRACE_SYNC;
+    e.id = 0;
+    e.arg = 0;
+    AppTrace_PrintEvent(&e);
+
+    while (TraceRing_Read(&s_xTrace.ring, &cursor, &e, 1, &lost) == 1)
+    {
+        AppTrace_PrintEvent(&e);
+    }
+
+    printf("TRACE,END\r\n");
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void AppTrace_Init(void)
+{
+    if (TraceRing_IsValid(&s_xTrace.ring, s_xEvents, APP_TRACE_EVENTS) && s_xTrace.ring.frozen)
+    {
+        printf("Trace from previous run (reason %u):\r\n", (unsigned int)s_xTrace.reason);
+        AppTrace_Print();
+    }
+
+    memset(&s_xTrace, 0, sizeof(s_xTrace));
+    (void)TraceRing_Init(&s_xTrace.ring, s_xEvents, APP_TRACE_EVENTS, TRACE_RING_OVERWRITE);
+    s_xTrace.ts_high = (uint32_t)(CPU_TS_Read64() >> 32);
+    s_xTrace.tail_high = s_xTrace.ts_high;
+    s_ucReady = 1;
+}
+
+MEM_FASTCODE void AppTrace_Record(AppTrace_Type_t type, uint8_t id, uint16_t arg)
+{
+    uint32_t primask;
+
+    if (!s_ucReady)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    AppTrace_PutLocked(type, id, arg);
+    __set_PRIMASK(primask);
+}
+
+void AppTrace_TaskCreate(unsigned long number, const char *name, unsigned long priority)
+{
+    if (!s_ucReady)
+    {
+        return;
+    }
+
+    if (number < APP_TRACE_MAX_TASKS)
+    {
+        strncpy(s_xTrace.names[number], name, APP_TRACE_NAME_LEN);
+    }
+    AppTrace_Record(APP_TRACE_TASK_CREATE, (uint8_t)number, (uint16_t)priority);
+}
+
+MEM_FASTCODE void AppTrace_IsrEnter(void)
+{
+    AppTrace_Record(APP_TRACE_ISR_ENTER, (uint8_t)__get_IPSR(), 0);
+}
+
+MEM_FASTCODE void AppTrace_IsrExit(void)
+{
+    AppTrace_Record(APP_TRACE_ISR_EXIT, (uint8_t)__get_IPSR(), 0);
+}
+
+unsigned long AppTrace_NextQueueNumber(void)
+{
+    /* 只在创建队列时调用(内核临界区内)，编号从1开始 */
+    return ++s_xTrace.queue_num;
+}
+
+void AppTrace_Freeze(uint16_t reason)
+{
+    uint32_t primask;
+
+    if (!s_ucReady)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (!s_xTrace.ring.frozen)
+    {
+        AppTrace_PutLocked(APP_TRACE_FREEZE, 0, reason);
+        s_xTrace.reason = reason;
+        TraceRing_Freeze(&s_xTrace.ring, 1);
+    }
+    __set_PRIMASK(primask);
+}
+
+void AppTrace_Dump(void)
+{
+    uint32_t primask;
+    uint8_t was_frozen;
+
+    if (!s_ucReady)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    was_frozen = s_xTrace.ring.frozen;
+    TraceRing_Freeze(&s_xTrace.ring, 1);
+    __set_PRIMASK(primask);
+
+    AppTrace_Print();
+
+    if (!was_frozen)
+    {
+        TraceRing_Freeze(&s_xTrace.ring, 0);
+    }
+}
@@ -4,10 +4,12 @@
  * @author Yukikaze
  * @date 2025-12-2
  *
- * @note 本任务周期性刷新OLED屏幕显示传感器数据
- *       刷新周期: 1秒 (使用vTaskDelayUntil精确控制)
+ * @note 本任务由数据总线事件驱动刷新OLED屏幕:
+ *       - 当前页面对应的主题有新样本时立即重绘
+ *       - 每 TASK_DISPLAY_PAGE_MS 轮换一次页面
+ *       其余时间任务保持阻塞，不做无意义的唤醒
  *       任务优先级: 4 (高优先级)
- *       LED指示: LED3(蓝色) 运行时点亮
+ *       LED指示: LED3(蓝色) 重绘时点亮
  */
 
 #ifndef __TASK_DISPLAY_H
@@ -24,7 +26,8 @@
 #define TASK_DISPLAY_NAME "Task_Display" /**< 任务名称 */
 #define TASK_DISPLAY_STACK_SIZE 768      /**< 任务栈大小(字) */
 #define TASK_DISPLAY_PRIORITY 4          /**< 任务优先级(最高) */
-#define TASK_DISPLAY_PERIOD_MS 1000      /**< 刷新周期(毫秒) */
+#define TASK_DISPLAY_PAGE_MS 3000        /**< 页面轮换周期(毫秒) */
+#define TASK_DISPLAY_PERIOD_MS 1000      /**< 轮询基准构建的重绘周期(毫秒，见app_task.h) */
 
 /**
  * ============================================================================
@@ -60,25 +63,11 @@ extern TaskHandle_t Task_Display_Handle;
  * @param pvParameters 任务参数(未使用)
  *
  * @note 任务执行流程:
- *       1. 点亮LED3(蓝色)指示任务运行
- *       2. 获取共享传感器数据
- *       3. 根据当前显示模式刷新OLED屏幕
- *       4. 切换显示模式(轮流显示)
- *       5. 熄灭LED3
- *       6. 使用vTaskDelayUntil精确等待下一周期
- *
- *       使用vTaskDelayUntil而非vTaskDelay的原因:
- *       - vTaskDelay: 从调用时刻开始延时，不考虑任务执行时间
- *       - vTaskDelayUntil: 从上次唤醒时刻开始计算，保证精确周期
+ *       1. 订阅数据总线(任务通知，只关注当前页面的主题)
+ *       2. 需要重绘时点亮LED3，读取共享数据并刷新当前页面，熄灭LED3
+ *       3. 等待任务通知，超时时间为距下次页面轮换的剩余时间
+ *       4. 收到当前页面主题的通知则重绘；超时则轮换页面、改订新页面的主题并重绘
  */
 void Task_Display(void *pvParameters);
 
-/**
- * @brief 创建OLED显示任务
- * @author Yukikaze
- *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
- */
-BaseType_t Task_Display_Create(void);
-
 #endif /* __TASK_DISPLAY_H */
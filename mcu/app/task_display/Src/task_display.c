@@ -4,14 +4,16 @@
  * @author Yukikaze
  * @date 2025-12-2
  *
- * @note 本任务周期性(1秒)刷新OLED屏幕显示传感器数据
- *       使用vTaskDelayUntil实现精确的1秒刷新周期
- *       轮流显示温湿度数据和光照数据
- *       任务运行时点亮LED3(蓝色)作为指示
+ * @note 本任务由数据总线的任务通知驱动刷新OLED屏幕
+ *       当前页面的数据有更新时立即重绘，每3秒轮流显示温湿度数据和光照数据
+ *       重绘时点亮LED3(蓝色)作为指示
  */
 
 #include "task_display.h"
+#include "app_boot.h"
 #include "app_data.h"
+#include "app_task.h"
+#include "app_bus.h"
 #include "bsp_oled.h"
 #include "bsp_led.h"
 #include <stdio.h>
@@ -26,6 +28,16 @@
 /* 任务句柄 */
 TaskHandle_t Task_Display_Handle = NULL;
 
+#if (APP_POLLING_BASELINE == 0)
+/* 各页面关注的数据总线主题
+ * 同一次更新的多个主题在共享数据写完之后才依次发布，只需关注最后发布的那个，
+ * 避免一次更新重绘多次 */
+static const uint32_t s_ulPageTopics[DISPLAY_MODE_MAX] = {
+    APP_BUS_MASK(APP_BUS_TOPIC_HUMIDITY),
+    APP_BUS_MASK(APP_BUS_TOPIC_LIGHT_LUX),
+};
+#endif
+
 /**
  * ============================================================================
  * 私有函数声明
@@ -34,6 +46,7 @@ TaskHandle_t Task_Display_Handle = NULL;
 
 static void Display_TempHum(SensorData_TypeDef *pData);
 static void Display_Light(SensorData_TypeDef *pData);
+static void Display_Page(DisplayMode_t *pMode);
 
 /**
  * ============================================================================
@@ -51,7 +64,7 @@ static void Display_Light(SensorData_TypeDef *pData);
  *       第0行: "==TempHum Data=="
  *       第2行: "Temp: XX C"
  *       第4行: "Humi: XX %"
- *       如果数据无效则显示"--"
+ *       如果数据无效则显示"--"，超过 APP_DATA_TEMPHUM_STALE_MS 未更新则状态显示OLD
  */
 static void Display_TempHum(SensorData_TypeDef *pData)
 {
@@ -85,15 +98,22 @@ static void Display_TempHum(SensorData_TypeDef *pData)
     }
     OLED_ShowStr(0, 4, (unsigned char *)line_buf, 1);
 
-    /* 状态行 */
-    if (pData->dht11_valid)
+    /* 状态行: 数据有效但长时间未更新时显示OLD */
+    if (!pData->dht11_valid)
     {
-        OLED_ShowStr(0, 6, (unsigned char *)"Status: OK", 1);
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: ERR", 1);
+    }
+    else if (AppData_IsStale(&pData->temphum_meta, APP_DATA_TEMPHUM_STALE_MS))
+    {
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: OLD", 1);
     }
     else
     {
-        OLED_ShowStr(0, 6, (unsigned char *)"Status: ERR", 1);
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: OK", 1);
     }
+
+    /* 统计采样到显示的端到端延迟 */
+    AppData_RecordLatency(APP_DATA_CH_TEMPHUM, &pData->temphum_meta);
 }
 
 /**
@@ -105,13 +125,12 @@ static void Display_TempHum(SensorData_TypeDef *pData)
  * @note 显示格式:
  *       第0行: "==Light Data=="
  *       第2行: "ADC: XXXX"
- *       第4行: "Light: XX %"
- *       光照百分比计算: 100 - (ADC * 100 / 4095)
+ *       第4行: "Lux: XXXXX XX%"
+ *       照度与百分比由Task_Light统一换算，此处只负责显示
  */
 static void Display_Light(SensorData_TypeDef *pData)
 {
-    char line_buf[20];
-    uint8_t light_percent;
+    char line_buf[32];
 
     /* 清屏 */
     OLED_CLS();
@@ -119,10 +138,10 @@ static void Display_Light(SensorData_TypeDef *pData)
     /* 标题行 */
     OLED_ShowStr(0, 0, (unsigned char *)"==Light Data==", 1);
 
-    /* ADC原始值行 */
+    /* ADC滤波值行 */
     if (pData->light_valid)
     {
-        sprintf(line_buf, "ADC: %lu", pData->light_adc);
+        sprintf(line_buf, "ADC: %lu", (unsigned long)pData->light_adc);
     }
     else
     {
@@ -130,51 +149,77 @@ static void Display_Light(SensorData_TypeDef *pData)
     }
     OLED_ShowStr(0, 2, (unsigned char *)line_buf, 1);
 
-    /* 光照百分比行 */
+    /* 照度与百分比行 */
     if (pData->light_valid)
     {
-        light_percent = (uint8_t)(100 - (pData->light_adc * 100 / 4095));
-        sprintf(line_buf, "Light: %d %%", light_percent);
+        snprintf(line_buf, sizeof(line_buf), "Lux: %lu %d%%", (unsigned long)pData->light_lux, pData->light_percent);
     }
     else
     {
-        sprintf(line_buf, "Light: -- %%");
+        sprintf(line_buf, "Lux: -- --%%");
     }
     OLED_ShowStr(0, 4, (unsigned char *)line_buf, 1);
 
-    /* 状态行 */
-    if (pData->light_valid)
+    /* 状态行: 数据有效但长时间未更新时显示OLD */
+    if (!pData->light_valid)
     {
-        OLED_ShowStr(0, 6, (unsigned char *)"Status: OK", 1);
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: ERR", 1);
+    }
+    else if (AppData_IsStale(&pData->light_meta, APP_DATA_LIGHT_STALE_MS))
+    {
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: OLD", 1);
     }
     else
     {
-        OLED_ShowStr(0, 6, (unsigned char *)"Status: ERR", 1);
+        OLED_ShowStr(0, 6, (unsigned char *)"Status: OK", 1);
     }
+
+    /* 统计采样到显示的端到端延迟 */
+    AppData_RecordLatency(APP_DATA_CH_LIGHT, &pData->light_meta);
 }
 
 /**
- * @brief OLED显示任务函数
+ * @brief 读取共享数据并绘制当前页面
  * @author Yukikaze
  *
- * @param pvParameters 任务参数(未使用)
+ * @param pMode 当前显示模式(非法值时复位为温湿度页面)
+ */
+static void Display_Page(DisplayMode_t *pMode)
+{
+    SensorData_TypeDef sensor_data;
+
+    /* 获取传感器数据副本(线程安全) */
+    AppData_GetSensorData(&sensor_data);
+
+    /* 根据当前模式显示数据 */
+    switch (*pMode)
+    {
+    case DISPLAY_MODE_TEMPHUM:
+        Display_TempHum(&sensor_data);
+        break;
+
+    case DISPLAY_MODE_LIGHT:
+        Display_Light(&sensor_data);
+        break;
+
+    default:
+        *pMode = DISPLAY_MODE_TEMPHUM;
+        break;
+    }
+}
+
+#if (APP_POLLING_BASELINE == 1)
+/**
+ * @brief OLED显示任务函数(轮询基准构建)
+ * @author Yukikaze
  *
- * @note 任务执行流程:
- *       1. 点亮LED3(蓝色)指示任务运行
- *       2. 获取共享传感器数据
- *       3. 根据当前显示模式刷新OLED屏幕
- *       4. 切换显示模式(轮流显示温湿度和光照)
- *       5. 熄灭LED3
- *       6. 使用vTaskDelayUntil精确等待下一周期(1秒)
+ * @param pvParameters 任务参数(未使用)
  *
- * @note vTaskDelayUntil vs vTaskDelay:
- *       vTaskDelay(1000): 任务执行完后延时1000ms
- *       vTaskDelayUntil(&xLastWakeTime, 1000): 从上次唤醒开始算1000ms
- *       后者保证精确的周期性执行，不受任务执行时间影响
+ * @note 数据总线驱动之前的固定周期循环，只用于对比唤醒次数与采样到显示的延迟:
+ *       每TASK_DISPLAY_PERIOD_MS无条件重绘一次并轮换页面，不订阅数据总线
  */
 void Task_Display(void *pvParameters)
 {
-    SensorData_TypeDef sensor_data;
     DisplayMode_t current_mode = DISPLAY_MODE_TEMPHUM;
     TickType_t xLastWakeTime;
     const TickType_t xPeriod = pdMS_TO_TICKS(TASK_DISPLAY_PERIOD_MS);
@@ -182,7 +227,9 @@ void Task_Display(void *pvParameters)
     /* 避免编译器警告 */
     (void)pvParameters;
 
-    /* 初始化xLastWakeTime为当前时间 */
+    /* 等待OLED初始化完成 */
+    AppBoot_Wait(APP_BOOT_RES_DISPLAY, portMAX_DELAY);
+
     xLastWakeTime = xTaskGetTickCount();
 
     /* 任务主循环 */
@@ -191,24 +238,7 @@ void Task_Display(void *pvParameters)
         /* 点亮LED3(蓝色)指示任务正在运行 */
         LED3_ON;
 
-        /* 获取传感器数据副本(线程安全) */
-        AppData_GetSensorData(&sensor_data);
-
-        /* 根据当前模式显示数据 */
-        switch (current_mode)
-        {
-        case DISPLAY_MODE_TEMPHUM:
-            Display_TempHum(&sensor_data);
-            break;
-
-        case DISPLAY_MODE_LIGHT:
-            Display_Light(&sensor_data);
-            break;
-
-        default:
-            current_mode = DISPLAY_MODE_TEMPHUM;
-            break;
-        }
+        Display_Page(&current_mode);
 
         /* 切换到下一个显示模式 */
         current_mode++;
@@ -217,37 +247,83 @@ void Task_Display(void *pvParameters)
             current_mode = DISPLAY_MODE_TEMPHUM;
         }
 
-        /* 使用vTaskDelayUntil实现精确的1秒周期
-         * 不同于vTaskDelay，vTaskDelayUntil从xLastWakeTime开始计算
-         * 即使任务执行时间有波动，也能保证精确的周期性
-         */
+        /* 固定周期，与数据何时更新无关 */
         vTaskDelayUntil(&xLastWakeTime, xPeriod);
 
         /* 周期结束前熄灭LED3 */
         LED3_OFF;
     }
 }
-
+#else
 /**
- * @brief 创建OLED显示任务
+ * @brief OLED显示任务函数
  * @author Yukikaze
  *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
+ * @param pvParameters 任务参数(未使用)
+ *
+ * @note 任务执行流程:
+ *       1. 订阅数据总线(任务通知，通知值按位对应主题)，只关注当前页面的主题
+ *       2. 需要重绘时点亮LED3，读取共享数据并刷新当前页面，熄灭LED3
+ *       3. 等待任务通知，超时时间为距下次页面轮换的剩余时间
+ *       4. 收到当前页面主题的通知则立即重绘；超时则轮换页面、改订新页面的主题并重绘
  *
- * @note 使用xTaskCreate创建任务
- *       任务栈大小: 512字(因为使用sprintf需要较大栈空间)
- *       任务优先级: 4 (最高，确保显示更新及时)
+ * @note 数据从采集完成到上屏只经过一次任务切换，不再受固定刷新周期影响
+ * @note OLED在启动工作任务中初始化，第一次绘制前等待其就绪位；
+ *       初始化失败时照常运行(I2C无应答，只是画面不更新)
  */
-BaseType_t Task_Display_Create(void)
+void Task_Display(void *pvParameters)
 {
-    BaseType_t xReturn;
+    DisplayMode_t current_mode = DISPLAY_MODE_TEMPHUM;
+    TickType_t xPageStart;
+    TickType_t xElapsed;
+    const TickType_t xPage = pdMS_TO_TICKS(TASK_DISPLAY_PAGE_MS);
+    uint32_t ulBits;
+    uint8_t redraw = 1;
+    int sub;
+
+    /* 避免编译器警告 */
+    (void)pvParameters;
+
+    /* 等待OLED初始化完成(第一次绘制读取的是当时的共享数据，等待期间的更新不会丢失) */
+    AppBoot_Wait(APP_BOOT_RES_DISPLAY, portMAX_DELAY);
+
+    /* 只订阅当前页面的主题，另一页面的数据更新不唤醒本任务(轮换时整页重绘) */
+    sub = AppBus_SubscribeNotify(s_ulPageTopics[current_mode], 0, xTaskGetCurrentTaskHandle());
 
-    xReturn = xTaskCreate((TaskFunction_t)Task_Display,
-                          (const char *)TASK_DISPLAY_NAME,
-                          (uint16_t)TASK_DISPLAY_STACK_SIZE,
-                          (void *)NULL,
-                          (UBaseType_t)TASK_DISPLAY_PRIORITY,
-                          (TaskHandle_t *)&Task_Display_Handle);
+    xPageStart = xTaskGetTickCount();
 
-    return xReturn;
+    /* 任务主循环 */
+    for (;;)
+    {
+        if (redraw)
+        {
+            /* 点亮LED3(蓝色)指示正在重绘 */
+            LED3_ON;
+
+            Display_Page(&current_mode);
+
+            LED3_OFF;
+        }
+
+        /* 等待数据事件，最长等到下次页面轮换 */
+        xElapsed = xTaskGetTickCount() - xPageStart;
+        if (xElapsed < xPage &&
+            xTaskNotifyWait(0, UINT32_MAX, &ulBits, xPage - xElapsed) == pdTRUE)
+        {
+            /* 只有当前页面的数据变化才需要重绘 */
+            redraw = (ulBits & s_ulPageTopics[current_mode]) != 0;
+            continue;
+        }
+
+        /* 切换到下一个显示模式 */
+        current_mode++;
+        if (current_mode >= DISPLAY_MODE_MAX)
+        {
+            current_mode = DISPLAY_MODE_TEMPHUM;
+        }
+        AppBus_SetMask(sub, s_ulPageTopics[current_mode]);
+        xPageStart = xTaskGetTickCount();
+        redraw = 1;
+    }
 }
+#endif
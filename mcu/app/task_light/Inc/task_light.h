@@ -4,10 +4,11 @@
  * @author Yukikaze
  * @date 2025-12-2
  *
- * @note 本任务周期性读取光敏电阻的ADC值
- *       采集周期: 1.5秒
+ * @note 本任务读取光敏电阻的ADC值
+ *       事件模式: ADC模拟看门狗越界唤醒，无事件时10秒刷新一次
+ *       轮询模式: 采集周期1.5秒
  *       任务优先级: 3 (中优先级)
- *       LED指示: LED2(绿色) 运行时点亮
+ *       LED指示: LED2(绿色) 每次采集点亮250毫秒(定时器熄灭)
  */
 
 #ifndef __TASK_LIGHT_H
@@ -25,6 +26,17 @@
 #define TASK_LIGHT_STACK_SIZE 512    /**< 任务栈大小(字) */
 #define TASK_LIGHT_PRIORITY 3        /**< 任务优先级(中) */
 #define TASK_LIGHT_PERIOD_MS 1500    /**< 采集周期(毫秒) */
+#define TASK_LIGHT_MEDIAN_LEN 3      /**< 中值滤波点数 */
+#define TASK_LIGHT_IIR_ALPHA 16384   /**< IIR平滑系数(Q15, 0.5) */
+#define TASK_LIGHT_LED_MS 250        /**< LED2指示时长(毫秒) */
+
+/* 事件模式: 1=模拟看门狗越界唤醒, 0=按TASK_LIGHT_PERIOD_MS周期轮询 */
+#ifndef TASK_LIGHT_EVENT_MODE
+#define TASK_LIGHT_EVENT_MODE 1
+#endif
+#define TASK_LIGHT_AWD_HALF_WIDTH 64 /**< 看门狗阈值带半宽(ADC计数) */
+#define TASK_LIGHT_AWD_HYSTERESIS 32 /**< 上报所需的最小变化量(ADC计数) */
+#define TASK_LIGHT_REFRESH_MS 10000  /**< 无事件时的刷新超时(毫秒) */
 
 /**
  * ============================================================================
@@ -48,21 +60,21 @@ extern TaskHandle_t Task_Light_Handle;
  * @param pvParameters 任务参数(未使用)
  *
  * @note 任务执行流程:
- *       1. 点亮LED2(绿色)指示任务运行
+ *       1. 点亮LED2(绿色)指示任务运行，由定时器到时熄灭
  *       2. 读取光敏电阻ADC值
  *       3. 更新共享数据结构
- *       4. 通过串口打印调试信息
- *       5. 熄灭LED2
- *       6. 延时等待下一周期
+ *       4. 等待越界通知或周期定时器通知
  */
 void Task_Light(void *pvParameters);
 
+#if TASK_LIGHT_EVENT_MODE
 /**
- * @brief 创建光照采集任务
+ * @brief ADC模拟看门狗越界通知(中断中调用)
  * @author Yukikaze
  *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
+ * @param pxHigherPriorityTaskWoken 是否需要在退出中断时切换任务
  */
-BaseType_t Task_Light_Create(void);
+void Task_Light_AWDFromISR(BaseType_t *pxHigherPriorityTaskWoken);
+#endif
 
 #endif /* __TASK_LIGHT_H */
@@ -4,26 +4,26 @@
  * @author Yukikaze
  * @date 2025-12-2
  *
- * @note 本任务周期性(1.5秒)读取光敏电阻的ADC值
- *       读取成功后更新共享数据结构供显示任务使用
- *       任务运行时点亮LED2(绿色)作为指示
+ * @note 默认工作在事件模式: 任务睡眠直到ADC模拟看门狗检测到光照越出阈值带，
+ *       确认新电平后更新共享数据并围绕新电平重新布防(CIC输出确已越界时先用新值重填滤波器)；
+ *       关闭 TASK_LIGHT_EVENT_MODE 时退回周期(1.5秒)轮询
+ *       任务运行时点亮LED2(绿色)作为指示，由软件定时器熄灭
  */
 
 #include "task_light.h"
+#include "app_boot.h"
 #include "app_data.h"
+#include "app_task.h"
+#include "app_calib.h"
+#include "app_power.h"
+#include "app_timer.h"
 #include "bsp_adc.h"
 #include "bsp_led.h"
+#include "filter.h"
+#include "mem_section.h"
+#include "threshold.h"
 #include <stdio.h>
 
-/**
- * ============================================================================
- * 外部变量引用
- * ============================================================================
- */
-
-/* ADC转换结果(由ADC中断回调更新) */
-extern __IO uint32_t ADC_ConvertedValue;
-
 /**
  * ============================================================================
  * 全局变量定义
@@ -33,6 +33,18 @@ extern __IO uint32_t ADC_ConvertedValue;
 /* 任务句柄 */
 TaskHandle_t Task_Light_Handle = NULL;
 
+/* 光照滤波链: 中值(剔除尖峰) -> 一阶IIR低通(状态放在CCMRAM) */
+static MEM_PLACE_FILTER Filter_Median_TypeDef s_xLightMedian;
+static MEM_PLACE_FILTER Filter_IIR_TypeDef s_xLightIIR;
+
+#if TASK_LIGHT_EVENT_MODE
+/* 模拟看门狗阈值带(中断只调用Threshold_Trigger，其余由本任务操作) */
+static Threshold_Band_TypeDef s_xLightBand;
+#elif (APP_POLLING_BASELINE == 0)
+/* 轮询周期定时器 */
+static AppTimer_TypeDef s_xPeriodTimer;
+#endif
+
 /**
  * ============================================================================
  * 函数实现
@@ -46,12 +58,14 @@ TaskHandle_t Task_Light_Handle = NULL;
  * @param pvParameters 任务参数(未使用)
  *
  * @note 任务执行流程:
- *       1. 点亮LED2(绿色)指示任务运行
- *       2. 读取光敏电阻ADC转换值
- *       3. 更新共享数据结构
- *       4. 通过串口打印调试信息
- *       5. 熄灭LED2
- *       6. 延时等待下一周期(1.5秒)
+ *       1. 点亮LED2(绿色)指示任务运行(250毫秒后由定时器熄灭)
+ *       2. 读取光敏电阻ADC转换值，经中值+IIR滤波
+ *       3. 更新VREFINT补偿，换算照度与百分比(只在此处计算一次)
+ *       4. 更新共享数据结构
+ *       5. 等待越界通知(事件模式)或周期定时器通知(轮询模式，1.5秒)
+ *
+ *       轮询基准构建(APP_POLLING_BASELINE，见app_task.h)恢复原来的LED指示:
+ *       采集完成即熄灭(事件模式)，或用vTaskDelay保持250毫秒后熄灭再vTaskDelayUntil到下一周期(轮询模式)
  *
  *       ADC值说明:
  *       - 范围: 0-4095 (12位ADC)
@@ -60,63 +74,124 @@ TaskHandle_t Task_Light_Handle = NULL;
  */
 void Task_Light(void *pvParameters)
 {
+    uint32_t raw;
     uint32_t light_value;
+    uint32_t light_lux;
     uint8_t light_percent;
+#if TASK_LIGHT_EVENT_MODE
+    uint32_t notified;
+    Threshold_Event_t evt;
+#elif (APP_POLLING_BASELINE == 1)
     TickType_t xLastWakeTime;
-    const TickType_t xPeriod = pdMS_TO_TICKS(TASK_LIGHT_PERIOD_MS);
+#endif
 
     /* 避免编译器警告 */
     (void)pvParameters;
 
-    /* 初始化上次唤醒时间 */
+    /* 初始化光照滤波链 */
+    Filter_Median_Init(&s_xLightMedian, TASK_LIGHT_MEDIAN_LEN);
+    Filter_IIR_Init(&s_xLightIIR, TASK_LIGHT_IIR_ALPHA);
+
+#if TASK_LIGHT_EVENT_MODE
+    /* 初始化阈值带(12位ADC量程) */
+    Threshold_Init(&s_xLightBand, TASK_LIGHT_AWD_HALF_WIDTH,
+                   TASK_LIGHT_AWD_HYSTERESIS, 0, 4095);
+    notified = 1;
+
+    /* 模拟看门狗依赖ADC连续转换，STOP模式下ADC时钟停止，禁止STOP */
+    AppPower_StopLock();
+#elif (APP_POLLING_BASELINE == 1)
     xLastWakeTime = xTaskGetTickCount();
+#else
+    /* 启动轮询周期定时器(到期通知本任务) */
+    AppTimer_StartNotify(&s_xPeriodTimer, Task_Light_Handle, TASK_LIGHT_PERIOD_MS);
+#endif
 
     /* 任务主循环 */
     for (;;)
     {
-        /* 点亮LED2(绿色)指示任务正在运行 */
+#if (APP_POLLING_BASELINE == 1)
         LED2_ON;
-
-        /* 读取ADC转换值 */
-        light_value = ADC_ConvertedValue;
-
-        /* 更新共享数据 */
-        AppData_UpdateLight(light_value, 1);
-
-        /* 计算光照百分比(值越小光照越强) */
-        light_percent = (uint8_t)(100 - (light_value * 100 / 4095));
-
-        /* 保持LED点亮250ms */
-        vTaskDelay(pdMS_TO_TICKS(250));
-
-        /* 熄灭LED2 */
+#else
+        /* 点亮LED2(绿色)指示任务正在运行，由定时器到时熄灭 */
+        AppTimer_LedPulse(APP_TIMER_LED2, TASK_LIGHT_LED_MS);
+#endif
+
+        /* 读取ADC转换值(中断中已做CIC抽取)，再经中值+IIR滤波 */
+        raw = ADC_ConvertedValue;
+#if TASK_LIGHT_EVENT_MODE
+        /* 看门狗唤醒且CIC输出确已越出阈值带: 电平发生了阶跃，而中值窗口里多数仍是旧电平，
+         * 直接滤波会返回旧值并围绕旧电平重新布防(随即再次越界)，因此先用新值重填滤波器；
+         * CIC输出仍在带内时视为原始转换上的尖峰，照常滤波 */
+        if (notified != 0 && Threshold_IsOutside(&s_xLightBand, (uint16_t)raw))
+        {
+            Filter_Median_Reset(&s_xLightMedian);
+            Filter_IIR_Reset(&s_xLightIIR);
+        }
+#endif
+        light_value = (uint32_t)Filter_Median_Update(&s_xLightMedian, (int16_t)raw);
+        light_value = (uint32_t)Filter_IIR_Update(&s_xLightIIR, (int16_t)light_value);
+
+#if APP_CALIB_USE_VREFINT
+        /* 跟踪电源电压漂移 */
+        AppCalib_UpdateVrefint(PhotoResistor_ReadVrefint());
+#endif
+
+#if TASK_LIGHT_EVENT_MODE
+        /* 确认新电平: 超过迟滞才上报，超时唤醒时照常刷新共享数据 */
+        evt = Threshold_Settle(&s_xLightBand, (uint16_t)light_value);
+        if (evt != THRESH_EVENT_NONE || notified == 0)
+        {
+            light_lux = AppCalib_LightToLux((uint16_t)light_value);
+            light_percent = AppCalib_LightToPercent((uint16_t)light_value);
+            AppData_UpdateLight(light_value, light_lux, light_percent, 1);
+            AppBoot_Mark("light");
+        }
+
+        /* 以新电平为中心重新布防模拟看门狗 */
+        PhotoResistor_AWD_Arm(s_xLightBand.low, s_xLightBand.high);
+#if (APP_POLLING_BASELINE == 1)
         LED2_OFF;
-
-        /* 精确延时到下一个周期（1.5秒）*/
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
+#endif
+
+        /* 睡眠直到光照越出阈值带，或到达刷新超时 */
+        notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TASK_LIGHT_REFRESH_MS));
+#else
+        /* 换算照度与百分比，更新共享数据 */
+        light_lux = AppCalib_LightToLux((uint16_t)light_value);
+        light_percent = AppCalib_LightToPercent((uint16_t)light_value);
+        AppData_UpdateLight(light_value, light_lux, light_percent, 1);
+        AppBoot_Mark("light");
+
+#if (APP_POLLING_BASELINE == 1)
+        /* 保持LED点亮后熄灭，再延时到下一个周期 */
+        vTaskDelay(pdMS_TO_TICKS(TASK_LIGHT_LED_MS));
+        LED2_OFF;
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(TASK_LIGHT_PERIOD_MS));
+#else
+        /* 等待下一个周期（1.5秒）*/
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+#endif
     }
 }
 
+#if TASK_LIGHT_EVENT_MODE
 /**
- * @brief 创建光照采集任务
+ * @brief ADC模拟看门狗越界通知(中断中调用)
  * @author Yukikaze
  *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
+ * @param pxHigherPriorityTaskWoken 是否需要在退出中断时切换任务
  *
- * @note 使用xTaskCreate创建任务
- *       任务栈大小: 512字
- *       任务优先级: 3
+ * @note 调用前中断服务函数已撤防看门狗，任务确认后重新布防
  */
-BaseType_t Task_Light_Create(void)
+void Task_Light_AWDFromISR(BaseType_t *pxHigherPriorityTaskWoken)
 {
-    BaseType_t xReturn;
-
-    xReturn = xTaskCreate((TaskFunction_t)Task_Light,
-                          (const char *)TASK_LIGHT_NAME,
-                          (uint16_t)TASK_LIGHT_STACK_SIZE,
-                          (void *)NULL,
-                          (UBaseType_t)TASK_LIGHT_PRIORITY,
-                          (TaskHandle_t *)&Task_Light_Handle);
+    Threshold_Trigger(&s_xLightBand);
 
-    return xReturn;
+    if (Task_Light_Handle != NULL)
+    {
+        vTaskNotifyGiveFromISR(Task_Light_Handle, pxHigherPriorityTaskWoken);
+    }
 }
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file task_prof.h
+ * @brief 运行时统计(CPU占用率)剖析任务头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 运行时间计数器使用DWT CYCCNT(见FreeRTOSConfig.h)，分辨率为一个内核时钟
+ *       本任务周期性采集各任务的CPU占用率、栈高水位、切入次数与唤醒次数，以CSV行输出到串口:
+ *         P,<seq>,<uptime_ms>,<window_us>,<task_num>
+ *         L,<seq>,<sleep_permille>,<stop_permille>,<sleeps>,<stops>,<wakes>,<early>,<aborts>
+ *         H,<seq>,<free>,<min_free>,<largest_free>,<free_blocks>,<frag_permille>,<allocs>,<fails>
+ *         M,<seq>,<block_size>,<count>,<used>,<high_water>,<fails>,<errors>
+ *         D,<seq>,<channel>,<count>,<min_us>,<avg_us>,<max_us>,<missed>
+ *         T,<seq>,<name>,<state>,<prio>,<cpu_permille>,<stack_free_words>,<switches>,<wakes>
+ *         C,<seq>,<from_hz>,<to_hz>,<idle_permille>
+ *       P行为窗口头，L行为休眠驻留(仅无节拍空闲启用时输出，见app_power.h)，
+ *       H行为RTOS堆概要(见app_heap.h)，M行为各内存池等级的累计统计(每个等级一行，见app_pool.h)，
+ *       D行为各数据通道采样到显示的累计延迟(每个通道一行，AppData_Channel_t顺序，见app_data.h)，
+ *       随后是task_num个T行(switches含被抢占后的恢复，wakes只计从阻塞/挂起转为就绪)；启动完成后的第一个窗口末尾另输出一次启动时间线(B行，见app_boot.h)；
+ *       启动完成后每个窗口末尾按IDLE占用率调频，切换档位时输出C行(见app_clock.h)，
+ *       T行的占用率按当时频率计算，降档后同样的工作量占比升高；
+ *       其余串口输出不以"P,"/"L,"/"H,"/"M,"/"D,"/"T,"/"B,"/"C,"开头，解析时忽略
+ *       串口控制台命令(单字符，接收中断转为任务通知，在本任务中执行):
+ *         h  输出堆监视完整报告(AppHeap_Dump)
+ *         光照现场标定(见app_calib.h)，反馈以"calib:"开头:
+ *         <lux>p  以当前光照滤波值与照度计读数<lux>采集一个标定点(数字在命令前输入，如"350p")
+ *         w       将采集的标定点写入Flash并立即生效(擦除扇区，CPU停顿1~2秒)
+ *         x       丢弃采集的标定点
+ *         <n>r    输出各通道最近n分钟(默认5)的分钟桶与丢弃样本数(见app_history.h)，
+ *                 每个桶一行"hist: <ch>,<t_s>,<min>,<avg>,<max>,<count>"，最后一行"hist: dropped <各通道>"
+ *       每个窗口的占用率与栈余量同时交给app_task核对预算(W/S行格式见app_task.h)
+ *       主机端解析与绘图: tools/prof_view.py
+ *       任务优先级: 1 (最低，只使用空闲时间)
+ */
+
+#ifndef __TASK_PROF_H
+#define __TASK_PROF_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * ============================================================================
+ * 任务配置参数
+ * ============================================================================
+ */
+#define TASK_PROF_NAME "Task_Prof"  /**< 任务名称 */
+#define TASK_PROF_STACK_SIZE 384    /**< 任务栈大小(字) */
+#define TASK_PROF_PRIORITY 1        /**< 任务优先级(最低) */
+#define TASK_PROF_PERIOD_MS 5000    /**< 统计窗口(毫秒) */
+#define TASK_PROF_MAX_TASKS 16      /**< 最多统计的任务数 */
+
+/* 任务通知位: 串口控制台命令 */
+#define TASK_PROF_CMD_HEAP_DUMP (1UL << 0)     /**< 'h': 堆监视报告 */
+#define TASK_PROF_CMD_CALIB_POINT (1UL << 1)   /**< 'p': 采集光照标定点 */
+#define TASK_PROF_CMD_CALIB_SAVE (1UL << 2)    /**< 'w': 写入光照标定表 */
+#define TASK_PROF_CMD_CALIB_DISCARD (1UL << 3) /**< 'x': 丢弃光照标定点 */
+#define TASK_PROF_CMD_HISTORY (1UL << 4)       /**< 'r': 输出最近的分钟历史 */
+
+#define TASK_PROF_HISTORY_MIN 5  /**< 'r'命令默认的分钟数 */
+#define TASK_PROF_HISTORY_MAX 16 /**< 'r'命令每个通道最多输出的桶数 */
+
+/* FreeRTOS V9 的运行时间计数器为32位(180MHz下约23.8秒回绕)，
+ * 各任务按窗口差值计算占用率，窗口必须小于一个回绕周期 */
+#if (TASK_PROF_PERIOD_MS >= 20000)
+#error "TASK_PROF_PERIOD_MS must be shorter than one CYCCNT wrap"
+#endif
+
+/**
+ * ============================================================================
+ * 外部变量声明
+ * ============================================================================
+ */
+
+/* 任务句柄 */
+extern TaskHandle_t Task_Prof_Handle;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 剖析任务函数
+ * @author Yukikaze
+ *
+ * @param pvParameters 任务参数(未使用)
+ */
+void Task_Prof(void *pvParameters);
+
+/**
+ * @brief 记录一次任务切入(由traceTASK_SWITCHED_IN调用)
+ * @author Yukikaze
+ *
+ * @param number 任务编号(TCB中的uxTCBNumber)
+ *
+ * @note 在PendSV中执行，只做一次数组自增
+ */
+void Task_Prof_SwitchedIn(UBaseType_t number);
+
+/**
+ * @brief 记录一次任务转为就绪(由traceMOVED_TASK_TO_READY_STATE调用)
+ * @author Yukikaze
+ *
+ * @param number 任务编号(TCB中的uxTCBNumber)
+ *
+ * @note 在内核临界区内执行(可能来自中断)，只做一次数组自增；
+ *       任务创建时也计一次，第一个窗口包含启动过程
+ */
+void Task_Prof_MadeReady(UBaseType_t number);
+
+/**
+ * @brief 处理控制台收到的一个字符(由串口接收中断调用)
+ * @author Yukikaze
+ *
+ * @param c 收到的字符(数字累积为下一个命令的参数，未识别的字符忽略并清除参数)
+ * @param pxHigherPriorityTaskWoken 是否需要在中断退出时切换任务
+ */
+void Task_Prof_CommandFromISR(uint8_t c, BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif /* __TASK_PROF_H */
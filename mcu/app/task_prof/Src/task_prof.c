@@ -0,0 +1,519 @@
+/**
+ * @file task_prof.c
+ * @brief 运行时统计(CPU占用率)剖析任务实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 开销估算(180MHz，约6个任务):
+ *       - uxTaskGetSystemState 含栈高水位扫描，约数十微秒
+ *       - 串口为查询发送，每窗口约300字节 ≈ 26ms(115200bps)
+ *       5秒窗口下合计约0.5% CPU，且只占用最低优先级时间
+ */
+
+#include "task_prof.h"
+#include "app_boot.h"
+#include "app_calib.h"
+#include "app_clock.h"
+#include "app_data.h"
+#include "app_heap.h"
+#include "app_history.h"
+#include "app_pool.h"
+#include "app_task.h"
+#include "core_delay.h"
+#include "mem_section.h"
+#if (configUSE_TICKLESS_IDLE == 1)
+#include "app_power.h"
+#endif
+#include <stdio.h>
+
+/**
+ * ============================================================================
+ * 全局变量定义
+ * ============================================================================
+ */
+
+/* 任务句柄 */
+TaskHandle_t Task_Prof_Handle = NULL;
+
+/* 按任务编号累计的切入次数(PendSV中自增，本任务只读) */
+static volatile uint32_t s_ulSwitchCount[TASK_PROF_MAX_TASKS];
+
+/* 按任务编号累计的就绪次数(任务或中断中自增，本任务只读) */
+static volatile uint32_t s_ulReadyCount[TASK_PROF_MAX_TASKS];
+
+/* 任务状态快照(放在静态区，避免占用任务栈) */
+static TaskStatus_t s_xStatus[TASK_PROF_MAX_TASKS];
+
+/* 上一窗口末的各任务累计值(按任务编号索引) */
+static uint32_t s_ulLastRunTime[TASK_PROF_MAX_TASKS];
+static uint32_t s_ulLastSwitch[TASK_PROF_MAX_TASKS];
+static uint32_t s_ulLastReady[TASK_PROF_MAX_TASKS];
+
+/* 控制台数字参数: s_ulCmdArg只在接收中断中读写，'p'/'r'命令把它交给本任务 */
+static uint32_t s_ulCmdArg = 0;
+static volatile uint32_t s_ulCalibLux = 0;
+static volatile uint32_t s_ulHistoryMin = 0;
+
+/* 'r'命令的查询结果 */
+static TSeries_Agg_TypeDef s_xHistory[TASK_PROF_HISTORY_MAX];
+
+#if (configUSE_TICKLESS_IDLE == 1)
+/* 上一窗口末的休眠驻留统计 */
+static AppPower_Stats_TypeDef s_xLastPower;
+#endif
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 任务状态转为单字符
+ */
+static char Task_Prof_StateChar(eTaskState state)
+{
+    switch (state)
+    {
+    case eRunning:
+        return 'X';
+    case eReady:
+        return 'R';
+    case eBlocked:
+        return 'B';
+    case eSuspended:
+        return 'S';
+    case eDeleted:
+        return 'D';
+    default:
+        return '?';
+    }
+}
+
+#if (configUSE_TICKLESS_IDLE == 1)
+/**
+ * @brief 输出本窗口的休眠驻留(L行)
+ *
+ * @param seq 窗口序号
+ * @param window 窗口长度(内核时钟周期)
+ */
+static void Task_Prof_PrintPower(uint32_t seq, uint64_t window)
+{
+    AppPower_Stats_TypeDef now;
+
+    AppPower_GetStats(&now);
+    if (window == 0)
+    {
+        window = 1;
+    }
+
+    printf("L,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+           (unsigned long)seq,
+           (unsigned long)(((now.sleep_cycles - s_xLastPower.sleep_cycles) * 1000U + window / 2U) / window),
+           (unsigned long)(((now.stop_cycles - s_xLastPower.stop_cycles) * 1000U + window / 2U) / window),
+           (unsigned long)(now.sleeps - s_xLastPower.sleeps),
+           (unsigned long)(now.stops - s_xLastPower.stops),
+           (unsigned long)(now.wakes - s_xLastPower.wakes),
+           (unsigned long)(now.early - s_xLastPower.early),
+           (unsigned long)(now.aborts - s_xLastPower.aborts));
+    s_xLastPower = now;
+}
+#endif
+
+/**
+ * @brief 采样RTOS堆并输出概要(H行)
+ *
+ * @param seq 窗口序号
+ * @param uptime_s 趋势样本时间戳(秒)
+ */
+static void Task_Prof_PrintHeap(uint32_t seq, uint32_t uptime_s)
+{
+    AppHeap_Summary_TypeDef sum;
+
+    AppHeap_Sample(uptime_s, &sum);
+    printf("H,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+           (unsigned long)seq,
+           (unsigned long)sum.free,
+           (unsigned long)sum.min_free,
+           (unsigned long)sum.largest,
+           (unsigned long)sum.free_blocks,
+           (unsigned long)sum.frag,
+           (unsigned long)sum.allocs,
+           (unsigned long)sum.fails);
+}
+
+/**
+ * @brief 以当前光照滤波值采集一个标定点
+ */
+static void Task_Prof_CalibPoint(void)
+{
+    SensorData_TypeDef data;
+    uint32_t lux = s_ulCalibLux;
+    int n;
+
+    AppData_GetSensorData(&data);
+    if (!data.light_valid)
+    {
+        printf("calib: no light data\r\n");
+        return;
+    }
+    n = AppCalib_CaptureLight((uint16_t)data.light_adc, (int32_t)lux);
+    if (n < 0)
+    {
+        printf("calib: table full (%d points)\r\n", LUT_MAX_POINTS);
+        return;
+    }
+    printf("calib: point %d adc %lu lux %lu\r\n", n, (unsigned long)data.light_adc,
+           (unsigned long)lux);
+}
+
+/**
+ * @brief 将暂存的标定点写入Flash
+ */
+static void Task_Prof_CalibSave(void)
+{
+    int n = AppCalib_CommitLight();
+
+    if (n < 0)
+    {
+        printf("calib: save failed (need >= 2 points with increasing adc)\r\n");
+        return;
+    }
+    printf("calib: saved %d points\r\n", n);
+}
+
+/**
+ * @brief 输出各通道最近若干分钟的分钟桶与丢弃样本数
+ */
+static void Task_Prof_PrintHistory(void)
+{
+    uint32_t minutes = (s_ulHistoryMin != 0) ? s_ulHistoryMin : TASK_PROF_HISTORY_MIN;
+    uint32_t now = AppHistory_Now();
+    uint32_t span = (minutes <= now / 60U) ? minutes * 60U : now;
+    uint16_t n;
+
+    for (uint32_t ch = 0; ch < APP_HISTORY_CHANNEL_NUM; ch++)
+    {
+        n = AppHistory_Query((AppHistory_Channel_t)ch, TSERIES_TIER_MINUTE, now - span, now,
+                             s_xHistory, TASK_PROF_HISTORY_MAX);
+        for (uint16_t i = 0; i < n; i++)
+        {
+            printf("hist: %lu,%lu,%ld,%ld,%ld,%lu\r\n",
+                   (unsigned long)ch,
+                   (unsigned long)s_xHistory[i].t,
+                   (long)s_xHistory[i].min,
+                   (long)s_xHistory[i].avg,
+                   (long)s_xHistory[i].max,
+                   (unsigned long)s_xHistory[i].count);
+        }
+    }
+    printf("hist: dropped %lu,%lu,%lu\r\n",
+           (unsigned long)AppHistory_GetDropped(APP_HISTORY_TEMPERATURE),
+           (unsigned long)AppHistory_GetDropped(APP_HISTORY_HUMIDITY),
+           (unsigned long)AppHistory_GetDropped(APP_HISTORY_LIGHT_LUX));
+}
+
+/**
+ * @brief 等待到下一个窗口，期间执行控制台命令
+ *
+ * @param pxLastWakeTime 上一窗口的起点，返回时前进一个窗口
+ */
+static void Task_Prof_WaitWindow(TickType_t *pxLastWakeTime)
+{
+    const TickType_t xPeriod = pdMS_TO_TICKS(TASK_PROF_PERIOD_MS);
+    TickType_t xElapsed;
+    uint32_t ulBits;
+
+    for (;;)
+    {
+        xElapsed = xTaskGetTickCount() - *pxLastWakeTime;
+        if (xElapsed >= xPeriod ||
+            xTaskNotifyWait(0, UINT32_MAX, &ulBits, xPeriod - xElapsed) != pdTRUE)
+        {
+            break;
+        }
+        if (ulBits & TASK_PROF_CMD_HEAP_DUMP)
+        {
+            AppHeap_Dump();
+        }
+        if (ulBits & TASK_PROF_CMD_CALIB_POINT)
+        {
+            Task_Prof_CalibPoint();
+        }
+        if (ulBits & TASK_PROF_CMD_CALIB_SAVE)
+        {
+            Task_Prof_CalibSave();
+        }
+        if (ulBits & TASK_PROF_CMD_CALIB_DISCARD)
+        {
+            AppCalib_DiscardLight();
+            printf("calib: discarded\r\n");
+        }
+        if (ulBits & TASK_PROF_CMD_HISTORY)
+        {
+            Task_Prof_PrintHistory();
+        }
+    }
+    *pxLastWakeTime += xPeriod;
+}
+
+/**
+ * @brief 输出各内存池等级的占用与失败统计(M行)
+ *
+ * @param seq 窗口序号
+ */
+static void Task_Prof_PrintPool(uint32_t seq)
+{
+    MemPool_Stats_TypeDef st;
+
+    for (uint32_t i = 0; i < APP_POOL_NUM; i++)
+    {
+        AppPool_GetStats((AppPool_Class_t)i, &st);
+        printf("M,%lu,%u,%u,%lu,%lu,%lu,%lu\r\n",
+               (unsigned long)seq,
+               (unsigned int)st.size,
+               (unsigned int)st.count,
+               (unsigned long)st.used,
+               (unsigned long)st.high_water,
+               (unsigned long)st.fails,
+               (unsigned long)st.errors);
+    }
+}
+
+/**
+ * @brief 输出各通道采样到显示的累计延迟(D行)
+ *
+ * @param seq 窗口序号
+ */
+static void Task_Prof_PrintLatency(uint32_t seq)
+{
+    AppData_Latency_TypeDef lat;
+
+    for (uint32_t ch = 0; ch < APP_DATA_CH_NUM; ch++)
+    {
+        AppData_GetLatency((AppData_Channel_t)ch, &lat);
+        printf("D,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+               (unsigned long)seq,
+               (unsigned long)ch,
+               (unsigned long)lat.count,
+               (unsigned long)lat.min_us,
+               (unsigned long)lat.avg_us,
+               (unsigned long)lat.max_us,
+               (unsigned long)lat.missed);
+    }
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+MEM_FASTCODE void Task_Prof_SwitchedIn(UBaseType_t number)
+{
+    if (number < TASK_PROF_MAX_TASKS)
+    {
+        s_ulSwitchCount[number]++;
+    }
+}
+
+MEM_FASTCODE void Task_Prof_MadeReady(UBaseType_t number)
+{
+    if (number < TASK_PROF_MAX_TASKS)
+    {
+        s_ulReadyCount[number]++;
+    }
+}
+
+void Task_Prof_CommandFromISR(uint8_t c, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    uint32_t bits = 0;
+
+    /* 数字累积为后一个命令的参数(饱和，不回绕) */
+    if (c >= '0' && c <= '9')
+    {
+        if (s_ulCmdArg <= (UINT32_MAX - 9U) / 10U)
+        {
+            s_ulCmdArg = s_ulCmdArg * 10U + (uint32_t)(c - '0');
+        }
+        return;
+    }
+
+    switch (c)
+    {
+    case 'h':
+    case 'H':
+        bits = TASK_PROF_CMD_HEAP_DUMP;
+        break;
+    case 'p':
+    case 'P':
+        s_ulCalibLux = s_ulCmdArg;
+        bits = TASK_PROF_CMD_CALIB_POINT;
+        break;
+    case 'w':
+    case 'W':
+        bits = TASK_PROF_CMD_CALIB_SAVE;
+        break;
+    case 'x':
+    case 'X':
+        bits = TASK_PROF_CMD_CALIB_DISCARD;
+        break;
+    case 'r':
+    case 'R':
+        s_ulHistoryMin = s_ulCmdArg;
+        bits = TASK_PROF_CMD_HISTORY;
+        break;
+    default:
+        break;
+    }
+    s_ulCmdArg = 0;
+
+    /* 任务创建前(调度器未启动)收到的字符直接丢弃 */
+    if (bits != 0 && Task_Prof_Handle != NULL)
+    {
+        xTaskNotifyFromISR(Task_Prof_Handle, bits, eSetBits, pxHigherPriorityTaskWoken);
+    }
+}
+
+/**
+ * @brief 剖析任务函数
+ * @author Yukikaze
+ *
+ * @param pvParameters 任务参数(未使用)
+ *
+ * @note 任务执行流程:
+ *       1. 等待一个统计窗口(期间响应串口控制台命令)
+ *       2. 获取全部任务状态快照与运行时间计数
+ *       3. 与上一窗口做差，按CSV输出每个任务的占用率(千分比)、栈余量和切入次数
+ *       4. 把占用率与栈余量交给任务注册表核对预算(app_task)
+ */
+void Task_Prof(void *pvParameters)
+{
+    TickType_t xLastWakeTime;
+    uint32_t total;
+    uint32_t last_total;
+    uint32_t window;
+    uint64_t now_cycles;
+    uint64_t last_cycles;
+    uint64_t now_us;
+    uint64_t last_us;
+    uint32_t seq = 0;
+    UBaseType_t count;
+    uint32_t idle;
+    uint32_t from_hz;
+    uint8_t boot_reported = 0;
+
+    /* 避免编译器警告 */
+    (void)pvParameters;
+
+    /* 以启动时刻的累计值作为第一个窗口的起点 */
+    count = uxTaskGetSystemState(s_xStatus, TASK_PROF_MAX_TASKS, &last_total);
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        if (s_xStatus[i].xTaskNumber < TASK_PROF_MAX_TASKS)
+        {
+            s_ulLastRunTime[s_xStatus[i].xTaskNumber] = s_xStatus[i].ulRunTimeCounter;
+            s_ulLastSwitch[s_xStatus[i].xTaskNumber] = s_ulSwitchCount[s_xStatus[i].xTaskNumber];
+            s_ulLastReady[s_xStatus[i].xTaskNumber] = s_ulReadyCount[s_xStatus[i].xTaskNumber];
+        }
+    }
+    last_cycles = CPU_TS_Read64();
+    last_us = CPU_TS_ToUs(last_cycles);
+#if (configUSE_TICKLESS_IDLE == 1)
+    AppPower_GetStats(&s_xLastPower);
+#endif
+    xLastWakeTime = xTaskGetTickCount();
+
+    for (;;)
+    {
+        Task_Prof_WaitWindow(&xLastWakeTime);
+
+        count = uxTaskGetSystemState(s_xStatus, TASK_PROF_MAX_TASKS, &total);
+        now_cycles = CPU_TS_Read64();
+
+        /* 32位计数器按模做差，窗口小于一个回绕周期即正确 */
+        window = total - last_total;
+        last_total = total;
+        if (window == 0)
+        {
+            continue;
+        }
+
+        now_us = CPU_TS_ToUs(now_cycles);
+        printf("P,%lu,%lu,%lu,%u\r\n",
+               (unsigned long)seq,
+               (unsigned long)(now_us / 1000U),
+               (unsigned long)(now_us - last_us),
+               (unsigned int)count);
+#if (configUSE_TICKLESS_IDLE == 1)
+        Task_Prof_PrintPower(seq, now_cycles - last_cycles);
+#endif
+        Task_Prof_PrintHeap(seq, (uint32_t)(now_us / 1000000U));
+        Task_Prof_PrintPool(seq);
+        Task_Prof_PrintLatency(seq);
+        last_cycles = now_cycles;
+        last_us = now_us;
+        idle = 0;
+
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            const TaskStatus_t *st = &s_xStatus[i];
+            UBaseType_t num = st->xTaskNumber;
+            uint32_t run = 0;
+            uint32_t sw = 0;
+            uint32_t wk = 0;
+            uint32_t cpu;
+
+            if (num < TASK_PROF_MAX_TASKS)
+            {
+                run = st->ulRunTimeCounter - s_ulLastRunTime[num];
+                sw = s_ulSwitchCount[num] - s_ulLastSwitch[num];
+                s_ulLastRunTime[num] = st->ulRunTimeCounter;
+                s_ulLastSwitch[num] += sw;
+                wk = s_ulReadyCount[num] - s_ulLastReady[num];
+                s_ulLastReady[num] += wk;
+            }
+            cpu = (uint32_t)(((uint64_t)run * 1000U + window / 2U) / window);
+
+            printf("T,%lu,%s,%c,%u,%lu,%u,%lu,%lu\r\n",
+                   (unsigned long)seq,
+                   st->pcTaskName,
+                   Task_Prof_StateChar(st->eCurrentState),
+                   (unsigned int)st->uxCurrentPriority,
+                   (unsigned long)cpu,
+                   (unsigned int)st->usStackHighWaterMark,
+                   (unsigned long)sw,
+                   (unsigned long)wk);
+            /* 预算按最高档频率给出，降档后的占用率折算回去再核对 */
+            AppTask_Sample(st->xHandle, AppClock_ScaleLoad(cpu), st->usStackHighWaterMark);
+            if (st->xHandle == xTaskGetIdleTaskHandle())
+            {
+                idle = cpu;
+            }
+        }
+        AppTask_Audit();
+
+        /* 启动工作任务全部结束后输出一次启动时间线 */
+        if (!boot_reported && AppBoot_Done())
+        {
+            AppBoot_Report();
+            boot_reported = 1;
+        }
+
+        /* 启动阶段(含LSE起振、日志挂载)完成后才开始调频 */
+        if (boot_reported)
+        {
+            from_hz = SystemCoreClock;
+            if (AppClock_Govern(idle) != 0)
+            {
+                printf("C,%lu,%lu,%lu,%lu\r\n",
+                       (unsigned long)seq,
+                       (unsigned long)from_hz,
+                       (unsigned long)SystemCoreClock,
+                       (unsigned long)idle);
+            }
+        }
+
+        seq++;
+    }
+}
@@ -7,7 +7,7 @@
  * @note 本任务周期性读取DHT11传感器的温湿度数据
  *       采集周期: 2秒
  *       任务优先级: 2 (低优先级)
- *       LED指示: LED1(红色) 运行时点亮
+ *       LED指示: LED1(红色) 每次采集点亮300毫秒(定时器熄灭)
  */
 
 #ifndef __TASK_TEMPHUM_H
@@ -25,6 +25,10 @@
 #define TASK_TEMPHUM_STACK_SIZE 512      /**< 任务栈大小(字) */
 #define TASK_TEMPHUM_PRIORITY 2          /**< 任务优先级(低) */
 #define TASK_TEMPHUM_PERIOD_MS 2000      /**< 采集周期(毫秒) */
+#define TASK_TEMPHUM_MEDIAN_LEN 3        /**< 中值滤波点数 */
+#define TASK_TEMPHUM_MA_LEN 4            /**< 滑动平均窗口(2的幂) */
+#define TASK_TEMPHUM_LED_MS 300          /**< LED1指示时长(毫秒) */
+#define TASK_TEMPHUM_POWERUP_MS 1000     /**< DHT11上电稳定时间(毫秒，数据手册要求，此前不响应起始信号) */
 
 /**
  * ============================================================================
@@ -48,21 +52,11 @@ extern TaskHandle_t Task_TempHum_Handle;
  * @param pvParameters 任务参数(未使用)
  *
  * @note 任务执行流程:
- *       1. 点亮LED1(红色)指示任务运行
+ *       1. 点亮LED1(红色)指示任务运行，由定时器到时熄灭
  *       2. 读取DHT11温湿度数据
  *       3. 更新共享数据结构
- *       4. 通过串口打印调试信息
- *       5. 熄灭LED1
- *       6. 延时等待下一周期
+ *       4. 等待周期定时器通知
  */
 void Task_TempHum(void *pvParameters);
 
-/**
- * @brief 创建温湿度采集任务
- * @author Yukikaze
- *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
- */
-BaseType_t Task_TempHum_Create(void);
-
 #endif /* __TASK_TEMPHUM_H */
@@ -6,13 +6,19 @@
  *
  * @note 本任务周期性(2秒)读取DHT11传感器的温湿度数据
  *       读取成功后更新共享数据结构供显示任务使用
- *       任务运行时点亮LED1(红色)作为指示
+ *       周期由软件定时器通知触发，LED1(红色)指示脉冲由定时器熄灭，任务不为指示而阻塞
  */
 
 #include "task_temphum.h"
+#include "app_boot.h"
 #include "app_data.h"
+#include "app_task.h"
+#include "app_timer.h"
 #include "bsp_dht11.h"
 #include "bsp_led.h"
+#include "core_delay.h"
+#include "filter.h"
+#include "mem_section.h"
 #include <stdio.h>
 
 /**
@@ -24,6 +30,16 @@
 /* 任务句柄 */
 TaskHandle_t Task_TempHum_Handle = NULL;
 
+/* 温湿度滤波链: 各自中值(剔除单帧错误) -> 双通道滑动平均(状态放在CCMRAM) */
+static MEM_PLACE_FILTER Filter_Median_TypeDef s_xTempMedian;
+static MEM_PLACE_FILTER Filter_Median_TypeDef s_xHumiMedian;
+static MEM_PLACE_FILTER Filter_MA2_TypeDef s_xTempHumMA;
+
+#if (APP_POLLING_BASELINE == 0)
+/* 采集周期定时器 */
+static AppTimer_TypeDef s_xPeriodTimer;
+#endif
+
 /**
  * ============================================================================
  * 函数实现
@@ -36,42 +52,73 @@ TaskHandle_t Task_TempHum_Handle = NULL;
  *
  * @param pvParameters 任务参数(未使用)
  *
+ * @note 启动后先等到DHT11上电满TASK_TEMPHUM_POWERUP_MS(以DWT启动时间计，
+ *       启动已经超过时不再等待)
+ *
  * @note 任务执行流程:
- *       1. 点亮LED1(红色)指示任务运行
- *       2. 读取DHT11温湿度数据
- *       3. 更新共享数据结构
- *       4. 通过串口打印调试信息
- *       5. 熄灭LED1
- *       6. 延时等待下一周期(2秒)
+ *       1. 点亮LED1(红色)指示任务运行(300毫秒后由定时器熄灭)
+ *       2. 读取DHT11温湿度数据，经中值+滑动平均滤波
+ *       3. 更新共享数据结构(同时发布到数据总线，显示任务被通知)
+ *       4. 等待周期定时器通知(2秒)
+ *
+ * @note 轮询基准构建(APP_POLLING_BASELINE，见app_task.h)恢复原来的循环:
+ *       LED1用vTaskDelay保持300毫秒后熄灭，再vTaskDelayUntil到下一周期，每周期唤醒两次
  */
 void Task_TempHum(void *pvParameters)
 {
     DHT11_Data_TypeDef dht11_data;
     uint8_t read_result;
+    uint32_t filtered;
+    uint32_t uptime_ms;
+#if (APP_POLLING_BASELINE == 1)
     TickType_t xLastWakeTime;
-    const TickType_t xPeriod = pdMS_TO_TICKS(TASK_TEMPHUM_PERIOD_MS);
+#endif
 
     /* 避免编译器警告 */
     (void)pvParameters;
 
-    /* 初始化上次唤醒时间 */
+    /* DHT11上电稳定之前不响应起始信号，只等待剩余的部分 */
+    uptime_ms = (uint32_t)(CPU_TS_ToUs(CPU_TS_Read64()) / 1000U);
+    if (uptime_ms < TASK_TEMPHUM_POWERUP_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TASK_TEMPHUM_POWERUP_MS - uptime_ms));
+    }
+
+    /* 初始化温湿度滤波链 */
+    Filter_Median_Init(&s_xTempMedian, TASK_TEMPHUM_MEDIAN_LEN);
+    Filter_Median_Init(&s_xHumiMedian, TASK_TEMPHUM_MEDIAN_LEN);
+    Filter_MA2_Init(&s_xTempHumMA, TASK_TEMPHUM_MA_LEN);
+
+#if (APP_POLLING_BASELINE == 1)
     xLastWakeTime = xTaskGetTickCount();
+#else
+    /* 启动周期定时器(到期通知本任务，周期不受采集耗时影响) */
+    AppTimer_StartNotify(&s_xPeriodTimer, Task_TempHum_Handle, TASK_TEMPHUM_PERIOD_MS);
+#endif
 
     /* 任务主循环 */
     for (;;)
     {
-        /* 点亮LED1(红色)指示任务正在运行 */
+#if (APP_POLLING_BASELINE == 1)
         LED1_ON;
+#else
+        /* 点亮LED1(红色)指示任务正在运行，由定时器到时熄灭 */
+        AppTimer_LedPulse(APP_TIMER_LED1, TASK_TEMPHUM_LED_MS);
+#endif
 
         /* 读取DHT11温湿度数据 */
         read_result = Read_DHT11(&dht11_data);
 
         if (read_result == 1)
         {
-            /* 读取成功，更新共享数据 */
-            AppData_UpdateTempHum(dht11_data.temp_int,
-                                  dht11_data.humi_int,
+            /* 读取成功，温度/湿度打包进入双通道滑动平均后更新共享数据 */
+            filtered = Filter_MA2_Update(&s_xTempHumMA,
+                                         FILTER_PACK16(Filter_Median_Update(&s_xTempMedian, dht11_data.temp_int),
+                                                       Filter_Median_Update(&s_xHumiMedian, dht11_data.humi_int)));
+            AppData_UpdateTempHum((uint8_t)FILTER_LO16(filtered),
+                                  (uint8_t)FILTER_HI16(filtered),
                                   1);
+            AppBoot_Mark("temphum");
         }
         else
         {
@@ -79,37 +126,14 @@ void Task_TempHum(void *pvParameters)
             AppData_UpdateTempHum(0, 0, 0);
         }
 
-        /* 保持LED点亮300ms */
-        vTaskDelay(pdMS_TO_TICKS(300));
-
-        /* 熄灭LED1 */
+#if (APP_POLLING_BASELINE == 1)
+        /* 保持LED点亮，熄灭后延时到下一个周期 */
+        vTaskDelay(pdMS_TO_TICKS(TASK_TEMPHUM_LED_MS));
         LED1_OFF;
-
-        /* 精确延时到下一个周期（2秒）*/
-        vTaskDelayUntil(&xLastWakeTime, xPeriod);
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(TASK_TEMPHUM_PERIOD_MS));
+#else
+        /* 周期定时只负责启动下一次采集，数据经总线通知显示任务 */
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
     }
 }
-
-/**
- * @brief 创建温湿度采集任务
- * @author Yukikaze
- *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
- *
- * @note 使用xTaskCreate创建任务
- *       任务栈大小: 256字
- *       任务优先级: 2
- */
-BaseType_t Task_TempHum_Create(void)
-{
-    BaseType_t xReturn;
-
-    xReturn = xTaskCreate((TaskFunction_t)Task_TempHum,
-                          (const char *)TASK_TEMPHUM_NAME,
-                          (uint16_t)TASK_TEMPHUM_STACK_SIZE,
-                          (void *)NULL,
-                          (UBaseType_t)TASK_TEMPHUM_PRIORITY,
-                          (TaskHandle_t *)&Task_TempHum_Handle);
-
-    return xReturn;
-}
@@ -41,12 +41,4 @@ extern TaskHandle_t Task_Test_Handle;
  */
 void Task_Test(void *pvParameters);
 
-/**
- * @brief 创建心跳测试任务
- * @author Yukikaze
- *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
- */
-BaseType_t Task_Test_Create(void);
-
 #endif /* __TASK_TEST_H */
\ No newline at end of file
@@ -46,27 +46,3 @@ void Task_Test(void *pvParameters)
         vTaskDelay(pdMS_TO_TICKS(500));
     }
 }
-
-/**
- * @brief 创建心跳测试任务
- * @author Yukikaze
- *
- * @return BaseType_t 创建结果(pdPASS=成功, pdFAIL=失败)
- *
- * @note 使用xTaskCreate创建任务
- *       任务栈大小: 256字(最小心跳任务，栈需求很小)
- *       任务优先级: 1(低优先级，不干扰其他任务)
- */
-BaseType_t Task_Test_Create(void)
-{
-    BaseType_t xReturn;
-
-    xReturn = xTaskCreate((TaskFunction_t)Task_Test,
-                          (const char *)TASK_TEST_NAME,
-                          (uint16_t)TASK_TEST_STACK_SIZE,
-                          (void *)NULL,
-                          (UBaseType_t)TASK_TEST_PRIORITY,
-                          (TaskHandle_t *)&Task_Test_Handle);
-
-    return xReturn;
-}
\ No newline at end of file
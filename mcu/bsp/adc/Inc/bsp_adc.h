@@ -4,6 +4,7 @@
 
 #include "stm32f4xx.h"
 #include "stm32f4xx_conf.h"
+#include "filter.h"
 
 
 // ADC ѡ
@@ -31,7 +32,24 @@
 #define    PhotoResistor_PORT                      GPIOG
 #define    PhotoResistor_PIN                       GPIO_Pin_3
 
+// ADC ȡ˲(CIC)EOCжÿ ADC_CIC_DECIM һ
+// 12λ + *log2(ȡ) ó32λ
+#define    ADC_CIC_ORDER                 3
+#define    ADC_CIC_DECIM                 16
+
+// ڲοѹVREFINTעͨϹͨת
+// ʱ10us(ADCCLK=22.5MHzʱ480Լ21us)
+#define    ADC_VREFINT_CHANNEL           ADC_Channel_Vrefint
+#define    ADC_VREFINT_SAMPLE_TIME       ADC_SampleTime_480Cycles
+#define    ADC_VREFINT_TIMEOUT           10000
+
+extern __IO uint16_t ADC_ConvertedValue;
+extern Filter_CIC_TypeDef ADC_LightCIC;
+
 void PhotoResistor_Init(void);
+void PhotoResistor_AWD_Arm(uint16_t low, uint16_t high);
+void PhotoResistor_AWD_Disarm(void);
+uint16_t PhotoResistor_ReadVrefint(void);
 
 
 #endif /* __BSP_PHOTORESISTOR_H */
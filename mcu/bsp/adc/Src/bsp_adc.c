@@ -13,6 +13,9 @@
 
 __IO uint16_t ADC_ConvertedValue;
 
+/* ADCCICȡ˲ADCжʹ */
+Filter_CIC_TypeDef ADC_LightCIC;
+
 /**
  * @brief  GPIO
  * @param  
@@ -88,6 +91,12 @@ static void PhotoResistor_ADC_Mode_Config(void)
     ADC_RegularChannelConfig(ADCx, ADC_CHANNEL, 1, ADC_SampleTime_56Cycles);
     // ADC תжϣжϷжȡתֵ
     ADC_ITConfig(ADCx, ADC_IT_EOC, ENABLE);
+
+    // עͨVREFINTڵԴѹ
+    ADC_TempSensorVrefintCmd(ENABLE);
+    ADC_InjectedSequencerLengthConfig(ADCx, 1);
+    ADC_InjectedChannelConfig(ADCx, ADC_VREFINT_CHANNEL, 1, ADC_VREFINT_SAMPLE_TIME);
+    ADC_ExternalTrigInjectedConvEdgeConfig(ADCx, ADC_ExternalTrigInjecConvEdge_None);
     // ʹADC
     ADC_Cmd(ADCx, ENABLE);
     // ʼadcת
@@ -119,9 +128,65 @@ static void PhotoResistor_ADC_NVIC_Config(void)
  */
 void PhotoResistor_Init(void)
 {
+    // ADCʼתǰɣжֱʹ˲״̬
+    Filter_CIC_Init(&ADC_LightCIC, ADC_CIC_ORDER, ADC_CIC_DECIM);
     PhotoResistor_GPIO_Config();
     PhotoResistor_ADC_Mode_Config();
     PhotoResistor_ADC_NVIC_Config();
 }
 
+/**
+ * @brief  ģ⿴Źתֵ [low, high] ʱ ADC_IT_AWD ж
+ * @param  low  ֵ(12λ)
+ * @param  high ֵ(12λ)
+ * @retval 
+ * @note   ŹȽϵÿһԭʼתֵ(CIC˲֮ǰ)
+ *         жϴжϷرAWDжϣȷϺ²
+ */
+void PhotoResistor_AWD_Arm(uint16_t low, uint16_t high)
+{
+    ADC_AnalogWatchdogThresholdsConfig(ADCx, high, low);
+    ADC_AnalogWatchdogSingleChannelConfig(ADCx, ADC_CHANNEL);
+    ADC_AnalogWatchdogCmd(ADCx, ADC_AnalogWatchdog_SingleRegEnable);
+    ADC_ClearITPendingBit(ADCx, ADC_IT_AWD);
+    ADC_ITConfig(ADCx, ADC_IT_AWD, ENABLE);
+}
+
+/**
+ * @brief  ģ⿴Ź
+ * @param  
+ * @retval 
+ * @note   же
+ */
+void PhotoResistor_AWD_Disarm(void)
+{
+    ADC_ITConfig(ADCx, ADC_IT_AWD, DISABLE);
+    ADC_ClearITPendingBit(ADCx, ADC_IT_AWD);
+}
+
+/**
+ * @brief  ȡһڲοѹVREFINTתֵ
+ * @param  
+ * @retval VREFINTתֵ(12λ)ʱ0
+ * @note   עתͣͨɺתԶ
+ *         ѯȴԼ30usֻе
+ */
+uint16_t PhotoResistor_ReadVrefint(void)
+{
+    uint32_t timeout = ADC_VREFINT_TIMEOUT;
+
+    ADC_ClearFlag(ADCx, ADC_FLAG_JEOC);
+    ADC_SoftwareStartInjectedConv(ADCx);
+    while (ADC_GetFlagStatus(ADCx, ADC_FLAG_JEOC) == RESET)
+    {
+        if (--timeout == 0)
+        {
+            return 0;
+        }
+    }
+    ADC_ClearFlag(ADCx, ADC_FLAG_JEOC);
+
+    return ADC_GetInjectedConversionValue(ADCx, ADC_InjectedChannel_1);
+}
+
 /*********************************************END OF FILE**********************/
@@ -0,0 +1,95 @@
+/**
+ * @file bsp_clock.h
+ * @brief 系统时钟(HSE/HSI + 主PLL)配置与运行时切换驱动头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note PLL输入优先使用HSE(25MHz)，起振失败时退回HSI(16MHz)，不再停在启动阶段
+ *       切换流程(参考手册RM0090 5.1.4/6.3.2):
+ *       1. 系统时钟先切到HSI，关闭PLL与不再需要的过驱动
+ *       2. 设置调压器等级(只能在PLL关闭时修改)，按新参数锁定PLL
+ *       3. 需要时开启过驱动(>168MHz)，设置Flash等待周期与APB分频
+ *       4. 切到PLL并更新SystemCoreClock
+ *       所有等待都有轮询上限(DWT可能尚未初始化)，PLL或过驱动失败时停留在HSI
+ *       本驱动只负责时钟树；节拍、波特率等依赖频率的外设由调用方重新计算(见app_clock.h)
+ */
+
+#ifndef __BSP_CLOCK_H
+#define __BSP_CLOCK_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+#include "pll.h"
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define BSP_CLOCK_WAIT_LOOPS 0x10000UL /**< PLL锁定/过驱动/时钟切换的轮询上限(HSI下约数毫秒) */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief PLL输入时钟源
+ */
+typedef enum
+{
+    BSP_CLOCK_SRC_HSI = 0, /**< 内部16MHz RC(精度约1%) */
+    BSP_CLOCK_SRC_HSE = 1, /**< 外部25MHz晶振 */
+} BSP_Clock_Src_t;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 复位时钟树并选择PLL输入时钟源
+ * @author Yukikaze
+ *
+ * @return int 0=HSE, 1=HSE起振失败，使用HSI
+ *
+ * @note 返回后系统时钟仍为HSI，由BSP_Clock_Apply切到PLL；同时打开Flash预取与缓存
+ */
+int BSP_Clock_Init(void);
+
+/**
+ * @brief PLL输入时钟源
+ * @author Yukikaze
+ */
+BSP_Clock_Src_t BSP_Clock_Src(void);
+
+/**
+ * @brief PLL输入时钟频率(Hz)
+ * @author Yukikaze
+ */
+uint32_t BSP_Clock_SrcHz(void);
+
+/**
+ * @brief 按配置切换系统时钟
+ * @author Yukikaze
+ *
+ * @param cfg PLL与总线配置(由Pll_Solve求出)
+ * @return int 0=成功, -1=PLL或过驱动未就绪(系统时钟停留在HSI)
+ *
+ * @note 切换期间内核先运行在HSI，需在关中断下调用；返回前更新SystemCoreClock
+ */
+int BSP_Clock_Apply(const Pll_Config_TypeDef *cfg);
+
+/**
+ * @brief STOP唤醒后恢复当前配置(HSE、PLL与过驱动)
+ * @author Yukikaze
+ *
+ * @return int 0=成功, -1=恢复失败(停留在HSI，SystemCoreClock已更新)
+ *
+ * @note PLL参数与调压器等级在STOP期间保持，HSE、PLL与过驱动需要重新打开
+ */
+int BSP_Clock_Restore(void);
+
+#endif /* __BSP_CLOCK_H */
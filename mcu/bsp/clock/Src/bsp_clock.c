@@ -0,0 +1,262 @@
+/**
+ * @file bsp_clock.c
+ * @brief 系统时钟(HSE/HSI + 主PLL)配置与运行时切换驱动实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "bsp_clock.h"
+
+/* PLL输入时钟源 */
+static BSP_Clock_Src_t s_eSrc = BSP_CLOCK_SRC_HSI;
+
+/* 当前生效的配置(s_ucPllActive=0时系统时钟为HSI) */
+static Pll_Config_TypeDef s_xActive;
+static uint8_t s_ucPllActive = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 等待RCC标志变为指定状态
+ */
+static int BSP_Clock_WaitRcc(uint8_t flag, FlagStatus state)
+{
+    for (uint32_t i = 0; i < BSP_CLOCK_WAIT_LOOPS; i++)
+    {
+        if (RCC_GetFlagStatus(flag) == state)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 等待PWR标志置位
+ */
+static int BSP_Clock_WaitPwr(uint32_t flag)
+{
+    for (uint32_t i = 0; i < BSP_CLOCK_WAIT_LOOPS; i++)
+    {
+        if (PWR_GetFlagStatus(flag) != RESET)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 切换系统时钟源并等待SWS确认
+ *
+ * @param source RCC_SYSCLKSource_x
+ */
+static int BSP_Clock_Switch(uint32_t source)
+{
+    RCC_SYSCLKConfig(source);
+    for (uint32_t i = 0; i < BSP_CLOCK_WAIT_LOOPS; i++)
+    {
+        /* SWS位段(CFGR[3:2])与SW位段(CFGR[1:0])编码相同 */
+        if (RCC_GetSYSCLKSource() == (uint8_t)(source << 2))
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 开启过驱动(先ODEN等待ODRDY，再ODSWEN等待ODSWRDY)
+ */
+static int BSP_Clock_OverDriveOn(void)
+{
+    PWR_OverDriveCmd(ENABLE);
+    if (BSP_Clock_WaitPwr(PWR_FLAG_ODRDY) != 0)
+    {
+        return -1;
+    }
+    PWR_OverDriveSWCmd(ENABLE);
+    return BSP_Clock_WaitPwr(PWR_FLAG_ODSWRDY);
+}
+
+static void BSP_Clock_OverDriveOff(void)
+{
+    PWR_OverDriveSWCmd(DISABLE);
+    PWR_OverDriveCmd(DISABLE);
+}
+
+/**
+ * @brief 分频系数转为RCC_HCLK_Divx
+ */
+static uint32_t BSP_Clock_ApbDiv(uint8_t div)
+{
+    switch (div)
+    {
+    case 1:
+        return RCC_HCLK_Div1;
+    case 2:
+        return RCC_HCLK_Div2;
+    case 4:
+        return RCC_HCLK_Div4;
+    case 8:
+        return RCC_HCLK_Div8;
+    default:
+        return RCC_HCLK_Div16;
+    }
+}
+
+static uint32_t BSP_Clock_Vos(uint8_t vos)
+{
+    switch (vos)
+    {
+    case 1:
+        return PWR_Regulator_Voltage_Scale1;
+    case 2:
+        return PWR_Regulator_Voltage_Scale2;
+    default:
+        return PWR_Regulator_Voltage_Scale3;
+    }
+}
+
+/**
+ * @brief 回到HSI(PLL关闭，过驱动关闭)
+ */
+static void BSP_Clock_FallBack(void)
+{
+    (void)BSP_Clock_Switch(RCC_SYSCLKSource_HSI);
+    BSP_Clock_OverDriveOff();
+    RCC_PLLCmd(DISABLE);
+    RCC_PCLK1Config(RCC_HCLK_Div1);
+    RCC_PCLK2Config(RCC_HCLK_Div1);
+    s_ucPllActive = 0;
+    SystemCoreClockUpdate();
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int BSP_Clock_Init(void)
+{
+    RCC_DeInit();
+    s_ucPllActive = 0;
+
+    /* 调压器等级与过驱动在PWR中配置 */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
+
+    FLASH_PrefetchBufferCmd(ENABLE);
+    FLASH_InstructionCacheCmd(ENABLE);
+    FLASH_DataCacheCmd(ENABLE);
+
+    RCC_HSEConfig(RCC_HSE_ON);
+    if (RCC_WaitForHSEStartUp() == SUCCESS)
+    {
+        s_eSrc = BSP_CLOCK_SRC_HSE;
+    }
+    else
+    {
+        RCC_HSEConfig(RCC_HSE_OFF);
+        s_eSrc = BSP_CLOCK_SRC_HSI;
+    }
+
+    SystemCoreClockUpdate();
+    return (s_eSrc == BSP_CLOCK_SRC_HSE) ? 0 : 1;
+}
+
+BSP_Clock_Src_t BSP_Clock_Src(void)
+{
+    return s_eSrc;
+}
+
+uint32_t BSP_Clock_SrcHz(void)
+{
+    return (s_eSrc == BSP_CLOCK_SRC_HSE) ? HSE_VALUE : HSI_VALUE;
+}
+
+int BSP_Clock_Apply(const Pll_Config_TypeDef *cfg)
+{
+    /* 1. 离开PLL: HSI(16MHz)下任何等待周期与分频都合法 */
+    if (BSP_Clock_Switch(RCC_SYSCLKSource_HSI) != 0)
+    {
+        return -1;
+    }
+    RCC_HCLKConfig(RCC_SYSCLK_Div1);
+    if (!cfg->overdrive)
+    {
+        BSP_Clock_OverDriveOff();
+    }
+    RCC_PLLCmd(DISABLE);
+    s_ucPllActive = 0;
+    if (BSP_Clock_WaitRcc(RCC_FLAG_PLLRDY, RESET) != 0)
+    {
+        BSP_Clock_FallBack();
+        return -1;
+    }
+
+    /* 2. 调压器等级只能在PLL关闭时修改，PLL锁定后生效 */
+    PWR_MainRegulatorModeConfig(BSP_Clock_Vos(cfg->vos));
+    RCC_PLLConfig((s_eSrc == BSP_CLOCK_SRC_HSE) ? RCC_PLLSource_HSE : RCC_PLLSource_HSI,
+                  cfg->m, cfg->n, cfg->p, cfg->q);
+    RCC_PLLCmd(ENABLE);
+    if (BSP_Clock_WaitRcc(RCC_FLAG_PLLRDY, SET) != 0)
+    {
+        BSP_Clock_FallBack();
+        return -1;
+    }
+
+    /* 3. 过驱动须在切到PLL之前就绪 */
+    if (cfg->overdrive && BSP_Clock_OverDriveOn() != 0)
+    {
+        BSP_Clock_FallBack();
+        return -1;
+    }
+    FLASH_SetLatency(cfg->latency);
+    RCC_PCLK1Config(BSP_Clock_ApbDiv(cfg->apb1_div));
+    RCC_PCLK2Config(BSP_Clock_ApbDiv(cfg->apb2_div));
+
+    /* 4. 切到PLL */
+    if (BSP_Clock_Switch(RCC_SYSCLKSource_PLLCLK) != 0)
+    {
+        BSP_Clock_FallBack();
+        return -1;
+    }
+
+    s_xActive = *cfg;
+    s_ucPllActive = 1;
+    SystemCoreClockUpdate();
+    return 0;
+}
+
+int BSP_Clock_Restore(void)
+{
+    if (!s_ucPllActive)
+    {
+        return 0;
+    }
+
+    if (s_eSrc == BSP_CLOCK_SRC_HSE)
+    {
+        RCC_HSEConfig(RCC_HSE_ON);
+        if (BSP_Clock_WaitRcc(RCC_FLAG_HSERDY, SET) != 0)
+        {
+            BSP_Clock_FallBack();
+            return -1;
+        }
+    }
+
+    RCC_PLLCmd(ENABLE);
+    if (BSP_Clock_WaitRcc(RCC_FLAG_PLLRDY, SET) != 0 ||
+        (s_xActive.overdrive && BSP_Clock_OverDriveOn() != 0) ||
+        BSP_Clock_Switch(RCC_SYSCLKSource_PLLCLK) != 0)
+    {
+        BSP_Clock_FallBack();
+        return -1;
+    }
+    return 0;
+}
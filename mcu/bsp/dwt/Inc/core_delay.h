@@ -32,7 +32,8 @@
    这样每次调用函数都会初始化一遍。
    把本宏值设置为0，然后在main函数刚运行时调用CPU_TS_TmrInit可避免每次都初始化 */  
 
-#define CPU_TS_INIT_IN_DELAY_FUNCTION   1
+/* 64位时间戳依赖CYCCNT连续计数，不能在延时函数中清零，改为在BSP_Init中初始化一次 */
+#define CPU_TS_INIT_IN_DELAY_FUNCTION   0
 
 
 /*******************************************************************************
@@ -40,6 +41,11 @@
  ******************************************************************************/
 uint32_t CPU_TS_TmrRd(void);
 void CPU_TS_TmrInit(void);
+uint64_t CPU_TS_Read64(void);
+void CPU_TS_Advance(uint32_t cycles);
+/* 运行时调频: 切换后记录新频率；时间戳按所在频率段换算为微秒 */
+void CPU_TS_ClockChanged(uint32_t hz);
+uint64_t CPU_TS_ToUs(uint64_t ts);
 
 //使用以下函数前必须先调用CPU_TS_TmrInit函数使能计数器，或使能宏CPU_TS_INIT_IN_DELAY_FUNCTION
 //最大延时值为60秒
@@ -10,6 +10,7 @@
  */
   
 #include "core_delay.h"   
+#include "mem_section.h"
 
 /*
 **********************************************************************
@@ -40,6 +41,25 @@
 #define  DEM_CR_TRCENA                   (1 << 24)
 #define  DWT_CR_CYCCNTENA                (1 <<  0)
 
+/* 64λʱչ32λԼϴζĵ32λ */
+static uint32_t s_ulTsHigh = 0;
+static uint32_t s_ulTsLast = 0;
+
+/* ƵʶΣʱƵʱڶεƵʻΪ΢
+ * ǰʱӦ΢ƵʣԼһεƵ */
+static uint64_t s_ullSegTs = 0;
+static uint64_t s_ullSegUs = 0;
+static uint32_t s_ulSegHz = 0;
+static uint32_t s_ulPrevHz = 0;
+
+/**
+  * @brief  ƵʻΪ΢(64λ)
+  */
+static uint64_t CPU_TS_CyclesToUs(uint64_t cycles, uint32_t hz)
+{
+  return cycles / hz * 1000000U + (cycles % hz) * 1000000U / hz;
+}
+
 
 /**
   * @brief  ʼʱ
@@ -57,6 +77,14 @@ void CPU_TS_TmrInit(void)
 
     /* ʹCortex-M DWT CYCCNTĴ */
     DWT_CR |= (uint32_t)DWT_CR_CYCCNTENA;
+
+    /* ʱԭ㣬ƵʶδӵǰƵʿʼ */
+    s_ulTsHigh = 0;
+    s_ulTsLast = 0;
+    s_ullSegTs = 0;
+    s_ullSegUs = 0;
+    s_ulSegHz = SystemCoreClock;
+    s_ulPrevHz = SystemCoreClock;
 }
 
 /**
@@ -64,11 +92,116 @@ void CPU_TS_TmrInit(void)
   * @param  
   * @retval ǰʱDWT_CYCCNTĴֵ
   */
-uint32_t CPU_TS_TmrRd(void)
+MEM_FASTCODE uint32_t CPU_TS_TmrRd(void)
 {        
   return ((uint32_t)DWT_CYCCNT);
 }
 
+/**
+  * @brief  ȡ64λʱ
+  * @param  
+  * @retval ʹںʱ
+  * @note   CYCCNTչ32λжоɵ
+  *         εüóһ(180MHzʱԼ23.8)
+  *         ϵͳĹԵñ֤
+  */
+MEM_FASTCODE uint64_t CPU_TS_Read64(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t now;
+  uint64_t ts;
+
+  __disable_irq();
+  now = (uint32_t)DWT_CYCCNT;
+  if (now < s_ulTsLast)
+  {
+    s_ulTsHigh++;
+  }
+  s_ulTsLast = now;
+  ts = ((uint64_t)s_ulTsHigh << 32) | now;
+  __set_PRIMASK(primask);
+
+  return ts;
+}
+
+/**
+  * @brief  ʱǰƽָ
+  * @param  cycles : ƽںʱ
+  * @retval 
+  * @note   STOPģʽںʱֹͣCYCCNTѺɵ͹ģ
+  *         RTCõʱ룬ʹʱͳ64λʱ
+  *         ȰCPU_TS_Read64Ĺƣ޸CYCCNT
+  */
+void CPU_TS_Advance(uint32_t cycles)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t now;
+  uint32_t next;
+
+  __disable_irq();
+  now = (uint32_t)DWT_CYCCNT;
+  if (now < s_ulTsLast)
+  {
+    s_ulTsHigh++;
+  }
+  next = now + cycles;
+  if (next < now)
+  {
+    s_ulTsHigh++;
+  }
+  DWT_CYCCNT = next;
+  s_ulTsLast = next;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  ¼һϵͳʱл
+  * @param  hz : лںʱƵ
+  * @retval 
+  * @note   лɺ󡢹жڼ(app_clock)ǰʱ԰Ƶʻ
+  */
+void CPU_TS_ClockChanged(uint32_t hz)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint64_t now;
+
+  __disable_irq();
+  now = CPU_TS_Read64();
+  s_ullSegUs += CPU_TS_CyclesToUs(now - s_ullSegTs, s_ulSegHz);
+  s_ullSegTs = now;
+  s_ulPrevHz = s_ulSegHz;
+  s_ulSegHz = hz;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  64λʱΪ΢
+  * @param  ts : CPU_TS_Read64ķֵ
+  * @retval ʹ΢
+  * @note   ԽƵʱȸԻһлʱ
+  *         һεƵʻ(ֻһΣʱ)
+  */
+uint64_t CPU_TS_ToUs(uint64_t ts)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint64_t us;
+  uint64_t back;
+
+  __disable_irq();
+  if (ts >= s_ullSegTs)
+  {
+    us = s_ullSegUs + CPU_TS_CyclesToUs(ts - s_ullSegTs, s_ulSegHz);
+  }
+  else
+  {
+    back = CPU_TS_CyclesToUs(s_ullSegTs - ts, s_ulPrevHz);
+    us = (back < s_ullSegUs) ? (s_ullSegUs - back) : 0U;
+  }
+  __set_PRIMASK(primask);
+
+  return us;
+}
+
 ///**
 //  * @brief  ȡǰʱ
 //  * @param  
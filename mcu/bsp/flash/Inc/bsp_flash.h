@@ -0,0 +1,68 @@
+/**
+ * @file bsp_flash.h
+ * @brief 片内Flash擦写驱动头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 基于标准外设库 stm32f4xx_flash.c，面向 1MB 单Bank布局:
+ *       扇区0~3: 16KB, 扇区4: 64KB, 扇区5~11: 128KB
+ *       擦写期间CPU从Flash取指会被阻塞(擦除128KB扇区约1~2秒)，
+ *       只能在允许长时间停顿的低优先级上下文中调用
+ */
+
+#ifndef __BSP_FLASH_H
+#define __BSP_FLASH_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+/**
+ * ============================================================================
+ * 存储布局(需与链接脚本中FLASH区域长度保持一致)
+ * ============================================================================
+ */
+#define BSP_FLASH_BASE 0x08000000UL       /**< 片内Flash起始地址 */
+#define BSP_FLASH_SIZE (1024UL * 1024UL)  /**< 片内Flash容量 */
+#define BSP_FLASH_LOG_ADDR 0x08080000UL   /**< 扇区8~10: 传感器日志 */
+#define BSP_FLASH_LOG_SECTORS 3           /**< 日志扇区数 */
+#define BSP_FLASH_LOG_SECTOR_SIZE 0x20000UL
+#define BSP_FLASH_CALIB_ADDR 0x080E0000UL /**< 扇区11: 标定数据 */
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 查询地址所在扇区
+ * @author Yukikaze
+ *
+ * @param addr Flash地址
+ * @param base 输出扇区起始地址(可为NULL)
+ * @param size 输出扇区大小(可为NULL)
+ * @return int 扇区号(0~11)，地址非法返回-1
+ */
+int BSP_Flash_GetSector(uint32_t addr, uint32_t *base, uint32_t *size);
+
+/**
+ * @brief 擦除地址所在的整个扇区
+ * @author Yukikaze
+ *
+ * @param addr 扇区内任意地址
+ * @return int 0=成功, -1=失败
+ */
+int BSP_Flash_EraseSector(uint32_t addr);
+
+/**
+ * @brief 按字写入Flash
+ * @author Yukikaze
+ *
+ * @param addr 目标地址(4字节对齐，目标区域需已擦除)
+ * @param words 源数据
+ * @param count 字数
+ * @return int 0=成功, -1=失败
+ */
+int BSP_Flash_Program(uint32_t addr, const uint32_t *words, uint32_t count);
+
+#endif /* __BSP_FLASH_H */
@@ -0,0 +1,112 @@
+/**
+ * @file bsp_flash.c
+ * @brief 片内Flash擦写驱动实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "bsp_flash.h"
+#include <stddef.h>
+
+/* 所有可能残留的错误标志，每次操作前清除 */
+#define BSP_FLASH_ERR_FLAGS (FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | \
+                             FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR)
+
+/* 扇区号 -> 标准库扇区编码 */
+static const uint16_t s_usSectorCode[12] = {
+    FLASH_Sector_0, FLASH_Sector_1, FLASH_Sector_2, FLASH_Sector_3,
+    FLASH_Sector_4, FLASH_Sector_5, FLASH_Sector_6, FLASH_Sector_7,
+    FLASH_Sector_8, FLASH_Sector_9, FLASH_Sector_10, FLASH_Sector_11,
+};
+
+int BSP_Flash_GetSector(uint32_t addr, uint32_t *base, uint32_t *size)
+{
+    uint32_t offset;
+    uint32_t sec_base;
+    uint32_t sec_size;
+    int sector;
+
+    if (addr < BSP_FLASH_BASE || addr >= BSP_FLASH_BASE + BSP_FLASH_SIZE)
+    {
+        return -1;
+    }
+
+    offset = addr - BSP_FLASH_BASE;
+    if (offset < 0x10000UL)
+    {
+        /* 扇区0~3: 16KB */
+        sector = (int)(offset >> 14);
+        sec_base = BSP_FLASH_BASE + ((uint32_t)sector << 14);
+        sec_size = 0x4000UL;
+    }
+    else if (offset < 0x20000UL)
+    {
+        /* 扇区4: 64KB */
+        sector = 4;
+        sec_base = BSP_FLASH_BASE + 0x10000UL;
+        sec_size = 0x10000UL;
+    }
+    else
+    {
+        /* 扇区5~11: 128KB */
+        sector = 5 + (int)((offset - 0x20000UL) >> 17);
+        sec_base = BSP_FLASH_BASE + 0x20000UL + ((uint32_t)(sector - 5) << 17);
+        sec_size = 0x20000UL;
+    }
+
+    if (base != NULL)
+    {
+        *base = sec_base;
+    }
+    if (size != NULL)
+    {
+        *size = sec_size;
+    }
+    return sector;
+}
+
+int BSP_Flash_EraseSector(uint32_t addr)
+{
+    FLASH_Status status;
+    int sector = BSP_Flash_GetSector(addr, NULL, NULL);
+
+    if (sector < 0)
+    {
+        return -1;
+    }
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(BSP_FLASH_ERR_FLAGS);
+    /* 供电2.7~3.6V，按字(32位)并行度擦除 */
+    status = FLASH_EraseSector(s_usSectorCode[sector], VoltageRange_3);
+    FLASH_Lock();
+
+    /* 擦除后清除数据缓存，避免读到旧内容 */
+    FLASH_DataCacheCmd(DISABLE);
+    FLASH_DataCacheReset();
+    FLASH_DataCacheCmd(ENABLE);
+
+    return (status == FLASH_COMPLETE) ? 0 : -1;
+}
+
+int BSP_Flash_Program(uint32_t addr, const uint32_t *words, uint32_t count)
+{
+    FLASH_Status status = FLASH_COMPLETE;
+
+    if ((addr & 3U) != 0 || words == NULL ||
+        BSP_Flash_GetSector(addr, NULL, NULL) < 0 ||
+        BSP_Flash_GetSector(addr + count * 4U - 1U, NULL, NULL) < 0)
+    {
+        return -1;
+    }
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(BSP_FLASH_ERR_FLAGS);
+    for (uint32_t i = 0; i < count && status == FLASH_COMPLETE; i++)
+    {
+        status = FLASH_ProgramWord(addr + i * 4U, words[i]);
+    }
+    FLASH_Lock();
+
+    return (status == FLASH_COMPLETE) ? 0 : -1;
+}
@@ -27,6 +27,8 @@
 #define IIC_SDA_READ GPIO_ReadInputDataBit(IIC_GPIO_PORT, IIC_SDA_GPIO_PIN)
 
 void IIC_GPIO_Config(void);
+void IIC_ClockUpdate(void);
+void IIC_ClockSync(void);
 void IIC_Start(void);
 void IIC_Stop(void);
 void IIC_ACK(uint8_t ack);
@@ -64,6 +64,48 @@ void IIC_GPIO_Config(void)
 #endif
 }
 
+#if IIC_SELECT
+/* 时钟切换时总线忙，时序更新推迟到下一次传输开始前(IIC_ClockSync) */
+static volatile uint8_t s_ucClockPending = 0;
+#endif
+
+/**
+ * @brief 系统时钟切换后按新的APB1频率重新设置硬件I2C时序
+ *
+ * @note I2C_Init按当前PCLK1计算CCR/TRISE(内部先关闭再打开外设)，传输中途调用会打断传输；
+ *       调频可能发生在显示任务的传输中途(被高优先级任务抢占)，此时总线忙，只记下待更新，
+ *       由下一次传输在等到总线空闲后调用IIC_ClockSync完成
+ *       软件I2C的延时为空循环，随内核频率降低而变慢，无需处理
+ */
+void IIC_ClockUpdate(void)
+{
+#if IIC_SELECT
+    if (I2C_GetFlagStatus(IIC_NUM, I2C_FLAG_BUSY) == SET)
+    {
+        s_ucClockPending = 1;
+        return;
+    }
+    s_ucClockPending = 0;
+    I2C_Init(IIC_NUM, &iic_initstruct);
+#endif
+}
+
+/**
+ * @brief 完成推迟的时序更新(总线空闲、发出起始信号之前调用)
+ *
+ * @note I2C_Init总是按调用时的PCLK1计算，与IIC_ClockUpdate交错执行也不会用到旧频率
+ */
+void IIC_ClockSync(void)
+{
+#if IIC_SELECT
+    if (s_ucClockPending != 0)
+    {
+        s_ucClockPending = 0;
+        I2C_Init(IIC_NUM, &iic_initstruct);
+    }
+#endif
+}
+
 static void IIC_Delay(void)
 {
     uint8_t i;
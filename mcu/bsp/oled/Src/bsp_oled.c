@@ -7,17 +7,23 @@
  *
  * @copyright Copyright (c) 2025 Yukikaze
  *
+ * @note ݰ: һI2CΪ ʼ+ַ+ֽ+Nֽ+ֹͣ
+ *       ֽCo=0ʱȫΪ(0x00)ȫΪʾ(0x40)
+ *       ҳѰַģʽеַԶдֽдʾͬ
+ *       ShowStr/Fillʹþ̬л壬ֻһе(Task_DisplayʱΪ)
  */
 
 #include "bsp_oled.h"
 #include "bsp_oled_codetab.h"
 #include "bsp_iic.h"
+#include <string.h>
 
 #if IIC_SELECT
 void IIC_Write_Byte(uint8_t addr, uint8_t data)
 {
     while (I2C_GetFlagStatus(IIC_NUM, I2C_FLAG_BUSY))
         ;
+    IIC_ClockSync();
 
     I2C_GenerateSTART(IIC_NUM, ENABLE); /* IIC_Startź */
     while (!I2C_CheckEvent(IIC_NUM, I2C_EVENT_MASTER_MODE_SELECT))
@@ -37,87 +43,116 @@ void IIC_Write_Byte(uint8_t addr, uint8_t data)
     I2C_GenerateSTOP(IIC_NUM, ENABLE); /* IIC_Stopź */
 }
 
-#endif
-
-/* oledд */
-void Oled_Write_Data(uint8_t data)
+/* һδlenֽ */
+static void IIC_Write_Buf(uint8_t addr, const uint8_t *buf, uint16_t len)
 {
-#if IIC_SELECT
-    IIC_Write_Byte(OLED_WR_DATA, data);
-#else
-    IIC_Start();
-    IIC_SendByte(OLED_ID);
-    /* ȴӦ */
-    while (IIC_Wait_ACK())
+    uint16_t i;
+
+    while (I2C_GetFlagStatus(IIC_NUM, I2C_FLAG_BUSY))
         ;
-    IIC_SendByte(OLED_WR_DATA);
-    /* ȴӦ */
-    while (IIC_Wait_ACK())
+    IIC_ClockSync();
+
+    I2C_GenerateSTART(IIC_NUM, ENABLE); /* IIC_Startź */
+    while (!I2C_CheckEvent(IIC_NUM, I2C_EVENT_MASTER_MODE_SELECT))
+        ; /*EV5,ģʽ*/
+
+    I2C_Send7bitAddress(IIC_NUM, OLED_ID, I2C_Direction_Transmitter); /* дӻ */
+    while (!I2C_CheckEvent(IIC_NUM, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
         ;
-    IIC_SendByte(data);
-    /* ȴӦ */
-    while (IIC_Wait_ACK())
+    I2C_SendData(IIC_NUM, addr); /* ֽ: ȫΪȫΪ */
+    while (!I2C_CheckEvent(IIC_NUM, I2C_EVENT_MASTER_BYTE_TRANSMITTED))
         ;
-    IIC_Stop();
-#endif
+
+    for (i = 0; i < len; i++)
+    {
+        I2C_SendData(IIC_NUM, buf[i]); /*  */
+        while (!I2C_CheckEvent(IIC_NUM, I2C_EVENT_MASTER_BYTE_TRANSMITTED))
+            ;
+    }
+
+    I2C_GenerateSTOP(IIC_NUM, ENABLE); /* IIC_Stopź */
 }
 
-/* oledд */
-void Oled_Write_Cmd(uint8_t cmd)
+#endif
+
+/* ÿ226x8ַ(132ֽ)8x16ַһ */
+#define OLED_RUN_MAX 132
+
+/* ShowStrַλ(ϰ/°)Fillл */
+static uint8_t s_ucOledRun[2 * OLED_RUN_MAX];
+
+/* oledд: ctrlΪOLED_WR_CMDOLED_WR_DATA */
+static void Oled_Write_Buf(uint8_t ctrl, const uint8_t *buf, uint16_t len)
 {
 #if IIC_SELECT
-    IIC_Write_Byte(OLED_WR_CMD, cmd);
+    IIC_Write_Buf(ctrl, buf, len);
 #else
+    uint16_t i;
+
     IIC_Start();
     IIC_SendByte(OLED_ID);
     /* ȴӦ */
     while (IIC_Wait_ACK())
         ;
-    IIC_SendByte(OLED_WR_CMD);
-    /* ȴӦ */
-    while (IIC_Wait_ACK())
-        ;
-    IIC_SendByte(cmd);
+    IIC_SendByte(ctrl);
     /* ȴӦ */
     while (IIC_Wait_ACK())
         ;
+    for (i = 0; i < len; i++)
+    {
+        IIC_SendByte(buf[i]);
+        /* ȴӦ */
+        while (IIC_Wait_ACK())
+            ;
+    }
     IIC_Stop();
 #endif
 }
 
-void OLED_Init(void)
+/* oledд */
+void Oled_Write_Data(uint8_t data)
 {
+    Oled_Write_Buf(OLED_WR_DATA, &data, 1);
+}
+
+/* oledд */
+void Oled_Write_Cmd(uint8_t cmd)
+{
+    Oled_Write_Buf(OLED_WR_CMD, &cmd, 1);
+}
+
+/* ʼ(һδ䷢) */
+static const uint8_t s_ucOledInitCmds[] = {
     /* ʾ/ر
      * AE--->ʾ
      * AF--->ʾر(ģʽ)
      */
-    Oled_Write_Cmd(0xAE);
+    0xAE,
 
     /* ==================  ===================*/
     /* öԱȶ
      * 0~255ֵԽ Խ
      */
-    Oled_Write_Cmd(0x81);
-    Oled_Write_Cmd(0xFF);
+    0x81, 0xFF,
 
     /* ʹȫʾ
      * A4--->ָRAMʾ
      * A5--->RAMʾ
      */
-    Oled_Write_Cmd(0xA4);
+    0xA4,
 
     /* ʾģʽ
      * A6--->ʾ01
      * A7--->ʾ10
      */
-    Oled_Write_Cmd(0xA6);
+    0xA6,
 
     /* ==================  ===================*/
     /* ʹ/ʧ
      * 2E--->ʧ
      * 2F--->ʹ
      */
-    Oled_Write_Cmd(0x2E);
+    0x2E,
 
     /* ֽ ˮƽ */
 
@@ -125,84 +160,82 @@ void OLED_Init(void)
      * 26--->ˮƽ
      * 27--->ˮƽ
      */
-    Oled_Write_Cmd(0x26);
+    0x26,
     /* ֽ */
-    Oled_Write_Cmd(0x00);
+    0x00,
     /* ùʼҳַ */
-    Oled_Write_Cmd(0x00);
+    0x00,
     /* ù */
-    Oled_Write_Cmd(0x03);
+    0x03,
     /* ùַ */
-    Oled_Write_Cmd(0x07);
+    0x07,
     /* ֽ */
-    Oled_Write_Cmd(0x00);
-    Oled_Write_Cmd(0xFF);
+    0x00, 0xFF,
 
     /* =============== Ѱַ ==================*/
 
     /* ˫ֽ:ĴѰַģʽ */
-    Oled_Write_Cmd(0x20);
+    0x20,
 
     /* 10:ҳѰַģʽ
      * 01:ֱѰַģʽ
      * 00:ˮƽѰַģʽ
      */
-    Oled_Write_Cmd(0x10);
+    0x10,
     /* ֽ:ҳѰַʼҳַ */
-    Oled_Write_Cmd(0xB0);
+    0xB0,
     /* ֽ:ҳѰַʼеַλ */
-    Oled_Write_Cmd(0x00);
+    0x00,
     /* ֽ:ҳѰַʼеַλ */
-    Oled_Write_Cmd(0x10);
+    0x10,
 
     /*=============== Ӳ ==================*/
 
     /* ʾʼ
      * 0x40~0x7FӦ0~63
      */
-    Oled_Write_Cmd(0x40);
+    0x40,
 
     /* ӳ
      * A0:addressX--->segX
      * A1:addressX--->seg(127-X)
      */
-    Oled_Write_Cmd(0xA1);
+    0xA1,
 
     /* ö·ñ */
-    Oled_Write_Cmd(0xA8);
-    Oled_Write_Cmd(0x3F);
+    0xA8, 0x3F,
 
     /* COMɨ跽
      * C0COM0--->COM63(ɨ)
      * C8COM63--->COM0(ɨ)
      */
-    Oled_Write_Cmd(0xC8);
+    0xC8,
 
     /* ˫ֽCOMʾƫ */
-    Oled_Write_Cmd(0xD3);
-    Oled_Write_Cmd(0x00); /* COMƫ */
+    0xD3, 0x00, /* COMƫ */
 
     /* ˫ֽCOMӳ */
-    Oled_Write_Cmd(0xDA);
-    Oled_Write_Cmd(0x12);
+    0xDA, 0x12,
 
     /* ˫ֽԤ */
-    Oled_Write_Cmd(0xD9);
-    Oled_Write_Cmd(0x22); /* ׶һ2ЧDCLKʱ/׶ζ2ЧDCLKʱ */
+    0xD9, 0x22, /* ׶һ2ЧDCLKʱ/׶ζ2ЧDCLKʱ */
 
     /* VCOMHȡѡƽ
      * 00:0.65xVcc
      * 20:0.77xVcc
      * 30:0.83xVcc
      */
-    Oled_Write_Cmd(0xDB);
-    Oled_Write_Cmd(0x20);
+    0xDB, 0x20,
 
     /* ˫ֽõɱ */
-    Oled_Write_Cmd(0x8d);
-    Oled_Write_Cmd(0x14);
+    0x8d, 0x14,
 
-    Oled_Write_Cmd(0xAF);
+    0xAF,
+};
+
+void OLED_Init(void)
+{
+    Oled_Write_Buf(OLED_WR_CMD, s_ucOledInitCmds, sizeof(s_ucOledInitCmds));
 }
 
 /**
@@ -213,9 +246,12 @@ void OLED_Init(void)
  */
 void OLED_SetPos(unsigned char x, unsigned char y) // ʼ
 {
-    Oled_Write_Cmd(0xb0 + y);
-    Oled_Write_Cmd(((x & 0xf0) >> 4) | 0x10);
-    Oled_Write_Cmd((x & 0x0f) | 0x01);
+    uint8_t cmd[3];
+
+    cmd[0] = 0xb0 + y;
+    cmd[1] = ((x & 0xf0) >> 4) | 0x10;
+    cmd[2] = (x & 0x0f) | 0x01;
+    Oled_Write_Buf(OLED_WR_CMD, cmd, 3);
 }
 
 /**
@@ -225,16 +261,17 @@ void OLED_SetPos(unsigned char x, unsigned char y) // 
  */
 void OLED_Fill(unsigned char fill_data) // ȫ
 {
-    unsigned char m, n;
+    unsigned char m;
+    uint8_t cmd[3];
+
+    memset(s_ucOledRun, fill_data, 128);
     for (m = 0; m < 8; m++)
     {
-        Oled_Write_Cmd(0xb0 + m); // page0-page1
-        Oled_Write_Cmd(0x00);     // low column start address
-        Oled_Write_Cmd(0x10);     // high column start address
-        for (n = 0; n < 128; n++)
-        {
-            Oled_Write_Data(fill_data);
-        }
+        cmd[0] = 0xb0 + m; // page0-page1
+        cmd[1] = 0x00;     // low column start address
+        cmd[2] = 0x10;     // high column start address
+        Oled_Write_Buf(OLED_WR_CMD, cmd, 3);
+        Oled_Write_Buf(OLED_WR_DATA, s_ucOledRun, 128);
     }
 }
 
@@ -278,27 +315,38 @@ void OLED_OFF(void)
  *					ch[] :- Ҫʾַ;
  *					textsize : ַС(1:6*8 ; 2:8*16)
  * @retval 
+ * @note   ͬһַϲΪһ: һιһδдΣ
+ *         ַùʱʼΪx|1ͬһڸַxżͬеַ
+ *         һַԽ127(еַ)ʱһΣַдһ
  */
 void OLED_ShowStr(unsigned char x, unsigned char y, unsigned char ch[], unsigned char textsize)
 {
     unsigned char c = 0, i = 0, j = 0;
+    unsigned char x0;
+    uint16_t n;
     switch (textsize)
     {
     case 1:
     {
         while (ch[j] != '\0')
         {
-            c = ch[j] - 32;
             if (x > 126)
             {
                 x = 0;
                 y++;
             }
-            OLED_SetPos(x, y);
-            for (i = 0; i < 6; i++)
-                Oled_Write_Data(F6x8[c][i]);
-            x += 6;
-            j++;
+            x0 = x;
+            n = 0;
+            do
+            {
+                c = ch[j] - 32;
+                for (i = 0; i < 6; i++)
+                    s_ucOledRun[n++] = F6x8[c][i];
+                x += 6;
+                j++;
+            } while (ch[j] != '\0' && x <= 126 && (x | 0x01) + 6 <= 128);
+            OLED_SetPos(x0, y);
+            Oled_Write_Buf(OLED_WR_DATA, s_ucOledRun, n);
         }
     }
     break;
@@ -306,20 +354,29 @@ void OLED_ShowStr(unsigned char x, unsigned char y, unsigned char ch[], unsigned
     {
         while (ch[j] != '\0')
         {
-            c = ch[j] - 32;
             if (x > 120)
             {
                 x = 0;
                 y++;
             }
-            OLED_SetPos(x, y);
-            for (i = 0; i < 8; i++)
-                Oled_Write_Data(F8X16[c * 16 + i]);
-            OLED_SetPos(x, y + 1);
-            for (i = 0; i < 8; i++)
-                Oled_Write_Data(F8X16[c * 16 + i + 8]);
-            x += 8;
-            j++;
+            x0 = x;
+            n = 0;
+            do
+            {
+                c = ch[j] - 32;
+                for (i = 0; i < 8; i++)
+                {
+                    s_ucOledRun[n + i] = F8X16[c * 16 + i];
+                    s_ucOledRun[OLED_RUN_MAX + n + i] = F8X16[c * 16 + i + 8];
+                }
+                n += 8;
+                x += 8;
+                j++;
+            } while (ch[j] != '\0' && x <= 120 && (x | 0x01) + 8 <= 128);
+            OLED_SetPos(x0, y);
+            Oled_Write_Buf(OLED_WR_DATA, s_ucOledRun, n);
+            OLED_SetPos(x0, y + 1);
+            Oled_Write_Buf(OLED_WR_DATA, &s_ucOledRun[OLED_RUN_MAX], n);
         }
     }
     break;
@@ -0,0 +1,114 @@
+/**
+ * @file bsp_power.h
+ * @brief 低功耗(STOP模式 + RTC唤醒)驱动头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note RTC时钟优先使用LSE(32.768kHz)，起振失败时退回LSI(约32kHz，误差较大):
+ *       - 亚秒计数器(SSR)频率 = RTCCLK/2，约61us分辨率，用于测量STOP时长
+ *       - 唤醒定时器时钟 = RTCCLK/16，16位计数最长约32秒
+ *       F4的唤醒定时器计数值无法读回，因此STOP时长由前后两次RTC快照计算，
+ *       提前唤醒(其他EXTI中断)时同样准确
+ *
+ *       STOP模式下PLL/HSE与过驱动停止，唤醒后系统时钟为HSI，需BSP_Power_RestoreClocks恢复
+ */
+
+#ifndef __BSP_POWER_H
+#define __BSP_POWER_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define BSP_POWER_LSE_TIMEOUT_MS 1500   /**< LSE起振等待上限(毫秒) */
+#define BSP_POWER_RTC_PREDIV_A 1        /**< 异步预分频(RTCCLK/2) */
+#define BSP_POWER_WUT_DIV 16            /**< 唤醒定时器分频(RTCCLK/16) */
+#define BSP_POWER_WKUP_IRQ_PRIORITY 6   /**< RTC唤醒中断优先级(可管理中断) */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief RTC时间快照
+ */
+typedef struct
+{
+    uint32_t sec; /**< 当日秒数(0~86399) */
+    uint32_t ss;  /**< 亚秒寄存器(向下计数) */
+} BSP_Power_Time_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化RTC与唤醒定时器
+ * @author Yukikaze
+ *
+ * @param wait 等待LSE/LSI起振期间每次轮询调用的让出函数(NULL=忙等)
+ * @return int 0=LSE, 1=LSI(计时误差大), -1=RTC不可用(不能使用STOP)
+ *
+ * @note RTC已在运行(后备域未掉电)时沿用原时钟源，不重新初始化
+ *       LSE起振最长约1秒，在任务中调用时传入让出函数，等待期间CPU交给其他任务
+ */
+int BSP_Power_Init(void (*wait)(void));
+
+/**
+ * @brief RTC时钟频率(Hz)，未初始化时为0
+ * @author Yukikaze
+ */
+uint32_t BSP_Power_RtcHz(void);
+
+/**
+ * @brief 读取RTC时间快照
+ * @author Yukikaze
+ *
+ * @param t 输出快照
+ *
+ * @note 从STOP唤醒后先调用BSP_Power_RestoreClocks(其中会等待影子寄存器同步)
+ */
+void BSP_Power_ReadTime(BSP_Power_Time_TypeDef *t);
+
+/**
+ * @brief 启动唤醒定时器
+ * @author Yukikaze
+ *
+ * @param counts 计数值(1~65536)
+ */
+void BSP_Power_WakeupStart(uint32_t counts);
+
+/**
+ * @brief 停止唤醒定时器并清除标志
+ * @author Yukikaze
+ */
+void BSP_Power_WakeupStop(void);
+
+/**
+ * @brief 进入STOP模式(低功耗调压器，WFI唤醒)
+ * @author Yukikaze
+ *
+ * @note 调用前需关中断(PRIMASK)，唤醒后中断在恢复PRIMASK后才执行；
+ *       先等待调试串口发送完成，避免最后一个字节被截断
+ */
+void BSP_Power_EnterStop(void);
+
+/**
+ * @brief STOP唤醒后恢复进入前的系统时钟
+ * @author Yukikaze
+ *
+ * @return int 0=成功, -1=HSE/PLL未能恢复，系统时钟停留在HSI(SystemCoreClock已更新)
+ *
+ * @note 时钟由BSP_Clock_Restore恢复(HSE、PLL与过驱动)，再等待RTC影子寄存器同步
+ */
+int BSP_Power_RestoreClocks(void);
+
+#endif /* __BSP_POWER_H */
@@ -0,0 +1,202 @@
+/**
+ * @file bsp_power.c
+ * @brief 低功耗(STOP模式 + RTC唤醒)驱动实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "bsp_power.h"
+#include "bsp_clock.h"
+#include "bsp_usart.h"
+#include "core_delay.h"
+
+/* RTC时钟频率(0=不可用) */
+static uint32_t s_ulRtcHz = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 等待RCC标志置位(DWT计时，wait非NULL时每次轮询让出CPU)
+ */
+static int BSP_Power_WaitFlag(uint8_t flag, uint32_t timeout_ms, void (*wait)(void))
+{
+    uint32_t start = CPU_TS_TmrRd();
+    uint32_t limit = timeout_ms * (SystemCoreClock / 1000U);
+
+    while (RCC_GetFlagStatus(flag) == RESET)
+    {
+        if (CPU_TS_TmrRd() - start > limit)
+        {
+            return -1;
+        }
+        if (wait != NULL)
+        {
+            wait();
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief BCD格式的时间寄存器转为当日秒数
+ */
+static uint32_t BSP_Power_TrToSec(uint32_t tr)
+{
+    uint32_t h = ((tr >> 20) & 0x3U) * 10U + ((tr >> 16) & 0xFU);
+    uint32_t m = ((tr >> 12) & 0x7U) * 10U + ((tr >> 8) & 0xFU);
+    uint32_t s = ((tr >> 4) & 0x7U) * 10U + (tr & 0xFU);
+
+    return h * 3600U + m * 60U + s;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int BSP_Power_Init(void (*wait)(void))
+{
+    RTC_InitTypeDef RTC_InitStructure;
+    EXTI_InitTypeDef EXTI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    uint32_t rtcsel;
+    int ret;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
+    PWR_BackupAccessCmd(ENABLE);
+
+    rtcsel = RCC->BDCR & RCC_BDCR_RTCSEL;
+    if ((RCC->BDCR & RCC_BDCR_RTCEN) != 0 && rtcsel == RCC_BDCR_RTCSEL_0 &&
+        RCC_GetFlagStatus(RCC_FLAG_LSERDY) != RESET)
+    {
+        /* 后备域保持着以LSE运行的RTC */
+        s_ulRtcHz = 32768U;
+        ret = 0;
+    }
+    else
+    {
+        if ((RCC->BDCR & RCC_BDCR_RTCEN) != 0 || rtcsel != 0)
+        {
+            /* 时钟源只能在后备域复位后修改(日历本身不需要保留) */
+            RCC_BackupResetCmd(ENABLE);
+            RCC_BackupResetCmd(DISABLE);
+        }
+
+        RCC_LSEConfig(RCC_LSE_ON);
+        if (BSP_Power_WaitFlag(RCC_FLAG_LSERDY, BSP_POWER_LSE_TIMEOUT_MS, wait) == 0)
+        {
+            RCC_RTCCLKConfig(RCC_RTCCLKSource_LSE);
+            s_ulRtcHz = 32768U;
+            ret = 0;
+        }
+        else
+        {
+            RCC_LSEConfig(RCC_LSE_OFF);
+            RCC_LSICmd(ENABLE);
+            if (BSP_Power_WaitFlag(RCC_FLAG_LSIRDY, 10, wait) != 0)
+            {
+                s_ulRtcHz = 0;
+                return -1;
+            }
+            RCC_RTCCLKConfig(RCC_RTCCLKSource_LSI);
+            s_ulRtcHz = 32000U;
+            ret = 1;
+        }
+        RCC_RTCCLKCmd(ENABLE);
+    }
+
+    if (RTC_WaitForSynchro() != SUCCESS)
+    {
+        s_ulRtcHz = 0;
+        return -1;
+    }
+
+    /* 亚秒频率 = RTCCLK/2，同步预分频使秒计数仍为1Hz */
+    RTC_InitStructure.RTC_AsynchPrediv = BSP_POWER_RTC_PREDIV_A;
+    RTC_InitStructure.RTC_SynchPrediv = s_ulRtcHz / (BSP_POWER_RTC_PREDIV_A + 1U) - 1U;
+    RTC_InitStructure.RTC_HourFormat = RTC_HourFormat_24;
+    if (RTC_Init(&RTC_InitStructure) != SUCCESS)
+    {
+        s_ulRtcHz = 0;
+        return -1;
+    }
+
+    /* 唤醒定时器: RTCCLK/16，经EXTI22上升沿产生中断 */
+    RTC_WakeUpCmd(DISABLE);
+    RTC_WakeUpClockConfig(RTC_WakeUpClock_RTCCLK_Div16);
+    RTC_ITConfig(RTC_IT_WUT, ENABLE);
+    RTC_ClearITPendingBit(RTC_IT_WUT);
+
+    EXTI_ClearITPendingBit(EXTI_Line22);
+    EXTI_InitStructure.EXTI_Line = EXTI_Line22;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = RTC_WKUP_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = BSP_POWER_WKUP_IRQ_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    return ret;
+}
+
+uint32_t BSP_Power_RtcHz(void)
+{
+    return s_ulRtcHz;
+}
+
+void BSP_Power_ReadTime(BSP_Power_Time_TypeDef *t)
+{
+    uint32_t ss;
+    uint32_t tr;
+
+    /* 读SSR锁存TR/DR影子寄存器，读DR解锁，三者属于同一时刻 */
+    ss = RTC->SSR;
+    tr = RTC->TR;
+    (void)RTC->DR;
+
+    t->ss = ss & RTC_SSR_SS;
+    t->sec = BSP_Power_TrToSec(tr);
+}
+
+void BSP_Power_WakeupStart(uint32_t counts)
+{
+    RTC_WakeUpCmd(DISABLE);
+    RTC_SetWakeUpCounter(counts - 1U);
+    RTC_ClearITPendingBit(RTC_IT_WUT);
+    EXTI_ClearITPendingBit(EXTI_Line22);
+    RTC_WakeUpCmd(ENABLE);
+}
+
+void BSP_Power_WakeupStop(void)
+{
+    RTC_WakeUpCmd(DISABLE);
+    RTC_ClearITPendingBit(RTC_IT_WUT);
+    EXTI_ClearITPendingBit(EXTI_Line22);
+    NVIC_ClearPendingIRQ(RTC_WKUP_IRQn);
+}
+
+void BSP_Power_EnterStop(void)
+{
+    /* 查询发送的printf可能还有字节在移位寄存器中 */
+    USARTx_WaitIdle();
+
+    PWR_EnterSTOPMode(PWR_LowPowerRegulator_ON, PWR_STOPEntry_WFI);
+}
+
+int BSP_Power_RestoreClocks(void)
+{
+    int ret = BSP_Clock_Restore();
+
+    /* STOP期间RTC影子寄存器未更新，等待重新同步后才能读取时间 */
+    (void)RTC_WaitForSynchro();
+    return ret;
+}
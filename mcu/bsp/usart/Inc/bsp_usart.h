@@ -30,8 +30,15 @@
 #define USARTx_TX_AF GPIO_AF_USART1
 #define USARTx_TX_SOURCE GPIO_PinSource9
 
+#define USARTx_IRQn USART1_IRQn
+#define USARTx_IRQHandler USART1_IRQHandler
+#define USARTx_IRQ_PRIORITY 6 // жȼ(ֵСconfigLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)
+
 /************************************************************/
 
 void USARTx_Config(void);
+void USARTx_RxIT_Config(void);
+void USARTx_WaitIdle(void);
+void USARTx_ClockUpdate(void);
 
 #endif /* __USART_H */
@@ -11,6 +11,33 @@
 
 #include "bsp_usart.h"
 
+/**
+ * @brief  ڹģʽ벨á115200 8-N-1
+ * @note   USART_InitǰPCLK㲨ʼĴϵͳʱлµ
+ * @param  
+ * @retval 
+ */
+static void USARTx_ModeConfig(void)
+{
+    USART_InitTypeDef USART_InitStructure;
+
+    /* ôDEBUG_USART ģʽ */
+    /* ãDEBUG_USART_BAUDRATE */
+    USART_InitStructure.USART_BaudRate = USARTx_BAUDRATE;
+    /* ֳ(λ+Уλ)8 */
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    /* ֹͣλ1ֹͣλ */
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    /* Уλѡ񣺲ʹУ */
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    /* ӲƣʹӲ */
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    /* USARTģʽƣͬʱʹܽպͷ */
+    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+    /* USARTʼ */
+    USART_Init(USARTx, &USART_InitStructure);
+}
+
 /**
  * @brief  USART GPIO ,ģʽá115200 8-N-1
  * @param  
@@ -19,7 +46,6 @@
 void USARTx_Config(void)
 {
     GPIO_InitTypeDef GPIO_InitStructure;
-    USART_InitTypeDef USART_InitStructure;
 
     RCC_AHB1PeriphClockCmd(USARTx_RX_GPIO_CLK | USARTx_TX_GPIO_CLK, ENABLE);
 
@@ -47,26 +73,53 @@ void USARTx_Config(void)
     /*   PXx  USARTx__Rx*/
     GPIO_PinAFConfig(USARTx_TX_GPIO_PORT, USARTx_TX_SOURCE, USARTx_TX_AF);
 
-    /* ôDEBUG_USART ģʽ */
-    /* ãDEBUG_USART_BAUDRATE */
-    USART_InitStructure.USART_BaudRate = USARTx_BAUDRATE;
-    /* ֳ(λ+Уλ)8 */
-    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
-    /* ֹͣλ1ֹͣλ */
-    USART_InitStructure.USART_StopBits = USART_StopBits_1;
-    /* Уλѡ񣺲ʹУ */
-    USART_InitStructure.USART_Parity = USART_Parity_No;
-    /* ӲƣʹӲ */
-    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
-    /* USARTģʽƣͬʱʹܽպͷ */
-    USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
-    /* USARTʼ */
-    USART_Init(USARTx, &USART_InitStructure);
+    USARTx_ModeConfig();
 
     /* ʹܴ */
     USART_Cmd(USARTx, ENABLE);
 }
 
+/**
+ * @brief  ʹܴڽж(ڿַ̨)
+ * @note   USARTx_IRQHandlerʹ__io_getcharѯ
+ * @param  
+ * @retval 
+ */
+void USARTx_RxIT_Config(void)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    NVIC_InitStructure.NVIC_IRQChannel = USARTx_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = USARTx_IRQ_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    USART_ITConfig(USARTx, USART_IT_RXNE, ENABLE);
+}
+
+/**
+ * @brief  ȴ(һֽƳλĴ)
+ * @param  
+ * @retval 
+ */
+void USARTx_WaitIdle(void)
+{
+    while (USART_GetFlagStatus(USARTx, USART_FLAG_TC) == RESET)
+        ;
+}
+
+/**
+ * @brief  ϵͳʱлµAPB2Ƶò
+ * @note   лǰȵUSARTx_WaitIdleڷ͵ֽڱض
+ * @param  
+ * @retval 
+ */
+void USARTx_ClockUpdate(void)
+{
+    USARTx_ModeConfig();
+}
+
 // ضײputchar_writeڷ
 int __io_putchar(int ch)
 {
@@ -2,7 +2,18 @@
 // Created by anyMSG on 11/20/19.
 //
 #define G_PORT_CONFIG
+
+#include "__port_config__.h"
+#include <stdint.h>
+
+// 字长: 未指定时按目标的long宽度选择(Cortex-M4为32位，64位主机为64位)
+#if !defined(__PFX32__) && !defined(__PFX64__)
+#if defined(__SIZEOF_LONG__) && (__SIZEOF_LONG__ == 8)
+#define __PFX64__ 1
+#else
 #define __PFX32__ 1
+#endif
+#endif
 
 #ifndef __PFX64__
 #ifndef __PFX32__
@@ -15,28 +26,59 @@
 #endif
 #endif
 
+// 按字访问任意类型的缓冲区(may_alias避免严格别名优化出错)
+typedef unsigned long int __attribute__((may_alias)) word_t;
+
 #ifdef __PFX64__
-typedef unsigned long int word_t;
-// 用于检查一个字节是否为零的掩码
-static const word_t BYTE_MASK = 0x7F7F7F7F7F7F7F7FULL;
-#elif __PFX32__
-typedef unsigned long int word_t;
-// 用于检查一个字节是否为零的掩码
-static const word_t BYTE_MASK = 0x7f7f7f7fU;
+_Static_assert(sizeof(word_t) == 8, "__PFX64__ requires a 64-bit long");
+#else
+_Static_assert(sizeof(word_t) == 4, "__PFX32__ requires a 32-bit long");
+#endif
+
+#define WSIZE sizeof(word_t)
+#define WMASK (WSIZE - 1U)
+
+// 每个字节为0x01 / 0x80
+#define ONES ((word_t)-1 / 0xFFU)
+#define HIGHS (ONES << 7)
+
+// 支持非对齐的单字读写(Cortex-M3/M4的LDR/STR、x86、AArch64)，否则非对齐部分逐字节处理
+#if defined(__ARM_FEATURE_UNALIGNED) || defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#define PORT_UNALIGNED_OK 1
+#else
+#define PORT_UNALIGNED_OK 0
 #endif
 
-// 用于检查4个字节的任意一个字节是否为零
-static inline word_t has_zero_byte(word_t x)
+// Cortex-M4: 对齐的大块复制/填充用LDM/STM突发(每条4个字)
+#if defined(__arm__) && defined(__ARM_ARCH_7EM__)
+#define PORT_ARM_BURST 1
+#else
+#define PORT_ARM_BURST 0
+#endif
+
+// 禁止编译器把下面的循环识别回memcpy/memset调用(替换newlib时会递归)
+#define PORT_NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+// 字中是否有零字节
+static inline int has_zero_byte(word_t x)
 {
-    return ((x - BYTE_MASK) & ~x & (BYTE_MASK << 1)) != 0;
+    return ((x - ONES) & ~x & HIGHS) != 0;
+}
+
+// 非对齐读取一个字(编译为单条LDR/MOV)
+static inline word_t load_unaligned(const unsigned char *p)
+{
+    word_t w;
+    __builtin_memcpy(&w, p, sizeof(w));
+    return w;
 }
 
 // 计算字符串长度的函数
-unsigned long int _port_strlen_(const char *s)
+PORT_NO_LIBCALL unsigned long int _port_strlen_(const char *s)
 {
     const char *p = s;
     // 计算指针是否对齐
-    while (((word_t)p & (sizeof(word_t) - 1)) != 0)
+    while (((uintptr_t)p & WMASK) != 0)
     {
         if (*p == '\0')
         {
@@ -45,53 +87,81 @@ unsigned long int _port_strlen_(const char *s)
         p++;
     }
 
-    // 按字对齐的方式读取内存
+    // 按字对齐的方式读取内存(对齐的字不会跨越页/存储区边界)
     const word_t *wp = (const word_t *)p;
-    while (1)
+    while (!has_zero_byte(*wp))
     {
-        word_t w = *wp++;
-        if (has_zero_byte(w))
-        {
-            // 如果找到了零字节，再逐个字符检查
-            p = (const char *)(wp - 1);
-            for (word_t i = 0; i < sizeof(word_t); i++)
-            {
-                if (p[i] == '\0')
-                {
-                    return p + i - s;
-                }
-            }
-        }
+        wp++;
+    }
+
+    // 找到了零字节，再逐个字符检查
+    p = (const char *)wp;
+    while (*p != '\0')
+    {
+        p++;
     }
+    return p - s;
 }
 
-void *_port_memset_(void *dest, int val, unsigned long int len)
+PORT_NO_LIBCALL void *_port_memset_(void *dest, int val, unsigned long int len)
 {
     unsigned char *ptr = (unsigned char *)dest;
     unsigned char value = (unsigned char)val;
+    word_t wide_val = ONES * value;
+
+    // 短缓冲直接逐字节
+    if (len < 2U * WSIZE)
+    {
+        while (len-- > 0)
+        {
+            *ptr++ = value;
+        }
+        return dest;
+    }
 
-    // 预先处理小部分字节以提高循环效率
-    while (len > 0 && ((unsigned long int)ptr % sizeof(unsigned long int)) != 0)
+    // 预先处理小部分字节以对齐
+    while (((uintptr_t)ptr & WMASK) != 0)
     {
         *ptr++ = value;
         len--;
     }
 
-    // 使用size_t类型进行批量设置
-    unsigned long int wide_val = value;
-    unsigned long int *wide_ptr;
-    // 将value填充到整个size_t中
-    for (unsigned long int i = 1; i < sizeof(unsigned long int); i++)
+    word_t *wide_ptr = (word_t *)ptr;
+#if PORT_ARM_BURST
+    // 每次32字节: 两条4字STM
+    unsigned long int blocks = len >> 5;
+    if (blocks != 0)
     {
-        wide_val |= (wide_val << 8);
+        __asm volatile("mov r3, %[v]\n\t"
+                       "mov r4, %[v]\n\t"
+                       "mov r5, %[v]\n\t"
+                       "mov r6, %[v]\n"
+                       "1:\n\t"
+                       "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+                       "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+                       "subs %[k], %[k], #1\n\t"
+                       "bne 1b"
+                       : [d] "+r"(wide_ptr), [k] "+r"(blocks)
+                       : [v] "r"(wide_val)
+                       : "r3", "r4", "r5", "r6", "cc", "memory");
+        len &= 31U;
     }
-
-    // 设置主要部分
-    wide_ptr = (unsigned long int *)ptr;
-    while (len >= sizeof(unsigned long int))
+#else
+    // 4字展开
+    while (len >= 4U * WSIZE)
+    {
+        wide_ptr[0] = wide_val;
+        wide_ptr[1] = wide_val;
+        wide_ptr[2] = wide_val;
+        wide_ptr[3] = wide_val;
+        wide_ptr += 4;
+        len -= 4U * WSIZE;
+    }
+#endif
+    while (len >= WSIZE)
     {
         *wide_ptr++ = wide_val;
-        len -= sizeof(unsigned long int);
+        len -= WSIZE;
     }
 
     // 处理剩余部分
@@ -104,3 +174,252 @@ void *_port_memset_(void *dest, int val, unsigned long int len)
 
     return dest;
 }
+
+PORT_NO_LIBCALL void *_port_memcpy_(void *dest, const void *src, unsigned long int len)
+{
+    unsigned char *d = (unsigned char *)dest;
+    const unsigned char *s = (const unsigned char *)src;
+
+    if (len >= 2U * WSIZE)
+    {
+        // 先把目的地址对齐
+        while (((uintptr_t)d & WMASK) != 0)
+        {
+            *d++ = *s++;
+            len--;
+        }
+
+        if (((uintptr_t)s & WMASK) == 0)
+        {
+            // 源与目的同时对齐
+            word_t *dw = (word_t *)d;
+            const word_t *sw = (const word_t *)s;
+#if PORT_ARM_BURST
+            unsigned long int blocks = len >> 5;
+            if (blocks != 0)
+            {
+                __asm volatile("1:\n\t"
+                               "ldmia %[s]!, {r3, r4, r5, r6}\n\t"
+                               "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+                               "ldmia %[s]!, {r3, r4, r5, r6}\n\t"
+                               "stmia %[d]!, {r3, r4, r5, r6}\n\t"
+                               "subs %[k], %[k], #1\n\t"
+                               "bne 1b"
+                               : [d] "+r"(dw), [s] "+r"(sw), [k] "+r"(blocks)
+                               :
+                               : "r3", "r4", "r5", "r6", "cc", "memory");
+                len &= 31U;
+            }
+#else
+            while (len >= 4U * WSIZE)
+            {
+                word_t a = sw[0], b = sw[1], c = sw[2], e = sw[3];
+                dw[0] = a;
+                dw[1] = b;
+                dw[2] = c;
+                dw[3] = e;
+                dw += 4;
+                sw += 4;
+                len -= 4U * WSIZE;
+            }
+#endif
+            while (len >= WSIZE)
+            {
+                *dw++ = *sw++;
+                len -= WSIZE;
+            }
+            d = (unsigned char *)dw;
+            s = (const unsigned char *)sw;
+        }
+#if PORT_UNALIGNED_OK
+        else
+        {
+            // 源不对齐: 非对齐读、对齐写
+            word_t *dw = (word_t *)d;
+            while (len >= 4U * WSIZE)
+            {
+                word_t a = load_unaligned(s);
+                word_t b = load_unaligned(s + WSIZE);
+                word_t c = load_unaligned(s + 2U * WSIZE);
+                word_t e = load_unaligned(s + 3U * WSIZE);
+                dw[0] = a;
+                dw[1] = b;
+                dw[2] = c;
+                dw[3] = e;
+                dw += 4;
+                s += 4U * WSIZE;
+                len -= 4U * WSIZE;
+            }
+            while (len >= WSIZE)
+            {
+                *dw++ = load_unaligned(s);
+                s += WSIZE;
+                len -= WSIZE;
+            }
+            d = (unsigned char *)dw;
+        }
+#endif
+    }
+
+    while (len > 0)
+    {
+        *d++ = *s++;
+        len--;
+    }
+    return dest;
+}
+
+PORT_NO_LIBCALL void *_port_memmove_(void *dest, const void *src, unsigned long int len)
+{
+    unsigned char *d = (unsigned char *)dest;
+    const unsigned char *s = (const unsigned char *)src;
+
+    // 目的在源之前或两者不重叠时，前向复制安全(每次先读后写，读地址始终不低于写地址)
+    if ((uintptr_t)d - (uintptr_t)s >= len)
+    {
+        return _port_memcpy_(dest, src, len);
+    }
+
+    // 目的在源之后且重叠: 从尾部向前复制
+    d += len;
+    s += len;
+    if (len >= 2U * WSIZE)
+    {
+        while (((uintptr_t)d & WMASK) != 0)
+        {
+            *--d = *--s;
+            len--;
+        }
+
+        word_t *dw = (word_t *)d;
+        if (((uintptr_t)s & WMASK) == 0)
+        {
+            const word_t *sw = (const word_t *)s;
+            while (len >= 4U * WSIZE)
+            {
+                word_t a = sw[-1], b = sw[-2], c = sw[-3], e = sw[-4];
+                dw[-1] = a;
+                dw[-2] = b;
+                dw[-3] = c;
+                dw[-4] = e;
+                dw -= 4;
+                sw -= 4;
+                len -= 4U * WSIZE;
+            }
+            while (len >= WSIZE)
+            {
+                *--dw = *--sw;
+                len -= WSIZE;
+            }
+            s = (const unsigned char *)sw;
+        }
+#if PORT_UNALIGNED_OK
+        else
+        {
+            while (len >= WSIZE)
+            {
+                s -= WSIZE;
+                *--dw = load_unaligned(s);
+                len -= WSIZE;
+            }
+        }
+#endif
+        d = (unsigned char *)dw;
+    }
+
+    while (len > 0)
+    {
+        *--d = *--s;
+        len--;
+    }
+    return dest;
+}
+
+PORT_NO_LIBCALL int _port_memcmp_(const void *a, const void *b, unsigned long int len)
+{
+    const unsigned char *p = (const unsigned char *)a;
+    const unsigned char *q = (const unsigned char *)b;
+
+    if (len >= 2U * WSIZE)
+    {
+        while (((uintptr_t)p & WMASK) != 0)
+        {
+            if (*p != *q)
+            {
+                return *p - *q;
+            }
+            p++;
+            q++;
+            len--;
+        }
+
+        // 按字比较，遇到不同的字再逐字节定位
+        if (((uintptr_t)q & WMASK) == 0)
+        {
+            while (len >= WSIZE && *(const word_t *)p == *(const word_t *)q)
+            {
+                p += WSIZE;
+                q += WSIZE;
+                len -= WSIZE;
+            }
+        }
+#if PORT_UNALIGNED_OK
+        else
+        {
+            while (len >= WSIZE && *(const word_t *)p == load_unaligned(q))
+            {
+                p += WSIZE;
+                q += WSIZE;
+                len -= WSIZE;
+            }
+        }
+#endif
+    }
+
+    while (len > 0)
+    {
+        if (*p != *q)
+        {
+            return *p - *q;
+        }
+        p++;
+        q++;
+        len--;
+    }
+    return 0;
+}
+
+PORT_NO_LIBCALL void *_port_memchr_(const void *src, int c, unsigned long int len)
+{
+    const unsigned char *p = (const unsigned char *)src;
+    unsigned char ch = (unsigned char)c;
+
+    while (len > 0 && ((uintptr_t)p & WMASK) != 0)
+    {
+        if (*p == ch)
+        {
+            return (void *)p;
+        }
+        p++;
+        len--;
+    }
+
+    // 与目标字节异或后，匹配的字节变为零
+    word_t pattern = ONES * ch;
+    while (len >= WSIZE && !has_zero_byte(*(const word_t *)p ^ pattern))
+    {
+        p += WSIZE;
+        len -= WSIZE;
+    }
+
+    while (len > 0)
+    {
+        if (*p == ch)
+        {
+            return (void *)p;
+        }
+        p++;
+        len--;
+    }
+    return (void *)0;
+}
@@ -67,6 +67,32 @@ extern "C"
     //=======================================================================
     G_BSP_COFING unsigned long int _port_strlen_(const char *str);
     G_BSP_COFING void *_port_memset_(void *dest, int val, unsigned long int len);
+    G_BSP_COFING void *_port_memcpy_(void *dest, const void *src, unsigned long int len);
+    G_BSP_COFING void *_port_memmove_(void *dest, const void *src, unsigned long int len);
+    G_BSP_COFING int _port_memcmp_(const void *a, const void *b, unsigned long int len);
+    G_BSP_COFING void *_port_memchr_(const void *src, int c, unsigned long int len);
+//=======================================================================
+// 内存/字符串函数选择: PORT_STRING_OPT=1 时使用上面的字对齐实现，否则使用C库(newlib)
+// 调用处统一写 PORT_MEMCPY(...) 等，切换只需改编译选项(CMake: -DPORT_STRING_OPT=ON)
+#ifndef PORT_STRING_OPT
+#define PORT_STRING_OPT 0
+#endif
+#if (PORT_STRING_OPT == 1)
+#define PORT_MEMCPY _port_memcpy_
+#define PORT_MEMMOVE _port_memmove_
+#define PORT_MEMSET _port_memset_
+#define PORT_MEMCMP _port_memcmp_
+#define PORT_MEMCHR _port_memchr_
+#define PORT_STRLEN _port_strlen_
+#else
+#include <string.h>
+#define PORT_MEMCPY memcpy
+#define PORT_MEMMOVE memmove
+#define PORT_MEMSET memset
+#define PORT_MEMCMP memcmp
+#define PORT_MEMCHR memchr
+#define PORT_STRLEN strlen
+#endif
 //=======================================================================
 #undef HS_PORT_TYPE
 #else
@@ -0,0 +1,193 @@
+/**
+ * @file bench.c
+ * @brief 内核函数微基准测试框架实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "bench.h"
+#include <stddef.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 开销测量用的空内核(不可内联，与被测内核走同样的间接调用)
+ */
+static void __attribute__((noinline)) Bench_Nop(void *arg)
+{
+    (void)arg;
+    __asm__ volatile("" ::: "memory");
+}
+
+/**
+ * @brief 测量一个样本: calls次调用run的耗时(未扣除开销)
+ */
+static uint32_t Bench_Sample(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *bc,
+                             Bench_Func_t run, uint32_t masked)
+{
+    /* 经volatile读取函数指针，避免链接时优化把内核内联进计时循环 */
+    Bench_Func_t volatile fn = run;
+    uint32_t state = 0;
+    uint32_t t0;
+    uint32_t dt;
+
+    if (bc->setup != NULL)
+    {
+        bc->setup(bc->arg);
+    }
+    if (masked != 0U)
+    {
+        state = cfg->mask();
+    }
+    t0 = cfg->clock();
+    for (uint32_t i = 0; i < bc->calls; i++)
+    {
+        fn(bc->arg);
+    }
+    dt = cfg->clock() - t0;
+    if (masked != 0U)
+    {
+        cfg->unmask(state);
+    }
+    return dt;
+}
+
+/**
+ * @brief 用例是否在关中断窗口中测量(后端不支持时为0)
+ */
+static uint32_t Bench_Masked(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *bc)
+{
+    return ((bc->flags & BENCH_F_IRQ_OFF) != 0U && cfg->mask != NULL && cfg->unmask != NULL) ? 1U : 0U;
+}
+
+/**
+ * @brief 预热与测量样本数(0取默认值，测量数不超过样本缓冲)
+ */
+static void Bench_Counts(const Bench_Config_TypeDef *cfg, uint32_t *warmup, uint32_t *repeat)
+{
+    *warmup = (cfg->warmup != 0U) ? cfg->warmup : BENCH_WARMUP;
+    *repeat = (cfg->repeat != 0U) ? cfg->repeat : BENCH_REPEAT;
+    if (*repeat > BENCH_MAX_REPEAT)
+    {
+        *repeat = BENCH_MAX_REPEAT;
+    }
+}
+
+/**
+ * @brief 插入排序(样本数不超过BENCH_MAX_REPEAT)
+ */
+static void Bench_Sort(uint32_t *v, uint32_t n)
+{
+    for (uint32_t i = 1; i < n; i++)
+    {
+        uint32_t x = v[i];
+        uint32_t j = i;
+
+        while (j > 0U && v[j - 1U] > x)
+        {
+            v[j] = v[j - 1U];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int Bench_Measure(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *bc,
+                  Bench_Result_TypeDef *out)
+{
+    uint32_t samples[BENCH_MAX_REPEAT];
+    uint32_t warmup;
+    uint32_t repeat;
+    uint32_t masked;
+    uint32_t overhead = UINT32_MAX;
+    Bench_Case_TypeDef nop;
+
+    if (cfg == NULL || cfg->clock == NULL || bc == NULL || bc->run == NULL ||
+        bc->calls == 0U || out == NULL)
+    {
+        return -1;
+    }
+
+    Bench_Counts(cfg, &warmup, &repeat);
+    masked = Bench_Masked(cfg, bc);
+
+    /* 开销: 同样的调用次数与中断窗口，内核换成空函数，取最小值 */
+    nop = *bc;
+    nop.setup = NULL;
+    for (uint32_t r = 0; r < warmup + repeat; r++)
+    {
+        uint32_t dt = Bench_Sample(cfg, &nop, Bench_Nop, masked);
+
+        if (r >= warmup && dt < overhead)
+        {
+            overhead = dt;
+        }
+    }
+
+    for (uint32_t r = 0; r < warmup; r++)
+    {
+        (void)Bench_Sample(cfg, bc, bc->run, masked);
+    }
+    for (uint32_t r = 0; r < repeat; r++)
+    {
+        uint32_t dt = Bench_Sample(cfg, bc, bc->run, masked);
+
+        samples[r] = (dt > overhead) ? dt - overhead : 0U;
+    }
+    Bench_Sort(samples, repeat);
+
+    out->min = samples[0];
+    out->median = samples[repeat / 2U];
+    out->max = samples[repeat - 1U];
+    out->overhead = overhead;
+    return 0;
+}
+
+void Bench_Run(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *cases, uint32_t count)
+{
+    uint32_t warmup;
+    uint32_t repeat;
+
+    if (cfg == NULL || cfg->print == NULL)
+    {
+        return;
+    }
+
+    Bench_Counts(cfg, &warmup, &repeat);
+    cfg->print("K,-,%s,%lu,%lu,%lu,%lu\r\n",
+               (cfg->unit != NULL) ? cfg->unit : "-",
+               (unsigned long)cfg->hz,
+               (unsigned long)warmup,
+               (unsigned long)repeat,
+               (unsigned long)count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const Bench_Case_TypeDef *bc = &cases[i];
+        Bench_Result_TypeDef res;
+
+        if (Bench_Measure(cfg, bc, &res) != 0)
+        {
+            continue;
+        }
+        cfg->print("K,%lu,%s,%lu,%lu,%lu,%lu,%lu,%u\r\n",
+                   (unsigned long)i,
+                   bc->name,
+                   (unsigned long)bc->calls,
+                   (unsigned long)res.min,
+                   (unsigned long)res.median,
+                   (unsigned long)res.max,
+                   (unsigned long)res.overhead,
+                   (unsigned int)Bench_Masked(cfg, bc));
+    }
+}
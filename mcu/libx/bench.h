@@ -0,0 +1,167 @@
+/**
+ * @file bench.h
+ * @brief 内核函数微基准测试框架头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 被测内核(滤波器、格式化、环形缓冲等)用BENCH_CASE登记到常量表，由Bench_Run逐项测量:
+ *       - 每个用例先预热BENCH_WARMUP个样本(不计入统计，填充缓存与分支预测)，
+ *         再测BENCH_REPEAT个样本，排序后取最小/中位/最大值
+ *       - 一个样本 = 连续调用run函数calls次；setup(可为NULL)在每个样本前调用，不计时
+ *       - 开销扣除: 以同样的calls次数调用空函数测得的最小值(计时读取+循环+间接调用)，
+ *         从每个样本中扣除，结果为内核本身的耗时
+ *       - BENCH_F_IRQ_OFF: 样本期间经mask/unmask关中断，结果不含中断抢占；
+ *         后端不提供mask时忽略(输出irq=0)
+ *       计时与输出由后端(Bench_Config_TypeDef)提供: 目标板为DWT周期计数器，
+ *       主机为clock_gettime纳秒计数；同一份用例表在两端编译，结果可直接对比
+ *       输出为机器可读行(printf兼容函数):
+ *         K,-,<unit>,<hz>,<warmup>,<repeat>,<cases>
+ *         K,<idx>,<name>,<calls>,<min>,<median>,<max>,<overhead>,<irq>
+ *       min/median/max为扣除开销后一个样本(calls次调用合计)的计数，单次调用 = 值/calls；
+ *       计数单位为unit(cyc/ns)，频率hz用于换算成时间
+ *       本模块不访问任何硬件，可在主机上编译
+ */
+
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+
+#ifndef APP_BENCH
+#define APP_BENCH 0              /**< 1=启动时运行内核基准(见main与app_bench.h) */
+#endif
+
+#ifndef BENCH_WARMUP
+#define BENCH_WARMUP 4U          /**< 默认预热样本数 */
+#endif
+
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 31U         /**< 默认测量样本数(奇数，中位数为正中一项) */
+#endif
+
+#define BENCH_MAX_REPEAT 64U     /**< 测量样本数上限(样本缓冲大小) */
+
+/* 用例标志 */
+#define BENCH_F_IRQ_OFF 0x01U    /**< 样本期间关中断 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 被测内核函数 / 样本前准备函数
+ *
+ * @param arg 用例参数(BENCH_CASE的arg)
+ */
+typedef void (*Bench_Func_t)(void *arg);
+
+/**
+ * @brief 计时函数，返回单调递增的计数(允许32位回绕)
+ */
+typedef uint32_t (*Bench_Clock_t)(void);
+
+/**
+ * @brief 输出函数(与printf兼容)
+ */
+typedef int (*Bench_Print_t)(const char *fmt, ...);
+
+/**
+ * @brief 关中断，返回之前的状态
+ */
+typedef uint32_t (*Bench_Mask_t)(void);
+
+/**
+ * @brief 恢复Bench_Mask_t返回的中断状态
+ */
+typedef void (*Bench_Unmask_t)(uint32_t state);
+
+/**
+ * @brief 用例表项
+ */
+typedef struct
+{
+    const char *name;   /**< 用例名称(输出用，不含逗号) */
+    Bench_Func_t setup; /**< 每个样本前调用(不计时)，NULL=无 */
+    Bench_Func_t run;   /**< 被测内核 */
+    void *arg;          /**< 传给setup/run的参数 */
+    uint16_t calls;     /**< 每个样本内调用run的次数(>=1) */
+    uint8_t flags;      /**< BENCH_F_xxx */
+} Bench_Case_TypeDef;
+
+/**
+ * @brief 计时与输出后端
+ */
+typedef struct
+{
+    Bench_Clock_t clock;   /**< 计时函数 */
+    Bench_Print_t print;   /**< 输出函数 */
+    Bench_Mask_t mask;     /**< 关中断，NULL=不支持关中断窗口 */
+    Bench_Unmask_t unmask; /**< 恢复中断 */
+    const char *unit;      /**< 计数单位名称("cyc"/"ns") */
+    uint32_t hz;           /**< 计数频率(每秒计数) */
+    uint16_t warmup;       /**< 预热样本数，0=BENCH_WARMUP */
+    uint16_t repeat;       /**< 测量样本数，0=BENCH_REPEAT，上限BENCH_MAX_REPEAT */
+} Bench_Config_TypeDef;
+
+/**
+ * @brief 生成用例表项
+ */
+#define BENCH_CASE(name, setup, run, arg, calls) \
+    {(name), (setup), (run), (arg), (calls), 0U}
+
+/**
+ * @brief 生成关中断测量的用例表项
+ */
+#define BENCH_CASE_IRQ_OFF(name, setup, run, arg, calls) \
+    {(name), (setup), (run), (arg), (calls), BENCH_F_IRQ_OFF}
+
+/**
+ * @brief 单个用例的测量结果(计数已扣除开销)
+ */
+typedef struct
+{
+    uint32_t min;      /**< 最小值 */
+    uint32_t median;   /**< 中位数 */
+    uint32_t max;      /**< 最大值 */
+    uint32_t overhead; /**< 扣除的开销 */
+} Bench_Result_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 测量一个用例
+ * @author Yukikaze
+ *
+ * @param cfg 后端
+ * @param bc 用例
+ * @param out 测量结果
+ * @return int 0=成功，-1=参数无效
+ */
+int Bench_Measure(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *bc,
+                  Bench_Result_TypeDef *out);
+
+/**
+ * @brief 按表顺序测量全部用例并输出K行
+ * @author Yukikaze
+ *
+ * @param cfg 后端
+ * @param cases 用例表
+ * @param count 用例数
+ *
+ * @note 应在调度器启动前运行，或在最高优先级任务中运行，避免样本被任务切换拉高
+ */
+void Bench_Run(const Bench_Config_TypeDef *cfg, const Bench_Case_TypeDef *cases, uint32_t count);
+
+#endif /* __BENCH_H */
@@ -0,0 +1,27 @@
+/**
+ * @file crc.h
+ * @brief CRC-32 校验头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note IEEE 802.3 多项式(反射 0xEDB88320)，与 zlib crc32() 结果一致
+ *       使用16项半字节查找表，兼顾代码体积与速度，主机与目标板结果相同
+ */
+
+#ifndef __CRC_H
+#define __CRC_H
+
+#include <stdint.h>
+
+/**
+ * @brief 计算CRC-32
+ * @author Yukikaze
+ *
+ * @param crc 上一段的CRC值(首段传0)，支持分段累加
+ * @param data 数据
+ * @param len 字节数
+ * @return uint32_t CRC值
+ */
+uint32_t CRC32_Update(uint32_t crc, const void *data, uint32_t len);
+
+#endif /* __CRC_H */
@@ -0,0 +1,340 @@
+/**
+ * @file filter.c
+ * @brief 定点数字滤波库实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 所有运算均为整数运算，不含除法
+ *       DSP指令与纯C参考实现逐位等价，主机上可直接对比验证
+ */
+
+#include "filter.h"
+#include "mem_section.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 计算2的幂的log2，非2的幂返回-1
+ */
+static int Filter_Log2(uint32_t n)
+{
+    int shift = 0;
+
+    if (n == 0 || (n & (n - 1)) != 0)
+    {
+        return -1;
+    }
+
+    while ((1UL << shift) != n)
+    {
+        shift++;
+    }
+    return shift;
+}
+
+/**
+ * @brief 饱和到int16范围
+ */
+static inline int32_t Filter_Sat16(int32_t v)
+{
+    if (v > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (v < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return v;
+}
+
+/**
+ * ============================================================================
+ * DSP内核参考实现
+ * ============================================================================
+ */
+
+uint32_t Filter_SMLAD_C(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    int32_t p_lo = (int32_t)FILTER_LO16(op1) * FILTER_LO16(op2);
+    int32_t p_hi = (int32_t)FILTER_HI16(op1) * FILTER_HI16(op2);
+
+    /* 与硬件一致: 32位回绕(硬件另置Q标志，此处不模拟) */
+    return op3 + (uint32_t)p_lo + (uint32_t)p_hi;
+}
+
+uint32_t Filter_QADD16_C(uint32_t op1, uint32_t op2)
+{
+    int32_t lo = Filter_Sat16((int32_t)FILTER_LO16(op1) + FILTER_LO16(op2));
+    int32_t hi = Filter_Sat16((int32_t)FILTER_HI16(op1) + FILTER_HI16(op2));
+
+    return FILTER_PACK16(lo, hi);
+}
+
+uint32_t Filter_QSUB16_C(uint32_t op1, uint32_t op2)
+{
+    int32_t lo = Filter_Sat16((int32_t)FILTER_LO16(op1) - FILTER_LO16(op2));
+    int32_t hi = Filter_Sat16((int32_t)FILTER_HI16(op1) - FILTER_HI16(op2));
+
+    return FILTER_PACK16(lo, hi);
+}
+
+/**
+ * ============================================================================
+ * 单通道滑动平均
+ * ============================================================================
+ */
+
+int Filter_MA_Init(Filter_MA_TypeDef *f, uint8_t len)
+{
+    int shift = Filter_Log2(len);
+
+    if (f == NULL || shift < 0 || len > FILTER_MA_MAX_LEN)
+    {
+        return -1;
+    }
+
+    memset(f, 0, sizeof(*f));
+    f->shift = (uint8_t)shift;
+    return 0;
+}
+
+MEM_FASTCODE int16_t Filter_MA_Update(Filter_MA_TypeDef *f, int16_t x)
+{
+    uint8_t len = (uint8_t)(1U << f->shift);
+    int32_t round = (f->shift != 0) ? (1L << (f->shift - 1)) : 0;
+
+    if (!f->primed)
+    {
+        /* 用首个样本填满窗口，避免启动阶段向0偏移 */
+        for (uint8_t i = 0; i < len; i++)
+        {
+            f->buf[i] = x;
+        }
+        f->sum = (int32_t)x << f->shift;
+        f->primed = 1;
+        return x;
+    }
+
+    f->sum += (int32_t)x - f->buf[f->idx];
+    f->buf[f->idx] = x;
+    f->idx = (uint8_t)((f->idx + 1) & (len - 1));
+
+    return (int16_t)((f->sum + round) >> f->shift);
+}
+
+/**
+ * ============================================================================
+ * 双通道打包滑动平均
+ * ============================================================================
+ */
+
+int Filter_MA2_Init(Filter_MA2_TypeDef *f, uint8_t len)
+{
+    int shift = Filter_Log2(len);
+
+    if (f == NULL || shift < 0 || len > FILTER_MA_MAX_LEN)
+    {
+        return -1;
+    }
+
+    memset(f, 0, sizeof(*f));
+    f->shift = (uint8_t)shift;
+    return 0;
+}
+
+MEM_FASTCODE uint32_t Filter_MA2_Update(Filter_MA2_TypeDef *f, uint32_t x)
+{
+    uint8_t len = (uint8_t)(1U << f->shift);
+    int32_t round = (f->shift != 0) ? (1L << (f->shift - 1)) : 0;
+    int32_t lo;
+    int32_t hi;
+
+    if (!f->primed)
+    {
+        for (uint8_t i = 0; i < len; i++)
+        {
+            f->buf[i] = x;
+        }
+        f->sum = FILTER_PACK16((int32_t)FILTER_LO16(x) << f->shift,
+                               (int32_t)FILTER_HI16(x) << f->shift);
+        f->primed = 1;
+        return x;
+    }
+
+    /* 先减旧样本再加新样本，中间结果始终不超过窗口和的上界 */
+    f->sum = FILTER_QSUB16(f->sum, f->buf[f->idx]);
+    f->sum = FILTER_QADD16(f->sum, x);
+    f->buf[f->idx] = x;
+    f->idx = (uint8_t)((f->idx + 1) & (len - 1));
+
+    lo = ((int32_t)FILTER_LO16(f->sum) + round) >> f->shift;
+    hi = ((int32_t)FILTER_HI16(f->sum) + round) >> f->shift;
+
+    return FILTER_PACK16(lo, hi);
+}
+
+/**
+ * ============================================================================
+ * 一阶IIR低通
+ * ============================================================================
+ */
+
+int Filter_IIR_Init(Filter_IIR_TypeDef *f, uint16_t alpha_q15)
+{
+    if (f == NULL || alpha_q15 == 0 || alpha_q15 > INT16_MAX)
+    {
+        return -1;
+    }
+
+    memset(f, 0, sizeof(*f));
+    /* a + (32768-a) = 1.0(Q15)，a>=1 保证 32768-a 可用int16表示 */
+    f->coef = FILTER_PACK16(alpha_q15, 32768U - alpha_q15);
+    return 0;
+}
+
+MEM_FASTCODE int16_t Filter_IIR_Update(Filter_IIR_TypeDef *f, int16_t x)
+{
+    uint32_t acc;
+
+    if (!f->primed)
+    {
+        f->y = x;
+        f->primed = 1;
+        return x;
+    }
+
+    /* a*x + (32768-a)*y + 0.5，一条SMLAD完成两次乘加 */
+    acc = FILTER_SMLAD(FILTER_PACK16(x, f->y), f->coef, 1UL << 14);
+    f->y = (int16_t)((int32_t)acc >> 15);
+
+    return f->y;
+}
+
+void Filter_IIR_Reset(Filter_IIR_TypeDef *f)
+{
+    f->primed = 0;
+}
+
+/**
+ * ============================================================================
+ * N点中值
+ * ============================================================================
+ */
+
+int Filter_Median_Init(Filter_Median_TypeDef *f, uint8_t len)
+{
+    if (f == NULL || len == 0 || len > FILTER_MEDIAN_MAX_LEN || (len & 1U) == 0)
+    {
+        return -1;
+    }
+
+    memset(f, 0, sizeof(*f));
+    f->len = len;
+    return 0;
+}
+
+void Filter_Median_Reset(Filter_Median_TypeDef *f)
+{
+    f->idx = 0;
+    f->primed = 0;
+}
+
+MEM_FASTCODE int16_t Filter_Median_Update(Filter_Median_TypeDef *f, int16_t x)
+{
+    int16_t sorted[FILTER_MEDIAN_MAX_LEN];
+
+    if (!f->primed)
+    {
+        for (uint8_t i = 0; i < f->len; i++)
+        {
+            f->buf[i] = x;
+        }
+        f->primed = 1;
+        return x;
+    }
+
+    f->buf[f->idx] = x;
+    f->idx++;
+    if (f->idx >= f->len)
+    {
+        f->idx = 0;
+    }
+
+    /* N不超过7，插入排序比选择算法更省代码且足够快 */
+    for (uint8_t i = 0; i < f->len; i++)
+    {
+        int16_t v = f->buf[i];
+        int8_t j = (int8_t)i - 1;
+
+        while (j >= 0 && sorted[j] > v)
+        {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+
+    return sorted[f->len / 2];
+}
+
+/**
+ * ============================================================================
+ * 抽取型CIC
+ * ============================================================================
+ */
+
+int Filter_CIC_Init(Filter_CIC_TypeDef *f, uint8_t order, uint16_t decim)
+{
+    int log2r = Filter_Log2(decim);
+
+    if (f == NULL || order == 0 || order > FILTER_CIC_MAX_ORDER || log2r < 1)
+    {
+        return -1;
+    }
+    if (order * log2r >= 32)
+    {
+        return -1;
+    }
+
+    memset(f, 0, sizeof(*f));
+    f->order = order;
+    f->decim = decim;
+    f->shift = (uint8_t)(order * log2r);
+    return 0;
+}
+
+MEM_FASTCODE int Filter_CIC_Update(Filter_CIC_TypeDef *f, int32_t x, int32_t *out)
+{
+    uint32_t v = (uint32_t)x;
+    uint32_t prev;
+
+    /* 积分器: 模2^32运算，中间溢出在梳状器中自然抵消 */
+    for (uint8_t i = 0; i < f->order; i++)
+    {
+        f->integ[i] += v;
+        v = f->integ[i];
+    }
+
+    if (++f->phase < f->decim)
+    {
+        return 0;
+    }
+    f->phase = 0;
+
+    /* 梳状器: 以抽取后速率运行 */
+    for (uint8_t i = 0; i < f->order; i++)
+    {
+        prev = f->comb[i];
+        f->comb[i] = v;
+        v -= prev;
+    }
+
+    *out = (int32_t)v >> f->shift;
+    return 1;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file filter.h
+ * @brief 定点数字滤波库头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 提供传感器采样常用的定点滤波器:
+ *       - 滑动平均(单通道 / 双通道打包)
+ *       - 一阶IIR低通
+ *       - N点中值
+ *       - 抽取型CIC
+ *
+ *       目标板(Cortex-M4, __ARM_FEATURE_DSP)上内核使用 __SMLAD/__QADD16/__QSUB16
+ *       主机上使用逐位等价的纯C实现(Filter_SMLAD_C 等)，两套实现结果完全一致
+ *       所有滤波器状态由调用者提供存储，不使用动态内存
+ */
+
+#ifndef __FILTER_H
+#define __FILTER_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 平台选择
+ * ============================================================================
+ */
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "stm32f4xx.h" /* CMSIS core_cmSimd.h: __SMLAD / __QADD16 / __QSUB16 */
+#define FILTER_USE_DSP 1
+#else
+#define FILTER_USE_DSP 0
+#endif
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define FILTER_MA_MAX_LEN 16    /**< 滑动平均最大窗口长度(必须为2的幂) */
+#define FILTER_MEDIAN_MAX_LEN 7 /**< 中值滤波最大点数(奇数) */
+#define FILTER_CIC_MAX_ORDER 4  /**< CIC最大阶数 */
+
+/**
+ * ============================================================================
+ * 滤波器状态结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 单通道滑动平均滤波器
+ *
+ * @note 窗口长度为2的幂，输出使用移位代替除法
+ *       第一个样本会填满整个窗口，避免启动阶段输出偏小
+ */
+typedef struct
+{
+    int16_t buf[FILTER_MA_MAX_LEN]; /**< 样本窗口 */
+    int32_t sum;                    /**< 窗口内样本和 */
+    uint8_t shift;                  /**< log2(窗口长度) */
+    uint8_t idx;                    /**< 下一个写入位置 */
+    uint8_t primed;                 /**< 是否已用首个样本填充 */
+} Filter_MA_TypeDef;
+
+/**
+ * @brief 双通道打包滑动平均滤波器
+ *
+ * @note 两个通道打包在一个32位字中(低半字=通道0，高半字=通道1)
+ *       累加使用 __QADD16/__QSUB16，一条指令同时更新两个通道
+ *       调用者需保证 窗口长度 × 样本最大绝对值 < 32768，此时饱和不会触发
+ */
+typedef struct
+{
+    uint32_t buf[FILTER_MA_MAX_LEN]; /**< 打包样本窗口 */
+    uint32_t sum;                    /**< 打包的两通道窗口和 */
+    uint8_t shift;                   /**< log2(窗口长度) */
+    uint8_t idx;                     /**< 下一个写入位置 */
+    uint8_t primed;                  /**< 是否已用首个样本填充 */
+} Filter_MA2_TypeDef;
+
+/**
+ * @brief 一阶IIR低通滤波器(Q15)
+ *
+ * @note y[n] = (a*x[n] + (32768-a)*y[n-1] + 16384) >> 15
+ *       两次乘加由一条 __SMLAD 完成
+ *       a越小截止频率越低，时间常数约为 32768/a 个样本
+ */
+typedef struct
+{
+    uint32_t coef; /**< 打包系数: 低半字=a, 高半字=32768-a */
+    int16_t y;     /**< 上一次输出 */
+    uint8_t primed;
+} Filter_IIR_TypeDef;
+
+/**
+ * @brief N点中值滤波器
+ */
+typedef struct
+{
+    int16_t buf[FILTER_MEDIAN_MAX_LEN]; /**< 最近N个样本 */
+    uint8_t len;                        /**< 点数N(奇数) */
+    uint8_t idx;                        /**< 下一个写入位置 */
+    uint8_t primed;
+} Filter_Median_TypeDef;
+
+/**
+ * @brief 抽取型CIC滤波器
+ *
+ * @note M阶积分器 + 抽取R + M阶梳状器(差分延迟1)
+ *       积分器使用32位模运算，溢出回绕不影响结果
+ *       要求: 输入位宽 + M*log2(R) <= 32
+ *       增益 R^M 通过右移 M*log2(R) 归一化
+ */
+typedef struct
+{
+    uint32_t integ[FILTER_CIC_MAX_ORDER]; /**< 积分器状态 */
+    uint32_t comb[FILTER_CIC_MAX_ORDER];  /**< 梳状器延迟状态 */
+    uint16_t decim;                       /**< 抽取因子R(2的幂) */
+    uint16_t phase;                       /**< 当前抽取相位 */
+    uint8_t order;                        /**< 阶数M */
+    uint8_t shift;                        /**< 归一化右移位数 */
+} Filter_CIC_TypeDef;
+
+/**
+ * ============================================================================
+ * DSP内核(目标板指令 / 主机参考实现)
+ * ============================================================================
+ */
+
+/**
+ * @brief __SMLAD 的纯C参考实现
+ * @author Yukikaze
+ *
+ * @return op3 + lo(op1)*lo(op2) + hi(op1)*hi(op2)，32位回绕
+ */
+uint32_t Filter_SMLAD_C(uint32_t op1, uint32_t op2, uint32_t op3);
+
+/**
+ * @brief __QADD16 的纯C参考实现(两个半字分别饱和相加)
+ * @author Yukikaze
+ */
+uint32_t Filter_QADD16_C(uint32_t op1, uint32_t op2);
+
+/**
+ * @brief __QSUB16 的纯C参考实现(两个半字分别饱和相减)
+ * @author Yukikaze
+ */
+uint32_t Filter_QSUB16_C(uint32_t op1, uint32_t op2);
+
+#if FILTER_USE_DSP
+#define FILTER_SMLAD(a, b, acc) __SMLAD((a), (b), (acc))
+#define FILTER_QADD16(a, b) __QADD16((a), (b))
+#define FILTER_QSUB16(a, b) __QSUB16((a), (b))
+#else
+#define FILTER_SMLAD(a, b, acc) Filter_SMLAD_C((a), (b), (acc))
+#define FILTER_QADD16(a, b) Filter_QADD16_C((a), (b))
+#define FILTER_QSUB16(a, b) Filter_QSUB16_C((a), (b))
+#endif
+
+/**
+ * @brief 将两个int16打包为一个32位字(低半字在前)
+ */
+#define FILTER_PACK16(lo, hi) \
+    ((uint32_t)(uint16_t)(lo) | ((uint32_t)(uint16_t)(hi) << 16))
+
+/**
+ * @brief 取打包字的低/高半字(有符号)
+ */
+#define FILTER_LO16(w) ((int16_t)(uint16_t)((w) & 0xFFFFU))
+#define FILTER_HI16(w) ((int16_t)(uint16_t)((w) >> 16))
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化单通道滑动平均
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param len 窗口长度(2的幂，1~FILTER_MA_MAX_LEN)
+ * @return int 0=成功, -1=参数错误
+ */
+int Filter_MA_Init(Filter_MA_TypeDef *f, uint8_t len);
+
+/**
+ * @brief 输入一个样本并返回当前平均值
+ * @author Yukikaze
+ */
+int16_t Filter_MA_Update(Filter_MA_TypeDef *f, int16_t x);
+
+/**
+ * @brief 初始化双通道打包滑动平均
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param len 窗口长度(2的幂，1~FILTER_MA_MAX_LEN)
+ * @return int 0=成功, -1=参数错误
+ */
+int Filter_MA2_Init(Filter_MA2_TypeDef *f, uint8_t len);
+
+/**
+ * @brief 输入一对样本并返回两通道平均值(打包)
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param x 打包样本，使用 FILTER_PACK16(ch0, ch1) 构造
+ * @return uint32_t 打包平均值，使用 FILTER_LO16/FILTER_HI16 拆分
+ */
+uint32_t Filter_MA2_Update(Filter_MA2_TypeDef *f, uint32_t x);
+
+/**
+ * @brief 初始化一阶IIR低通
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param alpha_q15 平滑系数a(Q15, 1~32767)
+ * @return int 0=成功, -1=参数错误
+ */
+int Filter_IIR_Init(Filter_IIR_TypeDef *f, uint16_t alpha_q15);
+
+/**
+ * @brief 输入一个样本并返回滤波输出
+ * @author Yukikaze
+ */
+int16_t Filter_IIR_Update(Filter_IIR_TypeDef *f, int16_t x);
+
+/**
+ * @brief 丢弃历史，下一个样本直接作为输出
+ * @author Yukikaze
+ *
+ * @note 已知输入发生阶跃时使用(如模拟看门狗确认的电平变化)，避免输出逐步追赶
+ */
+void Filter_IIR_Reset(Filter_IIR_TypeDef *f);
+
+/**
+ * @brief 初始化N点中值滤波
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param len 点数(奇数，1~FILTER_MEDIAN_MAX_LEN)
+ * @return int 0=成功, -1=参数错误
+ */
+int Filter_Median_Init(Filter_Median_TypeDef *f, uint8_t len);
+
+/**
+ * @brief 输入一个样本并返回最近N点的中值
+ * @author Yukikaze
+ */
+int16_t Filter_Median_Update(Filter_Median_TypeDef *f, int16_t x);
+
+/**
+ * @brief 丢弃窗口，下一个样本填满整个窗口
+ * @author Yukikaze
+ *
+ * @note 窗口中多数仍是阶跃前的样本时，中值会继续返回旧电平
+ */
+void Filter_Median_Reset(Filter_Median_TypeDef *f);
+
+/**
+ * @brief 初始化抽取型CIC
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param order 阶数M(1~FILTER_CIC_MAX_ORDER)
+ * @param decim 抽取因子R(2的幂，>=2)
+ * @return int 0=成功, -1=参数错误
+ */
+int Filter_CIC_Init(Filter_CIC_TypeDef *f, uint8_t order, uint16_t decim);
+
+/**
+ * @brief 输入一个样本，每R个样本产生一个输出
+ * @author Yukikaze
+ *
+ * @param f 滤波器
+ * @param x 输入样本
+ * @param out 输出样本(仅返回1时有效)
+ * @return int 1=产生输出, 0=无输出
+ *
+ * @note 可在中断中调用，无阻塞、无除法
+ */
+int Filter_CIC_Update(Filter_CIC_TypeDef *f, int32_t x, int32_t *out);
+
+#endif /* __FILTER_H */
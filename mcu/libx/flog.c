@@ -0,0 +1,339 @@
+/**
+ * @file flog.c
+ * @brief Flash追加式日志存储实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "flog.h"
+#include "crc.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有定义
+ * ============================================================================
+ */
+
+#define FLOG_SECTOR_MAGIC 0x474F4C46UL /**< "FLOG" */
+#define FLOG_HDR_SIZE 16U              /**< 扇区头大小(字节) */
+#define FLOG_BLOCK_MAGIC 0xB10CU       /**< 块头高半字 */
+#define FLOG_BLOCK_HDR 8U              /**< 块头大小: 魔数|长度 + CRC */
+#define FLOG_ERASED 0xFFFFFFFFUL       /**< 擦除后的字 */
+
+#define FLOG_BLANK_WORDS 16U           /**< 空白检查每次读取的字数 */
+
+#define FLOG_BATCH_BYTES (FLOG_BATCH_WORDS * 4U)
+#define FLOG_WORDS(len) (((uint32_t)(len) + 3U) >> 2)
+
+/* 块头损坏时跳过的长度: 写一半的块不会超出一个最大块 */
+#define FLOG_SKIP_BYTES (FLOG_BLOCK_HDR + FLOG_BATCH_BYTES)
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static uint32_t FLog_SectorAddr(const FLog_TypeDef *log, uint8_t sector)
+{
+    return log->base + (uint32_t)sector * log->sector_size;
+}
+
+/**
+ * @brief 读取扇区头
+ * @return int 0=有效(seq输出序号), -1=无效
+ */
+static int FLog_ReadHeader(const FLog_TypeDef *log, uint8_t sector, uint32_t *seq)
+{
+    uint32_t hdr[3];
+
+    if (log->ops->read(FLog_SectorAddr(log, sector), hdr, sizeof(hdr)) != 0)
+    {
+        return -1;
+    }
+    if (hdr[0] != FLOG_SECTOR_MAGIC || hdr[1] != ~hdr[2] || hdr[1] == 0)
+    {
+        return -1;
+    }
+    *seq = hdr[1];
+    return 0;
+}
+
+/**
+ * @brief 解析块头
+ * @return int 负载长度，块头无效返回-1
+ */
+static int FLog_BlockLen(const FLog_TypeDef *log, uint32_t off, uint32_t word0)
+{
+    uint32_t len = word0 & 0xFFFFU;
+
+    if ((word0 >> 16) != FLOG_BLOCK_MAGIC || len == 0 || len > FLOG_BATCH_BYTES ||
+        off + FLOG_BLOCK_HDR + FLOG_WORDS(len) * 4U > log->sector_size)
+    {
+        return -1;
+    }
+    return (int)len;
+}
+
+/**
+ * @brief 扫描当前扇区，定位下一个块的写入偏移
+ */
+static void FLog_ScanActive(FLog_TypeDef *log)
+{
+    uint32_t addr = FLog_SectorAddr(log, log->active);
+    uint32_t off = FLOG_HDR_SIZE;
+    uint32_t word0;
+    int len;
+
+    while (off + FLOG_BLOCK_HDR <= log->sector_size)
+    {
+        if (log->ops->read(addr + off, &word0, sizeof(word0)) != 0 || word0 == FLOG_ERASED)
+        {
+            break;
+        }
+
+        len = FLog_BlockLen(log, off, word0);
+        if (len < 0)
+        {
+            /* 块头写一半掉电: 跳过一个最大块，遍历时同样跳过 */
+            off += FLOG_SKIP_BYTES;
+            continue;
+        }
+        off += FLOG_BLOCK_HDR + FLOG_WORDS(len) * 4U;
+    }
+
+    log->wr_off = (off < log->sector_size) ? off : log->sector_size;
+}
+
+/**
+ * @brief 扇区是否全部为擦除态
+ */
+static int FLog_IsBlank(const FLog_TypeDef *log, uint32_t addr)
+{
+    uint32_t buf[FLOG_BLANK_WORDS];
+
+    for (uint32_t off = 0; off < log->sector_size; off += sizeof(buf))
+    {
+        uint32_t len = log->sector_size - off;
+
+        if (len > sizeof(buf))
+        {
+            len = sizeof(buf);
+        }
+        if (log->ops->read(addr + off, buf, len) != 0)
+        {
+            return 0;
+        }
+        for (uint32_t i = 0; i < len / 4U; i++)
+        {
+            if (buf[i] != FLOG_ERASED)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 擦除扇区并写入新的扇区头
+ *
+ * @note 扇区已是擦除态(新器件，或上次擦除后掉电)时跳过擦除，
+ *       省去一次整扇区擦除的停顿与磨损
+ */
+static int FLog_OpenSector(FLog_TypeDef *log, uint8_t sector, uint32_t seq)
+{
+    uint32_t addr = FLog_SectorAddr(log, sector);
+    uint32_t hdr[3];
+
+    hdr[0] = FLOG_SECTOR_MAGIC;
+    hdr[1] = seq;
+    hdr[2] = ~seq;
+
+    if (!FLog_IsBlank(log, addr))
+    {
+        log->erases++;
+        if (log->ops->erase(addr) != 0)
+        {
+            log->errors++;
+            return -1;
+        }
+    }
+    if (log->ops->program(addr, hdr, 3) != 0)
+    {
+        log->errors++;
+        return -1;
+    }
+
+    log->active = sector;
+    log->seq = seq;
+    log->wr_off = FLOG_HDR_SIZE;
+    return 0;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int FLog_Mount(FLog_TypeDef *log, const FLog_Ops_TypeDef *ops,
+               uint32_t base, uint32_t sector_size, uint8_t sector_count)
+{
+    uint32_t seq;
+    int found = 0;
+
+    if (log == NULL || ops == NULL || ops->erase == NULL || ops->program == NULL ||
+        ops->read == NULL || sector_count < 2 || sector_count > FLOG_MAX_SECTORS ||
+        (sector_size & 3U) != 0 || sector_size < FLOG_HDR_SIZE + FLOG_BLOCK_HDR + FLOG_BATCH_BYTES)
+    {
+        return -1;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->ops = ops;
+    log->base = base;
+    log->sector_size = sector_size;
+    log->sector_count = sector_count;
+
+    /* 序号最大的有效扇区为当前写入扇区 */
+    for (uint8_t i = 0; i < sector_count; i++)
+    {
+        if (FLog_ReadHeader(log, i, &seq) == 0 && (!found || seq > log->seq))
+        {
+            log->active = i;
+            log->seq = seq;
+            found = 1;
+        }
+    }
+
+    if (!found)
+    {
+        return (FLog_OpenSector(log, 0, 1) == 0) ? 1 : -1;
+    }
+
+    FLog_ScanActive(log);
+    return 0;
+}
+
+int FLog_Append(FLog_TypeDef *log, const void *data, uint8_t len)
+{
+    uint8_t *batch = (uint8_t *)log->batch;
+
+    if (data == NULL || len == 0)
+    {
+        return -1;
+    }
+
+    if (log->batch_len + 1U + len > FLOG_BATCH_BYTES && FLog_Flush(log) != 0)
+    {
+        return -1;
+    }
+
+    batch[log->batch_len] = len;
+    memcpy(&batch[log->batch_len + 1U], data, len);
+    log->batch_len = (uint16_t)(log->batch_len + 1U + len);
+    return 0;
+}
+
+int FLog_Flush(FLog_TypeDef *log)
+{
+    uint32_t words = FLOG_WORDS(log->batch_len);
+    uint32_t addr;
+    uint32_t hdr[2];
+    uint8_t next;
+
+    if (log->batch_len == 0)
+    {
+        return 0;
+    }
+
+    /* 当前扇区放不下时轮换到下一个扇区 */
+    if (log->wr_off + FLOG_BLOCK_HDR + words * 4U > log->sector_size)
+    {
+        next = (uint8_t)((log->active + 1U < log->sector_count) ? log->active + 1U : 0U);
+        if (FLog_OpenSector(log, next, log->seq + 1U) != 0)
+        {
+            return -1;
+        }
+    }
+
+    /* 尾部填充字节保持擦除态，CRC只覆盖有效长度 */
+    memset((uint8_t *)log->batch + log->batch_len, 0xFF, words * 4U - log->batch_len);
+    hdr[0] = ((uint32_t)FLOG_BLOCK_MAGIC << 16) | log->batch_len;
+    hdr[1] = CRC32_Update(0, log->batch, log->batch_len);
+
+    /* 先写块头: 之后无论何时掉电，挂载时都能跳过这个块 */
+    addr = FLog_SectorAddr(log, log->active) + log->wr_off;
+    log->wr_off += FLOG_BLOCK_HDR + words * 4U;
+    log->batch_len = 0;
+
+    if (log->ops->program(addr, hdr, 2) != 0 ||
+        log->ops->program(addr + FLOG_BLOCK_HDR, log->batch, words) != 0)
+    {
+        log->errors++;
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t FLog_Iterate(const FLog_TypeDef *log, FLog_Visit_t visit, void *ctx)
+{
+    uint32_t payload[FLOG_BATCH_WORDS];
+    const uint8_t *p = (const uint8_t *)payload;
+    uint32_t hdr[2];
+    uint32_t seq;
+    uint32_t addr;
+    uint32_t off;
+    uint32_t total = 0;
+    uint8_t sector;
+    int len;
+
+    if (log == NULL || visit == NULL)
+    {
+        return 0;
+    }
+
+    /* 当前扇区的下一个扇区最旧，按环形顺序遍历到当前扇区 */
+    for (uint8_t n = 1; n <= log->sector_count; n++)
+    {
+        sector = (uint8_t)((log->active + n) % log->sector_count);
+        if (FLog_ReadHeader(log, sector, &seq) != 0 || seq > log->seq)
+        {
+            continue;
+        }
+
+        addr = FLog_SectorAddr(log, sector);
+        off = FLOG_HDR_SIZE;
+        while (off + FLOG_BLOCK_HDR <= log->sector_size)
+        {
+            if (log->ops->read(addr + off, hdr, sizeof(hdr)) != 0 || hdr[0] == FLOG_ERASED)
+            {
+                break;
+            }
+            len = FLog_BlockLen(log, off, hdr[0]);
+            if (len < 0)
+            {
+                off += FLOG_SKIP_BYTES;
+                continue;
+            }
+
+            if (log->ops->read(addr + off + FLOG_BLOCK_HDR, payload, (uint32_t)len) == 0 &&
+                CRC32_Update(0, payload, (uint32_t)len) == hdr[1])
+            {
+                for (int i = 0; i < len && i + 1 + p[i] <= len && p[i] != 0; i += 1 + p[i])
+                {
+                    total++;
+                    if (visit(ctx, seq, &p[i + 1], p[i]) != 0)
+                    {
+                        return total;
+                    }
+                }
+            }
+            off += FLOG_BLOCK_HDR + FLOG_WORDS(len) * 4U;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file flog.h
+ * @brief Flash追加式日志存储头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 在若干个等大的Flash扇区上实现只追加的日志:
+ *       - 扇区头: 魔数 + 序号 + 序号反码，序号最大的扇区为当前写入扇区
+ *       - 数据块: 块头(魔数|长度) + CRC-32 + 按字对齐的负载，一次写入整块
+ *       - 块负载由若干条记录组成，每条记录为 [长度(1字节)][数据]
+ *       - 当前扇区写满后轮换到下一个扇区(擦除后写新序号)，最旧数据被覆盖，
+ *         各扇区擦除次数均衡；扇区已是擦除态时不再擦除
+ *
+ *       掉电恢复:
+ *       - 块头先于负载写入，负载写一半掉电时CRC不符，读取时跳过该块
+ *       - 块头写一半掉电(块头无效)时跳过一个最大块(8+256字节)，写入与遍历都从其后继续；
+ *         不把整个扇区视为已满，否则连续几次这样的掉电会把全部扇区轮换掉
+ *       - 擦除或写扇区头时掉电，该扇区头无效，挂载时忽略，下次轮换重新擦除
+ *
+ *       Flash访问全部通过 FLog_Ops_TypeDef，主机测试(mcu/sim/Test/test_flog.c)用RAM模拟Flash
+ *       并在任意一次写入/擦除中途注入掉电，验证上述恢复规则
+ */
+
+#ifndef __FLOG_H
+#define __FLOG_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define FLOG_BATCH_WORDS 64 /**< 块负载缓冲(字)，即一次写入的最大负载 */
+#define FLOG_MAX_SECTORS 8  /**< 最多管理的扇区数 */
+#define FLOG_RECORD_MAX 255 /**< 单条记录最大字节数 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief Flash访问接口
+ *
+ * @note 所有函数返回 0=成功, -1=失败
+ */
+typedef struct
+{
+    int (*erase)(uint32_t addr);                                          /**< 擦除addr所在扇区 */
+    int (*program)(uint32_t addr, const uint32_t *words, uint32_t count); /**< 按字写入 */
+    int (*read)(uint32_t addr, void *buf, uint32_t len);                  /**< 读取 */
+} FLog_Ops_TypeDef;
+
+/**
+ * @brief 日志实例
+ */
+typedef struct
+{
+    const FLog_Ops_TypeDef *ops;         /**< Flash访问接口 */
+    uint32_t base;                       /**< 第一个扇区地址 */
+    uint32_t sector_size;                /**< 扇区大小(字节) */
+    uint8_t sector_count;                /**< 扇区数(>=2) */
+    uint8_t active;                      /**< 当前写入扇区 */
+    uint32_t seq;                        /**< 当前写入扇区序号 */
+    uint32_t wr_off;                     /**< 当前扇区内下一个块的偏移 */
+    uint32_t batch[FLOG_BATCH_WORDS];    /**< 待写入的块负载 */
+    uint16_t batch_len;                  /**< 块负载已用字节数 */
+    uint32_t erases;                     /**< 本次上电以来的擦除次数 */
+    uint32_t errors;                     /**< Flash操作失败次数 */
+} FLog_TypeDef;
+
+/**
+ * @brief 记录遍历回调
+ *
+ * @param ctx 用户参数
+ * @param seq 记录所在扇区的序号
+ * @param data 记录数据
+ * @param len 记录长度
+ * @return int 0=继续, 非0=停止遍历
+ */
+typedef int (*FLog_Visit_t)(void *ctx, uint32_t seq, const uint8_t *data, uint8_t len);
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 挂载日志
+ * @author Yukikaze
+ *
+ * @param log 日志实例
+ * @param ops Flash访问接口
+ * @param base 第一个扇区地址
+ * @param sector_size 扇区大小(字节，4的倍数)
+ * @param sector_count 扇区数(2~FLOG_MAX_SECTORS)
+ * @return int 0=挂载已有日志, 1=无有效日志已格式化, -1=失败
+ *
+ * @note 只读取各扇区头并扫描当前扇区的块头，不校验负载
+ */
+int FLog_Mount(FLog_TypeDef *log, const FLog_Ops_TypeDef *ops,
+               uint32_t base, uint32_t sector_size, uint8_t sector_count);
+
+/**
+ * @brief 追加一条记录(先进入RAM缓冲)
+ * @author Yukikaze
+ *
+ * @param log 日志实例
+ * @param data 记录数据
+ * @param len 记录长度(1~FLOG_RECORD_MAX)
+ * @return int 0=成功, -1=失败
+ *
+ * @note 缓冲放不下时先写出已有缓冲
+ */
+int FLog_Append(FLog_TypeDef *log, const void *data, uint8_t len);
+
+/**
+ * @brief 将缓冲中的记录写入Flash
+ * @author Yukikaze
+ *
+ * @return int 0=成功(缓冲为空时直接返回), -1=失败
+ *
+ * @note 当前扇区放不下时会擦除下一个扇区，耗时较长
+ */
+int FLog_Flush(FLog_TypeDef *log);
+
+/**
+ * @brief 从旧到新遍历Flash中的全部有效记录
+ * @author Yukikaze
+ *
+ * @param log 日志实例
+ * @param visit 回调
+ * @param ctx 回调参数
+ * @return uint32_t 遍历的记录条数
+ *
+ * @note 不包含尚未写出的缓冲记录；CRC错误的块被跳过
+ */
+uint32_t FLog_Iterate(const FLog_TypeDef *log, FLog_Visit_t visit, void *ctx);
+
+#endif /* __FLOG_H */
@@ -0,0 +1,338 @@
+/**
+ * @file heapstat.c
+ * @brief 堆分配统计引擎实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "heapstat.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+#define HEAPSTAT_OTHER (HEAPSTAT_CALLER_MAX - 1U)
+
+/**
+ * @brief 地址的哈希槽位(堆块至少8字节对齐，先去掉低3位)
+ */
+static inline uint32_t HeapStat_Slot(uintptr_t ptr)
+{
+    return ((uint32_t)(ptr >> 3) * 2654435761UL) & (HEAPSTAT_LIVE_MAX - 1U);
+}
+
+/**
+ * @brief 查找活动分配，返回槽位，不存在返回HEAPSTAT_LIVE_MAX
+ */
+static uint32_t HeapStat_Find(const HeapStat_TypeDef *hs, uintptr_t ptr)
+{
+    uint32_t i = HeapStat_Slot(ptr);
+
+    for (uint32_t n = 0; n < HEAPSTAT_LIVE_MAX; n++)
+    {
+        if (hs->live[i].ptr == ptr)
+        {
+            return i;
+        }
+        if (hs->live[i].ptr == 0)
+        {
+            break;
+        }
+        i = (i + 1U) & (HEAPSTAT_LIVE_MAX - 1U);
+    }
+    return HEAPSTAT_LIVE_MAX;
+}
+
+/**
+ * @brief 删除槽位并后移填补(线性探测，保证后续查找不断链)
+ */
+static void HeapStat_Remove(HeapStat_TypeDef *hs, uint32_t hole)
+{
+    uint32_t i = hole;
+
+    for (;;)
+    {
+        uint32_t home;
+
+        i = (i + 1U) & (HEAPSTAT_LIVE_MAX - 1U);
+        if (hs->live[i].ptr == 0)
+        {
+            break;
+        }
+        /* 理想位置不在(hole, i]之间的项可以移到hole */
+        home = HeapStat_Slot(hs->live[i].ptr);
+        if (((i - home) & (HEAPSTAT_LIVE_MAX - 1U)) >= ((i - hole) & (HEAPSTAT_LIVE_MAX - 1U)))
+        {
+            hs->live[hole] = hs->live[i];
+            hole = i;
+        }
+    }
+    memset(&hs->live[hole], 0, sizeof(hs->live[hole]));
+    hs->live_count--;
+}
+
+/**
+ * @brief 查找或登记调用者，表满时归入"其他"
+ */
+static uint32_t HeapStat_Caller(HeapStat_TypeDef *hs, uintptr_t caller)
+{
+    for (uint32_t i = 0; i < hs->caller_count; i++)
+    {
+        if (hs->caller[i].caller == caller)
+        {
+            return i;
+        }
+    }
+    if (hs->caller_count < HEAPSTAT_OTHER)
+    {
+        hs->caller[hs->caller_count].caller = caller;
+        return hs->caller_count++;
+    }
+    return HEAPSTAT_OTHER;
+}
+
+/**
+ * @brief 块大小对应的直方图档
+ */
+static inline uint32_t HeapStat_Bin(uint32_t size)
+{
+    uint32_t bin;
+
+    if (size < (1UL << HEAPSTAT_HIST_MIN_SHIFT))
+    {
+        return 0;
+    }
+    bin = (31U - (uint32_t)__builtin_clz(size)) - HEAPSTAT_HIST_MIN_SHIFT + 1U;
+    return (bin < HEAPSTAT_HIST_BINS) ? bin : HEAPSTAT_HIST_BINS - 1U;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void HeapStat_Init(HeapStat_TypeDef *hs, uint32_t total)
+{
+    memset(hs, 0, sizeof(*hs));
+    hs->total = total;
+    hs->min_largest = UINT32_MAX;
+}
+
+void HeapStat_Alloc(HeapStat_TypeDef *hs, const void *ptr, uint32_t size, uintptr_t caller)
+{
+    uint32_t c = HeapStat_Caller(hs, caller);
+    HeapStat_Caller_TypeDef *cs = &hs->caller[c];
+
+    if (ptr == NULL)
+    {
+        hs->fails++;
+        cs->fails++;
+        return;
+    }
+
+    hs->allocs++;
+    hs->cur_bytes += size;
+    if (hs->cur_bytes > hs->peak_bytes)
+    {
+        hs->peak_bytes = hs->cur_bytes;
+    }
+    cs->allocs++;
+    cs->cur_bytes += size;
+    if (cs->cur_bytes > cs->peak_bytes)
+    {
+        cs->peak_bytes = cs->cur_bytes;
+    }
+
+    /* 保留一个空槽，查找总能在空槽处终止 */
+    if (hs->live_count < HEAPSTAT_LIVE_MAX - 1U)
+    {
+        uint32_t i = HeapStat_Slot((uintptr_t)ptr);
+
+        while (hs->live[i].ptr != 0)
+        {
+            i = (i + 1U) & (HEAPSTAT_LIVE_MAX - 1U);
+        }
+        hs->live[i].ptr = (uintptr_t)ptr;
+        hs->live[i].size = size;
+        hs->live[i].seq = hs->seq;
+        hs->live[i].caller = (uint8_t)c;
+        hs->live_count++;
+    }
+    else
+    {
+        hs->live_lost++;
+    }
+    hs->seq++;
+}
+
+void HeapStat_Free(HeapStat_TypeDef *hs, const void *ptr, uint32_t size)
+{
+    uint32_t i = HeapStat_Find(hs, (uintptr_t)ptr);
+
+    hs->frees++;
+    if (i < HEAPSTAT_LIVE_MAX)
+    {
+        HeapStat_Caller_TypeDef *cs = &hs->caller[hs->live[i].caller];
+
+        size = hs->live[i].size;
+        cs->frees++;
+        cs->cur_bytes -= (size < cs->cur_bytes) ? size : cs->cur_bytes;
+        HeapStat_Remove(hs, i);
+    }
+    else
+    {
+        /* 分配时表已满(或不是经钩子分配的)，只能按堆报告的大小扣减总量 */
+        hs->unknown_free++;
+    }
+    hs->cur_bytes -= (size < hs->cur_bytes) ? size : hs->cur_bytes;
+}
+
+void HeapStat_WalkBegin(HeapStat_TypeDef *hs)
+{
+    hs->w_bytes = 0;
+    hs->w_blocks = 0;
+    hs->w_largest = 0;
+    memset(hs->w_hist, 0, sizeof(hs->w_hist));
+}
+
+void HeapStat_WalkBlock(HeapStat_TypeDef *hs, uint32_t size)
+{
+    hs->w_bytes += size;
+    hs->w_blocks++;
+    if (size > hs->w_largest)
+    {
+        hs->w_largest = size;
+    }
+    hs->w_hist[HeapStat_Bin(size)]++;
+}
+
+void HeapStat_WalkEnd(HeapStat_TypeDef *hs, uint32_t t)
+{
+    HeapStat_Trend_TypeDef *tr = &hs->trend[hs->trend_head];
+
+    hs->free_bytes = hs->w_bytes;
+    hs->free_blocks = hs->w_blocks;
+    hs->largest = hs->w_largest;
+    memcpy(hs->hist, hs->w_hist, sizeof(hs->hist));
+    if (hs->largest < hs->min_largest)
+    {
+        hs->min_largest = hs->largest;
+    }
+    hs->walks++;
+
+    tr->t = t;
+    tr->largest = hs->largest;
+    tr->free = hs->free_bytes;
+    hs->trend_head = (hs->trend_head + 1U) % HEAPSTAT_TREND_LEN;
+    if (hs->trend_count < HEAPSTAT_TREND_LEN)
+    {
+        hs->trend_count++;
+    }
+}
+
+uint32_t HeapStat_FragPermille(const HeapStat_TypeDef *hs)
+{
+    if (hs->free_bytes == 0)
+    {
+        return 0;
+    }
+    return 1000U - (uint32_t)(((uint64_t)hs->largest * 1000U) / hs->free_bytes);
+}
+
+void HeapStat_Dump(const HeapStat_TypeDef *hs, HeapStat_Print_t print, uint32_t live_max)
+{
+    uint32_t frag = HeapStat_FragPermille(hs);
+    uint32_t last_seq = 0;
+    uint32_t listed = 0;
+
+    print("== heap: total %lu, allocated %lu (peak %lu), free %lu in %lu blocks, largest %lu (min %lu), frag %lu.%lu%%\r\n",
+          (unsigned long)hs->total,
+          (unsigned long)hs->cur_bytes,
+          (unsigned long)hs->peak_bytes,
+          (unsigned long)hs->free_bytes,
+          (unsigned long)hs->free_blocks,
+          (unsigned long)hs->largest,
+          (unsigned long)((hs->walks != 0) ? hs->min_largest : 0U),
+          (unsigned long)(frag / 10U),
+          (unsigned long)(frag % 10U));
+    print("   allocs %lu, frees %lu, fails %lu, live %lu (untracked %lu), unknown frees %lu\r\n",
+          (unsigned long)hs->allocs,
+          (unsigned long)hs->frees,
+          (unsigned long)hs->fails,
+          (unsigned long)hs->live_count,
+          (unsigned long)hs->live_lost,
+          (unsigned long)hs->unknown_free);
+
+    print("-- callers:  %10s %8s %8s %6s %8s %8s\r\n", "addr", "allocs", "frees", "fails", "cur", "peak");
+    for (uint32_t i = 0; i < HEAPSTAT_CALLER_MAX; i++)
+    {
+        const HeapStat_Caller_TypeDef *cs = &hs->caller[i];
+
+        if (cs->allocs == 0 && cs->fails == 0)
+        {
+            continue;
+        }
+        print("   %s 0x%08lx %8lu %8lu %6lu %8lu %8lu\r\n",
+              (i == HEAPSTAT_OTHER) ? "other " : "      ",
+              (unsigned long)cs->caller,
+              (unsigned long)cs->allocs,
+              (unsigned long)cs->frees,
+              (unsigned long)cs->fails,
+              (unsigned long)cs->cur_bytes,
+              (unsigned long)cs->peak_bytes);
+    }
+
+    print("-- free blocks by size:");
+    for (uint32_t i = 0; i < HEAPSTAT_HIST_BINS; i++)
+    {
+        if (hs->hist[i] != 0)
+        {
+            print(" %s%lu:%lu",
+                  (i == 0) ? "<" : "",
+                  (unsigned long)((i == 0) ? (1UL << HEAPSTAT_HIST_MIN_SHIFT)
+                                           : (1UL << (HEAPSTAT_HIST_MIN_SHIFT + i - 1U))),
+                  (unsigned long)hs->hist[i]);
+        }
+    }
+    print("\r\n-- largest free (t:largest/free), oldest first:");
+    for (uint32_t n = 0; n < hs->trend_count; n++)
+    {
+        const HeapStat_Trend_TypeDef *tr =
+            &hs->trend[(hs->trend_head + HEAPSTAT_TREND_LEN - hs->trend_count + n) % HEAPSTAT_TREND_LEN];
+
+        print(" %lu:%lu/%lu", (unsigned long)tr->t, (unsigned long)tr->largest, (unsigned long)tr->free);
+    }
+
+    /* 按分配序号从老到新列出(最老的未释放分配最可能是泄漏) */
+    print("\r\n-- live allocations, oldest first:\r\n");
+    while (listed < live_max && listed < hs->live_count)
+    {
+        const HeapStat_Live_TypeDef *oldest = NULL;
+
+        for (uint32_t i = 0; i < HEAPSTAT_LIVE_MAX; i++)
+        {
+            const HeapStat_Live_TypeDef *e = &hs->live[i];
+
+            if (e->ptr != 0 && (listed == 0 || e->seq > last_seq) &&
+                (oldest == NULL || e->seq < oldest->seq))
+            {
+                oldest = e;
+            }
+        }
+        if (oldest == NULL)
+        {
+            break;
+        }
+        print("   #%lu 0x%08lx %6lu B  caller 0x%08lx\r\n",
+              (unsigned long)oldest->seq,
+              (unsigned long)oldest->ptr,
+              (unsigned long)oldest->size,
+              (unsigned long)hs->caller[oldest->caller].caller);
+        last_seq = oldest->seq;
+        listed++;
+    }
+}
@@ -0,0 +1,207 @@
+/**
+ * @file heapstat.h
+ * @brief 堆分配统计引擎头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 由堆的分配/释放钩子驱动，统计:
+ *       - 活动分配表: 每个未释放分配的地址、大小、调用者与分配序号(开放寻址哈希)
+ *       - 调用者表: 按调用者(分配函数的返回地址)累计分配/释放/失败次数与当前/峰值字节数
+ *       - 空闲块直方图: 遍历空闲链表时按2的幂分档，同时得到空闲总量、最大块与碎片率
+ *       - 最大空闲块趋势: 每次遍历记录一个(时间, 最大空闲块, 空闲总量)样本
+ *       表容量固定，溢出时计数(live_lost/unknown_free)，总量仍按堆报告的块大小扣减，
+ *       但未记录的分配释放时无法归属调用者，该调用者的当前字节数会偏大
+ *       本模块不加锁，由调用者保证互斥
+ *       本模块不访问任何硬件，可在主机上与heap_4一起编译，用合成分配序列验证
+ */
+
+#ifndef __HEAPSTAT_H
+#define __HEAPSTAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+
+#ifndef HEAPSTAT_LIVE_MAX
+#define HEAPSTAT_LIVE_MAX 64U     /**< 活动分配表容量(2的幂) */
+#endif
+
+#ifndef HEAPSTAT_CALLER_MAX
+#define HEAPSTAT_CALLER_MAX 16U   /**< 调用者表容量(最后一项汇总表满后的其他调用者) */
+#endif
+
+#ifndef HEAPSTAT_TREND_LEN
+#define HEAPSTAT_TREND_LEN 32U    /**< 最大空闲块趋势样本数 */
+#endif
+
+#define HEAPSTAT_HIST_BINS 12U    /**< 直方图档数: <16, 16~31, ..., >=16K */
+#define HEAPSTAT_HIST_MIN_SHIFT 4U /**< 第1档下界为 1<<4 */
+
+#if ((HEAPSTAT_LIVE_MAX & (HEAPSTAT_LIVE_MAX - 1U)) != 0)
+#error "HEAPSTAT_LIVE_MAX must be a power of two"
+#endif
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 活动分配
+ */
+typedef struct
+{
+    uintptr_t ptr;   /**< 地址(0=空槽) */
+    uint32_t size;   /**< 大小(字节，含堆块头) */
+    uint32_t seq;    /**< 分配序号(越小越老) */
+    uint8_t caller;  /**< 调用者表下标 */
+    uint8_t reserved[3];
+} HeapStat_Live_TypeDef;
+
+/**
+ * @brief 调用者统计
+ */
+typedef struct
+{
+    uintptr_t caller;    /**< 调用者地址(0=其他) */
+    uint32_t allocs;     /**< 成功分配次数 */
+    uint32_t frees;      /**< 释放次数 */
+    uint32_t fails;      /**< 失败次数 */
+    uint32_t cur_bytes;  /**< 当前字节数 */
+    uint32_t peak_bytes; /**< 峰值字节数 */
+} HeapStat_Caller_TypeDef;
+
+/**
+ * @brief 趋势样本
+ */
+typedef struct
+{
+    uint32_t t;       /**< 时间戳(调用者定义单位) */
+    uint32_t largest; /**< 最大空闲块(字节) */
+    uint32_t free;    /**< 空闲总量(字节) */
+} HeapStat_Trend_TypeDef;
+
+/**
+ * @brief 统计状态
+ */
+typedef struct
+{
+    uint32_t total;        /**< 堆总量(字节) */
+    uint32_t cur_bytes;    /**< 当前分配字节数(按钩子统计) */
+    uint32_t peak_bytes;   /**< 分配字节数峰值 */
+    uint32_t allocs;       /**< 成功分配次数 */
+    uint32_t frees;        /**< 释放次数 */
+    uint32_t fails;        /**< 失败次数 */
+    uint32_t seq;          /**< 下一个分配序号 */
+    uint32_t live_count;   /**< 活动分配表中的项数 */
+    uint32_t live_lost;    /**< 表满未记录的分配数 */
+    uint32_t unknown_free; /**< 释放了表中没有的地址的次数 */
+
+    /* 最近一次空闲链表遍历 */
+    uint32_t free_bytes;   /**< 空闲总量 */
+    uint32_t free_blocks;  /**< 空闲块数 */
+    uint32_t largest;      /**< 最大空闲块 */
+    uint32_t min_largest;  /**< 历次遍历中最大空闲块的最小值 */
+    uint32_t walks;        /**< 遍历次数 */
+    uint32_t hist[HEAPSTAT_HIST_BINS];
+
+    /* 遍历中的临时累计 */
+    uint32_t w_bytes;
+    uint32_t w_blocks;
+    uint32_t w_largest;
+    uint32_t w_hist[HEAPSTAT_HIST_BINS];
+
+    HeapStat_Live_TypeDef live[HEAPSTAT_LIVE_MAX];
+    HeapStat_Caller_TypeDef caller[HEAPSTAT_CALLER_MAX];
+    uint32_t caller_count;
+
+    HeapStat_Trend_TypeDef trend[HEAPSTAT_TREND_LEN];
+    uint32_t trend_head;   /**< 下一个写入位置 */
+    uint32_t trend_count;
+} HeapStat_TypeDef;
+
+/**
+ * @brief 输出函数(与printf兼容)
+ */
+typedef int (*HeapStat_Print_t)(const char *fmt, ...);
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化
+ * @author Yukikaze
+ *
+ * @param hs 统计状态
+ * @param total 堆总量(字节，用于计算使用率)
+ */
+void HeapStat_Init(HeapStat_TypeDef *hs, uint32_t total);
+
+/**
+ * @brief 记录一次分配
+ * @author Yukikaze
+ *
+ * @param hs 统计状态
+ * @param ptr 返回的地址(NULL表示失败)
+ * @param size 大小(字节)
+ * @param caller 调用者地址
+ */
+void HeapStat_Alloc(HeapStat_TypeDef *hs, const void *ptr, uint32_t size, uintptr_t caller);
+
+/**
+ * @brief 记录一次释放
+ * @author Yukikaze
+ *
+ * @param hs 统计状态
+ * @param ptr 释放的地址
+ * @param size 堆报告的块大小(地址不在活动表中时使用)
+ */
+void HeapStat_Free(HeapStat_TypeDef *hs, const void *ptr, uint32_t size);
+
+/**
+ * @brief 开始一次空闲链表遍历
+ * @author Yukikaze
+ */
+void HeapStat_WalkBegin(HeapStat_TypeDef *hs);
+
+/**
+ * @brief 遍历中报告一个空闲块
+ * @author Yukikaze
+ */
+void HeapStat_WalkBlock(HeapStat_TypeDef *hs, uint32_t size);
+
+/**
+ * @brief 结束遍历，更新直方图并记录一个趋势样本
+ * @author Yukikaze
+ *
+ * @param hs 统计状态
+ * @param t 样本时间戳
+ */
+void HeapStat_WalkEnd(HeapStat_TypeDef *hs, uint32_t t);
+
+/**
+ * @brief 碎片率(千分比): 1 - 最大空闲块/空闲总量
+ * @author Yukikaze
+ */
+uint32_t HeapStat_FragPermille(const HeapStat_TypeDef *hs);
+
+/**
+ * @brief 输出完整报告
+ * @author Yukikaze
+ *
+ * @param hs 统计状态
+ * @param print 输出函数
+ * @param live_max 最多列出的活动分配数(按分配序号从老到新)
+ */
+void HeapStat_Dump(const HeapStat_TypeDef *hs, HeapStat_Print_t print, uint32_t live_max);
+
+#endif /* __HEAPSTAT_H */
@@ -0,0 +1,88 @@
+/**
+ * @file lut.c
+ * @brief 分段线性查找表插值实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "lut.h"
+#include <string.h>
+
+int LUT_Build(LUT_TypeDef *lut, const uint16_t *x, const int32_t *y, uint8_t count)
+{
+    int64_t slope;
+
+    if (lut == NULL || x == NULL || y == NULL || count < 2 || count > LUT_MAX_POINTS)
+    {
+        return -1;
+    }
+
+    memset(lut, 0, sizeof(*lut));
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (i > 0 && x[i] <= x[i - 1])
+        {
+            return -1;
+        }
+        lut->x[i] = x[i];
+        lut->y[i] = y[i];
+    }
+
+    /* 除法只在建表时进行一次，结果四舍五入到Q16 */
+    for (uint8_t i = 0; i + 1 < count; i++)
+    {
+        int64_t dy = ((int64_t)y[i + 1] - y[i]) * 65536;
+        int64_t dx = (int64_t)x[i + 1] - x[i];
+
+        slope = (dy >= 0) ? (dy + dx / 2) / dx : (dy - dx / 2) / dx;
+        if (slope > INT32_MAX || slope < INT32_MIN)
+        {
+            lut->count = 0;
+            return -1;
+        }
+        lut->slope_q16[i] = (int32_t)slope;
+    }
+
+    lut->count = count;
+    return 0;
+}
+
+int32_t LUT_Interp(const LUT_TypeDef *lut, uint16_t x)
+{
+    uint8_t lo = 0;
+    uint8_t hi;
+
+    if (lut->count == 0)
+    {
+        return 0;
+    }
+    if (x <= lut->x[0])
+    {
+        return lut->y[0];
+    }
+
+    hi = (uint8_t)(lut->count - 1);
+    if (x >= lut->x[hi])
+    {
+        return lut->y[hi];
+    }
+
+    /* 二分查找满足 x[lo] <= x < x[lo+1] 的段 */
+    while (hi - lo > 1)
+    {
+        uint8_t mid = (uint8_t)((lo + hi) >> 1);
+
+        if (lut->x[mid] <= x)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lut->y[lo] +
+           (int32_t)(((int64_t)(x - lut->x[lo]) * lut->slope_q16[lo] + 0x8000) >> 16);
+}
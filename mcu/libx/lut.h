@@ -0,0 +1,74 @@
+/**
+ * @file lut.h
+ * @brief 分段线性查找表插值头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 建表时一次性计算各段斜率(Q16)，之后每次插值只需
+ *       一次二分查找 + 一次乘法 + 移位，不含除法
+ *       本模块不访问任何硬件，可直接在主机上编译验证
+ */
+
+#ifndef __LUT_H
+#define __LUT_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define LUT_MAX_POINTS 16 /**< 最大标定点数 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 分段线性查找表
+ *
+ * @note x 严格递增；y 可增可减
+ *       每段斜率 |dy/dx| 必须小于 32768，否则建表失败
+ */
+typedef struct
+{
+    uint16_t x[LUT_MAX_POINTS];             /**< 横坐标(如ADC计数) */
+    int32_t y[LUT_MAX_POINTS];              /**< 纵坐标(如lux) */
+    int32_t slope_q16[LUT_MAX_POINTS - 1];  /**< 各段斜率(Q16) */
+    uint8_t count;                          /**< 点数 */
+} LUT_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 建立查找表
+ * @author Yukikaze
+ *
+ * @param lut 查找表
+ * @param x 横坐标数组(严格递增)
+ * @param y 纵坐标数组
+ * @param count 点数(2~LUT_MAX_POINTS)
+ * @return int 0=成功, -1=参数错误/非递增/斜率越界
+ */
+int LUT_Build(LUT_TypeDef *lut, const uint16_t *x, const int32_t *y, uint8_t count);
+
+/**
+ * @brief 查表插值
+ * @author Yukikaze
+ *
+ * @param lut 查找表
+ * @param x 横坐标
+ * @return int32_t 插值结果，超出表范围时钳位到端点值
+ *
+ * @note 在标定点上结果精确等于标定值；段内与精确线性插值的误差小于1
+ */
+int32_t LUT_Interp(const LUT_TypeDef *lut, uint16_t x);
+
+#endif /* __LUT_H */
@@ -0,0 +1,84 @@
+/**
+ * @file mem_section.h
+ * @brief 存储段放置宏
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 目标板上将变量放入链接脚本中的指定输出段，主机编译时宏为空
+ *       CCMRAM(64KB, 0x10000000)为CPU专用的零等待内存，DMA无法访问，
+ *       只能存放CPU独占的数据(任务栈、TCB、环形缓冲、滤波器状态等)
+ *       启动代码(startup_stm32f429_439xx.s)负责从Flash复制.ccmram并清零.ccmbss，
+ *       因此这两个段与.data/.bss语义相同；.noinit从不初始化
+ */
+
+#ifndef __MEM_SECTION_H
+#define __MEM_SECTION_H
+
+#if defined(__arm__)
+/* 有初值的CCMRAM变量(.ccmram，初值在Flash中，启动时复制) */
+#define MEM_CCMRAM __attribute__((section(".ccmram")))
+/* 零初始化的CCMRAM变量(.ccmbss，无Flash镜像，启动时清零) */
+#define MEM_CCMBSS __attribute__((section(".ccmbss")))
+/* 不初始化的CCMRAM变量(.noinit)，启动代码从不触碰，内容可跨热复位保留，用于事后分析 */
+#define MEM_NOINIT __attribute__((section(".noinit")))
+#else
+#define MEM_CCMRAM
+#define MEM_CCMBSS
+#define MEM_NOINIT
+#endif
+
+/**
+ * ============================================================================
+ * 按用途的放置宏
+ * ============================================================================
+ *
+ * 默认全部放入CCMRAM，192KB主SRAM留给DMA缓冲；CCMRAM不足时可在编译选项中
+ * 把某一项定义为空(例如 -DMEM_PLACE_FRAMEBUF=)，该类对象即回到.bss
+ * 注意: 放入CCMRAM的对象(包括任务栈上的局部变量)不能作为DMA的源或目的
+ */
+
+/* 任务栈(app_task静态栈与空闲任务栈) */
+#ifndef MEM_PLACE_STACK
+#define MEM_PLACE_STACK MEM_CCMBSS
+#endif
+
+/* 任务控制块(StaticTask_t) */
+#ifndef MEM_PLACE_TCB
+#define MEM_PLACE_TCB MEM_CCMBSS
+#endif
+
+/* 数字滤波器状态(filter.h中的各类滤波器) */
+#ifndef MEM_PLACE_FILTER
+#define MEM_PLACE_FILTER MEM_CCMBSS
+#endif
+
+/* 显示帧缓冲(CPU绘制、软件I2C刷屏，不经过DMA) */
+#ifndef MEM_PLACE_FRAMEBUF
+#define MEM_PLACE_FRAMEBUF MEM_CCMBSS
+#endif
+
+/**
+ * ============================================================================
+ * 代码放置(性能构建)
+ * ============================================================================
+ *
+ * 180MHz下Flash有5个等待周期，ART加速器只缓存1KB指令，中断与调度器这类跳转密集、
+ * 间隔执行的代码经常未命中；性能构建(-DAPP_PERF_PROFILE=ON)中:
+ * - MEM_FASTCODE: 放入.fastcode段，位于主SRAM(零等待)，启动时从Flash复制；
+ *   CCMRAM只连接D总线，不能执行代码。与Flash中函数的相互调用经链接器生成的跳板
+ * - MEM_COLD: 只在出错或初始化时执行的函数，编译器按大小优化并移出热点代码
+ * 默认构建中两者为空，代码布局不变
+ */
+#ifndef APP_PERF_PROFILE
+#define APP_PERF_PROFILE 0
+#endif
+
+#if defined(__arm__) && (APP_PERF_PROFILE == 1)
+#define MEM_FASTCODE __attribute__((section(".fastcode")))
+#define MEM_COLD __attribute__((cold))
+#else
+#define MEM_FASTCODE
+#define MEM_COLD
+#endif
+
+#endif /* __MEM_SECTION_H */
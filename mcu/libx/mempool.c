@@ -0,0 +1,267 @@
+/**
+ * @file mempool.c
+ * @brief 定长块内存池实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "mempool.h"
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+#define MEMPOOL_IDX(h) ((uint16_t)((h) & 0xFFFFU))
+#define MEMPOOL_HEAD(h, idx) ((((h) + 0x10000UL) & 0xFFFF0000UL) | (uint32_t)(idx))
+
+/**
+ * @brief 块号对应的用户区地址
+ */
+static inline uint8_t *MemPool_Block(const MemPool_TypeDef *p, uint16_t idx)
+{
+    return p->mem + (uint32_t)idx * p->stride + MEMPOOL_GUARD_BYTES;
+}
+
+/**
+ * @brief 更新占用峰值(CAS取最大值)
+ */
+static void MemPool_NoteUsed(MemPool_TypeDef *p, uint32_t used)
+{
+    uint32_t hw = __atomic_load_n(&p->high_water, __ATOMIC_RELAXED);
+
+    while (used > hw &&
+           !__atomic_compare_exchange_n(&p->high_water, &hw, used, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+#if (MEMPOOL_GUARD == 1)
+/**
+ * @brief 写入块前后的守护字
+ */
+static void MemPool_SetGuard(const MemPool_TypeDef *p, uint8_t *blk)
+{
+    uint32_t g = MEMPOOL_GUARD_WORD;
+
+    for (uint32_t i = 0; i < MEMPOOL_GUARD_BYTES; i += sizeof(g))
+    {
+        memcpy(blk - MEMPOOL_GUARD_BYTES + i, &g, sizeof(g));
+        memcpy(blk + p->stride - 2U * MEMPOOL_GUARD_BYTES + i, &g, sizeof(g));
+    }
+}
+
+/**
+ * @brief 检查守护字，1=完好
+ */
+static int MemPool_CheckGuard(const MemPool_TypeDef *p, const uint8_t *blk)
+{
+    uint32_t g = MEMPOOL_GUARD_WORD;
+
+    for (uint32_t i = 0; i < MEMPOOL_GUARD_BYTES; i += sizeof(g))
+    {
+        if (memcmp(blk - MEMPOOL_GUARD_BYTES + i, &g, sizeof(g)) != 0 ||
+            memcmp(blk + p->stride - 2U * MEMPOOL_GUARD_BYTES + i, &g, sizeof(g)) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 检查空闲块的毒化填充是否完好，1=完好
+ */
+static int MemPool_CheckPoison(const MemPool_TypeDef *p, const uint8_t *blk)
+{
+    uint32_t n = p->stride - 2U * MEMPOOL_GUARD_BYTES;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (blk[i] != MEMPOOL_POISON)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int MemPool_Init(MemPool_TypeDef *p, void *mem, uint16_t *next, uint16_t size, uint16_t count)
+{
+    if (p == NULL || mem == NULL || next == NULL || size == 0 ||
+        count == 0 || count > MEMPOOL_MAX_BLOCKS ||
+        ((uintptr_t)mem & (MEMPOOL_ALIGN - 1U)) != 0)
+    {
+        return -1;
+    }
+
+    memset(p, 0, sizeof(*p));
+    p->mem = (uint8_t *)mem;
+    p->next = next;
+    p->size = size;
+    p->stride = (uint16_t)MEMPOOL_STRIDE(size);
+    p->count = count;
+
+    /* 按地址顺序串成空闲链表，先分配低地址块 */
+    for (uint16_t i = 0; i < count; i++)
+    {
+        next[i] = (i + 1U < count) ? (uint16_t)(i + 1U) : MEMPOOL_NIL;
+#if (MEMPOOL_GUARD == 1)
+        memset(MemPool_Block(p, i), MEMPOOL_POISON, p->stride - 2U * MEMPOOL_GUARD_BYTES);
+        MemPool_SetGuard(p, MemPool_Block(p, i));
+#endif
+    }
+    p->head = 0;
+    return 0;
+}
+
+void *MemPool_Alloc(MemPool_TypeDef *p)
+{
+    uint32_t old = __atomic_load_n(&p->head, __ATOMIC_ACQUIRE);
+    uint32_t new_head;
+    uint16_t idx;
+    uint8_t *blk;
+
+    do
+    {
+        idx = MEMPOOL_IDX(old);
+        if (idx == MEMPOOL_NIL)
+        {
+            __atomic_fetch_add(&p->fails, 1U, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        /* 读到的链接可能已过时(idx被别人取走)，此时版本号已变，CAS必然失败 */
+        new_head = MEMPOOL_HEAD(old, __atomic_load_n(&p->next[idx], __ATOMIC_RELAXED));
+    } while (!__atomic_compare_exchange_n(&p->head, &old, new_head, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    __atomic_store_n(&p->next[idx], MEMPOOL_BUSY, __ATOMIC_RELAXED);
+    MemPool_NoteUsed(p, __atomic_add_fetch(&p->used, 1U, __ATOMIC_RELAXED));
+    __atomic_fetch_add(&p->allocs, 1U, __ATOMIC_RELAXED);
+
+    blk = MemPool_Block(p, idx);
+#if (MEMPOOL_GUARD == 1)
+    if (!MemPool_CheckPoison(p, blk))
+    {
+        /* 释放后仍被写过 */
+        __atomic_fetch_add(&p->errors, 1U, __ATOMIC_RELAXED);
+    }
+#endif
+    return blk;
+}
+
+int MemPool_Free(MemPool_TypeDef *p, void *ptr)
+{
+    uint32_t offset;
+    uint32_t old;
+    uint16_t idx;
+    uint16_t state = MEMPOOL_BUSY;
+    int ret = MEMPOOL_OK;
+
+    if (ptr == NULL)
+    {
+        return MEMPOOL_OK;
+    }
+
+    offset = (uint32_t)((uint8_t *)ptr - p->mem);
+    if (!MemPool_Owns(p, ptr) || offset % p->stride != MEMPOOL_GUARD_BYTES)
+    {
+        __atomic_fetch_add(&p->errors, 1U, __ATOMIC_RELAXED);
+        return MEMPOOL_ERR_PTR;
+    }
+    idx = (uint16_t)(offset / p->stride);
+
+    /* 只有已分配的块才能释放；失败说明块已在空闲链表中或正被另一处释放 */
+    if (!__atomic_compare_exchange_n(&p->next[idx], &state, MEMPOOL_FREEING, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        __atomic_fetch_add(&p->errors, 1U, __ATOMIC_RELAXED);
+        return MEMPOOL_ERR_DOUBLE;
+    }
+
+#if (MEMPOOL_GUARD == 1)
+    if (!MemPool_CheckGuard(p, (uint8_t *)ptr))
+    {
+        __atomic_fetch_add(&p->errors, 1U, __ATOMIC_RELAXED);
+        ret = MEMPOOL_ERR_GUARD;
+    }
+    memset(ptr, MEMPOOL_POISON, p->stride - 2U * MEMPOOL_GUARD_BYTES);
+    MemPool_SetGuard(p, (uint8_t *)ptr);
+#endif
+
+    /* 先减计数再归还，保证used不会超过实际占用 */
+    __atomic_fetch_sub(&p->used, 1U, __ATOMIC_RELAXED);
+
+    old = __atomic_load_n(&p->head, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n(&p->next[idx], MEMPOOL_IDX(old), __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&p->head, &old, MEMPOOL_HEAD(old, idx), 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    return ret;
+}
+
+int MemPool_Owns(const MemPool_TypeDef *p, const void *ptr)
+{
+    const uint8_t *b = (const uint8_t *)ptr;
+
+    return b >= p->mem && b < p->mem + (uint32_t)p->stride * p->count;
+}
+
+void MemPool_GetStats(const MemPool_TypeDef *p, MemPool_Stats_TypeDef *s)
+{
+    s->size = p->size;
+    s->count = p->count;
+    s->used = __atomic_load_n(&p->used, __ATOMIC_RELAXED);
+    s->high_water = __atomic_load_n(&p->high_water, __ATOMIC_RELAXED);
+    s->allocs = __atomic_load_n(&p->allocs, __ATOMIC_RELAXED);
+    s->fails = __atomic_load_n(&p->fails, __ATOMIC_RELAXED);
+    s->errors = __atomic_load_n(&p->errors, __ATOMIC_RELAXED);
+}
+
+void *MemPool_SetAlloc(MemPool_TypeDef *const *pools, uint32_t n, size_t size)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        void *blk;
+
+        if (pools[i]->size < size)
+        {
+            continue;
+        }
+        blk = MemPool_Alloc(pools[i]);
+        if (blk != NULL)
+        {
+            return blk;
+        }
+    }
+    return NULL;
+}
+
+int MemPool_SetFree(MemPool_TypeDef *const *pools, uint32_t n, void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return MEMPOOL_OK;
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (MemPool_Owns(pools[i], ptr))
+        {
+            return MemPool_Free(pools[i], ptr);
+        }
+    }
+    return MEMPOOL_ERR_PTR;
+}
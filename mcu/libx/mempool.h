@@ -0,0 +1,193 @@
+/**
+ * @file mempool.h
+ * @brief 定长块内存池头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个池管理count个大小相同的块，空闲块以块号组成单链表(链接存放在独立的next数组中):
+ *       - 分配/释放都是对链表头的一次CAS，O(1)，不关中断、不挂起调度器，可在中断中使用
+ *       - 链表头为32位: 高16位版本号 + 低16位块号，每次修改版本号加1，避免ABA
+ *       - 已分配块的next项置为MEMPOOL_BUSY，释放时据此识别重复释放与非法指针
+ *       - 每个池统计当前占用、占用峰值、分配次数、失败次数与错误次数
+ *       - MEMPOOL_GUARD == 1 时每块前后各加8字节守护字，释放时检查越界写；
+ *         空闲块填充MEMPOOL_POISON，分配时检查释放后写(开销与块大小成正比，仅用于调试)
+ *       多个池按块大小升序组成一组时，可按请求大小自动选择(满时退到更大的池)
+ *       使用GCC __atomic 内建函数(Cortex-M4上为LDREX/STREX)，目标板与主机行为一致，可直接在主机上编译验证
+ */
+
+#ifndef __MEMPOOL_H
+#define __MEMPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+
+/* 守护字/毒化调试模式 */
+#ifndef MEMPOOL_GUARD
+#define MEMPOOL_GUARD 0
+#endif
+
+#define MEMPOOL_ALIGN 8U              /**< 块对齐(字节) */
+#define MEMPOOL_MAX_BLOCKS 0xFFF0U    /**< 单个池的最大块数(块号为16位) */
+#define MEMPOOL_NIL 0xFFFFU           /**< 空链表 */
+#define MEMPOOL_BUSY 0xFFFEU          /**< next项: 块已分配 */
+#define MEMPOOL_FREEING 0xFFFDU       /**< next项: 块正在释放 */
+#define MEMPOOL_GUARD_WORD 0xFDFDFDFDUL /**< 守护字 */
+#define MEMPOOL_POISON 0xDDU          /**< 空闲块填充值 */
+
+#if (MEMPOOL_GUARD == 1)
+#define MEMPOOL_GUARD_BYTES 8U
+#else
+#define MEMPOOL_GUARD_BYTES 0U
+#endif
+
+/* 块跨度: 守护字 + 按MEMPOOL_ALIGN对齐的用户区 + 守护字 */
+#define MEMPOOL_STRIDE(size) \
+    (MEMPOOL_GUARD_BYTES * 2U + (((size) + MEMPOOL_ALIGN - 1U) / MEMPOOL_ALIGN) * MEMPOOL_ALIGN)
+
+/**
+ * @brief 定义池的存储(文件作用域使用)
+ *
+ * @param attr 存储属性(如 static MEM_CCMBSS)
+ * @param tag 名称，生成 s_x<tag>PoolMem 与 s_us<tag>PoolNext
+ * @param size 块大小(字节)
+ * @param count 块数
+ */
+#define MEMPOOL_STORAGE(attr, tag, size, count)                                          \
+    attr uint64_t s_x##tag##PoolMem[MEMPOOL_STRIDE(size) * (count) / sizeof(uint64_t)]; \
+    attr uint16_t s_us##tag##PoolNext[(count)]
+
+/**
+ * @brief 以MEMPOOL_STORAGE定义的存储初始化池
+ */
+#define MEMPOOL_INIT(pool, tag, size, count) \
+    MemPool_Init((pool), s_x##tag##PoolMem, s_us##tag##PoolNext, (size), (count))
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 释放结果
+ */
+typedef enum
+{
+    MEMPOOL_OK = 0,            /**< 成功 */
+    MEMPOOL_ERR_PTR = -1,      /**< 指针不属于该池或未对齐到块 */
+    MEMPOOL_ERR_DOUBLE = -2,   /**< 重复释放 */
+    MEMPOOL_ERR_GUARD = -3,    /**< 守护字被改写(块已正常释放) */
+} MemPool_Result_t;
+
+/**
+ * @brief 内存池
+ */
+typedef struct
+{
+    uint32_t head;        /**< 空闲链表头: [31:16]版本号, [15:0]块号 */
+    uint8_t *mem;         /**< 块存储 */
+    uint16_t *next;       /**< 各块的下一空闲块号 / MEMPOOL_BUSY */
+    uint16_t size;        /**< 用户可用大小(字节) */
+    uint16_t stride;      /**< 块跨度(字节) */
+    uint16_t count;       /**< 块数 */
+    uint16_t reserved;
+    uint32_t used;        /**< 当前已分配块数 */
+    uint32_t high_water;  /**< 已分配块数峰值 */
+    uint32_t allocs;      /**< 成功分配次数 */
+    uint32_t fails;       /**< 池空导致的分配失败次数 */
+    uint32_t errors;      /**< 非法释放/重复释放/守护字或毒化检查失败次数 */
+} MemPool_TypeDef;
+
+/**
+ * @brief 池统计快照
+ */
+typedef struct
+{
+    uint16_t size;        /**< 块大小(字节) */
+    uint16_t count;       /**< 块数 */
+    uint32_t used;        /**< 当前已分配块数 */
+    uint32_t high_water;  /**< 已分配块数峰值 */
+    uint32_t allocs;      /**< 成功分配次数 */
+    uint32_t fails;       /**< 分配失败次数 */
+    uint32_t errors;      /**< 错误次数 */
+} MemPool_Stats_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化内存池
+ * @author Yukikaze
+ *
+ * @param p 池
+ * @param mem 块存储(MEMPOOL_STRIDE(size) * count字节，按MEMPOOL_ALIGN对齐)
+ * @param next 链接数组(count项)
+ * @param size 块大小(字节)
+ * @param count 块数(1..MEMPOOL_MAX_BLOCKS)
+ * @return int 0=成功, -1=参数错误
+ *
+ * @note 须在任何分配之前、且无并发访问时调用
+ */
+int MemPool_Init(MemPool_TypeDef *p, void *mem, uint16_t *next, uint16_t size, uint16_t count);
+
+/**
+ * @brief 分配一块(可在中断中调用)
+ * @author Yukikaze
+ *
+ * @return void* 块地址(MEMPOOL_ALIGN对齐)，池空返回NULL
+ */
+void *MemPool_Alloc(MemPool_TypeDef *p);
+
+/**
+ * @brief 释放一块(可在中断中调用)
+ * @author Yukikaze
+ *
+ * @param p 池
+ * @param ptr MemPool_Alloc返回的地址(NULL直接返回MEMPOOL_OK)
+ * @return int MemPool_Result_t
+ */
+int MemPool_Free(MemPool_TypeDef *p, void *ptr);
+
+/**
+ * @brief 判断地址是否落在池的存储内
+ * @author Yukikaze
+ */
+int MemPool_Owns(const MemPool_TypeDef *p, const void *ptr);
+
+/**
+ * @brief 读取统计快照
+ * @author Yukikaze
+ */
+void MemPool_GetStats(const MemPool_TypeDef *p, MemPool_Stats_TypeDef *s);
+
+/**
+ * @brief 从一组池中按大小分配
+ * @author Yukikaze
+ *
+ * @param pools 池指针数组(按块大小升序)
+ * @param n 池数
+ * @param size 请求大小(字节)
+ * @return void* 块地址；没有足够大的池或全部用尽时返回NULL
+ *
+ * @note 优先使用能容纳size的最小池，该池用尽时依次尝试更大的池
+ */
+void *MemPool_SetAlloc(MemPool_TypeDef *const *pools, uint32_t n, size_t size);
+
+/**
+ * @brief 释放由MemPool_SetAlloc分配的块
+ * @author Yukikaze
+ *
+ * @return int MemPool_Result_t(不属于任何池时返回MEMPOOL_ERR_PTR)
+ */
+int MemPool_SetFree(MemPool_TypeDef *const *pools, uint32_t n, void *ptr);
+
+#endif /* __MEMPOOL_H */
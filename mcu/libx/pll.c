@@ -0,0 +1,157 @@
+/**
+ * @file pll.c
+ * @brief STM32F42x/43x 主PLL与总线分频参数求解实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "pll.h"
+#include <string.h>
+
+#define PLL_M_MIN 2U
+#define PLL_M_MAX 63U
+#define PLL_N_MIN 50U
+#define PLL_N_MAX 432U
+#define PLL_Q_MIN 2U
+#define PLL_Q_MAX 15U
+
+/**
+ * @brief 满足上限的最小2的幂分频
+ */
+static uint8_t Pll_BusDiv(uint32_t hz, uint32_t max_hz)
+{
+    uint8_t div = 1;
+
+    while (div < 16U && hz / div > max_hz)
+    {
+        div <<= 1;
+    }
+    return div;
+}
+
+/**
+ * @brief 候选a是否优于b(频率误差相同时比较)
+ */
+static int Pll_Better(const Pll_Config_TypeDef *a, uint32_t a_vin,
+                      const Pll_Config_TypeDef *b, uint32_t b_vin)
+{
+    int a_usb = (a->usb_hz == PLL_USB_HZ);
+    int b_usb = (b->usb_hz == PLL_USB_HZ);
+
+    if (a_usb != b_usb)
+    {
+        return a_usb;
+    }
+    if (a_vin != b_vin)
+    {
+        return a_vin > b_vin;
+    }
+    return a->vco_hz < b->vco_hz;
+}
+
+void Pll_Bus(uint32_t hclk_hz, Pll_Config_TypeDef *out)
+{
+    out->latency = (uint8_t)((hclk_hz - 1U) / PLL_FLASH_WS_HZ);
+    out->overdrive = (hclk_hz > PLL_SYSCLK_NO_OD);
+    out->vos = (hclk_hz > 144000000UL) ? 1U : (hclk_hz > 120000000UL) ? 2U : 3U;
+    out->apb1_div = Pll_BusDiv(hclk_hz, PLL_APB1_MAX);
+    out->apb2_div = Pll_BusDiv(hclk_hz, PLL_APB2_MAX);
+}
+
+int Pll_Solve(uint32_t src_hz, uint32_t target_hz, Pll_Config_TypeDef *out)
+{
+    static const uint8_t s_ucP[4] = {2, 4, 6, 8};
+    Pll_Config_TypeDef best;
+    Pll_Config_TypeDef cand;
+    uint32_t best_vin = 0;
+    int found = 0;
+
+    if (out == NULL || target_hz == 0 || target_hz > PLL_SYSCLK_MAX)
+    {
+        return -1;
+    }
+
+    memset(&best, 0, sizeof(best));
+    memset(&cand, 0, sizeof(cand));
+
+    for (uint32_t m = PLL_M_MIN; m <= PLL_M_MAX; m++)
+    {
+        /* VCO输入须为整数Hz，频率计算才没有舍入 */
+        uint32_t vin = src_hz / m;
+
+        if (src_hz % m != 0 || vin < PLL_VCO_IN_MIN || vin > PLL_VCO_IN_MAX)
+        {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < 4U; i++)
+        {
+            uint32_t p = s_ucP[i];
+            /* 不超过目标的最大N */
+            uint64_t n = (uint64_t)target_hz * p / vin;
+            uint64_t vco;
+
+            if (n > PLL_N_MAX)
+            {
+                n = PLL_N_MAX;
+            }
+            if (n < PLL_N_MIN)
+            {
+                continue;
+            }
+            if (n > PLL_VCO_OUT_MAX / vin)
+            {
+                n = PLL_VCO_OUT_MAX / vin;
+            }
+            /* 系统时钟须为整数Hz(SystemCoreClock与各分频计算才准确) */
+            while (n >= PLL_N_MIN && ((uint64_t)vin * n) % p != 0)
+            {
+                n--;
+            }
+            if (n < PLL_N_MIN)
+            {
+                continue;
+            }
+            vco = (uint64_t)vin * n;
+            if (vco < PLL_VCO_OUT_MIN)
+            {
+                continue;
+            }
+
+            cand.m = (uint16_t)m;
+            cand.n = (uint16_t)n;
+            cand.p = (uint8_t)p;
+            cand.vco_hz = (uint32_t)vco;
+            cand.sysclk_hz = (uint32_t)(vco / p);
+
+            /* 48MHz域不得超过48MHz */
+            cand.q = (uint8_t)((vco + PLL_USB_HZ - 1U) / PLL_USB_HZ);
+            if (cand.q < PLL_Q_MIN)
+            {
+                cand.q = PLL_Q_MIN;
+            }
+            if (cand.q > PLL_Q_MAX)
+            {
+                continue;
+            }
+            cand.usb_hz = (uint32_t)(vco / cand.q);
+
+            if (!found || cand.sysclk_hz > best.sysclk_hz ||
+                (cand.sysclk_hz == best.sysclk_hz && Pll_Better(&cand, vin, &best, best_vin)))
+            {
+                best = cand;
+                best_vin = vin;
+                found = 1;
+            }
+        }
+    }
+
+    if (!found)
+    {
+        return -1;
+    }
+
+    Pll_Bus(best.sysclk_hz, &best);
+    *out = best;
+    return (best.sysclk_hz == target_hz) ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file pll.h
+ * @brief STM32F42x/43x 主PLL与总线分频参数求解头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 按参考手册(RM0090)的约束，由PLL输入时钟与目标系统时钟求出:
+ *       - PLLM/N/P/Q: VCO输入1~2MHz，VCO输出100~432MHz，P取2/4/6/8，Q取2~15
+ *         SYSCLK = 输入 / M * N / P，48MHz域(USB/SDIO/RNG) = 输入 / M * N / Q，不得超过48MHz
+ *         VCO输入与SYSCLK只取整数Hz的组合，SystemCoreClock与由它推算的分频没有舍入误差
+ *       - Flash等待周期(2.7~3.6V: 每30MHz一个)、调压器等级与是否需要过驱动(>168MHz)
+ *       - APB1 <= 45MHz、APB2 <= 90MHz 的最小分频(AHB不分频)
+ *       多组参数都能得到目标频率时依次优先: 48MHz域恰好为48MHz、VCO输入较高(抖动小)、
+ *       VCO输出较低(功耗小)
+ *       本模块不访问硬件，可直接在主机上编译验证
+ */
+
+#ifndef __PLL_H
+#define __PLL_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 器件约束
+ * ============================================================================
+ */
+#define PLL_SYSCLK_MAX 180000000UL    /**< 系统时钟上限(过驱动) */
+#define PLL_SYSCLK_NO_OD 168000000UL  /**< 不需要过驱动的上限 */
+#define PLL_VCO_IN_MIN 1000000UL      /**< VCO输入下限 */
+#define PLL_VCO_IN_MAX 2000000UL      /**< VCO输入上限 */
+#define PLL_VCO_OUT_MIN 100000000UL   /**< VCO输出下限 */
+#define PLL_VCO_OUT_MAX 432000000UL   /**< VCO输出上限 */
+#define PLL_USB_HZ 48000000UL         /**< 48MHz域目标(也是上限) */
+#define PLL_APB1_MAX 45000000UL       /**< APB1上限 */
+#define PLL_APB2_MAX 90000000UL       /**< APB2上限 */
+#define PLL_FLASH_WS_HZ 30000000UL    /**< 每个Flash等待周期对应的频率(2.7~3.6V) */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief PLL与总线配置
+ */
+typedef struct
+{
+    uint32_t sysclk_hz; /**< 实际系统时钟(= HCLK) */
+    uint32_t vco_hz;    /**< VCO输出 */
+    uint32_t usb_hz;    /**< 48MHz域时钟 */
+    uint16_t m;         /**< PLLM(2~63) */
+    uint16_t n;         /**< PLLN(50~432) */
+    uint8_t p;          /**< PLLP(2/4/6/8) */
+    uint8_t q;          /**< PLLQ(2~15) */
+    uint8_t latency;    /**< Flash等待周期(0~7) */
+    uint8_t vos;        /**< 调压器等级(1~3，数值越大功耗越低) */
+    uint8_t overdrive;  /**< 是否需要过驱动 */
+    uint8_t apb1_div;   /**< APB1分频(1/2/4/8/16) */
+    uint8_t apb2_div;   /**< APB2分频(1/2/4/8/16) */
+} Pll_Config_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 求解PLL与总线配置
+ * @author Yukikaze
+ *
+ * @param src_hz PLL输入时钟(HSE或HSI)
+ * @param target_hz 目标系统时钟
+ * @param out 输出配置
+ * @return int 0=恰好得到目标频率, 1=不能恰好得到，输出不超过目标的最接近值,
+ *             -1=参数无效(目标超过上限或输入时钟不能分出1~2MHz)
+ */
+int Pll_Solve(uint32_t src_hz, uint32_t target_hz, Pll_Config_TypeDef *out);
+
+/**
+ * @brief 由HCLK计算Flash等待周期、调压器等级、过驱动与APB分频
+ * @author Yukikaze
+ *
+ * @param hclk_hz AHB时钟
+ * @param out 输出配置(只写latency/vos/overdrive/apb1_div/apb2_div)
+ *
+ * @note Pll_Solve内部调用；不经过PLL直接运行在HSI/HSE时也用它配置总线
+ */
+void Pll_Bus(uint32_t hclk_hz, Pll_Config_TypeDef *out);
+
+#endif /* __PLL_H */
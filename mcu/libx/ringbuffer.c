@@ -2,10 +2,12 @@
 
 #include "stdlib.h"
 #include "string.h"
+#include "__port_config__.h"
 // #include "api.h"
 // #include "hal.h"
 // #include "cmsis_os.h"
 #include "ringbuffer.h"
+#include "mem_section.h"
 
 int rbclear(rbptr_t rb, unsigned long int len)
 {
@@ -13,7 +15,7 @@ int rbclear(rbptr_t rb, unsigned long int len)
     {
         // 为什么又在最后将x赋给了rb->_RV_VALUE_
         unsigned long int x = rb->_RV_VALUE_;
-        memset(rb->bf, 0, len);
+        PORT_MEMSET(rb->bf, 0, len);
         rb->count = 0;
         rb->wrp = rb->bf;
         rb->rdp = rb->bf;
@@ -32,6 +34,8 @@ void *rb_init(unsigned long int size)
     rbptr->bf = (unsigned char *)malloc(size);
     if (rbptr->bf)
     {
+        /* rbclear保留_RV_VALUE_，新分配的缓冲先清零 */
+        rbptr->_RV_VALUE_ = 0;
         rbclear(rbptr, size);
         // osSemaphoreCreate创建信号量,赋予初始令牌1
         // rbptr->evtrb = osSemaphoreCreate(NULL, 1);
@@ -47,7 +51,7 @@ void *rb_init(unsigned long int size)
 }
 // 缓冲区句柄，要读的数据区域，要读得大小
 // rbread(msbp->flow, (unsigned char *)&sbp, 4)
-int rbread(rbptr_t rb, unsigned char *buf, unsigned long int size)
+MEM_FASTCODE int rbread(rbptr_t rb, unsigned char *buf, unsigned long int size)
 {
     //	if(!__get_IPSR()) taskENTER_CRITICAL();
     if (rb && buf && size)
@@ -58,7 +62,7 @@ int rbread(rbptr_t rb, unsigned char *buf, unsigned long int size)
             // in one direction, there is enough data for retrieving
             if (rb->wrp > rb->rdp)
             {
-                memcpy(buf, (unsigned char *)rb->rdp, size);
+                PORT_MEMCPY(buf, (unsigned char *)rb->rdp, size);
                 rb->rdp += size;
             }
             else if (rb->wrp < rb->rdp)
@@ -66,14 +70,14 @@ int rbread(rbptr_t rb, unsigned char *buf, unsigned long int size)
                 unsigned long int len1 = rb->bf + rb->capacity - 1 - rb->rdp + 1;
                 if (len1 >= size)
                 {
-                    memcpy(buf, (unsigned char *)rb->rdp, size);
+                    PORT_MEMCPY(buf, (unsigned char *)rb->rdp, size);
                     rb->rdp += size;
                 }
                 else
                 {
                     unsigned long int len2 = size - len1;
-                    memcpy(buf, (unsigned char *)rb->rdp, len1);
-                    memcpy(buf + len1, rb->bf, len2);
+                    PORT_MEMCPY(buf, (unsigned char *)rb->rdp, len1);
+                    PORT_MEMCPY(buf + len1, rb->bf, len2);
                     rb->rdp = rb->bf + len2; // Wrap around
                 }
             }
@@ -87,7 +91,7 @@ int rbread(rbptr_t rb, unsigned char *buf, unsigned long int size)
     return (0);
 }
 // rbwrite(msbp->flow, (unsigned char *)&flow2put, 4)
-int rbwrite(rbptr_t rb, unsigned char *buf, unsigned long int size)
+MEM_FASTCODE int rbwrite(rbptr_t rb, unsigned char *buf, unsigned long int size)
 {
     //	if(!__get_IPSR()) taskENTER_CRITICAL();
     if (rb && buf && size)
@@ -103,20 +107,20 @@ int rbwrite(rbptr_t rb, unsigned char *buf, unsigned long int size)
                 unsigned long int len1 = rb->bf + rb->capacity - rb->wrp;
                 if (len1 >= size)
                 {
-                    memcpy((unsigned char *)rb->wrp, buf, size);
+                    PORT_MEMCPY((unsigned char *)rb->wrp, buf, size);
                     rb->wrp += size;
                 }
                 else
                 {
                     unsigned long int len2 = size - len1;
-                    memcpy((unsigned char *)rb->wrp, buf, len1);
-                    memcpy(rb->bf, buf + len1, len2);
+                    PORT_MEMCPY((unsigned char *)rb->wrp, buf, len1);
+                    PORT_MEMCPY(rb->bf, buf + len1, len2);
                     rb->wrp = rb->bf + len2; // Wrap around
                 }
             }
             else
             {
-                memcpy((unsigned char *)rb->wrp, buf, size);
+                PORT_MEMCPY((unsigned char *)rb->wrp, buf, size);
                 rb->wrp += size;
             }
             rb->count += size;
@@ -139,7 +143,7 @@ int rbpeek_(rbptr_t rb, unsigned char *buf, unsigned long int size)
             // in one direction, there is enough data for retrieving
             if (rb->wrp > rb->rdp)
             {
-                memcpy(buf, (unsigned char *)rb->rdp, size);
+                PORT_MEMCPY(buf, (unsigned char *)rb->rdp, size);
             }
             else if (rb->wrp < rb->rdp)
             {
@@ -148,13 +152,13 @@ int rbpeek_(rbptr_t rb, unsigned char *buf, unsigned long int size)
                 unsigned long int len1 = rb->bf + rb->capacity - 1 - rb->rdp + 1;
                 if (len1 >= size)
                 {
-                    memcpy(buf, (unsigned char *)rb->rdp, size);
+                    PORT_MEMCPY(buf, (unsigned char *)rb->rdp, size);
                 }
                 else
                 {
                     unsigned long int len2 = size - len1;
-                    memcpy(buf, (unsigned char *)rb->rdp, len1);
-                    memcpy(buf + len1, rb->bf, len2);
+                    PORT_MEMCPY(buf, (unsigned char *)rb->rdp, len1);
+                    PORT_MEMCPY(buf + len1, rb->bf, len2);
                 }
             }
             //			if(!__get_IPSR()) taskEXIT_CRITICAL();
@@ -165,14 +169,14 @@ int rbpeek_(rbptr_t rb, unsigned char *buf, unsigned long int size)
     return (0);
 }
 
-int rbput(rbptr_t rb, unsigned char value)
+MEM_FASTCODE int rbput(rbptr_t rb, unsigned char value)
 {
     if (rbfull(rb))
         return -1;
     return (rbwrite(rb, &value, 1));
 }
 
-int rbget(rbptr_t rb)
+MEM_FASTCODE int rbget(rbptr_t rb)
 {
     if (rbempty(rb))
         return -1;
@@ -185,7 +189,7 @@ int rbpeek(rbptr_t rb)
 {
     if (rbempty(rb))
         return -1;
-    unsigned char r;
+    unsigned char r = 0;
     rbpeek_(rb, (unsigned char *)&r, 1);
     return (r);
 }
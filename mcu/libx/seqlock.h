@@ -0,0 +1,77 @@
+/**
+ * @file seqlock.h
+ * @brief 顺序锁(seqlock)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 适用于"少量写者、频繁读者、数据可整体拷贝"的共享结构:
+ *       - 写者: WriteBegin(序号变奇数) -> 写数据 -> WriteEnd(序号变偶数)
+ *       - 读者: ReadBegin 取序号 -> 拷贝数据 -> ReadRetry 判断期间是否被写过，是则重读
+ *       读者从不阻塞写者，也不需要关中断
+ *       多个写者之间必须由调用者互斥(例如临界区)，本模块只保证读写之间的一致性
+ *       使用GCC __atomic 内建函数，目标板与主机行为一致
+ */
+
+#ifndef __SEQLOCK_H
+#define __SEQLOCK_H
+
+#include <stdint.h>
+
+/**
+ * @brief 顺序锁
+ */
+typedef struct
+{
+    uint32_t seq; /**< 偶数=空闲, 奇数=正在写 */
+} SeqLock_TypeDef;
+
+#define SEQLOCK_INIT {0}
+
+/**
+ * @brief 开始写(写者之间需已互斥)
+ */
+static inline void SeqLock_WriteBegin(SeqLock_TypeDef *sl)
+{
+    __atomic_store_n(&sl->seq, sl->seq + 1U, __ATOMIC_RELAXED);
+    /* 序号变奇数必须先于数据写入被读者看到 */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 结束写
+ */
+static inline void SeqLock_WriteEnd(SeqLock_TypeDef *sl)
+{
+    __atomic_store_n(&sl->seq, sl->seq + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 开始读，返回当前序号(写入进行中时等待其结束)
+ *
+ * @note 单核上写者位于临界区内，读者不会观察到奇数序号；
+ *       此处的等待只在多核主机上生效
+ */
+static inline uint32_t SeqLock_ReadBegin(const SeqLock_TypeDef *sl)
+{
+    uint32_t seq;
+
+    while ((seq = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE)) & 1U)
+    {
+    }
+    return seq;
+}
+
+/**
+ * @brief 结束读
+ *
+ * @param seq ReadBegin 的返回值
+ * @return int 1=读取期间数据被修改，需要重读; 0=读取结果一致
+ */
+static inline int SeqLock_ReadRetry(const SeqLock_TypeDef *sl, uint32_t seq)
+{
+    /* 数据读取必须先于序号复查完成 */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&sl->seq, __ATOMIC_RELAXED) != seq;
+}
+
+#endif /* __SEQLOCK_H */
@@ -0,0 +1,93 @@
+/**
+ * @file threshold.c
+ * @brief 阈值带与迟滞状态机实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "threshold.h"
+#include <string.h>
+
+void Threshold_Init(Threshold_Band_TypeDef *b, uint16_t half_width,
+                    uint16_t hysteresis, uint16_t min, uint16_t max)
+{
+    memset(b, 0, sizeof(*b));
+    b->half_width = half_width;
+    /* 迟滞为0时相同电平也会被判为变化，至少取1 */
+    b->hysteresis = (hysteresis != 0) ? hysteresis : 1;
+    b->min = min;
+    b->max = max;
+    b->low = min;
+    b->high = max;
+    b->state = THRESH_STATE_IDLE;
+}
+
+void Threshold_Arm(Threshold_Band_TypeDef *b, uint16_t level)
+{
+    if (level < b->min)
+    {
+        level = b->min;
+    }
+    if (level > b->max)
+    {
+        level = b->max;
+    }
+
+    /* 使用32位中间值，避免uint16加减回绕 */
+    b->low = ((uint32_t)level >= (uint32_t)b->min + b->half_width)
+                 ? (uint16_t)(level - b->half_width)
+                 : b->min;
+    b->high = ((uint32_t)level + b->half_width <= b->max)
+                  ? (uint16_t)(level + b->half_width)
+                  : b->max;
+    b->state = THRESH_STATE_ARMED;
+}
+
+void Threshold_Trigger(Threshold_Band_TypeDef *b)
+{
+    if (b->state == THRESH_STATE_ARMED)
+    {
+        b->state = THRESH_STATE_TRIGGERED;
+        b->triggers++;
+    }
+}
+
+int Threshold_IsOutside(const Threshold_Band_TypeDef *b, uint16_t sample)
+{
+    if (b->state == THRESH_STATE_IDLE)
+    {
+        return 0;
+    }
+    return (sample < b->low) || (sample > b->high);
+}
+
+Threshold_Event_t Threshold_Settle(Threshold_Band_TypeDef *b, uint16_t level)
+{
+    Threshold_Event_t evt = THRESH_EVENT_NONE;
+
+    if (!b->has_report)
+    {
+        b->has_report = 1;
+        b->reported = level;
+        evt = THRESH_EVENT_RISE;
+    }
+    else if ((uint32_t)level >= (uint32_t)b->reported + b->hysteresis)
+    {
+        b->reported = level;
+        evt = THRESH_EVENT_RISE;
+    }
+    else if ((uint32_t)level + b->hysteresis <= b->reported)
+    {
+        b->reported = level;
+        evt = THRESH_EVENT_FALL;
+    }
+
+    if (evt != THRESH_EVENT_NONE)
+    {
+        b->events++;
+    }
+
+    /* 无论是否上报都以新电平为中心重新布防 */
+    Threshold_Arm(b, level);
+    return evt;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file threshold.h
+ * @brief 阈值带与迟滞状态机头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 为"越界触发"类事件源(如ADC模拟看门狗)提供纯软件的状态机:
+ *       - 围绕当前电平计算上下阈值(带宽 + 量程钳位)
+ *       - 触发后由任务确认滤波后的新电平，只有变化量超过迟滞才上报
+ *       - 无论是否上报，都以新电平为中心重新布防，避免在旧边界附近反复触发
+ *
+ *       本模块不访问任何硬件，可直接在主机上编译验证
+ */
+
+#ifndef __THRESHOLD_H
+#define __THRESHOLD_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 状态与事件定义
+ * ============================================================================
+ */
+
+/**
+ * @brief 阈值带状态
+ */
+typedef enum
+{
+    THRESH_STATE_IDLE = 0,  /**< 未布防 */
+    THRESH_STATE_ARMED,     /**< 已布防，等待越界 */
+    THRESH_STATE_TRIGGERED, /**< 已越界，等待任务确认 */
+} Threshold_State_t;
+
+/**
+ * @brief 确认结果
+ */
+typedef enum
+{
+    THRESH_EVENT_NONE = 0, /**< 变化量小于迟滞，不上报 */
+    THRESH_EVENT_RISE,     /**< 电平上升超过迟滞 */
+    THRESH_EVENT_FALL,     /**< 电平下降超过迟滞 */
+} Threshold_Event_t;
+
+/**
+ * @brief 阈值带状态机
+ */
+typedef struct
+{
+    uint16_t low;        /**< 当前下阈值 */
+    uint16_t high;       /**< 当前上阈值 */
+    uint16_t half_width; /**< 阈值带半宽 */
+    uint16_t hysteresis; /**< 上报所需的最小变化量 */
+    uint16_t min;        /**< 量程下限 */
+    uint16_t max;        /**< 量程上限 */
+    uint16_t reported;   /**< 最近一次上报的电平 */
+    uint8_t state;       /**< Threshold_State_t */
+    uint8_t has_report;  /**< 是否已有上报值 */
+    uint32_t triggers;   /**< 越界触发次数(含被迟滞吞掉的) */
+    uint32_t events;     /**< 实际上报次数 */
+} Threshold_Band_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化阈值带
+ * @author Yukikaze
+ *
+ * @param b 状态机
+ * @param half_width 阈值带半宽(应不小于hysteresis)
+ * @param hysteresis 上报所需的最小变化量
+ * @param min 量程下限
+ * @param max 量程上限
+ */
+void Threshold_Init(Threshold_Band_TypeDef *b, uint16_t half_width,
+                    uint16_t hysteresis, uint16_t min, uint16_t max);
+
+/**
+ * @brief 以指定电平为中心布防
+ * @author Yukikaze
+ *
+ * @note 计算结果写入 b->low / b->high，由调用者写入硬件
+ *       中心靠近量程边界时，靠边一侧钳位到量程(该侧不会再触发)
+ */
+void Threshold_Arm(Threshold_Band_TypeDef *b, uint16_t level);
+
+/**
+ * @brief 标记越界(可在中断中调用)
+ * @author Yukikaze
+ */
+void Threshold_Trigger(Threshold_Band_TypeDef *b);
+
+/**
+ * @brief 判断样本是否落在当前阈值带之外
+ * @author Yukikaze
+ *
+ * @return int 1=越界, 0=带内(未布防时总返回0)
+ */
+int Threshold_IsOutside(const Threshold_Band_TypeDef *b, uint16_t sample);
+
+/**
+ * @brief 确认新电平并重新布防
+ * @author Yukikaze
+ *
+ * @param b 状态机
+ * @param level 滤波后的新电平
+ * @return Threshold_Event_t 是否需要上报
+ *
+ * @note 首次调用总是上报(RISE)
+ */
+Threshold_Event_t Threshold_Settle(Threshold_Band_TypeDef *b, uint16_t level);
+
+#endif /* __THRESHOLD_H */
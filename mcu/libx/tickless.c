@@ -0,0 +1,133 @@
+/**
+ * @file tickless.c
+ * @brief 无节拍空闲的时间换算实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "tickless.h"
+
+#define TICKLESS_SEC_PER_DAY 86400UL
+
+Tickless_Mode_t Tickless_Select(const Tickless_Config_TypeDef *cfg, uint32_t expected,
+                                int stop_allowed)
+{
+    if (expected < 2)
+    {
+        return TICKLESS_NONE;
+    }
+    if (stop_allowed && expected >= cfg->min_stop)
+    {
+        return TICKLESS_STOP;
+    }
+    return TICKLESS_SLEEP;
+}
+
+uint32_t Tickless_WakeupCounts(const Tickless_Config_TypeDef *cfg, uint32_t ticks)
+{
+    uint64_t counts;
+
+    if (ticks > cfg->max_stop)
+    {
+        ticks = cfg->max_stop;
+    }
+
+    counts = (uint64_t)ticks * cfg->wut_hz / cfg->tick_hz;
+    if (counts == 0)
+    {
+        counts = 1;
+    }
+    if (counts > 65536U)
+    {
+        counts = 65536U;
+    }
+    return (uint32_t)counts;
+}
+
+uint32_t Tickless_SubElapsed(uint32_t sub_hz, uint32_t sec0, uint32_t ss0,
+                             uint32_t sec1, uint32_t ss1)
+{
+    /* 亚秒寄存器向下计数，换算为"本秒内已经过的亚秒数"后线性化 */
+    uint64_t t0 = (uint64_t)sec0 * sub_hz + (sub_hz - 1U - ss0);
+    uint64_t t1 = (uint64_t)sec1 * sub_hz + (sub_hz - 1U - ss1);
+    uint64_t day = (uint64_t)TICKLESS_SEC_PER_DAY * sub_hz;
+
+    if (t1 < t0)
+    {
+        t1 += day;
+    }
+    return (uint32_t)(t1 - t0);
+}
+
+uint32_t Tickless_SubToCycles(uint32_t sub_hz, uint32_t elapsed_sub, uint32_t cpu_hz)
+{
+    return (uint32_t)((uint64_t)elapsed_sub * cpu_hz / sub_hz);
+}
+
+uint32_t Tickless_Compensate(uint32_t counts_per_tick, uint32_t remain, uint32_t slept,
+                             uint32_t *reload)
+{
+    uint32_t ticks;
+    uint32_t left;
+
+    if (slept < remain)
+    {
+        /* 没有越过节拍边界 */
+        ticks = 0;
+        left = remain - slept;
+    }
+    else
+    {
+        uint32_t over = slept - remain;
+
+        ticks = 1U + over / counts_per_tick;
+        left = counts_per_tick - over % counts_per_tick;
+    }
+
+    /* 离下一个节拍太近时提前计入该节拍，第一个节拍延长一个周期，
+     * 节拍中断不会紧跟在唤醒之后，且误差不累积 */
+    if (left < counts_per_tick / 16U)
+    {
+        ticks++;
+        left += counts_per_tick;
+    }
+    *reload = left;
+    return ticks;
+}
+
+uint32_t Tickless_SleepReload(uint32_t counts_per_tick, uint32_t current, uint32_t ticks,
+                              uint32_t comp)
+{
+    /* -1: 当前节拍已经过了一部分，剩余部分就是SysTick当前值 */
+    uint32_t reload = current + counts_per_tick * (ticks - 1U);
+
+    if (reload > comp)
+    {
+        reload -= comp;
+    }
+    return reload;
+}
+
+uint32_t Tickless_SleepExpired(uint32_t counts_per_tick, uint32_t reload, uint32_t current,
+                               uint32_t comp)
+{
+    /* 计满后SysTick从reload重新计数，已经过的部分从第一个节拍中扣除 */
+    uint32_t load = (counts_per_tick - 1U) - (reload - current);
+
+    if (load < comp || load > counts_per_tick)
+    {
+        load = counts_per_tick - 1U;
+    }
+    return load;
+}
+
+uint32_t Tickless_SleepEarly(uint32_t counts_per_tick, uint32_t ticks, uint32_t current,
+                             uint32_t *reload)
+{
+    /* 从休眠前最近一个节拍边界算起已经过的计数 */
+    uint32_t done = ticks * counts_per_tick - current;
+    uint32_t full = done / counts_per_tick;
+
+    *reload = (full + 1U) * counts_per_tick - done;
+    return full;
+}
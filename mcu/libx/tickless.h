@@ -0,0 +1,156 @@
+/**
+ * @file tickless.h
+ * @brief 无节拍空闲的时间换算头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 为 portSUPPRESS_TICKS_AND_SLEEP 提供与硬件无关的计算:
+ *       - 根据预计空闲节拍数选择 不休眠 / SLEEP(SysTick继续计时) / STOP(RTC唤醒)
+ *       - 节拍数 -> RTC唤醒定时器计数值
+ *       - 两次RTC(秒 + 亚秒)快照之间经过的亚秒数(含跨零点)
+ *       - 休眠时长 -> 完整节拍数 + 第一个节拍的SysTick重装值(补偿不足一个节拍的部分)
+ *       - SLEEP路径: 延长后的SysTick重装值，唤醒后的节拍数与下一个节拍的重装值
+ *       本模块不访问硬件，由主机测试(mcu/sim/Test/test_tickless.c)验证
+ */
+
+#ifndef __TICKLESS_H
+#define __TICKLESS_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 休眠方式
+ */
+typedef enum
+{
+    TICKLESS_NONE = 0, /**< 空闲时间太短，不休眠 */
+    TICKLESS_SLEEP,    /**< SLEEP: 内核停止，外设与SysTick继续运行 */
+    TICKLESS_STOP,     /**< STOP: 时钟全部停止，由RTC唤醒定时器唤醒 */
+} Tickless_Mode_t;
+
+/**
+ * @brief 时钟参数
+ */
+typedef struct
+{
+    uint32_t tick_hz;   /**< 系统节拍频率 */
+    uint32_t wut_hz;    /**< RTC唤醒定时器计数频率 */
+    uint32_t sub_hz;    /**< RTC亚秒计数频率(同步预分频+1) */
+    uint32_t min_stop;  /**< 进入STOP的最小空闲节拍数(低于此值唤醒开销不划算) */
+    uint32_t max_stop;  /**< 单次STOP的最大节拍数 */
+} Tickless_Config_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 选择休眠方式
+ * @author Yukikaze
+ *
+ * @param cfg 时钟参数
+ * @param expected 预计空闲节拍数
+ * @param stop_allowed 当前是否允许STOP(有外设需要保持运行时为0)
+ * @return Tickless_Mode_t 休眠方式
+ */
+Tickless_Mode_t Tickless_Select(const Tickless_Config_TypeDef *cfg, uint32_t expected,
+                                int stop_allowed);
+
+/**
+ * @brief 计算RTC唤醒定时器计数值
+ * @author Yukikaze
+ *
+ * @param cfg 时钟参数
+ * @param ticks 休眠节拍数(超过max_stop按max_stop处理)
+ * @return uint32_t 计数值(1~65536，写入WUTR时减1)，向下取整，宁可早醒
+ */
+uint32_t Tickless_WakeupCounts(const Tickless_Config_TypeDef *cfg, uint32_t ticks);
+
+/**
+ * @brief 计算两次RTC快照之间经过的亚秒数
+ * @author Yukikaze
+ *
+ * @param sub_hz 亚秒计数频率
+ * @param sec0 起始时刻当日秒数(0~86399)
+ * @param ss0 起始时刻亚秒寄存器(向下计数: sub_hz-1 ~ 0)
+ * @param sec1 结束时刻当日秒数
+ * @param ss1 结束时刻亚秒寄存器
+ * @return uint32_t 经过的亚秒数(跨零点按一天取模)
+ */
+uint32_t Tickless_SubElapsed(uint32_t sub_hz, uint32_t sec0, uint32_t ss0,
+                             uint32_t sec1, uint32_t ss1);
+
+/**
+ * @brief 亚秒数换算为内核时钟周期数
+ * @author Yukikaze
+ *
+ * @param sub_hz 亚秒计数频率
+ * @param elapsed_sub 经过的亚秒数
+ * @param cpu_hz 内核时钟频率
+ * @return uint32_t 周期数(调用者保证不超过32位，即STOP时长受max_stop限制)
+ */
+uint32_t Tickless_SubToCycles(uint32_t sub_hz, uint32_t elapsed_sub, uint32_t cpu_hz);
+
+/**
+ * @brief 计算休眠期间经过的完整节拍数
+ * @author Yukikaze
+ *
+ * @param counts_per_tick 一个节拍的SysTick计数(SysTick时钟=内核时钟)
+ * @param remain 休眠前距离下一个节拍边界的计数(SysTick当前值)
+ * @param slept 休眠(含唤醒后恢复时钟)经过的计数
+ * @param reload 输出: 唤醒后第一个节拍剩余的计数(1/16 ~ 17/16个节拍)
+ * @return uint32_t 完整节拍数(由调用者按vTaskStepTick的上限钳位)
+ *
+ * @note 不足一个节拍的部分通过缩短第一个节拍补偿，多次休眠不会累积误差
+ */
+uint32_t Tickless_Compensate(uint32_t counts_per_tick, uint32_t remain, uint32_t slept,
+                             uint32_t *reload);
+
+/**
+ * @brief SLEEP: 计算延长后的SysTick重装值
+ * @author Yukikaze
+ *
+ * @param counts_per_tick 一个节拍的SysTick计数
+ * @param current 休眠前SysTick当前值(当前节拍剩余的计数)
+ * @param ticks 休眠节拍数(含当前节拍，>=1)
+ * @param comp 停止SysTick期间丢失的计数补偿
+ * @return uint32_t 重装值: 计满时恰好到达第ticks个节拍边界
+ */
+uint32_t Tickless_SleepReload(uint32_t counts_per_tick, uint32_t current, uint32_t ticks,
+                              uint32_t comp);
+
+/**
+ * @brief SLEEP计满(COUNTFLAG置位): 计算恢复节拍后第一个节拍的重装值
+ * @author Yukikaze
+ *
+ * @param counts_per_tick 一个节拍的SysTick计数
+ * @param reload 休眠时的重装值
+ * @param current 读取时的SysTick当前值(计满后已从reload重新计数)
+ * @param comp 停止SysTick期间丢失的计数补偿
+ * @return uint32_t 写入LOAD的值: 当前节拍剩余的计数，异常时取一个完整节拍
+ */
+uint32_t Tickless_SleepExpired(uint32_t counts_per_tick, uint32_t reload, uint32_t current,
+                               uint32_t comp);
+
+/**
+ * @brief SLEEP被其他中断提前唤醒: 计算已经过的完整节拍数
+ * @author Yukikaze
+ *
+ * @param counts_per_tick 一个节拍的SysTick计数
+ * @param ticks 休眠节拍数(同Tickless_SleepReload)
+ * @param current 唤醒时的SysTick当前值
+ * @param reload 输出: 距离下一个节拍边界的计数(1 ~ counts_per_tick)
+ * @return uint32_t 完整节拍数(小于ticks)
+ */
+uint32_t Tickless_SleepEarly(uint32_t counts_per_tick, uint32_t ticks, uint32_t current,
+                             uint32_t *reload);
+
+#endif /* __TICKLESS_H */
@@ -0,0 +1,156 @@
+/**
+ * @file trace_ring.c
+ * @brief 跟踪事件环形缓冲实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "trace_ring.h"
+#include <stddef.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 控制块中不随写入变化的字段的校验值
+ */
+static uint32_t TraceRing_Check(const TraceRing_TypeDef *r)
+{
+    return r->magic ^ r->mask ^ (uint32_t)(uintptr_t)r->buf ^ ((uint32_t)r->mode << 24) ^ 0xA5A5A5A5UL;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int TraceRing_Init(TraceRing_TypeDef *r, TraceRing_Event_TypeDef *buf, uint32_t len,
+                   TraceRing_Mode_t mode)
+{
+    if (r == NULL || buf == NULL || len == 0 || (len & (len - 1)) != 0)
+    {
+        return -1;
+    }
+
+    r->magic = TRACE_RING_MAGIC;
+    r->mask = len - 1;
+    r->head = 0;
+    r->dropped = 0;
+    r->mode = (uint8_t)mode;
+    r->frozen = 0;
+    r->full = 0;
+    r->reserved = 0;
+    r->buf = buf;
+    r->check = TraceRing_Check(r);
+    return 0;
+}
+
+int TraceRing_IsValid(const TraceRing_TypeDef *r, const TraceRing_Event_TypeDef *buf,
+                      uint32_t len)
+{
+    return r->magic == TRACE_RING_MAGIC &&
+           r->buf == buf &&
+           r->mask == len - 1 &&
+           r->mode <= TRACE_RING_STOP &&
+           r->check == TraceRing_Check(r);
+}
+
+int TraceRing_Put(TraceRing_TypeDef *r, uint32_t ts, uint8_t type, uint8_t id, uint16_t arg)
+{
+    TraceRing_Event_TypeDef *e;
+
+    if (r->frozen || (r->mode == TRACE_RING_STOP && r->full))
+    {
+        r->dropped++;
+        return 0;
+    }
+
+    e = &r->buf[r->head & r->mask];
+    e->ts = ts;
+    e->type = type;
+    e->id = id;
+    e->arg = arg;
+    r->head++;
+    if ((r->head & r->mask) == 0)
+    {
+        r->full = 1;
+    }
+    return 1;
+}
+
+int TraceRing_Evicts(const TraceRing_TypeDef *r, TraceRing_Event_TypeDef *out)
+{
+    if (!r->full || r->frozen || r->mode != TRACE_RING_OVERWRITE)
+    {
+        return 0;
+    }
+    *out = r->buf[r->head & r->mask];
+    return 1;
+}
+
+void TraceRing_Freeze(TraceRing_TypeDef *r, uint8_t frozen)
+{
+    r->frozen = frozen;
+}
+
+uint32_t TraceRing_Tail(const TraceRing_TypeDef *r)
+{
+    /* 序号按模2^32回绕，写满后最旧事件总是head-容量 */
+    return r->full ? r->head - r->mask - 1U : r->head - (r->head & r->mask);
+}
+
+uint32_t TraceRing_Read(const TraceRing_TypeDef *r, uint32_t *cursor,
+                        TraceRing_Event_TypeDef *out, uint32_t max, uint32_t *lost)
+{
+    uint32_t tail = TraceRing_Tail(r);
+    uint32_t n = 0;
+
+    if (lost != NULL)
+    {
+        *lost = 0;
+    }
+
+    /* 游标已被覆盖: 跳到最旧的有效事件 */
+    if ((int32_t)(*cursor - tail) < 0)
+    {
+        if (lost != NULL)
+        {
+            *lost = tail - *cursor;
+        }
+        *cursor = tail;
+    }
+
+    while (n < max && *cursor != r->head)
+    {
+        out[n++] = r->buf[*cursor & r->mask];
+        (*cursor)++;
+    }
+
+    return n;
+}
+
+void TraceRing_Encode(const TraceRing_Event_TypeDef *e, char *out)
+{
+    static const char s_cHex[] = "0123456789abcdef";
+    uint8_t b[8];
+
+    b[0] = (uint8_t)e->ts;
+    b[1] = (uint8_t)(e->ts >> 8);
+    b[2] = (uint8_t)(e->ts >> 16);
+    b[3] = (uint8_t)(e->ts >> 24);
+    b[4] = e->type;
+    b[5] = e->id;
+    b[6] = (uint8_t)e->arg;
+    b[7] = (uint8_t)(e->arg >> 8);
+
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        out[2U * i] = s_cHex[b[i] >> 4];
+        out[2U * i + 1U] = s_cHex[b[i] & 0x0FU];
+    }
+    out[TRACE_RING_HEX_LEN] = '\0';
+}
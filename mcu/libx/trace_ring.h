@@ -0,0 +1,155 @@
+/**
+ * @file trace_ring.h
+ * @brief 跟踪事件环形缓冲头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 定长8字节事件的环形缓冲，供调度跟踪记录器使用:
+ *       - 覆盖模式: 写满后覆盖最旧事件(飞行记录仪，保留崩溃前最后的N个事件)
+ *       - 停止模式: 写满后丢弃新事件并计数(保留启动后最早的N个事件)
+ *       - 冻结后不再写入，缓冲内容可跨软件复位保留(放在不初始化的内存段)
+ *       - 读者以绝对序号作游标(按模2^32比较)，被写者超越时跳到最旧的有效事件并报告丢失数
+ *       本模块不加锁，并发保护由调用者负责，可直接在主机上编译验证
+ */
+
+#ifndef __TRACE_RING_H
+#define __TRACE_RING_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+#define TRACE_RING_MAGIC 0x54524331UL /**< "TRC1" */
+#define TRACE_RING_HEX_LEN 16U        /**< 一个事件编码后的十六进制字符数 */
+
+/**
+ * @brief 跟踪事件(8字节，小端)
+ */
+typedef struct
+{
+    uint32_t ts;  /**< 时间戳低32位(内核时钟周期) */
+    uint8_t type; /**< 事件类型 */
+    uint8_t id;   /**< 对象编号(任务/队列/中断) */
+    uint16_t arg; /**< 附加参数 */
+} TraceRing_Event_TypeDef;
+
+/**
+ * @brief 写满策略
+ */
+typedef enum
+{
+    TRACE_RING_OVERWRITE = 0, /**< 覆盖最旧事件 */
+    TRACE_RING_STOP,          /**< 丢弃新事件 */
+} TraceRing_Mode_t;
+
+/**
+ * @brief 环形缓冲控制块
+ */
+typedef struct
+{
+    uint32_t magic;                /**< 有效标志 */
+    uint32_t mask;                 /**< 容量-1(容量为2的幂) */
+    uint32_t head;                 /**< 已写入事件总数(绝对序号) */
+    uint32_t dropped;              /**< 停止模式或冻结后丢弃的事件数 */
+    uint8_t mode;                  /**< TraceRing_Mode_t */
+    uint8_t frozen;                /**< 是否已冻结 */
+    uint8_t full;                  /**< 是否已写满过一圈 */
+    uint8_t reserved;
+    TraceRing_Event_TypeDef *buf;  /**< 事件存储 */
+    uint32_t check;                /**< 控制块校验(跨复位时检查) */
+} TraceRing_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化环形缓冲
+ * @author Yukikaze
+ *
+ * @param r 控制块
+ * @param buf 事件存储
+ * @param len 容量(2的幂)
+ * @param mode 写满策略
+ * @return int 0=成功, -1=参数错误
+ */
+int TraceRing_Init(TraceRing_TypeDef *r, TraceRing_Event_TypeDef *buf, uint32_t len,
+                   TraceRing_Mode_t mode);
+
+/**
+ * @brief 检查控制块是否有效(用于复位后判断缓冲内容是否可信)
+ * @author Yukikaze
+ *
+ * @param r 控制块
+ * @param buf 期望的事件存储地址
+ * @param len 期望的容量
+ * @return int 1=有效, 0=无效
+ */
+int TraceRing_IsValid(const TraceRing_TypeDef *r, const TraceRing_Event_TypeDef *buf,
+                      uint32_t len);
+
+/**
+ * @brief 写入一个事件
+ * @author Yukikaze
+ *
+ * @return int 1=已写入, 0=被丢弃(停止模式写满或已冻结)
+ */
+int TraceRing_Put(TraceRing_TypeDef *r, uint32_t ts, uint8_t type, uint8_t id, uint16_t arg);
+
+/**
+ * @brief 下一次写入将覆盖的事件
+ * @author Yukikaze
+ *
+ * @param r 控制块
+ * @param out 输出被覆盖的事件
+ * @return int 1=下一次写入会覆盖最旧事件(已输出), 0=不会覆盖(未写满、停止模式或已冻结)
+ *
+ * @note 调用者用它维护随最旧事件一起丢失的状态(例如被覆盖的时间戳高位同步事件)，
+ *       须与随后的TraceRing_Put在同一临界区内
+ */
+int TraceRing_Evicts(const TraceRing_TypeDef *r, TraceRing_Event_TypeDef *out);
+
+/**
+ * @brief 冻结/解冻缓冲
+ * @author Yukikaze
+ */
+void TraceRing_Freeze(TraceRing_TypeDef *r, uint8_t frozen);
+
+/**
+ * @brief 最旧的有效事件序号
+ * @author Yukikaze
+ */
+uint32_t TraceRing_Tail(const TraceRing_TypeDef *r);
+
+/**
+ * @brief 从游标处读出事件
+ * @author Yukikaze
+ *
+ * @param r 控制块
+ * @param cursor 读游标(绝对序号)，返回时更新
+ * @param out 输出缓冲
+ * @param max 输出缓冲容量
+ * @param lost 游标被写者超越而丢失的事件数(可为NULL)
+ * @return uint32_t 实际读出的事件数
+ */
+uint32_t TraceRing_Read(const TraceRing_TypeDef *r, uint32_t *cursor,
+                        TraceRing_Event_TypeDef *out, uint32_t max, uint32_t *lost);
+
+/**
+ * @brief 把事件编码为16位十六进制(8个字节按小端依次输出: ts(u32) type(u8) id(u8) arg(u16))
+ * @author Yukikaze
+ *
+ * @param e 事件
+ * @param out 输出缓冲(至少TRACE_RING_HEX_LEN+1字节，以'\0'结尾)
+ *
+ * @note 按字段移位编码，与结构体在内存中的布局和主机字节序无关；解码见tools/trace2json.py
+ */
+void TraceRing_Encode(const TraceRing_Event_TypeDef *e, char *out);
+
+#endif /* __TRACE_RING_H */
@@ -0,0 +1,289 @@
+/**
+ * @file tseries.c
+ * @brief 分级降采样时间序列存储实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "tseries.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 在环形缓冲中占用一个新位置(满时覆盖最旧元素)
+ * @return uint16_t 新元素的下标
+ */
+static uint16_t TSeries_RingPush(TSeries_Ring_TypeDef *r)
+{
+    uint16_t idx = r->head;
+
+    r->head = (uint16_t)((r->head + 1U < r->size) ? r->head + 1U : 0U);
+    if (r->used < r->size)
+    {
+        r->used++;
+    }
+    return idx;
+}
+
+/**
+ * @brief 第i旧元素的下标(i=0为最旧)
+ */
+static uint16_t TSeries_RingIndex(const TSeries_Ring_TypeDef *r, uint16_t i)
+{
+    uint32_t idx = (uint32_t)r->head + r->size - r->used + i;
+
+    return (uint16_t)((idx >= r->size) ? idx - r->size : idx);
+}
+
+/**
+ * @brief 向累加桶加入一组统计
+ */
+static void TSeries_AccAdd(TSeries_Acc_TypeDef *a, uint32_t t_start,
+                           int32_t min, int32_t max, int64_t sum, uint32_t count)
+{
+    if (a->count == 0)
+    {
+        a->t = t_start;
+        a->min = min;
+        a->max = max;
+        a->sum = sum;
+        a->count = count;
+        return;
+    }
+
+    if (min < a->min)
+    {
+        a->min = min;
+    }
+    if (max > a->max)
+    {
+        a->max = max;
+    }
+    a->sum += sum;
+    a->count += count;
+}
+
+/**
+ * @brief 累加桶 -> 聚合结果
+ */
+static void TSeries_AccToAgg(const TSeries_Acc_TypeDef *a, TSeries_Agg_TypeDef *out)
+{
+    out->t = a->t;
+    out->min = a->min;
+    out->max = a->max;
+    out->avg = (int32_t)(a->sum / (int64_t)a->count);
+    out->count = a->count;
+}
+
+/**
+ * @brief 关闭当前小时桶
+ */
+static void TSeries_CloseHour(TSeries_TypeDef *ts)
+{
+    TSeries_Agg_TypeDef *buf = (TSeries_Agg_TypeDef *)ts->hour.buf;
+
+    TSeries_AccToAgg(&ts->hour_acc, &buf[TSeries_RingPush(&ts->hour)]);
+    ts->hour_acc.count = 0;
+}
+
+/**
+ * @brief 关闭当前分钟桶，并合并到小时桶
+ */
+static void TSeries_CloseMinute(TSeries_TypeDef *ts)
+{
+    TSeries_Acc_TypeDef *m = &ts->min_acc;
+    TSeries_Agg_TypeDef *buf = (TSeries_Agg_TypeDef *)ts->minute.buf;
+    uint32_t hour_start = m->t - m->t % TSERIES_HOUR_SEC;
+
+    TSeries_AccToAgg(m, &buf[TSeries_RingPush(&ts->minute)]);
+
+    if (ts->hour_acc.count != 0 && ts->hour_acc.t != hour_start)
+    {
+        TSeries_CloseHour(ts);
+    }
+    TSeries_AccAdd(&ts->hour_acc, hour_start, m->min, m->max, m->sum, m->count);
+
+    m->count = 0;
+}
+
+/**
+ * @brief 从聚合环形缓冲中按时间范围取数据
+ */
+static uint16_t TSeries_QueryAgg(const TSeries_Ring_TypeDef *r, const TSeries_Acc_TypeDef *acc,
+                                 uint32_t t_from, uint32_t t_to,
+                                 TSeries_Agg_TypeDef *out, uint16_t max)
+{
+    const TSeries_Agg_TypeDef *buf = (const TSeries_Agg_TypeDef *)r->buf;
+    uint16_t n = 0;
+
+    for (uint16_t i = 0; i < r->used && n < max; i++)
+    {
+        const TSeries_Agg_TypeDef *a = &buf[TSeries_RingIndex(r, i)];
+
+        if (a->t > t_to)
+        {
+            return n;
+        }
+        if (a->t >= t_from)
+        {
+            out[n++] = *a;
+        }
+    }
+
+    if (n < max && acc->count != 0 && acc->t >= t_from && acc->t <= t_to)
+    {
+        TSeries_AccToAgg(acc, &out[n++]);
+    }
+    return n;
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+int TSeries_Init(TSeries_TypeDef *ts,
+                 TSeries_Sample_TypeDef *raw, uint16_t raw_len,
+                 TSeries_Agg_TypeDef *minute, uint16_t min_len,
+                 TSeries_Agg_TypeDef *hour, uint16_t hour_len)
+{
+    if (ts == NULL || raw == NULL || minute == NULL || hour == NULL ||
+        raw_len == 0 || min_len == 0 || hour_len == 0)
+    {
+        return -1;
+    }
+
+    memset(ts, 0, sizeof(*ts));
+    ts->raw.buf = raw;
+    ts->raw.size = raw_len;
+    ts->minute.buf = minute;
+    ts->minute.size = min_len;
+    ts->hour.buf = hour;
+    ts->hour.size = hour_len;
+    return 0;
+}
+
+int TSeries_Append(TSeries_TypeDef *ts, uint32_t t, int32_t v)
+{
+    TSeries_Sample_TypeDef *s;
+    uint32_t min_start;
+    int closed = 0;
+
+    if (ts->total != 0 && t < ts->last_t)
+    {
+        ts->dropped++;
+        return -1;
+    }
+    ts->last_t = t;
+    ts->total++;
+
+    s = &((TSeries_Sample_TypeDef *)ts->raw.buf)[TSeries_RingPush(&ts->raw)];
+    s->t = t;
+    s->v = v;
+
+    /* 跨分钟边界时先关闭旧桶；跨小时但中间没有样本时，小时桶在下一次关闭分钟桶时处理 */
+    min_start = t - t % TSERIES_MINUTE_SEC;
+    if (ts->min_acc.count != 0 && ts->min_acc.t != min_start)
+    {
+        TSeries_CloseMinute(ts);
+        closed = 1;
+    }
+    TSeries_AccAdd(&ts->min_acc, min_start, v, v, v, 1);
+
+    return closed;
+}
+
+int TSeries_Latest(const TSeries_TypeDef *ts, TSeries_Tier_t tier, TSeries_Agg_TypeDef *out)
+{
+    const TSeries_Ring_TypeDef *r;
+    const TSeries_Sample_TypeDef *s;
+
+    switch (tier)
+    {
+    case TSERIES_TIER_RAW:
+        r = &ts->raw;
+        break;
+    case TSERIES_TIER_MINUTE:
+        r = &ts->minute;
+        break;
+    case TSERIES_TIER_HOUR:
+        r = &ts->hour;
+        break;
+    default:
+        return -1;
+    }
+
+    if (r->used == 0)
+    {
+        return -1;
+    }
+
+    if (tier == TSERIES_TIER_RAW)
+    {
+        s = &((const TSeries_Sample_TypeDef *)r->buf)[TSeries_RingIndex(r, (uint16_t)(r->used - 1U))];
+        out->t = s->t;
+        out->min = s->v;
+        out->max = s->v;
+        out->avg = s->v;
+        out->count = 1;
+    }
+    else
+    {
+        *out = ((const TSeries_Agg_TypeDef *)r->buf)[TSeries_RingIndex(r, (uint16_t)(r->used - 1U))];
+    }
+    return 0;
+}
+
+uint16_t TSeries_Query(const TSeries_TypeDef *ts, TSeries_Tier_t tier,
+                       uint32_t t_from, uint32_t t_to,
+                       TSeries_Agg_TypeDef *out, uint16_t max)
+{
+    const TSeries_Sample_TypeDef *buf;
+    uint16_t n = 0;
+
+    if (ts == NULL || out == NULL || t_from > t_to)
+    {
+        return 0;
+    }
+
+    switch (tier)
+    {
+    case TSERIES_TIER_RAW:
+        buf = (const TSeries_Sample_TypeDef *)ts->raw.buf;
+        for (uint16_t i = 0; i < ts->raw.used && n < max; i++)
+        {
+            const TSeries_Sample_TypeDef *s = &buf[TSeries_RingIndex(&ts->raw, i)];
+
+            if (s->t > t_to)
+            {
+                break;
+            }
+            if (s->t >= t_from)
+            {
+                out[n].t = s->t;
+                out[n].min = s->v;
+                out[n].max = s->v;
+                out[n].avg = s->v;
+                out[n].count = 1;
+                n++;
+            }
+        }
+        return n;
+
+    case TSERIES_TIER_MINUTE:
+        return TSeries_QueryAgg(&ts->minute, &ts->min_acc, t_from, t_to, out, max);
+
+    case TSERIES_TIER_HOUR:
+        return TSeries_QueryAgg(&ts->hour, &ts->hour_acc, t_from, t_to, out, max);
+
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * @file tseries.h
+ * @brief 分级降采样时间序列存储头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个序列由三级环形缓冲组成:
+ *       - 原始级: 最近N个原始样本(时间戳 + 值)
+ *       - 分钟级: 每分钟一个聚合桶(min/max/avg/count)
+ *       - 小时级: 每小时一个聚合桶，由分钟桶合并而来
+ *       所有存储由调用者提供，容量固定，写满后覆盖最旧数据
+ *       插入为O(1)且不含除法(只有桶关闭时做一次求平均)
+ *       本模块不访问任何硬件，可直接在主机上编译验证
+ */
+
+#ifndef __TSERIES_H
+#define __TSERIES_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define TSERIES_MINUTE_SEC 60U  /**< 分钟桶宽度(秒) */
+#define TSERIES_HOUR_SEC 3600U  /**< 小时桶宽度(秒) */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 存储级别
+ */
+typedef enum
+{
+    TSERIES_TIER_RAW = 0, /**< 原始样本 */
+    TSERIES_TIER_MINUTE,  /**< 分钟聚合 */
+    TSERIES_TIER_HOUR,    /**< 小时聚合 */
+} TSeries_Tier_t;
+
+/**
+ * @brief 原始样本
+ */
+typedef struct
+{
+    uint32_t t; /**< 时间戳(秒) */
+    int32_t v;  /**< 样本值 */
+} TSeries_Sample_TypeDef;
+
+/**
+ * @brief 聚合桶(查询结果统一使用此结构，原始样本的 min=max=avg=v, count=1)
+ */
+typedef struct
+{
+    uint32_t t;     /**< 桶起始时间(秒) */
+    int32_t min;    /**< 最小值 */
+    int32_t max;    /**< 最大值 */
+    int32_t avg;    /**< 平均值(向零取整) */
+    uint32_t count; /**< 样本数 */
+} TSeries_Agg_TypeDef;
+
+/**
+ * @brief 正在累加的桶
+ */
+typedef struct
+{
+    uint32_t t;     /**< 桶起始时间 */
+    int32_t min;
+    int32_t max;
+    int64_t sum;    /**< 样本和 */
+    uint32_t count; /**< 0=空桶 */
+} TSeries_Acc_TypeDef;
+
+/**
+ * @brief 环形缓冲描述
+ */
+typedef struct
+{
+    void *buf;     /**< 存储区 */
+    uint16_t size; /**< 容量(元素个数) */
+    uint16_t head; /**< 下一个写入位置 */
+    uint16_t used; /**< 已用元素个数 */
+} TSeries_Ring_TypeDef;
+
+/**
+ * @brief 时间序列
+ */
+typedef struct
+{
+    TSeries_Ring_TypeDef raw;    /**< 原始级(TSeries_Sample_TypeDef) */
+    TSeries_Ring_TypeDef minute; /**< 分钟级(TSeries_Agg_TypeDef) */
+    TSeries_Ring_TypeDef hour;   /**< 小时级(TSeries_Agg_TypeDef) */
+    TSeries_Acc_TypeDef min_acc; /**< 当前分钟桶 */
+    TSeries_Acc_TypeDef hour_acc;/**< 当前小时桶 */
+    uint32_t last_t;             /**< 最近一次插入的时间戳 */
+    uint32_t total;              /**< 累计插入样本数 */
+    uint32_t dropped;            /**< 因时间倒退被丢弃的样本数 */
+} TSeries_TypeDef;
+
+/**
+ * @brief 计算一个序列占用的存储字节数(控制块 + 三级缓冲)
+ */
+#define TSERIES_FOOTPRINT(raw_len, min_len, hour_len)            \
+    (sizeof(TSeries_TypeDef) +                                   \
+     (raw_len) * sizeof(TSeries_Sample_TypeDef) +                \
+     ((min_len) + (hour_len)) * sizeof(TSeries_Agg_TypeDef))
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化时间序列
+ * @author Yukikaze
+ *
+ * @param ts 序列
+ * @param raw 原始级存储
+ * @param raw_len 原始级容量
+ * @param minute 分钟级存储
+ * @param min_len 分钟级容量
+ * @param hour 小时级存储
+ * @param hour_len 小时级容量
+ * @return int 0=成功, -1=参数错误
+ *
+ * @note 存储区内容无需预先清零
+ */
+int TSeries_Init(TSeries_TypeDef *ts,
+                 TSeries_Sample_TypeDef *raw, uint16_t raw_len,
+                 TSeries_Agg_TypeDef *minute, uint16_t min_len,
+                 TSeries_Agg_TypeDef *hour, uint16_t hour_len);
+
+/**
+ * @brief 插入一个样本
+ * @author Yukikaze
+ *
+ * @param ts 序列
+ * @param t 时间戳(秒，单调不减)
+ * @param v 样本值
+ * @return int 0=成功, 1=成功且关闭了一个分钟桶, -1=时间戳倒退(样本被丢弃)
+ *
+ * @note 跨越分钟/小时边界时关闭当前桶并滚动到上一级
+ */
+int TSeries_Append(TSeries_TypeDef *ts, uint32_t t, int32_t v);
+
+/**
+ * @brief 取指定级别中最新的一项(不含正在累加的桶)
+ * @author Yukikaze
+ *
+ * @param ts 序列
+ * @param tier 存储级别
+ * @param out 输出
+ * @return int 0=成功, -1=该级别为空
+ */
+int TSeries_Latest(const TSeries_TypeDef *ts, TSeries_Tier_t tier, TSeries_Agg_TypeDef *out);
+
+/**
+ * @brief 按时间范围查询
+ * @author Yukikaze
+ *
+ * @param ts 序列
+ * @param tier 存储级别
+ * @param t_from 起始时间(含)
+ * @param t_to 结束时间(含)
+ * @param out 输出缓冲
+ * @param max 输出缓冲容量
+ * @return uint16_t 实际输出个数，按时间从旧到新排列
+ *
+ * @note 聚合级按桶起始时间筛选，正在累加的桶也会作为最后一项输出
+ *       (小时级的当前桶只包含已关闭的分钟)
+ *       结果超过max时只输出最旧的max项
+ */
+uint16_t TSeries_Query(const TSeries_TypeDef *ts, TSeries_Tier_t tier,
+                       uint32_t t_from, uint32_t t_to,
+                       TSeries_Agg_TypeDef *out, uint16_t max);
+
+#endif /* __TSERIES_H */
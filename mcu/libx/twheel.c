@@ -0,0 +1,260 @@
+/**
+ * @file twheel.c
+ * @brief 分层时间轮定时器实现
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "twheel.h"
+#include <stddef.h>
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static inline void TWheel_ListInit(TWheel_Node_TypeDef *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static inline void TWheel_ListAdd(TWheel_Node_TypeDef *head, TWheel_Node_TypeDef *n)
+{
+    n->prev = head->prev;
+    n->next = head;
+    head->prev->next = n;
+    head->prev = n;
+}
+
+static inline void TWheel_ListDel(TWheel_Node_TypeDef *n)
+{
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    n->next = n;
+    n->prev = n;
+}
+
+/**
+ * @brief 把整条链表移到新的表头下(原表头置空)
+ */
+static inline void TWheel_ListMove(TWheel_Node_TypeDef *from, TWheel_Node_TypeDef *to)
+{
+    if (from->next == from)
+    {
+        TWheel_ListInit(to);
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    TWheel_ListInit(from);
+}
+
+/**
+ * @brief 按剩余时间把定时器挂到对应层的槽
+ */
+static void TWheel_Insert(TWheel_TypeDef *w, TWheel_Timer_TypeDef *t)
+{
+    uint32_t diff = t->expires - w->now;
+    uint32_t when = t->expires;
+    uint8_t level = 0;
+
+    /* 超出范围的延时先挂在最高层最远的槽，下放时再重新计算 */
+    if (diff > TWHEEL_MAX_DELAY)
+    {
+        diff = TWHEEL_MAX_DELAY;
+        when = w->now + TWHEEL_MAX_DELAY;
+    }
+
+    while (level + 1U < TWHEEL_LEVELS && diff >= (1UL << ((level + 1U) * TWHEEL_SLOT_BITS)))
+    {
+        level++;
+    }
+
+    TWheel_ListAdd(&w->slot[level][(when >> (level * TWHEEL_SLOT_BITS)) & TWHEEL_SLOT_MASK],
+                   &t->node);
+}
+
+/**
+ * @brief 把第level层的一个槽按剩余时间重新插入(落到更低层)
+ */
+static void TWheel_Cascade(TWheel_TypeDef *w, uint8_t level, uint32_t index)
+{
+    TWheel_Node_TypeDef list;
+
+    TWheel_ListMove(&w->slot[level][index], &list);
+    while (list.next != &list)
+    {
+        TWheel_Node_TypeDef *n = list.next;
+
+        TWheel_ListDel(n);
+        TWheel_Insert(w, (TWheel_Timer_TypeDef *)n);
+    }
+}
+
+/**
+ * ============================================================================
+ * 函数实现
+ * ============================================================================
+ */
+
+void TWheel_Init(TWheel_TypeDef *w, uint32_t now)
+{
+    for (uint8_t l = 0; l < TWHEEL_LEVELS; l++)
+    {
+        for (uint32_t i = 0; i < TWHEEL_SLOTS; i++)
+        {
+            TWheel_ListInit(&w->slot[l][i]);
+        }
+    }
+    w->now = now;
+    w->count = 0;
+}
+
+void TWheel_TimerInit(TWheel_Timer_TypeDef *t, TWheel_Callback_t cb, void *ctx)
+{
+    TWheel_ListInit(&t->node);
+    t->expires = 0;
+    t->period = 0;
+    t->cb = cb;
+    t->ctx = ctx;
+    t->active = 0;
+}
+
+void TWheel_Start(TWheel_TypeDef *w, TWheel_Timer_TypeDef *t, uint32_t delay, uint32_t period)
+{
+    TWheel_Stop(w, t);
+
+    t->expires = w->now + ((delay != 0) ? delay : 1U);
+    t->period = period;
+    t->active = 1;
+    w->count++;
+    TWheel_Insert(w, t);
+}
+
+void TWheel_Stop(TWheel_TypeDef *w, TWheel_Timer_TypeDef *t)
+{
+    if (!t->active)
+    {
+        return;
+    }
+    TWheel_ListDel(&t->node);
+    t->active = 0;
+    w->count--;
+}
+
+uint32_t TWheel_Tick(TWheel_TypeDef *w)
+{
+    TWheel_Node_TypeDef list;
+    uint32_t fired = 0;
+    uint32_t index;
+
+    w->now++;
+    index = w->now & TWHEEL_SLOT_MASK;
+
+    /* 第0层转完一圈时，从高层到低层依次下放 */
+    if (index == 0)
+    {
+        uint8_t level = 1;
+
+        while (level < TWHEEL_LEVELS)
+        {
+            uint32_t idx = (w->now >> (level * TWHEEL_SLOT_BITS)) & TWHEEL_SLOT_MASK;
+
+            if (idx != 0 || level + 1U == TWHEEL_LEVELS)
+            {
+                break;
+            }
+            level++;
+        }
+        for (; level >= 1; level--)
+        {
+            TWheel_Cascade(w, level, (w->now >> (level * TWHEEL_SLOT_BITS)) & TWHEEL_SLOT_MASK);
+        }
+    }
+
+    /* 先摘下整个槽，回调中启动/停止定时器不会影响遍历 */
+    TWheel_ListMove(&w->slot[0][index], &list);
+    while (list.next != &list)
+    {
+        TWheel_Timer_TypeDef *t = (TWheel_Timer_TypeDef *)list.next;
+
+        TWheel_ListDel(&t->node);
+        if (t->expires != w->now)
+        {
+            /* 超长延时的中途下放 */
+            TWheel_Insert(w, t);
+            continue;
+        }
+
+        if (t->period != 0)
+        {
+            t->expires = w->now + t->period;
+            TWheel_Insert(w, t);
+        }
+        else
+        {
+            t->active = 0;
+            w->count--;
+        }
+
+        fired++;
+        if (t->cb != NULL)
+        {
+            t->cb(t, t->ctx);
+        }
+    }
+
+    return fired;
+}
+
+uint32_t TWheel_NextDelay(const TWheel_TypeDef *w, uint32_t limit)
+{
+    uint32_t best = limit;
+
+    if (w->count == 0 || limit <= 1U)
+    {
+        return (limit != 0) ? limit : 1U;
+    }
+
+    /* 第0层: 逐槽查找，命中即为精确值 */
+    for (uint32_t d = 1; d < TWHEEL_SLOTS && d < best; d++)
+    {
+        const TWheel_Node_TypeDef *head = &w->slot[0][(w->now + d) & TWHEEL_SLOT_MASK];
+
+        if (head->next != head)
+        {
+            best = d;
+            break;
+        }
+    }
+
+    /* 高层: 槽内定时器最早在该槽下放时到期 */
+    for (uint8_t level = 1; level < TWHEEL_LEVELS; level++)
+    {
+        uint8_t shift = (uint8_t)(level * TWHEEL_SLOT_BITS);
+        uint32_t base = w->now >> shift;
+
+        for (uint32_t k = 1; k <= TWHEEL_SLOTS; k++)
+        {
+            const TWheel_Node_TypeDef *head = &w->slot[level][(base + k) & TWHEEL_SLOT_MASK];
+            uint32_t d;
+
+            if (head->next == head)
+            {
+                continue;
+            }
+            d = ((base + k) << shift) - w->now;
+            if (d < best)
+            {
+                best = d;
+            }
+            break;
+        }
+    }
+
+    return (best != 0) ? best : 1U;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file twheel.h
+ * @brief 分层时间轮定时器头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 4层 × 64槽的分层时间轮(与Linux内核timer wheel同构):
+ *       - 第k层每槽跨度 64^k 个节拍，总范围 2^24 个节拍(1ms节拍约4.6小时)，
+ *         更长的延时先挂在最高层，到期前逐级重新插入
+ *       - 启动/停止为O(1)；每个节拍只处理第0层的一个槽，
+ *         每64个节拍把上一层的一个槽下放一次，均摊为O(1)
+ *       - 定时器结构由调用者提供(侵入式链表)，不使用动态内存
+ *       本模块不加锁、不访问硬件，并发保护由调用者负责，可直接在主机上编译验证
+ */
+
+#ifndef __TWHEEL_H
+#define __TWHEEL_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define TWHEEL_LEVELS 4                            /**< 层数 */
+#define TWHEEL_SLOT_BITS 6                         /**< 每层槽数的位数 */
+#define TWHEEL_SLOTS (1U << TWHEEL_SLOT_BITS)      /**< 每层槽数 */
+#define TWHEEL_SLOT_MASK (TWHEEL_SLOTS - 1U)
+#define TWHEEL_MAX_DELAY ((1UL << (TWHEEL_LEVELS * TWHEEL_SLOT_BITS)) - 1UL) /**< 单次挂入的最大延时 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 双向循环链表节点
+ */
+typedef struct TWheel_Node
+{
+    struct TWheel_Node *next;
+    struct TWheel_Node *prev;
+} TWheel_Node_TypeDef;
+
+struct TWheel_Timer;
+
+/**
+ * @brief 到期回调
+ *
+ * @note 在 TWheel_Tick 的调用者上下文中执行，回调中可以启动/停止任何定时器
+ */
+typedef void (*TWheel_Callback_t)(struct TWheel_Timer *timer, void *ctx);
+
+/**
+ * @brief 定时器
+ */
+typedef struct TWheel_Timer
+{
+    TWheel_Node_TypeDef node; /**< 链表节点(必须为第一个成员) */
+    uint32_t expires;         /**< 到期节拍 */
+    uint32_t period;          /**< 周期(0=单次) */
+    TWheel_Callback_t cb;     /**< 回调 */
+    void *ctx;                /**< 回调参数 */
+    uint8_t active;           /**< 是否已挂入时间轮 */
+} TWheel_Timer_TypeDef;
+
+/**
+ * @brief 时间轮
+ */
+typedef struct
+{
+    TWheel_Node_TypeDef slot[TWHEEL_LEVELS][TWHEEL_SLOTS]; /**< 各层槽链表头 */
+    uint32_t now;                                          /**< 当前节拍 */
+    uint32_t count;                                        /**< 活动定时器数 */
+} TWheel_TypeDef;
+
+/**
+ * ============================================================================
+ * 函数声明
+ * ============================================================================
+ */
+
+/**
+ * @brief 初始化时间轮
+ * @author Yukikaze
+ *
+ * @param w 时间轮
+ * @param now 当前节拍
+ */
+void TWheel_Init(TWheel_TypeDef *w, uint32_t now);
+
+/**
+ * @brief 初始化定时器
+ * @author Yukikaze
+ *
+ * @param t 定时器
+ * @param cb 到期回调
+ * @param ctx 回调参数
+ */
+void TWheel_TimerInit(TWheel_Timer_TypeDef *t, TWheel_Callback_t cb, void *ctx);
+
+/**
+ * @brief 启动定时器(已启动时重新开始计时)
+ * @author Yukikaze
+ *
+ * @param w 时间轮
+ * @param t 定时器
+ * @param delay 首次到期延时(节拍，0按1处理)
+ * @param period 周期(节拍，0=单次)
+ */
+void TWheel_Start(TWheel_TypeDef *w, TWheel_Timer_TypeDef *t, uint32_t delay, uint32_t period);
+
+/**
+ * @brief 停止定时器(未启动时无操作)
+ * @author Yukikaze
+ */
+void TWheel_Stop(TWheel_TypeDef *w, TWheel_Timer_TypeDef *t);
+
+/**
+ * @brief 推进一个节拍并执行到期的定时器
+ * @author Yukikaze
+ *
+ * @return uint32_t 本节拍执行的回调数
+ */
+uint32_t TWheel_Tick(TWheel_TypeDef *w);
+
+/**
+ * @brief 估计距离下一次到期的节拍数
+ * @author Yukikaze
+ *
+ * @param w 时间轮
+ * @param limit 上限(无活动定时器时直接返回)
+ * @return uint32_t 1~limit，保证在此之前不会有定时器到期(高层槽按下放时刻保守估计)
+ *
+ * @note 用于无节拍空闲决定可以休眠多久，休眠后用TWheel_Tick逐拍补齐
+ */
+uint32_t TWheel_NextDelay(const TWheel_TypeDef *w, uint32_t limit);
+
+#endif /* __TWHEEL_H */
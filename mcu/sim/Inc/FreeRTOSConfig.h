@@ -0,0 +1,27 @@
+/**
+ * @file FreeRTOSConfig.h
+ * @brief 主机仿真构建的FreeRTOS配置
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 沿用目标板配置(mcu/user/FreeRTOSConfig.h)，只覆盖仿真移植层需要不同的几项:
+ *       - 无节拍空闲由sim_power.c实现(只有SLEEP路径)；空闲钩子在预计空闲不足
+ *         2个节拍时把模拟时间推进到下一个节拍
+ *       - 断言在输出后记入仿真结果，进程以非零状态退出
+ */
+
+#ifndef SIM_FREERTOS_CONFIG_H
+#define SIM_FREERTOS_CONFIG_H
+
+#include "../../user/FreeRTOSConfig.h"
+
+#include <stdio.h>
+
+#undef configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK 1
+
+extern void Sim_AssertFailed(const char *file, int line);
+#undef vAssertCalled
+#define vAssertCalled(char,int) (AppTrace_Freeze(1 /* APP_TRACE_REASON_ASSERT */), printf("Error:%s,%d\r\n",char,int), Sim_AssertFailed(char,int))
+
+#endif /* SIM_FREERTOS_CONFIG_H */
@@ -0,0 +1,33 @@
+/**
+ * @file bsp_adc.h
+ * @brief 仿真光敏电阻ADC头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口与mcu/bsp/adc/Inc/bsp_adc.h相同；sim_adc.c每个节拍产生
+ *       SIM_ADC_SAMPLES_PER_TICK个样本，按目标板ADC中断的顺序处理模拟看门狗与CIC抽取
+ *       (目标板EOC中断约330kHz，仿真按比例降低采样率，CIC每个节拍输出一次)
+ */
+
+#ifndef __BSP_PHOTORESISTOR_H
+#define	__BSP_PHOTORESISTOR_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+#include "filter.h"
+
+#define    ADC_CIC_ORDER                 3
+#define    ADC_CIC_DECIM                 16
+
+/* 每个节拍的仿真样本数 */
+#define    SIM_ADC_SAMPLES_PER_TICK      ADC_CIC_DECIM
+
+extern __IO uint16_t ADC_ConvertedValue;
+extern Filter_CIC_TypeDef ADC_LightCIC;
+
+void PhotoResistor_Init(void);
+void PhotoResistor_AWD_Arm(uint16_t low, uint16_t high);
+void PhotoResistor_AWD_Disarm(void);
+uint16_t PhotoResistor_ReadVrefint(void);
+
+#endif /* __BSP_PHOTORESISTOR_H */
@@ -0,0 +1,33 @@
+/**
+ * @file bsp_dht11.h
+ * @brief 仿真DHT11温湿度传感器头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口与mcu/bsp/dht11/Inc/bsp_dht11.h相同；读数来自仿真场景(sim_dht11.c)，
+ *       一次读取按目标驱动的时序(起始信号20ms + 40位数据)计入忙等时间
+ */
+
+#ifndef __DHT11_H_
+#define __DHT11_H_
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+#define DHT11_HIGH 1
+#define DHT11_LOW 0
+
+typedef struct
+{
+    uint8_t humi_int;  // 湿度的整数部分
+    uint8_t humi_deci; // 湿度的小数部分
+    uint8_t temp_int;  // 温度的整数部分
+    uint8_t temp_deci; // 温度的小数部分
+    uint8_t check_sum; // 校验和
+} DHT11_Data_TypeDef;
+
+void DHT11_GPIO_Config(void);
+
+uint8_t Read_DHT11(DHT11_Data_TypeDef *DHT11_Data);
+
+#endif //__DHT11_H_
@@ -0,0 +1,29 @@
+/**
+ * @file bsp_flash.h
+ * @brief 仿真片内Flash头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口与存储布局同mcu/bsp/flash/Inc/bsp_flash.h；sim_flash.c把1MB主机内存
+ *       映射到同一地址(0x08000000)，应用层按地址直接读取的代码无需修改
+ *       擦除/编程时间按数据手册典型值计入忙等，期间中断保持屏蔽(取指被阻塞)
+ */
+
+#ifndef __BSP_FLASH_H
+#define __BSP_FLASH_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+#define BSP_FLASH_BASE 0x08000000UL       /**< 片内Flash起始地址 */
+#define BSP_FLASH_SIZE (1024UL * 1024UL)  /**< 片内Flash容量 */
+#define BSP_FLASH_LOG_ADDR 0x08080000UL   /**< 扇区8~10: 传感器日志 */
+#define BSP_FLASH_LOG_SECTORS 3           /**< 日志扇区数 */
+#define BSP_FLASH_LOG_SECTOR_SIZE 0x20000UL
+#define BSP_FLASH_CALIB_ADDR 0x080E0000UL /**< 扇区11: 标定数据 */
+
+int BSP_Flash_GetSector(uint32_t addr, uint32_t *base, uint32_t *size);
+int BSP_Flash_EraseSector(uint32_t addr);
+int BSP_Flash_Program(uint32_t addr, const uint32_t *words, uint32_t count);
+
+#endif /* __BSP_FLASH_H */
@@ -0,0 +1,20 @@
+/**
+ * @file bsp_iic.h
+ * @brief 仿真I2C总线头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 总线上只有OLED，传输时间由sim_oled.c计算，这里只保留初始化接口
+ */
+
+#ifndef __BSP_IIC_SOFTWARE_H
+#define __BSP_IIC_SOFTWARE_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+void IIC_GPIO_Config(void);
+void IIC_ClockUpdate(void);
+void IIC_ClockSync(void);
+
+#endif
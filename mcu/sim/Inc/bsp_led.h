@@ -0,0 +1,100 @@
+/**
+ * @file bsp_led.h
+ * @brief 仿真RGB LED头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口与mcu/bsp/led/Inc/bsp_led.h相同(低电平点亮: ON=0, OFF=1)，
+ *       状态变化记入sim_led.c，详细输出模式下打印
+ */
+
+#ifndef __LED_H
+#define __LED_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+#define ON 0
+#define OFF 1
+
+/**
+ * @brief 设置LED状态
+ *
+ * @param led 0=LED1(红) 1=LED2(绿) 2=LED3(蓝)
+ * @param on 1=点亮
+ */
+void Sim_Led_Write(uint8_t led, uint8_t on);
+
+/**
+ * @brief 翻转LED状态
+ */
+void Sim_Led_Toggle(uint8_t led);
+
+/* 带参宏，参数为ON/OFF */
+#define LED1(a) Sim_Led_Write(0U, (a) ? 0U : 1U)
+#define LED2(a) Sim_Led_Write(1U, (a) ? 0U : 1U)
+#define LED3(a) Sim_Led_Write(2U, (a) ? 0U : 1U)
+
+#define LED1_TOGGLE Sim_Led_Toggle(0U)
+#define LED1_OFF Sim_Led_Write(0U, 0U)
+#define LED1_ON Sim_Led_Write(0U, 1U)
+
+#define LED2_TOGGLE Sim_Led_Toggle(1U)
+#define LED2_OFF Sim_Led_Write(1U, 0U)
+#define LED2_ON Sim_Led_Write(1U, 1U)
+
+#define LED3_TOGGLE Sim_Led_Toggle(2U)
+#define LED3_OFF Sim_Led_Write(2U, 0U)
+#define LED3_ON Sim_Led_Write(2U, 1U)
+
+// 红
+#define LED_RED \
+    LED1_ON;    \
+    LED2_OFF;   \
+    LED3_OFF
+
+// 绿
+#define LED_GREEN \
+    LED1_OFF;     \
+    LED2_ON;      \
+    LED3_OFF
+
+// 蓝
+#define LED_BLUE \
+    LED1_OFF;    \
+    LED2_OFF;    \
+    LED3_ON
+
+// 黄(红+绿)
+#define LED_YELLOW \
+    LED1_ON;       \
+    LED2_ON;       \
+    LED3_OFF
+
+// 紫(红+蓝)
+#define LED_PURPLE \
+    LED1_ON;       \
+    LED2_OFF;      \
+    LED3_ON
+
+// 青(绿+蓝)
+#define LED_CYAN \
+    LED1_OFF;    \
+    LED2_ON;     \
+    LED3_ON
+
+// 白(红+绿+蓝)
+#define LED_WHITE \
+    LED1_ON;      \
+    LED2_ON;      \
+    LED3_ON
+
+// 黑(全部关闭)
+#define LED_RGBOFF \
+    LED1_OFF;      \
+    LED2_OFF;      \
+    LED3_OFF
+
+void LED_GPIO_Config(void);
+
+#endif /* __LED_H */
@@ -0,0 +1,31 @@
+/**
+ * @file bsp_oled.h
+ * @brief 仿真OLED(SSD1306, 128x64)头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口与mcu/bsp/oled/Inc/bsp_oled.h相同；sim_oled.c按字符单元保存屏幕内容，
+ *       并按目标驱动的I2C传输划分(命令/数据按批发送)计入忙等时间
+ */
+
+#ifndef __BSP_OLED_DEBUG_H
+#define __BSP_OLED_DEBUG_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+#define IIC_SELECT 1
+
+#define OLED_ID          0x78
+#define OLED_WR_CMD      0x00
+#define OLED_WR_DATA     0x40
+
+void OLED_Init(void);
+void OLED_SetPos(unsigned char x, unsigned char y);
+void OLED_Fill(unsigned char fill_data);
+void OLED_CLS(void);
+void OLED_ON(void);
+void OLED_OFF(void);
+void OLED_ShowStr(unsigned char x, unsigned char y, unsigned char ch[], unsigned char textsize);
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file bsp_usart.h
+ * @brief 仿真调试串口头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 发送即进程标准输出(printf)；接收字符来自仿真场景(-e MS:uart=TEXT)，
+ *       按115200波特率的字符间隔在中断上下文中交给Task_Prof_CommandFromISR
+ */
+
+#ifndef __USART_H
+#define __USART_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+#include <stdio.h>
+
+#define USARTx_BAUDRATE 115200 // 串口波特率
+
+void USARTx_Config(void);
+void USARTx_RxIT_Config(void);
+void USARTx_WaitIdle(void);
+void USARTx_ClockUpdate(void);
+
+#endif /* __USART_H */
@@ -0,0 +1,33 @@
+/**
+ * @file core_delay.h
+ * @brief 仿真DWT周期计数器与延时头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 接口同mcu/bsp/dwt/Inc/core_delay.h；计数器即模拟时间(内核时钟周期)，
+ *       忙等延时通过vPortSimConsume推进模拟时间，期间节拍与抢占照常发生
+ */
+
+#ifndef __CORE_DELAY_H
+#define __CORE_DELAY_H
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+
+/* 获取内核时钟频率 */
+#define GET_CPU_ClkFreq()       (SystemCoreClock)
+#define SysClockFreq            (SystemCoreClock)
+
+uint32_t CPU_TS_TmrRd(void);
+void CPU_TS_TmrInit(void);
+uint64_t CPU_TS_Read64(void);
+void CPU_TS_Advance(uint32_t cycles);
+/* 运行时调频: 切换后记录新频率；时间戳按所在频率段换算为微秒 */
+void CPU_TS_ClockChanged(uint32_t hz);
+uint64_t CPU_TS_ToUs(uint64_t ts);
+
+void CPU_TS_Tmr_Delay_US(__IO uint32_t us);
+#define CPU_TS_Tmr_Delay_MS(ms)     CPU_TS_Tmr_Delay_US(ms*1000)
+#define CPU_TS_Tmr_Delay_S(s)       CPU_TS_Tmr_Delay_MS(s*1000)
+
+#endif /* __CORE_DELAY_H */
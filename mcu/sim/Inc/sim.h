@@ -0,0 +1,130 @@
+/**
+ * @file sim.h
+ * @brief 主机仿真层公共接口
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 主机仿真构建(project/sim)把应用层、libx与main.c编译为主机程序:
+ *       - FreeRTOS使用确定性仿真移植层(crm/freeRTOS/portable/GCC/Posix_Sim)
+ *       - BSP由本目录的仿真设备替换，接口与mcu/bsp相同；应用层中app_power.c与
+ *         app_bench_port.c直接访问寄存器，由sim_power.c与sim_bench.c替换
+ *       - 时间为模拟时间，外设输入来自命令行给出的场景，同样的参数得到同样的输出
+ *       仿真层之间通过本头文件交互，应用代码不包含它
+ */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#include <stdint.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define SIM_DEFAULT_TIME_MS 60000U /**< 默认仿真时长(模拟毫秒) */
+#define SIM_DEFAULT_SEED 1U        /**< 默认噪声种子 */
+#define SIM_MAX_EVENTS 64          /**< 场景事件数上限 */
+#define SIM_EVENT_TEXT_LEN 64      /**< 事件参数最大长度 */
+
+/**
+ * ============================================================================
+ * 数据结构
+ * ============================================================================
+ */
+
+/**
+ * @brief 场景事件类型
+ */
+typedef enum
+{
+    SIM_EVENT_LIGHT = 0, /**< light=N: 光照原始值固定为N；light=wave: 恢复正弦波形 */
+    SIM_EVENT_TEMP,      /**< temp=T,H: 温湿度固定为T℃/H%；temp=fail: DHT11无响应 */
+    SIM_EVENT_UART,      /**< uart=TEXT: 从串口输入TEXT */
+    SIM_EVENT_LIGHT_ISR, /**< lightisr=N: 在ADC中断中直接发布光照值N并读回 */
+} Sim_EventType_t;
+
+/**
+ * @brief 场景事件(按时间排序，节拍钩子中到期执行)
+ */
+typedef struct
+{
+    uint32_t ms;                    /**< 触发时刻(模拟毫秒) */
+    Sim_EventType_t type;           /**< 事件类型 */
+    char arg[SIM_EVENT_TEXT_LEN];   /**< 参数原文 */
+} Sim_Event_TypeDef;
+
+/**
+ * @brief 仿真运行参数
+ */
+typedef struct
+{
+    uint32_t time_ms;   /**< 仿真时长 */
+    uint32_t seed;      /**< 噪声种子 */
+    const char *flash;  /**< Flash镜像文件(NULL=不保存) */
+    uint8_t oled;       /**< 1=显示内容变化时输出OLED画面 */
+    uint8_t verbose;    /**< 1=输出LED变化与场景事件 */
+    uint8_t no_hse;     /**< 1=HSE不起振(验证HSI退路) */
+    uint8_t no_tickless; /**< 1=关闭无节拍空闲(每个节拍都唤醒，用于对比) */
+    uint8_t heap_stress; /**< 1=启动堆压力任务(sim_heap.c) */
+} Sim_Config_TypeDef;
+
+/**
+ * ============================================================================
+ * 仿真层接口
+ * ============================================================================
+ */
+
+/* 运行参数(sim_main.c) */
+extern Sim_Config_TypeDef g_xSimConfig;
+
+/**
+ * @brief 当前模拟时间(毫秒，按各段的内核频率换算，运行时调频后保持连续)
+ */
+uint32_t Sim_NowMs(void);
+
+/**
+ * @brief 内核频率变化(sim_periph.c的SystemCoreClockUpdate调用)
+ */
+void Sim_ClockChanged(uint32_t old_hz, uint32_t new_hz);
+
+/**
+ * @brief 确定性伪随机数(LCG，种子来自-s参数)
+ */
+uint32_t Sim_Rand(void);
+
+/**
+ * @brief 带模拟时间戳的仿真层输出(写到标准输出，与应用的串口输出按顺序交错)
+ */
+void Sim_Log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief 断言失败记录(FreeRTOSConfig.h中的vAssertCalled调用)，进程退出码变为2
+ */
+void Sim_AssertFailed(const char *file, int line);
+
+/* 各仿真设备: 场景事件、节拍处理、结束报告 */
+void Sim_Flash_Open(const char *path);
+void Sim_Flash_Report(void);
+
+void Sim_Adc_Event(const char *arg);
+void Sim_Adc_IsrPublish(const char *arg);
+void Sim_Adc_Tick(void);
+void Sim_Adc_Report(void);
+
+void Sim_Dht11_Event(const char *arg);
+void Sim_Dht11_Report(void);
+
+void Sim_Usart_Event(const char *arg);
+void Sim_Usart_Tick(void);
+void Sim_Usart_Report(void);
+
+void Sim_Oled_Tick(void);
+void Sim_Oled_Report(void);
+void Sim_Led_Report(void);
+void Sim_Power_Report(void);
+
+void Sim_Heap_Start(void);
+void Sim_Heap_Report(void);
+
+#endif /* __SIM_H */
@@ -0,0 +1,104 @@
+/**
+ * @file stm32f4xx.h
+ * @brief 主机仿真构建的器件头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 只提供应用层(mcu/app、mcu/libx)、main.c与bsp_clock.c用到的CMSIS类型、中断号与内核函数:
+ *       PRIMASK/IPSR读写转到仿真移植层，__NOP计为一个内核周期
+ *       外设寄存器不存在，BSP由mcu/sim中的仿真设备替换
+ */
+
+#ifndef __STM32F4xx_H
+#define __STM32F4xx_H
+
+#include <stdint.h>
+
+#define STM32F4XX_SIM 1
+
+#define __IO volatile
+#define __I volatile const
+#define __O volatile
+
+typedef enum
+{
+    RESET = 0,
+    SET = !RESET
+} FlagStatus,
+    ITStatus;
+
+typedef enum
+{
+    DISABLE = 0,
+    ENABLE = !DISABLE
+} FunctionalState;
+
+typedef enum
+{
+    ERROR = 0,
+    SUCCESS = !ERROR
+} ErrorStatus;
+
+#define __NVIC_PRIO_BITS 4
+
+/* 只列出仿真设备使用的中断号 */
+typedef enum
+{
+    NonMaskableInt_IRQn = -14,
+    SVCall_IRQn = -5,
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    RTC_WKUP_IRQn = 3,
+    ADC_IRQn = 18,
+    USART1_IRQn = 37,
+} IRQn_Type;
+
+#define HSE_VALUE ((uint32_t)25000000)
+#define HSI_VALUE ((uint32_t)16000000)
+
+extern uint32_t SystemCoreClock;
+extern void SystemCoreClockUpdate(void);
+
+/**
+ * ============================================================================
+ * 内核函数(CMSIS core_cmFunc.h / core_cmInstr.h)
+ * ============================================================================
+ */
+
+extern uint32_t ulPortSimGetPRIMASK(void);
+extern void vPortSimSetPRIMASK(uint32_t ulPriMask);
+extern uint32_t ulPortSimGetIPSR(void);
+extern void vPortSimConsume(uint32_t ulCycles);
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return ulPortSimGetPRIMASK();
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    vPortSimSetPRIMASK(priMask);
+}
+
+static inline void __disable_irq(void)
+{
+    vPortSimSetPRIMASK(1U);
+}
+
+static inline void __enable_irq(void)
+{
+    vPortSimSetPRIMASK(0U);
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    return ulPortSimGetIPSR();
+}
+
+#define __NOP() vPortSimConsume(1U)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __WFI() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+#endif /* __STM32F4xx_H */
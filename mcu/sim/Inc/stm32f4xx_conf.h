@@ -0,0 +1,100 @@
+/**
+ * @file stm32f4xx_conf.h
+ * @brief 主机仿真构建的标准外设库配置头文件
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 只声明main.c(NVIC配置)与bsp_clock.c(时钟树)用到的库函数，常量取值与标准外设库一致；
+ *       实现见sim_periph.c: 记录时钟树配置并据此计算SystemCoreClock
+ */
+
+#ifndef __STM32F4xx_CONF_H
+#define __STM32F4xx_CONF_H
+
+#include "stm32f4xx.h"
+
+/* misc.h */
+#define NVIC_PriorityGroup_0 ((uint32_t)0x700)
+#define NVIC_PriorityGroup_1 ((uint32_t)0x600)
+#define NVIC_PriorityGroup_2 ((uint32_t)0x500)
+#define NVIC_PriorityGroup_3 ((uint32_t)0x400)
+#define NVIC_PriorityGroup_4 ((uint32_t)0x300)
+
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup);
+
+/* stm32f4xx_rcc.h */
+#define RCC_HSE_OFF ((uint8_t)0x00)
+#define RCC_HSE_ON ((uint8_t)0x01)
+#define RCC_HSE_Bypass ((uint8_t)0x05)
+
+#define RCC_PLLSource_HSI ((uint32_t)0x00000000)
+#define RCC_PLLSource_HSE ((uint32_t)0x00400000)
+
+#define RCC_SYSCLKSource_HSI ((uint32_t)0x00000000)
+#define RCC_SYSCLKSource_HSE ((uint32_t)0x00000001)
+#define RCC_SYSCLKSource_PLLCLK ((uint32_t)0x00000002)
+
+#define RCC_SYSCLK_Div1 ((uint32_t)0x00000000)
+#define RCC_SYSCLK_Div2 ((uint32_t)0x00000080)
+#define RCC_SYSCLK_Div4 ((uint32_t)0x00000090)
+#define RCC_SYSCLK_Div8 ((uint32_t)0x000000A0)
+#define RCC_SYSCLK_Div16 ((uint32_t)0x000000B0)
+#define RCC_SYSCLK_Div64 ((uint32_t)0x000000C0)
+#define RCC_SYSCLK_Div128 ((uint32_t)0x000000D0)
+#define RCC_SYSCLK_Div256 ((uint32_t)0x000000E0)
+#define RCC_SYSCLK_Div512 ((uint32_t)0x000000F0)
+
+#define RCC_HCLK_Div1 ((uint32_t)0x00000000)
+#define RCC_HCLK_Div2 ((uint32_t)0x00001000)
+#define RCC_HCLK_Div4 ((uint32_t)0x00001400)
+#define RCC_HCLK_Div8 ((uint32_t)0x00001800)
+#define RCC_HCLK_Div16 ((uint32_t)0x00001C00)
+
+#define RCC_APB1Periph_PWR ((uint32_t)0x10000000)
+
+#define RCC_FLAG_HSIRDY ((uint8_t)0x21)
+#define RCC_FLAG_HSERDY ((uint8_t)0x31)
+#define RCC_FLAG_PLLRDY ((uint8_t)0x39)
+
+void RCC_DeInit(void);
+void RCC_HSEConfig(uint8_t RCC_HSE);
+ErrorStatus RCC_WaitForHSEStartUp(void);
+void RCC_PLLConfig(uint32_t RCC_PLLSource, uint32_t PLLM, uint32_t PLLN, uint32_t PLLP, uint32_t PLLQ);
+void RCC_PLLCmd(FunctionalState NewState);
+void RCC_SYSCLKConfig(uint32_t RCC_SYSCLKSource);
+uint8_t RCC_GetSYSCLKSource(void);
+void RCC_HCLKConfig(uint32_t RCC_SYSCLK);
+void RCC_PCLK1Config(uint32_t RCC_HCLK);
+void RCC_PCLK2Config(uint32_t RCC_HCLK);
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState);
+FlagStatus RCC_GetFlagStatus(uint8_t RCC_FLAG);
+
+/* stm32f4xx_pwr.h */
+#define PWR_Regulator_Voltage_Scale1 ((uint32_t)0x0000C000)
+#define PWR_Regulator_Voltage_Scale2 ((uint32_t)0x00008000)
+#define PWR_Regulator_Voltage_Scale3 ((uint32_t)0x00004000)
+
+#define PWR_FLAG_ODRDY ((uint32_t)0x00010000)
+#define PWR_FLAG_ODSWRDY ((uint32_t)0x00020000)
+
+void PWR_MainRegulatorModeConfig(uint32_t PWR_Regulator_Voltage);
+void PWR_OverDriveCmd(FunctionalState NewState);
+void PWR_OverDriveSWCmd(FunctionalState NewState);
+FlagStatus PWR_GetFlagStatus(uint32_t PWR_FLAG);
+
+/* stm32f4xx_flash.h */
+#define FLASH_Latency_0 ((uint8_t)0x0000)
+#define FLASH_Latency_1 ((uint8_t)0x0001)
+#define FLASH_Latency_2 ((uint8_t)0x0002)
+#define FLASH_Latency_3 ((uint8_t)0x0003)
+#define FLASH_Latency_4 ((uint8_t)0x0004)
+#define FLASH_Latency_5 ((uint8_t)0x0005)
+#define FLASH_Latency_6 ((uint8_t)0x0006)
+#define FLASH_Latency_7 ((uint8_t)0x0007)
+
+void FLASH_SetLatency(uint32_t FLASH_Latency);
+void FLASH_PrefetchBufferCmd(FunctionalState NewState);
+void FLASH_InstructionCacheCmd(FunctionalState NewState);
+void FLASH_DataCacheCmd(FunctionalState NewState);
+
+#endif /* __STM32F4xx_CONF_H */
@@ -0,0 +1,187 @@
+/**
+ * @file sim_adc.c
+ * @brief 仿真光敏电阻ADC(规则通道连续转换 + 模拟看门狗 + CIC抽取)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个节拍产生SIM_ADC_SAMPLES_PER_TICK个样本，每个样本在中断上下文中执行一次
+ *       与stm32f4xx_it.c中ADC_IRQHandler相同的处理: 看门狗越界先撤防再通知Task_Light，
+ *       然后送入CIC抽取滤波器
+ *       默认光照为 2048 ± 600 的正弦(40秒周期)叠加 ±16 的噪声，场景事件可固定为某个值
+ *       lightisr事件在ADC中断上下文中调用AppData_UpdateLightFromISR并读回，验证中断中的写者
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bsp_adc.h"
+#include "app_trace.h"
+#include "task_light.h"
+#include "app_data.h"
+#include "app_calib.h"
+#include "sim.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_ADC_WAVE_MID 2048.0
+#define SIM_ADC_WAVE_AMP 600.0
+#define SIM_ADC_WAVE_PERIOD_MS 40000.0
+#define SIM_ADC_NOISE 16U
+
+/* 出厂VREFINT标定值(sim_flash.c写入系统存储区)，VDDA=3.3V时读数与之相同 */
+#define SIM_ADC_VREFINT_RAW 1500U
+
+__IO uint16_t ADC_ConvertedValue;
+Filter_CIC_TypeDef ADC_LightCIC;
+
+static uint8_t s_ucRunning = 0;
+static uint8_t s_ucFixed = 0;
+static uint16_t s_usFixedRaw = 0;
+
+static uint8_t s_ucAwdArmed = 0;
+static uint16_t s_usAwdLow = 0;
+static uint16_t s_usAwdHigh = 0x0FFF;
+
+/* 当前样本(中断处理函数读取) */
+static uint16_t s_usSample = 0;
+
+static uint64_t s_ullSamples = 0;
+static uint32_t s_ulAwdFires = 0;
+
+/* lightisr事件要发布的值 */
+static uint16_t s_usIsrLight = 0;
+
+static uint16_t Sim_Adc_Model(uint32_t now_ms, uint32_t index)
+{
+    double v;
+
+    if (s_ucFixed)
+    {
+        v = s_usFixedRaw;
+    }
+    else
+    {
+        double t = now_ms + (double)index / SIM_ADC_SAMPLES_PER_TICK;
+        v = SIM_ADC_WAVE_MID + SIM_ADC_WAVE_AMP * sin(2.0 * M_PI * t / SIM_ADC_WAVE_PERIOD_MS);
+    }
+    v += (double)(Sim_Rand() % (2U * SIM_ADC_NOISE + 1U)) - SIM_ADC_NOISE;
+    if (v < 0.0)
+    {
+        v = 0.0;
+    }
+    if (v > 4095.0)
+    {
+        v = 4095.0;
+    }
+    return (uint16_t)v;
+}
+
+/**
+ * @brief ADC中断(同stm32f4xx_it.c的ADC_IRQHandler)
+ */
+static void Sim_Adc_IRQHandler(void)
+{
+    int32_t filtered;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+#if TASK_LIGHT_EVENT_MODE
+    if (s_ucAwdArmed && (s_usSample < s_usAwdLow || s_usSample > s_usAwdHigh))
+    {
+        AppTrace_IsrEnter();
+        s_ulAwdFires++;
+        PhotoResistor_AWD_Disarm();
+        Task_Light_AWDFromISR(&xHigherPriorityTaskWoken);
+        AppTrace_IsrExit();
+    }
+#endif
+
+    if (Filter_CIC_Update(&ADC_LightCIC, s_usSample, &filtered))
+    {
+        ADC_ConvertedValue = (uint16_t)filtered;
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief 中断中直接发布光照值并读回(lightisr事件)
+ */
+static void Sim_Adc_PublishIRQHandler(void)
+{
+    SensorData_TypeDef data;
+
+    AppData_UpdateLightFromISR(s_usIsrLight, AppCalib_LightToLux(s_usIsrLight),
+                               AppCalib_LightToPercent(s_usIsrLight), 1);
+    AppData_GetSensorData(&data);
+    printf("[sim] adc: isr publish %u, read back %lu (seq %lu)\n", (unsigned)s_usIsrLight,
+           (unsigned long)data.light_adc, (unsigned long)data.light_meta.seq);
+}
+
+void Sim_Adc_IsrPublish(const char *arg)
+{
+    s_usIsrLight = (uint16_t)strtoul(arg, NULL, 0);
+    vPortSimRunISR(ADC_IRQn, Sim_Adc_PublishIRQHandler);
+}
+
+void Sim_Adc_Event(const char *arg)
+{
+    if (strcmp(arg, "wave") == 0)
+    {
+        s_ucFixed = 0;
+    }
+    else
+    {
+        s_usFixedRaw = (uint16_t)strtoul(arg, NULL, 0);
+        s_ucFixed = 1;
+    }
+}
+
+void Sim_Adc_Tick(void)
+{
+    uint32_t now;
+
+    if (!s_ucRunning)
+    {
+        return;
+    }
+    now = Sim_NowMs();
+    for (uint32_t i = 0; i < SIM_ADC_SAMPLES_PER_TICK; i++)
+    {
+        s_usSample = Sim_Adc_Model(now, i);
+        s_ullSamples++;
+        vPortSimRunISR(ADC_IRQn, Sim_Adc_IRQHandler);
+    }
+}
+
+void PhotoResistor_Init(void)
+{
+    Filter_CIC_Init(&ADC_LightCIC, ADC_CIC_ORDER, ADC_CIC_DECIM);
+    s_ucRunning = 1;
+}
+
+void PhotoResistor_AWD_Arm(uint16_t low, uint16_t high)
+{
+    s_usAwdLow = low;
+    s_usAwdHigh = high;
+    s_ucAwdArmed = 1;
+}
+
+void PhotoResistor_AWD_Disarm(void)
+{
+    s_ucAwdArmed = 0;
+}
+
+uint16_t PhotoResistor_ReadVrefint(void)
+{
+    /* 注入转换约30us，查询等待 */
+    vPortSimConsume(30U * (SystemCoreClock / 1000000U));
+    return (uint16_t)(SIM_ADC_VREFINT_RAW + (Sim_Rand() % 5U) - 2U);
+}
+
+void Sim_Adc_Report(void)
+{
+    printf("[sim] adc: %llu samples, %lu watchdog events, last filtered %u\n",
+           (unsigned long long)s_ullSamples, (unsigned long)s_ulAwdFires, (unsigned)ADC_ConvertedValue);
+}
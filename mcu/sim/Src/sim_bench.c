@@ -0,0 +1,34 @@
+/**
+ * @file sim_bench.c
+ * @brief 内核函数基准的主机后端(替换app_bench_port.c)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 模拟时间只在忙等与空闲时推进，任务代码本身不耗时，DWT读数无法反映内核耗时；
+ *       这里改用主机单调时钟(纳秒，截为32位，差值在4.29秒内有效)
+ *       主机没有需要屏蔽的异步中断，不提供关中断窗口(K行irq=0)；
+ *       结果随主机负载变化，APP_BENCH构建的输出不再逐字节确定
+ */
+
+#include "app_bench.h"
+
+#include <stdio.h>
+#include <time.h>
+
+static uint32_t SimBench_Clock(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+void AppBench_Backend(Bench_Config_TypeDef *cfg)
+{
+    cfg->clock = SimBench_Clock;
+    cfg->print = printf;
+    cfg->mask = NULL;
+    cfg->unmask = NULL;
+    cfg->unit = "ns";
+    cfg->hz = 1000000000UL;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file sim_dht11.c
+ * @brief 仿真DHT11温湿度传感器
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 默认读数为缓慢变化的波形: 温度25±2℃(10分钟周期)，湿度55±5%(15分钟周期)
+ *       场景事件可固定读数或让传感器无响应
+ *       一次读取的忙等时间与目标驱动相同: 起始信号20ms + 30us，响应160us，
+ *       40位数据每位50us低电平 + 26/70us高电平(按平均约100us计)
+ */
+
+#include "bsp_dht11.h"
+#include "core_delay.h"
+#include "sim.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_DHT11_START_US 20030U
+#define SIM_DHT11_DATA_US (160U + 40U * 100U)
+
+typedef enum
+{
+    SIM_DHT11_WAVE = 0,
+    SIM_DHT11_FIXED,
+    SIM_DHT11_FAIL,
+} Sim_Dht11_Mode_t;
+
+static Sim_Dht11_Mode_t s_eMode = SIM_DHT11_WAVE;
+static uint16_t s_usFixedTemp10 = 250; /* 0.1℃ */
+static uint8_t s_ucFixedHumi = 55;
+static uint32_t s_ulReads = 0;
+static uint32_t s_ulFails = 0;
+
+void Sim_Dht11_Event(const char *arg)
+{
+    if (strcmp(arg, "fail") == 0)
+    {
+        s_eMode = SIM_DHT11_FAIL;
+    }
+    else if (strcmp(arg, "wave") == 0)
+    {
+        s_eMode = SIM_DHT11_WAVE;
+    }
+    else
+    {
+        const char *comma = strchr(arg, ',');
+
+        s_usFixedTemp10 = (uint16_t)(strtod(arg, NULL) * 10.0 + 0.5);
+        if (comma != NULL)
+        {
+            s_ucFixedHumi = (uint8_t)strtoul(comma + 1, NULL, 10);
+        }
+        s_eMode = SIM_DHT11_FIXED;
+    }
+}
+
+void DHT11_GPIO_Config(void)
+{
+}
+
+uint8_t Read_DHT11(DHT11_Data_TypeDef *DHT11_Data)
+{
+    double t = Sim_NowMs() / 1000.0;
+    uint16_t temp10;
+    uint8_t humi;
+
+    s_ulReads++;
+    CPU_TS_Tmr_Delay_US(SIM_DHT11_START_US);
+    if (s_eMode == SIM_DHT11_FAIL)
+    {
+        /* 从机没有拉低总线，驱动立即返回 */
+        s_ulFails++;
+        return 0;
+    }
+    CPU_TS_Tmr_Delay_US(SIM_DHT11_DATA_US);
+
+    if (s_eMode == SIM_DHT11_FIXED)
+    {
+        temp10 = s_usFixedTemp10;
+        humi = s_ucFixedHumi;
+    }
+    else
+    {
+        temp10 = (uint16_t)lround(250.0 + 20.0 * sin(2.0 * M_PI * t / 600.0));
+        humi = (uint8_t)lround(55.0 + 5.0 * sin(2.0 * M_PI * t / 900.0));
+    }
+
+    DHT11_Data->humi_int = humi;
+    DHT11_Data->humi_deci = 0;
+    DHT11_Data->temp_int = (uint8_t)(temp10 / 10U);
+    DHT11_Data->temp_deci = (uint8_t)(temp10 % 10U);
+    DHT11_Data->check_sum = (uint8_t)(DHT11_Data->humi_int + DHT11_Data->humi_deci +
+                                      DHT11_Data->temp_int + DHT11_Data->temp_deci);
+    return 1;
+}
+
+void Sim_Dht11_Report(void)
+{
+    printf("[sim] dht11: %lu reads, %lu no-response\n", (unsigned long)s_ulReads, (unsigned long)s_ulFails);
+}
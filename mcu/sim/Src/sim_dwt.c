@@ -0,0 +1,78 @@
+/**
+ * @file sim_dwt.c
+ * @brief 仿真DWT周期计数器与忙等延时
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note CYCCNT = 模拟时间 + 偏移: CPU_TS_TmrInit清零、CPU_TS_Advance补齐都只修改偏移，
+ *       与目标板一样32位回绕；64位时间戳直接取模拟时间，不需要回绕检测
+ *       频率段换算与目标板(core_delay.c)相同
+ */
+
+#include "FreeRTOS.h"
+#include "core_delay.h"
+
+/* CYCCNT相对模拟时间的偏移 */
+static uint64_t s_ullOffset = 0;
+
+/* 当前频率段起点的时间戳、对应的微秒数与频率，以及上一段的频率 */
+static uint64_t s_ullSegTs = 0;
+static uint64_t s_ullSegUs = 0;
+static uint32_t s_ulSegHz = 0;
+static uint32_t s_ulPrevHz = 0;
+
+static uint64_t CPU_TS_CyclesToUs(uint64_t cycles, uint32_t hz)
+{
+    return cycles / hz * 1000000U + (cycles % hz) * 1000000U / hz;
+}
+
+void CPU_TS_TmrInit(void)
+{
+    s_ullOffset = (uint64_t)0 - ullPortSimCycles();
+    s_ullSegTs = 0;
+    s_ullSegUs = 0;
+    s_ulSegHz = SystemCoreClock;
+    s_ulPrevHz = SystemCoreClock;
+}
+
+uint32_t CPU_TS_TmrRd(void)
+{
+    return (uint32_t)(ullPortSimCycles() + s_ullOffset);
+}
+
+uint64_t CPU_TS_Read64(void)
+{
+    return ullPortSimCycles() + s_ullOffset;
+}
+
+void CPU_TS_Advance(uint32_t cycles)
+{
+    s_ullOffset += cycles;
+}
+
+void CPU_TS_ClockChanged(uint32_t hz)
+{
+    uint64_t now = CPU_TS_Read64();
+
+    s_ullSegUs += CPU_TS_CyclesToUs(now - s_ullSegTs, s_ulSegHz);
+    s_ullSegTs = now;
+    s_ulPrevHz = s_ulSegHz;
+    s_ulSegHz = hz;
+}
+
+uint64_t CPU_TS_ToUs(uint64_t ts)
+{
+    uint64_t back;
+
+    if (ts >= s_ullSegTs)
+    {
+        return s_ullSegUs + CPU_TS_CyclesToUs(ts - s_ullSegTs, s_ulSegHz);
+    }
+    back = CPU_TS_CyclesToUs(s_ullSegTs - ts, s_ulPrevHz);
+    return (back < s_ullSegUs) ? (s_ullSegUs - back) : 0U;
+}
+
+void CPU_TS_Tmr_Delay_US(__IO uint32_t us)
+{
+    vPortSimConsume(us * (GET_CPU_ClkFreq() / 1000000U));
+}
@@ -0,0 +1,199 @@
+/**
+ * @file sim_flash.c
+ * @brief 仿真片内Flash与系统存储区
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 1MB主机内存固定映射到0x08000000，应用层(app_calib/app_log)按地址直接读取；
+ *       另在0x1FFF7000映射一页系统存储区，放入出厂VREFINT标定值
+ *       给出-f FILE时Flash与文件共享映射，日志与标定数据跨运行保留(新文件按擦除状态0xFF初始化)
+ *       编程只能把1写成0(按位与)；擦除/编程期间CPU取指被阻塞，这里屏蔽中断后忙等:
+ *       16KB扇区约250ms，64KB约550ms，128KB约1s，每字约16us(数据手册典型值，x32并行度)
+ */
+
+#include "bsp_flash.h"
+#include "sim.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SIM_SYSMEM_PAGE 0x1FFF7000UL
+#define SIM_SYSMEM_SIZE 0x1000UL
+#define SIM_VREFINT_CAL_ADDR 0x1FFF7A2AUL
+#define SIM_VREFINT_CAL 1500U
+
+#define SIM_FLASH_ERASE16_US 250000U
+#define SIM_FLASH_ERASE64_US 550000U
+#define SIM_FLASH_ERASE128_US 1000000U
+#define SIM_FLASH_WORD_US 16U
+
+static uint32_t s_ulErases = 0;
+static uint32_t s_ulWords = 0;
+static uint32_t s_ulOverwrites = 0;
+
+/**
+ * @brief 屏蔽中断忙等(期间到期的节拍只挂起一次，与目标板相同)
+ */
+static void Sim_Flash_Stall(uint32_t us)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    vPortSimConsume(us * (SystemCoreClock / 1000000U));
+    __set_PRIMASK(primask);
+}
+
+static void *Sim_Flash_Map(uintptr_t addr, size_t size, int fd)
+{
+    void *p = mmap((void *)addr, size, PROT_READ | PROT_WRITE,
+                   MAP_FIXED_NOREPLACE | ((fd >= 0) ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS)),
+                   fd, 0);
+
+    if (p == MAP_FAILED || p != (void *)addr)
+    {
+        fprintf(stderr, "[sim] cannot map 0x%08lx\n", (unsigned long)addr);
+        exit(1);
+    }
+    return p;
+}
+
+void Sim_Flash_Open(const char *path)
+{
+    uint8_t *flash;
+    uint8_t *sysmem;
+    uint16_t cal = SIM_VREFINT_CAL;
+    int fd = -1;
+    int fresh = 1;
+
+    if (path != NULL)
+    {
+        struct stat st;
+
+        fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0 || fstat(fd, &st) != 0)
+        {
+            perror(path);
+            exit(1);
+        }
+        fresh = (st.st_size != (off_t)BSP_FLASH_SIZE);
+        if (fresh && ftruncate(fd, BSP_FLASH_SIZE) != 0)
+        {
+            perror(path);
+            exit(1);
+        }
+    }
+
+    flash = Sim_Flash_Map(BSP_FLASH_BASE, BSP_FLASH_SIZE, fd);
+    if (fresh)
+    {
+        memset(flash, 0xFF, BSP_FLASH_SIZE);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    sysmem = Sim_Flash_Map(SIM_SYSMEM_PAGE, SIM_SYSMEM_SIZE, -1);
+    memset(sysmem, 0xFF, SIM_SYSMEM_SIZE);
+    memcpy(sysmem + (SIM_VREFINT_CAL_ADDR - SIM_SYSMEM_PAGE), &cal, sizeof(cal));
+}
+
+int BSP_Flash_GetSector(uint32_t addr, uint32_t *base, uint32_t *size)
+{
+    uint32_t offset;
+    uint32_t sec_base;
+    uint32_t sec_size;
+    int sector;
+
+    if (addr < BSP_FLASH_BASE || addr >= BSP_FLASH_BASE + BSP_FLASH_SIZE)
+    {
+        return -1;
+    }
+
+    offset = addr - BSP_FLASH_BASE;
+    if (offset < 0x10000UL)
+    {
+        /* 扇区0~3: 16KB */
+        sector = (int)(offset >> 14);
+        sec_base = BSP_FLASH_BASE + ((uint32_t)sector << 14);
+        sec_size = 0x4000UL;
+    }
+    else if (offset < 0x20000UL)
+    {
+        /* 扇区4: 64KB */
+        sector = 4;
+        sec_base = BSP_FLASH_BASE + 0x10000UL;
+        sec_size = 0x10000UL;
+    }
+    else
+    {
+        /* 扇区5~11: 128KB */
+        sector = 5 + (int)((offset - 0x20000UL) >> 17);
+        sec_base = BSP_FLASH_BASE + 0x20000UL + ((uint32_t)(sector - 5) << 17);
+        sec_size = 0x20000UL;
+    }
+
+    if (base != NULL)
+    {
+        *base = sec_base;
+    }
+    if (size != NULL)
+    {
+        *size = sec_size;
+    }
+    return sector;
+}
+
+int BSP_Flash_EraseSector(uint32_t addr)
+{
+    uint32_t base;
+    uint32_t size;
+
+    if (BSP_Flash_GetSector(addr, &base, &size) < 0)
+    {
+        return -1;
+    }
+
+    Sim_Flash_Stall((size == 0x4000UL)    ? SIM_FLASH_ERASE16_US
+                    : (size == 0x10000UL) ? SIM_FLASH_ERASE64_US
+                                          : SIM_FLASH_ERASE128_US);
+    memset((void *)(uintptr_t)base, 0xFF, size);
+    s_ulErases++;
+    return 0;
+}
+
+int BSP_Flash_Program(uint32_t addr, const uint32_t *words, uint32_t count)
+{
+    if ((addr & 3U) != 0 || words == NULL ||
+        BSP_Flash_GetSector(addr, NULL, NULL) < 0 ||
+        BSP_Flash_GetSector(addr + count * 4U - 1U, NULL, NULL) < 0)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t *dst = (uint32_t *)(uintptr_t)(addr + i * 4U);
+
+        Sim_Flash_Stall(SIM_FLASH_WORD_US);
+        if ((~*dst & words[i]) != 0)
+        {
+            /* 0不能编程为1 */
+            s_ulOverwrites++;
+        }
+        *dst &= words[i];
+        s_ulWords++;
+    }
+    return 0;
+}
+
+void Sim_Flash_Report(void)
+{
+    printf("[sim] flash: %lu sector erases, %lu words programmed, %lu over-programmed\n",
+           (unsigned long)s_ulErases, (unsigned long)s_ulWords, (unsigned long)s_ulOverwrites);
+}
@@ -0,0 +1,229 @@
+/**
+ * @file sim_heap.c
+ * @brief 仿真堆压力测试(--heap-stress)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 应用正常运行的同时，SIM_HEAP_TASKS个不同优先级的任务随机分配/释放heap_4中的块:
+ *       - 一半经pvPortMalloc(调用者为本文件中的任务函数)，一半经AppHeap_MallocFrom
+ *         登记各任务自己的标记地址(与newlib_heap.c中malloc包装的做法相同)
+ *       - 每次操作后随机让出或延时1~3个节拍，各任务的分配与释放相互交错
+ *       - 块内容按(任务, 槽, 字节)填充，释放前检查，块重叠或被改写即断言
+ *       - 分配前保留SIM_HEAP_MARGIN字节空闲，不触发分配失败钩子(会停机)
+ *       仿真时长过半后各任务释放全部块，最后一个结束的任务核对堆监视的调用者表:
+ *       每个标记地址的分配/释放次数与本任务的计数一致、当前字节数归零、没有失败
+ *       核对失败记为断言(退出码2)，结束报告输出各任务的计数
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_heap.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * ============================================================================
+ * 配置参数
+ * ============================================================================
+ */
+#define SIM_HEAP_TASKS 3         /**< 压力任务数(优先级1~3) */
+#define SIM_HEAP_SLOTS 6         /**< 每个任务最多持有的块数 */
+#define SIM_HEAP_MAX_SIZE 256U   /**< 最大请求大小(字节) */
+#define SIM_HEAP_MARGIN 1024U    /**< 分配前保留的空闲量(字节) */
+#define SIM_HEAP_STACK (configMINIMAL_STACK_SIZE * 2)
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+typedef struct
+{
+    uint8_t *ptr[SIM_HEAP_SLOTS];    /**< 持有的块 */
+    uint16_t size[SIM_HEAP_SLOTS];   /**< 请求大小 */
+    uint8_t tagged[SIM_HEAP_SLOTS];  /**< 经AppHeap_MallocFrom分配 */
+    uint32_t allocs;                 /**< 分配次数 */
+    uint32_t tagged_allocs;          /**< 其中经AppHeap_MallocFrom的次数 */
+    uint32_t tagged_frees;           /**< 经AppHeap_MallocFrom分配的块的释放次数 */
+    uint32_t frees;                  /**< 释放次数 */
+    uint32_t skipped;                /**< 空闲不足而跳过的分配 */
+    uint32_t corrupt;                /**< 释放前检查失败的块 */
+} SimHeap_State_TypeDef;
+
+static SimHeap_State_TypeDef s_xState[SIM_HEAP_TASKS];
+
+/* 各任务登记的调用者标记(只取地址) */
+static uint8_t s_ucTag[SIM_HEAP_TASKS];
+
+static StackType_t s_xStack[SIM_HEAP_TASKS][SIM_HEAP_STACK];
+static StaticTask_t s_xTcb[SIM_HEAP_TASKS];
+
+static uint32_t s_ulDone = 0;
+static uint8_t s_ucVerified = 0;
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static uint8_t SimHeap_Pattern(uint32_t id, uint32_t slot, uint32_t k)
+{
+    return (uint8_t)(id * 64U + slot * 7U + k);
+}
+
+static void SimHeap_Alloc(SimHeap_State_TypeDef *st, uint32_t id, uint32_t slot)
+{
+    uint32_t size = 1U + Sim_Rand() % SIM_HEAP_MAX_SIZE;
+    uint8_t tagged = (uint8_t)(Sim_Rand() & 1U);
+    uint8_t *p;
+
+    if (xPortGetFreeHeapSize() < size + SIM_HEAP_MARGIN)
+    {
+        st->skipped++;
+        return;
+    }
+
+    p = tagged ? (uint8_t *)AppHeap_MallocFrom(size, &s_ucTag[id]) : (uint8_t *)pvPortMalloc(size);
+    if (p == NULL)
+    {
+        st->skipped++;
+        return;
+    }
+    for (uint32_t k = 0; k < size; k++)
+    {
+        p[k] = SimHeap_Pattern(id, slot, k);
+    }
+
+    st->ptr[slot] = p;
+    st->size[slot] = (uint16_t)size;
+    st->tagged[slot] = tagged;
+    st->allocs++;
+    st->tagged_allocs += tagged;
+}
+
+static void SimHeap_Free(SimHeap_State_TypeDef *st, uint32_t id, uint32_t slot)
+{
+    uint8_t *p = st->ptr[slot];
+
+    for (uint32_t k = 0; k < st->size[slot]; k++)
+    {
+        if (p[k] != SimHeap_Pattern(id, slot, k))
+        {
+            st->corrupt++;
+            Sim_AssertFailed(__FILE__, __LINE__);
+            break;
+        }
+    }
+
+    vPortFree(p);
+    st->ptr[slot] = NULL;
+    st->frees++;
+    st->tagged_frees += st->tagged[slot];
+}
+
+/**
+ * @brief 核对堆监视的调用者表(全部任务结束后)
+ */
+static void SimHeap_Verify(void)
+{
+    HeapStat_Caller_TypeDef c;
+
+    for (uint32_t id = 0; id < SIM_HEAP_TASKS; id++)
+    {
+        const SimHeap_State_TypeDef *st = &s_xState[id];
+
+        if (st->tagged_allocs == 0)
+        {
+            continue;
+        }
+        if (AppHeap_GetCaller(&s_ucTag[id], &c) != 0 || c.allocs != st->tagged_allocs ||
+            c.frees != st->tagged_frees || c.cur_bytes != 0 || c.fails != 0)
+        {
+            Sim_Log("heap stress: task %lu caller table mismatch", (unsigned long)id);
+            Sim_AssertFailed(__FILE__, __LINE__);
+        }
+    }
+    s_ucVerified = 1;
+}
+
+static void SimHeap_Task(void *pvParameters)
+{
+    uint32_t id = (uint32_t)(uintptr_t)pvParameters;
+    SimHeap_State_TypeDef *st = &s_xState[id];
+    uint32_t stop = g_xSimConfig.time_ms / 2U;
+    uint32_t slot;
+
+    while (Sim_NowMs() < stop)
+    {
+        slot = Sim_Rand() % SIM_HEAP_SLOTS;
+        if (st->ptr[slot] != NULL)
+        {
+            SimHeap_Free(st, id, slot);
+        }
+        else
+        {
+            SimHeap_Alloc(st, id, slot);
+        }
+
+        if ((Sim_Rand() & 3U) != 0)
+        {
+            taskYIELD();
+        }
+        else
+        {
+            vTaskDelay(1U + Sim_Rand() % 3U);
+        }
+    }
+
+    for (slot = 0; slot < SIM_HEAP_SLOTS; slot++)
+    {
+        if (st->ptr[slot] != NULL)
+        {
+            SimHeap_Free(st, id, slot);
+        }
+    }
+
+    if (++s_ulDone == SIM_HEAP_TASKS)
+    {
+        SimHeap_Verify();
+    }
+    vTaskDelete(NULL);
+}
+
+/**
+ * ============================================================================
+ * 仿真层接口
+ * ============================================================================
+ */
+
+void Sim_Heap_Start(void)
+{
+    static const char *const names[SIM_HEAP_TASKS] = {"Sim_Heap1", "Sim_Heap2", "Sim_Heap3"};
+
+    /* heap_4在首次分配时才初始化，此前xPortGetFreeHeapSize为0 */
+    vPortFree(pvPortMalloc(1));
+
+    for (uint32_t id = 0; id < SIM_HEAP_TASKS; id++)
+    {
+        (void)xTaskCreateStatic(SimHeap_Task, names[id], SIM_HEAP_STACK,
+                                (void *)(uintptr_t)id, tskIDLE_PRIORITY + 1U + id,
+                                s_xStack[id], &s_xTcb[id]);
+    }
+}
+
+void Sim_Heap_Report(void)
+{
+    for (uint32_t id = 0; id < SIM_HEAP_TASKS; id++)
+    {
+        const SimHeap_State_TypeDef *st = &s_xState[id];
+
+        printf("[sim] heap stress %lu: %lu allocs (%lu tagged), %lu frees, %lu skipped, %lu corrupt\n",
+               (unsigned long)id, (unsigned long)st->allocs, (unsigned long)st->tagged_allocs,
+               (unsigned long)st->frees, (unsigned long)st->skipped, (unsigned long)st->corrupt);
+    }
+    printf("[sim] heap stress: caller table %s\n", s_ucVerified ? "verified" : "not verified (run shorter than 2x stop)");
+}
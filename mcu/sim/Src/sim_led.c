@@ -0,0 +1,51 @@
+/**
+ * @file sim_led.c
+ * @brief 仿真RGB LED
+ * @author Yukikaze
+ * @date 2026-10-19
+ */
+
+#include "bsp_led.h"
+#include "sim.h"
+
+#include <stdio.h>
+
+static const char *const s_pcLedName[3] = {"red", "green", "blue"};
+static uint8_t s_ucLedOn[3];
+static uint32_t s_ulLedEdges[3];
+
+void LED_GPIO_Config(void)
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        s_ucLedOn[i] = 0;
+    }
+}
+
+void Sim_Led_Write(uint8_t led, uint8_t on)
+{
+    if (led >= 3 || s_ucLedOn[led] == on)
+    {
+        return;
+    }
+    s_ucLedOn[led] = on;
+    s_ulLedEdges[led]++;
+    if (g_xSimConfig.verbose)
+    {
+        Sim_Log("led %s %s", s_pcLedName[led], on ? "on" : "off");
+    }
+}
+
+void Sim_Led_Toggle(uint8_t led)
+{
+    if (led < 3)
+    {
+        Sim_Led_Write(led, (uint8_t)!s_ucLedOn[led]);
+    }
+}
+
+void Sim_Led_Report(void)
+{
+    printf("[sim] led: red %lu, green %lu, blue %lu changes\n",
+           (unsigned long)s_ulLedEdges[0], (unsigned long)s_ulLedEdges[1], (unsigned long)s_ulLedEdges[2]);
+}
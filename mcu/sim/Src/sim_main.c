@@ -0,0 +1,343 @@
+/**
+ * @file sim_main.c
+ * @brief 主机仿真入口: 命令行参数、场景事件与结束报告
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note main.c按原样编译，其main被重命名为App_Main(见project/sim/CMakeLists.txt)；
+ *       这里解析参数后直接调用App_Main，调度器启动后不再返回
+ *       到达仿真时长时由节拍钩子结束进程，退出码: 0=正常, 2=发生断言, 3=挂死
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sim.h"
+
+#include <getopt.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern int App_Main(void);
+
+/**
+ * ============================================================================
+ * 私有变量
+ * ============================================================================
+ */
+
+Sim_Config_TypeDef g_xSimConfig = {
+    .time_ms = SIM_DEFAULT_TIME_MS,
+    .seed = SIM_DEFAULT_SEED,
+    .flash = NULL,
+    .oled = 0,
+    .verbose = 0,
+};
+
+static Sim_Event_TypeDef s_xEvents[SIM_MAX_EVENTS];
+static uint32_t s_ulEventCount = 0;
+static uint32_t s_ulEventNext = 0;
+
+/* 模拟时间换算: 最近一次调频时的周期数、对应的微秒数与此后的频率(0=尚未调频) */
+static uint64_t s_ullBaseCycles = 0;
+static uint64_t s_ullBaseUs = 0;
+static uint32_t s_ulBaseHz = 0;
+
+static uint32_t s_ulRand = SIM_DEFAULT_SEED;
+static uint32_t s_ulAsserts = 0;
+
+static const struct option s_xOptions[] = {
+    {"time", required_argument, NULL, 't'},
+    {"seed", required_argument, NULL, 's'},
+    {"flash", required_argument, NULL, 'f'},
+    {"event", required_argument, NULL, 'e'},
+    {"oled", no_argument, NULL, 'o'},
+    {"verbose", no_argument, NULL, 'v'},
+    {"stall", required_argument, NULL, 'S'},
+    {"no-hse", no_argument, NULL, 'H'},
+    {"no-tickless", no_argument, NULL, 'N'},
+    {"heap-stress", no_argument, NULL, 'M'},
+    {"help", no_argument, NULL, 'h'},
+    {NULL, 0, NULL, 0},
+};
+
+/**
+ * ============================================================================
+ * 私有函数
+ * ============================================================================
+ */
+
+static void Sim_Usage(const char *prog)
+{
+    printf("usage: %s [options]\n"
+           "  -t, --time MS          simulated run time (default %u)\n"
+           "  -s, --seed N           noise seed (default %u)\n"
+           "  -f, --flash FILE       persist the 1MB flash image in FILE\n"
+           "  -e, --event MS:K=V     scenario event, repeatable:\n"
+           "                           light=N | light=wave\n"
+           "                           temp=T,H | temp=fail | temp=wave\n"
+           "                           uart=TEXT (\\n and \\r escapes)\n"
+           "                           lightisr=N (publish N from the ADC interrupt)\n"
+           "  -o, --oled             print the OLED text grid when it changes\n"
+           "  -v, --verbose          log LED changes and scenario events\n"
+           "      --stall S          exit if no tick for S host seconds (0=off)\n"
+           "      --no-hse           HSE never starts (clock falls back to HSI)\n"
+           "      --no-tickless      wake on every tick instead of tickless idle\n"
+           "      --heap-stress      run random alloc/free tasks beside the application\n",
+           prog, SIM_DEFAULT_TIME_MS, SIM_DEFAULT_SEED);
+}
+
+/**
+ * @brief 解析"MS:KEY=VALUE"并按时间插入事件表(同一时刻保持命令行顺序)
+ */
+static int Sim_AddEvent(const char *spec)
+{
+    Sim_Event_TypeDef ev;
+    char *end;
+    const char *eq;
+    size_t klen;
+    uint32_t i;
+
+    if (s_ulEventCount >= SIM_MAX_EVENTS)
+    {
+        return -1;
+    }
+
+    ev.ms = (uint32_t)strtoul(spec, &end, 10);
+    if (end == spec || *end != ':')
+    {
+        return -1;
+    }
+    spec = end + 1;
+    eq = strchr(spec, '=');
+    if (eq == NULL)
+    {
+        return -1;
+    }
+    klen = (size_t)(eq - spec);
+    if (klen == 5 && strncmp(spec, "light", 5) == 0)
+    {
+        ev.type = SIM_EVENT_LIGHT;
+    }
+    else if (klen == 4 && strncmp(spec, "temp", 4) == 0)
+    {
+        ev.type = SIM_EVENT_TEMP;
+    }
+    else if (klen == 4 && strncmp(spec, "uart", 4) == 0)
+    {
+        ev.type = SIM_EVENT_UART;
+    }
+    else if (klen == 8 && strncmp(spec, "lightisr", 8) == 0)
+    {
+        ev.type = SIM_EVENT_LIGHT_ISR;
+    }
+    else
+    {
+        return -1;
+    }
+    snprintf(ev.arg, sizeof(ev.arg), "%s", eq + 1);
+
+    i = s_ulEventCount++;
+    while (i > 0 && s_xEvents[i - 1].ms > ev.ms)
+    {
+        s_xEvents[i] = s_xEvents[i - 1];
+        i--;
+    }
+    s_xEvents[i] = ev;
+    return 0;
+}
+
+static void Sim_RunEvents(uint32_t now)
+{
+    while (s_ulEventNext < s_ulEventCount && s_xEvents[s_ulEventNext].ms <= now)
+    {
+        const Sim_Event_TypeDef *ev = &s_xEvents[s_ulEventNext++];
+
+        if (g_xSimConfig.verbose)
+        {
+            static const char *const names[] = {"light", "temp", "uart", "lightisr"};
+            Sim_Log("event %s=%s", names[ev->type], ev->arg);
+        }
+        switch (ev->type)
+        {
+        case SIM_EVENT_LIGHT:
+            Sim_Adc_Event(ev->arg);
+            break;
+        case SIM_EVENT_TEMP:
+            Sim_Dht11_Event(ev->arg);
+            break;
+        case SIM_EVENT_UART:
+            Sim_Usart_Event(ev->arg);
+            break;
+        case SIM_EVENT_LIGHT_ISR:
+            Sim_Adc_IsrPublish(ev->arg);
+            break;
+        }
+    }
+}
+
+static void Sim_Report(void)
+{
+    fflush(stdout);
+    printf("[sim] ---- summary @ %lu ms ----\n", (unsigned long)Sim_NowMs());
+    printf("[sim] core: %lu Hz, %llu cycles, %llu ticks (%llu suppressed), %llu irqs, %llu switches\n",
+           (unsigned long)SystemCoreClock,
+           (unsigned long long)ullPortSimCycles(),
+           (unsigned long long)ullPortSimTicks(),
+           (unsigned long long)ullPortSimSuppressedTicks(),
+           (unsigned long long)ullPortSimIrqs(),
+           (unsigned long long)ullPortSimSwitches());
+    Sim_Led_Report();
+    Sim_Dht11_Report();
+    Sim_Adc_Report();
+    Sim_Usart_Report();
+    Sim_Oled_Report();
+    Sim_Flash_Report();
+    Sim_Power_Report();
+    if (g_xSimConfig.heap_stress)
+    {
+        Sim_Heap_Report();
+    }
+    printf("[sim] asserts: %lu\n", (unsigned long)s_ulAsserts);
+    fflush(stdout);
+}
+
+/**
+ * ============================================================================
+ * 仿真层接口
+ * ============================================================================
+ */
+
+static uint64_t Sim_NowUs(void)
+{
+    uint64_t cycles = ullPortSimCycles() - s_ullBaseCycles;
+    uint32_t hz = (s_ulBaseHz != 0) ? s_ulBaseHz : SystemCoreClock;
+
+    return s_ullBaseUs + cycles / hz * 1000000U + (cycles % hz) * 1000000U / hz;
+}
+
+uint32_t Sim_NowMs(void)
+{
+    return (uint32_t)(Sim_NowUs() / 1000U);
+}
+
+void Sim_ClockChanged(uint32_t old_hz, uint32_t new_hz)
+{
+    if (s_ulBaseHz == 0)
+    {
+        s_ulBaseHz = old_hz;
+    }
+    s_ullBaseUs = Sim_NowUs();
+    s_ullBaseCycles = ullPortSimCycles();
+    s_ulBaseHz = new_hz;
+}
+
+uint32_t Sim_Rand(void)
+{
+    s_ulRand = s_ulRand * 1664525U + 1013904223U;
+    return s_ulRand >> 8;
+}
+
+void Sim_Log(const char *fmt, ...)
+{
+    uint32_t now = Sim_NowMs();
+    va_list ap;
+
+    printf("[sim %5lu.%03lu] ", (unsigned long)(now / 1000U), (unsigned long)(now % 1000U));
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+}
+
+void Sim_AssertFailed(const char *file, int line)
+{
+    s_ulAsserts++;
+    Sim_Log("assert %s:%d", file, line);
+}
+
+/**
+ * @brief 仿真节拍钩子(中断上下文，内核节拍处理之前)
+ *
+ * @note 依次执行到期的场景事件与各设备的节拍处理，到达仿真时长时结束进程
+ */
+void vApplicationSimTickHook(void)
+{
+    uint32_t now = Sim_NowMs();
+
+    if (now >= g_xSimConfig.time_ms)
+    {
+        exit((s_ulAsserts != 0) ? 2 : 0);
+    }
+
+    Sim_RunEvents(now);
+    Sim_Adc_Tick();
+    Sim_Usart_Tick();
+    Sim_Oled_Tick();
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "t:s:f:e:ovh", s_xOptions, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+            g_xSimConfig.time_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            g_xSimConfig.seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            g_xSimConfig.flash = optarg;
+            break;
+        case 'e':
+            if (Sim_AddEvent(optarg) != 0)
+            {
+                fprintf(stderr, "bad event '%s'\n", optarg);
+                return 1;
+            }
+            break;
+        case 'o':
+            g_xSimConfig.oled = 1;
+            break;
+        case 'v':
+            g_xSimConfig.verbose = 1;
+            break;
+        case 'S':
+            vPortSimSetStallTimeout((uint32_t)strtoul(optarg, NULL, 0));
+            break;
+        case 'H':
+            g_xSimConfig.no_hse = 1;
+            break;
+        case 'N':
+            g_xSimConfig.no_tickless = 1;
+            break;
+        case 'M':
+            g_xSimConfig.heap_stress = 1;
+            break;
+        case 'h':
+            Sim_Usage(argv[0]);
+            return 0;
+        default:
+            Sim_Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    /* 输出按行刷新，与仿真层日志保持顺序(管道中同样如此) */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    s_ulRand = g_xSimConfig.seed;
+
+    Sim_Flash_Open(g_xSimConfig.flash);
+    atexit(Sim_Report);
+    if (g_xSimConfig.heap_stress)
+    {
+        Sim_Heap_Start();
+    }
+
+    return App_Main();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file sim_oled.c
+ * @brief 仿真OLED(SSD1306, 硬件I2C)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 屏幕按6x8字符单元保存为8行x21列的文本；8x16字符占上下两行
+ *       时间按目标驱动的批量传输计算(400kHz): 每次传输的起始+地址+控制字节+停止约50us，
+ *       其后每字节22.5us；传输的划分与bsp_oled.c相同(初始化1次34字节，光标1次3字节，
+ *       填充每页命令3字节+数据128字节，字符串按同一行的连续段)，驱动在传输期间查询标志忙等
+ *       -o参数下，画面变化后静止SIM_OLED_SETTLE_MS输出一次
+ */
+
+#include "FreeRTOS.h"
+#include "bsp_oled.h"
+#include "bsp_iic.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SIM_OLED_XACT_NS 50000U  /**< 每次传输的固定开销(起始+地址+控制字节+停止) */
+#define SIM_OLED_BYTE_NS 22500U  /**< 每字节(8位+应答) */
+#define SIM_OLED_ROWS 8U
+#define SIM_OLED_COLS 21U
+#define SIM_OLED_SETTLE_MS 20U
+
+static char s_cText[SIM_OLED_ROWS][SIM_OLED_COLS + 1];
+static uint8_t s_ucOn = 0;
+static uint8_t s_ucDirty = 0;
+static uint32_t s_ulLastWriteMs = 0;
+static uint64_t s_ullXacts = 0;
+static uint64_t s_ullBytes = 0;
+static uint32_t s_ulFrames = 0;
+
+static uint64_t Sim_Oled_BusyNs(uint64_t xacts, uint64_t bytes)
+{
+    return xacts * SIM_OLED_XACT_NS + bytes * SIM_OLED_BYTE_NS;
+}
+
+/**
+ * @brief 按传输次数与字节数忙等
+ */
+static void Sim_Oled_Xfer(uint32_t xacts, uint32_t bytes)
+{
+    s_ullXacts += xacts;
+    s_ullBytes += bytes;
+    vPortSimConsume((uint32_t)(Sim_Oled_BusyNs(xacts, bytes) * (SystemCoreClock / 1000000U) / 1000U));
+    s_ulLastWriteMs = Sim_NowMs();
+    s_ucDirty = 1;
+}
+
+static void Sim_Oled_Put(uint32_t row, uint32_t col, char c)
+{
+    if (row < SIM_OLED_ROWS && col < SIM_OLED_COLS)
+    {
+        s_cText[row][col] = c;
+    }
+}
+
+void IIC_GPIO_Config(void)
+{
+}
+
+void IIC_ClockUpdate(void)
+{
+}
+
+void IIC_ClockSync(void)
+{
+}
+
+void OLED_Init(void)
+{
+    /* 初始化命令序列共34字节，一次传输 */
+    memset(s_cText, ' ', sizeof(s_cText));
+    for (uint32_t r = 0; r < SIM_OLED_ROWS; r++)
+    {
+        s_cText[r][SIM_OLED_COLS] = '\0';
+    }
+    s_ucOn = 1;
+    Sim_Oled_Xfer(1U, 34U);
+}
+
+void OLED_SetPos(unsigned char x, unsigned char y)
+{
+    (void)x;
+    (void)y;
+    Sim_Oled_Xfer(1U, 3U);
+}
+
+void OLED_Fill(unsigned char fill_data)
+{
+    char c = (fill_data == 0x00) ? ' ' : '#';
+
+    for (uint32_t r = 0; r < SIM_OLED_ROWS; r++)
+    {
+        memset(s_cText[r], c, SIM_OLED_COLS);
+    }
+    Sim_Oled_Xfer(8U * 2U, 8U * (3U + 128U));
+}
+
+void OLED_CLS(void)
+{
+    OLED_Fill(0x00);
+}
+
+void OLED_ON(void)
+{
+    s_ucOn = 1;
+    Sim_Oled_Xfer(3U, 3U);
+}
+
+void OLED_OFF(void)
+{
+    s_ucOn = 0;
+    Sim_Oled_Xfer(3U, 3U);
+}
+
+void OLED_ShowStr(unsigned char x, unsigned char y, unsigned char ch[], unsigned char textsize)
+{
+    uint32_t j = 0;
+    uint32_t xacts = 0;
+    uint32_t bytes = 0;
+
+    /* 同一行的连续字符为一段: 光标(1次3字节) + 数据(1次)，
+     * 下一个字符会越过第127列时另起一段(见bsp_oled.c) */
+    switch (textsize)
+    {
+    case 1:
+        while (ch[j] != '\0')
+        {
+            if (x > 126)
+            {
+                x = 0;
+                y++;
+            }
+            xacts += 2U;
+            bytes += 3U;
+            do
+            {
+                Sim_Oled_Put(y, x / 6U, (char)ch[j]);
+                bytes += 6U;
+                x += 6;
+                j++;
+            } while (ch[j] != '\0' && x <= 126 && (x | 0x01) + 6 <= 128);
+        }
+        break;
+    case 2:
+        while (ch[j] != '\0')
+        {
+            if (x > 120)
+            {
+                x = 0;
+                y++;
+            }
+            xacts += 4U;
+            bytes += 2U * 3U;
+            do
+            {
+                Sim_Oled_Put(y, x / 6U, (char)ch[j]);
+                Sim_Oled_Put(y + 1U, x / 6U, (char)ch[j]);
+                bytes += 2U * 8U;
+                x += 8;
+                j++;
+            } while (ch[j] != '\0' && x <= 120 && (x | 0x01) + 8 <= 128);
+        }
+        break;
+    }
+    Sim_Oled_Xfer(xacts, bytes);
+}
+
+void Sim_Oled_Tick(void)
+{
+    if (!g_xSimConfig.oled || !s_ucDirty || Sim_NowMs() - s_ulLastWriteMs < SIM_OLED_SETTLE_MS)
+    {
+        return;
+    }
+    s_ucDirty = 0;
+    s_ulFrames++;
+    Sim_Log("oled%s", s_ucOn ? "" : " (off)");
+    printf("+---------------------+\n");
+    for (uint32_t r = 0; r < SIM_OLED_ROWS; r++)
+    {
+        printf("|%s|\n", s_cText[r]);
+    }
+    printf("+---------------------+\n");
+}
+
+void Sim_Oled_Report(void)
+{
+    printf("[sim] oled: %llu i2c transfers, %llu bytes (%llu ms busy)",
+           (unsigned long long)s_ullXacts,
+           (unsigned long long)s_ullBytes,
+           (unsigned long long)(Sim_Oled_BusyNs(s_ullXacts, s_ullBytes) / 1000000U));
+    if (g_xSimConfig.oled)
+    {
+        printf(", %lu frames printed", (unsigned long)s_ulFrames);
+    }
+    printf("\n");
+}
@@ -0,0 +1,193 @@
+/**
+ * @file sim_periph.c
+ * @brief 仿真时钟树与NVIC配置(bsp_clock.c与main.c中BSP_Init使用的库函数)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 记录RCC配置并按参考手册的公式计算SystemCoreClock，模拟时间以它为内核频率:
+ *       PLL输出 = 输入 / M * N / P，HCLK = SYSCLK / AHB分频
+ *       振荡器、PLL与过驱动立即就绪(--no-hse时HSE不起振)，Flash等待周期与缓存设置不模拟
+ *       频率变化时通知仿真层更新模拟时间的换算(Sim_ClockChanged)
+ */
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+#include "sim.h"
+
+#define SIM_HSI_VALUE HSI_VALUE
+#define SIM_HSE_VALUE HSE_VALUE
+
+/* 复位后运行在HSI */
+uint32_t SystemCoreClock = SIM_HSI_VALUE;
+
+static uint32_t s_ulPllSource = RCC_PLLSource_HSI;
+static uint32_t s_ulPllM = 16;
+static uint32_t s_ulPllN = 192;
+static uint32_t s_ulPllP = 2;
+static uint32_t s_ulSysclkSource = RCC_SYSCLKSource_HSI;
+static uint32_t s_ulAhbDiv = RCC_SYSCLK_Div1;
+static uint8_t s_ucHseOn = 0;
+static uint8_t s_ucPllOn = 0;
+static uint8_t s_ucOdOn = 0;
+static uint8_t s_ucOdSwOn = 0;
+
+/* AHB分频编码(HPRE[7:4]) -> 右移位数，与system_stm32f4xx.c的AHBPrescTable相同 */
+static const uint8_t s_ucAhbShift[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
+
+void SystemCoreClockUpdate(void)
+{
+    uint32_t sysclk;
+
+    switch (s_ulSysclkSource)
+    {
+    case RCC_SYSCLKSource_HSE:
+        sysclk = SIM_HSE_VALUE;
+        break;
+    case RCC_SYSCLKSource_PLLCLK:
+        sysclk = ((s_ulPllSource == RCC_PLLSource_HSE) ? SIM_HSE_VALUE : SIM_HSI_VALUE) /
+                 s_ulPllM * s_ulPllN / s_ulPllP;
+        break;
+    default:
+        sysclk = SIM_HSI_VALUE;
+        break;
+    }
+    sysclk >>= s_ucAhbShift[(s_ulAhbDiv >> 4) & 0x0FU];
+    if (sysclk != SystemCoreClock)
+    {
+        Sim_ClockChanged(SystemCoreClock, sysclk);
+        SystemCoreClock = sysclk;
+    }
+}
+
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup)
+{
+    (void)NVIC_PriorityGroup;
+}
+
+void RCC_DeInit(void)
+{
+    s_ulSysclkSource = RCC_SYSCLKSource_HSI;
+    s_ulAhbDiv = RCC_SYSCLK_Div1;
+    s_ucHseOn = 0;
+    s_ucPllOn = 0;
+}
+
+void RCC_HSEConfig(uint8_t RCC_HSE)
+{
+    s_ucHseOn = (RCC_HSE != RCC_HSE_OFF && !g_xSimConfig.no_hse) ? 1U : 0U;
+}
+
+ErrorStatus RCC_WaitForHSEStartUp(void)
+{
+    return s_ucHseOn ? SUCCESS : ERROR;
+}
+
+void RCC_PLLConfig(uint32_t RCC_PLLSource, uint32_t PLLM, uint32_t PLLN, uint32_t PLLP, uint32_t PLLQ)
+{
+    (void)PLLQ;
+    s_ulPllSource = RCC_PLLSource;
+    s_ulPllM = PLLM;
+    s_ulPllN = PLLN;
+    s_ulPllP = PLLP;
+}
+
+void RCC_PLLCmd(FunctionalState NewState)
+{
+    /* 以HSE为输入时HSE须已起振 */
+    s_ucPllOn = (NewState != DISABLE && (s_ulPllSource != RCC_PLLSource_HSE || s_ucHseOn)) ? 1U : 0U;
+}
+
+void RCC_SYSCLKConfig(uint32_t RCC_SYSCLKSource)
+{
+    s_ulSysclkSource = RCC_SYSCLKSource;
+}
+
+uint8_t RCC_GetSYSCLKSource(void)
+{
+    /* SWS位段(RCC_CFGR[3:2]) */
+    return (uint8_t)(s_ulSysclkSource << 2);
+}
+
+void RCC_HCLKConfig(uint32_t RCC_SYSCLK)
+{
+    s_ulAhbDiv = RCC_SYSCLK;
+}
+
+void RCC_PCLK1Config(uint32_t RCC_HCLK)
+{
+    (void)RCC_HCLK;
+}
+
+void RCC_PCLK2Config(uint32_t RCC_HCLK)
+{
+    (void)RCC_HCLK;
+}
+
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState)
+{
+    (void)RCC_APB1Periph;
+    (void)NewState;
+}
+
+FlagStatus RCC_GetFlagStatus(uint8_t RCC_FLAG)
+{
+    switch (RCC_FLAG)
+    {
+    case RCC_FLAG_HSIRDY:
+        return SET;
+    case RCC_FLAG_HSERDY:
+        return s_ucHseOn ? SET : RESET;
+    case RCC_FLAG_PLLRDY:
+        return s_ucPllOn ? SET : RESET;
+    default:
+        return RESET;
+    }
+}
+
+void PWR_MainRegulatorModeConfig(uint32_t PWR_Regulator_Voltage)
+{
+    (void)PWR_Regulator_Voltage;
+}
+
+void PWR_OverDriveCmd(FunctionalState NewState)
+{
+    s_ucOdOn = (NewState != DISABLE) ? 1U : 0U;
+}
+
+void PWR_OverDriveSWCmd(FunctionalState NewState)
+{
+    s_ucOdSwOn = (NewState != DISABLE && s_ucOdOn) ? 1U : 0U;
+}
+
+FlagStatus PWR_GetFlagStatus(uint32_t PWR_FLAG)
+{
+    switch (PWR_FLAG)
+    {
+    case PWR_FLAG_ODRDY:
+        return s_ucOdOn ? SET : RESET;
+    case PWR_FLAG_ODSWRDY:
+        return s_ucOdSwOn ? SET : RESET;
+    default:
+        return RESET;
+    }
+}
+
+void FLASH_SetLatency(uint32_t FLASH_Latency)
+{
+    (void)FLASH_Latency;
+}
+
+void FLASH_PrefetchBufferCmd(FunctionalState NewState)
+{
+    (void)NewState;
+}
+
+void FLASH_InstructionCacheCmd(FunctionalState NewState)
+{
+    (void)NewState;
+}
+
+void FLASH_DataCacheCmd(FunctionalState NewState)
+{
+    (void)NewState;
+}
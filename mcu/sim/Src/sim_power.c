@@ -0,0 +1,173 @@
+/**
+ * @file sim_power.c
+ * @brief 仿真低功耗管理(替换app_power.c)
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 无节拍空闲沿用app_power.c的策略，只有SLEEP路径(仿真没有RTC与STOP):
+ *       - 预计空闲时长受软件定时器限制(AppTimer_NextDelay)，由Tickless_Select选择模式
+ *       - 单次休眠不超过24位SysTick重装值对应的节拍数(180MHz下93个)
+ *       - 休眠期间外设中断照常执行，没有任务就绪则继续睡眠，结束后vTaskStepTick补齐
+ *         (traceINCREASE_TICK_COUNT同样补齐时间轮)
+ *       SysTick/RTC寄存器级的重装值与补偿计算留在目标板，由libx/tickless的主机测试覆盖
+ *       --no-tickless时空闲钩子每次推进到下一个节拍(每个节拍都唤醒)，用于前后对比
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_power.h"
+#include "app_timer.h"
+#include "tickless.h"
+#include "sim.h"
+
+#include <stdio.h>
+
+static AppPower_Stats_TypeDef s_xStats;
+static volatile uint32_t s_ulStopLock = 0;
+
+/* SLEEP路径的最大节拍数与模式选择参数(min_stop为0，不使用STOP) */
+static uint32_t s_ulMaxSleepTicks = 1;
+static Tickless_Config_TypeDef s_xCfg;
+
+/* 空闲钩子已执行而本轮尚未休眠: 下一次空闲钩子推进到下一个节拍 */
+static uint8_t s_ucIdlePending = 0;
+
+/* 本次无节拍空闲中上一个节拍边界时的外设中断数 */
+static uint64_t s_ullIrqMark = 0;
+
+/* 休眠总时长(微秒，调频前后按各自频率累计) */
+static uint64_t s_ullSleepUs = 0;
+
+/**
+ * @brief 记入一次休眠的时长
+ */
+static void SimPower_Account(uint32_t cycles)
+{
+    s_xStats.sleep_cycles += cycles;
+    s_ullSleepUs += (uint64_t)cycles * 1000000U / SystemCoreClock;
+}
+
+/**
+ * @brief 休眠期间是否有任务被中断唤醒
+ *
+ * @note 每个节拍边界都会调用；该边界执行的每个外设中断在目标板上都是一次WFI唤醒，
+ *       按中断数计入wakes(没有中断的边界不计)，任务就绪判断放在计数之后
+ */
+static BaseType_t SimPower_Abort(void)
+{
+    uint64_t irqs = ullPortSimIrqs();
+
+    if (irqs == s_ullIrqMark)
+    {
+        return pdFALSE;
+    }
+    s_xStats.wakes += (uint32_t)(irqs - s_ullIrqMark);
+    s_ullIrqMark = irqs;
+    return (eTaskConfirmSleepModeStatus() == eAbortSleep) ? pdTRUE : pdFALSE;
+}
+
+void AppPower_Init(void)
+{
+    s_xCfg.tick_hz = configTICK_RATE_HZ;
+    AppPower_ClockUpdate();
+}
+
+void AppPower_ClockUpdate(void)
+{
+    vPortSimClockUpdate();
+    s_ulMaxSleepTicks = 0xFFFFFFUL / (SystemCoreClock / configTICK_RATE_HZ);
+}
+
+int AppPower_InitStop(void)
+{
+    /* 没有RTC与STOP模式 */
+    return -1;
+}
+
+void AppPower_SuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    TickType_t xIdle;
+    uint64_t cycles;
+    uint32_t ticks;
+
+    if (g_xSimConfig.no_tickless)
+    {
+        return;
+    }
+    s_ucIdlePending = 0;
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        s_xStats.aborts++;
+        return;
+    }
+
+    xIdle = AppTimer_NextDelay(xExpectedIdleTime);
+    if (Tickless_Select(&s_xCfg, xIdle, 0) != TICKLESS_SLEEP)
+    {
+        s_ucIdlePending = 1;
+        return;
+    }
+    if (xIdle > s_ulMaxSleepTicks)
+    {
+        xIdle = s_ulMaxSleepTicks;
+    }
+
+    cycles = ullPortSimCycles();
+    s_ullIrqMark = ullPortSimIrqs();
+    ticks = ulPortSimSuppressTicks(xIdle, SimPower_Abort);
+    SimPower_Account((uint32_t)(ullPortSimCycles() - cycles));
+    s_xStats.sleeps++;
+    vTaskStepTick(ticks);
+}
+
+void AppPower_StopLock(void)
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    s_ulStopLock++;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+void AppPower_StopUnlock(void)
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    if (s_ulStopLock != 0)
+    {
+        s_ulStopLock--;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+void AppPower_GetStats(AppPower_Stats_TypeDef *out)
+{
+    taskENTER_CRITICAL();
+    *out = s_xStats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 空闲钩子(空闲任务每轮先于无节拍空闲调用)
+ *
+ * @note 上一轮没有进入无节拍空闲(预计空闲不足2个节拍)时休眠到下一个节拍，
+ *       否则交给本轮的AppPower_SuppressTicksAndSleep，避免每次空闲都先被节拍唤醒一次
+ */
+void vApplicationIdleHook(void)
+{
+    if (s_ucIdlePending != 0 || g_xSimConfig.no_tickless)
+    {
+        SimPower_Account(ulPortSimIdle());
+        s_xStats.sleeps++;
+    }
+    s_ucIdlePending = 1;
+}
+
+void Sim_Power_Report(void)
+{
+    uint64_t total = (uint64_t)Sim_NowMs() * 1000U;
+
+    printf("[sim] power: %lu sleeps, %lu wakes, %lu aborts, %llu.%llu%% of time asleep\n",
+           (unsigned long)s_xStats.sleeps,
+           (unsigned long)s_xStats.wakes,
+           (unsigned long)s_xStats.aborts,
+           (unsigned long long)((total != 0) ? s_ullSleepUs * 100U / total : 0U),
+           (unsigned long long)((total != 0) ? (s_ullSleepUs * 1000U / total) % 10U : 0U));
+}
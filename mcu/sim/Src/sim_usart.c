@@ -0,0 +1,110 @@
+/**
+ * @file sim_usart.c
+ * @brief 仿真调试串口
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 发送: printf直接写进程标准输出，不计入模拟时间(目标板上115200波特率约87us/字符)
+ *       接收: 场景事件(uart=TEXT)写入接收队列，每个节拍按115200波特率最多送出
+ *       SIM_USART_CHARS_PER_TICK个字符，每个字符执行一次与USARTx_IRQHandler相同的处理
+ *       未使能接收中断(USARTx_RxIT_Config之前)收到的字符丢弃
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bsp_usart.h"
+#include "task_prof.h"
+#include "sim.h"
+
+#include <string.h>
+
+#define SIM_USART_CHARS_PER_TICK 11U /* 115200 / 10位 / 1000Hz */
+#define SIM_USART_QUEUE_SIZE 256U
+
+static uint8_t s_ucQueue[SIM_USART_QUEUE_SIZE];
+static uint32_t s_ulHead = 0;
+static uint32_t s_ulTail = 0;
+static uint8_t s_ucRxEnabled = 0;
+static uint8_t s_ucRxChar = 0;
+
+static uint32_t s_ulRxChars = 0;
+static uint32_t s_ulDropped = 0;
+
+/**
+ * @brief 接收中断(同stm32f4xx_it.c的USARTx_IRQHandler)
+ */
+static void Sim_Usart_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    Task_Prof_CommandFromISR(s_ucRxChar, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void Sim_Usart_Push(uint8_t c)
+{
+    if (s_ulHead - s_ulTail >= SIM_USART_QUEUE_SIZE)
+    {
+        s_ulDropped++;
+        return;
+    }
+    s_ucQueue[s_ulHead++ % SIM_USART_QUEUE_SIZE] = c;
+}
+
+void Sim_Usart_Event(const char *arg)
+{
+    for (const char *p = arg; *p != '\0'; p++)
+    {
+        if (p[0] == '\\' && p[1] == 'n')
+        {
+            Sim_Usart_Push('\n');
+            p++;
+        }
+        else if (p[0] == '\\' && p[1] == 'r')
+        {
+            Sim_Usart_Push('\r');
+            p++;
+        }
+        else
+        {
+            Sim_Usart_Push((uint8_t)*p);
+        }
+    }
+}
+
+void Sim_Usart_Tick(void)
+{
+    for (uint32_t i = 0; i < SIM_USART_CHARS_PER_TICK && s_ulTail != s_ulHead; i++)
+    {
+        s_ucRxChar = s_ucQueue[s_ulTail++ % SIM_USART_QUEUE_SIZE];
+        if (!s_ucRxEnabled)
+        {
+            s_ulDropped++;
+            continue;
+        }
+        s_ulRxChars++;
+        vPortSimRunISR(USART1_IRQn, Sim_Usart_IRQHandler);
+    }
+}
+
+void USARTx_Config(void)
+{
+}
+
+void USARTx_RxIT_Config(void)
+{
+    s_ucRxEnabled = 1;
+}
+
+void USARTx_WaitIdle(void)
+{
+}
+
+void USARTx_ClockUpdate(void)
+{
+}
+
+void Sim_Usart_Report(void)
+{
+    printf("[sim] usart: %lu chars received, %lu dropped\n", (unsigned long)s_ulRxChars, (unsigned long)s_ulDropped);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file sim_test.h
+ * @brief 主机单元测试的断言、随机数与计时
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个测试是一个独立程序(mcu/sim/Test/test_<名称>.c)，只链接被测的libx/应用源文件，
+ *       由project/sim/CMakeLists.txt的sim_add_test登记到ctest；
+ *       断言失败时输出位置并继续，TEST_RUN逐个执行用例，Test_Exit返回进程退出码
+ *       性能数据以"[bench] <名称>: ..."行输出，只作参考，不参与判定
+ */
+
+#ifndef __SIM_TEST_H
+#define __SIM_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * ============================================================================
+ * 私有变量(每个测试程序一份)
+ * ============================================================================
+ */
+static uint32_t s_ulTestFails = 0;
+static uint32_t s_ulTestChecks = 0;
+static uint32_t s_ulTestRand = 1U;
+
+/**
+ * ============================================================================
+ * 断言
+ * ============================================================================
+ */
+
+/**
+ * @brief 条件不成立时记录失败并继续
+ */
+#define TEST_CHECK(cond)                                                            \
+    do                                                                              \
+    {                                                                               \
+        s_ulTestChecks++;                                                           \
+        if (!(cond))                                                                \
+        {                                                                           \
+            s_ulTestFails++;                                                        \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+        }                                                                           \
+    } while (0)
+
+/**
+ * @brief 整数相等，失败时输出两边的值
+ */
+#define TEST_EQ(a, b)                                                               \
+    do                                                                              \
+    {                                                                               \
+        long long test_a_ = (long long)(a);                                         \
+        long long test_b_ = (long long)(b);                                         \
+        s_ulTestChecks++;                                                           \
+        if (test_a_ != test_b_)                                                     \
+        {                                                                           \
+            s_ulTestFails++;                                                        \
+            printf("%s:%d: %s == %s failed: %lld != %lld\n", __FILE__, __LINE__,    \
+                   #a, #b, test_a_, test_b_);                                       \
+        }                                                                           \
+    } while (0)
+
+/**
+ * @brief 执行一个用例并输出结果
+ */
+#define TEST_RUN(fn)                                                                \
+    do                                                                              \
+    {                                                                               \
+        uint32_t test_before_ = s_ulTestFails;                                      \
+        fn();                                                                       \
+        printf("%s %s\n", (s_ulTestFails == test_before_) ? "[pass]" : "[FAIL]", #fn); \
+    } while (0)
+
+/**
+ * ============================================================================
+ * 辅助函数
+ * ============================================================================
+ */
+
+/**
+ * @brief 确定性伪随机数(xorshift32，同样的种子得到同样的序列)
+ */
+static inline void Test_Seed(uint32_t seed)
+{
+    s_ulTestRand = (seed != 0U) ? seed : 1U;
+}
+
+static inline uint32_t Test_Rand(void)
+{
+    uint32_t x = s_ulTestRand;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_ulTestRand = x;
+    return x;
+}
+
+/**
+ * @brief [0, n)内的随机数
+ */
+static inline uint32_t Test_RandBelow(uint32_t n)
+{
+    return (n != 0U) ? (uint32_t)(((uint64_t)Test_Rand() * n) >> 32) : 0U;
+}
+
+/**
+ * @brief 主机单调时钟(纳秒)
+ */
+static inline uint64_t Test_NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 输出汇总，返回进程退出码(0=全部通过)
+ */
+static inline int Test_Exit(const char *name)
+{
+    printf("%s: %lu checks, %lu failed\n", name,
+           (unsigned long)s_ulTestChecks, (unsigned long)s_ulTestFails);
+    return (s_ulTestFails == 0U) ? 0 : 1;
+}
+
+#endif /* __SIM_TEST_H */
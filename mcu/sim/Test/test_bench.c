@@ -0,0 +1,305 @@
+/**
+ * @file test_bench.c
+ * @brief libx/bench主机测试: 开销扣除、预热、中位数、样本数上限、关中断窗口与K行输出
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 计时函数为可控的假时钟: 每次读取前进TEST_READ_COST，被测内核按设定的量推进，
+ *       每个样本的计数因此是已知的，可以逐项核对Bench_Measure的统计
+ */
+
+#include "sim_test.h"
+#include "bench.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#define TEST_READ_COST 5U   /**< 每次读取计时的开销(计数) */
+#define TEST_WARMUP_COST 1000000U
+
+static uint32_t s_ulClock;
+static uint32_t s_ulRunCalls;
+static uint32_t s_ulSetupCalls;
+static uint32_t s_ulMaskDepth;
+static uint32_t s_ulMaskCalls;
+static uint32_t s_ulMaskedRuns;
+
+/* 各样本的内核耗时(预热之后按顺序取) */
+static const uint32_t *s_pulCost;
+static uint32_t s_ulCostLen;
+static uint32_t s_ulWarmup;
+
+static char s_cOut[4096];
+static size_t s_ulOutLen;
+
+static uint32_t Test_Clock(void)
+{
+    uint32_t t = s_ulClock;
+
+    s_ulClock += TEST_READ_COST;
+    return t;
+}
+
+static uint32_t Test_Mask(void)
+{
+    s_ulMaskDepth++;
+    s_ulMaskCalls++;
+    return 0xA5U;
+}
+
+static void Test_Unmask(uint32_t state)
+{
+    TEST_EQ(state, 0xA5U);
+    s_ulMaskDepth--;
+}
+
+static int Test_Print(const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(s_cOut + s_ulOutLen, sizeof(s_cOut) - s_ulOutLen, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+    {
+        s_ulOutLen += (size_t)n;
+    }
+    return n;
+}
+
+static void Test_Reset(uint32_t clock, const uint32_t *cost, uint32_t len, uint32_t warmup)
+{
+    s_ulClock = clock;
+    s_ulRunCalls = 0;
+    s_ulSetupCalls = 0;
+    s_ulMaskDepth = 0;
+    s_ulMaskCalls = 0;
+    s_ulMaskedRuns = 0;
+    s_pulCost = cost;
+    s_ulCostLen = len;
+    s_ulWarmup = warmup;
+    s_ulOutLen = 0;
+    s_cOut[0] = '\0';
+}
+
+/**
+ * @brief 被测内核: 预热样本耗时极大(必须被丢弃)，之后按表推进
+ */
+static void Test_Run(void *arg)
+{
+    uint32_t idx = s_ulRunCalls++;
+
+    (void)arg;
+    if (s_ulMaskDepth != 0)
+    {
+        s_ulMaskedRuns++;
+    }
+    if (idx < s_ulWarmup)
+    {
+        s_ulClock += TEST_WARMUP_COST;
+    }
+    else if (s_pulCost != NULL)
+    {
+        s_ulClock += s_pulCost[(idx - s_ulWarmup) % s_ulCostLen];
+    }
+}
+
+/**
+ * @brief 固定耗时的内核(每次调用7个计数)
+ */
+static void Test_Fixed(void *arg)
+{
+    (void)arg;
+    s_ulRunCalls++;
+    s_ulClock += 7U;
+}
+
+static void Test_Setup(void *arg)
+{
+    (void)arg;
+    s_ulSetupCalls++;
+    /* 准备工作不计时 */
+    s_ulClock += 12345U;
+}
+
+/**
+ * @brief 开销扣除: 每个样本两次读取的开销被扣除，多次调用合计
+ */
+static void Test_Overhead(void)
+{
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock, .warmup = 2, .repeat = 9};
+    Bench_Case_TypeDef bc = BENCH_CASE("fixed", Test_Setup, Test_Fixed, NULL, 16U);
+    Bench_Result_TypeDef res;
+
+    Test_Reset(0, NULL, 0, 0);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(res.overhead, TEST_READ_COST);
+    TEST_EQ(res.min, 16U * 7U);
+    TEST_EQ(res.median, 16U * 7U);
+    TEST_EQ(res.max, 16U * 7U);
+    /* 预热 + 测量，每个样本调用calls次；setup每个样本一次(开销样本不调用) */
+    TEST_EQ(s_ulRunCalls, (2U + 9U) * 16U);
+    TEST_EQ(s_ulSetupCalls, 2U + 9U);
+
+    /* 计时器回绕不影响差值 */
+    Test_Reset(0xFFFFFF00UL, NULL, 0, 0);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(res.min, 16U * 7U);
+    TEST_EQ(res.max, 16U * 7U);
+}
+
+/**
+ * @brief 中位数与最小/最大值，预热样本不计入
+ */
+static void Test_Median(void)
+{
+    uint32_t cost[BENCH_REPEAT];
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock};
+    Bench_Case_TypeDef bc = BENCH_CASE("median", NULL, Test_Run, NULL, 1U);
+    Bench_Result_TypeDef res;
+
+    /* 10..310的乱序排列(31与17互质) */
+    for (uint32_t i = 0; i < BENCH_REPEAT; i++)
+    {
+        cost[i] = ((i * 17U) % BENCH_REPEAT + 1U) * 10U;
+    }
+
+    Test_Reset(0, cost, BENCH_REPEAT, BENCH_WARMUP);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulRunCalls, BENCH_WARMUP + BENCH_REPEAT);
+    TEST_EQ(res.min, 10U);
+    TEST_EQ(res.median, (BENCH_REPEAT / 2U + 1U) * 10U);
+    TEST_EQ(res.max, BENCH_REPEAT * 10U);
+
+    /* 偶数个样本取上中位(下标n/2) */
+    cfg.warmup = 1;
+    cfg.repeat = 4;
+    {
+        static const uint32_t c4[4] = {40U, 10U, 30U, 20U};
+
+        Test_Reset(0, c4, 4, 1);
+        TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+        TEST_EQ(res.min, 10U);
+        TEST_EQ(res.median, 30U);
+        TEST_EQ(res.max, 40U);
+    }
+
+    /* 内核比空函数还快时结果为0而不是回绕 */
+    {
+        static const uint32_t zero[1] = {0U};
+
+        Test_Reset(0, zero, 1, 1);
+        TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+        TEST_EQ(res.min, 0U);
+        TEST_EQ(res.max, 0U);
+    }
+}
+
+/**
+ * @brief 样本数上限与默认值
+ */
+static void Test_RepeatClamp(void)
+{
+    static const uint32_t cost[1] = {3U};
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock, .warmup = 3, .repeat = 1000};
+    Bench_Case_TypeDef bc = BENCH_CASE("clamp", Test_Setup, Test_Run, NULL, 1U);
+    Bench_Result_TypeDef res;
+
+    Test_Reset(0, cost, 1, 3);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulRunCalls, 3U + BENCH_MAX_REPEAT);
+    TEST_EQ(s_ulSetupCalls, 3U + BENCH_MAX_REPEAT);
+    TEST_EQ(res.max, 3U);
+
+    cfg.repeat = BENCH_MAX_REPEAT;
+    Test_Reset(0, cost, 1, 3);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulRunCalls, 3U + BENCH_MAX_REPEAT);
+
+    /* 0取默认值 */
+    cfg.warmup = 0;
+    cfg.repeat = 0;
+    Test_Reset(0, cost, 1, BENCH_WARMUP);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulRunCalls, BENCH_WARMUP + BENCH_REPEAT);
+}
+
+/**
+ * @brief 关中断窗口: 开销样本与测量样本都在窗口内，后端不支持时忽略标志
+ */
+static void Test_IrqOff(void)
+{
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock, .mask = Test_Mask, .unmask = Test_Unmask,
+                                .warmup = 2, .repeat = 5};
+    Bench_Case_TypeDef bc = BENCH_CASE_IRQ_OFF("irq", NULL, Test_Run, NULL, 2U);
+    Bench_Case_TypeDef on = BENCH_CASE("on", NULL, Test_Run, NULL, 2U);
+    Bench_Result_TypeDef res;
+
+    Test_Reset(0, NULL, 0, 0);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulMaskDepth, 0);
+    /* 开销样本(预热+测量)与内核样本(预热+测量)各一次，内核总在窗口内执行 */
+    TEST_EQ(s_ulMaskCalls, 2U * (2U + 5U));
+    TEST_EQ(s_ulMaskedRuns, s_ulRunCalls);
+
+    Test_Reset(0, NULL, 0, 0);
+    TEST_EQ(Bench_Measure(&cfg, &on, &res), 0);
+    TEST_EQ(s_ulMaskCalls, 0);
+    TEST_EQ(s_ulMaskedRuns, 0);
+
+    cfg.mask = NULL;
+    Test_Reset(0, NULL, 0, 0);
+    TEST_EQ(Bench_Measure(&cfg, &bc, &res), 0);
+    TEST_EQ(s_ulMaskCalls, 0);
+}
+
+static void Test_Invalid(void)
+{
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock};
+    Bench_Case_TypeDef bc = BENCH_CASE("x", NULL, Test_Fixed, NULL, 1U);
+    Bench_Case_TypeDef zero = BENCH_CASE("x", NULL, Test_Fixed, NULL, 0U);
+    Bench_Case_TypeDef norun = BENCH_CASE("x", NULL, NULL, NULL, 1U);
+    Bench_Config_TypeDef noclock = {0};
+    Bench_Result_TypeDef res;
+
+    TEST_EQ(Bench_Measure(NULL, &bc, &res), -1);
+    TEST_EQ(Bench_Measure(&noclock, &bc, &res), -1);
+    TEST_EQ(Bench_Measure(&cfg, NULL, &res), -1);
+    TEST_EQ(Bench_Measure(&cfg, &zero, &res), -1);
+    TEST_EQ(Bench_Measure(&cfg, &norun, &res), -1);
+    TEST_EQ(Bench_Measure(&cfg, &bc, NULL), -1);
+}
+
+/**
+ * @brief K行输出: 表头一行，每个用例一行，无效用例跳过但保留下标
+ */
+static void Test_RunOutput(void)
+{
+    static const Bench_Case_TypeDef cases[] = {
+        BENCH_CASE_IRQ_OFF("fixed", NULL, Test_Fixed, NULL, 4U),
+        BENCH_CASE("bad", NULL, NULL, NULL, 1U),
+        BENCH_CASE("fixed1", NULL, Test_Fixed, NULL, 1U),
+    };
+    Bench_Config_TypeDef cfg = {.clock = Test_Clock, .print = Test_Print, .mask = Test_Mask,
+                                .unmask = Test_Unmask, .unit = "cyc", .hz = 168000000UL,
+                                .warmup = 1, .repeat = 3};
+
+    Test_Reset(0, NULL, 0, 0);
+    Bench_Run(&cfg, cases, 3U);
+    TEST_CHECK(strcmp(s_cOut,
+                      "K,-,cyc,168000000,1,3,3\r\n"
+                      "K,0,fixed,4,28,28,28,5,1\r\n"
+                      "K,2,fixed1,1,7,7,7,5,0\r\n") == 0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Overhead);
+    TEST_RUN(Test_Median);
+    TEST_RUN(Test_RepeatClamp);
+    TEST_RUN(Test_IrqOff);
+    TEST_RUN(Test_Invalid);
+    TEST_RUN(Test_RunOutput);
+    return Test_Exit("test_bench");
+}
@@ -0,0 +1,607 @@
+/**
+ * @file test_filter.c
+ * @brief libx/filter主机测试: 与独立参考模型逐位对比，固定参考向量的CRC，单次更新耗时
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 参考模型按各滤波器的定义用int64直接计算，不调用filter.c的任何函数:
+ *       - SMLAD/QADD16/QSUB16: ARM架构手册的定义(乘加32位回绕，半字饱和)
+ *       - 滑动平均: 保存全部历史，窗口和四舍五入后右移
+ *       - IIR: (a*x + (32768-a)*y + 16384) >> 15
+ *       - 中值: 窗口复制后排序取中间
+ *       - CIC: M级长度为R的滑动和级联后每R个样本取一个(等价于积分-梳状结构，不涉及回绕)，
+ *         长序列运行验证32位积分器的回绕确实在梳状器中抵消
+ *       Reset后的下一个样本在模型中按首个样本处理(填满窗口/直接输出)
+ *       参考向量(Test_Golden)与app_bench.c中目标板的自检使用同一输入与CRC，
+ *       目标板走__SMLAD/__QADD16/__QSUB16，主机走纯C实现，CRC相同即两者逐位一致
+ */
+
+#include "sim_test.h"
+#include "filter.h"
+#include "crc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SAMPLES 100000U
+#define TEST_CIC_SAMPLES 400000U
+#define TEST_GOLDEN_LEN 1024U
+#define TEST_GOLDEN_RESET 256U /**< 参考向量中每256个样本复位一次中值与IIR */
+
+/* 参考向量的CRC-32(与app_bench.c的APP_BENCH_VEC_*一致) */
+#define TEST_GOLDEN_MA8 0x60B198F1UL
+#define TEST_GOLDEN_MA2X8 0x4911B030UL
+#define TEST_GOLDEN_IIR 0x875B97C2UL
+#define TEST_GOLDEN_MEDIAN5 0x73E4BE81UL
+#define TEST_GOLDEN_CIC3R8 0x2088A8D4UL
+
+/* 饱和与回绕的边界值 */
+static const int16_t s_sEdge[] = {
+    0, 1, -1, 2, -2, 127, -128, 255, 16383, -16384, 16384, 32766, -32767, 32767, -32768};
+#define TEST_EDGE_NUM (sizeof(s_sEdge) / sizeof(s_sEdge[0]))
+
+/* 参考模型的历史样本 */
+static int16_t s_sHist[TEST_CIC_SAMPLES];
+
+/**
+ * ============================================================================
+ * 参考模型
+ * ============================================================================
+ */
+
+static int32_t Ref_Sat16(int64_t v)
+{
+    return (v > 32767) ? 32767 : (v < -32768) ? -32768 : (int32_t)v;
+}
+
+static uint32_t Ref_SMLAD(uint32_t a, uint32_t b, uint32_t acc)
+{
+    int64_t v = (int64_t)(int16_t)(a & 0xFFFFU) * (int16_t)(b & 0xFFFFU) +
+                (int64_t)(int16_t)(a >> 16) * (int16_t)(b >> 16) + (int64_t)acc;
+
+    return (uint32_t)((uint64_t)v & 0xFFFFFFFFULL);
+}
+
+static uint32_t Ref_Q16(uint32_t a, uint32_t b, int sub)
+{
+    int64_t lo = (int64_t)(int16_t)(a & 0xFFFFU);
+    int64_t hi = (int64_t)(int16_t)(a >> 16);
+    int64_t blo = (int64_t)(int16_t)(b & 0xFFFFU);
+    int64_t bhi = (int64_t)(int16_t)(b >> 16);
+
+    lo = Ref_Sat16(sub ? lo - blo : lo + blo);
+    hi = Ref_Sat16(sub ? hi - bhi : hi + bhi);
+    return ((uint32_t)lo & 0xFFFFU) | (((uint32_t)hi & 0xFFFFU) << 16);
+}
+
+/**
+ * @brief 以首个样本(或复位后的第一个样本)填充的窗口中第n个样本
+ *
+ * @param hist 历史样本
+ * @param start 首个样本的下标
+ * @param n 当前样本下标
+ * @param k 往前数第k个(0=当前)
+ */
+static int32_t Ref_Window(const int16_t *hist, uint32_t start, uint32_t n, uint32_t k)
+{
+    return (n - start >= k) ? hist[n - k] : hist[start];
+}
+
+static int32_t Ref_MA(const int16_t *hist, uint32_t n, uint32_t len)
+{
+    int64_t sum = 0;
+    uint32_t shift = 0;
+
+    while ((1U << shift) < len)
+    {
+        shift++;
+    }
+    for (uint32_t k = 0; k < len; k++)
+    {
+        sum += Ref_Window(hist, 0, n, k);
+    }
+    /* 首个样本原样输出(窗口和恰为x<<shift，结果相同) */
+    return (int32_t)((sum + ((shift != 0) ? (1 << (shift - 1)) : 0)) >> shift);
+}
+
+static int Ref_Cmp16(const void *a, const void *b)
+{
+    return *(const int16_t *)a - *(const int16_t *)b;
+}
+
+static int16_t Ref_Median(const int16_t *hist, uint32_t start, uint32_t n, uint32_t len)
+{
+    int16_t w[FILTER_MEDIAN_MAX_LEN];
+
+    for (uint32_t k = 0; k < len; k++)
+    {
+        w[k] = (int16_t)Ref_Window(hist, start, n, k);
+    }
+    qsort(w, len, sizeof(w[0]), Ref_Cmp16);
+    return w[len / 2];
+}
+
+static int16_t Ref_IIR(int16_t y, int16_t x, uint32_t a)
+{
+    int64_t acc = (int64_t)a * x + (int64_t)(32768U - a) * y + 16384;
+
+    return (int16_t)(acc >> 15);
+}
+
+/**
+ * ============================================================================
+ * 测试用例
+ * ============================================================================
+ */
+
+/**
+ * @brief DSP内核的纯C实现: 边界值两两组合 + 随机
+ */
+static void Test_Kernels(void)
+{
+    uint32_t fails = 0;
+
+    for (uint32_t i = 0; i < TEST_EDGE_NUM * TEST_EDGE_NUM; i++)
+    {
+        for (uint32_t j = 0; j < TEST_EDGE_NUM * TEST_EDGE_NUM; j++)
+        {
+            uint32_t a = FILTER_PACK16(s_sEdge[i % TEST_EDGE_NUM], s_sEdge[i / TEST_EDGE_NUM]);
+            uint32_t b = FILTER_PACK16(s_sEdge[j % TEST_EDGE_NUM], s_sEdge[j / TEST_EDGE_NUM]);
+            uint32_t acc = (uint32_t)(int32_t)s_sEdge[(i + j) % TEST_EDGE_NUM] << ((i + j) & 15U);
+
+            fails += (Filter_SMLAD_C(a, b, acc) != Ref_SMLAD(a, b, acc));
+            fails += (Filter_SMLAD_C(a, b, 0x80000000UL) != Ref_SMLAD(a, b, 0x80000000UL));
+            fails += (Filter_QADD16_C(a, b) != Ref_Q16(a, b, 0));
+            fails += (Filter_QSUB16_C(a, b) != Ref_Q16(a, b, 1));
+        }
+    }
+
+    Test_Seed(26);
+    for (uint32_t i = 0; i < 1000000U; i++)
+    {
+        uint32_t a = Test_Rand();
+        uint32_t b = Test_Rand();
+        uint32_t acc = Test_Rand();
+
+        fails += (Filter_SMLAD_C(a, b, acc) != Ref_SMLAD(a, b, acc));
+        fails += (Filter_QADD16_C(a, b) != Ref_Q16(a, b, 0));
+        fails += (Filter_QSUB16_C(a, b) != Ref_Q16(a, b, 1));
+    }
+    TEST_EQ(fails, 0);
+
+    /* 手算: 两个半字分别饱和，互不进位 */
+    TEST_EQ(Filter_QADD16_C(FILTER_PACK16(32767, -32768), FILTER_PACK16(1, -1)),
+            FILTER_PACK16(32767, -32768));
+    TEST_EQ(Filter_QSUB16_C(FILTER_PACK16(-32768, 32767), FILTER_PACK16(1, -1)),
+            FILTER_PACK16(-32768, 32767));
+    TEST_EQ(Filter_QADD16_C(FILTER_PACK16(-1, 0), FILTER_PACK16(1, 0)), 0);
+    TEST_EQ(Filter_SMLAD_C(FILTER_PACK16(-32768, -32768), FILTER_PACK16(-32768, -32768), 0),
+            0x80000000UL);
+}
+
+/**
+ * @brief 初始化参数检查
+ */
+static void Test_Init(void)
+{
+    Filter_MA_TypeDef ma;
+    Filter_MA2_TypeDef ma2;
+    Filter_IIR_TypeDef iir;
+    Filter_Median_TypeDef med;
+    Filter_CIC_TypeDef cic;
+
+    for (uint32_t len = 0; len <= 2U * FILTER_MA_MAX_LEN; len++)
+    {
+        int ok = (len != 0 && (len & (len - 1U)) == 0 && len <= FILTER_MA_MAX_LEN) ? 0 : -1;
+
+        TEST_EQ(Filter_MA_Init(&ma, (uint8_t)len), ok);
+        TEST_EQ(Filter_MA2_Init(&ma2, (uint8_t)len), ok);
+    }
+    TEST_EQ(Filter_MA_Init(NULL, 4), -1);
+    TEST_EQ(Filter_MA2_Init(NULL, 4), -1);
+
+    TEST_EQ(Filter_IIR_Init(&iir, 0), -1);
+    TEST_EQ(Filter_IIR_Init(&iir, 1), 0);
+    TEST_EQ(Filter_IIR_Init(&iir, 32767), 0);
+    TEST_EQ(Filter_IIR_Init(&iir, 32768), -1);
+    TEST_EQ(Filter_IIR_Init(NULL, 100), -1);
+
+    for (uint32_t len = 0; len <= FILTER_MEDIAN_MAX_LEN + 2U; len++)
+    {
+        int ok = ((len & 1U) != 0 && len <= FILTER_MEDIAN_MAX_LEN) ? 0 : -1;
+
+        TEST_EQ(Filter_Median_Init(&med, (uint8_t)len), ok);
+    }
+    TEST_EQ(Filter_Median_Init(NULL, 3), -1);
+
+    TEST_EQ(Filter_CIC_Init(&cic, 0, 8), -1);
+    TEST_EQ(Filter_CIC_Init(&cic, FILTER_CIC_MAX_ORDER + 1U, 8), -1);
+    TEST_EQ(Filter_CIC_Init(&cic, 1, 1), -1);
+    TEST_EQ(Filter_CIC_Init(&cic, 1, 6), -1);
+    TEST_EQ(Filter_CIC_Init(&cic, 1, 2), 0);
+    TEST_EQ(Filter_CIC_Init(&cic, 4, 128), 0);
+    /* M*log2(R) >= 32 时增益无法归一化 */
+    TEST_EQ(Filter_CIC_Init(&cic, 4, 256), -1);
+    TEST_EQ(Filter_CIC_Init(NULL, 3, 8), -1);
+}
+
+/**
+ * @brief 单通道滑动平均: 全部窗口长度，满量程随机输入
+ */
+static void Test_MA(void)
+{
+    Filter_MA_TypeDef f;
+    uint32_t fails = 0;
+
+    Test_Seed(260);
+    for (uint32_t len = 1; len <= FILTER_MA_MAX_LEN; len <<= 1)
+    {
+        TEST_EQ(Filter_MA_Init(&f, (uint8_t)len), 0);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            s_sHist[n] = (n < 64U) ? s_sEdge[n % TEST_EDGE_NUM] : (int16_t)Test_Rand();
+            fails += (Filter_MA_Update(&f, s_sHist[n]) != Ref_MA(s_sHist, n, len));
+        }
+    }
+    TEST_EQ(fails, 0);
+}
+
+/**
+ * @brief 双通道滑动平均: 约定范围内(窗口和不饱和)两个通道分别等于单通道模型
+ */
+static void Test_MA2(void)
+{
+    static int16_t hist_hi[TEST_SAMPLES];
+    Filter_MA2_TypeDef f;
+    uint32_t fails = 0;
+
+    Test_Seed(261);
+    for (uint32_t len = 1; len <= FILTER_MA_MAX_LEN; len <<= 1)
+    {
+        /* 窗口长度 × 样本最大绝对值 < 32768 */
+        int32_t lim = (int32_t)(32767U / len);
+
+        TEST_EQ(Filter_MA2_Init(&f, (uint8_t)len), 0);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            uint32_t y;
+
+            s_sHist[n] = (int16_t)((int32_t)Test_RandBelow(2U * (uint32_t)lim + 1U) - lim);
+            hist_hi[n] = (int16_t)((int32_t)Test_RandBelow(2U * (uint32_t)lim + 1U) - lim);
+            y = Filter_MA2_Update(&f, FILTER_PACK16(s_sHist[n], hist_hi[n]));
+            fails += (FILTER_LO16(y) != Ref_MA(s_sHist, n, len));
+            fails += (FILTER_HI16(y) != Ref_MA(hist_hi, n, len));
+        }
+    }
+    TEST_EQ(fails, 0);
+
+    /* 超出约定时窗口和饱和在int16端点，不回绕 */
+    TEST_EQ(Filter_MA2_Init(&f, 2), 0);
+    (void)Filter_MA2_Update(&f, FILTER_PACK16(16000, -16000));
+    TEST_EQ(Filter_MA2_Update(&f, FILTER_PACK16(32767, -32768)), FILTER_PACK16(16384, -16384));
+}
+
+/**
+ * @brief IIR: 不同系数，随机位置复位
+ */
+static void Test_IIR(void)
+{
+    static const uint16_t alpha[] = {1U, 100U, 8192U, 16384U, 32767U};
+    Filter_IIR_TypeDef f;
+    uint32_t fails = 0;
+    uint32_t resets = 0;
+
+    Test_Seed(262);
+    for (uint32_t a = 0; a < sizeof(alpha) / sizeof(alpha[0]); a++)
+    {
+        int16_t y = 0;
+        int primed = 0;
+
+        TEST_EQ(Filter_IIR_Init(&f, alpha[a]), 0);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            int16_t x = (n < 64U) ? s_sEdge[n % TEST_EDGE_NUM] : (int16_t)Test_Rand();
+
+            if (Test_RandBelow(1000U) == 0)
+            {
+                Filter_IIR_Reset(&f);
+                primed = 0;
+                resets++;
+            }
+            y = primed ? Ref_IIR(y, x, alpha[a]) : x;
+            primed = 1;
+            fails += (Filter_IIR_Update(&f, x) != y);
+        }
+    }
+    TEST_EQ(fails, 0);
+    TEST_CHECK(resets > 100U);
+
+    /* 阶跃: 复位后第一个输出即为新值，否则逐步追赶 */
+    TEST_EQ(Filter_IIR_Init(&f, 8192U), 0);
+    (void)Filter_IIR_Update(&f, 1000);
+    TEST_EQ(Filter_IIR_Update(&f, 3000), 1500);
+    Filter_IIR_Reset(&f);
+    TEST_EQ(Filter_IIR_Update(&f, 3000), 3000);
+    TEST_EQ(Filter_IIR_Update(&f, 3000), 3000);
+}
+
+/**
+ * @brief 中值: 全部点数，随机位置复位
+ */
+static void Test_Median(void)
+{
+    Filter_Median_TypeDef f;
+    uint32_t fails = 0;
+    uint32_t resets = 0;
+
+    Test_Seed(263);
+    for (uint32_t len = 1; len <= FILTER_MEDIAN_MAX_LEN; len += 2U)
+    {
+        uint32_t start = 0;
+
+        TEST_EQ(Filter_Median_Init(&f, (uint8_t)len), 0);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            /* 一半样本取自小集合，窗口内出现大量重复值 */
+            s_sHist[n] = (Test_Rand() & 1U) ? s_sEdge[Test_RandBelow(TEST_EDGE_NUM)]
+                                            : (int16_t)Test_Rand();
+            if (Test_RandBelow(500U) == 0)
+            {
+                Filter_Median_Reset(&f);
+                start = n;
+                resets++;
+            }
+            fails += (Filter_Median_Update(&f, s_sHist[n]) != Ref_Median(s_sHist, start, n, len));
+        }
+    }
+    TEST_EQ(fails, 0);
+    TEST_CHECK(resets > 100U);
+
+    /* 阶跃: 复位前旧电平占多数时仍输出旧值，复位后立即为新值 */
+    TEST_EQ(Filter_Median_Init(&f, 5), 0);
+    (void)Filter_Median_Update(&f, 100);
+    TEST_EQ(Filter_Median_Update(&f, 900), 100);
+    TEST_EQ(Filter_Median_Update(&f, 900), 100);
+    Filter_Median_Reset(&f);
+    TEST_EQ(Filter_Median_Update(&f, 900), 900);
+    TEST_EQ(Filter_Median_Update(&f, 100), 900);
+}
+
+/**
+ * @brief CIC: 全部阶数与抽取因子，长序列(积分器多次回绕)
+ *
+ * @note 模型为M级长度R的滑动和(int64，不回绕)，每级保存最近R个输入
+ */
+static void Test_CIC(void)
+{
+    static int64_t ring[FILTER_CIC_MAX_ORDER][1U << 15];
+    Filter_CIC_TypeDef f;
+    uint32_t fails = 0;
+    uint32_t outputs = 0;
+
+    Test_Seed(264);
+    for (uint32_t order = 1; order <= FILTER_CIC_MAX_ORDER; order++)
+    {
+        /* decim为16位，R最大2^15 */
+        for (uint32_t lr = 1; lr <= 15U && order * lr < 32U; lr++)
+        {
+            uint32_t r = 1U << lr;
+            uint32_t shift = order * lr;
+            /* 输入位宽 + M*log2(R) <= 32 */
+            uint32_t bits = (32U - shift > 16U) ? 16U : 32U - shift;
+            int64_t sum[FILTER_CIC_MAX_ORDER] = {0};
+
+            TEST_EQ(Filter_CIC_Init(&f, (uint8_t)order, (uint16_t)r), 0);
+            for (uint32_t m = 0; m < order; m++)
+            {
+                memset(ring[m], 0, r * sizeof(ring[m][0]));
+            }
+            for (uint32_t n = 0; n < TEST_CIC_SAMPLES; n++)
+            {
+                int16_t x = (int16_t)((int32_t)Test_Rand() >> (32U - bits));
+                int64_t v = x;
+                int32_t out = 0;
+                int got = Filter_CIC_Update(&f, x, &out);
+
+                for (uint32_t m = 0; m < order; m++)
+                {
+                    sum[m] += v - ring[m][n & (r - 1U)];
+                    ring[m][n & (r - 1U)] = v;
+                    v = sum[m];
+                }
+                if (((n + 1U) & (r - 1U)) != 0)
+                {
+                    fails += (got != 0);
+                    continue;
+                }
+                fails += (got != 1 || out != (int32_t)(v >> shift));
+                outputs++;
+            }
+        }
+    }
+    TEST_EQ(fails, 0);
+    TEST_CHECK(outputs > 100000U);
+
+    /* 直流输入: 填满M*R个样本后输出等于输入 */
+    TEST_EQ(Filter_CIC_Init(&f, 3, 8), 0);
+    for (uint32_t n = 0; n < 64U; n++)
+    {
+        int32_t out = 0;
+
+        if (Filter_CIC_Update(&f, -1234, &out) && n >= 24U)
+        {
+            TEST_EQ(out, -1234);
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * 参考向量
+ * ============================================================================
+ */
+
+/**
+ * @brief 参考向量输入(与app_bench.c相同): LCG高16位，满量程
+ */
+static int16_t Test_GoldenInput(uint32_t *seed)
+{
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (int16_t)(*seed >> 16);
+}
+
+static void Test_Golden(void)
+{
+    Filter_MA_TypeDef ma;
+    Filter_MA2_TypeDef ma2;
+    Filter_IIR_TypeDef iir;
+    Filter_Median_TypeDef med;
+    Filter_CIC_TypeDef cic;
+    uint32_t crc[5] = {0};
+    uint32_t seed = 0x26U;
+
+    (void)Filter_MA_Init(&ma, 8U);
+    (void)Filter_MA2_Init(&ma2, 8U);
+    (void)Filter_IIR_Init(&iir, 8192U);
+    (void)Filter_Median_Init(&med, 5U);
+    (void)Filter_CIC_Init(&cic, 3U, 8U);
+
+    for (uint32_t n = 0; n < TEST_GOLDEN_LEN; n++)
+    {
+        int16_t x = Test_GoldenInput(&seed);
+        int16_t y;
+        uint32_t y2;
+        int32_t out;
+
+        if (n % TEST_GOLDEN_RESET == TEST_GOLDEN_RESET - 1U)
+        {
+            Filter_IIR_Reset(&iir);
+            Filter_Median_Reset(&med);
+        }
+        y = Filter_MA_Update(&ma, x);
+        crc[0] = CRC32_Update(crc[0], &y, sizeof(y));
+        /* 两通道各缩小到约定范围(8 × 2048 < 32768) */
+        y2 = Filter_MA2_Update(&ma2, FILTER_PACK16(x >> 4, (int16_t)~x >> 4));
+        crc[1] = CRC32_Update(crc[1], &y2, sizeof(y2));
+        y = Filter_IIR_Update(&iir, x);
+        crc[2] = CRC32_Update(crc[2], &y, sizeof(y));
+        y = Filter_Median_Update(&med, x);
+        crc[3] = CRC32_Update(crc[3], &y, sizeof(y));
+        if (Filter_CIC_Update(&cic, x, &out))
+        {
+            crc[4] = CRC32_Update(crc[4], &out, sizeof(out));
+        }
+    }
+
+    printf("[bench] golden: ma8 %08lx ma2x8 %08lx iir %08lx median5 %08lx cic3r8 %08lx\n",
+           (unsigned long)crc[0], (unsigned long)crc[1], (unsigned long)crc[2],
+           (unsigned long)crc[3], (unsigned long)crc[4]);
+    TEST_EQ(crc[0], TEST_GOLDEN_MA8);
+    TEST_EQ(crc[1], TEST_GOLDEN_MA2X8);
+    TEST_EQ(crc[2], TEST_GOLDEN_IIR);
+    TEST_EQ(crc[3], TEST_GOLDEN_MEDIAN5);
+    TEST_EQ(crc[4], TEST_GOLDEN_CIC3R8);
+}
+
+/**
+ * ============================================================================
+ * 耗时
+ * ============================================================================
+ */
+
+#define TEST_COST_LEN 4096U
+#define TEST_COST_ROUNDS 64U
+
+typedef enum
+{
+    TEST_COST_MA8 = 0,
+    TEST_COST_MA2X8,
+    TEST_COST_IIR,
+    TEST_COST_IIR_RESET,
+    TEST_COST_MEDIAN5,
+    TEST_COST_MEDIAN5_RESET,
+    TEST_COST_CIC3R8,
+    TEST_COST_NUM
+} Test_Cost_t;
+
+static const char *const s_pcCostName[TEST_COST_NUM] = {
+    "ma8", "ma2x8", "iir", "iir_reset", "median5", "median5_reset", "cic3r8"};
+
+static void Test_Cost(void)
+{
+    Filter_MA_TypeDef ma;
+    Filter_MA2_TypeDef ma2;
+    Filter_IIR_TypeDef iir;
+    Filter_Median_TypeDef med;
+    Filter_CIC_TypeDef cic;
+    volatile int32_t sink = 0;
+
+    Test_Seed(265);
+    for (uint32_t i = 0; i < TEST_COST_LEN; i++)
+    {
+        s_sHist[i] = (int16_t)(2000 + (int32_t)Test_RandBelow(64U) - 32);
+    }
+    (void)Filter_MA_Init(&ma, 8U);
+    (void)Filter_MA2_Init(&ma2, 8U);
+    (void)Filter_IIR_Init(&iir, 8192U);
+    (void)Filter_Median_Init(&med, 5U);
+    (void)Filter_CIC_Init(&cic, 3U, 8U);
+
+    for (uint32_t c = 0; c < TEST_COST_NUM; c++)
+    {
+        uint64_t t0 = Test_NowNs();
+
+        for (uint32_t r = 0; r < TEST_COST_ROUNDS; r++)
+        {
+            for (uint32_t i = 0; i < TEST_COST_LEN; i++)
+            {
+                int16_t x = s_sHist[i];
+                int32_t out = 0;
+
+                switch (c)
+                {
+                case TEST_COST_MA8:
+                    sink += Filter_MA_Update(&ma, x);
+                    break;
+                case TEST_COST_MA2X8:
+                    sink += (int32_t)Filter_MA2_Update(&ma2, FILTER_PACK16(x, 4095 - x));
+                    break;
+                case TEST_COST_IIR:
+                    sink += Filter_IIR_Update(&iir, x);
+                    break;
+                case TEST_COST_IIR_RESET:
+                    Filter_IIR_Reset(&iir);
+                    sink += Filter_IIR_Update(&iir, x);
+                    break;
+                case TEST_COST_MEDIAN5:
+                    sink += Filter_Median_Update(&med, x);
+                    break;
+                case TEST_COST_MEDIAN5_RESET:
+                    Filter_Median_Reset(&med);
+                    sink += Filter_Median_Update(&med, x);
+                    break;
+                default:
+                    sink += Filter_CIC_Update(&cic, x, &out) + out;
+                    break;
+                }
+            }
+        }
+        printf("[bench] filter_%s: %.2f ns/update\n", s_pcCostName[c],
+               (double)(Test_NowNs() - t0) / ((double)TEST_COST_ROUNDS * TEST_COST_LEN));
+    }
+    (void)sink;
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Kernels);
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_MA);
+    TEST_RUN(Test_MA2);
+    TEST_RUN(Test_IIR);
+    TEST_RUN(Test_Median);
+    TEST_RUN(Test_CIC);
+    TEST_RUN(Test_Golden);
+    TEST_RUN(Test_Cost);
+    return Test_Exit("test_filter");
+}
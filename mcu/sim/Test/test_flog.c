@@ -0,0 +1,421 @@
+/**
+ * @file test_flog.c
+ * @brief libx/flog主机测试: RAM模拟Flash上的轮换、磨损均衡与掉电恢复
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 模拟Flash按NOR语义工作: 写入只能把1变为0(写非擦除态的字记为错误)，擦除把整扇区置为0xFF
+ *       掉电注入: 每次上电给定一个操作预算(写一个字或擦除一次各消耗1)，预算用完的那次操作被打断:
+ *       - 写入: 之前的字已写入，当前字只写入一部分位(撕裂)，之后的字不写
+ *       - 擦除: 扇区前一部分已擦除，边界处的字为随机值，其余保持原样
+ *       之后所有操作失败，直到重新挂载；每次重新挂载后检查:
+ *       - 遍历得到的每条记录内容完整、序号严格递增，不返回损坏的数据
+ *       - 最后一次成功写出(FLog_Flush返回0)的记录一定存在
+ *       - 挂载后可以继续写入，新记录排在旧记录之后
+ */
+
+#include "sim_test.h"
+#include "flog.h"
+
+#include <string.h>
+
+/* 3个1KB扇区(每扇区约13个满块，足够频繁地轮换) */
+#define TEST_BASE 0x08080000UL
+#define TEST_SECTOR_SIZE 1024U
+#define TEST_SECTORS 3U
+#define TEST_WORDS (TEST_SECTOR_SIZE * TEST_SECTORS / 4U)
+
+/* 记录: 序号 + 序号反码 + 由序号生成的填充 */
+#define TEST_REC_MIN 8U
+#define TEST_REC_MAX 40U
+
+/**
+ * ============================================================================
+ * 模拟Flash
+ * ============================================================================
+ */
+
+static uint32_t s_ulFlash[TEST_WORDS];
+static int32_t s_lBudget = -1;     /**< 剩余操作数，-1=不限 */
+static uint8_t s_ucDead = 0;       /**< 已掉电 */
+static uint32_t s_ulOverwrite = 0; /**< 写非擦除态的字 */
+static uint32_t s_ulSectorErases[TEST_SECTORS];
+
+/**
+ * @brief 消耗一次操作预算，返回1表示本次操作被掉电打断
+ */
+static int Test_Cut(void)
+{
+    if (s_lBudget < 0)
+    {
+        return 0;
+    }
+    if (s_lBudget == 0)
+    {
+        s_ucDead = 1;
+        return 1;
+    }
+    s_lBudget--;
+    return 0;
+}
+
+static int Test_Index(uint32_t addr, uint32_t len, uint32_t *index)
+{
+    if (addr < TEST_BASE || addr + len > TEST_BASE + sizeof(s_ulFlash) || (addr & 3U) != 0)
+    {
+        return -1;
+    }
+    *index = (addr - TEST_BASE) / 4U;
+    return 0;
+}
+
+static int Test_Erase(uint32_t addr)
+{
+    uint32_t first;
+    uint32_t words = TEST_SECTOR_SIZE / 4U;
+    uint32_t done;
+
+    if (s_ucDead || Test_Index(addr, 4, &first) != 0)
+    {
+        return -1;
+    }
+    first -= first % words;
+
+    if (Test_Cut())
+    {
+        done = Test_RandBelow(words);
+        memset(&s_ulFlash[first], 0xFF, done * 4U);
+        s_ulFlash[first + done] = Test_Rand();
+        return -1;
+    }
+
+    memset(&s_ulFlash[first], 0xFF, words * 4U);
+    s_ulSectorErases[first / words]++;
+    return 0;
+}
+
+static int Test_Program(uint32_t addr, const uint32_t *words, uint32_t count)
+{
+    uint32_t first;
+
+    if (s_ucDead || Test_Index(addr, count * 4U, &first) != 0)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (s_ulFlash[first + i] != 0xFFFFFFFFUL)
+        {
+            s_ulOverwrite++;
+        }
+        if (Test_Cut())
+        {
+            /* 只有一部分0位写入 */
+            s_ulFlash[first + i] &= words[i] | Test_Rand();
+            return -1;
+        }
+        s_ulFlash[first + i] &= words[i];
+    }
+    return 0;
+}
+
+static int Test_Read(uint32_t addr, void *buf, uint32_t len)
+{
+    uint32_t first;
+
+    if (s_ucDead || addr < TEST_BASE || addr + len > TEST_BASE + sizeof(s_ulFlash))
+    {
+        return -1;
+    }
+    first = addr - TEST_BASE;
+    memcpy(buf, (const uint8_t *)s_ulFlash + first, len);
+    return 0;
+}
+
+static const FLog_Ops_TypeDef s_xOps = {Test_Erase, Test_Program, Test_Read};
+
+/**
+ * @brief 上电: 清除掉电状态并设置操作预算
+ */
+static void Test_PowerOn(int32_t budget)
+{
+    s_ucDead = 0;
+    s_lBudget = budget;
+}
+
+static void Test_Blank(void)
+{
+    memset(s_ulFlash, 0xFF, sizeof(s_ulFlash));
+    memset(s_ulSectorErases, 0, sizeof(s_ulSectorErases));
+    s_ulOverwrite = 0;
+    Test_PowerOn(-1);
+}
+
+/**
+ * ============================================================================
+ * 记录生成与校验
+ * ============================================================================
+ */
+
+static uint8_t Test_MakeRecord(uint32_t serial, uint8_t *buf)
+{
+    uint8_t len = (uint8_t)(TEST_REC_MIN + Test_RandBelow(TEST_REC_MAX - TEST_REC_MIN + 1U));
+    uint32_t inv = ~serial;
+
+    memcpy(buf, &serial, 4);
+    memcpy(buf + 4, &inv, 4);
+    for (uint8_t i = 8; i < len; i++)
+    {
+        buf[i] = (uint8_t)(serial * 31U + i);
+    }
+    return len;
+}
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t first;
+    uint32_t last;
+    uint32_t bad;       /**< 内容损坏 */
+    uint32_t unordered; /**< 序号不递增 */
+    uint32_t gaps;      /**< 序号不连续 */
+    uint32_t want;      /**< 需要出现的序号 */
+    uint8_t found;
+} Test_Scan_TypeDef;
+
+static int Test_Visit(void *ctx, uint32_t seq, const uint8_t *data, uint8_t len)
+{
+    Test_Scan_TypeDef *scan = (Test_Scan_TypeDef *)ctx;
+    uint32_t serial;
+    uint32_t inv;
+    uint8_t ok;
+
+    (void)seq;
+
+    ok = (len >= TEST_REC_MIN && len <= TEST_REC_MAX);
+    if (ok)
+    {
+        memcpy(&serial, data, 4);
+        memcpy(&inv, data + 4, 4);
+        ok = (serial == ~inv);
+        for (uint8_t i = 8; ok && i < len; i++)
+        {
+            ok = (data[i] == (uint8_t)(serial * 31U + i));
+        }
+    }
+    if (!ok)
+    {
+        scan->bad++;
+        return 0;
+    }
+
+    if (scan->count != 0)
+    {
+        if (serial <= scan->last)
+        {
+            scan->unordered++;
+        }
+        else if (serial != scan->last + 1U)
+        {
+            scan->gaps++;
+        }
+    }
+    else
+    {
+        scan->first = serial;
+    }
+    if (serial == scan->want)
+    {
+        scan->found = 1;
+    }
+    scan->last = serial;
+    scan->count++;
+    return 0;
+}
+
+static void Test_Scan(const FLog_TypeDef *log, uint32_t want, Test_Scan_TypeDef *scan)
+{
+    memset(scan, 0, sizeof(*scan));
+    scan->want = want;
+    TEST_EQ(FLog_Iterate(log, Test_Visit, scan), scan->count + scan->bad);
+}
+
+/**
+ * ============================================================================
+ * 测试用例
+ * ============================================================================
+ */
+
+/**
+ * @brief 空白器件上挂载与轮换不擦除，扇区用完一轮后才开始擦除
+ */
+static void Test_BlankSkipsErase(void)
+{
+    FLog_TypeDef log;
+    uint8_t rec[TEST_REC_MAX];
+    uint32_t serial = 0;
+
+    Test_Blank();
+    Test_Seed(30);
+    TEST_EQ(FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS), 1);
+    TEST_EQ(log.erases, 0);
+
+    while (log.seq < TEST_SECTORS)
+    {
+        serial++;
+        TEST_EQ(FLog_Append(&log, rec, Test_MakeRecord(serial, rec)), 0);
+    }
+    TEST_EQ(log.erases, 0);
+
+    while (log.seq < TEST_SECTORS + 1U)
+    {
+        serial++;
+        TEST_EQ(FLog_Append(&log, rec, Test_MakeRecord(serial, rec)), 0);
+    }
+    TEST_EQ(log.erases, 1);
+    TEST_EQ(s_ulSectorErases[0], 1);
+
+    /* 已有日志时重新挂载不擦除 */
+    TEST_EQ(FLog_Flush(&log), 0);
+    TEST_EQ(FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS), 0);
+    TEST_EQ(log.erases, 0);
+    TEST_EQ(s_ulOverwrite, 0);
+
+    /* 有旧数据但没有有效扇区头: 需要擦除 */
+    s_ulFlash[0] = 0;
+    s_ulFlash[TEST_SECTOR_SIZE / 4U] = 0;
+    s_ulFlash[TEST_SECTOR_SIZE / 2U] = 0;
+    TEST_EQ(FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS), 1);
+    TEST_EQ(log.erases, 1);
+}
+
+/**
+ * @brief 无掉电时的长时间写入: 保留最新的连续记录，擦除次数均衡
+ */
+static void Test_Rotation(void)
+{
+    FLog_TypeDef log;
+    Test_Scan_TypeDef scan;
+    uint8_t rec[TEST_REC_MAX];
+    uint32_t serial;
+    uint32_t lo = 0xFFFFFFFFUL;
+    uint32_t hi = 0;
+    uint64_t t0;
+
+    Test_Blank();
+    Test_Seed(31);
+    TEST_EQ(FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS), 1);
+
+    t0 = Test_NowNs();
+    for (serial = 1; serial <= 20000U; serial++)
+    {
+        TEST_EQ(FLog_Append(&log, rec, Test_MakeRecord(serial, rec)), 0);
+        if (Test_RandBelow(4) == 0)
+        {
+            TEST_EQ(FLog_Flush(&log), 0);
+        }
+    }
+    TEST_EQ(FLog_Flush(&log), 0);
+    printf("[bench] flog append+flush: %.1f ns/record\n",
+           (double)(Test_NowNs() - t0) / 20000.0);
+
+    Test_Scan(&log, serial - 1U, &scan);
+    TEST_EQ(scan.bad, 0);
+    TEST_EQ(scan.unordered, 0);
+    TEST_EQ(scan.gaps, 0);
+    TEST_EQ(scan.last, serial - 1U);
+    /* 至少保留两个满扇区(每条记录最多41字节，每块最多256字节负载) */
+    TEST_CHECK(scan.count >= 2U * ((TEST_SECTOR_SIZE - 16U) / (8U + 256U)) * (256U / (TEST_REC_MAX + 1U)));
+
+    for (uint32_t i = 0; i < TEST_SECTORS; i++)
+    {
+        lo = (s_ulSectorErases[i] < lo) ? s_ulSectorErases[i] : lo;
+        hi = (s_ulSectorErases[i] > hi) ? s_ulSectorErases[i] : hi;
+    }
+    TEST_CHECK(hi - lo <= 1U);
+    TEST_EQ(s_ulOverwrite, 0);
+
+    /* 重新挂载后内容相同 */
+    TEST_EQ(FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS), 0);
+    Test_Scan(&log, serial - 1U, &scan);
+    TEST_EQ(scan.last, serial - 1U);
+    TEST_EQ(scan.bad + scan.gaps + scan.unordered, 0);
+}
+
+/**
+ * @brief 在随机位置反复掉电
+ */
+static void Test_PowerCut(void)
+{
+    FLog_TypeDef log;
+    Test_Scan_TypeDef scan;
+    uint8_t rec[TEST_REC_MAX];
+    uint16_t before;
+    uint8_t len;
+    uint32_t serial = 0;
+    uint32_t durable = 0;
+    uint32_t mounts = 0;
+
+    Test_Blank();
+    Test_Seed(32);
+
+    for (uint32_t boot = 0; boot < 20000U; boot++)
+    {
+        /* 挂载与检查不掉电，之后的写入随机掉电 */
+        Test_PowerOn(-1);
+        if (FLog_Mount(&log, &s_xOps, TEST_BASE, TEST_SECTOR_SIZE, TEST_SECTORS) < 0)
+        {
+            TEST_CHECK(0);
+            break;
+        }
+        mounts++;
+
+        Test_Scan(&log, durable, &scan);
+        TEST_EQ(scan.bad, 0);
+        TEST_EQ(scan.unordered, 0);
+        TEST_CHECK(durable == 0 || scan.found);
+        TEST_CHECK(scan.count == 0 || scan.last <= serial);
+        if (scan.bad != 0 || scan.unordered != 0 || (durable != 0 && !scan.found))
+        {
+            printf("boot %lu: durable %lu, scanned %lu..%lu\n", (unsigned long)boot,
+                   (unsigned long)durable, (unsigned long)scan.first, (unsigned long)scan.last);
+            break;
+        }
+
+        /* 平均约2个块之后掉电，覆盖块头、负载、扇区头与擦除的每个位置 */
+        Test_PowerOn((int32_t)Test_RandBelow(160));
+        while (!s_ucDead)
+        {
+            serial++;
+            len = Test_MakeRecord(serial, rec);
+            before = log.batch_len;
+            if (FLog_Append(&log, rec, len) != 0)
+            {
+                break;
+            }
+            /* 追加前缓冲放不下时先写出了之前的记录 */
+            if (before != 0 && log.batch_len == 1U + len)
+            {
+                durable = serial - 1U;
+            }
+            if (Test_RandBelow(3) == 0 && FLog_Flush(&log) == 0)
+            {
+                durable = serial;
+            }
+        }
+    }
+
+    TEST_EQ(mounts, 20000);
+    TEST_EQ(s_ulOverwrite, 0);
+    printf("[bench] flog power cuts: %lu boots, %lu records written\n",
+           (unsigned long)mounts, (unsigned long)serial);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_BlankSkipsErase);
+    TEST_RUN(Test_Rotation);
+    TEST_RUN(Test_PowerCut);
+    return Test_Exit("test_flog");
+}
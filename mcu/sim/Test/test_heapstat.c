@@ -0,0 +1,432 @@
+/**
+ * @file test_heapstat.c
+ * @brief libx/heapstat主机测试: 随机分配/释放序列对照参考模型，表溢出、空闲块直方图、趋势与报告
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 地址为合成值(8字节对齐，不访问)，一半取哈希到同一槽位的地址，
+ *       让活动分配表形成长探测链，检验删除后移填补后每一项仍可查到:
+ *       - 每步之后检查表中每一项从理想槽位到所在槽位之间没有空槽、项数与模型一致
+ *       - 调用者数超过表容量时，多出的调用者归入"其他"项
+ *       - 全部释放后总量与各调用者的当前字节数归零，没有未知释放
+ */
+
+#include "sim_test.h"
+#include "heapstat.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#define TEST_OPS 200000U
+#define TEST_LIVE (HEAPSTAT_LIVE_MAX - 1U)  /**< 表中可记录的活动分配数 */
+#define TEST_CALLERS 20U                   /**< 多于HEAPSTAT_CALLER_MAX */
+#define TEST_BENCH_OPS 2000000U
+
+typedef struct
+{
+    uintptr_t ptr;
+    uint32_t size;
+    uint32_t caller;  /**< 模型中的调用者下标 */
+} Test_Live_TypeDef;
+
+typedef struct
+{
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t fails;
+    uint32_t cur;
+    uint32_t peak;
+} Test_Caller_TypeDef;
+
+static HeapStat_TypeDef s_xHs;
+
+static Test_Live_TypeDef s_xLive[TEST_LIVE];
+static uint32_t s_ulLive;
+static Test_Caller_TypeDef s_xCaller[TEST_CALLERS + 1U]; /**< 最后一项为"其他" */
+static uintptr_t s_ulNextAddr;
+
+static char s_cOut[8192];
+static size_t s_ulOutLen;
+
+/**
+ * ============================================================================
+ * 辅助函数
+ * ============================================================================
+ */
+
+static uintptr_t Test_CallerAddr(uint32_t c)
+{
+    return 0x08001000UL + c * 0x40UL;
+}
+
+/**
+ * @brief 不重复的地址: 一半为8*64的倍数(哈希到同一槽位)，一半为任意8字节对齐
+ */
+static uintptr_t Test_Addr(void)
+{
+    s_ulNextAddr += 8U * HEAPSTAT_LIVE_MAX;
+    return s_ulNextAddr + ((Test_Rand() & 1U) ? 0U : 8U * (1U + Test_RandBelow(HEAPSTAT_LIVE_MAX - 1U)));
+}
+
+static uint32_t Test_Home(uintptr_t ptr)
+{
+    return ((uint32_t)(ptr >> 3) * 2654435761UL) & (HEAPSTAT_LIVE_MAX - 1U);
+}
+
+/**
+ * @brief 活动分配表的结构: 项数一致，每一项从理想槽位起的探测链不断
+ */
+static int Test_TableOk(void)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < HEAPSTAT_LIVE_MAX; i++)
+    {
+        const HeapStat_Live_TypeDef *e = &s_xHs.live[i];
+
+        if (e->ptr == 0)
+        {
+            continue;
+        }
+        n++;
+        for (uint32_t j = Test_Home(e->ptr); j != i; j = (j + 1U) & (HEAPSTAT_LIVE_MAX - 1U))
+        {
+            if (s_xHs.live[j].ptr == 0)
+            {
+                return 0;
+            }
+        }
+    }
+    return n == s_xHs.live_count && n == s_ulLive;
+}
+
+/**
+ * @brief 模型中调用者c对应的统计表项(第15个之后的调用者共用"其他")
+ */
+static const HeapStat_Caller_TypeDef *Test_HsCaller(uint32_t c)
+{
+    for (uint32_t i = 0; i < HEAPSTAT_CALLER_MAX - 1U; i++)
+    {
+        if (s_xHs.caller[i].caller == Test_CallerAddr(c))
+        {
+            return &s_xHs.caller[i];
+        }
+    }
+    return &s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U];
+}
+
+static int Test_Print(const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(s_cOut + s_ulOutLen, sizeof(s_cOut) - s_ulOutLen, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+    {
+        s_ulOutLen += (size_t)n;
+    }
+    return n;
+}
+
+/**
+ * ============================================================================
+ * 测试用例
+ * ============================================================================
+ */
+
+/**
+ * @brief 随机序列对照模型(活动分配不超过表容量，全部可归属)
+ */
+static void Test_Random(void)
+{
+    uint32_t bad_table = 0;
+    uint32_t cur = 0;
+    uint32_t peak = 0;
+    uint32_t first_other = 0;
+
+    Test_Seed(43);
+    HeapStat_Init(&s_xHs, 65536U);
+    memset(s_xCaller, 0, sizeof(s_xCaller));
+    s_ulLive = 0;
+    s_ulNextAddr = 0x20000000UL;
+
+    for (uint32_t op = 0; op < TEST_OPS; op++)
+    {
+        uint32_t r = Test_RandBelow(16U);
+
+        if (r < 8U && s_ulLive < TEST_LIVE)
+        {
+            Test_Live_TypeDef *l = &s_xLive[s_ulLive++];
+
+            l->ptr = Test_Addr();
+            l->size = 8U + 8U * Test_RandBelow(64U);
+            l->caller = Test_RandBelow(TEST_CALLERS);
+            HeapStat_Alloc(&s_xHs, (const void *)l->ptr, l->size, Test_CallerAddr(l->caller));
+
+            cur += l->size;
+            peak = (cur > peak) ? cur : peak;
+            s_xCaller[l->caller].allocs++;
+            s_xCaller[l->caller].cur += l->size;
+            if (s_xCaller[l->caller].cur > s_xCaller[l->caller].peak)
+            {
+                s_xCaller[l->caller].peak = s_xCaller[l->caller].cur;
+            }
+        }
+        else if (r == 8U)
+        {
+            uint32_t c = Test_RandBelow(TEST_CALLERS);
+
+            HeapStat_Alloc(&s_xHs, NULL, 1024U, Test_CallerAddr(c));
+            s_xCaller[c].fails++;
+        }
+        else if (s_ulLive != 0)
+        {
+            uint32_t k = Test_RandBelow(s_ulLive);
+            Test_Live_TypeDef l = s_xLive[k];
+
+            /* 故意传入错误的大小: 表中有记录时应使用登记的大小 */
+            HeapStat_Free(&s_xHs, (const void *)l.ptr, l.size + 8U);
+            s_xLive[k] = s_xLive[--s_ulLive];
+
+            cur -= l.size;
+            s_xCaller[l.caller].frees++;
+            s_xCaller[l.caller].cur -= l.size;
+        }
+
+        bad_table += !Test_TableOk();
+        if (s_xHs.cur_bytes != cur || s_xHs.peak_bytes != peak)
+        {
+            TEST_EQ(s_xHs.cur_bytes, cur);
+            TEST_EQ(s_xHs.peak_bytes, peak);
+            break;
+        }
+    }
+    TEST_EQ(bad_table, 0);
+    TEST_EQ(s_xHs.unknown_free, 0);
+    TEST_EQ(s_xHs.live_lost, 0);
+
+    /* 每个调用者: 表中前15个各自一项，其余合并到"其他"(峰值为合并后的，只核对计数与当前值) */
+    {
+        Test_Caller_TypeDef other = {0};
+        uint32_t mism = 0;
+
+        for (uint32_t c = 0; c < TEST_CALLERS; c++)
+        {
+            const HeapStat_Caller_TypeDef *hc = Test_HsCaller(c);
+
+            if (hc == &s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U])
+            {
+                other.allocs += s_xCaller[c].allocs;
+                other.frees += s_xCaller[c].frees;
+                other.fails += s_xCaller[c].fails;
+                other.cur += s_xCaller[c].cur;
+                first_other++;
+                continue;
+            }
+            mism += hc->allocs != s_xCaller[c].allocs || hc->frees != s_xCaller[c].frees ||
+                    hc->fails != s_xCaller[c].fails || hc->cur_bytes != s_xCaller[c].cur ||
+                    hc->peak_bytes != s_xCaller[c].peak;
+        }
+        TEST_EQ(mism, 0);
+        TEST_EQ(first_other, TEST_CALLERS - (HEAPSTAT_CALLER_MAX - 1U));
+        TEST_EQ(s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U].caller, 0);
+        TEST_EQ(s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U].allocs, other.allocs);
+        TEST_EQ(s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U].frees, other.frees);
+        TEST_EQ(s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U].fails, other.fails);
+        TEST_EQ(s_xHs.caller[HEAPSTAT_CALLER_MAX - 1U].cur_bytes, other.cur);
+    }
+
+    /* 全部释放后归零 */
+    while (s_ulLive != 0)
+    {
+        s_ulLive--;
+        HeapStat_Free(&s_xHs, (const void *)s_xLive[s_ulLive].ptr, s_xLive[s_ulLive].size);
+    }
+    TEST_EQ(s_xHs.cur_bytes, 0);
+    TEST_EQ(s_xHs.live_count, 0);
+    TEST_EQ(s_xHs.allocs, s_xHs.frees);
+    for (uint32_t i = 0; i < HEAPSTAT_CALLER_MAX; i++)
+    {
+        TEST_EQ(s_xHs.caller[i].cur_bytes, 0);
+    }
+}
+
+/**
+ * @brief 表满: 多出的分配不记录，释放时按堆报告的大小扣减总量
+ */
+static void Test_Overflow(void)
+{
+    const uint32_t n = HEAPSTAT_LIVE_MAX + 8U;
+    const uintptr_t caller = 0x08002000UL;
+
+    HeapStat_Init(&s_xHs, 65536U);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        HeapStat_Alloc(&s_xHs, (const void *)(uintptr_t)(0x20000000UL + 8U * i), 32U, caller);
+    }
+    TEST_EQ(s_xHs.live_count, TEST_LIVE);
+    TEST_EQ(s_xHs.live_lost, n - TEST_LIVE);
+    TEST_EQ(s_xHs.cur_bytes, 32U * n);
+    TEST_EQ(s_xHs.caller[0].cur_bytes, 32U * n);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        HeapStat_Free(&s_xHs, (const void *)(uintptr_t)(0x20000000UL + 8U * i), 32U);
+    }
+    TEST_EQ(s_xHs.unknown_free, n - TEST_LIVE);
+    TEST_EQ(s_xHs.live_count, 0);
+    TEST_EQ(s_xHs.cur_bytes, 0);
+    /* 未记录的分配无法归属，调用者的当前字节数偏大(见heapstat.h) */
+    TEST_EQ(s_xHs.caller[0].frees, TEST_LIVE);
+    TEST_EQ(s_xHs.caller[0].cur_bytes, 32U * (n - TEST_LIVE));
+
+    /* 不是经钩子分配的地址 */
+    HeapStat_Free(&s_xHs, (const void *)(uintptr_t)0x30000000UL, 64U);
+    TEST_EQ(s_xHs.unknown_free, n - TEST_LIVE + 1U);
+    TEST_EQ(s_xHs.cur_bytes, 0);
+}
+
+/**
+ * @brief 空闲链表遍历: 直方图分档、最大块、碎片率、趋势环
+ */
+static void Test_Walk(void)
+{
+    static const uint32_t sizes[] = {8U, 15U, 16U, 31U, 32U, 100U, 16383U, 16384U, 1000000U};
+    static const uint32_t bins[] = {0U, 0U, 1U, 1U, 2U, 3U, 10U, 11U, 11U};
+
+    HeapStat_Init(&s_xHs, 2000000U);
+    TEST_EQ(HeapStat_FragPermille(&s_xHs), 0);
+
+    HeapStat_WalkBegin(&s_xHs);
+    for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        HeapStat_WalkBlock(&s_xHs, sizes[i]);
+    }
+    HeapStat_WalkEnd(&s_xHs, 7U);
+    for (uint32_t b = 0; b < HEAPSTAT_HIST_BINS; b++)
+    {
+        uint32_t want = 0;
+
+        for (uint32_t i = 0; i < sizeof(bins) / sizeof(bins[0]); i++)
+        {
+            want += (bins[i] == b);
+        }
+        TEST_EQ(s_xHs.hist[b], want);
+    }
+    TEST_EQ(s_xHs.free_blocks, 9);
+    TEST_EQ(s_xHs.largest, 1000000U);
+    TEST_EQ(s_xHs.free_bytes, 8U + 15U + 16U + 31U + 32U + 100U + 16383U + 16384U + 1000000U);
+
+    /* 100 + 300 + 600: 最大块占60%，碎片率40.0% */
+    HeapStat_WalkBegin(&s_xHs);
+    HeapStat_WalkBlock(&s_xHs, 100U);
+    HeapStat_WalkBlock(&s_xHs, 600U);
+    HeapStat_WalkBlock(&s_xHs, 300U);
+    HeapStat_WalkEnd(&s_xHs, 8U);
+    TEST_EQ(HeapStat_FragPermille(&s_xHs), 400);
+    TEST_EQ(s_xHs.min_largest, 600);
+    TEST_EQ(s_xHs.hist[HEAPSTAT_HIST_BINS - 1U], 0);
+
+    /* 趋势环只保留最近HEAPSTAT_TREND_LEN个样本 */
+    for (uint32_t t = 9; t < 9U + HEAPSTAT_TREND_LEN + 5U; t++)
+    {
+        HeapStat_WalkBegin(&s_xHs);
+        HeapStat_WalkBlock(&s_xHs, 1000U + t);
+        HeapStat_WalkEnd(&s_xHs, t);
+    }
+    TEST_EQ(s_xHs.walks, 2U + HEAPSTAT_TREND_LEN + 5U);
+    TEST_EQ(s_xHs.trend_count, HEAPSTAT_TREND_LEN);
+    TEST_EQ(s_xHs.trend[(s_xHs.trend_head + HEAPSTAT_TREND_LEN - s_xHs.trend_count) % HEAPSTAT_TREND_LEN].t,
+            9U + 5U);
+    TEST_EQ(s_xHs.min_largest, 600);
+    TEST_EQ(HeapStat_FragPermille(&s_xHs), 0);
+}
+
+/**
+ * @brief 报告: 汇总行、"其他"调用者、活动分配按序号从老到新且受live_max限制
+ */
+static void Test_Dump(void)
+{
+    char *p;
+    char *q;
+
+    HeapStat_Init(&s_xHs, 4096U);
+    for (uint32_t i = 0; i < 20U; i++)
+    {
+        HeapStat_Alloc(&s_xHs, (const void *)(uintptr_t)(0x20000000UL + 64U * (20U - i)), 16U + i,
+                       Test_CallerAddr(i));
+    }
+    /* 释放最老的两个，最老的未释放分配为#2 */
+    HeapStat_Free(&s_xHs, (const void *)(uintptr_t)(0x20000000UL + 64U * 20U), 0);
+    HeapStat_Free(&s_xHs, (const void *)(uintptr_t)(0x20000000UL + 64U * 19U), 0);
+    HeapStat_WalkBegin(&s_xHs);
+    HeapStat_WalkBlock(&s_xHs, 200U);
+    HeapStat_WalkBlock(&s_xHs, 800U);
+    HeapStat_WalkEnd(&s_xHs, 5U);
+
+    s_ulOutLen = 0;
+    s_cOut[0] = '\0';
+    HeapStat_Dump(&s_xHs, Test_Print, 3U);
+
+    TEST_CHECK(strstr(s_cOut, "free 1000 in 2 blocks, largest 800 (min 800), frag 20.0%") != NULL);
+    TEST_CHECK(strstr(s_cOut, "allocs 20, frees 2, fails 0, live 18 (untracked 0)") != NULL);
+    TEST_CHECK(strstr(s_cOut, "other  0x00000000") != NULL);
+    TEST_CHECK(strstr(s_cOut, " 5:800/1000") != NULL);
+
+    p = strstr(s_cOut, "-- live allocations");
+    TEST_CHECK(p != NULL);
+    if (p != NULL)
+    {
+        q = strstr(p, "#2 ");
+        TEST_CHECK(q != NULL && strstr(p, "#0 ") == NULL && strstr(p, "#1 ") == NULL);
+        TEST_CHECK(q != NULL && strstr(q, "#3 ") != NULL && strstr(q, "#4 ") != NULL);
+        TEST_CHECK(strstr(p, "#5 ") == NULL);
+    }
+}
+
+/**
+ * @brief 每对分配/释放钩子的开销(表中约一半项)
+ */
+static void Test_Cost(void)
+{
+    uintptr_t ring[32];
+    uint64_t t0;
+    uint64_t ns;
+
+    Test_Seed(4300);
+    HeapStat_Init(&s_xHs, 65536U);
+    s_ulNextAddr = 0x20000000UL;
+    for (uint32_t i = 0; i < 32U; i++)
+    {
+        ring[i] = Test_Addr();
+        HeapStat_Alloc(&s_xHs, (const void *)ring[i], 64U, Test_CallerAddr(i & 7U));
+    }
+
+    t0 = Test_NowNs();
+    for (uint32_t k = 0; k < TEST_BENCH_OPS; k++)
+    {
+        uint32_t i = k & 31U;
+
+        HeapStat_Free(&s_xHs, (const void *)ring[i], 64U);
+        ring[i] = Test_Addr();
+        HeapStat_Alloc(&s_xHs, (const void *)ring[i], 64U, Test_CallerAddr(i & 7U));
+    }
+    ns = Test_NowNs() - t0;
+
+    TEST_EQ(s_xHs.unknown_free, 0);
+    TEST_EQ(s_xHs.live_count, 32);
+    printf("[bench] heapstat_free_alloc: %.1f ns per pair (32 live, half colliding)\n",
+           (double)ns / TEST_BENCH_OPS);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Random);
+    TEST_RUN(Test_Overflow);
+    TEST_RUN(Test_Walk);
+    TEST_RUN(Test_Dump);
+    TEST_RUN(Test_Cost);
+    return Test_Exit("test_heapstat");
+}
@@ -0,0 +1,263 @@
+/**
+ * @file test_lut.c
+ * @brief libx/lut主机测试: 建表校验、标定点精确、段内误差与端点钳位
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 参考值为双精度线性插值；定点结果在标定点上必须精确，段内误差必须小于1
+ *       (斜率Q16四舍五入误差乘以段长不超过0.5，加上结果舍入0.5)
+ *       随机表覆盖递增/递减/混合、2~LUT_MAX_POINTS点、段长1~65535、接近上限的斜率，
+ *       每张表在0~65535全部横坐标上逐点对比
+ */
+
+#include "sim_test.h"
+#include "lut.h"
+
+#include <math.h>
+
+#define TEST_TABLES 300U
+#define TEST_SLOPE_MAX 32767 /**< |dy/dx|上限(不含32768) */
+
+static uint16_t s_usX[LUT_MAX_POINTS];
+static int32_t s_lY[LUT_MAX_POINTS];
+
+/**
+ * @brief 双精度参考插值(超出范围钳位到端点)
+ */
+static double Test_RefInterp(const uint16_t *x, const int32_t *y, uint8_t n, uint16_t v)
+{
+    uint8_t i = 0;
+
+    if (v <= x[0])
+    {
+        return y[0];
+    }
+    if (v >= x[n - 1])
+    {
+        return y[n - 1];
+    }
+    while (v >= x[i + 1])
+    {
+        i++;
+    }
+    return y[i] + (double)(y[i + 1] - y[i]) * (v - x[i]) / (double)(x[i + 1] - x[i]);
+}
+
+/**
+ * @brief 随机生成一张合法表: 横坐标严格递增，每段斜率不超过上限
+ */
+static uint8_t Test_RandomTable(void)
+{
+    uint8_t n = (uint8_t)(2U + Test_RandBelow(LUT_MAX_POINTS - 1U));
+    uint32_t span = 65535U / n;
+    uint32_t x = Test_RandBelow(span);
+
+    /* 段长按对数分布，短段(1~几个计数)与长段都能取到 */
+    s_usX[0] = (uint16_t)x;
+    for (uint8_t i = 1; i < n; i++)
+    {
+        uint32_t dx = 1U + (Test_RandBelow(span) >> Test_RandBelow(16U));
+
+        x += (dx < span) ? dx : span;
+        s_usX[i] = (uint16_t)x;
+    }
+
+    s_lY[0] = (int32_t)Test_RandBelow(2000001U) - 1000000;
+    for (uint8_t i = 1; i < n; i++)
+    {
+        int64_t dx = (int64_t)s_usX[i] - s_usX[i - 1];
+        int64_t limit = dx * TEST_SLOPE_MAX;
+        int64_t dy;
+
+        /* 四分之一的段取接近上限的斜率 */
+        if ((Test_Rand() & 3U) == 0)
+        {
+            dy = limit - (int64_t)Test_RandBelow(4U);
+        }
+        else
+        {
+            dy = (int64_t)Test_RandBelow((uint32_t)((limit < 1000000) ? limit + 1 : 1000001));
+        }
+        if (Test_Rand() & 1U)
+        {
+            dy = -dy;
+        }
+        s_lY[i] = (int32_t)(s_lY[i - 1] + dy);
+    }
+    return n;
+}
+
+/**
+ * @brief 建表参数校验
+ */
+static void Test_Build(void)
+{
+    static const uint16_t x[3] = {10, 20, 30};
+    static const uint16_t dup[3] = {10, 20, 20};
+    static const uint16_t dec[3] = {10, 30, 20};
+    static const int32_t y[3] = {0, 100, -50};
+    uint16_t xs[LUT_MAX_POINTS + 1];
+    int32_t ys[LUT_MAX_POINTS + 1];
+    LUT_TypeDef lut;
+
+    TEST_EQ(LUT_Build(&lut, x, y, 3), 0);
+    TEST_EQ(lut.count, 3);
+
+    TEST_EQ(LUT_Build(NULL, x, y, 3), -1);
+    TEST_EQ(LUT_Build(&lut, NULL, y, 3), -1);
+    TEST_EQ(LUT_Build(&lut, x, NULL, 3), -1);
+    TEST_EQ(LUT_Build(&lut, x, y, 1), -1);
+    TEST_EQ(LUT_Build(&lut, dup, y, 3), -1);
+    TEST_EQ(LUT_Build(&lut, dec, y, 3), -1);
+
+    for (uint32_t i = 0; i <= LUT_MAX_POINTS; i++)
+    {
+        xs[i] = (uint16_t)(i * 100U);
+        ys[i] = (int32_t)i;
+    }
+    TEST_EQ(LUT_Build(&lut, xs, ys, LUT_MAX_POINTS), 0);
+    TEST_EQ(LUT_Build(&lut, xs, ys, LUT_MAX_POINTS + 1), -1);
+
+    /* 斜率上限: |dy/dx| = 32767可以，32768溢出Q16 */
+    xs[0] = 0;
+    xs[1] = 1;
+    ys[0] = 0;
+    ys[1] = TEST_SLOPE_MAX;
+    TEST_EQ(LUT_Build(&lut, xs, ys, 2), 0);
+    TEST_EQ(LUT_Interp(&lut, 1), TEST_SLOPE_MAX);
+    ys[1] = -TEST_SLOPE_MAX;
+    TEST_EQ(LUT_Build(&lut, xs, ys, 2), 0);
+    ys[1] = TEST_SLOPE_MAX + 1;
+    TEST_EQ(LUT_Build(&lut, xs, ys, 2), -1);
+    /* 失败后表不可用，插值返回0 */
+    TEST_EQ(lut.count, 0);
+    TEST_EQ(LUT_Interp(&lut, 1), 0);
+}
+
+/**
+ * @brief 手算的小表: 标定点、段内、端点外
+ */
+static void Test_Known(void)
+{
+    /* GL5528式递减曲线的一段 + 一段递增 */
+    static const uint16_t x[4] = {100, 200, 1000, 1003};
+    static const int32_t y[4] = {1000, 500, 100, 400};
+    LUT_TypeDef lut;
+
+    TEST_EQ(LUT_Build(&lut, x, y, 4), 0);
+    TEST_EQ(LUT_Interp(&lut, 0), 1000);
+    TEST_EQ(LUT_Interp(&lut, 100), 1000);
+    TEST_EQ(LUT_Interp(&lut, 150), 750);
+    TEST_EQ(LUT_Interp(&lut, 200), 500);
+    TEST_EQ(LUT_Interp(&lut, 600), 300);
+    TEST_EQ(LUT_Interp(&lut, 1000), 100);
+    TEST_EQ(LUT_Interp(&lut, 1001), 200);
+    TEST_EQ(LUT_Interp(&lut, 1002), 300);
+    TEST_EQ(LUT_Interp(&lut, 1003), 400);
+    TEST_EQ(LUT_Interp(&lut, 65535), 400);
+}
+
+/**
+ * @brief 随机表全横坐标对比参考插值
+ */
+static void Test_Random(void)
+{
+    LUT_TypeDef lut;
+    uint32_t build_fails = 0;
+    uint32_t node_fails = 0;
+    uint32_t err_fails = 0;
+    uint32_t range_fails = 0;
+    double worst = 0.0;
+
+    Test_Seed(28);
+    for (uint32_t t = 0; t < TEST_TABLES; t++)
+    {
+        uint8_t n = Test_RandomTable();
+
+        if (LUT_Build(&lut, s_usX, s_lY, n) != 0)
+        {
+            build_fails++;
+            continue;
+        }
+        for (uint8_t i = 0; i < n; i++)
+        {
+            node_fails += (LUT_Interp(&lut, s_usX[i]) != s_lY[i]);
+        }
+        for (uint32_t v = 0; v <= 0xFFFFU; v++)
+        {
+            int32_t got = LUT_Interp(&lut, (uint16_t)v);
+            double err = fabs(got - Test_RefInterp(s_usX, s_lY, n, (uint16_t)v));
+            int32_t lo = s_lY[0];
+            int32_t hi = s_lY[0];
+
+            if (err > worst)
+            {
+                worst = err;
+            }
+            err_fails += (err >= 1.0);
+
+            /* 结果不超出所在段两端的值 */
+            for (uint8_t i = 1; i < n && s_usX[i - 1] < v; i++)
+            {
+                lo = (s_lY[i - 1] < s_lY[i]) ? s_lY[i - 1] : s_lY[i];
+                hi = (s_lY[i - 1] < s_lY[i]) ? s_lY[i] : s_lY[i - 1];
+            }
+            if (v >= s_usX[n - 1])
+            {
+                lo = hi = s_lY[n - 1];
+            }
+            range_fails += (got < lo || got > hi);
+        }
+    }
+    TEST_EQ(build_fails, 0);
+    TEST_EQ(node_fails, 0);
+    TEST_EQ(err_fails, 0);
+    TEST_EQ(range_fails, 0);
+    printf("[bench] lut: %u tables, worst error %.4f\n", TEST_TABLES, worst);
+}
+
+/**
+ * @brief 插值耗时(满表，随机横坐标)
+ */
+static void Test_Cost(void)
+{
+    static uint16_t v[4096];
+    LUT_TypeDef lut;
+    volatile int32_t sink = 0;
+    uint64_t t0;
+    uint64_t t1;
+
+    Test_Seed(280);
+    for (uint32_t i = 0; i < LUT_MAX_POINTS; i++)
+    {
+        s_usX[i] = (uint16_t)(i * 4000U);
+        s_lY[i] = (int32_t)(LUT_MAX_POINTS - i) * 1000;
+    }
+    TEST_EQ(LUT_Build(&lut, s_usX, s_lY, LUT_MAX_POINTS), 0);
+    for (uint32_t i = 0; i < 4096U; i++)
+    {
+        v[i] = (uint16_t)Test_Rand();
+    }
+
+    t0 = Test_NowNs();
+    for (uint32_t r = 0; r < 256U; r++)
+    {
+        for (uint32_t i = 0; i < 4096U; i++)
+        {
+            sink += LUT_Interp(&lut, v[i]);
+        }
+    }
+    t1 = Test_NowNs();
+    (void)sink;
+    printf("[bench] lut_interp: %.2f ns/call (%d points)\n",
+           (double)(t1 - t0) / (256.0 * 4096.0), LUT_MAX_POINTS);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Build);
+    TEST_RUN(Test_Known);
+    TEST_RUN(Test_Random);
+    TEST_RUN(Test_Cost);
+    return Test_Exit("test_lut");
+}
@@ -0,0 +1,560 @@
+/**
+ * @file test_mempool.c
+ * @brief libx/mempool主机测试: 耗尽与回填、非法释放、守护字与毒化、按大小分组与多线程压力
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 本文件编译两份: test_mempool(默认配置)与test_mempool_guard(MEMPOOL_GUARD=1)，
+ *       守护字与毒化用例只在后者中执行
+ *       压力测试中每个线程随机分配/释放，块内第一个字记录持有者(空闲时为毒化值)，
+ *       同一块被两个线程同时持有即可被发现；池很小，链表头上的CAS竞争充分，
+ *       版本号失效(ABA)会表现为重复分配或结束时空闲链表不完整
+ */
+
+#include "sim_test.h"
+#include "mempool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (MEMPOOL_GUARD == 1)
+#define TEST_NAME "test_mempool_guard"
+#else
+#define TEST_NAME "test_mempool"
+#endif
+
+#define TEST_SIZE 20U             /**< 块大小(非8的倍数，检查对齐填充) */
+#define TEST_COUNT 32U
+#define TEST_THREADS 4U
+#define TEST_STRESS_COUNT 8U      /**< 压力测试池的块数(小于线程持有上限之和) */
+#define TEST_STRESS_HOLD 4U       /**< 每个线程最多同时持有的块数 */
+#define TEST_STRESS_OPS 500000U   /**< 每个线程的操作次数 */
+#define TEST_BENCH_OPS 2000000U
+#define TEST_FREE_WORD 0xDDDDDDDDUL /**< 空闲块第一个字(与MEMPOOL_POISON一致) */
+
+MEMPOOL_STORAGE(static, Test, TEST_SIZE, TEST_COUNT);
+MEMPOOL_STORAGE(static, Small, 16U, 4U);
+MEMPOOL_STORAGE(static, Medium, 64U, 4U);
+MEMPOOL_STORAGE(static, Large, 256U, 2U);
+MEMPOOL_STORAGE(static, Stress, 16U, TEST_STRESS_COUNT);
+
+static MemPool_TypeDef s_xPool;
+static MemPool_TypeDef s_xSmall;
+static MemPool_TypeDef s_xMedium;
+static MemPool_TypeDef s_xLarge;
+static MemPool_TypeDef s_xStress;
+
+typedef struct
+{
+    uint32_t id;
+    uint64_t allocs;
+    uint64_t fails;
+    uint64_t dup;       /**< 分配到别的线程仍持有的块 */
+    uint64_t stolen;    /**< 持有期间块被别人改写 */
+    uint64_t errors;    /**< MemPool_Free返回非MEMPOOL_OK */
+} Test_Worker_TypeDef;
+
+/**
+ * @brief 重新初始化单池并检查
+ */
+static void Test_InitPool(void)
+{
+    TEST_EQ(MEMPOOL_INIT(&s_xPool, Test, TEST_SIZE, TEST_COUNT), 0);
+}
+
+/**
+ * @brief 块号(由地址反推)
+ */
+static uint32_t Test_Index(const MemPool_TypeDef *p, const void *blk)
+{
+    return (uint32_t)(((const uint8_t *)blk - p->mem) / p->stride);
+}
+
+/**
+ * @brief 初始化参数校验
+ */
+static void Test_Init(void)
+{
+    uint16_t next[4];
+    MemPool_Stats_TypeDef st;
+
+    TEST_EQ(MemPool_Init(NULL, s_xTestPoolMem, s_usTestPoolNext, TEST_SIZE, TEST_COUNT), -1);
+    TEST_EQ(MemPool_Init(&s_xPool, NULL, s_usTestPoolNext, TEST_SIZE, TEST_COUNT), -1);
+    TEST_EQ(MemPool_Init(&s_xPool, s_xTestPoolMem, NULL, TEST_SIZE, TEST_COUNT), -1);
+    TEST_EQ(MemPool_Init(&s_xPool, s_xTestPoolMem, s_usTestPoolNext, 0, TEST_COUNT), -1);
+    TEST_EQ(MemPool_Init(&s_xPool, s_xTestPoolMem, s_usTestPoolNext, TEST_SIZE, 0), -1);
+    TEST_EQ(MemPool_Init(&s_xPool, s_xTestPoolMem, next, TEST_SIZE, MEMPOOL_MAX_BLOCKS + 1U), -1);
+    /* 存储未按MEMPOOL_ALIGN对齐 */
+    TEST_EQ(MemPool_Init(&s_xPool, (uint8_t *)s_xTestPoolMem + 4, s_usTestPoolNext, TEST_SIZE, 4), -1);
+
+    Test_InitPool();
+    TEST_EQ(s_xPool.stride, MEMPOOL_STRIDE(TEST_SIZE));
+    TEST_EQ(s_xPool.stride % MEMPOOL_ALIGN, 0);
+    TEST_CHECK(s_xPool.stride >= TEST_SIZE + 2U * MEMPOOL_GUARD_BYTES);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.size, TEST_SIZE);
+    TEST_EQ(st.count, TEST_COUNT);
+    TEST_EQ(st.used, 0);
+    TEST_EQ(st.high_water, 0);
+    TEST_EQ(st.allocs, 0);
+    TEST_EQ(st.fails, 0);
+    TEST_EQ(st.errors, 0);
+}
+
+/**
+ * @brief 耗尽与回填: 每块恰好分配一次，释放后全部可再分配
+ */
+static void Test_Exhaust(void)
+{
+    void *blk[TEST_COUNT];
+    uint32_t seen[TEST_COUNT];
+    MemPool_Stats_TypeDef st;
+
+    Test_InitPool();
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        blk[i] = MemPool_Alloc(&s_xPool);
+        TEST_CHECK(blk[i] != NULL);
+        TEST_EQ((uintptr_t)blk[i] % MEMPOOL_ALIGN, 0);
+        TEST_CHECK(MemPool_Owns(&s_xPool, blk[i]));
+        /* 初始链表按地址顺序 */
+        TEST_EQ(Test_Index(&s_xPool, blk[i]), i);
+        seen[Test_Index(&s_xPool, blk[i])]++;
+        /* 写满用户区不影响其他块 */
+        memset(blk[i], (int)i, TEST_SIZE);
+    }
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        TEST_EQ(seen[i], 1);
+        TEST_EQ(((uint8_t *)blk[i])[0], i);
+        TEST_EQ(((uint8_t *)blk[i])[TEST_SIZE - 1U], i);
+    }
+
+    /* 池空 */
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == NULL);
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == NULL);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.used, TEST_COUNT);
+    TEST_EQ(st.high_water, TEST_COUNT);
+    TEST_EQ(st.allocs, TEST_COUNT);
+    TEST_EQ(st.fails, 2);
+
+    /* 释放一块后恰好能再分配到这一块(后进先出) */
+    TEST_EQ(MemPool_Free(&s_xPool, blk[5]), MEMPOOL_OK);
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == blk[5]);
+
+    /* 乱序全部释放，再全部分配回来 */
+    Test_Seed(42);
+    for (uint32_t i = TEST_COUNT - 1U; i > 0; i--)
+    {
+        uint32_t j = Test_RandBelow(i + 1U);
+        void *t = blk[i];
+
+        blk[i] = blk[j];
+        blk[j] = t;
+    }
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        TEST_EQ(MemPool_Free(&s_xPool, blk[i]), MEMPOOL_OK);
+    }
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.used, 0);
+    TEST_EQ(st.high_water, TEST_COUNT);
+    TEST_EQ(st.errors, 0);
+
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        void *b = MemPool_Alloc(&s_xPool);
+
+        TEST_CHECK(b != NULL);
+        if (b != NULL)
+        {
+            seen[Test_Index(&s_xPool, b)]++;
+        }
+    }
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        TEST_EQ(seen[i], 1);
+    }
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == NULL);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.allocs, 2U * TEST_COUNT + 1U);
+    TEST_EQ(st.fails, 3);
+    TEST_EQ(st.errors, 0);
+}
+
+/**
+ * @brief 重复释放、正在释放与非法指针
+ */
+static void Test_BadFree(void)
+{
+    static uint64_t foreign[4];
+    uint8_t *a;
+    uint8_t *b;
+    uint32_t idx;
+    MemPool_Stats_TypeDef st;
+
+    Test_InitPool();
+    a = (uint8_t *)MemPool_Alloc(&s_xPool);
+    b = (uint8_t *)MemPool_Alloc(&s_xPool);
+
+    /* NULL不算错误 */
+    TEST_EQ(MemPool_Free(&s_xPool, NULL), MEMPOOL_OK);
+
+    /* 重复释放: next项已不是MEMPOOL_BUSY，计数不变 */
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_OK);
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_ERR_DOUBLE);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.used, 1);
+    TEST_EQ(st.errors, 1);
+
+    /* 从未分配过的块(仍在空闲链表中) */
+    TEST_EQ(MemPool_Free(&s_xPool, s_xPool.mem + (TEST_COUNT - 1U) * s_xPool.stride + MEMPOOL_GUARD_BYTES),
+            MEMPOOL_ERR_DOUBLE);
+
+    /* 另一处正在释放同一块(MEMPOOL_FREEING)时后到者失败 */
+    idx = Test_Index(&s_xPool, b);
+    TEST_EQ(s_xPool.next[idx], MEMPOOL_BUSY);
+    s_xPool.next[idx] = MEMPOOL_FREEING;
+    TEST_EQ(MemPool_Free(&s_xPool, b), MEMPOOL_ERR_DOUBLE);
+    s_xPool.next[idx] = MEMPOOL_BUSY;
+    TEST_EQ(MemPool_Free(&s_xPool, b), MEMPOOL_OK);
+
+    /* 池外、块内偏移、块间守护区 */
+    TEST_EQ(MemPool_Free(&s_xPool, foreign), MEMPOOL_ERR_PTR);
+    TEST_EQ(MemPool_Free(&s_xPool, s_xPool.mem + (uint32_t)s_xPool.stride * TEST_COUNT),
+            MEMPOOL_ERR_PTR);
+    TEST_EQ(MemPool_Free(&s_xPool, a + 1), MEMPOOL_ERR_PTR);
+    TEST_EQ(MemPool_Free(&s_xPool, a + MEMPOOL_ALIGN), MEMPOOL_ERR_PTR);
+    TEST_CHECK(!MemPool_Owns(&s_xPool, foreign));
+
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.used, 0);
+    TEST_EQ(st.errors, 7);
+
+    /* 非法释放不破坏空闲链表 */
+    for (uint32_t i = 0; i < TEST_COUNT; i++)
+    {
+        TEST_CHECK(MemPool_Alloc(&s_xPool) != NULL);
+    }
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == NULL);
+}
+
+#if (MEMPOOL_GUARD == 1)
+/**
+ * @brief 守护字: 前后越界写在释放时发现，块仍正常归还
+ */
+static void Test_Guard(void)
+{
+    uint8_t *a;
+    MemPool_Stats_TypeDef st;
+
+    Test_InitPool();
+
+    /* 前越界 */
+    a = (uint8_t *)MemPool_Alloc(&s_xPool);
+    a[-1] = 0;
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_ERR_GUARD);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.used, 0);
+    TEST_EQ(st.errors, 1);
+
+    /* 归还时守护字已重写，再分配/释放正常 */
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == a);
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_OK);
+
+    /* 后越界: 对齐后用户区末尾之后的第一个字节 */
+    a = (uint8_t *)MemPool_Alloc(&s_xPool);
+    a[s_xPool.stride - 2U * MEMPOOL_GUARD_BYTES] ^= 0xFFU;
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_ERR_GUARD);
+
+    /* 对齐填充区(size之后、守护字之前)不属于守护字 */
+    a = (uint8_t *)MemPool_Alloc(&s_xPool);
+    a[TEST_SIZE] = 0;
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_OK);
+
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.errors, 2);
+    TEST_EQ(st.used, 0);
+}
+
+/**
+ * @brief 毒化: 空闲块填充毒化值，释放后写在下次分配时发现
+ */
+static void Test_Poison(void)
+{
+    uint8_t *a;
+    uint32_t bad = 0;
+    MemPool_Stats_TypeDef st;
+
+    Test_InitPool();
+    a = (uint8_t *)MemPool_Alloc(&s_xPool);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.errors, 0);
+
+    memset(a, 0x11, TEST_SIZE);
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_OK);
+    for (uint32_t i = 0; i < s_xPool.stride - 2U * MEMPOOL_GUARD_BYTES; i++)
+    {
+        bad += (a[i] != MEMPOOL_POISON);
+    }
+    TEST_EQ(bad, 0);
+
+    /* 释放后写 */
+    a[3] = 0x55;
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == a);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.errors, 1);
+    TEST_EQ(MemPool_Free(&s_xPool, a), MEMPOOL_OK);
+
+    /* 释放时重新毒化，下次分配不再报错 */
+    TEST_CHECK(MemPool_Alloc(&s_xPool) == a);
+    MemPool_GetStats(&s_xPool, &st);
+    TEST_EQ(st.errors, 1);
+}
+#endif
+
+/**
+ * @brief 按大小分组: 选最小可容纳的池，满时退到更大的池，释放回到所属池
+ */
+static void Test_Set(void)
+{
+    MemPool_TypeDef *const pools[3] = {&s_xSmall, &s_xMedium, &s_xLarge};
+    static uint64_t foreign[4];
+    void *s[4];
+    void *m[4];
+    void *p;
+
+    TEST_EQ(MEMPOOL_INIT(&s_xSmall, Small, 16U, 4U), 0);
+    TEST_EQ(MEMPOOL_INIT(&s_xMedium, Medium, 64U, 4U), 0);
+    TEST_EQ(MEMPOOL_INIT(&s_xLarge, Large, 256U, 2U), 0);
+
+    /* 按大小选池 */
+    p = MemPool_SetAlloc(pools, 3, 1);
+    TEST_CHECK(MemPool_Owns(&s_xSmall, p));
+    TEST_EQ(MemPool_SetFree(pools, 3, p), MEMPOOL_OK);
+    p = MemPool_SetAlloc(pools, 3, 16);
+    TEST_CHECK(MemPool_Owns(&s_xSmall, p));
+    TEST_EQ(MemPool_SetFree(pools, 3, p), MEMPOOL_OK);
+    p = MemPool_SetAlloc(pools, 3, 17);
+    TEST_CHECK(MemPool_Owns(&s_xMedium, p));
+    TEST_EQ(MemPool_SetFree(pools, 3, p), MEMPOOL_OK);
+    p = MemPool_SetAlloc(pools, 3, 256);
+    TEST_CHECK(MemPool_Owns(&s_xLarge, p));
+    TEST_EQ(MemPool_SetFree(pools, 3, p), MEMPOOL_OK);
+    TEST_CHECK(MemPool_SetAlloc(pools, 3, 257) == NULL);
+
+    /* 小池用尽后退到中池 */
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        s[i] = MemPool_SetAlloc(pools, 3, 8);
+        TEST_CHECK(MemPool_Owns(&s_xSmall, s[i]));
+    }
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        m[i] = MemPool_SetAlloc(pools, 3, 8);
+        TEST_CHECK(MemPool_Owns(&s_xMedium, m[i]));
+    }
+    p = MemPool_SetAlloc(pools, 3, 8);
+    TEST_CHECK(MemPool_Owns(&s_xLarge, p));
+    TEST_EQ(s_xSmall.fails, 5);
+    TEST_EQ(s_xMedium.fails, 1);
+
+    /* 释放按地址回到各自的池 */
+    TEST_EQ(MemPool_SetFree(pools, 3, m[2]), MEMPOOL_OK);
+    TEST_EQ(s_xMedium.used, 3);
+    TEST_EQ(s_xSmall.used, 4);
+    TEST_EQ(MemPool_SetFree(pools, 3, s[1]), MEMPOOL_OK);
+    TEST_EQ(s_xSmall.used, 3);
+    TEST_EQ(MemPool_SetFree(pools, 3, p), MEMPOOL_OK);
+    TEST_EQ(s_xLarge.used, 0);
+
+    /* 重复释放的错误记在所属池；不属于任何池时不计入任何池 */
+    TEST_EQ(MemPool_SetFree(pools, 3, m[2]), MEMPOOL_ERR_DOUBLE);
+    TEST_EQ(s_xMedium.errors, 1);
+    TEST_EQ(MemPool_SetFree(pools, 3, foreign), MEMPOOL_ERR_PTR);
+    TEST_EQ(MemPool_SetFree(pools, 3, NULL), MEMPOOL_OK);
+    TEST_EQ(s_xSmall.errors + s_xMedium.errors + s_xLarge.errors, 1);
+
+    /* 块内偏移由所属池判为非法 */
+    TEST_EQ(MemPool_SetFree(pools, 3, (uint8_t *)s[0] + 4), MEMPOOL_ERR_PTR);
+    TEST_EQ(s_xSmall.errors, 1);
+
+    /* 小池刚释放的块优先于更大的池 */
+    TEST_CHECK(MemPool_SetAlloc(pools, 3, 8) == s[1]);
+}
+
+static void *Test_Worker(void *arg)
+{
+    Test_Worker_TypeDef *w = (Test_Worker_TypeDef *)arg;
+    uint32_t *held[TEST_STRESS_HOLD];
+    uint32_t n = 0;
+    uint32_t stamp = w->id + 1U;
+    uint32_t rnd = w->id * 2654435761U + 1U;
+
+    for (uint32_t k = 0; k < TEST_STRESS_OPS; k++)
+    {
+        rnd = rnd * 1664525U + 1013904223U;
+        if (n < TEST_STRESS_HOLD && (n == 0 || (rnd >> 31) != 0))
+        {
+            uint32_t *b = (uint32_t *)MemPool_Alloc(&s_xStress);
+
+            if (b == NULL)
+            {
+                w->fails++;
+                continue;
+            }
+            w->allocs++;
+            /* 空闲块第一个字为毒化值，否则说明另一线程仍持有 */
+            if (__atomic_exchange_n(b, stamp, __ATOMIC_RELAXED) != TEST_FREE_WORD)
+            {
+                w->dup++;
+            }
+            held[n++] = b;
+        }
+        else
+        {
+            uint32_t i = (rnd >> 8) % n;
+            uint32_t *b = held[i];
+
+            if (__atomic_exchange_n(b, TEST_FREE_WORD, __ATOMIC_RELAXED) != stamp)
+            {
+                w->stolen++;
+            }
+            held[i] = held[--n];
+            if (MemPool_Free(&s_xStress, b) != MEMPOOL_OK)
+            {
+                w->errors++;
+            }
+        }
+    }
+
+    while (n > 0)
+    {
+        uint32_t *b = held[--n];
+
+        if (__atomic_exchange_n(b, TEST_FREE_WORD, __ATOMIC_RELAXED) != stamp)
+        {
+            w->stolen++;
+        }
+        if (MemPool_Free(&s_xStress, b) != MEMPOOL_OK)
+        {
+            w->errors++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 多线程分配/释放: 无重复分配，结束时计数归零且每块都能再分配
+ */
+static void Test_Stress(void)
+{
+    pthread_t th[TEST_THREADS];
+    Test_Worker_TypeDef w[TEST_THREADS];
+    uint32_t seen[TEST_STRESS_COUNT];
+    uint64_t allocs = 0;
+    uint64_t fails = 0;
+    MemPool_Stats_TypeDef st;
+
+    memset(s_xStressPoolMem, MEMPOOL_POISON, sizeof(s_xStressPoolMem));
+    TEST_EQ(MEMPOOL_INIT(&s_xStress, Stress, 16U, TEST_STRESS_COUNT), 0);
+    memset(w, 0, sizeof(w));
+
+    for (uint32_t i = 0; i < TEST_THREADS; i++)
+    {
+        w[i].id = i;
+        TEST_EQ(pthread_create(&th[i], NULL, Test_Worker, &w[i]), 0);
+    }
+    for (uint32_t i = 0; i < TEST_THREADS; i++)
+    {
+        pthread_join(th[i], NULL);
+        TEST_EQ(w[i].dup, 0);
+        TEST_EQ(w[i].stolen, 0);
+        TEST_EQ(w[i].errors, 0);
+        allocs += w[i].allocs;
+        fails += w[i].fails;
+    }
+
+    MemPool_GetStats(&s_xStress, &st);
+    TEST_EQ(st.used, 0);
+    TEST_EQ(st.allocs, (uint32_t)allocs);
+    TEST_EQ(st.fails, (uint32_t)fails);
+    TEST_EQ(st.errors, 0);
+    TEST_CHECK(st.high_water <= TEST_STRESS_COUNT);
+
+    /* 空闲链表完整: 每块恰好能再分配一次 */
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t i = 0; i < TEST_STRESS_COUNT; i++)
+    {
+        void *b = MemPool_Alloc(&s_xStress);
+
+        TEST_CHECK(b != NULL);
+        if (b != NULL)
+        {
+            seen[Test_Index(&s_xStress, b)]++;
+        }
+    }
+    for (uint32_t i = 0; i < TEST_STRESS_COUNT; i++)
+    {
+        TEST_EQ(seen[i], 1);
+    }
+    TEST_CHECK(MemPool_Alloc(&s_xStress) == NULL);
+
+    printf("[bench] mempool_stress: %llu allocs, %llu empty, high water %u/%u\n",
+           (unsigned long long)allocs, (unsigned long long)fails,
+           (unsigned)st.high_water, TEST_STRESS_COUNT);
+}
+
+/**
+ * @brief 单线程分配+释放一对的开销(对比malloc/free)
+ */
+static void Test_Cost(void)
+{
+    uint64_t t0;
+    uint64_t pool_ns;
+    uint64_t heap_ns;
+    uint32_t fails = 0;
+
+    Test_InitPool();
+
+    t0 = Test_NowNs();
+    for (uint32_t k = 0; k < TEST_BENCH_OPS; k++)
+    {
+        void *b = MemPool_Alloc(&s_xPool);
+
+        fails += (MemPool_Free(&s_xPool, b) != MEMPOOL_OK);
+    }
+    pool_ns = Test_NowNs() - t0;
+
+    t0 = Test_NowNs();
+    for (uint32_t k = 0; k < TEST_BENCH_OPS; k++)
+    {
+        void *volatile b = malloc(TEST_SIZE);
+
+        free(b);
+    }
+    heap_ns = Test_NowNs() - t0;
+
+    TEST_EQ(fails, 0);
+    printf("[bench] mempool_pair: %.1f ns, malloc_pair: %.1f ns (%u-byte block)\n",
+           (double)pool_ns / TEST_BENCH_OPS, (double)heap_ns / TEST_BENCH_OPS, TEST_SIZE);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_Exhaust);
+    TEST_RUN(Test_BadFree);
+#if (MEMPOOL_GUARD == 1)
+    TEST_RUN(Test_Guard);
+    TEST_RUN(Test_Poison);
+#endif
+    TEST_RUN(Test_Set);
+    TEST_RUN(Test_Stress);
+    TEST_RUN(Test_Cost);
+    return Test_Exit(TEST_NAME);
+}
@@ -0,0 +1,294 @@
+/**
+ * @file test_pll.c
+ * @brief libx/pll主机测试: 4~26MHz输入 x 0.5MHz网格与随机目标频率，按RM0090的约束逐项检查
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每个输入时钟先穷举全部M/N/P组合，得到可达的系统时钟集合(及该频率下48MHz域能否恰好为48MHz)，
+ *       Pll_Solve的结果须满足:
+ *       - 寄存器取值与VCO输入/输出、48MHz域、系统时钟上限等器件约束
+ *       - 频率为不超过目标的最大可达值，恰好等于目标时返回0；没有可达值时返回-1
+ *       - 同频率下有48MHz域恰好为48MHz的组合时选中它
+ *       - Flash等待周期、调压器等级、过驱动与APB分频满足各自上限且分频最小
+ */
+
+#include "sim_test.h"
+#include "pll.h"
+
+#include <stdlib.h>
+
+#define TEST_SRC_MIN 4000000UL
+#define TEST_SRC_MAX 26000000UL
+#define TEST_REACH_MAX 8192U
+
+typedef struct
+{
+    uint32_t hz;
+    uint8_t usb48;
+} Test_Reach_TypeDef;
+
+static Test_Reach_TypeDef s_xReach[TEST_REACH_MAX];
+static uint32_t s_ulReach;
+
+static int Test_ReachCmp(const void *a, const void *b)
+{
+    uint32_t x = ((const Test_Reach_TypeDef *)a)->hz;
+    uint32_t y = ((const Test_Reach_TypeDef *)b)->hz;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 穷举一个输入时钟的全部合法组合(VCO输入与系统时钟都取整数Hz，与求解器相同)
+ */
+static void Test_Enumerate(uint32_t src)
+{
+    static const uint32_t p_tab[4] = {2, 4, 6, 8};
+    uint32_t n_out = 0;
+
+    s_ulReach = 0;
+    for (uint32_t m = 2; m <= 63U; m++)
+    {
+        uint32_t vin = src / m;
+
+        if (src % m != 0 || vin < PLL_VCO_IN_MIN || vin > PLL_VCO_IN_MAX)
+        {
+            continue;
+        }
+        for (uint32_t n = 50; n <= 432U; n++)
+        {
+            uint64_t vco = (uint64_t)vin * n;
+            uint32_t q;
+
+            if (vco < PLL_VCO_OUT_MIN || vco > PLL_VCO_OUT_MAX)
+            {
+                continue;
+            }
+            q = (uint32_t)((vco + PLL_USB_HZ - 1U) / PLL_USB_HZ);
+            q = (q < 2U) ? 2U : q;
+            if (q > 15U)
+            {
+                continue;
+            }
+            for (uint32_t i = 0; i < 4U; i++)
+            {
+                uint32_t hz = (uint32_t)(vco / p_tab[i]);
+
+                if (vco % p_tab[i] != 0 || hz > PLL_SYSCLK_MAX || s_ulReach >= TEST_REACH_MAX)
+                {
+                    continue;
+                }
+                s_xReach[s_ulReach].hz = hz;
+                s_xReach[s_ulReach].usb48 = (vco % PLL_USB_HZ == 0 && vco / PLL_USB_HZ >= 2U);
+                s_ulReach++;
+            }
+        }
+    }
+
+    /* 排序后合并同频率的项 */
+    qsort(s_xReach, s_ulReach, sizeof(s_xReach[0]), Test_ReachCmp);
+    for (uint32_t i = 0; i < s_ulReach; i++)
+    {
+        if (n_out != 0 && s_xReach[n_out - 1U].hz == s_xReach[i].hz)
+        {
+            s_xReach[n_out - 1U].usb48 |= s_xReach[i].usb48;
+        }
+        else
+        {
+            s_xReach[n_out++] = s_xReach[i];
+        }
+    }
+    s_ulReach = n_out;
+}
+
+/**
+ * @brief 不超过目标的最大可达频率(NULL=没有)
+ */
+static const Test_Reach_TypeDef *Test_Best(uint32_t target)
+{
+    const Test_Reach_TypeDef *best = NULL;
+
+    for (uint32_t i = 0; i < s_ulReach && s_xReach[i].hz <= target; i++)
+    {
+        best = &s_xReach[i];
+    }
+    return best;
+}
+
+/**
+ * @brief 总线参数满足上限且分频最小
+ */
+static void Test_CheckBus(const Pll_Config_TypeDef *c, uint32_t hclk)
+{
+    TEST_CHECK(c->latency <= 7U);
+    TEST_CHECK(hclk <= (uint32_t)(c->latency + 1U) * PLL_FLASH_WS_HZ);
+    TEST_CHECK(c->latency == 0U || hclk > (uint32_t)c->latency * PLL_FLASH_WS_HZ);
+
+    TEST_EQ(c->overdrive, hclk > PLL_SYSCLK_NO_OD);
+    /* 调压器: 等级3 <= 120MHz，等级2 <= 144MHz，更高用等级1 */
+    TEST_CHECK(c->vos >= 1U && c->vos <= 3U);
+    TEST_CHECK(c->vos != 3U || hclk <= 120000000UL);
+    TEST_CHECK(c->vos != 2U || hclk <= 144000000UL);
+    TEST_CHECK(c->vos == 3U || hclk > ((c->vos == 2U) ? 120000000UL : 144000000UL));
+
+    TEST_CHECK(hclk / c->apb1_div <= PLL_APB1_MAX);
+    TEST_CHECK(c->apb1_div == 1U || hclk / (c->apb1_div / 2U) > PLL_APB1_MAX);
+    TEST_CHECK(hclk / c->apb2_div <= PLL_APB2_MAX);
+    TEST_CHECK(c->apb2_div == 1U || hclk / (c->apb2_div / 2U) > PLL_APB2_MAX);
+}
+
+static void Test_CheckPll(const Pll_Config_TypeDef *c, uint32_t src, uint32_t target)
+{
+    uint32_t vin = src / c->m;
+
+    TEST_CHECK(c->m >= 2U && c->m <= 63U);
+    TEST_CHECK(c->n >= 50U && c->n <= 432U);
+    TEST_CHECK(c->p == 2U || c->p == 4U || c->p == 6U || c->p == 8U);
+    TEST_CHECK(c->q >= 2U && c->q <= 15U);
+
+    TEST_EQ(src % c->m, 0);
+    TEST_CHECK(vin >= PLL_VCO_IN_MIN && vin <= PLL_VCO_IN_MAX);
+    TEST_EQ(c->vco_hz, vin * c->n);
+    TEST_CHECK(c->vco_hz >= PLL_VCO_OUT_MIN && c->vco_hz <= PLL_VCO_OUT_MAX);
+    TEST_EQ(c->sysclk_hz, c->vco_hz / c->p);
+    TEST_EQ(c->vco_hz % c->p, 0);
+    TEST_EQ(c->usb_hz, c->vco_hz / c->q);
+    TEST_CHECK(c->usb_hz <= PLL_USB_HZ);
+    TEST_CHECK(c->sysclk_hz <= target && c->sysclk_hz <= PLL_SYSCLK_MAX);
+
+    Test_CheckBus(c, c->sysclk_hz);
+}
+
+/**
+ * @brief 一组(输入, 目标)的检查，返回Pll_Solve的返回值
+ */
+static int Test_One(uint32_t src, uint32_t target)
+{
+    const Test_Reach_TypeDef *best = (target <= PLL_SYSCLK_MAX) ? Test_Best(target) : NULL;
+    Pll_Config_TypeDef cfg;
+    int rc = Pll_Solve(src, target, &cfg);
+
+    if (best == NULL)
+    {
+        TEST_EQ(rc, -1);
+        return rc;
+    }
+    TEST_EQ(rc, (best->hz == target) ? 0 : 1);
+    if (rc >= 0)
+    {
+        Test_CheckPll(&cfg, src, target);
+        TEST_EQ(cfg.sysclk_hz, best->hz);
+        if (best->usb48)
+        {
+            TEST_EQ(cfg.usb_hz, PLL_USB_HZ);
+        }
+    }
+    return rc;
+}
+
+static void Test_Sweep(void)
+{
+    /* 整数MHz的晶振之外再加几个常见的音频/串口晶振 */
+    static const uint32_t odd[] = {8192000UL, 12288000UL, 14745600UL, 24576000UL};
+    uint32_t count[3] = {0, 0, 0};
+    uint32_t src;
+    int rc;
+
+    Test_Seed(49);
+    for (uint32_t k = 0; k <= (TEST_SRC_MAX - TEST_SRC_MIN) / 1000000UL + 4U; k++)
+    {
+        src = (k <= (TEST_SRC_MAX - TEST_SRC_MIN) / 1000000UL)
+                  ? TEST_SRC_MIN + k * 1000000UL
+                  : odd[k - (TEST_SRC_MAX - TEST_SRC_MIN) / 1000000UL - 1U];
+        Test_Enumerate(src);
+
+        /* 0.5MHz网格，再加任意Hz的随机目标(多数不能恰好得到) */
+        for (uint32_t target = 500000UL; target <= PLL_SYSCLK_MAX + 2000000UL; target += 500000UL)
+        {
+            rc = Test_One(src, target);
+            count[rc + 1]++;
+        }
+        for (uint32_t i = 0; i < 2000U; i++)
+        {
+            rc = Test_One(src, 1U + Test_RandBelow(PLL_SYSCLK_MAX + 1000000UL));
+            count[rc + 1]++;
+        }
+    }
+    TEST_CHECK(count[1] != 0 && count[2] != 0 && count[0] != 0);
+    printf("[bench] pll_sweep: %lu exact, %lu nearest, %lu unreachable\n",
+           (unsigned long)count[1], (unsigned long)count[2], (unsigned long)count[0]);
+}
+
+/**
+ * @brief 板上实际使用的组合: HSE 25MHz与HSI 16MHz下的全部档位都能恰好得到
+ */
+static void Test_Profiles(void)
+{
+    static const uint32_t src[2] = {25000000UL, 16000000UL};
+    static const uint32_t hz[4] = {180000000UL, 168000000UL, 84000000UL, 48000000UL};
+    Pll_Config_TypeDef cfg;
+
+    for (uint32_t s = 0; s < 2U; s++)
+    {
+        for (uint32_t i = 0; i < 4U; i++)
+        {
+            TEST_EQ(Pll_Solve(src[s], hz[i], &cfg), 0);
+            Test_CheckPll(&cfg, src[s], hz[i]);
+        }
+    }
+
+    /* 168MHz: 48MHz域恰好为48MHz(USB可用) */
+    TEST_EQ(Pll_Solve(25000000UL, 168000000UL, &cfg), 0);
+    TEST_EQ(cfg.usb_hz, PLL_USB_HZ);
+    TEST_EQ(cfg.latency, 5);
+    TEST_EQ(cfg.overdrive, 0);
+    TEST_EQ(cfg.apb1_div, 4);
+    TEST_EQ(cfg.apb2_div, 2);
+
+    /* 180MHz需要过驱动 */
+    TEST_EQ(Pll_Solve(25000000UL, 180000000UL, &cfg), 0);
+    TEST_EQ(cfg.overdrive, 1);
+    TEST_EQ(cfg.vos, 1);
+}
+
+static void Test_Invalid(void)
+{
+    Pll_Config_TypeDef cfg;
+
+    TEST_EQ(Pll_Solve(25000000UL, 0, &cfg), -1);
+    TEST_EQ(Pll_Solve(25000000UL, PLL_SYSCLK_MAX + 1U, &cfg), -1);
+    TEST_EQ(Pll_Solve(25000000UL, 168000000UL, NULL), -1);
+    /* 分不出1~2MHz的VCO输入 */
+    TEST_EQ(Pll_Solve(1500000UL, 168000000UL, &cfg), -1);
+    /* 低于VCO下限/8 */
+    TEST_EQ(Pll_Solve(25000000UL, 12000000UL, &cfg), -1);
+}
+
+/**
+ * @brief 不经过PLL直接运行在HSI/HSE时的总线配置
+ */
+static void Test_BusDirect(void)
+{
+    Pll_Config_TypeDef cfg;
+
+    for (uint32_t hz = 1000000UL; hz <= PLL_SYSCLK_MAX; hz += 250000UL)
+    {
+        Pll_Bus(hz, &cfg);
+        Test_CheckBus(&cfg, hz);
+    }
+
+    Pll_Bus(16000000UL, &cfg);
+    TEST_EQ(cfg.latency, 0);
+    TEST_EQ(cfg.vos, 3);
+    TEST_EQ(cfg.apb1_div, 1);
+    TEST_EQ(cfg.apb2_div, 1);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Sweep);
+    TEST_RUN(Test_Profiles);
+    TEST_RUN(Test_Invalid);
+    TEST_RUN(Test_BusDirect);
+    return Test_Exit("test_pll");
+}
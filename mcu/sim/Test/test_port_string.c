@@ -0,0 +1,241 @@
+/**
+ * @file test_port_string.c
+ * @brief libx/__port_config__内存/字符串函数的一致性测试: 随机长度与对齐，逐字节对比C库
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 每轮随机选一个函数、长度(一半不超过64字节，覆盖头尾处理；其余到2KB)与目的/源偏移，
+ *       在两份内容相同的缓冲上分别执行port与C库实现，比较返回值与整个缓冲(越界写入同样会被发现):
+ *       - memmove在同一缓冲内随机取前向/后向重叠
+ *       - memcmp在随机位置制造差异(含0x80以上的字节，检验按无符号比较)
+ *       - memset/memchr的值超出一个字节时只取低8位
+ *       主机的字长为64位(目标板为32位)，两者共用同一份按WSIZE展开的代码
+ */
+
+#include "sim_test.h"
+#include "__port_config__.h"
+
+#include <string.h>
+
+#define TEST_ROUNDS 200000U
+#define TEST_MAX_LEN 2048U
+#define TEST_PAD 64U            /**< 偏移与重叠的余量 */
+#define TEST_BUF_LEN (TEST_MAX_LEN + 3U * TEST_PAD) /**< 前后余量 + memmove源向后偏移 */
+
+typedef enum
+{
+    TEST_OP_MEMCPY = 0,
+    TEST_OP_MEMMOVE,
+    TEST_OP_MEMSET,
+    TEST_OP_MEMCMP,
+    TEST_OP_MEMCHR,
+    TEST_OP_STRLEN,
+    TEST_OP_NUM
+} Test_Op_t;
+
+static const char *const s_pcOpName[TEST_OP_NUM] = {
+    "memcpy", "memmove", "memset", "memcmp", "memchr", "strlen"};
+
+/* port与C库各一份目的缓冲，源缓冲共用 */
+static uint8_t s_ucPort[TEST_BUF_LEN] __attribute__((aligned(16)));
+static uint8_t s_ucLibc[TEST_BUF_LEN] __attribute__((aligned(16)));
+static uint8_t s_ucSrc[TEST_BUF_LEN] __attribute__((aligned(16)));
+
+static uint32_t s_ulRounds[TEST_OP_NUM];
+static uint32_t s_ulFails[TEST_OP_NUM];
+
+static uint32_t Test_Len(void)
+{
+    return (Test_Rand() & 1U) ? Test_RandBelow(65U) : Test_RandBelow(TEST_MAX_LEN + 1U);
+}
+
+/**
+ * @brief 随机填充(不含0，strlen/memchr的目标字节另外放置)
+ */
+static void Test_Fill(uint8_t *buf)
+{
+    for (uint32_t i = 0; i < TEST_BUF_LEN; i++)
+    {
+        buf[i] = (uint8_t)(1U + Test_RandBelow(255U));
+    }
+}
+
+static int Test_Sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+/**
+ * @brief 执行一轮，返回1=与C库一致
+ */
+static int Test_Round(Test_Op_t op, uint32_t len, uint32_t da, uint32_t sa)
+{
+    uint8_t *p = s_ucPort + TEST_PAD + da;
+    uint8_t *l = s_ucLibc + TEST_PAD + da;
+    const uint8_t *s = s_ucSrc + TEST_PAD + sa;
+    int32_t shift;
+    int c;
+
+    Test_Fill(s_ucPort);
+    memcpy(s_ucLibc, s_ucPort, TEST_BUF_LEN);
+    Test_Fill(s_ucSrc);
+
+    switch (op)
+    {
+    case TEST_OP_MEMCPY:
+        if (_port_memcpy_(p, s, len) != p || memcpy(l, s, len) != l)
+        {
+            return 0;
+        }
+        break;
+
+    case TEST_OP_MEMMOVE:
+        /* 同一缓冲内源相对目的偏移[-PAD, PAD]，覆盖前向/后向重叠与完全重合 */
+        shift = (int32_t)Test_RandBelow(2U * TEST_PAD + 1U) - (int32_t)TEST_PAD;
+        if (_port_memmove_(p, p + shift, len) != p || memmove(l, l + shift, len) != l)
+        {
+            return 0;
+        }
+        break;
+
+    case TEST_OP_MEMSET:
+        c = (int)Test_RandBelow(0x400U) - 0x200;
+        if (_port_memset_(p, c, len) != p || memset(l, c, len) != l)
+        {
+            return 0;
+        }
+        break;
+
+    case TEST_OP_MEMCMP:
+        /* 与源相同，随机在一个位置制造差异(或完全相同) */
+        memcpy(p, s, len);
+        if (len != 0 && (Test_Rand() & 3U) != 0)
+        {
+            p[Test_RandBelow(len)] = (uint8_t)Test_Rand();
+        }
+        memcpy(l, p, len);
+        if (Test_Sign(_port_memcmp_(p, s, len)) != Test_Sign(memcmp(l, s, len)))
+        {
+            return 0;
+        }
+        break;
+
+    case TEST_OP_MEMCHR:
+        /* 目标字节出现0~2次，查找值可能超出一个字节 */
+        c = (int)(Test_Rand() & 0x3FFU);
+        for (uint32_t k = Test_RandBelow(3U); k != 0 && len != 0; k--)
+        {
+            uint32_t at = Test_RandBelow(len + 8U);
+
+            p[at] = (uint8_t)c;
+            l[at] = (uint8_t)c;
+        }
+        {
+            const uint8_t *rp = (const uint8_t *)_port_memchr_(p, c, len);
+            const uint8_t *rl = (const uint8_t *)memchr(l, c, len);
+
+            if ((rp == NULL) != (rl == NULL) || (rp != NULL && rp - p != rl - l))
+            {
+                return 0;
+            }
+        }
+        break;
+
+    default:
+        p[len] = 0U;
+        l[len] = 0U;
+        if (_port_strlen_((const char *)p) != strlen((const char *)l))
+        {
+            return 0;
+        }
+        break;
+    }
+
+    return memcmp(s_ucPort, s_ucLibc, TEST_BUF_LEN) == 0;
+}
+
+static void Test_Random(void)
+{
+    Test_Seed(45);
+    for (uint32_t r = 0; r < TEST_ROUNDS; r++)
+    {
+        Test_Op_t op = (Test_Op_t)Test_RandBelow(TEST_OP_NUM);
+        uint32_t len = Test_Len();
+        uint32_t da = Test_RandBelow(16U);
+        uint32_t sa = Test_RandBelow(16U);
+
+        s_ulRounds[op]++;
+        if (!Test_Round(op, len, da, sa))
+        {
+            if (s_ulFails[op]++ < 5U)
+            {
+                printf("mismatch: %s len %lu da %lu sa %lu (round %lu)\n", s_pcOpName[op],
+                       (unsigned long)len, (unsigned long)da, (unsigned long)sa, (unsigned long)r);
+            }
+        }
+    }
+
+    for (uint32_t op = 0; op < TEST_OP_NUM; op++)
+    {
+        TEST_EQ(s_ulFails[op], 0);
+        TEST_CHECK(s_ulRounds[op] != 0);
+        printf("[bench] %s: %lu rounds\n", s_pcOpName[op], (unsigned long)s_ulRounds[op]);
+    }
+}
+
+/**
+ * @brief 边界: 每个函数在全部长度0..3*字长 x 全部字内偏移上穷举
+ */
+static void Test_Edges(void)
+{
+    uint32_t fails = 0;
+
+    Test_Seed(450);
+    for (uint32_t op = 0; op < TEST_OP_NUM; op++)
+    {
+        for (uint32_t len = 0; len <= 3U * sizeof(long); len++)
+        {
+            for (uint32_t da = 0; da < sizeof(long); da++)
+            {
+                for (uint32_t sa = 0; sa < sizeof(long); sa++)
+                {
+                    fails += !Test_Round((Test_Op_t)op, len, da, sa);
+                }
+            }
+        }
+    }
+    TEST_EQ(fails, 0);
+}
+
+/**
+ * @brief memmove的全部重叠距离(固定长度，源在目的前后各一个窗口)
+ */
+static void Test_MoveOverlap(void)
+{
+    uint32_t fails = 0;
+
+    Test_Seed(4500);
+    for (uint32_t len = 1; len <= 200U; len += 7U)
+    {
+        for (int32_t shift = -(int32_t)TEST_PAD; shift <= (int32_t)TEST_PAD; shift++)
+        {
+            uint8_t *p = s_ucPort + TEST_PAD;
+            uint8_t *l = s_ucLibc + TEST_PAD;
+
+            Test_Fill(s_ucPort);
+            memcpy(s_ucLibc, s_ucPort, TEST_BUF_LEN);
+            (void)_port_memmove_(p, p + shift, len);
+            (void)memmove(l, l + shift, len);
+            fails += (memcmp(s_ucPort, s_ucLibc, TEST_BUF_LEN) != 0);
+        }
+    }
+    TEST_EQ(fails, 0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Edges);
+    TEST_RUN(Test_MoveOverlap);
+    TEST_RUN(Test_Random);
+    return Test_Exit("test_port_string");
+}
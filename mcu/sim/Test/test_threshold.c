@@ -0,0 +1,304 @@
+/**
+ * @file test_threshold.c
+ * @brief libx/threshold主机测试: 布防、钳位、触发、越界判断、迟滞确认与光照任务的防尖峰流程
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 流程测试按task_light的事件模式逐次唤醒复现: 读取CIC输出，看门狗唤醒且越界时重填
+ *       中值+IIR，滤波后Settle并围绕新电平重新布防；参数与task_light.h保持一致
+ */
+
+#include "sim_test.h"
+#include "threshold.h"
+#include "filter.h"
+
+#define TEST_HALF_WIDTH 64   /**< 同TASK_LIGHT_AWD_HALF_WIDTH */
+#define TEST_HYSTERESIS 32   /**< 同TASK_LIGHT_AWD_HYSTERESIS */
+#define TEST_MEDIAN_LEN 3    /**< 同TASK_LIGHT_MEDIAN_LEN */
+#define TEST_IIR_ALPHA 16384 /**< 同TASK_LIGHT_IIR_ALPHA */
+#define TEST_ADC_MAX 4095
+
+static Threshold_Band_TypeDef s_xBand;
+static Filter_Median_TypeDef s_xMedian;
+static Filter_IIR_TypeDef s_xIIR;
+
+/**
+ * @brief 检查阈值带上下限
+ */
+static int Test_BandIs(const Threshold_Band_TypeDef *b, uint16_t low, uint16_t high)
+{
+    return b->low == low && b->high == high;
+}
+
+/**
+ * @brief 初始化: 未布防，范围取全量程，迟滞至少为1
+ */
+static void Test_Init(void)
+{
+    Threshold_Band_TypeDef b;
+
+    Threshold_Init(&b, TEST_HALF_WIDTH, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+    TEST_EQ(b.state, THRESH_STATE_IDLE);
+    TEST_CHECK(Test_BandIs(&b, 0, TEST_ADC_MAX));
+    TEST_EQ(b.hysteresis, TEST_HYSTERESIS);
+    TEST_EQ(b.has_report, 0);
+    TEST_EQ(b.triggers, 0);
+    TEST_EQ(b.events, 0);
+
+    /* 未布防时任何采样都不算越界，触发也不计数 */
+    TEST_EQ(Threshold_IsOutside(&b, 0), 0);
+    TEST_EQ(Threshold_IsOutside(&b, 65535), 0);
+    Threshold_Trigger(&b);
+    TEST_EQ(b.state, THRESH_STATE_IDLE);
+    TEST_EQ(b.triggers, 0);
+
+    Threshold_Init(&b, TEST_HALF_WIDTH, 0, 0, TEST_ADC_MAX);
+    TEST_EQ(b.hysteresis, 1);
+}
+
+/**
+ * @brief 布防: 以电平为中心，上下限在量程两端钳位
+ */
+static void Test_Arm(void)
+{
+    Threshold_Band_TypeDef b;
+
+    Threshold_Init(&b, TEST_HALF_WIDTH, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+    Threshold_Arm(&b, 2000);
+    TEST_EQ(b.state, THRESH_STATE_ARMED);
+    TEST_CHECK(Test_BandIs(&b, 1936, 2064));
+
+    /* 带边界本身在带内 */
+    TEST_EQ(Threshold_IsOutside(&b, 1936), 0);
+    TEST_EQ(Threshold_IsOutside(&b, 2064), 0);
+    TEST_EQ(Threshold_IsOutside(&b, 1935), 1);
+    TEST_EQ(Threshold_IsOutside(&b, 2065), 1);
+
+    /* 下限钳位到0(不回绕到65535附近) */
+    Threshold_Arm(&b, 10);
+    TEST_CHECK(Test_BandIs(&b, 0, 74));
+    Threshold_Arm(&b, 0);
+    TEST_CHECK(Test_BandIs(&b, 0, 64));
+    Threshold_Arm(&b, TEST_HALF_WIDTH);
+    TEST_CHECK(Test_BandIs(&b, 0, 128));
+
+    /* 上限钳位到4095 */
+    Threshold_Arm(&b, 4090);
+    TEST_CHECK(Test_BandIs(&b, 4026, TEST_ADC_MAX));
+    Threshold_Arm(&b, TEST_ADC_MAX);
+    TEST_CHECK(Test_BandIs(&b, 4031, TEST_ADC_MAX));
+
+    /* 电平超出量程先钳位再布防 */
+    Threshold_Arm(&b, 60000);
+    TEST_CHECK(Test_BandIs(&b, 4031, TEST_ADC_MAX));
+
+    /* 非零下限: 电平低于下限按下限布防 */
+    Threshold_Init(&b, TEST_HALF_WIDTH, TEST_HYSTERESIS, 100, 4000);
+    Threshold_Arm(&b, 50);
+    TEST_CHECK(Test_BandIs(&b, 100, 164));
+    Threshold_Arm(&b, 3990);
+    TEST_CHECK(Test_BandIs(&b, 3926, 4000));
+
+    /* 半宽大于量程: 两端同时钳位 */
+    Threshold_Init(&b, 60000, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+    Threshold_Arm(&b, 2000);
+    TEST_CHECK(Test_BandIs(&b, 0, TEST_ADC_MAX));
+}
+
+/**
+ * @brief 触发: 只在布防状态下计数一次，直到重新布防
+ */
+static void Test_Trigger(void)
+{
+    Threshold_Band_TypeDef b;
+
+    Threshold_Init(&b, TEST_HALF_WIDTH, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+    Threshold_Arm(&b, 1000);
+    Threshold_Trigger(&b);
+    TEST_EQ(b.state, THRESH_STATE_TRIGGERED);
+    TEST_EQ(b.triggers, 1);
+
+    /* 已触发后重复触发不计数 */
+    Threshold_Trigger(&b);
+    TEST_EQ(b.triggers, 1);
+
+    /* 触发状态下仍按原阈值带判断越界 */
+    TEST_EQ(Threshold_IsOutside(&b, 1000), 0);
+    TEST_EQ(Threshold_IsOutside(&b, 2000), 1);
+
+    Threshold_Arm(&b, 1000);
+    Threshold_Trigger(&b);
+    TEST_EQ(b.triggers, 2);
+}
+
+/**
+ * @brief 确认: 首次上报，迟滞以内不上报但仍围绕新电平重新布防
+ */
+static void Test_Settle(void)
+{
+    Threshold_Band_TypeDef b;
+
+    Threshold_Init(&b, TEST_HALF_WIDTH, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+
+    /* 首次确认无条件上报 */
+    TEST_EQ(Threshold_Settle(&b, 1000), THRESH_EVENT_RISE);
+    TEST_EQ(b.reported, 1000);
+    TEST_EQ(b.state, THRESH_STATE_ARMED);
+    TEST_CHECK(Test_BandIs(&b, 936, 1064));
+
+    /* 迟滞以内: 不上报、上报值不变，但阈值带跟随新电平 */
+    Threshold_Trigger(&b);
+    TEST_EQ(Threshold_Settle(&b, 1020), THRESH_EVENT_NONE);
+    TEST_EQ(b.reported, 1000);
+    TEST_EQ(b.state, THRESH_STATE_ARMED);
+    TEST_CHECK(Test_BandIs(&b, 956, 1084));
+    TEST_EQ(Threshold_Settle(&b, 1031), THRESH_EVENT_NONE);
+    TEST_EQ(Threshold_Settle(&b, 969), THRESH_EVENT_NONE);
+    TEST_CHECK(Test_BandIs(&b, 905, 1033));
+
+    /* 迟滞边界: 相对上报值变化恰好等于迟滞即上报 */
+    TEST_EQ(Threshold_Settle(&b, 1032), THRESH_EVENT_RISE);
+    TEST_EQ(b.reported, 1032);
+    TEST_EQ(Threshold_Settle(&b, 1000), THRESH_EVENT_FALL);
+    TEST_EQ(b.reported, 1000);
+
+    /* 大阶跃 */
+    TEST_EQ(Threshold_Settle(&b, 3000), THRESH_EVENT_RISE);
+    TEST_CHECK(Test_BandIs(&b, 2936, 3064));
+    TEST_EQ(Threshold_Settle(&b, 5), THRESH_EVENT_FALL);
+    TEST_CHECK(Test_BandIs(&b, 0, 69));
+    TEST_EQ(Threshold_Settle(&b, TEST_ADC_MAX), THRESH_EVENT_RISE);
+    TEST_CHECK(Test_BandIs(&b, 4031, TEST_ADC_MAX));
+
+    /* 每次上报计一个事件: 首次 + RISE/FALL 5次 */
+    TEST_EQ(b.events, 6);
+}
+
+/**
+ * @brief 按task_light事件模式处理一次唤醒
+ * @param cic 唤醒时读到的CIC输出
+ * @param notified 1为看门狗唤醒，0为刷新超时唤醒
+ * @return 本次确认的事件
+ */
+static Threshold_Event_t Test_Wake(uint16_t cic, int notified)
+{
+    int16_t v;
+
+    if (notified && Threshold_IsOutside(&s_xBand, cic))
+    {
+        Filter_Median_Reset(&s_xMedian);
+        Filter_IIR_Reset(&s_xIIR);
+    }
+    v = Filter_Median_Update(&s_xMedian, (int16_t)cic);
+    v = Filter_IIR_Update(&s_xIIR, v);
+    return Threshold_Settle(&s_xBand, (uint16_t)v);
+}
+
+/**
+ * @brief 建立稳定在指定电平的流程状态
+ */
+static void Test_PipelineAt(uint16_t level)
+{
+    Threshold_Init(&s_xBand, TEST_HALF_WIDTH, TEST_HYSTERESIS, 0, TEST_ADC_MAX);
+    Filter_Median_Init(&s_xMedian, TEST_MEDIAN_LEN);
+    Filter_IIR_Init(&s_xIIR, TEST_IIR_ALPHA);
+
+    TEST_EQ(Test_Wake(level, 1), THRESH_EVENT_RISE);
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_EQ(Test_Wake(level, 0), THRESH_EVENT_NONE);
+    }
+}
+
+/**
+ * @brief 单个噪声尖峰不确认为阶跃
+ */
+static void Test_Spike(void)
+{
+    /* 原始转换上的尖峰: 看门狗触发，但CIC输出仍在带内，照常滤波 */
+    Test_PipelineAt(1000);
+    Threshold_Trigger(&s_xBand);
+    TEST_EQ(s_xBand.triggers, 1);
+    TEST_EQ(Test_Wake(1040, 1), THRESH_EVENT_NONE);
+    TEST_EQ(s_xBand.reported, 1000);
+    TEST_CHECK(Test_BandIs(&s_xBand, 936, 1064));
+    TEST_EQ(s_xBand.state, THRESH_STATE_ARMED);
+
+    /* 超时唤醒时读到一个越界值: 不重填滤波器，中值滤除 */
+    Test_PipelineAt(1000);
+    TEST_EQ(Test_Wake(3000, 0), THRESH_EVENT_NONE);
+    TEST_EQ(Test_Wake(1000, 0), THRESH_EVENT_NONE);
+    TEST_EQ(s_xBand.reported, 1000);
+    TEST_CHECK(Test_BandIs(&s_xBand, 936, 1064));
+
+    /* 向下的尖峰同样滤除 */
+    Test_PipelineAt(2500);
+    TEST_EQ(Test_Wake(0, 0), THRESH_EVENT_NONE);
+    TEST_EQ(Test_Wake(2500, 0), THRESH_EVENT_NONE);
+    TEST_EQ(s_xBand.reported, 2500);
+    TEST_EQ(s_xBand.events, 1);
+}
+
+/**
+ * @brief 持续阶跃在第一次看门狗唤醒时即确认，并围绕新电平重新布防
+ */
+static void Test_Step(void)
+{
+    Test_PipelineAt(1000);
+    Threshold_Trigger(&s_xBand);
+    TEST_EQ(Test_Wake(2000, 1), THRESH_EVENT_RISE);
+    TEST_EQ(s_xBand.reported, 2000);
+    TEST_CHECK(Test_BandIs(&s_xBand, 1936, 2064));
+
+    /* 新电平保持: 不再上报，阈值带不再移动 */
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_EQ(Test_Wake(2000, 0), THRESH_EVENT_NONE);
+    }
+    TEST_CHECK(Test_BandIs(&s_xBand, 1936, 2064));
+
+    Threshold_Trigger(&s_xBand);
+    TEST_EQ(Test_Wake(100, 1), THRESH_EVENT_FALL);
+    TEST_EQ(s_xBand.reported, 100);
+    TEST_CHECK(Test_BandIs(&s_xBand, 36, 164));
+    TEST_EQ(s_xBand.triggers, 2);
+    TEST_EQ(s_xBand.events, 3);
+}
+
+/**
+ * @brief 随机噪声: 带内噪声叠加孤立尖峰，电平不变时不产生事件
+ */
+static void Test_Noise(void)
+{
+    uint32_t false_events = 0;
+    uint32_t outside = 0;
+
+    Test_Seed(27);
+    Test_PipelineAt(2048);
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        /* 均匀噪声±8，约1%的超时唤醒读到任意值(尖峰间隔至少3次，中值窗口里最多一个) */
+        uint16_t v = (uint16_t)(2048 - 8 + Test_RandBelow(17U));
+
+        if (Test_RandBelow(100U) == 0 && (i % 3U) == 0)
+        {
+            v = (uint16_t)Test_RandBelow(TEST_ADC_MAX + 1U);
+        }
+        false_events += (Test_Wake(v, 0) != THRESH_EVENT_NONE);
+        outside += (s_xBand.low > 2048 || s_xBand.high < 2048);
+    }
+    TEST_EQ(false_events, 0);
+    TEST_EQ(outside, 0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_Arm);
+    TEST_RUN(Test_Trigger);
+    TEST_RUN(Test_Settle);
+    TEST_RUN(Test_Spike);
+    TEST_RUN(Test_Step);
+    TEST_RUN(Test_Noise);
+    return Test_Exit("test_threshold");
+}
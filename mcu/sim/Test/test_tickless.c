@@ -0,0 +1,257 @@
+/**
+ * @file test_tickless.c
+ * @brief libx/tickless主机测试: 模式选择、RTC换算、节拍补偿与SLEEP重装值
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 补偿的关键性质: 休眠时长 + 唤醒后第一个节拍的重装值 = 休眠前剩余计数 + 补齐的节拍数 * 节拍计数，
+ *       即下一个节拍边界始终落在原来的节拍网格上；STOP长时间运行模拟中，
+ *       测量准确时节拍网格误差恒为0，RTC亚秒量化只带来无偏的随机误差
+ */
+
+#include "sim_test.h"
+#include "tickless.h"
+
+#include <math.h>
+
+/* 180MHz内核、1kHz节拍、LSE 32768Hz(同bsp_power.h: 亚秒16384Hz，唤醒定时器2048Hz) */
+#define TEST_CPU_HZ 180000000UL
+#define TEST_CPT (TEST_CPU_HZ / 1000UL)
+#define TEST_SUB_HZ 16384UL
+#define TEST_WUT_HZ 2048UL
+#define TEST_COMP 45UL
+
+static const Tickless_Config_TypeDef s_xCfg = {
+    .tick_hz = 1000,
+    .wut_hz = TEST_WUT_HZ,
+    .sub_hz = TEST_SUB_HZ,
+    .min_stop = 20,
+    .max_stop = 16000,
+};
+
+static void Test_Select(void)
+{
+    TEST_EQ(Tickless_Select(&s_xCfg, 0, 1), TICKLESS_NONE);
+    TEST_EQ(Tickless_Select(&s_xCfg, 1, 1), TICKLESS_NONE);
+    TEST_EQ(Tickless_Select(&s_xCfg, 2, 1), TICKLESS_SLEEP);
+    TEST_EQ(Tickless_Select(&s_xCfg, 19, 1), TICKLESS_SLEEP);
+    TEST_EQ(Tickless_Select(&s_xCfg, 20, 1), TICKLESS_STOP);
+    TEST_EQ(Tickless_Select(&s_xCfg, 20, 0), TICKLESS_SLEEP);
+    TEST_EQ(Tickless_Select(&s_xCfg, 0xFFFFFFFFUL, 0), TICKLESS_SLEEP);
+}
+
+static void Test_WakeupCounts(void)
+{
+    Tickless_Config_TypeDef fast = s_xCfg;
+
+    /* 10ms = 20.48个计数，向下取整 */
+    TEST_EQ(Tickless_WakeupCounts(&s_xCfg, 10), 20);
+    TEST_EQ(Tickless_WakeupCounts(&s_xCfg, 0), 1);
+    TEST_EQ(Tickless_WakeupCounts(&s_xCfg, 16000), 32768);
+    TEST_EQ(Tickless_WakeupCounts(&s_xCfg, 100000), 32768);
+
+    /* 唤醒定时器更快时受16位寄存器限制 */
+    fast.wut_hz = 16384;
+    TEST_EQ(Tickless_WakeupCounts(&fast, 16000), 65536);
+
+    /* 宁可早醒: 计数对应的时间不超过请求的节拍数 */
+    Test_Seed(38);
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        uint32_t ticks = 1U + Test_RandBelow(s_xCfg.max_stop);
+        uint32_t counts = Tickless_WakeupCounts(&s_xCfg, ticks);
+
+        TEST_CHECK((uint64_t)counts * s_xCfg.tick_hz <= (uint64_t)ticks * s_xCfg.wut_hz || counts == 1U);
+        TEST_CHECK((uint64_t)(counts + 1U) * s_xCfg.tick_hz > (uint64_t)ticks * s_xCfg.wut_hz);
+    }
+}
+
+static void Test_SubElapsed(void)
+{
+    const uint32_t top = TEST_SUB_HZ - 1U;
+
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 100, 7, 100, 7), 0);
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 100, top, 100, 0), top);
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 100, 5, 101, 5), TEST_SUB_HZ);
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 100, 0, 101, top), 1);
+
+    /* 跨零点 */
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 86399, 0, 0, top), 1);
+    TEST_EQ(Tickless_SubElapsed(TEST_SUB_HZ, 86399, 3, 2, 3), 3U * TEST_SUB_HZ);
+
+    TEST_EQ(Tickless_SubToCycles(TEST_SUB_HZ, TEST_SUB_HZ, TEST_CPU_HZ), TEST_CPU_HZ);
+    TEST_EQ(Tickless_SubToCycles(TEST_SUB_HZ, 1, TEST_CPU_HZ), TEST_CPU_HZ / TEST_SUB_HZ);
+    TEST_EQ(Tickless_SubToCycles(TEST_SUB_HZ, 16U * TEST_SUB_HZ, TEST_CPU_HZ), 16U * TEST_CPU_HZ);
+}
+
+/**
+ * @brief 补偿的不变量与重装值范围
+ */
+static void Test_Compensate(void)
+{
+    uint32_t reload;
+
+    /* 没有越过节拍边界 */
+    TEST_EQ(Tickless_Compensate(TEST_CPT, 100000, 50000, &reload), 0);
+    TEST_EQ(reload, 50000);
+
+    /* 恰好到达边界: 下一个节拍还有一个完整周期 */
+    TEST_EQ(Tickless_Compensate(TEST_CPT, 100000, 100000, &reload), 1);
+    TEST_EQ(reload, TEST_CPT);
+
+    /* 离下一个节拍不足1/16: 提前计入，第一个节拍延长 */
+    TEST_EQ(Tickless_Compensate(TEST_CPT, 100000, 100000 + TEST_CPT - 10, &reload), 2);
+    TEST_EQ(reload, TEST_CPT + 10);
+
+    Test_Seed(1038);
+    for (uint32_t i = 0; i < 1000000U; i++)
+    {
+        uint32_t remain = 1U + Test_RandBelow(TEST_CPT);
+        uint32_t slept = Test_RandBelow(16000U * TEST_CPT);
+        uint32_t ticks = Tickless_Compensate(TEST_CPT, remain, slept, &reload);
+
+        TEST_CHECK((uint64_t)slept + reload == (uint64_t)remain + (uint64_t)ticks * TEST_CPT);
+        TEST_CHECK(reload >= TEST_CPT / 16U && reload < TEST_CPT + TEST_CPT / 16U);
+        if (s_ulTestFails != 0U)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief STOP长时间运行: 节拍网格误差(下一个节拍的实际时刻 - 理想时刻)
+ *
+ * @param quantize 1=经过时间由RTC快照测得(亚秒量化)，0=准确
+ * @param sleeps 休眠次数
+ * @param worst 输出: 过程中的最大误差(节拍)
+ * @return double 最终误差(节拍)
+ */
+static double Test_StopDrift(int quantize, uint32_t sleeps, double *worst)
+{
+    uint64_t t = 0;
+    uint64_t next = TEST_CPT;
+    uint64_t kticks = 0;
+    uint64_t phase = Test_Rand();
+
+    *worst = 0.0;
+    for (uint32_t i = 0; i < sleeps; i++)
+    {
+        uint32_t remain;
+        uint32_t slept;
+        uint32_t reload;
+        uint64_t d;
+        double err;
+
+        /* 运行一段时间(SysTick正常计数) */
+        t += Test_RandBelow(3U * TEST_CPT);
+        while (t >= next)
+        {
+            kticks++;
+            next += TEST_CPT;
+        }
+
+        /* 休眠20~2000个节拍，RTC亚秒计数与内核时钟不同相位 */
+        remain = (uint32_t)(next - t);
+        d = (uint64_t)(20U + Test_RandBelow(1980U)) * TEST_CPT + Test_RandBelow(TEST_CPT);
+        if (quantize)
+        {
+            uint64_t s0 = ((t + phase) * TEST_SUB_HZ) / TEST_CPU_HZ;
+            uint64_t s1 = ((t + d + phase) * TEST_SUB_HZ) / TEST_CPU_HZ;
+
+            slept = Tickless_SubToCycles(TEST_SUB_HZ, (uint32_t)(s1 - s0), TEST_CPU_HZ);
+        }
+        else
+        {
+            slept = (uint32_t)d;
+        }
+        t += d;
+        kticks += Tickless_Compensate(TEST_CPT, remain, slept, &reload);
+        next = t + reload;
+
+        err = ((double)next - (double)(kticks + 1U) * TEST_CPT) / TEST_CPT;
+        if (fabs(err) > *worst)
+        {
+            *worst = fabs(err);
+        }
+        if (!quantize)
+        {
+            TEST_CHECK(next == (kticks + 1U) * TEST_CPT);
+        }
+    }
+    return ((double)next - (double)(kticks + 1U) * TEST_CPT) / TEST_CPT;
+}
+
+static void Test_StopLongRun(void)
+{
+    const uint32_t sleeps = 200000U;
+    /* 每次量化误差在(-1, 1)个亚秒内且均值为0: 随机游走的5倍标准差 */
+    const double bound = 5.0 * sqrt((double)sleeps / 6.0) * ((double)TEST_CPU_HZ / TEST_SUB_HZ) / TEST_CPT;
+    double worst;
+    double err;
+
+    Test_Seed(2038);
+    err = Test_StopDrift(0, sleeps, &worst);
+    TEST_CHECK(err == 0.0 && worst == 0.0);
+
+    err = Test_StopDrift(1, sleeps, &worst);
+    printf("[bench] stop_drift: %lu sleeps, final %.3f ticks, worst %.3f ticks, bound %.3f\n",
+           (unsigned long)sleeps, err, worst, bound);
+    TEST_CHECK(fabs(err) < bound);
+}
+
+/**
+ * @brief SLEEP路径: 重装值对齐节拍边界，提前唤醒时节拍数与剩余计数互补
+ */
+static void Test_Sleep(void)
+{
+    uint32_t reload;
+    uint32_t full;
+
+    TEST_EQ(Tickless_SleepReload(TEST_CPT, 123, 5, TEST_COMP), 123U + 4U * TEST_CPT - TEST_COMP);
+    TEST_EQ(Tickless_SleepReload(TEST_CPT, 5000, 1, TEST_COMP), 5000U - TEST_COMP);
+    TEST_EQ(Tickless_SleepReload(TEST_CPT, 30, 1, TEST_COMP), 30);
+
+    /* 计满后已从reload重新计数1000 */
+    TEST_EQ(Tickless_SleepExpired(TEST_CPT, 720000, 719000, TEST_COMP), TEST_CPT - 1U - 1000U);
+    /* 异常读数(已计数超过一个节拍或剩余不足补偿)时取一个完整节拍 */
+    TEST_EQ(Tickless_SleepExpired(TEST_CPT, 720000, 720000 - TEST_CPT, TEST_COMP), TEST_CPT - 1U);
+    TEST_EQ(Tickless_SleepExpired(TEST_CPT, 720000, 720000 - TEST_CPT + 20U, TEST_COMP), TEST_CPT - 1U);
+    TEST_EQ(Tickless_SleepExpired(TEST_CPT, 720000, 720000 - (TEST_CPT - 1U - TEST_COMP), TEST_COMP), TEST_COMP);
+
+    /* 提前唤醒: 刚开始就被唤醒，节拍数为0 */
+    full = Tickless_SleepEarly(TEST_CPT, 4, 4U * TEST_CPT - 10U, &reload);
+    TEST_EQ(full, 0);
+    TEST_EQ(reload, TEST_CPT - 10U);
+
+    Test_Seed(3038);
+    for (uint32_t i = 0; i < 1000000U; i++)
+    {
+        uint32_t ticks = 2U + Test_RandBelow(92U);
+        uint32_t cur0 = 1U + Test_RandBelow(TEST_CPT - 1U);
+        uint32_t load = Tickless_SleepReload(TEST_CPT, cur0, ticks, TEST_COMP);
+        uint32_t current = 1U + Test_RandBelow(load);
+        uint32_t done = ticks * TEST_CPT - current;
+
+        TEST_CHECK(load <= 0xFFFFFFUL);
+        full = Tickless_SleepEarly(TEST_CPT, ticks, current, &reload);
+        TEST_CHECK(full < ticks);
+        TEST_CHECK((uint64_t)done + reload == (uint64_t)(full + 1U) * TEST_CPT);
+        TEST_CHECK(reload >= 1U && reload <= TEST_CPT);
+        if (s_ulTestFails != 0U)
+        {
+            break;
+        }
+    }
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Select);
+    TEST_RUN(Test_WakeupCounts);
+    TEST_RUN(Test_SubElapsed);
+    TEST_RUN(Test_Compensate);
+    TEST_RUN(Test_StopLongRun);
+    TEST_RUN(Test_Sleep);
+    return Test_Exit("test_tickless");
+}
@@ -0,0 +1,477 @@
+/**
+ * @file test_trace_ring.c
+ * @brief libx/trace_ring主机测试: 覆盖/停止模式的溢出、冻结、序号回绕与事件编码
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 编码部分按app_trace的做法录制: 64位时间戳只存低32位，高32位变化时插入SYNC，
+ *       SYNC被覆盖时记下它的值作为输出开头的SYNC；再按tools/trace2json.py的解码方法
+ *       (逐行小端解出8个字节，SYNC给出高32位)还原，每个保留事件的64位时间戳须与写入时一致
+ */
+
+#include "sim_test.h"
+#include "trace_ring.h"
+
+#include <string.h>
+
+#define TEST_SYNC 0U            /**< 与APP_TRACE_SYNC相同 */
+#define TEST_MAX_CAP 256U
+#define TEST_ROUNDS 300U        /**< 录制/解码的轮数 */
+#define TEST_BENCH_PUTS 4000000U
+
+static TraceRing_Event_TypeDef s_xBuf[TEST_MAX_CAP];
+
+/**
+ * ============================================================================
+ * 环形缓冲
+ * ============================================================================
+ */
+
+static void Test_Init(void)
+{
+    TraceRing_TypeDef r;
+
+    TEST_EQ(TraceRing_Init(NULL, s_xBuf, 8, TRACE_RING_OVERWRITE), -1);
+    TEST_EQ(TraceRing_Init(&r, NULL, 8, TRACE_RING_OVERWRITE), -1);
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 0, TRACE_RING_OVERWRITE), -1);
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 12, TRACE_RING_OVERWRITE), -1);
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 8, TRACE_RING_OVERWRITE), 0);
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf, 8), 1);
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf, 16), 0);
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf + 1, 8), 0);
+    TEST_EQ(TraceRing_Tail(&r), 0);
+
+    /* 写入不影响有效性，控制块被改写则无效 */
+    for (uint32_t i = 0; i < 20U; i++)
+    {
+        (void)TraceRing_Put(&r, i, 1, 0, 0);
+    }
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf, 8), 1);
+    r.mode = TRACE_RING_STOP;
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf, 8), 0);
+    r.mode = TRACE_RING_OVERWRITE;
+    r.magic ^= 1U;
+    TEST_EQ(TraceRing_IsValid(&r, s_xBuf, 8), 0);
+}
+
+/**
+ * @brief 覆盖模式: 保留最后的容量个事件，落后的游标跳到最旧事件并报告丢失数
+ */
+static void Test_Overwrite(void)
+{
+    TraceRing_TypeDef r;
+    TraceRing_Event_TypeDef out[16];
+    uint32_t cursor = 0;
+    uint32_t lost;
+    uint32_t n;
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 8, TRACE_RING_OVERWRITE), 0);
+    for (uint32_t i = 0; i < 5U; i++)
+    {
+        TEST_EQ(TraceRing_Put(&r, i, 1, (uint8_t)i, (uint16_t)(i * 3U)), 1);
+    }
+    TEST_EQ(TraceRing_Tail(&r), 0);
+    n = TraceRing_Read(&r, &cursor, out, 16, &lost);
+    TEST_EQ(n, 5);
+    TEST_EQ(lost, 0);
+    TEST_EQ(cursor, 5);
+    TEST_EQ(out[4].ts, 4);
+    TEST_EQ(out[4].arg, 12);
+
+    /* 再写15个: 共20个，保留12..19 */
+    for (uint32_t i = 5; i < 20U; i++)
+    {
+        TEST_EQ(TraceRing_Put(&r, i, 1, (uint8_t)i, 0), 1);
+    }
+    TEST_EQ(r.dropped, 0);
+    TEST_EQ(TraceRing_Tail(&r), 12);
+    n = TraceRing_Read(&r, &cursor, out, 16, &lost);
+    TEST_EQ(lost, 7);
+    TEST_EQ(n, 8);
+    TEST_EQ(cursor, 20);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        TEST_EQ(out[i].ts, 12U + i);
+        TEST_EQ(out[i].id, 12U + i);
+    }
+
+    /* 读到头部后没有新事件；分批读出 */
+    TEST_EQ(TraceRing_Read(&r, &cursor, out, 16, &lost), 0);
+    TEST_EQ(lost, 0);
+    (void)TraceRing_Put(&r, 20, 1, 0, 0);
+    (void)TraceRing_Put(&r, 21, 1, 0, 0);
+    (void)TraceRing_Put(&r, 22, 1, 0, 0);
+    TEST_EQ(TraceRing_Read(&r, &cursor, out, 2, NULL), 2);
+    TEST_EQ(out[1].ts, 21);
+    TEST_EQ(TraceRing_Read(&r, &cursor, out, 2, NULL), 1);
+    TEST_EQ(out[0].ts, 22);
+}
+
+/**
+ * @brief 停止模式: 保留最早的容量个事件，其余计入丢弃数
+ */
+static void Test_Stop(void)
+{
+    TraceRing_TypeDef r;
+    TraceRing_Event_TypeDef out[16];
+    TraceRing_Event_TypeDef old;
+    uint32_t cursor = 0;
+    uint32_t lost;
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 8, TRACE_RING_STOP), 0);
+    for (uint32_t i = 0; i < 20U; i++)
+    {
+        TEST_EQ(TraceRing_Put(&r, i, 1, 0, 0), (i < 8U) ? 1 : 0);
+        TEST_EQ(TraceRing_Evicts(&r, &old), 0);
+    }
+    TEST_EQ(r.head, 8);
+    TEST_EQ(r.dropped, 12);
+    TEST_EQ(TraceRing_Tail(&r), 0);
+    TEST_EQ(TraceRing_Read(&r, &cursor, out, 16, &lost), 8);
+    TEST_EQ(lost, 0);
+    TEST_EQ(out[0].ts, 0);
+    TEST_EQ(out[7].ts, 7);
+}
+
+/**
+ * @brief 冻结: 不写入也不覆盖，解冻后恢复
+ */
+static void Test_Freeze(void)
+{
+    TraceRing_TypeDef r;
+    TraceRing_Event_TypeDef out[8];
+    TraceRing_Event_TypeDef old;
+    uint32_t cursor = 0;
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 4, TRACE_RING_OVERWRITE), 0);
+    for (uint32_t i = 0; i < 6U; i++)
+    {
+        (void)TraceRing_Put(&r, i, 1, 0, 0);
+    }
+    TraceRing_Freeze(&r, 1);
+    TEST_EQ(TraceRing_Evicts(&r, &old), 0);
+    TEST_EQ(TraceRing_Put(&r, 100, 1, 0, 0), 0);
+    TEST_EQ(TraceRing_Put(&r, 101, 1, 0, 0), 0);
+    TEST_EQ(r.dropped, 2);
+    TEST_EQ(TraceRing_Read(&r, &cursor, out, 8, NULL), 4);
+    TEST_EQ(out[0].ts, 2);
+    TEST_EQ(out[3].ts, 5);
+
+    TraceRing_Freeze(&r, 0);
+    TEST_EQ(TraceRing_Put(&r, 6, 1, 0, 0), 1);
+    TEST_EQ(TraceRing_Tail(&r), 3);
+}
+
+/**
+ * @brief 下一次写入将覆盖的事件: 写满前没有，写满后为最旧事件
+ */
+static void Test_Evicts(void)
+{
+    TraceRing_TypeDef r;
+    TraceRing_Event_TypeDef old;
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 8, TRACE_RING_OVERWRITE), 0);
+    for (uint32_t i = 0; i < 30U; i++)
+    {
+        int ev = TraceRing_Evicts(&r, &old);
+
+        TEST_EQ(ev, i >= 8U);
+        if (ev)
+        {
+            TEST_EQ(old.ts, TraceRing_Tail(&r));
+            TEST_EQ(old.id, (uint8_t)TraceRing_Tail(&r));
+        }
+        (void)TraceRing_Put(&r, i, 1, (uint8_t)i, 0);
+    }
+}
+
+/**
+ * @brief 绝对序号回绕: 头部越过2^32时尾部、读游标与丢失数仍正确
+ */
+static void Test_HeadWrap(void)
+{
+    TraceRing_TypeDef r;
+    TraceRing_Event_TypeDef out[16];
+    uint32_t cursor;
+    uint32_t lost;
+    uint32_t n;
+
+    TEST_EQ(TraceRing_Init(&r, s_xBuf, 8, TRACE_RING_OVERWRITE), 0);
+    r.head = 0xFFFFFFF8UL;
+    cursor = r.head;
+    for (uint32_t i = 0; i < 20U; i++)
+    {
+        (void)TraceRing_Put(&r, i, 1, 0, 0);
+    }
+    TEST_EQ(r.head, 12);
+    TEST_EQ(TraceRing_Tail(&r), 4);
+    n = TraceRing_Read(&r, &cursor, out, 16, &lost);
+    TEST_EQ(lost, 12);
+    TEST_EQ(n, 8);
+    TEST_EQ(out[0].ts, 12);
+    TEST_EQ(out[7].ts, 19);
+    TEST_EQ(cursor, 12);
+}
+
+/**
+ * ============================================================================
+ * 编码
+ * ============================================================================
+ */
+
+static uint8_t Test_Hex(char c)
+{
+    return (uint8_t)((c <= '9') ? (c - '0') : (c - 'a' + 10));
+}
+
+/**
+ * @brief 与trace2json.py的struct.unpack("<IBBH", ...)相同的解码
+ */
+static int Test_Decode(const char *hex, TraceRing_Event_TypeDef *e)
+{
+    uint8_t b[8];
+
+    if (strlen(hex) != TRACE_RING_HEX_LEN || strspn(hex, "0123456789abcdef") != TRACE_RING_HEX_LEN)
+    {
+        return -1;
+    }
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        b[i] = (uint8_t)((Test_Hex(hex[2U * i]) << 4) | Test_Hex(hex[2U * i + 1U]));
+    }
+    e->ts = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    e->type = b[4];
+    e->id = b[5];
+    e->arg = (uint16_t)(b[6] | (b[7] << 8));
+    return 0;
+}
+
+static void Test_Encode(void)
+{
+    TraceRing_Event_TypeDef e = {0x12345678UL, 0x0E, 0x05, 0xBEEF};
+    TraceRing_Event_TypeDef d;
+    char hex[TRACE_RING_HEX_LEN + 1U];
+
+    TEST_EQ(sizeof(TraceRing_Event_TypeDef), 8);
+
+    TraceRing_Encode(&e, hex);
+    TEST_CHECK(strcmp(hex, "785634120e05efbe") == 0);
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    /* 小端主机上与事件在内存中的8个字节相同(目标板一样) */
+    {
+        const uint8_t *b = (const uint8_t *)&e;
+        char mem[TRACE_RING_HEX_LEN + 1U];
+
+        for (uint32_t i = 0; i < 8U; i++)
+        {
+            snprintf(mem + 2U * i, 3, "%02x", b[i]);
+        }
+        TEST_CHECK(strcmp(hex, mem) == 0);
+    }
+#endif
+
+    /* 随机往返 */
+    Test_Seed(37);
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        e.ts = Test_Rand();
+        e.type = (uint8_t)Test_Rand();
+        e.id = (uint8_t)Test_Rand();
+        e.arg = (uint16_t)Test_Rand();
+        TraceRing_Encode(&e, hex);
+        if (Test_Decode(hex, &d) != 0 || d.ts != e.ts || d.type != e.type || d.id != e.id ||
+            d.arg != e.arg)
+        {
+            TEST_CHECK(0);
+            break;
+        }
+    }
+}
+
+/**
+ * ============================================================================
+ * 录制与还原(与app_trace相同的SYNC规则)
+ * ============================================================================
+ */
+
+typedef struct
+{
+    TraceRing_TypeDef ring;
+    uint32_t ts_high;
+    uint32_t tail_high;
+    uint64_t exp[TEST_MAX_CAP];   /**< 与缓冲同位置的64位时间戳 */
+} Test_Recorder_TypeDef;
+
+static Test_Recorder_TypeDef s_xRec;
+
+static void Test_RecPut(uint64_t ts64, uint32_t ts, uint8_t type, uint8_t id, uint16_t arg)
+{
+    TraceRing_Event_TypeDef old;
+
+    if (TraceRing_Evicts(&s_xRec.ring, &old) && old.type == TEST_SYNC)
+    {
+        s_xRec.tail_high = old.ts;
+    }
+    s_xRec.exp[s_xRec.ring.head & s_xRec.ring.mask] = ts64;
+    (void)TraceRing_Put(&s_xRec.ring, ts, type, id, arg);
+}
+
+static void Test_RecEvent(uint64_t ts, uint8_t type, uint8_t id)
+{
+    uint32_t high = (uint32_t)(ts >> 32);
+
+    if (high != s_xRec.ts_high)
+    {
+        s_xRec.ts_high = high;
+        Test_RecPut(ts, high, TEST_SYNC, 0, 0);
+    }
+    Test_RecPut(ts, (uint32_t)ts, type, id, 0);
+}
+
+/**
+ * @brief 输出开头的SYNC与全部保留事件，按trace2json.py的timeline还原并逐个核对
+ * @return uint32_t 核对的事件数
+ */
+static uint32_t Test_Dump(void)
+{
+    TraceRing_Event_TypeDef e;
+    TraceRing_Event_TypeDef d;
+    char hex[TRACE_RING_HEX_LEN + 1U];
+    uint32_t cursor = TraceRing_Tail(&s_xRec.ring);
+    uint64_t high;
+    uint32_t last = 0;
+    uint8_t have_last = 0;
+    uint32_t checked = 0;
+
+    e.ts = s_xRec.tail_high;
+    e.type = TEST_SYNC;
+    e.id = 0;
+    e.arg = 0;
+    TraceRing_Encode(&e, hex);
+    TEST_EQ(Test_Decode(hex, &d), 0);
+    TEST_EQ(d.type, TEST_SYNC);
+    high = d.ts;
+
+    while (TraceRing_Read(&s_xRec.ring, &cursor, &e, 1, NULL) == 1)
+    {
+        uint64_t exp = s_xRec.exp[(cursor - 1U) & s_xRec.ring.mask];
+
+        TraceRing_Encode(&e, hex);
+        TEST_EQ(Test_Decode(hex, &d), 0);
+        if (d.type == TEST_SYNC)
+        {
+            high = d.ts;
+            have_last = 0;
+            continue;
+        }
+        if (have_last && d.ts < last)
+        {
+            high++;
+        }
+        last = d.ts;
+        have_last = 1;
+
+        if (((high << 32) | d.ts) != exp)
+        {
+            printf("mismatch at seq %lu: got %016llx, want %016llx\n", (unsigned long)(cursor - 1U),
+                   (unsigned long long)((high << 32) | d.ts), (unsigned long long)exp);
+            TEST_CHECK(0);
+            return checked;
+        }
+        checked++;
+    }
+    return checked;
+}
+
+/**
+ * @brief 随机步长(多数在一个时间段内，部分跨越一个或多个时间段)录制，随机时刻输出
+ */
+static void Test_Epochs(void)
+{
+    static const uint32_t caps[3] = {16U, 64U, 256U};
+    uint32_t checked = 0;
+    uint32_t stale = 0;
+
+    Test_Seed(137);
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++)
+    {
+        uint32_t cap = caps[round % 3U];
+        uint32_t events = Test_RandBelow(cap * 6U);
+        uint64_t ts = ((uint64_t)Test_RandBelow(4U) << 32) | Test_Rand();
+
+        memset(&s_xRec, 0, sizeof(s_xRec));
+        TEST_EQ(TraceRing_Init(&s_xRec.ring, s_xBuf, cap, TRACE_RING_OVERWRITE), 0);
+        s_xRec.ts_high = (uint32_t)(ts >> 32);
+        s_xRec.tail_high = s_xRec.ts_high;
+
+        for (uint32_t i = 0; i < events; i++)
+        {
+            uint32_t pick = Test_RandBelow(16U);
+
+            if (pick == 0U)
+            {
+                ts += ((uint64_t)(1U + Test_RandBelow(3U)) << 32) + Test_Rand();
+            }
+            else if (pick < 4U)
+            {
+                ts += 0x40000000ULL + Test_Rand();
+            }
+            else
+            {
+                ts += 1U + Test_RandBelow(5000U);
+            }
+            Test_RecEvent(ts, (uint8_t)(1U + Test_RandBelow(15U)), (uint8_t)Test_Rand());
+        }
+
+        /* 最旧事件所在时间段与当前不同，才能区分开头SYNC取哪个值 */
+        stale += (s_xRec.tail_high != s_xRec.ts_high);
+        checked += Test_Dump();
+    }
+
+    TEST_CHECK(stale != 0);
+    printf("[bench] trace_epochs: %lu events checked, %lu dumps start in an older epoch\n",
+           (unsigned long)checked, (unsigned long)stale);
+}
+
+/**
+ * @brief 写入开销(覆盖模式，含覆盖检查)
+ */
+static void Test_PutCost(void)
+{
+    TraceRing_Event_TypeDef old;
+    uint32_t syncs = 0;
+    uint64_t t0;
+    uint64_t ns;
+
+    TEST_EQ(TraceRing_Init(&s_xRec.ring, s_xBuf, TEST_MAX_CAP, TRACE_RING_OVERWRITE), 0);
+    t0 = Test_NowNs();
+    for (uint32_t i = 0; i < TEST_BENCH_PUTS; i++)
+    {
+        if (TraceRing_Evicts(&s_xRec.ring, &old) && old.type == TEST_SYNC)
+        {
+            syncs++;
+        }
+        (void)TraceRing_Put(&s_xRec.ring, i, (uint8_t)((i & 255U) == 0 ? TEST_SYNC : 2U), 0, 0);
+    }
+    ns = Test_NowNs() - t0;
+
+    TEST_EQ(s_xRec.ring.head, TEST_BENCH_PUTS);
+    TEST_EQ(syncs, (TEST_BENCH_PUTS - TEST_MAX_CAP) / 256U);
+    printf("[bench] trace_put: %.2f ns\n", (double)ns / TEST_BENCH_PUTS);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_Overwrite);
+    TEST_RUN(Test_Stop);
+    TEST_RUN(Test_Freeze);
+    TEST_RUN(Test_Evicts);
+    TEST_RUN(Test_HeadWrap);
+    TEST_RUN(Test_Encode);
+    TEST_RUN(Test_Epochs);
+    TEST_RUN(Test_PutCost);
+    return Test_Exit("test_trace_ring");
+}
@@ -0,0 +1,472 @@
+/**
+ * @file test_tseries.c
+ * @brief libx/tseries主机测试: 分钟/小时滚动、环形覆盖、级别边界上的范围查询、插入耗时与存储占用
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 随机用例保存全部样本，由参考模型从头重算应有的各级内容，与全范围查询逐项对比:
+ *       - 分钟桶在下一个不同分钟的样本到来时关闭，没有样本的分钟不产生桶
+ *       - 小时桶由已关闭的分钟桶合并，最后一个已关闭分钟所在的小时即正在累加的小时桶
+ *       - 各级只保留最新的容量项，正在累加的桶作为查询结果的最后一项
+ */
+
+#include "sim_test.h"
+#include "tseries.h"
+
+#include <string.h>
+
+#define TEST_RAW_LEN 16U
+#define TEST_MIN_LEN 8U
+#define TEST_HOUR_LEN 4U
+#define TEST_SAMPLES 20000U
+#define TEST_BENCH_SAMPLES 4000000U
+
+/* 与app_history.h的容量一致 */
+#define TEST_APP_RAW_LEN 128U
+#define TEST_APP_MIN_LEN 120U
+#define TEST_APP_HOUR_LEN 168U
+
+static TSeries_TypeDef s_xTs;
+static TSeries_Sample_TypeDef s_xRaw[TEST_RAW_LEN];
+static TSeries_Agg_TypeDef s_xMinute[TEST_MIN_LEN];
+static TSeries_Agg_TypeDef s_xHour[TEST_HOUR_LEN];
+
+/* 参考模型: 全部样本与重算结果 */
+static TSeries_Sample_TypeDef s_xAll[TEST_SAMPLES];
+static TSeries_Agg_TypeDef s_xRefMin[TEST_SAMPLES];
+static int64_t s_llRefMinSum[TEST_SAMPLES];
+static TSeries_Agg_TypeDef s_xRefHour[TEST_SAMPLES];
+static TSeries_Agg_TypeDef s_xOut[TEST_SAMPLES];
+
+/**
+ * @brief 以参考方式聚合(64位求和，向零取整)
+ */
+typedef struct
+{
+    TSeries_Agg_TypeDef a;
+    int64_t sum;
+} Test_Acc_TypeDef;
+
+static void Test_AccAdd(Test_Acc_TypeDef *acc, uint32_t t, int32_t min, int32_t max,
+                        int64_t sum, uint32_t count)
+{
+    if (acc->a.count == 0)
+    {
+        acc->a.t = t;
+        acc->a.min = min;
+        acc->a.max = max;
+        acc->sum = 0;
+    }
+    acc->a.min = (min < acc->a.min) ? min : acc->a.min;
+    acc->a.max = (max > acc->a.max) ? max : acc->a.max;
+    acc->sum += sum;
+    acc->a.count += count;
+    acc->a.avg = (int32_t)(acc->sum / (int64_t)acc->a.count);
+}
+
+/**
+ * @brief 检查两个聚合结果相同
+ */
+static int Test_AggEq(const TSeries_Agg_TypeDef *a, const TSeries_Agg_TypeDef *b)
+{
+    return a->t == b->t && a->min == b->min && a->max == b->max &&
+           a->avg == b->avg && a->count == b->count;
+}
+
+static void Test_InitSmall(void)
+{
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, TEST_RAW_LEN, s_xMinute, TEST_MIN_LEN,
+                         s_xHour, TEST_HOUR_LEN), 0);
+}
+
+/**
+ * @brief 初始化参数校验与空序列
+ */
+static void Test_Init(void)
+{
+    TSeries_Agg_TypeDef a;
+
+    TEST_EQ(TSeries_Init(NULL, s_xRaw, 1, s_xMinute, 1, s_xHour, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, NULL, 1, s_xMinute, 1, s_xHour, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, 1, NULL, 1, s_xHour, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, 1, s_xMinute, 1, NULL, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, 0, s_xMinute, 1, s_xHour, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, 1, s_xMinute, 0, s_xHour, 1), -1);
+    TEST_EQ(TSeries_Init(&s_xTs, s_xRaw, 1, s_xMinute, 1, s_xHour, 0), -1);
+
+    /* 存储区无需清零 */
+    memset(s_xMinute, 0x5A, sizeof(s_xMinute));
+    Test_InitSmall();
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_RAW, &a), -1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_MINUTE, &a), -1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_HOUR, &a), -1);
+    TEST_EQ(TSeries_Latest(&s_xTs, (TSeries_Tier_t)3, &a), -1);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, UINT32_MAX, s_xOut, 8), 0);
+}
+
+/**
+ * @brief 分钟桶: 跨分钟时关闭，统计值与取整方向
+ */
+static void Test_Minute(void)
+{
+    TSeries_Agg_TypeDef a;
+
+    Test_InitSmall();
+    for (uint32_t t = 0; t < TSERIES_MINUTE_SEC; t++)
+    {
+        TEST_EQ(TSeries_Append(&s_xTs, t, (int32_t)t), 0);
+    }
+    /* 当前分钟尚未关闭 */
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_MINUTE, &a), -1);
+
+    TEST_EQ(TSeries_Append(&s_xTs, 60, -7), 1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_MINUTE, &a), 0);
+    TEST_EQ(a.t, 0);
+    TEST_EQ(a.min, 0);
+    TEST_EQ(a.max, 59);
+    TEST_EQ(a.avg, 29);
+    TEST_EQ(a.count, 60);
+
+    /* 负数平均向零取整: (-7 + -8) / 2 = -7 */
+    TEST_EQ(TSeries_Append(&s_xTs, 119, -8), 0);
+    TEST_EQ(TSeries_Append(&s_xTs, 120, 0), 1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_MINUTE, &a), 0);
+    TEST_CHECK(a.t == 60 && a.min == -8 && a.max == -7 && a.avg == -7 && a.count == 2);
+
+    /* 原始级最新样本 */
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_RAW, &a), 0);
+    TEST_CHECK(a.t == 120 && a.min == 0 && a.max == 0 && a.avg == 0 && a.count == 1);
+
+    /* 同一时间戳允许，倒退丢弃且不影响状态 */
+    TEST_EQ(TSeries_Append(&s_xTs, 120, 5), 0);
+    TEST_EQ(TSeries_Append(&s_xTs, 119, 1000), -1);
+    TEST_EQ(s_xTs.dropped, 1);
+    TEST_EQ(s_xTs.total, 64);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_RAW, &a), 0);
+    TEST_EQ(a.avg, 5);
+}
+
+/**
+ * @brief 小时桶: 由分钟桶合并，在下一小时的第一个分钟桶关闭时关闭
+ */
+static void Test_Hour(void)
+{
+    TSeries_Agg_TypeDef a;
+    uint16_t n;
+
+    Test_InitSmall();
+    /* 第0小时每10秒一个样本，值为分钟号 */
+    for (uint32_t t = 0; t < TSERIES_HOUR_SEC; t += 10U)
+    {
+        TSeries_Append(&s_xTs, t, (int32_t)(t / 60U));
+    }
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_HOUR, &a), -1);
+
+    /* 进入第1小时: 关闭第59分钟，小时桶仍在累加(查询中作为最后一项) */
+    TEST_EQ(TSeries_Append(&s_xTs, 3600, 1000), 1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_HOUR, &a), -1);
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, UINT32_MAX, s_xOut, 4);
+    TEST_EQ(n, 1);
+    TEST_CHECK(s_xOut[0].t == 0 && s_xOut[0].min == 0 && s_xOut[0].max == 59 &&
+               s_xOut[0].count == 360 && s_xOut[0].avg == 29);
+
+    /* 第1小时的第一个分钟桶关闭时第0小时关闭 */
+    TEST_EQ(TSeries_Append(&s_xTs, 3660, 1001), 1);
+    TEST_EQ(TSeries_Latest(&s_xTs, TSERIES_TIER_HOUR, &a), 0);
+    TEST_CHECK(a.t == 0 && a.min == 0 && a.max == 59 && a.count == 360 && a.avg == 29);
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, UINT32_MAX, s_xOut, 4);
+    TEST_EQ(n, 2);
+    TEST_CHECK(s_xOut[1].t == 3600 && s_xOut[1].count == 1 && s_xOut[1].avg == 1000);
+
+    /* 跳过几个小时: 空的小时不产生桶 */
+    TEST_EQ(TSeries_Append(&s_xTs, 5 * 3600U + 30U, 7), 1);
+    TEST_EQ(TSeries_Append(&s_xTs, 5 * 3600U + 60U, 8), 1);
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, UINT32_MAX, s_xOut, 8);
+    TEST_EQ(n, 3);
+    TEST_EQ(s_xOut[0].t, 0);
+    TEST_EQ(s_xOut[1].t, 3600);
+    TEST_CHECK(s_xOut[1].count == 2 && s_xOut[1].min == 1000 && s_xOut[1].max == 1001);
+    TEST_EQ(s_xOut[2].t, 5 * 3600U);
+    TEST_EQ(s_xOut[2].count, 1);
+}
+
+/**
+ * @brief 环形覆盖: 各级只保留最新的容量项，且按时间顺序输出
+ */
+static void Test_Wrap(void)
+{
+    uint16_t n;
+    uint32_t order = 0;
+
+    Test_InitSmall();
+    /* 每分钟2个样本，共30小时 */
+    for (uint32_t t = 0; t < 30U * TSERIES_HOUR_SEC; t += 30U)
+    {
+        TSeries_Append(&s_xTs, t, (int32_t)(t % 1000U));
+    }
+
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_RAW, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    TEST_EQ(n, TEST_RAW_LEN);
+    TEST_EQ(s_xOut[n - 1U].t, 30U * TSERIES_HOUR_SEC - 30U);
+    TEST_EQ(s_xOut[0].t, 30U * TSERIES_HOUR_SEC - 30U * TEST_RAW_LEN);
+
+    /* 已关闭的分钟桶只剩最新TEST_MIN_LEN个，加上当前分钟 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    TEST_EQ(n, TEST_MIN_LEN + 1U);
+    TEST_EQ(s_xOut[n - 1U].t, 30U * TSERIES_HOUR_SEC - 60U);
+    TEST_EQ(s_xOut[0].t, 30U * TSERIES_HOUR_SEC - 60U * (TEST_MIN_LEN + 1U));
+    for (uint16_t i = 1; i < n; i++)
+    {
+        order += (s_xOut[i].t != s_xOut[i - 1U].t + 60U);
+    }
+
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    TEST_EQ(n, TEST_HOUR_LEN + 1U);
+    TEST_EQ(s_xOut[n - 1U].t, 29U * TSERIES_HOUR_SEC);
+    TEST_EQ(s_xOut[0].t, (29U - TEST_HOUR_LEN) * TSERIES_HOUR_SEC);
+    TEST_EQ(s_xOut[0].count, 120);
+    for (uint16_t i = 1; i < n; i++)
+    {
+        order += (s_xOut[i].t != s_xOut[i - 1U].t + TSERIES_HOUR_SEC);
+    }
+    TEST_EQ(order, 0);
+    TEST_EQ(s_xTs.raw.used, TEST_RAW_LEN);
+    TEST_EQ(s_xTs.minute.used, TEST_MIN_LEN);
+    TEST_EQ(s_xTs.hour.used, TEST_HOUR_LEN);
+}
+
+/**
+ * @brief 范围查询: 按桶起始时间闭区间筛选，边界前后各差1秒
+ */
+static void Test_Range(void)
+{
+    uint16_t n;
+
+    Test_InitSmall();
+    /* 分钟 0,1,2,3 各一个样本(值为分钟号)，第4分钟正在累加 */
+    for (uint32_t m = 0; m <= 4U; m++)
+    {
+        TSeries_Append(&s_xTs, m * 60U + 5U, (int32_t)m);
+    }
+
+    /* 起点恰好是桶起始时间: 包含 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 60, 180, s_xOut, 8);
+    TEST_EQ(n, 3);
+    TEST_CHECK(s_xOut[0].t == 60 && s_xOut[2].t == 180);
+
+    /* 起点在桶内(晚于起始时间1秒): 不包含该桶 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 61, 180, s_xOut, 8);
+    TEST_EQ(n, 2);
+    TEST_EQ(s_xOut[0].t, 120);
+
+    /* 终点早于桶起始时间1秒: 不包含；桶的末秒仍属该桶，但筛选只看起始时间 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, 179, s_xOut, 8);
+    TEST_EQ(n, 3);
+    TEST_EQ(s_xOut[2].t, 120);
+
+    /* 正在累加的桶: 起始时间在范围内才输出 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 240, 240, s_xOut, 8);
+    TEST_EQ(n, 1);
+    TEST_CHECK(s_xOut[0].t == 240 && s_xOut[0].avg == 4 && s_xOut[0].count == 1);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 241, UINT32_MAX, s_xOut, 8), 0);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, 239, s_xOut, 8), 4);
+
+    /* 只有一个桶的区间，空区间，反向区间 */
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 120, 120, s_xOut, 8), 1);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 121, 179, s_xOut, 8), 0);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 180, 120, s_xOut, 8), 0);
+
+    /* 超过max只输出最旧的max项 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, UINT32_MAX, s_xOut, 2);
+    TEST_EQ(n, 2);
+    TEST_CHECK(s_xOut[0].t == 0 && s_xOut[1].t == 60);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, UINT32_MAX, s_xOut, 0), 0);
+
+    /* 原始级按样本时间闭区间 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_RAW, 65, 185, s_xOut, 8);
+    TEST_EQ(n, 3);
+    TEST_CHECK(s_xOut[0].t == 65 && s_xOut[2].t == 185);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_RAW, 66, 124, s_xOut, 8), 0);
+
+    /* 小时级: 当前小时桶只含已关闭的分钟(0~3) */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, 0, s_xOut, 8);
+    TEST_EQ(n, 1);
+    TEST_CHECK(s_xOut[0].t == 0 && s_xOut[0].count == 4 && s_xOut[0].max == 3);
+    TEST_EQ(TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 1, UINT32_MAX, s_xOut, 8), 0);
+    TEST_EQ(TSeries_Query(&s_xTs, (TSeries_Tier_t)3, 0, UINT32_MAX, s_xOut, 8), 0);
+}
+
+/**
+ * @brief 由全部样本重算各级内容，与全范围查询对比
+ * @return uint32_t 不一致的项数
+ */
+static uint32_t Test_CompareModel(uint32_t count)
+{
+    Test_Acc_TypeDef cur;
+    Test_Acc_TypeDef hour;
+    uint32_t nmin = 0;
+    uint32_t nhour = 0;
+    uint32_t bad = 0;
+    uint32_t first;
+    uint16_t n;
+
+    /* 分钟: 每遇到不同的分钟关闭上一桶 */
+    memset(&cur, 0, sizeof(cur));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t ms = s_xAll[i].t - s_xAll[i].t % TSERIES_MINUTE_SEC;
+
+        if (cur.a.count != 0 && cur.a.t != ms)
+        {
+            s_llRefMinSum[nmin] = cur.sum;
+            s_xRefMin[nmin++] = cur.a;
+            memset(&cur, 0, sizeof(cur));
+        }
+        Test_AccAdd(&cur, ms, s_xAll[i].v, s_xAll[i].v, s_xAll[i].v, 1);
+    }
+
+    /* 小时: 由已关闭的分钟合并，最后一组为正在累加的小时桶 */
+    memset(&hour, 0, sizeof(hour));
+    for (uint32_t i = 0; i < nmin; i++)
+    {
+        const TSeries_Agg_TypeDef *m = &s_xRefMin[i];
+        uint32_t hs = m->t - m->t % TSERIES_HOUR_SEC;
+
+        if (hour.a.count != 0 && hour.a.t != hs)
+        {
+            s_xRefHour[nhour++] = hour.a;
+            memset(&hour, 0, sizeof(hour));
+        }
+        /* 用分钟和合并(平均值取整后不可逆) */
+        Test_AccAdd(&hour, hs, m->min, m->max, s_llRefMinSum[i], m->count);
+    }
+
+    /* 分钟级 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_MINUTE, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    first = (nmin > TEST_MIN_LEN) ? nmin - TEST_MIN_LEN : 0;
+    bad += (n != nmin - first + (cur.a.count != 0));
+    for (uint32_t i = first; i < nmin && i - first < n; i++)
+    {
+        bad += !Test_AggEq(&s_xOut[i - first], &s_xRefMin[i]);
+    }
+    if (cur.a.count != 0 && n != 0)
+    {
+        bad += !Test_AggEq(&s_xOut[n - 1U], &cur.a);
+    }
+
+    /* 小时级 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_HOUR, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    first = (nhour > TEST_HOUR_LEN) ? nhour - TEST_HOUR_LEN : 0;
+    bad += (n != nhour - first + (hour.a.count != 0));
+    for (uint32_t i = first; i < nhour && i - first < n; i++)
+    {
+        bad += !Test_AggEq(&s_xOut[i - first], &s_xRefHour[i]);
+    }
+    if (hour.a.count != 0 && n != 0)
+    {
+        bad += !Test_AggEq(&s_xOut[n - 1U], &hour.a);
+    }
+
+    /* 原始级 */
+    n = TSeries_Query(&s_xTs, TSERIES_TIER_RAW, 0, UINT32_MAX, s_xOut, TEST_SAMPLES);
+    first = (count > TEST_RAW_LEN) ? count - TEST_RAW_LEN : 0;
+    bad += (n != count - first);
+    for (uint32_t i = first; i < count && i - first < n; i++)
+    {
+        bad += (s_xOut[i - first].t != s_xAll[i].t || s_xOut[i - first].avg != s_xAll[i].v);
+    }
+    return bad;
+}
+
+/**
+ * @brief 随机时间间隔(含同秒、跨多个小时的空档)与随机取值对比参考模型
+ */
+static void Test_Model(void)
+{
+    uint32_t t = 1000U;
+    uint32_t bad = 0;
+    uint32_t checks = 0;
+
+    Test_Seed(29);
+    Test_InitSmall();
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++)
+    {
+        uint32_t r = Test_RandBelow(1000U);
+
+        if (r < 5U)
+        {
+            t += Test_RandBelow(3U * TSERIES_HOUR_SEC);
+        }
+        else if (r < 100U)
+        {
+            t += Test_RandBelow(200U);
+        }
+        else
+        {
+            t += Test_RandBelow(8U);
+        }
+        s_xAll[i].t = t;
+        s_xAll[i].v = (int32_t)Test_Rand();
+        bad += (TSeries_Append(&s_xTs, t, s_xAll[i].v) < 0);
+
+        if ((i % 997U) == 0 || i + 1U == TEST_SAMPLES)
+        {
+            bad += Test_CompareModel(i + 1U);
+            checks++;
+        }
+    }
+    TEST_EQ(bad, 0);
+    TEST_EQ(s_xTs.total, TEST_SAMPLES);
+    TEST_EQ(s_xTs.dropped, 0);
+    printf("[bench] tseries_model: %u samples, %u comparisons, span %lu s\n",
+           TEST_SAMPLES, checks, (unsigned long)(t - 1000U));
+}
+
+/**
+ * @brief 插入耗时(每秒一个样本，按app_history的容量)与存储占用
+ */
+static void Test_Cost(void)
+{
+    static TSeries_Sample_TypeDef raw[TEST_APP_RAW_LEN];
+    static TSeries_Agg_TypeDef minute[TEST_APP_MIN_LEN];
+    static TSeries_Agg_TypeDef hour[TEST_APP_HOUR_LEN];
+    size_t footprint = TSERIES_FOOTPRINT(TEST_APP_RAW_LEN, TEST_APP_MIN_LEN, TEST_APP_HOUR_LEN);
+    uint32_t closed = 0;
+    uint64_t t0;
+    uint64_t ns;
+
+    /* 元素大小在32位目标板与64位主机上相同(控制块含指针，两端不同) */
+    TEST_EQ(sizeof(TSeries_Sample_TypeDef), 8);
+    TEST_EQ(sizeof(TSeries_Agg_TypeDef), 20);
+    TEST_EQ(footprint, sizeof(TSeries_TypeDef) + TEST_APP_RAW_LEN * 8U +
+                           (TEST_APP_MIN_LEN + TEST_APP_HOUR_LEN) * 20U);
+    TEST_EQ(footprint, sizeof(s_xTs) + sizeof(raw) + sizeof(minute) + sizeof(hour));
+    /* app_history.c的估算(每通道约6.8KB)，控制块按32位目标板不超过128字节 */
+    TEST_CHECK(footprint - sizeof(TSeries_TypeDef) + 128U < 7000U);
+
+    TEST_EQ(TSeries_Init(&s_xTs, raw, TEST_APP_RAW_LEN, minute, TEST_APP_MIN_LEN,
+                         hour, TEST_APP_HOUR_LEN), 0);
+    t0 = Test_NowNs();
+    for (uint32_t i = 0; i < TEST_BENCH_SAMPLES; i++)
+    {
+        closed += (TSeries_Append(&s_xTs, i, (int32_t)(i & 0xFFFU)) == 1);
+    }
+    ns = Test_NowNs() - t0;
+
+    TEST_EQ(closed, TEST_BENCH_SAMPLES / TSERIES_MINUTE_SEC);
+    TEST_EQ(s_xTs.hour.used, TEST_APP_HOUR_LEN);
+    printf("[bench] tseries_append: %.2f ns/sample, footprint %u bytes/channel (control block %u)\n",
+           (double)ns / TEST_BENCH_SAMPLES, (unsigned)footprint, (unsigned)sizeof(TSeries_TypeDef));
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_Minute);
+    TEST_RUN(Test_Hour);
+    TEST_RUN(Test_Wrap);
+    TEST_RUN(Test_Range);
+    TEST_RUN(Test_Model);
+    TEST_RUN(Test_Cost);
+    return Test_Exit("test_tseries");
+}
@@ -0,0 +1,402 @@
+/**
+ * @file test_twheel.c
+ * @brief libx/twheel主机测试: 数千个定时器对照参考模型逐拍核对到期时刻，以及每拍开销
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note 参考模型按64位节拍记录每个定时器的到期时刻，时间轮须恰好在该节拍回调:
+ *       - 延时按位数均匀分布(1 ~ 2^24)，覆盖全部4层与逐级下放；另有超出单次范围的延时
+ *       - 单次与周期定时器混合，回调中随机停止/重启其他定时器或自己，回调外随机启动/停止
+ *       - 节拍计数从0与2^32附近开始各跑一次，覆盖回绕
+ *       - 定期检查没有漏掉的到期、活动计数一致，TWheel_NextDelay不晚于真实的下一次到期
+ *       每拍开销以1千~10万个周期定时器测量平均与最差值，只作参考
+ */
+
+#include "sim_test.h"
+#include "twheel.h"
+
+#include <string.h>
+
+#define TEST_TIMERS 4096U
+#define TEST_TICKS (1UL << 21)
+#define TEST_CHECK_EVERY 4093U  /**< 全量检查的间隔(节拍) */
+#define TEST_LONG_TIMERS 64U
+#define TEST_COST_TICKS 65536U
+#define TEST_COST_MAX 100000U
+#define TEST_COST_PERIOD 60000U /**< 周期上限(节拍)，每个定时器平均约每3万拍到期一次 */
+
+typedef struct
+{
+    uint64_t exp;       /**< 期望的到期节拍 */
+    uint32_t period;
+    uint8_t active;
+} Test_Model_TypeDef;
+
+static TWheel_TypeDef s_xWheel;
+static TWheel_Timer_TypeDef s_xTimer[TEST_COST_MAX];
+static Test_Model_TypeDef s_xModel[TEST_TIMERS];
+
+static uint64_t s_ullTick;      /**< 自开始以来的节拍(不回绕) */
+static uint32_t s_ulBase;       /**< 开始时的时间轮节拍 */
+static uint8_t s_ucChurn;       /**< 回调中是否随机修改定时器 */
+static uint32_t s_ulTimers;     /**< 本轮使用的定时器数 */
+static uint32_t s_ulFired;
+static uint32_t s_ulWrong;      /**< 时刻不对或未启动却回调 */
+static uint32_t s_ulActive;
+
+/**
+ * ============================================================================
+ * 参考模型
+ * ============================================================================
+ */
+
+/**
+ * @brief 按位数均匀分布的延时(1 ~ 2^bits)
+ */
+static uint32_t Test_Delay(uint32_t bits)
+{
+    uint32_t b = Test_RandBelow(bits + 1U);
+
+    return 1U + (Test_Rand() & ((1UL << b) - 1UL));
+}
+
+static void Test_Start(uint32_t i, uint32_t delay, uint32_t period)
+{
+    if (!s_xModel[i].active)
+    {
+        s_ulActive++;
+    }
+    TWheel_Start(&s_xWheel, &s_xTimer[i], delay, period);
+    s_xModel[i].exp = s_ullTick + ((delay != 0) ? delay : 1U);
+    s_xModel[i].period = period;
+    s_xModel[i].active = 1;
+}
+
+static void Test_Stop(uint32_t i)
+{
+    if (s_xModel[i].active)
+    {
+        s_ulActive--;
+    }
+    TWheel_Stop(&s_xWheel, &s_xTimer[i]);
+    s_xModel[i].active = 0;
+}
+
+/**
+ * @brief 随机启动一个定时器(约1/3为周期定时器)
+ */
+static void Test_StartRandom(uint32_t i, uint32_t bits)
+{
+    uint32_t period = (Test_RandBelow(3U) == 0) ? Test_Delay(bits > 16U ? 16U : bits) : 0U;
+
+    Test_Start(i, Test_Delay(bits) - (Test_RandBelow(64U) == 0), period);
+}
+
+static void Test_OnExpire(TWheel_Timer_TypeDef *timer, void *ctx)
+{
+    uint32_t i = (uint32_t)(uintptr_t)ctx;
+    Test_Model_TypeDef *m = &s_xModel[i];
+    uint32_t r;
+
+    s_ulFired++;
+    if (timer != &s_xTimer[i] || !m->active || m->exp != s_ullTick ||
+        s_xWheel.now != s_ulBase + (uint32_t)s_ullTick)
+    {
+        if (s_ulWrong++ < 5U)
+        {
+            printf("timer %lu fired at tick %llu, expected %llu (active %u)\n", (unsigned long)i,
+                   (unsigned long long)s_ullTick, (unsigned long long)m->exp, m->active);
+        }
+    }
+
+    if (m->period != 0)
+    {
+        m->exp = s_ullTick + m->period;
+    }
+    else
+    {
+        m->active = 0;
+        s_ulActive--;
+    }
+
+    if (!s_ucChurn)
+    {
+        return;
+    }
+
+    /* 回调中修改定时器(包括同一节拍尚未回调的) */
+    r = Test_RandBelow(16U);
+    if (r == 0)
+    {
+        Test_Stop(Test_RandBelow(s_ulTimers));
+    }
+    else if (r == 1)
+    {
+        Test_StartRandom(Test_RandBelow(s_ulTimers), 12U);
+    }
+    else if (r == 2)
+    {
+        Test_StartRandom(i, 8U);
+    }
+    else if (r == 3)
+    {
+        Test_Stop(i);
+    }
+}
+
+/**
+ * @brief 全量检查: 没有漏掉的到期，计数一致，NextDelay保守
+ */
+static uint32_t Test_Audit(void)
+{
+    uint64_t next = UINT64_MAX;
+    uint32_t bad = 0;
+    uint32_t active = 0;
+    uint32_t limit = 1U + Test_RandBelow(100000U);
+    uint32_t est;
+
+    for (uint32_t i = 0; i < s_ulTimers; i++)
+    {
+        if (!s_xModel[i].active)
+        {
+            continue;
+        }
+        active++;
+        if (s_xModel[i].exp <= s_ullTick)
+        {
+            if (bad++ < 5U)
+            {
+                printf("timer %lu missed: expected %llu, now %llu\n", (unsigned long)i,
+                       (unsigned long long)s_xModel[i].exp, (unsigned long long)s_ullTick);
+            }
+        }
+        if (s_xModel[i].exp < next)
+        {
+            next = s_xModel[i].exp;
+        }
+    }
+
+    bad += (active != s_ulActive) || (s_xWheel.count != s_ulActive);
+
+    est = TWheel_NextDelay(&s_xWheel, limit);
+    if (est < 1U || est > limit || (next != UINT64_MAX && est > next - s_ullTick))
+    {
+        if (bad++ < 5U)
+        {
+            printf("NextDelay %lu (limit %lu) but next expiry in %llu\n", (unsigned long)est,
+                   (unsigned long)limit, (unsigned long long)(next - s_ullTick));
+        }
+    }
+    return bad;
+}
+
+static void Test_Reset(uint32_t now, uint32_t timers, uint8_t churn)
+{
+    TWheel_Init(&s_xWheel, now);
+    s_ulBase = now;
+    s_ucChurn = churn;
+    memset(s_xModel, 0, sizeof(s_xModel));
+    s_ullTick = 0;
+    s_ulTimers = timers;
+    s_ulFired = 0;
+    s_ulWrong = 0;
+    s_ulActive = 0;
+    for (uint32_t i = 0; i < timers; i++)
+    {
+        TWheel_TimerInit(&s_xTimer[i], Test_OnExpire, (void *)(uintptr_t)i);
+    }
+}
+
+/**
+ * ============================================================================
+ * 测试用例
+ * ============================================================================
+ */
+
+/**
+ * @brief 随机定时器与参考模型逐拍对照
+ */
+static void Test_RandomRun(uint32_t now)
+{
+    uint32_t fired = 0;
+    uint32_t bad = 0;
+    uint32_t t;
+
+    Test_Reset(now, TEST_TIMERS, 1);
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        Test_StartRandom(i, 24U);
+    }
+
+    for (t = 0; t < TEST_TICKS; t++)
+    {
+        s_ullTick++;
+        fired += TWheel_Tick(&s_xWheel);
+
+        /* 回调之外的启动/停止 */
+        if (Test_RandBelow(4U) == 0)
+        {
+            uint32_t i = Test_RandBelow(TEST_TIMERS);
+
+            if (Test_RandBelow(4U) == 0)
+            {
+                Test_Stop(i);
+            }
+            else
+            {
+                Test_StartRandom(i, 24U);
+            }
+        }
+        if (t % TEST_CHECK_EVERY == 0)
+        {
+            bad += Test_Audit();
+        }
+    }
+    bad += Test_Audit();
+
+    TEST_EQ(s_ulWrong, 0);
+    TEST_EQ(bad, 0);
+    TEST_EQ(fired, s_ulFired);
+    TEST_CHECK(s_ulFired > TEST_TICKS / 4U);
+    printf("[bench] twheel_random(now=0x%08lx): %lu ticks, %lu expiries, %lu active at end\n",
+           (unsigned long)now, (unsigned long)TEST_TICKS, (unsigned long)s_ulFired,
+           (unsigned long)s_ulActive);
+}
+
+static void Test_Random(void)
+{
+    Test_Seed(35);
+    Test_RandomRun(0);
+    /* 运行中途越过2^32 */
+    Test_RandomRun(0xFFFFFFFFUL - TEST_TICKS / 2U);
+}
+
+/**
+ * @brief 超出单次挂入范围的延时: 先挂在最高层，中途重新插入后仍准时到期
+ */
+static void Test_LongDelay(void)
+{
+    uint32_t bad = 0;
+    uint64_t end = 0;
+
+    Test_Seed(350);
+    Test_Reset(0x12345678UL, TEST_LONG_TIMERS, 0);
+    for (uint32_t i = 0; i < TEST_LONG_TIMERS; i++)
+    {
+        uint32_t delay = TWHEEL_MAX_DELAY - 2U + Test_RandBelow(2U * TWHEEL_MAX_DELAY);
+
+        Test_Start(i, delay, 0);
+        end = (s_xModel[i].exp > end) ? s_xModel[i].exp : end;
+    }
+    /* 边界附近的几个固定值 */
+    Test_Start(0, TWHEEL_MAX_DELAY, 0);
+    Test_Start(1, TWHEEL_MAX_DELAY + 1U, 0);
+    Test_Start(2, 3U * TWHEEL_MAX_DELAY, 0);
+    end = (s_xModel[2].exp > end) ? s_xModel[2].exp : end;
+
+    while (s_ullTick < end)
+    {
+        s_ullTick++;
+        (void)TWheel_Tick(&s_xWheel);
+        if ((s_ullTick & 0xFFFFFU) == 0)
+        {
+            bad += Test_Audit();
+        }
+    }
+
+    TEST_EQ(s_ulWrong, 0);
+    TEST_EQ(bad, 0);
+    TEST_EQ(s_ulFired, TEST_LONG_TIMERS);
+    TEST_EQ(s_xWheel.count, 0);
+}
+
+/**
+ * @brief 同一节拍的多个定时器、延时0按1处理、重复启动与停止
+ */
+static void Test_Basic(void)
+{
+    Test_Seed(3500);
+    Test_Reset(100, 8, 0);
+
+    Test_Start(0, 0, 0);
+    TEST_EQ(s_xModel[0].exp, 1);
+    Test_Start(1, 64, 0);
+    Test_Start(2, 64, 0);
+    Test_Start(3, 64, 0);
+    Test_Start(3, 65, 0);      /* 重新开始计时 */
+    Test_Stop(2);
+    Test_Stop(2);              /* 未启动时无操作 */
+    TEST_EQ(s_xWheel.count, 3);
+
+    s_ullTick++;
+    TEST_EQ(TWheel_Tick(&s_xWheel), 1);
+    /* 第1层的槽按下放时刻(节拍128)保守估计 */
+    TEST_EQ(TWheel_NextDelay(&s_xWheel, 1000), 128U - 101U);
+    while (s_ullTick < 63U)
+    {
+        s_ullTick++;
+        TEST_EQ(TWheel_Tick(&s_xWheel), 0);
+    }
+    s_ullTick++;
+    TEST_EQ(TWheel_Tick(&s_xWheel), 1);
+    s_ullTick++;
+    TEST_EQ(TWheel_Tick(&s_xWheel), 1);
+    TEST_EQ(s_xWheel.count, 0);
+    TEST_EQ(s_ulWrong, 0);
+
+    /* 没有定时器时返回上限 */
+    TEST_EQ(TWheel_NextDelay(&s_xWheel, 500), 500);
+    TEST_EQ(TWheel_NextDelay(&s_xWheel, 0), 1);
+}
+
+/**
+ * @brief 每拍开销: N个随机周期(100 ~ 6万拍)的周期定时器，平均与最差的一拍
+ */
+static void Test_TickCost(void)
+{
+    static const uint32_t counts[3] = {1000U, 10000U, TEST_COST_MAX};
+
+    Test_Seed(35000);
+    for (uint32_t c = 0; c < 3U; c++)
+    {
+        uint32_t n = counts[c];
+        uint64_t total = 0;
+        uint64_t worst = 0;
+        uint64_t fired = 0;
+
+        TWheel_Init(&s_xWheel, 0);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t period = 100U + Test_RandBelow(TEST_COST_PERIOD);
+
+            TWheel_TimerInit(&s_xTimer[i], NULL, NULL);
+            TWheel_Start(&s_xWheel, &s_xTimer[i], 1U + Test_RandBelow(period), period);
+        }
+
+        for (uint32_t t = 0; t < TEST_COST_TICKS; t++)
+        {
+            uint64_t t0 = Test_NowNs();
+            uint64_t dt;
+
+            fired += TWheel_Tick(&s_xWheel);
+            dt = Test_NowNs() - t0;
+            total += dt;
+            worst = (dt > worst) ? dt : worst;
+        }
+
+        TEST_EQ(s_xWheel.count, n);
+        printf("[bench] twheel_tick %lu timers: %.1f ns/tick mean, %llu ns worst, %.2f expiries/tick, "
+               "%.1f ns/expiry\n",
+               (unsigned long)n, (double)total / TEST_COST_TICKS, (unsigned long long)worst,
+               (double)fired / TEST_COST_TICKS, (fired != 0) ? (double)total / (double)fired : 0.0);
+    }
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Basic);
+    TEST_RUN(Test_Random);
+    TEST_RUN(Test_LongDelay);
+    TEST_RUN(Test_TickCost);
+    return Test_Exit("test_twheel");
+}
@@ -79,8 +79,9 @@
     extern uint32_t SystemCoreClock;
 #endif
 
-//断言
-#define vAssertCalled(char,int) printf("Error:%s,%d\r\n",char,int)
+//断言(先冻结调度跟踪缓冲，保留断言前的时间线)
+extern void AppTrace_Freeze(uint16_t reason);
+#define vAssertCalled(char,int) (AppTrace_Freeze(1 /* APP_TRACE_REASON_ASSERT */), printf("Error:%s,%d\r\n",char,int))
 #define configASSERT(x) if((x)==0) vAssertCalled(__FILE__,__LINE__)
 
 /************************************************************************
@@ -127,12 +128,14 @@
  * 			1.使用FlyMcu擦除一下芯片，然后进行下载
  *			STMISP -> 清除芯片(z)
  */
-#define configUSE_TICKLESS_IDLE													0   
+/* 由app_power实现(SLEEP/STOP自动选择，见下方"低功耗"一节) */
+#define configUSE_TICKLESS_IDLE													1   
 
 /*
  * 写入实际的CPU内核时钟频率，也就是CPU指令执行频率，通常称为Fclk
  * Fclk为供给CPU内核的时钟信号，我们所说的cpu主频为 XX MHz，
  * 就是指的这个时钟信号，相应的，1/Fclk即为cpu时钟周期；
+ * 运行时可调频(app_clock)，切换后的SysTick重装值由AppPower_ClockUpdate重新计算
  */
 #define configCPU_CLOCK_HZ						  (SystemCoreClock)
 
@@ -181,9 +184,15 @@
 //支持动态内存申请
 #define configSUPPORT_DYNAMIC_ALLOCATION        1    
 //支持静态内存
-#define configSUPPORT_STATIC_ALLOCATION					0					
+#define configSUPPORT_STATIC_ALLOCATION					1					
 //系统所有总的堆大小
+//任务栈/TCB/互斥量为静态分配(app_task)，堆只留给运行期少量动态对象
+//newlib的malloc也使用此堆(newlib_heap.c)，另含stdout流缓冲(BUFSIZ，1KB)
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+#define configTOTAL_HEAP_SIZE					((size_t)(9*1024))
+#else
 #define configTOTAL_HEAP_SIZE					((size_t)(36*1024))    
+#endif
 
 
 /***************************************************************
@@ -208,10 +217,11 @@
  * FreeRTOS规定了函数的名字和参数：void vApplicationTickHook(void )
  * 时间片中断可以周期性的调用
  * 函数必须非常短小，不能大量使用堆栈，
- * 不能调用以”FromISR" 或 "FROM_ISR”结尾的API函数
+ * 只能调用以”FromISR" 或 "FROM_ISR”结尾的API函数
  */
  /*xTaskIncrementTick函数是在xPortSysTickHandler中断函数中被调用的。因此，vApplicationTickHook()函数执行的时间必须很短才行*/
-#define configUSE_TICK_HOOK						0           
+/* 节拍钩子中周期性读取64位DWT时间戳(防止CYCCNT回绕丢失)，并推进软件定时器(app_timer) */
+#define configUSE_TICK_HOOK						1           
 
 //使用内存申请失败钩子函数
 #define configUSE_MALLOC_FAILED_HOOK			1 
@@ -227,9 +237,9 @@
           FreeRTOS与运行时间和任务状态收集有关的配置选项   
 **********************************************************************/
 //启用运行时间统计功能
-#define configGENERATE_RUN_TIME_STATS	        0             
- //启用可视化跟踪调试
-#define configUSE_TRACE_FACILITY				      0    
+#define configGENERATE_RUN_TIME_STATS	        1             
+ //启用可视化跟踪调试(uxTaskGetSystemState与任务编号需要)
+#define configUSE_TRACE_FACILITY				      1    
 /* 与宏configUSE_TRACE_FACILITY同时为1时会编译下面3个函数
  * prvWriteNameToBuffer()
  * vTaskList(),
@@ -274,7 +284,7 @@
 #define INCLUDE_xTimerPendFunctionCall	     0
 //#define INCLUDE_xTaskGetCurrentTaskHandle       1
 //#define INCLUDE_uxTaskGetStackHighWaterMark     0
-//#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_xTaskGetIdleTaskHandle          1   /* Task_Prof按IDLE占用率调频(app_clock) */
 
 
 /******************************************************************
@@ -306,12 +316,87 @@
  * 并手动调用 xPortSysTickHandler() */
 // #define xPortSysTickHandler SysTick_Handler
 
-/* 以下为使用Percepio Tracealyzer需要的东西，不需要时将 configUSE_TRACE_FACILITY 定义为 0 */
-#if ( configUSE_TRACE_FACILITY == 1 )
-#include "trcRecorder.h"
-#define INCLUDE_xTaskGetCurrentTaskHandle               1   // 启用一个可选函数（该函数被 Trace源码使用，默认该值为0 表示不用）
+/****************************************************************
+            FreeRTOS运行时间统计与跟踪钩子
+****************************************************************/
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+/* 运行时间计数器直接使用DWT CYCCNT(在BSP_Init中已使能，无需再配置定时器)
+ * V9的计数器为32位，180MHz下约23.8秒回绕，统计方(task_prof)按窗口做差使用 */
+extern uint32_t CPU_TS_TmrRd(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        CPU_TS_TmrRd()
+
+/* 统计每个任务的切入次数(在tasks.c内展开，可直接访问pxCurrentTCB) */
+extern void Task_Prof_SwitchedIn(unsigned long number); /* number为UBaseType_t */
+#define PROF_TASK_SWITCHED_IN()                 Task_Prof_SwitchedIn(pxCurrentTCB->uxTCBNumber)
+
+/* 统计每个任务转为就绪的次数(被抢占后恢复运行不经过这里，即实际唤醒次数) */
+extern void Task_Prof_MadeReady(unsigned long number); /* number为UBaseType_t */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)   Task_Prof_MadeReady((pxTCB)->uxTCBNumber)
+#else
+#define PROF_TASK_SWITCHED_IN()
+#endif
+
+/* 调度器热点(PendSV/SysTick/vTaskSwitchContext/xTaskIncrementTick)的放置: 性能构建中从SRAM执行(见mem_section.h) */
+#include "mem_section.h"
+#define portFASTCODE_FUNCTION                   MEM_FASTCODE
+
+/* 调度跟踪记录器(app_trace)：任务切换、队列/信号量、任务通知，需要configUSE_TRACE_FACILITY */
+#define configUSE_APP_TRACE                     1
+
+#if ( configUSE_APP_TRACE == 1 )
+#include "app_trace.h"
+#define APP_TRACE_TASK_SWITCHED_IN()            AppTrace_Record(APP_TRACE_TASK_IN, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceTASK_CREATE(pxNewTCB)              AppTrace_TaskCreate((pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName, (pxNewTCB)->uxPriority)
+#define traceQUEUE_CREATE(pxNewQueue)           ((pxNewQueue)->uxQueueNumber = AppTrace_NextQueueNumber())
+#define traceQUEUE_SEND(pxQueue)                AppTrace_Record(APP_TRACE_QUEUE_SEND, (uint8_t)(pxQueue)->uxQueueNumber, (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       AppTrace_Record(APP_TRACE_QUEUE_SEND_ISR, (uint8_t)(pxQueue)->uxQueueNumber, (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue)             AppTrace_Record(APP_TRACE_QUEUE_RECV, (uint8_t)(pxQueue)->uxQueueNumber, (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    AppTrace_Record(APP_TRACE_QUEUE_RECV_ISR, (uint8_t)(pxQueue)->uxQueueNumber, (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)    AppTrace_Record(APP_TRACE_QUEUE_BLOCK_SEND, (uint8_t)(pxQueue)->uxQueueNumber, 0)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) AppTrace_Record(APP_TRACE_QUEUE_BLOCK_RECV, (uint8_t)(pxQueue)->uxQueueNumber, 0)
+#define traceTASK_NOTIFY()                      AppTrace_Record(APP_TRACE_NOTIFY, (uint8_t)pxTCB->uxTCBNumber, 0)
+#define traceTASK_NOTIFY_FROM_ISR()             AppTrace_Record(APP_TRACE_NOTIFY_ISR, (uint8_t)pxTCB->uxTCBNumber, 0)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()        AppTrace_Record(APP_TRACE_NOTIFY_ISR, (uint8_t)pxTCB->uxTCBNumber, 0)
+#define traceTASK_NOTIFY_TAKE()                 AppTrace_Record(APP_TRACE_NOTIFY_TAKE, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceTASK_NOTIFY_WAIT()                 AppTrace_Record(APP_TRACE_NOTIFY_TAKE, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#else
+#define APP_TRACE_TASK_SWITCHED_IN()
+#endif
+
+/* 堆监视(app_heap)：按调用者统计分配、活动分配表、空闲块直方图，钩子在heap_4/heap_5挂起调度器期间执行 */
+#define configUSE_APP_HEAP_MONITOR              1
+
+#if ( configUSE_APP_HEAP_MONITOR == 1 )
+/* 宏在pvPortMalloc内展开，返回地址即调用pvPortMalloc的函数；
+ * malloc族包装经AppHeap_MallocFrom登记自己的调用者，钩子优先使用登记值 */
+extern void AppHeap_OnMalloc(void *pv, size_t size, void *caller);
+extern void AppHeap_OnFree(void *pv, size_t size);
+#define traceMALLOC(pvAddress, uiSize)          AppHeap_OnMalloc((pvAddress), (uiSize), __builtin_return_address(0))
+#define traceFREE(pvAddress, uiSize)            AppHeap_OnFree((pvAddress), (uiSize))
+#endif
+
+/****************************************************************
+            FreeRTOS低功耗(无节拍空闲)
+****************************************************************/
+#if ( configUSE_TICKLESS_IDLE == 1 )
+/* 替换port.c的vPortSuppressTicksAndSleep: 短空闲延长SysTick后SLEEP，
+ * 长空闲进入STOP并由RTC唤醒定时器唤醒(参数类型为TickType_t) */
+extern void AppPower_SuppressTicksAndSleep(uint32_t xExpectedIdleTime);
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) AppPower_SuppressTicksAndSleep(xExpectedIdleTime)
+
+/* vTaskStepTick一次跳过多个节拍时补齐软件定时器时间轮(节拍钩子不会被调用) */
+extern void AppTimer_Advance(uint32_t ticks);
+#define traceINCREASE_TICK_COUNT(xTicksToJump)   AppTimer_Advance(xTicksToJump)
 #endif
 
+#define traceTASK_SWITCHED_IN()                 \
+    do                                          \
+    {                                           \
+        PROF_TASK_SWITCHED_IN();                \
+        APP_TRACE_TASK_SWITCHED_IN();           \
+    } while (0)
+
 
 #endif /* FREERTOS_CONFIG_H */
 
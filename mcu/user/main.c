@@ -6,8 +6,14 @@
  * @date    2025-12-05
  * @note    说明:
  *       - Task_TempHum: 周期2秒，读取DHT11温湿度，优先级2，LED1(红)
- *       - Task_Light:   周期1.5秒，读取光敏ADC值，优先级3，LED2(绿)
- *       - Task_Display: 周期1秒，刷新OLED显示，优先级4，LED3(蓝)
+ *       - Task_Light:   光照越限唤醒(或周期1.5秒)，读取光敏ADC值，优先级3，LED2(绿)
+ *       - Task_Display: 数据更新通知驱动，3秒轮换页面，优先级4，LED3(蓝)
+ *       - Task_Prof:    每5秒串口输出各任务CPU占用率/栈余量/切入次数与休眠驻留，优先级1
+ *       - Task_Log:     分钟聚合写入Flash日志(app_log)，优先级1
+ *       - 空闲时无节拍休眠(app_power): 短空闲SLEEP，长空闲STOP + RTC唤醒
+ *       - 任务由注册表s_xAppTasks描述，启动调度器前静态创建(app_task)，栈与TCB在CCMRAM
+ *       - 板级初始化由阶段表s_xBootStages描述(app_boot): 慢速设备在调度器启动后并行初始化
+ *       - 系统时钟按档位表配置(app_clock): 启动完成后由Task_Prof按空闲占比自动调频
  *
  * @copyright Copyright (c) 2025 Yukikaze
  *
@@ -26,22 +32,126 @@
 #include "bsp_iic.h"
 #include "bsp_oled.h"
 #include "bsp_adc.h"
+#include "core_delay.h"
 
 /* 应用层任务头文件 */
+#include "app_bench.h"
+#include "app_boot.h"
+#include "app_clock.h"
 #include "app_data.h"
+#include "app_heap.h"
+#include "app_calib.h"
+#include "app_history.h"
+#include "app_log.h"
+#include "app_pool.h"
+#include "app_power.h"
+#include "app_task.h"
+#include "app_timer.h"
+#include "app_trace.h"
 #include "task_temphum.h"
 #include "task_light.h"
 #include "task_display.h"
+#include "task_prof.h"
 #include "task_test.h"
 
 /**
  * ============================================================================
- * 任务句柄定义
+ * 任务注册表
  * ============================================================================
+ *
+ * 每个任务一项: 名称、入口、优先级、栈预算(字)、周期(毫秒，0=事件驱动)、CPU预算(千分比)
+ * 栈预算沿用各任务头文件的TASK_X_STACK_SIZE；用测量构建(-DAPP_TASK_MEASURE=ON)
+ * 运行一段典型负载后，串口会输出按实测高水位加余量的建议值
+ *
+ * 任务优先级说明(数值越大优先级越高):
+ * - Task_TempHum: 优先级2 (低)
+ * - Task_Light:   优先级3 (中)
+ * - Task_Display: 优先级4 (高)
+ * - Task_Prof:    优先级1 (最低，运行时统计输出)
+ * - Task_Log:     优先级1 (最低，Flash写入与扇区擦除)
+ * - Task_Test:    优先级1 (最低，仅用于验证调度)
+ */
+
+APP_TASK_STORAGE(TempHum, TASK_TEMPHUM_STACK_SIZE);
+APP_TASK_STORAGE(Light, TASK_LIGHT_STACK_SIZE);
+APP_TASK_STORAGE(Display, TASK_DISPLAY_STACK_SIZE);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+APP_TASK_STORAGE(Prof, TASK_PROF_STACK_SIZE);
+#endif
+APP_TASK_STORAGE(Log, APP_LOG_TASK_STACK_SIZE);
+// APP_TASK_STORAGE(Test, TASK_TEST_STACK_SIZE);
+
+static const AppTask_Def_TypeDef s_xAppTasks[] = {
+    /* DHT11读取为位时序忙等，占用集中在每个周期的一次读取 */
+    APP_TASK_DEF(TempHum, TASK_TEMPHUM_NAME, Task_TempHum, TASK_TEMPHUM_PRIORITY,
+                 TASK_TEMPHUM_STACK_SIZE, TASK_TEMPHUM_PERIOD_MS, 10,
+                 &Task_TempHum_Handle),
+    /* 事件模式下由模拟看门狗越界唤醒 */
+    APP_TASK_DEF(Light, TASK_LIGHT_NAME, Task_Light, TASK_LIGHT_PRIORITY,
+                 TASK_LIGHT_STACK_SIZE, (TASK_LIGHT_EVENT_MODE ? 0 : TASK_LIGHT_PERIOD_MS), 10,
+                 &Task_Light_Handle),
+    /* 数据更新通知驱动，另每TASK_DISPLAY_PAGE_MS轮换页面，OLED刷新走软件I2C */
+    APP_TASK_DEF(Display, TASK_DISPLAY_NAME, Task_Display, TASK_DISPLAY_PRIORITY,
+                 TASK_DISPLAY_STACK_SIZE,
+                 (APP_POLLING_BASELINE ? TASK_DISPLAY_PERIOD_MS : TASK_DISPLAY_PAGE_MS), 50,
+                 &Task_Display_Handle),
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    /* 剖析任务：周期输出各任务CPU占用率 */
+    APP_TASK_DEF(Prof, TASK_PROF_NAME, Task_Prof, TASK_PROF_PRIORITY,
+                 TASK_PROF_STACK_SIZE, TASK_PROF_PERIOD_MS, 10,
+                 &Task_Prof_Handle),
+#endif
+    /* 日志任务：队列驱动，每分钟写一块，扇区轮换时擦除停顿1~2秒 */
+    APP_TASK_DEF(Log, APP_LOG_TASK_NAME, AppLog_Task, APP_LOG_TASK_PRIORITY,
+                 APP_LOG_TASK_STACK_SIZE, 0, 5,
+                 &AppLog_Task_Handle),
+    /* 心跳任务：验证调度与时基 */
+    // APP_TASK_DEF(Test, TASK_TEST_NAME, Task_Test, TASK_TEST_PRIORITY,
+    //              TASK_TEST_STACK_SIZE, 500, 1,
+    //              &Task_Test_Handle),
+};
+
+/**
+ * ============================================================================
+ * 启动阶段表
+ * ============================================================================
+ *
+ * 同步阶段在调度器启动前按表顺序执行，只放任务与中断立即依赖、且不需要等待的初始化；
+ * 异步阶段在调度器启动后由低优先级工作任务执行，与应用任务的首次采集重叠:
+ * - 工作任务A: OLED初始化与清屏(软件I2C约40ms)，完成后Task_Display开始绘制
+ * - 工作任务B: RTC时钟源(LSE起振最长约1秒，等待期间让出CPU)，
+ *              Flash日志挂载(扇区有旧数据而无有效日志时擦除1~2秒，期间CPU停顿，因此等OLED就绪后再开始)，
+ *              完成后Task_Log开始写入
+ * 各阶段的起止时间在启动完成后由Task_Prof输出(B行)
  */
 
-/* AppTaskCreate任务句柄 */
-static TaskHandle_t AppTaskCreate_Handle = NULL;
+MEM_COLD static int Boot_Led(void);
+MEM_COLD static int Boot_Usart(void);
+MEM_COLD static int Boot_Clock(void);
+MEM_COLD static int Boot_Trace(void);
+MEM_COLD static int Boot_Power(void);
+MEM_COLD static int Boot_DHT11(void);
+MEM_COLD static int Boot_ADC(void);
+MEM_COLD static int Boot_Calib(void);
+MEM_COLD static int Boot_IIC(void);
+MEM_COLD static int Boot_OLED(void);
+MEM_COLD static int Boot_Log(void);
+
+static const AppBoot_Stage_TypeDef s_xBootStages[] = {
+    APP_BOOT_STAGE("led", Boot_Led, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("usart", Boot_Usart, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("clock", Boot_Clock, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("trace", Boot_Trace, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("power", Boot_Power, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("dht11", Boot_DHT11, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("adc", Boot_ADC, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("calib", Boot_Calib, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("i2c", Boot_IIC, APP_BOOT_SYNC, 0, 0),
+    APP_BOOT_STAGE("oled", Boot_OLED, APP_BOOT_LANE_A, 0, APP_BOOT_RES_DISPLAY),
+    APP_BOOT_STAGE("rtc", AppPower_InitStop, APP_BOOT_LANE_B, 0, APP_BOOT_RES_STOP),
+    /* 擦除扇区时CPU取指停顿，放在第一帧画面之后 */
+    APP_BOOT_STAGE("log", Boot_Log, APP_BOOT_LANE_B, APP_BOOT_RES_DISPLAY, APP_BOOT_RES_LOG),
+};
 
 /**
  * ============================================================================
@@ -49,9 +159,8 @@ static TaskHandle_t AppTaskCreate_Handle = NULL;
  * ============================================================================
  */
 
-static void BSP_Init(void);
-static void AppTaskCreate(void *pvParameters);
-static void SystemClock_Config(void);
+MEM_COLD static BaseType_t BSP_Init(void);
+MEM_COLD static BaseType_t App_Init(void);
 
 /**
  * @brief 主函数
@@ -60,33 +169,35 @@ static void SystemClock_Config(void);
  * @return int 返回值(嵌入式系统中不会返回)
  *
  * @note 开发板硬件初始化
- *       创建APP应用任务
+ *       初始化应用模块并按注册表创建任务
  *       启动FreeRTOS，开始多任务调度
  */
 int main(void)
 {
     BaseType_t xReturn = pdPASS;
 
-    /* 配置系统时钟为180MHz */
-    SystemClock_Config();
+    /* RTOS堆(heap_5时定义SRAM+CCMRAM区域)与堆监视: newlib的malloc也使用此堆，
+     * 第一次printf就会分配流缓冲，因此放在最前面 */
+    AppTask_HeapInit();
+    AppHeap_Init();
 
-    /* 开发板硬件初始化 */
-    BSP_Init();
+    /* 系统时钟切到最高档(180MHz；HSE起振失败时由HSI经PLL得到，不在此停机) */
+    (void)AppClock_Init();
 
-    /* 创建AppTaskCreate任务 */
-    xReturn = xTaskCreate((TaskFunction_t)AppTaskCreate,
-                          (const char *)"AppTaskCreate",
-                          (uint16_t)512,
-                          (void *)NULL,
-                          (UBaseType_t)1,
-                          (TaskHandle_t *)&AppTaskCreate_Handle);
+    /* 开发板硬件初始化(慢速设备交给启动工作任务) */
+    xReturn = BSP_Init();
 
-    printf("AppTaskCreate Task Created!\r\n");
+    /* 应用模块初始化与任务创建(调度器启动前，不需要临界区) */
+    if (pdPASS == xReturn)
+    {
+        xReturn = App_Init();
+    }
 
     // 创建成功，启动调度器
     if (pdPASS == xReturn)
     {
         /* 启动FreeRTOS调度器 */
+        AppBoot_Mark("sched");
         vTaskStartScheduler();
     }
     // 创建失败，红灯常亮
@@ -108,125 +219,166 @@ int main(void)
  * @brief 板级外设初始化
  * @author Yukikaze
  *
- * @note 初始化顺序:
- *       1. LED GPIO
- *       2. 串口(调试输出)
- *       3. DHT11温湿度传感器
- *       4. I2C总线(OLED使用)
- *       5. OLED显示屏
- *       6. 光敏电阻ADC
+ * @return BaseType_t pdPASS=成功, pdFAIL=启动工作任务创建失败
+ *
+ * @note 同步阶段按s_xBootStages的顺序执行，异步阶段的工作任务在调度器启动后运行
  */
-static void BSP_Init(void)
+static BaseType_t BSP_Init(void)
 {
-    uint32_t i;
+    BaseType_t xReturn;
 
     /* 设置NVIC优先级分组为4 (全部用于抢占优先级) */
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
 
-    /* LED初始化 */
+    /* DWT周期计数器(延时与64位时间戳共用，只初始化一次；启动时间线的原点) */
+    CPU_TS_TmrInit();
+
+    xReturn = AppBoot_Run(s_xBootStages, sizeof(s_xBootStages) / sizeof(s_xBootStages[0]));
+
+#if (APP_BENCH == 1)
+    /* 内核函数基准(K行，格式见bench.h) */
+    AppBench_Run();
+#endif
+
+    return xReturn;
+}
+
+/**
+ * @brief LED GPIO
+ */
+static int Boot_Led(void)
+{
     LED_GPIO_Config();
-    LED_BLUE;
+    return 0;
+}
 
-    /* 串口初始化 */
+/**
+ * @brief 串口(调试输出)与控制台接收中断(单字符命令转发给Task_Prof，见task_prof.h)
+ */
+static int Boot_Usart(void)
+{
     USARTx_Config();
+    USARTx_RxIT_Config();
     printf("USART Initialized\r\n");
+    return 0;
+}
 
-    /* 简单延时 */
-    for (i = 0; i < 1800000; i++)
-    {
-        __NOP();
-    }
-    LED_RGBOFF;
+/**
+ * @brief 输出系统时钟(main最先配置，此时串口刚可用；HSE失败返回1，PLL失败返回-1)
+ */
+static int Boot_Clock(void)
+{
+    return AppClock_Report();
+}
+
+/**
+ * @brief 调度跟踪记录器(上次运行崩溃时先输出保留的跟踪缓冲)
+ */
+static int Boot_Trace(void)
+{
+    AppTrace_Init();
+    return 0;
+}
 
-    /* DHT11初始化 */
+/**
+ * @brief 低功耗管理: 先只使用SLEEP，RTC就绪后(工作任务B)允许STOP
+ */
+static int Boot_Power(void)
+{
+    AppPower_Init();
+    return 0;
+}
+
+/**
+ * @brief DHT11 GPIO(上电稳定时间由Task_TempHum等待)
+ */
+static int Boot_DHT11(void)
+{
     DHT11_GPIO_Config();
-    printf("DHT11 Initialized\r\n");
+    return 0;
+}
 
-    /* I2C初始化(OLED使用) */
+/**
+ * @brief 光敏电阻ADC
+ */
+static int Boot_ADC(void)
+{
+    PhotoResistor_Init();
+    return 0;
+}
+
+/**
+ * @brief 光照标定表(Flash无有效表时使用内置默认表，返回1)
+ */
+static int Boot_Calib(void)
+{
+    return AppCalib_Init();
+}
+
+/**
+ * @brief I2C总线GPIO(OLED使用)
+ */
+static int Boot_IIC(void)
+{
     IIC_GPIO_Config();
-    printf("I2C Initialized\r\n");
+    return 0;
+}
 
-    /* OLED初始化 */
+/**
+ * @brief OLED初始化与启动画面(工作任务A)
+ */
+static int Boot_OLED(void)
+{
     OLED_Init();
     OLED_CLS();
     OLED_ShowStr(0, 3, (unsigned char *)"Initializing", 1);
-    printf("OLED Initialized\r\n");
+    return 0;
+}
 
-    /* 光敏电阻ADC初始化 */
-    PhotoResistor_Init();
-    printf("PhotoResistor ADC Initialized\r\n");
+/**
+ * @brief 挂载Flash传感器日志(工作任务B，失败不影响其他功能)
+ */
+static int Boot_Log(void)
+{
+    return (pdPASS == AppLog_Init()) ? 0 : -1;
 }
 
 /**
- * @brief 应用任务创建函数
+ * @brief 应用模块初始化与任务创建
  * @author Yukikaze
  *
- * @param pvParameters 任务参数(未使用)
- *
- * @note 为了方便管理，所有的任务创建函数都放在这个函数里面
- *       任务创建完成后删除自身，释放资源
+ * @return BaseType_t pdPASS=成功, pdFAIL=失败
  *
- *       任务优先级说明(数值越大优先级越高):
- *       - Task_TempHum: 优先级2 (低)
- *       - Task_Light:   优先级3 (中)
- *       - Task_Display: 优先级4 (高)
- *       - Task_Test:    优先级1 (最低，仅用于验证调度)
+ * @note 在vTaskStartScheduler之前执行: 此时调度器未运行，
+ *       创建内核对象后BASEPRI保持抬高，受管中断到调度器启动时才会放开，
+ *       因此无需临界区，也不再需要一个创建完即自删的引导任务
  */
-static void AppTaskCreate(void *pvParameters)
+static BaseType_t App_Init(void)
 {
-    BaseType_t xReturn = pdPASS;
+    BaseType_t xReturn;
 
-    /* 避免编译器警告 */
-    (void)pvParameters;
+    /* 消息内存池(须早于任何可能分配消息的任务或中断) */
+    AppPool_Init();
 
-    /* 进入临界区(禁止任务调度) */
-    taskENTER_CRITICAL();
+    /* 初始化软件定时器(LED指示与周期触发，须早于任务创建) */
+    AppTimer_Init();
 
     /* 初始化共享数据模块 */
     xReturn = AppData_Init();
     if (pdPASS != xReturn)
     {
-        goto error;
-    }
-
-    /* 创建温湿度采集任务 */
-    xReturn = Task_TempHum_Create();
-    if (pdPASS != xReturn)
-    {
-        goto error;
+        return xReturn;
     }
 
-    /* 创建光照采集任务 */
-    xReturn = Task_Light_Create();
+    /* 初始化传感器历史数据 */
+    xReturn = AppHistory_Init();
     if (pdPASS != xReturn)
     {
-        goto error;
+        return xReturn;
     }
 
-    /* 创建显示任务 */
-    xReturn = Task_Display_Create();
-    if (pdPASS != xReturn)
-    {
-        goto error;
-    }
-
-    // /* 创建心跳任务：验证调度与时基 */
-    // xReturn = Task_Test_Create();
-    // if (pdPASS != xReturn)
-    // {
-    //     goto error;
-    // }
-
-    /* 退出临界区后再删除自身任务，避免调度器一直被禁止 */
-    taskEXIT_CRITICAL();
-    vTaskDelete(AppTaskCreate_Handle);
-    return;
-
-error:
-    /* 任务创建失败 */
-    LED_RED;
-    taskEXIT_CRITICAL();
-    vTaskDelete(AppTaskCreate_Handle);
+    /* 按注册表创建全部应用任务 */
+    return AppTask_CreateAll(s_xAppTasks, sizeof(s_xAppTasks) / sizeof(s_xAppTasks[0]));
 }
 
 /**
@@ -239,11 +391,14 @@ error:
  * @note 当检测到任务堆栈溢出时，FreeRTOS会调用此函数
  *       此函数必须在 configCHECK_FOR_STACK_OVERFLOW 非0时实现
  */
-void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+MEM_COLD void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
 {
     (void)xTask;
     (void)pcTaskName;
 
+    /* 冻结调度跟踪缓冲，复位后输出 */
+    AppTrace_Freeze(APP_TRACE_REASON_STACK);
+
     /* 禁止任务切换，保持错误状态 */
     taskDISABLE_INTERRUPTS();
 
@@ -263,14 +418,30 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
     }
 }
 
+/**
+ * @brief 系统节拍钩子函数
+ * @author Yukikaze
+ *
+ * @note 每个节拍读取一次64位DWT时间戳，保证CYCCNT回绕(约23.8秒)不会被漏检，
+ *       并推进软件定时器时间轮
+ *       在SysTick中断中执行，必须非常短小
+ */
+void vApplicationTickHook(void)
+{
+    (void)CPU_TS_Read64();
+    AppTimer_TickFromISR();
+}
+
 /**
  * @brief Malloc失败钩子函数
  * @author Yukikaze
  *
- * @note 当内存分配失败时调用
+ * @note 当内存分配失败时调用(heap已恢复调度器)，先输出堆监视报告再停机
  */
-void vApplicationMallocFailedHook(void)
+MEM_COLD void vApplicationMallocFailedHook(void)
 {
+    AppTrace_Freeze(APP_TRACE_REASON_MALLOC);
+    AppHeap_Dump();
     taskDISABLE_INTERRUPTS();
     LED_RED;
     for (;;)
@@ -278,65 +449,3 @@ void vApplicationMallocFailedHook(void)
         /* 常亮指示内存不足 */
     }
 }
-
-/**
- * @brief  配置系统时钟为180MHz
- *         HSE = 25MHz
- *         SYSCLK = 180MHz
- *         AHB = 180MHz
- *         APB1 = 45MHz
- *         APB2 = 90MHz
- * @param  无
- * @retval 无
- */
-static void SystemClock_Config(void)
-{
-    RCC_DeInit();
-    /* 使能HSE */
-    RCC_HSEConfig(RCC_HSE_ON);
-    /* 等待HSE就绪 */
-    if (RCC_WaitForHSEStartUp() == SUCCESS)
-    {
-        /* 使能PWR时钟 */
-        RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
-        /* 设置调压器输出电压等级为Scale1模式，支持180MHz */
-        PWR_MainRegulatorModeConfig(PWR_Regulator_Voltage_Scale1);
-        /* HCLK = SYSCLK / 1 = 180MHz */
-        RCC_HCLKConfig(RCC_SYSCLK_Div1);
-        /* APB2 = HCLK / 2 = 90MHz */
-        RCC_PCLK2Config(RCC_HCLK_Div2);
-        /* APB1 = HCLK / 4 = 45MHz (APB1最大频率45MHz) */
-        RCC_PCLK1Config(RCC_HCLK_Div4);
-        /* 配置PLL: HSE/25 * 360 / 2 = 180MHz */
-        RCC_PLLConfig(RCC_PLLSource_HSE, 25, 360, 2, 7);
-        /* 使能PLL */
-        RCC_PLLCmd(ENABLE);
-        /* 等待PLL就绪 */
-        while (RCC_GetFlagStatus(RCC_FLAG_PLLRDY) == RESET)
-        {
-        }
-        /* 配置Flash预取指，指令缓存，数据缓存和等待状态 */
-        FLASH_SetLatency(FLASH_Latency_5);
-        FLASH_PrefetchBufferCmd(ENABLE);
-        FLASH_InstructionCacheCmd(ENABLE);
-        FLASH_DataCacheCmd(ENABLE);
-        /* 当PLL准备好后，选择PLL作为系统时钟源 */
-        RCC_SYSCLKConfig(RCC_SYSCLKSource_PLLCLK);
-        /* 等待PLL被选择为系统时钟源 */
-        while (RCC_GetSYSCLKSource() != 0x08)
-        {
-            /* 等待 */
-        }
-    }
-    else
-    {
-        /* HSE启动失败时在此处理错误 */
-        while (1)
-        {
-            /* 可以添加错误处理代码 */
-        }
-    }
-
-    /* 更新系统时钟全局变量 */
-    SystemCoreClockUpdate();
-}
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * @file newlib_heap.c
+ * @brief 将newlib的malloc族函数接到FreeRTOS堆
+ * @author Yukikaze
+ * @date 2026-10-19
+ *
+ * @note NEWLIB_HEAP_RTOS == 1(默认)时，malloc/free/realloc/calloc及其可重入版本(_malloc_r等，
+ *       printf的流缓冲、dtoa等库内部分配走这一组)全部转给pvPortMalloc/vPortFree:
+ *       - 全系统只有一个堆(heap_4/heap_5)，由其挂起调度器保证线程安全，碎片与用量只需看一处
+ *       - 分配同样经过堆监视钩子(app_heap)；各入口取自己的返回地址经AppHeap_MallocFrom登记，
+ *         调用者显示为调用malloc/calloc/realloc的函数(库内部分配显示为newlib中的调用点)
+ *       - 链接器不再拉入newlib自己的分配器，_sbrk随之不被引用
+ *       因此AppTask_HeapInit必须早于第一次printf(见main)；与内核对象一样，不能在中断中分配
+ *
+ *       NEWLIB_HEAP_RTOS == 0 时保留newlib分配器(经_sbrk从_end向上增长，边界检查见syscalls.c)，
+ *       __malloc_lock/__malloc_unlock挂起调度器使其在多任务下安全
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_heap.h"
+#include <errno.h>
+#include <reent.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef NEWLIB_HEAP_RTOS
+#define NEWLIB_HEAP_RTOS 1
+#endif
+
+/**
+ * ============================================================================
+ * 分配器锁
+ * ============================================================================
+ */
+
+/**
+ * @brief newlib分配器加锁(可嵌套，newlib在malloc/free内部调用)
+ */
+void __malloc_lock(struct _reent *r)
+{
+    (void)r;
+    vTaskSuspendAll();
+}
+
+/**
+ * @brief newlib分配器解锁
+ */
+void __malloc_unlock(struct _reent *r)
+{
+    (void)r;
+    (void)xTaskResumeAll();
+}
+
+#if (NEWLIB_HEAP_RTOS == 1)
+
+/**
+ * ============================================================================
+ * 私有函数(caller为入口函数的返回地址)
+ * ============================================================================
+ */
+
+static void *NewlibHeap_Malloc(struct _reent *r, size_t size, void *caller)
+{
+    void *p;
+
+    /* heap_4对0字节请求返回NULL并触发分配失败钩子，C标准允许malloc(0)返回唯一指针 */
+    p = AppHeap_MallocFrom((size != 0) ? size : 1U, caller);
+    if (p == NULL)
+    {
+        r->_errno = ENOMEM;
+    }
+    return p;
+}
+
+static void *NewlibHeap_Calloc(struct _reent *r, size_t n, size_t size, void *caller)
+{
+    void *p;
+
+    if (size != 0 && n > SIZE_MAX / size)
+    {
+        r->_errno = ENOMEM;
+        return NULL;
+    }
+    p = NewlibHeap_Malloc(r, n * size, caller);
+    if (p != NULL)
+    {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+static void *NewlibHeap_Realloc(struct _reent *r, void *ptr, size_t size, void *caller)
+{
+    size_t old;
+    void *p;
+
+    if (ptr == NULL)
+    {
+        return NewlibHeap_Malloc(r, size, caller);
+    }
+    if (size == 0)
+    {
+        vPortFree(ptr);
+        return NULL;
+    }
+
+    /* 原块足够大时原地返回(heap_4不支持原地扩展) */
+    old = xPortGetAllocatedSize(ptr);
+    if (size <= old)
+    {
+        return ptr;
+    }
+
+    p = NewlibHeap_Malloc(r, size, caller);
+    if (p != NULL)
+    {
+        memcpy(p, ptr, old);
+        vPortFree(ptr);
+    }
+    return p;
+}
+
+/**
+ * ============================================================================
+ * 可重入版本(newlib库内部调用)
+ * ============================================================================
+ */
+
+void *_malloc_r(struct _reent *r, size_t size)
+{
+    return NewlibHeap_Malloc(r, size, __builtin_return_address(0));
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    vPortFree(ptr);
+}
+
+void *_calloc_r(struct _reent *r, size_t n, size_t size)
+{
+    return NewlibHeap_Calloc(r, n, size, __builtin_return_address(0));
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    return NewlibHeap_Realloc(r, ptr, size, __builtin_return_address(0));
+}
+
+/**
+ * ============================================================================
+ * 标准接口
+ * ============================================================================
+ */
+
+void *malloc(size_t size)
+{
+    return NewlibHeap_Malloc(_REENT, size, __builtin_return_address(0));
+}
+
+void free(void *ptr)
+{
+    vPortFree(ptr);
+}
+
+void *calloc(size_t n, size_t size)
+{
+    return NewlibHeap_Calloc(_REENT, n, size, __builtin_return_address(0));
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    return NewlibHeap_Realloc(_REENT, ptr, size, __builtin_return_address(0));
+}
+
+#endif /* NEWLIB_HEAP_RTOS == 1 */
@@ -25,6 +25,11 @@
   ******************************************************************************
   */
 
+/* 主机仿真构建(project/sim): main.c按引号包含时先找到本文件，转到mcu/sim中的同名头文件 */
+#if defined(STM32F4XX_SIM)
+#include "../sim/Inc/stm32f4xx_conf.h"
+#else
+
 /* Define to prevent recursive inclusion -------------------------------------*/
 #ifndef __STM32F4xx_CONF_H
 #define __STM32F4xx_CONF_H
@@ -131,4 +136,6 @@
 
 #endif /* __STM32F4xx_CONF_H */
 
+#endif /* STM32F4XX_SIM */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
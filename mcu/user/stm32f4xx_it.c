@@ -33,6 +33,12 @@
 #include "FreeRTOS.h" //FreeRTOS使用
 #include "task.h"
 #include "bsp_adc.h" // ADC EOC interrupt handler
+#include "task_light.h" // ADC analog watchdog -> Task_Light
+#include "app_trace.h" // scheduler trace (ISR enter/exit, freeze on fault)
+#include "bsp_power.h" // RTC wakeup (tickless STOP)
+#include "bsp_usart.h" // console RX -> Task_Prof commands
+#include "task_prof.h"
+#include "mem_section.h" // MEM_FASTCODE/MEM_COLD (performance profile)
 
 extern __IO uint16_t ADC_ConvertedValue;
 
@@ -60,7 +66,7 @@ extern __IO uint16_t ADC_ConvertedValue;
  * @param  None
  * @retval None
  */
-void NMI_Handler(void)
+MEM_COLD void NMI_Handler(void)
 {
 }
 
@@ -69,8 +75,11 @@ void NMI_Handler(void)
  * @param  None
  * @retval None
  */
-void HardFault_Handler(void)
+MEM_COLD void HardFault_Handler(void)
 {
+    /* Keep the scheduler trace for post-mortem dump after reset */
+    AppTrace_Freeze(APP_TRACE_REASON_FAULT);
+
     /* Go to infinite loop when Hard Fault exception occurs */
     while (1)
     {
@@ -82,8 +91,11 @@ void HardFault_Handler(void)
  * @param  None
  * @retval None
  */
-void MemManage_Handler(void)
+MEM_COLD void MemManage_Handler(void)
 {
+    /* Keep the scheduler trace for post-mortem dump after reset */
+    AppTrace_Freeze(APP_TRACE_REASON_FAULT);
+
     /* Go to infinite loop when Memory Manage exception occurs */
     while (1)
     {
@@ -95,8 +107,11 @@ void MemManage_Handler(void)
  * @param  None
  * @retval None
  */
-void BusFault_Handler(void)
+MEM_COLD void BusFault_Handler(void)
 {
+    /* Keep the scheduler trace for post-mortem dump after reset */
+    AppTrace_Freeze(APP_TRACE_REASON_FAULT);
+
     /* Go to infinite loop when Bus Fault exception occurs */
     while (1)
     {
@@ -108,8 +123,11 @@ void BusFault_Handler(void)
  * @param  None
  * @retval None
  */
-void UsageFault_Handler(void)
+MEM_COLD void UsageFault_Handler(void)
 {
+    /* Keep the scheduler trace for post-mortem dump after reset */
+    AppTrace_Freeze(APP_TRACE_REASON_FAULT);
+
     /* Go to infinite loop when Usage Fault exception occurs */
     while (1)
     {
@@ -132,8 +150,11 @@ void DebugMon_Handler(void)
  */
 extern void xPortSysTickHandler(void);
 // systick中断服务函数
-void SysTick_Handler(void)
+MEM_FASTCODE void SysTick_Handler(void)
 {
+#if APP_TRACE_SYSTICK
+    AppTrace_IsrEnter();
+#endif
 #if (INCLUDE_xTaskGetSchedulerState == 1)
     if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
     {
@@ -142,6 +163,9 @@ void SysTick_Handler(void)
 #if (INCLUDE_xTaskGetSchedulerState == 1)
     }
 #endif /* INCLUDE_xTaskGetSchedulerState */
+#if APP_TRACE_SYSTICK
+    AppTrace_IsrExit();
+#endif
 }
 
 /******************************************************************************/
@@ -159,13 +183,71 @@ void SysTick_Handler(void)
  * @}
  */
 
-void ADC_IRQHandler(void)
+MEM_FASTCODE void ADC_IRQHandler(void)
 {
+    int32_t filtered;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t traced = 0;
+
+#if TASK_LIGHT_EVENT_MODE
+    if (ADC_GetITStatus(ADCx, ADC_IT_AWD) != RESET)
+    {
+        /* EOC中断频率过高，只跟踪会唤醒任务的看门狗中断 */
+        AppTrace_IsrEnter();
+        traced = 1;
+
+        /* 先撤防再通知，信号停留在带外时不会形成中断风暴 */
+        PhotoResistor_AWD_Disarm();
+        Task_Light_AWDFromISR(&xHigherPriorityTaskWoken);
+    }
+#endif
+
     if (ADC_GetITStatus(ADCx, ADC_IT_EOC) != RESET)
     {
-        ADC_ConvertedValue = ADC_GetConversionValue(ADCx);
+        /* CIC抽取滤波，每ADC_CIC_DECIM个样本更新一次结果 */
+        if (Filter_CIC_Update(&ADC_LightCIC, ADC_GetConversionValue(ADCx), &filtered))
+        {
+            ADC_ConvertedValue = (uint16_t)filtered;
+        }
         ADC_ClearITPendingBit(ADCx, ADC_IT_EOC);
     }
+
+    if (traced)
+    {
+        AppTrace_IsrExit();
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief  RTC唤醒定时器中断(STOP唤醒源)
+ * @note   正常情况下app_power在唤醒后已清除挂起位，这里只处理残留的标志
+ */
+void RTC_WKUP_IRQHandler(void)
+{
+    if (RTC_GetITStatus(RTC_IT_WUT) != RESET)
+    {
+        RTC_ClearITPendingBit(RTC_IT_WUT);
+    }
+    EXTI_ClearITPendingBit(EXTI_Line22);
+}
+
+/**
+ * @brief  控制台串口接收中断
+ * @note   先读SR再读DR，同时清除RXNE与溢出(ORE)标志；ORE也会触发RXNE中断，不清除会反复进入
+ *         STOP模式下串口无时钟，期间收到的字符会丢失，重发即可
+ */
+MEM_FASTCODE void USARTx_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if ((USARTx->SR & (USART_SR_RXNE | USART_SR_ORE)) != 0)
+    {
+        Task_Prof_CommandFromISR((uint8_t)USART_ReceiveData(USARTx), &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -17,19 +17,33 @@
 
 extern uint8_t _end;
 extern uint8_t _estack;
+extern uint8_t _Min_Stack_Size; /* absolute linker symbol: its address is the value */
+
+/* minimum gap kept between the break and the current main stack pointer */
+#define SBRK_STACK_MARGIN 256U
 
 static uint8_t *s_brk = NULL;
 
+/* Only used by newlib's own allocator (NEWLIB_HEAP_RTOS == 0, see newlib_heap.c).
+ * The heap grows up from _end and the main stack (MSP) grows down from _estack:
+ * never hand out the _Min_Stack_Size reserved for the MSP, nor come close to
+ * where the MSP currently is. */
 void *_sbrk(ptrdiff_t incr)
 {
     uint8_t *prev_brk;
+    uint8_t *limit = &_estack - (uintptr_t)&_Min_Stack_Size;
+    uint8_t *msp = (uint8_t *)__get_MSP() - SBRK_STACK_MARGIN;
 
     if (s_brk == NULL)
     {
         s_brk = &_end;
     }
 
-    if ((s_brk + incr) > &_estack)
+    if (msp < limit)
+    {
+        limit = msp;
+    }
+    if ((s_brk + incr) > limit)
     {
         errno = ENOMEM;
         return (void *)-1;
@@ -0,0 +1,28 @@
+# ============================================================================
+# 仿真确定性检查(ctest 调用)
+# ============================================================================
+# 用同样的参数运行两次仿真，输出必须逐字节相同
+#
+# cmake -DSIM=<template_sim> -DSIM_ARGS=<;分隔的参数> -DOUT=<输出前缀> -P sim_compare.cmake
+# ============================================================================
+
+# @author Yukikaze
+foreach(run 1 2)
+    execute_process(
+        COMMAND ${SIM} ${SIM_ARGS}
+        OUTPUT_FILE ${OUT}.${run}.txt
+        RESULT_VARIABLE rc
+    )
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "run ${run} exited with ${rc}")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT}.1.txt ${OUT}.2.txt
+    RESULT_VARIABLE diff
+)
+if(NOT diff EQUAL 0)
+    message(FATAL_ERROR "output differs between runs: ${OUT}.1.txt ${OUT}.2.txt")
+endif()
+message(STATUS "identical output (${OUT}.1.txt)")
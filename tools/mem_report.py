@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    mem_report.py
+@author  Yukikaze
+@brief   解析GNU ld生成的链接映射文件(.map)，按存储区域汇总占用并列出最大的RAM对象
+@date    2026-10-19
+
+输入: 链接时由 -Wl,-Map=<name>.map 生成的映射文件(见 project/CMakeLists.txt)
+输出:
+    - 各存储区域(FLASH/RAM/CCMRAM)的已用/剩余字节，.data等AT>FLASH段同时计入FLASH
+    - 各输出段的地址与大小
+    - 静态任务栈/TCB(app_task的 s_x<Tag>Stack / s_x<Tag>Tcb)与FreeRTOS堆(ucHeap)
+    - .bss/.ccmbss/.data中最大的N个对象(依赖 -fdata-sections，每个对象一个输入段)
+
+用法:
+    python3 tools/mem_report.py build/template.map
+    python3 tools/mem_report.py app.map --top 30
+"""
+
+import argparse
+import re
+import sys
+
+# 输出段: 段名与地址/大小在同一行，或段名过长时换到下一行
+RE_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_OUT = re.compile(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?)?\s*$")
+RE_IN = re.compile(r"^ (\.\S+|COMMON)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?\s*$")
+RE_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(?:load address 0x([0-9a-fA-F]+)|(\S.*)))?\s*$")
+RE_STORAGE = re.compile(r"^s_x(\w+?)(Stack|Tcb)$")
+
+# 需要列出对象的RAM段
+RAM_SECTIONS = (".data", ".bss", ".ccmram", ".ccmbss", ".noinit")
+
+# 不占Flash映像的段(ld仍可能为其打印load address)
+NOBITS_SECTIONS = (".bss", ".ccmbss", ".noinit", "._user_heap_stack")
+
+
+class Region:
+    """MEMORY中定义的一个存储区域"""
+
+    def __init__(self, name, origin, length):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        self.used = 0
+
+    def contains(self, addr):
+        return self.origin <= addr < self.origin + self.length
+
+
+class Section:
+    """一个输出段"""
+
+    def __init__(self, name, addr, size, lma):
+        self.name = name
+        self.addr = addr
+        self.size = size
+        self.lma = lma
+        self.objects = []  # (符号名, 大小, 目标文件)
+
+
+def parse(fp):
+    regions = []
+    sections = []
+    state = None
+    pending_out = None
+    pending_in = None
+    cur = None
+
+    for raw in fp:
+        line = raw.rstrip("\n")
+
+        if line.startswith("Memory Configuration"):
+            state = "mem"
+            continue
+        if line.startswith("Linker script and memory map"):
+            state = "map"
+            continue
+
+        if state == "mem":
+            m = RE_REGION.match(line)
+            if m and m.group(1) not in ("Name", "*default*"):
+                regions.append(Region(m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+            continue
+        if state != "map":
+            continue
+
+        # 输出段名独占一行时，地址/大小在下一行
+        if pending_out is not None:
+            m = RE_CONT.match(line)
+            if m:
+                cur = Section(pending_out, int(m.group(1), 16), int(m.group(2), 16),
+                              int(m.group(3), 16) if m.group(3) else None)
+                sections.append(cur)
+            pending_out = None
+            continue
+        if pending_in is not None:
+            m = RE_CONT.match(line)
+            if m and cur is not None and m.group(4):
+                cur.objects.append((pending_in, int(m.group(2), 16), m.group(4)))
+            pending_in = None
+            continue
+
+        m = RE_OUT.match(line)
+        if m:
+            if m.group(2) is None:
+                pending_out = m.group(1)
+            else:
+                cur = Section(m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                              int(m.group(4), 16) if m.group(4) else None)
+                sections.append(cur)
+            continue
+
+        m = RE_IN.match(line)
+        if m and cur is not None:
+            if m.group(2) is None:
+                pending_in = m.group(1)
+            elif int(m.group(3), 16) != 0:
+                cur.objects.append((m.group(1), int(m.group(3), 16), m.group(4)))
+
+    return regions, sections
+
+
+def object_name(section_name, out_name):
+    """由输入段名还原对象名: .bss.s_xFooStack -> s_xFooStack"""
+    for prefix in (out_name + ".", ".bss.", ".data.", ".ccmram.", ".ccmbss.", ".noinit."):
+        if section_name.startswith(prefix) and len(section_name) > len(prefix):
+            return section_name[len(prefix):]
+    return section_name
+
+
+def short_file(path):
+    path = path.replace("\\", "/")
+    m = re.search(r"\(([^()]+)\)$", path)  # 库成员 libc.a(lib_a-xxx.o)
+    if m:
+        return m.group(1)
+    return path.rsplit("/", 1)[-1]
+
+
+def account(regions, sections):
+    for sec in sections:
+        if sec.size == 0:
+            continue
+        for r in regions:
+            if r.contains(sec.addr):
+                r.used += sec.size
+            if (sec.lma is not None and sec.lma != sec.addr and r.contains(sec.lma)
+                    and sec.name not in NOBITS_SECTIONS):
+                r.used += sec.size
+
+
+def report(regions, sections, top):
+    account(regions, sections)
+
+    print("%-10s %10s %10s %10s %7s" % ("Region", "Size", "Used", "Free", "Used%"))
+    for r in regions:
+        pct = 100.0 * r.used / r.length if r.length else 0.0
+        print("%-10s %10d %10d %10d %6.1f%%" % (r.name, r.length, r.used, r.length - r.used, pct))
+
+    print("\n%-20s %10s %10s %10s" % ("Section", "Address", "Size", "LMA"))
+    for sec in sections:
+        if sec.size == 0 or sec.addr == 0:
+            continue
+        lma = ""
+        if sec.lma is not None and sec.lma != sec.addr and sec.name not in NOBITS_SECTIONS:
+            lma = "0x%08x" % sec.lma
+        print("%-20s 0x%08x %10d %10s" % (sec.name, sec.addr, sec.size, lma))
+
+    ram_objs = []
+    for sec in sections:
+        if sec.name not in RAM_SECTIONS:
+            continue
+        for sname, size, path in sec.objects:
+            ram_objs.append((object_name(sname, sec.name), size, sec.name, short_file(path)))
+
+    # 静态任务存储: 同一tag的栈与TCB合并成一行
+    tasks = {}
+    heap = None
+    for name, size, sec, _ in ram_objs:
+        m = RE_STORAGE.match(name)
+        if m:
+            t = tasks.setdefault(m.group(1), [0, 0, sec])
+            t[0 if m.group(2) == "Stack" else 1] += size
+        elif name == "ucHeap":
+            heap = (size, sec)
+
+    if tasks:
+        print("\n%-16s %10s %8s %10s" % ("Task storage", "Stack(B)", "TCB(B)", "Section"))
+        total = 0
+        for tag in sorted(tasks, key=lambda k: -tasks[k][0]):
+            stack, tcb, sec = tasks[tag]
+            total += stack + tcb
+            print("%-16s %10d %8d %10s" % (tag, stack, tcb, sec))
+        print("%-16s %19d" % ("total", total))
+    if heap is not None:
+        print("\nFreeRTOS heap (ucHeap): %d B in %s" % heap)
+
+    ram_objs.sort(key=lambda o: -o[1])
+    print("\n%-40s %8s %10s  %s" % ("Largest RAM objects", "Size", "Section", "File"))
+    for name, size, sec, path in ram_objs[:top]:
+        print("%-40s %8d %10s  %s" % (name, size, sec, path))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="GNU ld map -> memory usage report")
+    ap.add_argument("file", help="链接映射文件(.map)")
+    ap.add_argument("--top", type=int, default=20, help="列出最大的N个RAM对象(默认20)")
+    args = ap.parse_args()
+
+    with open(args.file, "r", encoding="utf-8", errors="replace") as fp:
+        regions, sections = parse(fp)
+    if not regions or not sections:
+        sys.exit("不是GNU ld映射文件或缺少 Memory Configuration 段")
+
+    report(regions, sections, args.top)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    prof_view.py
+@author  Yukikaze
+@brief   解析 Task_Prof 的串口CSV输出，打印各窗口的任务统计并可绘制CPU占用率曲线
+@date    2026-10-19
+
+输入格式(见 mcu/app/task_prof/Inc/task_prof.h):
+    P,<seq>,<uptime_ms>,<window_us>,<task_num>
+    L,<seq>,<sleep_permille>,<stop_permille>,<sleeps>,<stops>,<wakes>,<early>,<aborts>  (可选)
+    H,<seq>,<free>,<min_free>,<largest_free>,<free_blocks>,<frag_permille>,<allocs>,<fails>  (RTOS堆概要)
+    M,<seq>,<block_size>,<count>,<used>,<high_water>,<fails>,<errors>  (每个内存池等级一行)
+    D,<seq>,<channel>,<count>,<min_us>,<avg_us>,<max_us>,<missed>  (每个数据通道一行，采样到显示的累计延迟)
+    T,<seq>,<name>,<state>,<prio>,<cpu_permille>,<stack_free_words>,<switches>[,<wakes>]
+其余行(普通printf输出)直接忽略
+
+用法:
+    python3 tools/prof_view.py log.txt                 # 解析日志文件
+    python3 tools/prof_view.py -p /dev/ttyUSB0         # 实时读取串口(需要pyserial)
+    python3 tools/prof_view.py log.txt --plot          # 绘制CPU占用率(需要matplotlib)
+    python3 tools/prof_view.py log.txt --csv out.csv   # 导出为宽表CSV
+"""
+
+import argparse
+import csv
+import sys
+
+
+# 数据通道，与 AppData_Channel_t 保持一致
+CHANNEL_NAMES = {0: "temphum", 1: "light"}
+
+
+class Window:
+    """一个统计窗口"""
+
+    def __init__(self, seq, uptime_ms, window_us, task_num):
+        self.seq = seq
+        self.uptime_ms = uptime_ms
+        self.window_us = window_us
+        self.task_num = task_num
+        self.tasks = []
+        self.power = None
+        self.pools = []
+        self.heap = None
+        self.latency = []
+
+    def complete(self):
+        return len(self.tasks) >= self.task_num
+
+
+def parse_lines(lines):
+    """逐行解析，每凑齐一个完整窗口产出一次"""
+    cur = None
+    for raw in lines:
+        line = raw.strip()
+        f = line.split(",")
+        try:
+            if f[0] == "P" and len(f) == 5:
+                cur = Window(int(f[1]), int(f[2]), int(f[3]), int(f[4]))
+            elif f[0] == "L" and len(f) == 9 and cur is not None and int(f[1]) == cur.seq:
+                cur.power = {
+                    "sleep": int(f[2]) / 10.0,
+                    "stop": int(f[3]) / 10.0,
+                    "sleeps": int(f[4]),
+                    "stops": int(f[5]),
+                    "wakes": int(f[6]),
+                    "early": int(f[7]),
+                    "aborts": int(f[8]),
+                }
+            elif f[0] == "H" and len(f) == 9 and cur is not None and int(f[1]) == cur.seq:
+                cur.heap = {
+                    "free": int(f[2]),
+                    "min_free": int(f[3]),
+                    "largest": int(f[4]),
+                    "blocks": int(f[5]),
+                    "frag": int(f[6]) / 10.0,
+                    "allocs": int(f[7]),
+                    "fails": int(f[8]),
+                }
+            elif f[0] == "M" and len(f) == 8 and cur is not None and int(f[1]) == cur.seq:
+                cur.pools.append({
+                    "size": int(f[2]),
+                    "count": int(f[3]),
+                    "used": int(f[4]),
+                    "high_water": int(f[5]),
+                    "fails": int(f[6]),
+                    "errors": int(f[7]),
+                })
+            elif f[0] == "D" and len(f) == 8 and cur is not None and int(f[1]) == cur.seq:
+                cur.latency.append({
+                    "channel": int(f[2]),
+                    "count": int(f[3]),
+                    "min_us": int(f[4]),
+                    "avg_us": int(f[5]),
+                    "max_us": int(f[6]),
+                    "missed": int(f[7]),
+                })
+            elif f[0] == "T" and len(f) in (8, 9) and cur is not None:
+                if int(f[1]) != cur.seq:
+                    # 窗口头丢失(串口断续)，丢弃该窗口
+                    cur = None
+                    continue
+                cur.tasks.append({
+                    "name": f[2],
+                    "state": f[3],
+                    "prio": int(f[4]),
+                    "cpu": int(f[5]) / 10.0,
+                    "stack_free": int(f[6]),
+                    "switches": int(f[7]),
+                    # 旧固件没有唤醒次数列
+                    "wakes": int(f[8]) if len(f) > 8 else None,
+                })
+            else:
+                continue
+        except ValueError:
+            cur = None
+            continue
+
+        if cur is not None and cur.complete():
+            yield cur
+            cur = None
+
+
+def read_source(args):
+    if args.port:
+        try:
+            import serial
+        except ImportError:
+            sys.exit("读取串口需要 pyserial: pip install pyserial")
+        ser = serial.Serial(args.port, args.baud, timeout=1)
+        while True:
+            yield ser.readline().decode("ascii", errors="replace")
+    elif args.file == "-":
+        yield from sys.stdin
+    else:
+        with open(args.file, "r", encoding="ascii", errors="replace") as fp:
+            yield from fp
+
+
+def print_window(w):
+    print("== #%d  t=%.1fs  window=%.3fs" % (w.seq, w.uptime_ms / 1000.0, w.window_us / 1e6))
+    sec = w.window_us / 1e6 if w.window_us else 1.0
+    if w.power is not None:
+        p = w.power
+        print("  idle: sleep %.1f%%  stop %.1f%%  (sleeps %d, stops %d, irq wakes %d, early %d, aborts %d)" % (
+            p["sleep"], p["stop"], p["sleeps"], p["stops"], p["wakes"], p["early"], p["aborts"]))
+    if w.heap is not None:
+        h = w.heap
+        print("  heap: free %d (min %d) in %d blocks, largest %d, frag %.1f%%  (allocs %d, fails %d)" % (
+            h["free"], h["min_free"], h["blocks"], h["largest"], h["frag"], h["allocs"], h["fails"]))
+    for m in w.pools:
+        print("  pool %4dB: used %d/%d  peak %d  fails %d  errors %d" % (
+            m["size"], m["used"], m["count"], m["high_water"], m["fails"], m["errors"]))
+    for d in w.latency:
+        print("  latency %-8s: %d samples  min %.1f  avg %.1f  max %.1f ms  (missed %d)" % (
+            CHANNEL_NAMES.get(d["channel"], "ch%d" % d["channel"]), d["count"],
+            d["min_us"] / 1000.0, d["avg_us"] / 1000.0, d["max_us"] / 1000.0, d["missed"]))
+    print("  %-16s %-2s %4s %7s %10s %9s %7s" % ("task", "st", "prio", "cpu%", "stack_free", "switch/s",
+                                                  "wake/s"))
+    for t in sorted(w.tasks, key=lambda t: -t["cpu"]):
+        print("  %-16s %-2s %4d %7.1f %10d %9.1f %7s" % (
+            t["name"], t["state"], t["prio"], t["cpu"], t["stack_free"], t["switches"] / sec,
+            "-" if t["wakes"] is None else "%.1f" % (t["wakes"] / sec)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Task_Prof 串口输出解析")
+    ap.add_argument("file", nargs="?", default="-", help="日志文件('-'为标准输入)")
+    ap.add_argument("-p", "--port", help="串口设备，如 /dev/ttyUSB0 或 COM3")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("--plot", action="store_true", help="结束后绘制CPU占用率曲线")
+    ap.add_argument("--csv", help="导出宽表CSV(每行一个窗口)")
+    ap.add_argument("-q", "--quiet", action="store_true", help="不打印每个窗口")
+    args = ap.parse_args()
+
+    windows = []
+    try:
+        for w in parse_lines(read_source(args)):
+            windows.append(w)
+            if not args.quiet:
+                print_window(w)
+    except KeyboardInterrupt:
+        pass
+
+    if not windows:
+        sys.exit("没有解析到完整的统计窗口")
+
+    names = []
+    for w in windows:
+        for t in w.tasks:
+            if t["name"] not in names:
+                names.append(t["name"])
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as fp:
+            wr = csv.writer(fp)
+            wr.writerow(["seq", "uptime_s", "sleep_pct", "stop_pct"] + ["%s_cpu" % n for n in names] +
+                        ["%s_stack_free" % n for n in names])
+            for w in windows:
+                by = {t["name"]: t for t in w.tasks}
+                p = w.power or {}
+                wr.writerow([w.seq, w.uptime_ms / 1000.0, p.get("sleep", ""), p.get("stop", "")] +
+                            [by[n]["cpu"] if n in by else "" for n in names] +
+                            [by[n]["stack_free"] if n in by else "" for n in names])
+
+    if args.plot:
+        try:
+            import matplotlib.pyplot as plt
+        except ImportError:
+            sys.exit("绘图需要 matplotlib: pip install matplotlib")
+        xs = [w.uptime_ms / 1000.0 for w in windows]
+        fig, (ax1, ax2) = plt.subplots(2, 1, sharex=True)
+        for n in names:
+            ys = [next((t["cpu"] for t in w.tasks if t["name"] == n), 0.0) for w in windows]
+            ax1.plot(xs, ys, label=n)
+            ys = [next((t["stack_free"] for t in w.tasks if t["name"] == n), None) for w in windows]
+            ax2.plot(xs, ys, label=n)
+        if any(w.power is not None for w in windows):
+            ys = [(w.power["sleep"] + w.power["stop"]) if w.power else None for w in windows]
+            ax1.plot(xs, ys, "k--", label="(sleep+stop)")
+        ax1.set_ylabel("CPU %")
+        ax1.legend(fontsize="small")
+        ax2.set_ylabel("stack free (words)")
+        ax2.set_xlabel("uptime (s)")
+        plt.show()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    profile_report.py
+@author  Yukikaze
+@brief   对比两种构建配置(默认构建与性能构建 APP_PERF_PROFILE)的大小与CPU占用
+@date    2026-10-19
+
+输入:
+    - 两个构建的链接映射文件(.map)，先基准后对比
+    - 可选: 两份 Task_Prof 串口日志(同一负载下分别采集，格式见 prof_view.py)
+输出:
+    - 各存储区域与输出段的大小及差值(.fastcode 同时占用 Flash 镜像与 SRAM)
+    - .fastcode 中各目标文件的字节数
+    - 各任务平均CPU占用(千分比)及比值；负载不变时比值即该任务消耗周期数之比
+
+用法:
+    python3 tools/profile_report.py build/template.map build-perf/template.map
+    python3 tools/profile_report.py base.map perf.map --log base.txt perf.txt
+"""
+
+import argparse
+import sys
+
+from mem_report import account, parse, short_file
+from prof_view import parse_lines
+
+
+def load_map(path):
+    with open(path, "r", encoding="utf-8", errors="replace") as fp:
+        regions, sections = parse(fp)
+    if not regions or not sections:
+        sys.exit("%s: 不是GNU ld映射文件或缺少 Memory Configuration 段" % path)
+    account(regions, sections)
+    return regions, sections
+
+
+def load_log(path):
+    """返回 {任务名: 平均CPU千分比}，以及窗口数"""
+    total = {}
+    count = {}
+    windows = 0
+    with open(path, "r", encoding="ascii", errors="replace") as fp:
+        for w in parse_lines(fp):
+            windows += 1
+            for t in w.tasks:
+                total[t["name"]] = total.get(t["name"], 0.0) + t["cpu"] * 10.0
+                count[t["name"]] = count.get(t["name"], 0) + 1
+    if windows == 0:
+        sys.exit("%s: 没有解析到完整的统计窗口" % path)
+    return {n: total[n] / count[n] for n in total}, windows
+
+
+def delta(a, b):
+    if a == 0:
+        return "" if b == 0 else "new"
+    return "%+.1f%%" % (100.0 * (b - a) / a)
+
+
+def report_size(base, perf):
+    b_regions, b_sections = base
+    p_regions, p_sections = perf
+
+    print("%-10s %10s %10s %10s %8s" % ("Region", "Base", "Perf", "Diff", ""))
+    p_used = {r.name: r.used for r in p_regions}
+    for r in b_regions:
+        used = p_used.get(r.name, 0)
+        print("%-10s %10d %10d %+10d %8s" % (r.name, r.used, used, used - r.used, delta(r.used, used)))
+
+    names = []
+    for sec in b_sections + p_sections:
+        if sec.size != 0 and sec.addr != 0 and sec.name not in names:
+            names.append(sec.name)
+    b_size = {s.name: s.size for s in b_sections}
+    p_size = {s.name: s.size for s in p_sections}
+    print("\n%-20s %10s %10s %10s %8s" % ("Section", "Base", "Perf", "Diff", ""))
+    for n in names:
+        b = b_size.get(n, 0)
+        p = p_size.get(n, 0)
+        print("%-20s %10d %10d %+10d %8s" % (n, b, p, p - b, delta(b, p)))
+
+    fast = {}
+    for sec in p_sections:
+        if sec.name != ".fastcode":
+            continue
+        for _, size, path in sec.objects:
+            f = short_file(path)
+            fast[f] = fast.get(f, 0) + size
+    if fast:
+        print("\n%-40s %8s" % (".fastcode (SRAM) by file", "Size"))
+        for f in sorted(fast, key=lambda k: -fast[k]):
+            print("%-40s %8d" % (f, fast[f]))
+        print("%-40s %8d" % ("total", sum(fast.values())))
+
+
+def report_cpu(base_log, perf_log):
+    base, nb = load_log(base_log)
+    perf, np_ = load_log(perf_log)
+
+    print("\nCPU (average over %d / %d windows, permille of total cycles)" % (nb, np_))
+    print("%-16s %10s %10s %8s" % ("task", "Base", "Perf", "Perf/Base"))
+    names = sorted(set(base) | set(perf), key=lambda n: -base.get(n, 0.0))
+    for n in names:
+        b = base.get(n)
+        p = perf.get(n)
+        ratio = "%.2f" % (p / b) if b and p is not None else ""
+        print("%-16s %10s %10s %8s" % (n,
+                                       "%.1f" % b if b is not None else "-",
+                                       "%.1f" % p if p is not None else "-",
+                                       ratio))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="构建配置大小/CPU占用对比")
+    ap.add_argument("base_map", help="基准构建的映射文件(.map)")
+    ap.add_argument("perf_map", help="对比构建的映射文件(.map)")
+    ap.add_argument("--log", nargs=2, metavar=("BASE", "PERF"), help="两份 Task_Prof 串口日志")
+    args = ap.parse_args()
+
+    report_size(load_map(args.base_map), load_map(args.perf_map))
+    if args.log:
+        report_cpu(args.log[0], args.log[1])
+
+
+if __name__ == "__main__":
+    main()
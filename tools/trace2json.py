@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    trace2json.py
+@author  Yukikaze
+@brief   将 app_trace 的串口输出转换为 Chrome tracing JSON (chrome://tracing 或 ui.perfetto.dev 打开)
+@date    2026-10-19
+
+输入格式(见 mcu/app/app_trace/Inc/app_trace.h):
+    TRACE,BEGIN,<events>,<lost>,<dropped>,<cpu_hz>,<reason>
+    TRACE,N,<task_num>,<name>
+    TRACE,E,<16位十六进制: 事件的8个字节，小端 ts(u32) type(u8) id(u8) arg(u16)>
+    TRACE,END
+其余行直接忽略。日志中有多段跟踪时默认转换最后一段
+
+用法:
+    python3 tools/trace2json.py uart.log -o trace.json
+    python3 tools/trace2json.py uart.log --summary      # 只打印统计信息
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# 事件类型，与 AppTrace_Type_t 保持一致
+SYNC = 0
+TASK_CREATE = 1
+TASK_IN = 2
+ISR_ENTER = 3
+ISR_EXIT = 4
+QUEUE_SEND = 5
+QUEUE_SEND_ISR = 6
+QUEUE_RECV = 7
+QUEUE_RECV_ISR = 8
+QUEUE_BLOCK_SEND = 9
+QUEUE_BLOCK_RECV = 10
+NOTIFY = 11
+NOTIFY_ISR = 12
+NOTIFY_TAKE = 13
+MARK = 14
+FREEZE = 15
+
+INSTANT_NAMES = {
+    QUEUE_SEND: "queue send",
+    QUEUE_SEND_ISR: "queue send (ISR)",
+    QUEUE_RECV: "queue recv",
+    QUEUE_RECV_ISR: "queue recv (ISR)",
+    QUEUE_BLOCK_SEND: "block on queue send",
+    QUEUE_BLOCK_RECV: "block on queue recv",
+    NOTIFY: "notify",
+    NOTIFY_ISR: "notify (ISR)",
+    NOTIFY_TAKE: "notify take",
+    MARK: "mark",
+}
+
+FREEZE_REASONS = ["none", "assert", "stack overflow", "malloc failed", "fault", "user"]
+
+PID = 1
+ISR_TID_BASE = 1000
+
+
+class Capture:
+    """一段跟踪输出"""
+
+    def __init__(self, cpu_hz, lost, dropped, reason):
+        self.cpu_hz = cpu_hz
+        self.lost = lost
+        self.dropped = dropped
+        self.reason = reason
+        self.names = {}
+        self.events = []  # (ts32, type, id, arg)
+
+
+def parse(lines):
+    """解析出所有完整的跟踪段"""
+    caps = []
+    cur = None
+    for raw in lines:
+        f = raw.strip().split(",", 3)
+        if len(f) < 2 or f[0] != "TRACE":
+            continue
+        try:
+            if f[1] == "BEGIN":
+                v = raw.strip().split(",")
+                cur = Capture(int(v[5]), int(v[3]), int(v[4]), int(v[6]))
+            elif cur is None:
+                continue
+            elif f[1] == "N":
+                cur.names[int(f[2])] = f[3]
+            elif f[1] == "E":
+                cur.events.append(struct.unpack("<IBBH", bytes.fromhex(f[2])))
+            elif f[1] == "END":
+                caps.append(cur)
+                cur = None
+        except (ValueError, IndexError, struct.error):
+            # 串口误码，丢弃该行
+            continue
+    return caps
+
+
+def timeline(cap):
+    """重建64位时间戳，返回 (cycles, type, id, arg) 列表"""
+    out = []
+    high = 0
+    last = None
+    for ts, typ, oid, arg in cap.events:
+        if typ == SYNC:
+            high = ts
+            last = None
+            continue
+        # 低32位回退但没有SYNC(第一个SYNC之前被覆盖掉的部分)，按回绕处理
+        if last is not None and ts < last:
+            high += 1
+        last = ts
+        out.append(((high << 32) | ts, typ, oid, arg))
+    return out
+
+
+def task_name(cap, num):
+    return cap.names.get(num, "task#%d" % num)
+
+
+def convert(cap):
+    evs = timeline(cap)
+    if not evs:
+        return [], {}
+    t0 = evs[0][0]
+    us = lambda c: (c - t0) * 1e6 / cap.cpu_hz
+
+    out = []
+    seen_tids = {}
+    stats = {"switches": 0, "isr": 0, "instant": 0}
+
+    def thread(tid, name, sort):
+        if tid not in seen_tids:
+            seen_tids[tid] = name
+            out.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name", "args": {"name": name}})
+            out.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_sort_index", "args": {"sort_index": sort}})
+
+    out.append({"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "STM32F429 FreeRTOS"}})
+
+    running = None  # (task_num, start_cycles)
+    isr_stack = []  # [(irq, start_cycles)]
+
+    for c, typ, oid, arg in evs:
+        if typ == TASK_IN:
+            if running is not None and running[0] != oid:
+                thread(running[0], task_name(cap, running[0]), running[0])
+                out.append({"ph": "X", "pid": PID, "tid": running[0], "name": task_name(cap, running[0]),
+                            "ts": us(running[1]), "dur": us(c) - us(running[1])})
+                stats["switches"] += 1
+            if running is None or running[0] != oid:
+                running = (oid, c)
+        elif typ == ISR_ENTER:
+            isr_stack.append((oid, c))
+        elif typ == ISR_EXIT:
+            if isr_stack and isr_stack[-1][0] == oid:
+                irq, start = isr_stack.pop()
+                tid = ISR_TID_BASE + irq
+                thread(tid, "ISR %d (IRQ %d)" % (irq, irq - 16), -1)
+                out.append({"ph": "X", "pid": PID, "tid": tid, "name": "ISR %d" % irq,
+                            "ts": us(start), "dur": us(c) - us(start)})
+                stats["isr"] += 1
+        elif typ == TASK_CREATE:
+            thread(oid, task_name(cap, oid), oid)
+            out.append({"ph": "i", "pid": PID, "tid": oid, "s": "t", "name": "create",
+                        "ts": us(c), "args": {"priority": arg}})
+        elif typ == FREEZE:
+            reason = FREEZE_REASONS[arg] if arg < len(FREEZE_REASONS) else str(arg)
+            out.append({"ph": "i", "pid": PID, "s": "g", "name": "FREEZE: " + reason, "ts": us(c)})
+        elif typ in INSTANT_NAMES:
+            if typ in (NOTIFY, NOTIFY_ISR):
+                args = {"target": task_name(cap, oid)}
+            elif typ == NOTIFY_TAKE:
+                args = {}
+            elif typ == MARK:
+                args = {"id": oid, "arg": arg}
+            else:
+                args = {"queue": oid, "waiting": arg}
+            if isr_stack:
+                tid = ISR_TID_BASE + isr_stack[-1][0]
+            elif running is not None:
+                tid = running[0]
+            else:
+                tid = 0
+            out.append({"ph": "i", "pid": PID, "tid": tid, "s": "t", "name": INSTANT_NAMES[typ],
+                        "ts": us(c), "args": args})
+            stats["instant"] += 1
+
+    # 最后一个仍在运行的任务
+    if running is not None:
+        thread(running[0], task_name(cap, running[0]), running[0])
+        out.append({"ph": "X", "pid": PID, "tid": running[0], "name": task_name(cap, running[0]),
+                    "ts": us(running[1]), "dur": us(evs[-1][0]) - us(running[1])})
+
+    stats["span_ms"] = us(evs[-1][0]) / 1000.0
+    stats["events"] = len(cap.events)
+    return out, stats
+
+
+def main():
+    ap = argparse.ArgumentParser(description="app_trace -> Chrome tracing JSON")
+    ap.add_argument("file", nargs="?", default="-", help="串口日志('-'为标准输入)")
+    ap.add_argument("-o", "--output", default="trace.json")
+    ap.add_argument("-i", "--index", type=int, default=-1, help="转换第几段跟踪(默认最后一段)")
+    ap.add_argument("--summary", action="store_true", help="只打印统计信息")
+    args = ap.parse_args()
+
+    if args.file == "-":
+        caps = parse(sys.stdin)
+    else:
+        with open(args.file, "r", encoding="ascii", errors="replace") as fp:
+            caps = parse(fp)
+    if not caps:
+        sys.exit("没有找到完整的 TRACE,BEGIN ... TRACE,END 段")
+
+    cap = caps[args.index]
+    events, stats = convert(cap)
+    reason = FREEZE_REASONS[cap.reason] if cap.reason < len(FREEZE_REASONS) else str(cap.reason)
+    print("captures=%d events=%d overwritten=%d dropped=%d span=%.3fms switches=%d isr=%d freeze=%s" % (
+        len(caps), stats.get("events", 0), cap.lost, cap.dropped, stats.get("span_ms", 0.0),
+        stats.get("switches", 0), stats.get("isr", 0), reason))
+
+    if not args.summary:
+        with open(args.output, "w") as fp:
+            json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, fp)
+        print("written", args.output)
+
+
+if __name__ == "__main__":
+    main()
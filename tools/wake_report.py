@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    wake_report.py
+@author  Yukikaze
+@brief   对比两份同一负载日志的任务唤醒次数、CPU唤醒与采样到显示的延迟
+@date    2026-10-19
+
+输入:
+    两份同一负载下的串口日志，先基准后对比。默认对比轮询基准构建(APP_POLLING_BASELINE，
+    显示任务每秒重绘、LED指示用vTaskDelay保持)与数据总线通知驱动的默认构建，例如仿真:
+        cmake -S project/sim -B build_poll -DAPP_POLLING_BASELINE=ON && cmake --build build_poll
+        build_poll/template_sim -t 120000 > polling.txt
+        build/template_sim -t 120000 > event.txt
+    同一构建加 --no-tickless 与否即为无节拍空闲前后的对比(--labels Base,Tickless)
+    日志中的 Task_Prof 输出(L/D/T行，格式见 prof_view.py)必需；
+    仿真结束时的 [sim] core/power 汇总行可选，有则给出整次运行的节拍与中断计数
+输出:
+    - 各任务每秒唤醒次数(转为就绪，T行wakes列)与切入次数(含被抢占后的恢复)
+    - 各数据通道采样到显示的延迟(最后一个窗口的累计值)
+    - Task_Prof L行: 每秒进入休眠次数与休眠中被非节拍中断唤醒的次数、休眠占比
+    - 内核节拍、外设中断与CPU唤醒次数(仿真汇总)，每秒值及差值
+
+用法:
+    python3 tools/wake_report.py polling.txt event.txt
+    python3 tools/wake_report.py --labels Base,Tickless base.txt tickless.txt
+"""
+
+import argparse
+import re
+import sys
+
+from prof_view import CHANNEL_NAMES, parse_lines
+
+RE_SUMMARY = re.compile(r"^\[sim\] ---- summary @ (\d+) ms")
+RE_CORE = re.compile(r"^\[sim\] core: \d+ Hz, \d+ cycles, (\d+) ticks \((\d+) suppressed\), "
+                     r"(\d+) irqs, (\d+) switches")
+RE_POWER = re.compile(r"^\[sim\] power: (\d+) sleeps, (\d+) wakes, (\d+) aborts")
+
+
+class Log:
+    """一份日志的汇总"""
+
+    def __init__(self):
+        self.sim = {}
+        self.windows = 0
+        self.seconds = 0.0
+        self.power = {"sleeps": 0, "stops": 0, "wakes": 0, "sleep": 0.0}
+        self.switches = {}
+        self.wakes = {}
+        self.latency = []
+
+
+def load_log(path):
+    log = Log()
+    with open(path, "r", encoding="ascii", errors="replace") as fp:
+        lines = fp.readlines()
+
+    for line in lines:
+        m = RE_SUMMARY.match(line)
+        if m:
+            log.sim["ms"] = int(m.group(1))
+            continue
+        m = RE_CORE.match(line)
+        if m:
+            log.sim["ticks"], log.sim["suppressed"], log.sim["irqs"], log.sim["switches"] = (
+                int(g) for g in m.groups())
+            continue
+        m = RE_POWER.match(line)
+        if m:
+            log.sim["sleeps"], log.sim["wakes"], log.sim["aborts"] = (int(g) for g in m.groups())
+
+    sleep_us = 0.0
+    for w in parse_lines(lines):
+        # 第一个窗口包含启动过程，不计入
+        if w.seq == 0:
+            continue
+        sec = w.window_us / 1e6
+        log.windows += 1
+        log.seconds += sec
+        if w.power is not None:
+            for k in ("sleeps", "stops", "wakes"):
+                log.power[k] += w.power[k]
+            sleep_us += (w.power["sleep"] + w.power["stop"]) * w.window_us / 100.0
+        for t in w.tasks:
+            log.switches[t["name"]] = log.switches.get(t["name"], 0) + t["switches"]
+            if t["wakes"] is not None:
+                log.wakes[t["name"]] = log.wakes.get(t["name"], 0) + t["wakes"]
+        if w.latency:
+            log.latency = w.latency
+
+    if log.windows == 0:
+        sys.exit("%s: 没有解析到完整的统计窗口" % path)
+    log.power["sleep"] = sleep_us / (log.seconds * 1e6) * 100.0
+    return log
+
+
+def delta(a, b):
+    if a == 0:
+        return "" if b == 0 else "new"
+    return "%+.1f%%" % (100.0 * (b - a) / a)
+
+
+LABELS = ["Base", "New"]
+
+
+def row(name, a, b, fmt="%.1f"):
+    print("%-24s %12s %12s %8s" % (name, fmt % a, fmt % b, delta(a, b)))
+
+
+def header(title):
+    print("%-24s %12s %12s %8s" % (title, LABELS[0], LABELS[1], ""))
+
+
+def report_sim(base, new):
+    if "irqs" not in base.sim or "irqs" not in new.sim:
+        return
+    sb = base.sim["ms"] / 1000.0
+    sn = new.sim["ms"] / 1000.0
+    print("\nSimulator summary (%.0f s / %.0f s, per second)" % (sb, sn))
+    header("")
+    row("kernel ticks", base.sim["ticks"] / sb, new.sim["ticks"] / sn)
+    row("suppressed ticks", base.sim["suppressed"] / sb, new.sim["suppressed"] / sn)
+    row("peripheral irqs", base.sim["irqs"] / sb, new.sim["irqs"] / sn)
+    # 每个执行的内核节拍与外设中断都是一次中断入口(CPU从WFI醒来或打断运行中的任务)
+    row("cpu wakeups",
+        (base.sim["ticks"] + base.sim["irqs"]) / sb,
+        (new.sim["ticks"] + new.sim["irqs"]) / sn)
+    row("  of which tick", base.sim["ticks"] / sb, new.sim["ticks"] / sn)
+    row("sim thread switches", base.sim["switches"] / sb, new.sim["switches"] / sn)
+    row("sleeps", base.sim["sleeps"] / sb, new.sim["sleeps"] / sn)
+    row("irq wakes in sleep", base.sim["wakes"] / sb, new.sim["wakes"] / sn)
+
+
+def report_tasks(base, new):
+    print("Tasks (%d / %d windows, %.0f s / %.0f s, per second)" % (
+        base.windows, new.windows, base.seconds, new.seconds))
+    names = sorted(set(base.switches) | set(new.switches), key=lambda n: -base.switches.get(n, 0))
+    if base.wakes and new.wakes:
+        header("wake/s")
+        for n in names:
+            row(n, base.wakes.get(n, 0) / base.seconds, new.wakes.get(n, 0) / new.seconds)
+        print()
+    header("switch/s")
+    for n in names:
+        row(n, base.switches.get(n, 0) / base.seconds, new.switches.get(n, 0) / new.seconds)
+
+
+def report_prof(base, new):
+    print("\nTask_Prof power (per second)")
+    header("")
+    row("sleeps", base.power["sleeps"] / base.seconds, new.power["sleeps"] / new.seconds)
+    row("stops", base.power["stops"] / base.seconds, new.power["stops"] / new.seconds)
+    row("irq wakes in sleep", base.power["wakes"] / base.seconds, new.power["wakes"] / new.seconds)
+    row("time asleep (%)", base.power["sleep"], new.power["sleep"])
+
+
+def report_latency(base, new):
+    if not base.latency or not new.latency:
+        return
+    print()
+    header("latency (ms)")
+    new_ch = {d["channel"]: d for d in new.latency}
+    for b in base.latency:
+        n = new_ch.get(b["channel"])
+        if n is None:
+            continue
+        name = CHANNEL_NAMES.get(b["channel"], "ch%d" % b["channel"])
+        for k in ("min_us", "avg_us", "max_us"):
+            row("%s %s" % (name, k[:3]), b[k] / 1000.0, n[k] / 1000.0)
+        row("%s samples" % name, b["count"], n["count"], "%d")
+        row("%s missed" % name, b["missed"], n["missed"], "%d")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="两份同一负载日志的唤醒次数与延迟对比")
+    ap.add_argument("base", help="基准日志(默认为轮询基准构建 APP_POLLING_BASELINE)")
+    ap.add_argument("new", help="对比日志(默认为通知驱动的默认构建)")
+    ap.add_argument("--labels", default="Polling,Event", help="两列的标题(逗号分隔)")
+    args = ap.parse_args()
+
+    labels = args.labels.split(",")
+    if len(labels) != 2:
+        sys.exit("--labels 需要两个以逗号分隔的标题")
+    LABELS[:] = labels
+
+    base = load_log(args.base)
+    new = load_log(args.new)
+    report_tasks(base, new)
+    report_latency(base, new)
+    report_prof(base, new)
+    report_sim(base, new)
+
+
+if __name__ == "__main__":
+    main()